@@ -108,6 +108,12 @@ namespace bs
 		if (skeleton != nullptr)
 			skeletonPose = LocalSkeletonPose(skeleton->getNumBones());
 
+		lodFramesSinceUpdate = 0;
+		lodMaskLevels = 0;
+		lodSkeletonMask = SkeletonMask();
+		lodPoses[0] = LocalSkeletonPose();
+		lodPoses[1] = LocalSkeletonPose();
+
 		numSceneObjects = (UINT32)sceneObjects.size();
 		if (numSceneObjects > 0)
 			sceneObjectPose = LocalSkeletonPose(numSceneObjects, true);
@@ -429,6 +435,7 @@ namespace bs
 					if (isClipValid)
 					{
 						state.curves = clipInfo.clip->getCurves();
+						state.compressedCurves = clipInfo.clip->_getCompressedCurves();
 						state.disabled = clipInfo.playbackType == AnimPlaybackType::None;
 					}
 					else
@@ -277,6 +277,12 @@ namespace bs
 		UINT32 numGenericCurves = 0;
 		float* genericCurveOutputs = nullptr;
 		bool wasCulled = false;
+
+		// Level of detail
+		UINT32 lodFramesSinceUpdate = 0;
+		UINT32 lodMaskLevels = 0; /**< Number of leaf bone levels disabled by @p lodSkeletonMask. */
+		SkeletonMask lodSkeletonMask;
+		LocalSkeletonPose lodPoses[2]; /**< Two most recently evaluated local poses, oldest first. */
 	};
 
 	/**
@@ -139,12 +139,46 @@ namespace bs
 	void AnimationClip::setCurves(const AnimationCurves& curves)
 	{
 		*mCurves = curves;
+		mCompressedCurves = nullptr;
 
 		buildNameMapping();
 		calculateLength();
 		mVersion++;
 	}
 
+	bool AnimationClip::_compress(const AnimationCompressionSettings& settings)
+	{
+		SPtr<CompressedAnimationCurves> compressedCurves = CompressedAnimationCurves::create(*mCurves, settings);
+		if(compressedCurves == nullptr)
+			return false;
+
+		// Keep the curve names so they can still be mapped to bones, but release the keyframes
+		auto stripKeyframes = [](const auto& curves, auto& output)
+		{
+			output.reserve(curves.size());
+			for(auto& entry : curves)
+			{
+				output.push_back(entry);
+				output.back().curve = {};
+			}
+		};
+
+		SPtr<AnimationCurves> newCurves = bs_shared_ptr_new<AnimationCurves>();
+		stripKeyframes(mCurves->position, newCurves->position);
+		stripKeyframes(mCurves->rotation, newCurves->rotation);
+		stripKeyframes(mCurves->scale, newCurves->scale);
+		newCurves->generic = mCurves->generic;
+
+		// Curves may be in use on other threads, so they must be replaced rather than modified
+		mCurves = newCurves;
+		mCompressedCurves = compressedCurves;
+
+		calculateLength();
+		mVersion++;
+
+		return true;
+	}
+
 	bool AnimationClip::hasRootMotion() const
 	{
 		return mRootMotion != nullptr &&
@@ -166,6 +200,9 @@ namespace bs
 
 		for (auto& entry : mCurves->generic)
 			mLength = std::max(mLength, entry.curve.getLength());
+
+		if (mCompressedCurves != nullptr)
+			mLength = std::max(mLength, mCompressedCurves->getTimeRange().second);
 	}
 
 	void AnimationClip::buildNameMapping()
@@ -7,6 +7,7 @@
 #include "Math/BsVector3.h"
 #include "Math/BsQuaternion.h"
 #include "Animation/BsAnimationCurve.h"
+#include "Animation/BsCompressedAnimationCurves.h"
 #include <array>
 
 namespace bs
@@ -272,6 +273,18 @@ namespace bs
 		static SPtr<AnimationClip> _createPtr(const SPtr<AnimationCurves>& curves, bool isAdditive = false,
 			UINT32 sampleRate = 1, const SPtr<RootMotion>& rootMotion = nullptr);
 
+		/**
+		 * Replaces the position, rotation and scale curves of the clip with a lossy compressed version that uses less
+		 * memory. Afterwards the clip curves returned by getCurves() retain their names but contain no keyframes. Generic
+		 * curves are not affected. Setting new curves on the clip discards the compressed data.
+		 *
+		 * @return	True if the curves were compressed, false if the clip was left unchanged.
+		 */
+		bool _compress(const AnimationCompressionSettings& settings = AnimationCompressionSettings());
+
+		/** Returns the compressed position, rotation and scale curves, or null if the clip isn't compressed. */
+		SPtr<CompressedAnimationCurves> _getCompressedCurves() const { return mCompressedCurves; }
+
 		/** @} */
 
 	protected:
@@ -297,6 +310,12 @@ namespace bs
 		 */
 		SPtr<AnimationCurves> mCurves;
 
+		/**
+		 * Compressed version of the position, rotation and scale curves in @p mCurves, if the clip was compressed. Same
+		 * immutability rules as for @p mCurves apply.
+		 */
+		SPtr<CompressedAnimationCurves> mCompressedCurves;
+
 		/**
 		 * A set of curves containing motion of the root bone. If this is non-empty it should be true that mCurves does not
 		 * contain animation curves for the root bone. Root motion will not be evaluated through normal animation process
@@ -10,14 +10,47 @@
 #include "Animation/BsMorphShapes.h"
 #include "Mesh/BsMeshData.h"
 #include "Mesh/BsMeshUtility.h"
+#include "Animation/BsSkeletonMask.h"
 
 namespace bs
 {
+	/**
+	 * Minimum cost of a single batch of animations evaluated on a worker thread. Prevents scenes with few animations from
+	 * being split into batches too small to be worth the scheduling overhead.
+	 */
+	static constexpr UINT32 MIN_BATCH_COST = 256;
+
+	/** Returns the relative cost of evaluating the provided animation, used for load balancing. */
+	static UINT32 getEvaluationCost(const AnimationProxy& anim)
+	{
+		// Every animation has some fixed cost (culling, scene object and generic curves), on top of bone evaluation
+		UINT32 cost = 1 + anim.numSceneObjects;
+		if (anim.skeleton != nullptr)
+			cost += anim.skeleton->getNumBones();
+
+		return cost;
+	}
+
 	AnimationManager::AnimationManager()
 	{
 		mBlendShapeVertexDesc = VertexDataDesc::create();
 		mBlendShapeVertexDesc->addVertElem(VET_FLOAT3, VES_POSITION, 1, 1);
 		mBlendShapeVertexDesc->addVertElem(VET_UBYTE4_NORM, VES_NORMAL, 1, 1);
+
+		mLODTiers =
+		{
+			{ 0.25f, 1, 0 },
+			{ 0.1f, 2, 0 },
+			{ 0.03f, 3, 1 },
+			{ 0.0f, 4, 2 }
+		};
+	}
+
+	AnimationManager::~AnimationManager()
+	{
+		// Evaluation tasks reference this object, make sure they finish before it is destroyed
+		if(mEvaluationTasks)
+			mEvaluationTasks->wait();
 	}
 
 	void AnimationManager::setPaused(bool paused)
@@ -33,23 +66,40 @@ namespace bs
 		mUpdateRate = 1.0f / fps;
 	}
 
+	void AnimationManager::setLODEnabled(bool enabled)
+	{
+		mLODEnabled = enabled;
+	}
+
+	void AnimationManager::setLODTiers(const Vector<AnimationLODTier>& tiers)
+	{
+		mLODTiers = tiers;
+		for(auto& tier : mLODTiers)
+		{
+			if (tier.updateInterval == 0)
+				tier.updateInterval = 1;
+		}
+
+		std::sort(mLODTiers.begin(), mLODTiers.end(),
+			[](const AnimationLODTier& a, const AnimationLODTier& b) { return a.minScreenSize > b.minScreenSize; });
+	}
+
 	const EvaluatedAnimationData* AnimationManager::update(bool async)
 	{
 		// Wait for any workers to complete
+		if(mEvaluationTasks)
 		{
-			Lock lock(mMutex);
-
-			while (mNumActiveWorkers > 0)
-				mWorkerDoneSignal.wait(lock);
+			mEvaluationTasks->wait();
+			mEvaluationTasks = nullptr;
+		}
 
-			// Advance the buffers (last write buffer becomes read buffer)
-			if(mSwapBuffers)
-			{
-				mPoseReadBufferIdx = (mPoseReadBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
-				mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
+		// Advance the buffers (last write buffer becomes read buffer)
+		if(mSwapBuffers)
+		{
+			mPoseReadBufferIdx = (mPoseReadBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
+			mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
 
-				mSwapBuffers = false;
-			}
+			mSwapBuffers = false;
 		}
 
 		if(mPaused)
@@ -86,6 +136,7 @@ namespace bs
 
 		// Build frustums for culling
 		mCullFrustums.clear();
+		mLODViews.clear();
 
 		auto& allCameras = gSceneManager().getAllCameras();
 		for(auto& entry : allCameras)
@@ -97,59 +148,60 @@ namespace bs
 			// TODO: Not checking if camera and animation renderable's layers match. If we checked more animations could
 			// be culled.
 			mCullFrustums.push_back(entry.second->getWorldFrustum());
+
+			LODView view;
+			view.position = entry.second->getTransform().getPosition();
+			view.projectionScale = Math::abs(entry.second->getProjectionMatrix()[1][1]);
+			view.perspective = entry.second->getProjectionType() == PT_PERSPECTIVE;
+
+			mLODViews.push_back(view);
 		}
 
-		// Prepare the write buffer
+		mEvaluationLODTiers.clear();
+		if(mLODEnabled)
+			mEvaluationLODTiers = mLODTiers;
+
+		// Assign output bones to each animation
+		const auto numProxies = (UINT32)mProxies.size();
+		mProxyBoneStarts.resize(numProxies);
+
 		UINT32 totalNumBones = 0;
-		for (auto& anim : mProxies)
+		for (UINT32 i = 0; i < numProxies; i++)
 		{
-			if (anim->skeleton != nullptr)
-				totalNumBones += anim->skeleton->getNumBones();
+			mProxyBoneStarts[i] = totalNumBones;
+
+			const SPtr<Skeleton>& skeleton = mProxies[i]->skeleton;
+			if (skeleton != nullptr)
+				totalNumBones += skeleton->getNumBones();
 		}
 
+		mEvaluationOutputs.clear();
+		mEvaluationOutputs.resize(numProxies);
+
 		// Prepare the write buffer
 		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
 		renderData.transforms.resize(totalNumBones);
 		renderData.infos.clear();
 
 		// Queue animation evaluation tasks
-		{
-			Lock lock(mMutex);
-			mNumActiveWorkers = (UINT32)mProxies.size();
-		}
+		createBatches();
 
-		UINT32 curBoneIdx = 0;
-		for (auto& anim : mProxies)
+		const auto numBatches = (UINT32)mBatchStarts.size() - 1;
+		if (numBatches > 0)
 		{
-			auto evaluateAnimWorker = [this, anim, curBoneIdx]()
-			{
-				UINT32 boneIdx = curBoneIdx;
-				evaluateAnimation(anim.get(), boneIdx);
-
-				Lock lock(mMutex);
-				{
-					assert(mNumActiveWorkers > 0);
-					mNumActiveWorkers--;
-				}
-
-				mWorkerDoneSignal.notify_one();
-			};
+			mNumRemainingBatches = numBatches;
+			mEvaluationTasks = TaskGroup::create("AnimWorker", [this](UINT32 idx) { evaluateBatch(idx); }, numBatches);
 
-			SPtr<Task> task = Task::create("AnimWorker", evaluateAnimWorker);
-			TaskScheduler::instance().addTask(task);
-
-			if (anim->skeleton != nullptr)
-				curBoneIdx += anim->skeleton->getNumBones();
+			TaskScheduler::instance().addTaskGroup(mEvaluationTasks);
 		}
 
 		// Wait for tasks to complete
 		if(!async)
 		{
+			if(mEvaluationTasks)
 			{
-				Lock lock(mMutex);
-
-				while (mNumActiveWorkers > 0)
-					mWorkerDoneSignal.wait(lock);
+				mEvaluationTasks->wait();
+				mEvaluationTasks = nullptr;
 			}
 
 			// Trigger events and update attachments (for the data we just evaluated)
@@ -168,7 +220,87 @@ namespace bs
 			return &mAnimData[mPoseReadBufferIdx];
 	}
 
-	void AnimationManager::evaluateAnimation(AnimationProxy* anim, UINT32& curBoneIdx)
+	const AnimationLODTier& AnimationManager::findLODTier(const AABox& bounds) const
+	{
+		const Vector3 center = bounds.getCenter();
+		const float radius = bounds.getRadius();
+
+		float screenSize = 0.0f;
+		for(auto& view : mLODViews)
+		{
+			float viewScreenSize = radius * view.projectionScale;
+			if(view.perspective)
+				viewScreenSize /= std::max(center.distance(view.position), radius);
+
+			screenSize = std::max(screenSize, viewScreenSize);
+		}
+
+		for(auto& tier : mEvaluationLODTiers)
+		{
+			if(screenSize >= tier.minScreenSize)
+				return tier;
+		}
+
+		return mEvaluationLODTiers.back();
+	}
+
+	void AnimationManager::createBatches()
+	{
+		mBatchStarts.clear();
+
+		const auto numProxies = (UINT32)mProxies.size();
+		if (numProxies == 0)
+		{
+			mBatchStarts.push_back(0);
+			return;
+		}
+
+		UINT32 totalCost = 0;
+		for (auto& anim : mProxies)
+			totalCost += getEvaluationCost(*anim);
+
+		// Aim for a few batches per worker, so workers that finish early can pick up the remaining ones
+		const UINT32 numWorkers = std::max(1U, TaskScheduler::instance().getNumWorkers());
+		const UINT32 targetCost = std::max(MIN_BATCH_COST, Math::divideAndRoundUp(totalCost, numWorkers * 4));
+
+		UINT32 batchCost = 0;
+		mBatchStarts.push_back(0);
+		for (UINT32 i = 0; i < numProxies; i++)
+		{
+			batchCost += getEvaluationCost(*mProxies[i]);
+
+			if (batchCost >= targetCost && (i + 1) < numProxies)
+			{
+				mBatchStarts.push_back(i + 1);
+				batchCost = 0;
+			}
+		}
+
+		mBatchStarts.push_back(numProxies);
+	}
+
+	void AnimationManager::evaluateBatch(UINT32 batchIdx)
+	{
+		const UINT32 start = mBatchStarts[batchIdx];
+		const UINT32 end = mBatchStarts[batchIdx + 1];
+
+		for (UINT32 i = start; i < end; i++)
+			evaluateAnimation(mProxies[i].get(), mProxyBoneStarts[i], mEvaluationOutputs[i]);
+
+		// Last batch to complete publishes the results, so no locking is required while evaluating
+		if (mNumRemainingBatches.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
+			for (UINT32 i = 0; i < (UINT32)mEvaluationOutputs.size(); i++)
+			{
+				const EvaluationOutput& output = mEvaluationOutputs[i];
+				if (output.valid)
+					renderData.infos[mProxies[i]->id] = output.info;
+			}
+		}
+	}
+
+	void AnimationManager::evaluateAnimation(AnimationProxy* anim, UINT32 boneIdx, EvaluationOutput& output)
 	{
 		// Culling
 		if (anim->mCullEnabled)
@@ -208,30 +340,127 @@ namespace bs
 
 			EvaluatedAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
 			poseInfo.animId = anim->id;
-			poseInfo.startIdx = curBoneIdx;
+			poseInfo.startIdx = boneIdx;
 			poseInfo.numBones = numBones;
 
-			memset(anim->skeletonPose.hasOverride, 0, sizeof(bool) * anim->skeletonPose.numBones);
-			Matrix4* boneDst = renderData.transforms.data() + curBoneIdx;
+			Matrix4* boneDst = renderData.transforms.data() + boneIdx;
 
-			// Copy transforms from mapped scene objects
-			UINT32 boneTfrmIdx = 0;
-			for (UINT32 i = 0; i < anim->numSceneObjects; i++)
+			UINT32 updateInterval = 1;
+			UINT32 skippedBoneLevels = 0;
+			if (anim->mCullEnabled && !mEvaluationLODTiers.empty())
 			{
-				const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+				const AnimationLODTier& tier = findLODTier(anim->mBounds);
+				updateInterval = tier.updateInterval;
+				skippedBoneLevels = tier.skippedBoneLevels;
+			}
+
+			LocalSkeletonPose* lodPoses = anim->lodPoses;
+			const bool hasLODPoses = lodPoses[1].numBones == numBones;
+
+			bool evaluate = true;
+			if (updateInterval > 1 && hasLODPoses)
+			{
+				anim->lodFramesSinceUpdate++;
+				evaluate = anim->lodFramesSinceUpdate >= updateInterval;
+			}
+
+			if (evaluate)
+			{
+				anim->lodFramesSinceUpdate = 0;
+
+				memset(anim->skeletonPose.hasOverride, 0, sizeof(bool) * anim->skeletonPose.numBones);
+
+				// Copy transforms from mapped scene objects
+				UINT32 boneTfrmIdx = 0;
+				for (UINT32 i = 0; i < anim->numSceneObjects; i++)
+				{
+					const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+
+					if (soInfo.boneIdx == -1)
+						continue;
+
+					boneDst[soInfo.boneIdx] = anim->sceneObjectTransforms[boneTfrmIdx];
+					anim->skeletonPose.hasOverride[soInfo.boneIdx] = true;
+					boneTfrmIdx++;
+				}
+
+				// Animate bones
+				if (skippedBoneLevels > 0)
+				{
+					if (anim->lodMaskLevels != skippedBoneLevels)
+					{
+						SkeletonMaskBuilder maskBuilder(anim->skeleton, anim->skeletonMask);
+						maskBuilder.disableLeafBones(skippedBoneLevels);
+
+						anim->lodSkeletonMask = maskBuilder.getMask();
+						anim->lodMaskLevels = skippedBoneLevels;
+					}
+
+					anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->lodSkeletonMask, anim->layers,
+						anim->numLayers);
+				}
+				else
+					anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers);
+
+				// Keep a history of evaluated local poses to interpolate between on the updates that aren't evaluated
+				if (updateInterval > 1)
+				{
+					const auto copyLocalPose = [numBones](const LocalSkeletonPose& src, LocalSkeletonPose& dst)
+					{
+						memcpy(dst.positions, src.positions, sizeof(Vector3) * numBones);
+						memcpy(dst.rotations, src.rotations, sizeof(Quaternion) * numBones);
+						memcpy(dst.scales, src.scales, sizeof(Vector3) * numBones);
+					};
 
-				if (soInfo.boneIdx == -1)
-					continue;
+					if (!hasLODPoses)
+					{
+						lodPoses[0] = LocalSkeletonPose(numBones);
+						lodPoses[1] = LocalSkeletonPose(numBones);
 
-				boneDst[soInfo.boneIdx] = anim->sceneObjectTransforms[boneTfrmIdx];
-				anim->skeletonPose.hasOverride[soInfo.boneIdx] = true;
-				boneTfrmIdx++;
+						copyLocalPose(anim->skeletonPose, lodPoses[0]);
+					}
+					else
+						std::swap(lodPoses[0], lodPoses[1]);
+
+					copyLocalPose(anim->skeletonPose, lodPoses[1]);
+				}
+				else if (hasLODPoses)
+				{
+					lodPoses[0] = LocalSkeletonPose();
+					lodPoses[1] = LocalSkeletonPose();
+				}
 			}
 
-			// Animate bones
-			anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers);
+			// Output trails the most recent evaluation by one interval, so it reaches it by the time the next one happens.
+			// Local transforms are interpolated, as blending the final bone matrices would distort rotated bones.
+			if (updateInterval > 1)
+			{
+				const float t = (anim->lodFramesSinceUpdate + 1) / (float)updateInterval;
+
+				LocalSkeletonPose& localPose = anim->skeletonPose;
+				for (UINT32 i = 0; i < numBones; i++)
+				{
+					localPose.positions[i] = Vector3::lerp(t, lodPoses[0].positions[i], lodPoses[1].positions[i]);
+					localPose.rotations[i] = Quaternion::lerp(t, lodPoses[0].rotations[i], lodPoses[1].rotations[i]);
+					localPose.scales[i] = Vector3::lerp(t, lodPoses[0].scales[i], lodPoses[1].scales[i]);
+				}
+
+				// Bones driven by scene objects always use the latest transforms
+				UINT32 boneTfrmIdx = 0;
+				for (UINT32 i = 0; i < anim->numSceneObjects; i++)
+				{
+					const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+
+					if (soInfo.boneIdx == -1)
+						continue;
+
+					boneDst[soInfo.boneIdx] = anim->sceneObjectTransforms[boneTfrmIdx];
+					boneTfrmIdx++;
+				}
+
+				anim->skeleton->getPose(boneDst, localPose);
+			}
 
-			curBoneIdx += numBones;
 			hasAnimInfo = true;
 		}
 		else
@@ -269,12 +498,25 @@ namespace bs
 			if (state.disabled)
 				continue;
 
+			const CompressedCurveCache* compressed = nullptr;
+			if (state.compressedCurves != nullptr)
+			{
+				state.compressedCurves->evaluate(state.time, state.loop, state.compressedCache);
+				compressed = &state.compressedCache;
+			}
+
 			{
 				UINT32 curveIdx = soInfo.curveIndices.position;
 				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-					anim->sceneObjectPose.positions[curveIdx] = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
+					if (compressed != nullptr)
+						anim->sceneObjectPose.positions[curveIdx] = compressed->getPositions()[curveIdx];
+					else
+					{
+						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
+						anim->sceneObjectPose.positions[curveIdx] = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
+					}
+
 					anim->sceneObjectPose.hasOverride[i * 3 + 0] = false;
 				}
 			}
@@ -283,8 +525,14 @@ namespace bs
 				UINT32 curveIdx = soInfo.curveIndices.rotation;
 				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-					anim->sceneObjectPose.rotations[curveIdx] = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
+					if (compressed != nullptr)
+						anim->sceneObjectPose.rotations[curveIdx] = compressed->getRotations()[curveIdx];
+					else
+					{
+						const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+						anim->sceneObjectPose.rotations[curveIdx] = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
+					}
+
 					anim->sceneObjectPose.rotations[curveIdx].normalize();
 					anim->sceneObjectPose.hasOverride[i * 3 + 1] = false;
 				}
@@ -294,8 +542,14 @@ namespace bs
 				UINT32 curveIdx = soInfo.curveIndices.scale;
 				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-					anim->sceneObjectPose.scales[curveIdx] = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
+					if (compressed != nullptr)
+						anim->sceneObjectPose.scales[curveIdx] = compressed->getScales()[curveIdx];
+					else
+					{
+						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
+						anim->sceneObjectPose.scales[curveIdx] = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
+					}
+
 					anim->sceneObjectPose.hasOverride[i * 3 + 2] = false;
 				}
 			}
@@ -509,8 +763,8 @@ namespace bs
 
 		if (hasAnimInfo)
 		{
-			Lock lock(mMutex);
-			renderData.infos[anim->id] = animInfo;
+			output.info = animInfo;
+			output.valid = true;
 		}
 	}
 
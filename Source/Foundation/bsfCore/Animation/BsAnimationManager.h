@@ -50,6 +50,32 @@ namespace bs
 		Vector<Matrix4> transforms;
 	};
 
+	/**
+	 * Level of detail tier for animation evaluation. Animations that appear smaller on screen can be evaluated less
+	 * often and with fewer bones.
+	 */
+	struct AnimationLODTier
+	{
+		/**
+		 * Minimum screen size required for an animation to use this tier. Screen size is the radius of the animation's
+		 * bounds, relative to half of the viewport height of the camera it appears largest in.
+		 */
+		float minScreenSize = 0.0f;
+
+		/**
+		 * Determines how often is skeletal animation evaluated, in animation updates. For example a value of 3 evaluates
+		 * the animation every third update. Poses for the updates in between are interpolated from the two most recently
+		 * evaluated poses, which delays the animation by one interval.
+		 */
+		UINT32 updateInterval = 1;
+
+		/**
+		 * Number of bone levels, starting from the leaf bones of the skeleton, that are not animated. Skipped bones
+		 * remain in their bind pose relative to their parent.
+		 */
+		UINT32 skippedBoneLevels = 0;
+	};
+
 	/**
 	 * Keeps track of all active animations, queues animation thread tasks and synchronizes data between simulation, core
 	 * and animation threads.
@@ -58,6 +84,7 @@ namespace bs
 	{
 	public:
 		AnimationManager();
+		~AnimationManager();
 
 		/** Pauses or resumes the animation evaluation. */
 		void setPaused(bool paused);
@@ -70,6 +97,19 @@ namespace bs
 		 */
 		void setUpdateRate(UINT32 fps);
 
+		/**
+		 * Enables or disables animation level of detail. When enabled, animations with culling enabled pick one of the
+		 * tiers provided to setLODTiers() depending on how large they appear on screen. Disabled by default.
+		 */
+		void setLODEnabled(bool enabled);
+
+		/**
+		 * Sets the level of detail tiers to choose from when animation level of detail is enabled. Each animation uses
+		 * the first tier with the largest minimum screen size it satisfies, or the tier with the lowest minimum screen size
+		 * if it satisfies none.
+		 */
+		void setLODTiers(const Vector<AnimationLODTier>& tiers);
+
 		/**
 		 * Evaluates animations for all animated objects, and returns the evaluated skeleton bone poses and morph shape
 		 * meshes that can be passed along to the renderer.
@@ -105,14 +145,39 @@ namespace bs
 		/** Unregisters an animation with the specified ID. Must be called before an Animation is destroyed. */
 		void unregisterAnimation(UINT64 id);
 
+		/** Information about an evaluated animation, to be written to EvaluatedAnimationData once evaluation completes. */
+		struct EvaluationOutput
+		{
+			EvaluatedAnimationData::AnimInfo info;
+			bool valid = false;
+		};
+
 		/**
-		 * Evaluates animation for a single object and writes the result in the currently active write buffer.
+		 * Evaluates animation for a single object and writes the bone transforms in the currently active write buffer.
 		 *
 		 * @param[in]	anim		Proxy representing the animation to evaluate.
-		 * @param[in]	boneIdx		Index in the output buffer in which to write evaluated bone information. This will be
-		 *							automatically advanced by the number of written bone transforms.
+		 * @param[in]	boneIdx		Index in the output buffer in which to write evaluated bone information.
+		 * @param[out]	output		Information about the evaluated animation. Left unchanged if the animation was culled.
+		 */
+		void evaluateAnimation(AnimationProxy* anim, UINT32 boneIdx, EvaluationOutput& output);
+
+		/**
+		 * Picks a level of detail tier for an animation with the provided world space bounds, depending on how large it
+		 * appears in the currently active cameras.
+		 */
+		const AnimationLODTier& findLODTier(const AABox& bounds) const;
+
+		/**
+		 * Splits the current set of animation proxies into batches of roughly equal evaluation cost, depending on the
+		 * number of bones they need to evaluate. Populates @p mBatchStarts.
+		 */
+		void createBatches();
+
+		/**
+		 * Evaluates all animations in the batch with the provided index. The last batch to finish moves the evaluation
+		 * outputs into the currently active write buffer.
 		 */
-		void evaluateAnimation(AnimationProxy* anim, UINT32& boneIdx);
+		void evaluateBatch(UINT32 batchIdx);
 
 		UINT64 mNextId = 1;
 		UnorderedMap<UINT64, Animation*> mAnimations;
@@ -124,20 +189,40 @@ namespace bs
 		float mLastAnimationDeltaTime = 0.0f;
 		bool mPaused = false;
 
+		bool mLODEnabled = false;
+		Vector<AnimationLODTier> mLODTiers;
+
 		SPtr<VertexDataDesc> mBlendShapeVertexDesc;
 
 		// Animation thread
 		Vector<SPtr<AnimationProxy>> mProxies;
+		Vector<UINT32> mProxyBoneStarts;
+		Vector<EvaluationOutput> mEvaluationOutputs;
+		Vector<UINT32> mBatchStarts; /**< Index of the first proxy in each batch, followed by the total number of proxies. */
 		Vector<ConvexVolume> mCullFrustums;
+
+		/**
+		 * Copy of @p mLODTiers taken before evaluation starts, so the tiers can be changed while evaluation is running.
+		 * Empty if level of detail is disabled.
+		 */
+		Vector<AnimationLODTier> mEvaluationLODTiers;
+
+		/** Information about a camera required for calculating the screen size of animations. */
+		struct LODView
+		{
+			Vector3 position;
+			float projectionScale;
+			bool perspective;
+		};
+
+		Vector<LODView> mLODViews;
 		EvaluatedAnimationData mAnimData[CoreThread::NUM_SYNC_BUFFERS + 1];
 
 		UINT32 mPoseReadBufferIdx = 2;
 		UINT32 mPoseWriteBufferIdx = 0;
-		
-		Signal mWorkerDoneSignal;
-		Mutex mMutex;
 
-		UINT32 mNumActiveWorkers = 0;
+		SPtr<TaskGroup> mEvaluationTasks;
+		std::atomic<UINT32> mNumRemainingBatches{0};
 		bool mSwapBuffers = false;
 	};
 
@@ -0,0 +1,701 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Animation/BsCompressedAnimationCurves.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationUtility.h"
+#include "Private/RTTI/BsCompressedAnimationCurvesRTTI.h"
+#include "Math/BsSIMD.h"
+
+namespace bs
+{
+	/** Number of tracks interpolated at once. */
+	static constexpr UINT32 SIMD_WIDTH = 4;
+
+	/** Largest quantized value of a position or scale component. */
+	static constexpr UINT32 VECTOR_QUANTIZED_MAX = 0xFFFF;
+
+	/** Largest quantized value of a rotation component. Top bit is reserved for the index of the largest component. */
+	static constexpr UINT32 ROTATION_QUANTIZED_MAX = 0x7FFF;
+
+	/** Three smallest components of a normalized quaternion are always in range [-1/sqrt(2), 1/sqrt(2)]. */
+	static constexpr float ROTATION_COMPONENT_RANGE = 0.70710678f;
+
+	/** Value of an animation track at a specific time. */
+	template<class T>
+	struct TrackSample
+	{
+		float time;
+		T value;
+	};
+
+	/** Linearly interpolates between two values of a compressed track. */
+	static Vector3 interpolate(const Vector3& a, const Vector3& b, float t)
+	{
+		return a + (b - a) * t;
+	}
+
+	/** Interpolates between two values of a compressed track along the shortest path, and normalizes the result. */
+	static Quaternion interpolate(const Quaternion& a, const Quaternion& b, float t)
+	{
+		const Quaternion target = a.dot(b) < 0.0f ? -b : b;
+
+		Quaternion output = a * (1.0f - t) + target * t;
+		output.normalize();
+
+		return output;
+	}
+
+	/** Returns the distance between two positions. */
+	static float getPositionError(const Vector3& a, const Vector3& b)
+	{
+		return a.distance(b);
+	}
+
+	/** Returns the angle between two rotations, in radians. */
+	static float getRotationError(const Quaternion& a, const Quaternion& b)
+	{
+		Quaternion normA = a;
+		normA.normalize();
+
+		Quaternion normB = b;
+		normB.normalize();
+
+		// Calculated from the distance between the quaternions, as acos() of their dot product is imprecise for small
+		// angles. Both q and -q represent the same rotation.
+		const Quaternion diff = normA.dot(normB) < 0.0f ? normA + normB : normA - normB;
+		const float halfDistance = std::min(1.0f, std::sqrt(diff.dot(diff)) * 0.5f);
+
+		return 4.0f * Math::asin(halfDistance).valueRadians();
+	}
+
+	/** Returns the largest difference between the components of two scales. */
+	static float getScaleError(const Vector3& a, const Vector3& b)
+	{
+		return std::max(std::max(Math::abs(a.x - b.x), Math::abs(a.y - b.y)), Math::abs(a.z - b.z));
+	}
+
+	/** Value of a track with no keys, matching the value returned by TAnimationCurve. */
+	template<class T>
+	static T getEmptyValue() { return T(BsZero); }
+
+	template<>
+	Quaternion getEmptyValue<Quaternion>() { return Quaternion::ZERO; }
+
+	/**
+	 * Returns the largest error introduced by quantizing the values of a position or scale track containing the provided
+	 * samples. Values are rounded to the nearest quantization step, so they are off by at most half a step.
+	 */
+	template<class ErrorFunc>
+	static float getQuantizationError(const Vector<TrackSample<Vector3>>& samples, ErrorFunc getError)
+	{
+		Vector3 min = samples[0].value;
+		Vector3 max = samples[0].value;
+		for(auto& sample : samples)
+		{
+			min.min(sample.value);
+			max.max(sample.value);
+		}
+
+		const Vector3 halfStep = (max - min) / (float)VECTOR_QUANTIZED_MAX * 0.5f;
+		return getError(min, min + halfStep);
+	}
+
+	/** Returns the largest error introduced by quantizing the values of a rotation track, in radians. */
+	template<class ErrorFunc>
+	static float getQuantizationError(const Vector<TrackSample<Quaternion>>& samples, ErrorFunc getError)
+	{
+		// Each of the three stored components is off by at most half a step. The reconstructed largest component is at
+		// least 1/2, which limits its error to sqrt(3) times the error of the stored components, so the quaternion is off
+		// by at most twice that. The angle between two close rotations is roughly twice the distance between their
+		// quaternions.
+		const float halfStep = ROTATION_COMPONENT_RANGE / ROTATION_QUANTIZED_MAX;
+		const float distance = 2.0f * std::sqrt(3.0f) * halfStep;
+
+		return 2.0f * distance;
+	}
+
+	/**
+	 * Replaces the curve with linear segments between samples of the curve, using as few samples as the provided error
+	 * tolerance allows. Part of the tolerance is reserved for the error introduced by quantizing the values later. The
+	 * returned track always has at least two keys, the first at @p start and the last at @p end.
+	 */
+	template<class T, class ErrorFunc>
+	static Vector<TrackSample<T>> reduceKeys(const TAnimationCurve<T>& curve, float start, float end, float tolerance,
+		ErrorFunc getError)
+	{
+		// Number of samples taken per segment between two original keys, since the original curve isn't linear
+		static constexpr UINT32 SAMPLES_PER_SEGMENT = 4;
+
+		Vector<TrackSample<T>> output;
+
+		const Vector<TKeyframe<T>>& keyframes = curve.getKeyFrames();
+		const auto numKeys = (UINT32)keyframes.size();
+		if(numKeys == 0)
+		{
+			output.push_back({ start, getEmptyValue<T>() });
+			output.push_back({ end, getEmptyValue<T>() });
+
+			return output;
+		}
+
+		// Samples are candidates for the output keys. They include all the original keys.
+		Vector<TrackSample<T>> samples;
+		samples.reserve((numKeys - 1) * SAMPLES_PER_SEGMENT + 1);
+		for(UINT32 i = 0; i < numKeys; i++)
+		{
+			samples.push_back({ keyframes[i].time, keyframes[i].value });
+
+			if((i + 1) < numKeys)
+			{
+				const float segmentStart = keyframes[i].time;
+				const float segmentLength = keyframes[i + 1].time - segmentStart;
+
+				for(UINT32 j = 1; j < SAMPLES_PER_SEGMENT; j++)
+				{
+					const float time = segmentStart + segmentLength * (j / (float)SAMPLES_PER_SEGMENT);
+					samples.push_back({ time, curve.evaluate(time, false) });
+				}
+			}
+		}
+
+		const auto numSamples = (UINT32)samples.size();
+
+		// Error is checked at every sample and at the midpoints between them. Sample i is at index 2 * i.
+		Vector<TrackSample<T>> checkPoints;
+		checkPoints.reserve(numSamples * 2 - 1);
+		for(UINT32 i = 0; i < numSamples; i++)
+		{
+			checkPoints.push_back(samples[i]);
+
+			if((i + 1) < numSamples)
+			{
+				const float time = (samples[i].time + samples[i + 1].time) * 0.5f;
+				checkPoints.push_back({ time, curve.evaluate(time, false) });
+			}
+		}
+
+		const float budget = std::max(0.0f, tolerance - getQuantizationError(samples, getError));
+
+		// Checks if samples between the two provided samples can be removed
+		auto canInterpolate = [&](UINT32 from, UINT32 to)
+		{
+			const float fromTime = samples[from].time;
+			const float length = samples[to].time - fromTime;
+
+			for(UINT32 i = from * 2 + 1; i < to * 2; i++)
+			{
+				const float t = length > 0.0f ? (checkPoints[i].time - fromTime) / length : 1.0f;
+				if(getError(interpolate(samples[from].value, samples[to].value, t), checkPoints[i].value) > budget)
+					return false;
+			}
+
+			return true;
+		};
+
+		// Constant tracks are very common (e.g. scale), handle them without searching
+		const T& firstValue = samples[0].value;
+		bool isConstant = true;
+		for(auto& entry : checkPoints)
+		{
+			if(getError(firstValue, entry.value) > budget)
+			{
+				isConstant = false;
+				break;
+			}
+		}
+
+		if(isConstant)
+			output.push_back(samples[0]);
+		else
+		{
+			// Greedily extend each linear segment as far as the tolerance allows
+			UINT32 anchor = 0;
+			output.push_back(samples[0]);
+
+			while((anchor + 1) < numSamples)
+			{
+				UINT32 next = anchor + 1;
+				while((next + 1) < numSamples && canInterpolate(anchor, next + 1))
+					next++;
+
+				output.push_back(samples[next]);
+				anchor = next;
+			}
+		}
+
+		// All tracks share the same time range, the original curve clamps to its end values outside of its own range
+		if(output.front().time > start)
+			output.insert(output.begin(), { start, output.front().value });
+
+		if(output.back().time < end || output.size() < 2)
+			output.push_back({ end, output.back().value });
+
+		return output;
+	}
+
+	/** Quantizes the values of a position or scale track. */
+	static void quantizeTrack(const Vector<TrackSample<Vector3>>& samples, UINT16 track,
+		Vector<CompressedAnimationKey>& keys, CompressedTrackRange& range)
+	{
+		Vector3 min = samples[0].value;
+		Vector3 max = samples[0].value;
+		for(auto& sample : samples)
+		{
+			min.min(sample.value);
+			max.max(sample.value);
+		}
+
+		range.min = min;
+		range.step = (max - min) / (float)VECTOR_QUANTIZED_MAX;
+
+		for(auto& sample : samples)
+		{
+			CompressedAnimationKey key;
+			key.time = sample.time;
+			key.track = track;
+
+			for(UINT32 i = 0; i < 3; i++)
+			{
+				UINT32 value = 0;
+				if(range.step[i] > 0.0f)
+				{
+					const float normalized = (sample.value[i] - min[i]) / range.step[i];
+					value = (UINT32)Math::clamp(Math::roundToInt(normalized), 0, (INT32)VECTOR_QUANTIZED_MAX);
+				}
+
+				key.value[i] = (UINT16)value;
+			}
+
+			keys.push_back(key);
+		}
+	}
+
+	/** Quantizes the values of a rotation track. */
+	static void quantizeTrack(const Vector<TrackSample<Quaternion>>& samples, UINT16 track,
+		Vector<CompressedAnimationKey>& keys)
+	{
+		for(auto& sample : samples)
+		{
+			Quaternion value = sample.value;
+			if(value.dot(value) > 0.0f)
+				value.normalize();
+			else
+				value = Quaternion::IDENTITY;
+
+			UINT32 largest = 0;
+			for(UINT32 i = 1; i < 4; i++)
+			{
+				if(Math::abs(value[i]) > Math::abs(value[largest]))
+					largest = i;
+			}
+
+			// q and -q represent the same rotation, flip so the omitted component is always positive
+			if(value[largest] < 0.0f)
+				value = -value;
+
+			CompressedAnimationKey key;
+			key.time = sample.time;
+			key.track = track;
+
+			UINT32 componentIdx = 0;
+			for(UINT32 i = 0; i < 4; i++)
+			{
+				if(i == largest)
+					continue;
+
+				const float normalized = (value[i] / ROTATION_COMPONENT_RANGE) * 0.5f + 0.5f;
+				const INT32 quantized = Math::roundToInt(normalized * ROTATION_QUANTIZED_MAX);
+
+				key.value[componentIdx++] = (UINT16)Math::clamp(quantized, 0, (INT32)ROTATION_QUANTIZED_MAX);
+			}
+
+			key.value[0] |= (UINT16)((largest & 0x1) << 15);
+			key.value[1] |= (UINT16)((largest >> 1) << 15);
+
+			keys.push_back(key);
+		}
+	}
+
+	/**
+	 * Interleaves keys of all tracks into a single stream. The stream starts with the first, and then the second key
+	 * of every track. The remaining keys are sorted by the time they are needed at, which is the time of the previous
+	 * key in the same track.
+	 */
+	static void interleaveTracks(const Vector<Vector<CompressedAnimationKey>>& tracks,
+		Vector<CompressedAnimationKey>& output)
+	{
+		struct PendingKey
+		{
+			float neededTime;
+			UINT32 track;
+			UINT32 key;
+		};
+
+		Vector<PendingKey> pendingKeys;
+		for(UINT32 i = 0; i < 2; i++)
+		{
+			for(auto& track : tracks)
+				output.push_back(track[i]);
+		}
+
+		for(UINT32 i = 0; i < (UINT32)tracks.size(); i++)
+		{
+			for(UINT32 j = 2; j < (UINT32)tracks[i].size(); j++)
+				pendingKeys.push_back({ tracks[i][j - 1].time, i, j });
+		}
+
+		std::sort(pendingKeys.begin(), pendingKeys.end(), [](const PendingKey& a, const PendingKey& b)
+		{
+			if(a.neededTime != b.neededTime)
+				return a.neededTime < b.neededTime;
+
+			if(a.track != b.track)
+				return a.track < b.track;
+
+			return a.key < b.key;
+		});
+
+		for(auto& entry : pendingKeys)
+			output.push_back(tracks[entry.track][entry.key]);
+	}
+
+	/**
+	 * Calculates the interpolation factor between the left and right keys of four tracks. Tracks where both keys are
+	 * at the same time use the right key.
+	 */
+	static simd::float32x4 getInterpolationFactor(const float* leftTime, const float* rightTime,
+		const simd::float32x4& time)
+	{
+		const simd::float32x4 zero = simd::splat(0.0f);
+		const simd::float32x4 one = simd::splat(1.0f);
+
+		const simd::float32x4 left = simd::load_u<simd::float32x4>(leftTime);
+		const simd::float32x4 length = simd::sub(simd::load_u<simd::float32x4>(rightTime), left);
+
+		simd::float32x4 factor = simd::div(simd::sub(time, left), length);
+		factor = simd::blend(factor, one, simd::cmp_gt(length, zero));
+
+		return simd::min(simd::max(factor, zero), one);
+	}
+
+	template<UINT32 NumComponents>
+	void CompressedCurveCache::TrackKeys<NumComponents>::resize(UINT32 numTracks)
+	{
+		const UINT32 paddedNumTracks = Math::divideAndRoundUp(numTracks, SIMD_WIDTH) * SIMD_WIDTH;
+
+		// Padding tracks are never output, but keep them at valid values
+		leftTime.assign(paddedNumTracks, 0.0f);
+		rightTime.assign(paddedNumTracks, 1.0f);
+
+		for(UINT32 i = 0; i < NumComponents; i++)
+		{
+			left[i].assign(paddedNumTracks, 1.0f);
+			right[i].assign(paddedNumTracks, 1.0f);
+		}
+	}
+
+	SPtr<CompressedAnimationCurves> CompressedAnimationCurves::create(const AnimationCurves& curves,
+		const AnimationCompressionSettings& settings)
+	{
+		const auto numPositionCurves = (UINT32)curves.position.size();
+		const auto numRotationCurves = (UINT32)curves.rotation.size();
+		const auto numScaleCurves = (UINT32)curves.scale.size();
+
+		// Track indices are stored in 16 bits
+		const UINT32 numVectorTracks = numPositionCurves + numScaleCurves;
+		const UINT32 maxTracks = std::numeric_limits<UINT16>::max();
+		if(numVectorTracks > maxTracks || numRotationCurves > maxTracks)
+			return nullptr;
+
+		// Compressed tracks share the same time range
+		float start = std::numeric_limits<float>::infinity();
+		float end = -std::numeric_limits<float>::infinity();
+
+		auto updateTimeRange = [&](const auto& namedCurves)
+		{
+			for(auto& entry : namedCurves)
+			{
+				if(entry.curve.getNumKeyFrames() == 0)
+					continue;
+
+				std::pair<float, float> range = entry.curve.getTimeRange();
+				start = std::min(start, range.first);
+				end = std::max(end, range.second);
+			}
+		};
+
+		updateTimeRange(curves.position);
+		updateTimeRange(curves.rotation);
+		updateTimeRange(curves.scale);
+
+		if(start > end)
+		{
+			start = 0.0f;
+			end = 0.0f;
+		}
+
+		SPtr<CompressedAnimationCurves> output = bs_shared_ptr_new<CompressedAnimationCurves>();
+		output->mNumPositionCurves = numPositionCurves;
+		output->mNumRotationCurves = numRotationCurves;
+		output->mNumScaleCurves = numScaleCurves;
+		output->mStart = start;
+		output->mEnd = end;
+
+		// Position and scale tracks
+		{
+			Vector<Vector<CompressedAnimationKey>> tracks(numVectorTracks);
+			output->mVectorRanges.resize(numVectorTracks);
+
+			for(UINT32 i = 0; i < numVectorTracks; i++)
+			{
+				Vector<TrackSample<Vector3>> samples;
+				if(i < numPositionCurves)
+				{
+					samples = reduceKeys(curves.position[i].curve, start, end, settings.positionError,
+						&getPositionError);
+				}
+				else
+				{
+					samples = reduceKeys(curves.scale[i - numPositionCurves].curve, start, end, settings.scaleError,
+						&getScaleError);
+				}
+
+				quantizeTrack(samples, (UINT16)i, tracks[i], output->mVectorRanges[i]);
+			}
+
+			interleaveTracks(tracks, output->mVectorKeys);
+		}
+
+		// Rotation tracks
+		{
+			Vector<Vector<CompressedAnimationKey>> tracks(numRotationCurves);
+			for(UINT32 i = 0; i < numRotationCurves; i++)
+			{
+				Vector<TrackSample<Quaternion>> samples = reduceKeys(curves.rotation[i].curve, start, end,
+					settings.rotationError, &getRotationError);
+
+				quantizeTrack(samples, (UINT16)i, tracks[i]);
+			}
+
+			interleaveTracks(tracks, output->mRotationKeys);
+		}
+
+		return output;
+	}
+
+	void CompressedAnimationCurves::evaluate(float time, bool loop, const CompressedCurveCache& cache) const
+	{
+		AnimationUtility::wrapTime(time, mStart, mEnd, loop);
+
+		// Already evaluated at this time (e.g. when the same clip drives both bones and scene objects)
+		if(cache.mInitialized && time == cache.mTime)
+			return;
+
+		// Keys can only be decompressed going forward, start over when going back in time (e.g. when looping)
+		if(!cache.mInitialized || time < cache.mTime)
+			resetCache(cache);
+
+		advanceCache(time, cache);
+		cache.mTime = time;
+
+		const simd::float32x4 timeVec = simd::splat(time);
+
+		// Position and scale tracks
+		const UINT32 numVectorTracks = mNumPositionCurves + mNumScaleCurves;
+		const CompressedCurveCache::TrackKeys<3>& vectorKeys = cache.mVectorKeys;
+		for(UINT32 i = 0; i < numVectorTracks; i += SIMD_WIDTH)
+		{
+			const simd::float32x4 factor = getInterpolationFactor(&vectorKeys.leftTime[i], &vectorKeys.rightTime[i],
+				timeVec);
+
+			simd::float32x4 values[3];
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				const simd::float32x4 left = simd::load_u<simd::float32x4>(&vectorKeys.left[j][i]);
+				const simd::float32x4 right = simd::load_u<simd::float32x4>(&vectorKeys.right[j][i]);
+
+				values[j] = simd::add(left, simd::mul(simd::sub(right, left), factor));
+			}
+
+			alignas(16) float output[SIMD_WIDTH * 3];
+			simd::store_packed3(output, values[0], values[1], values[2]);
+
+			const UINT32 numLanes = std::min(SIMD_WIDTH, numVectorTracks - i);
+			for(UINT32 j = 0; j < numLanes; j++)
+			{
+				const UINT32 trackIdx = i + j;
+
+				Vector3* dst;
+				if(trackIdx < mNumPositionCurves)
+					dst = &cache.mPositions[trackIdx];
+				else
+					dst = &cache.mScales[trackIdx - mNumPositionCurves];
+
+				memcpy(dst, &output[j * 3], sizeof(Vector3));
+			}
+		}
+
+		// Rotation tracks
+		const simd::float32x4 zero = simd::splat(0.0f);
+		const simd::float32x4 one = simd::splat(1.0f);
+
+		const CompressedCurveCache::TrackKeys<4>& rotationKeys = cache.mRotationKeys;
+		for(UINT32 i = 0; i < mNumRotationCurves; i += SIMD_WIDTH)
+		{
+			const simd::float32x4 factor = getInterpolationFactor(&rotationKeys.leftTime[i],
+				&rotationKeys.rightTime[i], timeVec);
+
+			simd::float32x4 left[4];
+			simd::float32x4 right[4];
+			simd::float32x4 dot = zero;
+			for(UINT32 j = 0; j < 4; j++)
+			{
+				left[j] = simd::load_u<simd::float32x4>(&rotationKeys.left[j][i]);
+				right[j] = simd::load_u<simd::float32x4>(&rotationKeys.right[j][i]);
+
+				dot = simd::add(dot, simd::mul(left[j], right[j]));
+			}
+
+			// Interpolate along the shortest path
+			const simd::mask_float32x4 flip = simd::cmp_lt(dot, zero);
+
+			simd::float32x4 values[4];
+			simd::float32x4 lengthSqrd = zero;
+			for(UINT32 j = 0; j < 4; j++)
+			{
+				const simd::float32x4 target = simd::blend(simd::neg(right[j]), right[j], flip);
+
+				values[j] = simd::add(left[j], simd::mul(simd::sub(target, left[j]), factor));
+				lengthSqrd = simd::add(lengthSqrd, simd::mul(values[j], values[j]));
+			}
+
+			const simd::float32x4 invLength = simd::div(one, simd::sqrt(lengthSqrd));
+			for(UINT32 j = 0; j < 4; j++)
+				values[j] = simd::mul(values[j], invLength);
+
+			alignas(16) float output[SIMD_WIDTH * 4];
+			simd::store_packed4(output, values[0], values[1], values[2], values[3]);
+
+			const UINT32 numLanes = std::min(SIMD_WIDTH, mNumRotationCurves - i);
+			memcpy(&cache.mRotations[i], output, sizeof(Quaternion) * numLanes);
+		}
+	}
+
+	void CompressedAnimationCurves::resetCache(const CompressedCurveCache& cache) const
+	{
+		const UINT32 numVectorTracks = mNumPositionCurves + mNumScaleCurves;
+
+		cache.mVectorKeys.resize(numVectorTracks);
+		cache.mRotationKeys.resize(mNumRotationCurves);
+
+		cache.mPositions.resize(mNumPositionCurves);
+		cache.mRotations.resize(mNumRotationCurves);
+		cache.mScales.resize(mNumScaleCurves);
+
+		// Stream starts with two keys per track
+		for(UINT32 i = 0; i < numVectorTracks * 2; i++)
+			pushVectorKey(mVectorKeys[i], cache);
+
+		for(UINT32 i = 0; i < mNumRotationCurves * 2; i++)
+			pushRotationKey(mRotationKeys[i], cache);
+
+		cache.mVectorCursor = numVectorTracks * 2;
+		cache.mRotationCursor = mNumRotationCurves * 2;
+		cache.mTime = mStart;
+		cache.mInitialized = true;
+	}
+
+	void CompressedAnimationCurves::advanceCache(float time, const CompressedCurveCache& cache) const
+	{
+		// Keys are sorted by the time they are needed at, which is when time passes the right key of their track
+		const auto numVectorKeys = (UINT32)mVectorKeys.size();
+		while(cache.mVectorCursor < numVectorKeys)
+		{
+			const CompressedAnimationKey& key = mVectorKeys[cache.mVectorCursor];
+			if(cache.mVectorKeys.rightTime[key.track] >= time)
+				break;
+
+			pushVectorKey(key, cache);
+			cache.mVectorCursor++;
+		}
+
+		const auto numRotationKeys = (UINT32)mRotationKeys.size();
+		while(cache.mRotationCursor < numRotationKeys)
+		{
+			const CompressedAnimationKey& key = mRotationKeys[cache.mRotationCursor];
+			if(cache.mRotationKeys.rightTime[key.track] >= time)
+				break;
+
+			pushRotationKey(key, cache);
+			cache.mRotationCursor++;
+		}
+	}
+
+	void CompressedAnimationCurves::pushVectorKey(const CompressedAnimationKey& key,
+		const CompressedCurveCache& cache) const
+	{
+		CompressedCurveCache::TrackKeys<3>& keys = cache.mVectorKeys;
+		const CompressedTrackRange& range = mVectorRanges[key.track];
+
+		keys.leftTime[key.track] = keys.rightTime[key.track];
+		keys.rightTime[key.track] = key.time;
+
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			keys.left[i][key.track] = keys.right[i][key.track];
+			keys.right[i][key.track] = range.min[i] + key.value[i] * range.step[i];
+		}
+	}
+
+	void CompressedAnimationCurves::pushRotationKey(const CompressedAnimationKey& key,
+		const CompressedCurveCache& cache) const
+	{
+		CompressedCurveCache::TrackKeys<4>& keys = cache.mRotationKeys;
+
+		keys.leftTime[key.track] = keys.rightTime[key.track];
+		keys.rightTime[key.track] = key.time;
+
+		const UINT32 largest = (key.value[0] >> 15) | ((key.value[1] >> 15) << 1);
+
+		float components[3];
+		float lengthSqrd = 0.0f;
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			const float normalized = (key.value[i] & ROTATION_QUANTIZED_MAX) / (float)ROTATION_QUANTIZED_MAX;
+			components[i] = (normalized * 2.0f - 1.0f) * ROTATION_COMPONENT_RANGE;
+
+			lengthSqrd += components[i] * components[i];
+		}
+
+		UINT32 componentIdx = 0;
+		for(UINT32 i = 0; i < 4; i++)
+		{
+			keys.left[i][key.track] = keys.right[i][key.track];
+
+			if(i == largest)
+				keys.right[i][key.track] = std::sqrt(std::max(0.0f, 1.0f - lengthSqrd));
+			else
+				keys.right[i][key.track] = components[componentIdx++];
+		}
+	}
+
+	UINT32 CompressedAnimationCurves::getMemorySize() const
+	{
+		size_t size = sizeof(CompressedAnimationCurves);
+		size += mVectorKeys.size() * sizeof(CompressedAnimationKey);
+		size += mRotationKeys.size() * sizeof(CompressedAnimationKey);
+		size += mVectorRanges.size() * sizeof(CompressedTrackRange);
+
+		return (UINT32)size;
+	}
+
+	RTTITypeBase* CompressedAnimationCurves::getRTTIStatic()
+	{
+		return CompressedAnimationCurvesRTTI::instance();
+	}
+
+	RTTITypeBase* CompressedAnimationCurves::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+}
@@ -0,0 +1,191 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Reflection/BsIReflectable.h"
+#include "Math/BsVector3.h"
+#include "Math/BsQuaternion.h"
+
+namespace bs
+{
+	struct AnimationCurves;
+
+	/** @addtogroup Animation-Internal
+	 *  @{
+	 */
+
+	/** Determines how much can compressed animation curves deviate from the curves they were created from. */
+	struct AnimationCompressionSettings
+	{
+		/** Maximum distance between the original and the compressed position, in the units of the curve. */
+		float positionError = 0.0005f;
+
+		/** Maximum angle between the original and the compressed rotation, in radians. */
+		float rotationError = 0.0005f;
+
+		/** Maximum difference between any component of the original and the compressed scale. */
+		float scaleError = 0.0005f;
+	};
+
+	/** Single keyframe of a compressed animation track. */
+	struct CompressedAnimationKey
+	{
+		float time; /**< Time of the key, in seconds. */
+		UINT16 track; /**< Index of the track the key belongs to. */
+
+		/**
+		 * Quantized value of the key. For position and scale tracks these are the components normalized to the track's
+		 * range. For rotation tracks these are the three smallest quaternion components, with the index of the largest
+		 * component stored in the top bits of the first two values.
+		 */
+		UINT16 value[3];
+	};
+
+	BS_ALLOW_MEMCPY_SERIALIZATION(CompressedAnimationKey);
+
+	/** Range of values in a compressed position or scale track, used for restoring quantized values. */
+	struct CompressedTrackRange
+	{
+		Vector3 min; /**< Value corresponding to a quantized value of zero. */
+		Vector3 step; /**< Difference in value per one quantized unit. */
+	};
+
+	BS_ALLOW_MEMCPY_SERIALIZATION(CompressedTrackRange);
+
+	/**
+	 * Holds decompressed keys and evaluated values of CompressedAnimationCurves for a single animation instance.
+	 * Sequential evaluations only need to decompress keys that were passed since the previous evaluation. You should
+	 * not use the same instance of this object for evaluating multiple different sets of compressed curves.
+	 */
+	struct BS_CORE_EXPORT CompressedCurveCache
+	{
+		/** Returns the evaluated values of the position curves, as of the last call to evaluate(). */
+		const Vector3* getPositions() const { return mPositions.data(); }
+
+		/** Returns the evaluated values of the rotation curves, as of the last call to evaluate(). */
+		const Quaternion* getRotations() const { return mRotations.data(); }
+
+		/** Returns the evaluated values of the scale curves, as of the last call to evaluate(). */
+		const Vector3* getScales() const { return mScales.data(); }
+
+	private:
+		friend class CompressedAnimationCurves;
+
+		/** Decompressed keys of a group of tracks, in structure-of-arrays layout. Track count is padded to four. */
+		template<UINT32 NumComponents>
+		struct TrackKeys
+		{
+			/** Resizes the storage for the provided number of tracks. */
+			void resize(UINT32 numTracks);
+
+			Vector<float> leftTime;
+			Vector<float> rightTime;
+			Vector<float> left[NumComponents];
+			Vector<float> right[NumComponents];
+		};
+
+		mutable bool mInitialized = false;
+		mutable float mTime = 0.0f; /**< Wrapped time the cache was last evaluated at. */
+		mutable UINT32 mVectorCursor = 0; /**< Index of the next vector key to decompress. */
+		mutable UINT32 mRotationCursor = 0; /**< Index of the next rotation key to decompress. */
+
+		mutable TrackKeys<3> mVectorKeys;
+		mutable TrackKeys<4> mRotationKeys;
+
+		mutable Vector<Vector3> mPositions;
+		mutable Vector<Quaternion> mRotations;
+		mutable Vector<Vector3> mScales;
+	};
+
+	/**
+	 * Lossy compressed version of the position, rotation and scale curves in AnimationCurves. Curves are replaced by
+	 * linear segments, using as few keys as needed to stay within the error tolerance. Position and scale values are
+	 * quantized to 16 bits per component, relative to the range of their track. Rotations are stored as their three
+	 * smallest components at 15 bits each.
+	 *
+	 * Compressed curves interpolate linearly between keys. Keys of all tracks are interleaved in a single stream,
+	 * ordered by the time at which they are first needed, so playing the animation forward reads the key data
+	 * sequentially.
+	 */
+	class BS_CORE_EXPORT CompressedAnimationCurves : public IReflectable
+	{
+	public:
+		/**
+		 * Compresses the position, rotation and scale curves in @p curves. Generic curves are not compressed. Returns
+		 * null if the curves cannot be compressed.
+		 */
+		static SPtr<CompressedAnimationCurves> create(const AnimationCurves& curves,
+			const AnimationCompressionSettings& settings = AnimationCompressionSettings());
+
+		/**
+		 * Evaluates all compressed curves at the specified time. Evaluated values can be retrieved from the cache.
+		 *
+		 * @param[in]	time	%Time to evaluate the curves at.
+		 * @param[in]	loop	If true the curves will loop when time goes past the end or beginning. Otherwise the
+		 *						curve values will be clamped.
+		 * @param[in]	cache	Cache holding decompressed keys from previous evaluations. Receives the evaluated
+		 *						values.
+		 */
+		void evaluate(float time, bool loop, const CompressedCurveCache& cache) const;
+
+		/** Returns the number of position curves. Indices match the position curves of the original AnimationCurves. */
+		UINT32 getNumPositionCurves() const { return mNumPositionCurves; }
+
+		/** Returns the number of rotation curves. Indices match the rotation curves of the original AnimationCurves. */
+		UINT32 getNumRotationCurves() const { return mNumRotationCurves; }
+
+		/** Returns the number of scale curves. Indices match the scale curves of the original AnimationCurves. */
+		UINT32 getNumScaleCurves() const { return mNumScaleCurves; }
+
+		/** Returns the time of the first and last key in the curves. */
+		std::pair<float, float> getTimeRange() const { return std::make_pair(mStart, mEnd); }
+
+		/** Returns the number of keys remaining after compression, in all curves. */
+		UINT32 getNumKeys() const { return (UINT32)(mVectorKeys.size() + mRotationKeys.size()); }
+
+		/** Returns the number of bytes used for storing the compressed curves. */
+		UINT32 getMemorySize() const;
+
+	private:
+		/** Initializes the cache with the first two keys of each track. */
+		void resetCache(const CompressedCurveCache& cache) const;
+
+		/** Decompresses the keys needed for evaluating time @p time, starting from the last key in the cache. */
+		void advanceCache(float time, const CompressedCurveCache& cache) const;
+
+		/**
+		 * Decompresses a vector key and makes it the right key of its track. Previous right key becomes the left key.
+		 */
+		void pushVectorKey(const CompressedAnimationKey& key, const CompressedCurveCache& cache) const;
+
+		/**
+		 * Decompresses a rotation key and makes it the right key of its track. Previous right key becomes the left key.
+		 */
+		void pushRotationKey(const CompressedAnimationKey& key, const CompressedCurveCache& cache) const;
+
+		UINT32 mNumPositionCurves = 0;
+		UINT32 mNumRotationCurves = 0;
+		UINT32 mNumScaleCurves = 0;
+		float mStart = 0.0f;
+		float mEnd = 0.0f;
+
+		/** Keys of position tracks, followed by keys of scale tracks. */
+		Vector<CompressedAnimationKey> mVectorKeys;
+
+		/** Ranges of position tracks, followed by ranges of scale tracks. */
+		Vector<CompressedTrackRange> mVectorRanges;
+
+		Vector<CompressedAnimationKey> mRotationKeys;
+
+		/************************************************************************/
+		/* 								SERIALIZATION                      		*/
+		/************************************************************************/
+	public:
+		friend class CompressedAnimationCurvesRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	/** @} */
+}
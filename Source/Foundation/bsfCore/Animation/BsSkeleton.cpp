@@ -3,6 +3,7 @@
 #include "Animation/BsSkeleton.h"
 #include "Animation/BsAnimationClip.h"
 #include "Animation/BsSkeletonMask.h"
+#include "Private/Animation/BsSkeletonKernels.h"
 #include "Private/RTTI/BsSkeletonRTTI.h"
 
 namespace bs
@@ -126,6 +127,7 @@ namespace bs
 			state.rotationCaches = rotationCache.data();
 			state.scaleCaches = scaleCache.data();
 			state.genericCaches = nullptr;
+			state.compressedCurves = clip._getCompressedCurves();
 			state.disabled = false;
 
 			AnimationStateLayer layer;
@@ -144,20 +146,47 @@ namespace bs
 	void Skeleton::getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask,
 		const AnimationStateLayer* layers, UINT32 numLayers)
 	{
-		// Note: If more performance is required this method could be optimized with vector instructions
-
 		assert(localPose.numBones == mNumBones);
 
-		for(UINT32 i = 0; i < mNumBones; i++)
-		{
-			localPose.positions[i] = Vector3::ZERO;
-			localPose.rotations[i] = Quaternion::ZERO;
-			localPose.scales[i] = Vector3::ONE;
-		}
+		// Blending is done on SoA poses using SIMD kernels. Curve values of each animation state are first gathered
+		// into a separate pose, along with per-bone weights (zero for bones without a curve), and then blended at once.
+		const UINT32 poseSize = SkeletonKernels::getPoseSize(mNumBones);
+		const UINT32 numPaddedBones = Math::divideAndRoundUp(mNumBones, SkeletonKernels::SIMD_WIDTH) *
+			SkeletonKernels::SIMD_WIDTH;
+
+		float* poseBuffer = bs_stack_alloc<float>(poseSize * 2 + numPaddedBones * 3);
+
+		SoABonePose blendedPose;
+		SkeletonKernels::initPose(blendedPose, poseBuffer, mNumBones);
+
+		SoABonePose statePose;
+		SkeletonKernels::initPose(statePose, poseBuffer + poseSize, mNumBones);
+
+		float* positionWeights = poseBuffer + poseSize * 2;
+		float* rotationWeights = positionWeights + numPaddedBones;
+		float* scaleWeights = rotationWeights + numPaddedBones;
+
+		// Padding bones are never animated
+		std::fill(positionWeights, positionWeights + numPaddedBones * 3, 0.0f);
 
 		bool* hasAnimCurve = bs_stack_alloc<bool>(mNumBones);
 		bs_zero_out(hasAnimCurve, mNumBones);
 
+		const auto setVector = [](float* const (&components)[3], UINT32 idx, const Vector3& value)
+		{
+			components[0][idx] = value.x;
+			components[1][idx] = value.y;
+			components[2][idx] = value.z;
+		};
+
+		const auto setQuaternion = [](float* const (&components)[4], UINT32 idx, const Quaternion& value)
+		{
+			components[0][idx] = value.x;
+			components[1][idx] = value.y;
+			components[2][idx] = value.z;
+			components[3][idx] = value.w;
+		};
+
 		// Note: For a possible performance improvement consider keeping an array of only active (non-disabled) bones and
 		// just iterate over them without mask checks. Possibly also a list of active curve mappings to avoid those checks
 		// as well.
@@ -189,8 +218,20 @@ namespace bs
 				if (Math::approxEquals(normWeight, 0.0f))
 					continue;
 
+				// Compressed curves are evaluated all at once
+				const CompressedCurveCache* compressed = nullptr;
+				if (state.compressedCurves != nullptr)
+				{
+					state.compressedCurves->evaluate(state.time, state.loop, state.compressedCache);
+					compressed = &state.compressedCache;
+				}
+
 				for (UINT32 k = 0; k < mNumBones; k++)
 				{
+					positionWeights[k] = 0.0f;
+					rotationWeights[k] = 0.0f;
+					scaleWeights[k] = 0.0f;
+
 					if (!mask.isEnabled(k))
 						continue;
 
@@ -198,8 +239,17 @@ namespace bs
 					UINT32 curveIdx = mapping.position;
 					if (curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-						localPose.positions[k] += curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop) * normWeight;
+						Vector3 value;
+						if (compressed != nullptr)
+							value = compressed->getPositions()[curveIdx];
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
+							value = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
+						}
+
+						setVector(statePose.positions, k, value);
+						positionWeights[k] = normWeight;
 
 						localPose.hasOverride[k] = false;
 						hasAnimCurve[k] = true;
@@ -208,49 +258,49 @@ namespace bs
 					curveIdx = mapping.scale;
 					if (curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-						localPose.scales[k] *= curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop) * normWeight;
+						Vector3 value;
+						if (compressed != nullptr)
+							value = compressed->getScales()[curveIdx];
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
+							value = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
+						}
+
+						setVector(statePose.scales, k, value);
+						scaleWeights[k] = normWeight;
 
 						localPose.hasOverride[k] = false;
 						hasAnimCurve[k] = true;
 					}
 
-					if (layer.additive)
+					curveIdx = mapping.rotation;
+					if (curveIdx != (UINT32)-1)
 					{
-						curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
+						Quaternion value;
+						if (compressed != nullptr)
+							value = compressed->getRotations()[curveIdx];
+						else
 						{
-							bool isAssigned = localPose.rotations[k].w != 0.0f;
-							if (!isAssigned)
-								localPose.rotations[k] = Quaternion::IDENTITY;
-
 							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-							value = Quaternion::lerp(normWeight, Quaternion::IDENTITY, value);
-
-							localPose.rotations[k] *= value;
-							localPose.hasOverride[k] = false;
-							hasAnimCurve[k] = true;
+							value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
 						}
-					}
-					else
-					{
-						curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
-						{
-							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop) * normWeight;
 
-							if (value.dot(localPose.rotations[k]) < 0.0f)
-								value = -value;
+						setQuaternion(statePose.rotations, k, value);
+						rotationWeights[k] = normWeight;
 
-							localPose.rotations[k] += value;
-							localPose.hasOverride[k] = false;
-							hasAnimCurve[k] = true;
-						}
+						localPose.hasOverride[k] = false;
+						hasAnimCurve[k] = true;
 					}
 				}
+
+				SkeletonKernels::blendPositions(blendedPose, statePose, positionWeights, mNumBones);
+				SkeletonKernels::blendScales(blendedPose, statePose, scaleWeights, mNumBones);
+
+				if (layer.additive)
+					SkeletonKernels::blendRotationsAdditive(blendedPose, statePose, rotationWeights, mNumBones);
+				else
+					SkeletonKernels::blendRotations(blendedPose, statePose, rotationWeights, mNumBones);
 			}
 		}
 
@@ -260,63 +310,65 @@ namespace bs
 			if(hasAnimCurve[i])
 				continue;
 
-			localPose.positions[i] = mBoneTransforms[i].getPosition();
-			localPose.rotations[i] = mBoneTransforms[i].getRotation();
-			localPose.scales[i] = mBoneTransforms[i].getScale();
+			setVector(blendedPose.positions, i, mBoneTransforms[i].getPosition());
+			setQuaternion(blendedPose.rotations, i, mBoneTransforms[i].getRotation());
+			setVector(blendedPose.scales, i, mBoneTransforms[i].getScale());
 		}
 
-		// Calculate local pose matrices
-		UINT32 isGlobalBytes = sizeof(bool) * mNumBones;
-		bool* isGlobal = (bool*)bs_stack_alloc(isGlobalBytes);
-		memset(isGlobal, 0, isGlobalBytes);
+		SkeletonKernels::normalizeRotations(blendedPose, mNumBones);
+		SkeletonKernels::storePose(blendedPose, localPose.positions, localPose.rotations, localPose.scales, mNumBones);
 
-		for(UINT32 i = 0; i < mNumBones; i++)
-		{
-			bool isAssigned = localPose.rotations[i].w != 0.0f;
-			if (!isAssigned)
-				localPose.rotations[i] = Quaternion::IDENTITY;
-			else
-				localPose.rotations[i].normalize();
+		// Calculate local pose matrices. Bones with overrides already have their transforms in model space.
+		SkeletonKernels::calculateLocalTransforms(blendedPose, localPose.hasOverride, pose, mNumBones);
+		calculateModelSpacePose(pose, localPose.hasOverride);
 
-			if (localPose.hasOverride[i])
-			{
-				isGlobal[i] = true;
-				continue;
-			}
+		bs_stack_free(hasAnimCurve);
+		bs_stack_free(poseBuffer);
+	}
 
-			pose[i] = Matrix4::TRS(localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
-		}
+	void Skeleton::getPose(Matrix4* pose, const LocalSkeletonPose& localPose) const
+	{
+		assert(localPose.numBones == mNumBones);
 
-		// Calculate global poses
-		// Note: For a possible performance improvement consider sorting bones in such order so that parents (and overrides)
-		// always come before children, we no isGlobal check is needed.
-		std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
+		for (UINT32 i = 0; i < mNumBones; i++)
 		{
-			UINT32 parentBoneIdx = mBoneInfo[boneIdx].parent;
-			if (parentBoneIdx == (UINT32)-1)
-			{
-				isGlobal[boneIdx] = true;
-				return;
-			}
+			if (!localPose.hasOverride[i])
+				pose[i].setTRS(localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
+		}
 
-			if (!isGlobal[parentBoneIdx])
-				calcGlobal(parentBoneIdx);
+		calculateModelSpacePose(pose, localPose.hasOverride);
+	}
 
-			pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
-			isGlobal[boneIdx] = true;
-		};
+	void Skeleton::calculateModelSpacePose(Matrix4* pose, const bool* hasOverride) const
+	{
+		bool* isGlobal = bs_stack_alloc<bool>(mNumBones);
+		memcpy(isGlobal, hasOverride, sizeof(bool) * mNumBones);
 
+		// Calculate global poses. Walk up from each bone until a bone with a known model space transform is found, then
+		// transform the visited bones from the top down.
+		UINT32* boneChain = bs_stack_alloc<UINT32>(mNumBones);
 		for (UINT32 i = 0; i < mNumBones; i++)
 		{
-			if (!isGlobal[i])
-				calcGlobal(i);
+			UINT32 chainLength = 0;
+			for (UINT32 boneIdx = i; boneIdx != (UINT32)-1 && !isGlobal[boneIdx]; boneIdx = mBoneInfo[boneIdx].parent)
+				boneChain[chainLength++] = boneIdx;
+
+			while (chainLength > 0)
+			{
+				const UINT32 boneIdx = boneChain[--chainLength];
+				const UINT32 parentBoneIdx = mBoneInfo[boneIdx].parent;
+
+				if (parentBoneIdx != (UINT32)-1)
+					SkeletonKernels::multiplyAffine(pose[parentBoneIdx], pose[boneIdx], pose[boneIdx]);
+
+				isGlobal[boneIdx] = true;
+			}
 		}
 
-		for (UINT32 i = 0; i < mNumBones; i++)
-			pose[i] = pose[i] * mInvBindPoses[i];
+		SkeletonKernels::multiplyAffine(pose, mInvBindPoses, pose, mNumBones);
 
+		bs_stack_free(boneChain);
 		bs_stack_free(isGlobal);
-		bs_stack_free(hasAnimCurve);
 	}
 
 	Transform Skeleton::calcBoneTransform(UINT32 idx) const
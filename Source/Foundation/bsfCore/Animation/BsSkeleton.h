@@ -8,6 +8,7 @@
 #include "Math/BsVector3.h"
 #include "Math/BsQuaternion.h"
 #include "Animation/BsCurveCache.h"
+#include "Animation/BsCompressedAnimationCurves.h"
 #include "Scene/BsTransform.h"
 
 namespace bs
@@ -51,6 +52,13 @@ namespace bs
 		TCurveCache<Vector3>* scaleCaches; /**< Cache used for evaluating scale curves. */
 		TCurveCache<float>* genericCaches; /**< Cache used for evaluating generic curves. */
 
+		/**
+		 * Compressed version of the position, rotation and scale curves. If present it is used for evaluation instead of
+		 * the curves in @p curves.
+		 */
+		SPtr<CompressedAnimationCurves> compressedCurves;
+		CompressedCurveCache compressedCache; /**< Cache used for evaluating compressed curves. */
+
 		float time; /**< Time to evaluate the curve at. */
 		float weight; /**< Determines how much of an influence will this clip have in regard to others in the same layer. */
 		bool loop; /**< Determines should the animation loop (wrap) once ending or beginning frames are passed. */
@@ -152,6 +160,17 @@ namespace bs
 		void getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask,
 			const AnimationStateLayer* layers, UINT32 numLayers);
 
+		/**
+		 * Outputs a skeleton pose from already evaluated local bone transforms (e.g. ones output by the other getPose
+		 * overloads, or interpolated between two such poses).
+		 *
+		 * @param[in,out]	pose		Output pose containing the requested transforms. Must be pre-allocated with enough
+		 *								space to hold all the bone matrices of this skeleton. Bones with an override
+		 *								must already contain their model space transform.
+		 * @param[in]		localPose	Local transforms of all the bones of this skeleton.
+		 */
+		void getPose(Matrix4* pose, const LocalSkeletonPose& localPose) const;
+
 		/** Returns the total number of bones in the skeleton. */
 		BS_SCRIPT_EXPORT(pr:getter,n:NumBones)
 		UINT32 getNumBones() const { return mNumBones; }
@@ -180,6 +199,12 @@ namespace bs
 		Skeleton() = default;
 		Skeleton(BONE_DESC* bones, UINT32 numBones);
 
+		/**
+		 * Transforms bone matrices in @p pose from local space into the final output space (model space, relative to the
+		 * bind pose). Bones with an override are expected to already be in model space.
+		 */
+		void calculateModelSpacePose(Matrix4* pose, const bool* hasOverride) const;
+
 		UINT32 mNumBones = 0;
 		Transform* mBoneTransforms = nullptr;
 		Matrix4* mInvBindPoses = nullptr;
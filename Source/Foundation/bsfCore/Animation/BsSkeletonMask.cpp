@@ -21,6 +21,13 @@ namespace bs
 		:mSkeleton(skeleton), mMask(skeleton->getNumBones())
 	{ }
 
+	SkeletonMaskBuilder::SkeletonMaskBuilder(const SPtr<Skeleton>& skeleton, const SkeletonMask& mask)
+		:mSkeleton(skeleton), mMask(mask)
+	{
+		// Default constructed masks have no entries and have all bones enabled
+		mMask.mIsDisabled.resize(skeleton->getNumBones(), false);
+	}
+
 	void SkeletonMaskBuilder::setBoneState(const String& name, bool enabled)
 	{
 		UINT32 numBones = mSkeleton->getNumBones();
@@ -33,4 +40,30 @@ namespace bs
 			}
 		}
 	}
+
+	void SkeletonMaskBuilder::disableLeafBones(UINT32 numLevels)
+	{
+		if(numLevels == 0)
+			return;
+
+		// Level of a bone is the length of the longest path from it to a leaf bone
+		const UINT32 numBones = mSkeleton->getNumBones();
+		Vector<UINT32> levels(numBones, 1);
+		for(UINT32 i = 0; i < numBones; i++)
+		{
+			UINT32 level = levels[i] + 1;
+			UINT32 parentIdx = mSkeleton->getBoneInfo(i).parent;
+			while(parentIdx != (UINT32)-1 && levels[parentIdx] < level)
+			{
+				levels[parentIdx] = level++;
+				parentIdx = mSkeleton->getBoneInfo(parentIdx).parent;
+			}
+		}
+
+		for(UINT32 i = 0; i < numBones; i++)
+		{
+			if(levels[i] <= numLevels)
+				mMask.mIsDisabled[i] = true;
+		}
+	}
 }
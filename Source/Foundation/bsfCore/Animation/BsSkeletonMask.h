@@ -38,9 +38,18 @@ namespace bs
 	public:
 		SkeletonMaskBuilder(const SPtr<Skeleton>& skeleton);
 
+		/** Creates a builder that starts with the bone states from an existing mask for the same skeleton. */
+		SkeletonMaskBuilder(const SPtr<Skeleton>& skeleton, const SkeletonMask& mask);
+
 		/** Enables or disables a bone with the specified name. */
 		void setBoneState(const String& name, bool enabled);
 
+		/**
+		 * Disables bones at the ends of the bone hierarchy. Bones without children are at level one, bones whose children
+		 * are all at level one are at level two, and so on. All bones at or below @p numLevels are disabled.
+		 */
+		void disableLeafBones(UINT32 numLevels);
+
 		/** Teturns the built skeleton mask. */
 		SkeletonMask getMask() const { return mMask; }
 
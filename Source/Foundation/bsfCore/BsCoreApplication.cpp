@@ -151,7 +151,10 @@ namespace bs
 		MessageHandler::startUp();
 		ProfilerCPU::startUp();
 		ProfilingManager::startUp();
-		ThreadPool::startUp<TThreadPool<ThreadDefaultPolicy>>((numWorkerThreads));
+		// Keep enough threads around for the task workers, the task scheduler and the core thread, so the pool doesn't
+		// need to create new threads during normal operation
+		const UINT32 numPooledThreads = numWorkerThreads + 2;
+		ThreadPool::startUp<TThreadPool<ThreadDefaultPolicy>>(numPooledThreads, std::max(16U, numPooledThreads));
 		TaskScheduler::startUp();
 		RenderStats::startUp();
 		CoreThread::startUp();
@@ -298,11 +301,7 @@ namespace bs
 				Lock lock(mFrameRenderingFinishedMutex);
 
 				while(!mIsFrameRenderingFinished)
-				{
-					TaskScheduler::instance().addWorker();
 					mFrameRenderingFinishedCondition.wait(lock);
-					TaskScheduler::instance().removeWorker();
-				}
 
 				mIsFrameRenderingFinished = false;
 			}
@@ -328,11 +327,7 @@ namespace bs
 			Lock lock(mFrameRenderingFinishedMutex);
 
 			while (!mIsFrameRenderingFinished)
-			{
-				TaskScheduler::instance().addWorker();
 				mFrameRenderingFinishedCondition.wait(lock);
-				TaskScheduler::instance().removeWorker();
-			}
 		}
 	}
 
@@ -418,6 +418,7 @@ namespace bs
 	class Resource;
 	class Resources;
 	class ResourceManifest;
+	class SavedResourceData;
 	class MeshBase;
 	class TransientMesh;
 	class MeshHeap;
@@ -655,6 +656,7 @@ namespace bs
 		TID_ShaderVariationParamInfo = 1196,
 		TID_ShaderVariationParamValue = 1197,
 		TID_ScreenSpaceLensFlareSettings = 1198,
+		TID_CompressedAnimationCurves = 1199,
 
 		// Moved from Engine layer
 		TID_CCamera = 30000,
@@ -84,6 +84,7 @@ set(BS_CORE_INC_SCENE
 	"bsfCore/Scene/BsPrefabUtility.h"
 	"bsfCore/Scene/BsTransform.h"
 	"bsfCore/Scene/BsSceneActor.h"
+	"bsfCore/Private/Scene/BsSceneTransformPass.h"
 )
 
 set(BS_CORE_INC_INPUT
@@ -149,6 +150,7 @@ set(BS_CORE_INC_RENDERAPI
 	"bsfCore/RenderAPI/BsGpuProgram.h"
 	"bsfCore/RenderAPI/BsGpuParams.h"
 	"bsfCore/RenderAPI/BsGpuParamDesc.h"
+	"bsfCore/RenderAPI/BsGpuParamBlockBufferPool.h"
 	"bsfCore/RenderAPI/BsGpuParamBlockBuffer.h"
 	"bsfCore/RenderAPI/BsGpuParam.h"
 	"bsfCore/RenderAPI/BsGpuBuffer.h"
@@ -230,6 +232,9 @@ set(BS_CORE_INC_IMAGE
 	"bsfCore/Image/BsPixelUtil.h"
 	"bsfCore/Image/BsPixelVolume.h"
 	"bsfCore/Image/BsSpriteTexture.h"
+	"bsfCore/Private/Image/BsPixelConversionKernels.h"
+	"bsfCore/Private/Image/BsTextureImportUtility.h"
+	"bsfCore/Private/Image/BsBCDecompressionKernels.h"
 )
 
 set(BS_CORE_SRC_UTILITY
@@ -358,6 +363,7 @@ set(BS_CORE_INC_RTTI
 	"bsfCore/Private/RTTI/BsCAudioSourceRTTI.h"
 	"bsfCore/Private/RTTI/BsCAudioListenerRTTI.h"
 	"bsfCore/Private/RTTI/BsAnimationClipRTTI.h"
+	"bsfCore/Private/RTTI/BsCompressedAnimationCurvesRTTI.h"
 	"bsfCore/Private/RTTI/BsAnimationCurveRTTI.h"
 	"bsfCore/Private/RTTI/BsSkeletonRTTI.h"
 	"bsfCore/Private/RTTI/BsCCameraRTTI.h"
@@ -433,6 +439,9 @@ set(BS_CORE_SRC_IMAGE
 	"bsfCore/Image/BsTexture.cpp"
 	"bsfCore/Image/BsPixelUtil.cpp"
 	"bsfCore/Image/BsSpriteTexture.cpp"
+	"bsfCore/Private/Image/BsPixelConversionKernels.cpp"
+	"bsfCore/Private/Image/BsTextureImportUtility.cpp"
+	"bsfCore/Private/Image/BsBCDecompressionKernels.cpp"
 )
 
 set(BS_CORE_SRC_MATERIAL
@@ -471,6 +480,7 @@ set(BS_CORE_SRC_RENDERAPI
 	"bsfCore/RenderAPI/BsGpuBuffer.cpp"
 	"bsfCore/RenderAPI/BsGpuParam.cpp"
 	"bsfCore/RenderAPI/BsGpuParamBlockBuffer.cpp"
+	"bsfCore/RenderAPI/BsGpuParamBlockBufferPool.cpp"
 	"bsfCore/RenderAPI/BsGpuParams.cpp"
 	"bsfCore/RenderAPI/BsGpuProgram.cpp"
 	"bsfCore/RenderAPI/BsIndexBuffer.cpp"
@@ -549,6 +559,7 @@ set(BS_CORE_SRC_SCENE
 	"bsfCore/Scene/BsPrefabUtility.cpp"
 	"bsfCore/Scene/BsTransform.cpp"
 	"bsfCore/Scene/BsSceneActor.cpp"
+	"bsfCore/Private/Scene/BsSceneTransformPass.cpp"
 )
 
 set(BS_CORE_INC_AUDIO
@@ -581,6 +592,8 @@ set(BS_CORE_INC_ANIMATION
 	"bsfCore/Animation/BsAnimationUtility.h"
 	"bsfCore/Animation/BsSkeletonMask.h"
 	"bsfCore/Animation/BsMorphShapes.h"
+	"bsfCore/Animation/BsCompressedAnimationCurves.h"
+	"bsfCore/Private/Animation/BsSkeletonKernels.h"
 )
 
 set(BS_CORE_SRC_ANIMATION
@@ -592,6 +605,8 @@ set(BS_CORE_SRC_ANIMATION
 	"bsfCore/Animation/BsAnimationUtility.cpp"
 	"bsfCore/Animation/BsSkeletonMask.cpp"
 	"bsfCore/Animation/BsMorphShapes.cpp"
+	"bsfCore/Animation/BsCompressedAnimationCurves.cpp"
+	"bsfCore/Private/Animation/BsSkeletonKernels.cpp"
 )
 
 set(BS_CORE_INC_PARTICLES
@@ -603,6 +618,7 @@ set(BS_CORE_INC_PARTICLES
 	"bsfCore/Particles/BsParticleModule.h"
 	"bsfCore/Particles/BsVectorField.h"
 	"bsfCore/Private/Particles/BsParticleSet.h"
+	"bsfCore/Private/Particles/BsParticleKernels.h"
 )
 
 set(BS_CORE_SRC_PARTICLES
@@ -612,6 +628,7 @@ set(BS_CORE_SRC_PARTICLES
 	"bsfCore/Particles/BsParticleManager.cpp"
 	"bsfCore/Particles/BsParticleDistribution.cpp"
 	"bsfCore/Particles/BsVectorField.cpp"
+	"bsfCore/Private/Particles/BsParticleKernels.cpp"
 )
 
 set(BS_CORE_INC_NETWORK
@@ -4,6 +4,8 @@
 #include "Error/BsException.h"
 #include "CoreThread/BsCoreThread.h"
 #include "Debug/BsDebug.h"
+#include "Math/BsMath.h"
+#include "Utility/BsBitwise.h"
 
 namespace bs
 {
@@ -167,6 +169,118 @@ namespace bs
 		BS_EXCEPT(InternalErrorException, message);
 	}
 
+	CommandRingQueue::CommandRingQueue(ThreadId threadId, UINT32 capacity)
+		:mCapacity(capacity), mMyThreadId(threadId)
+	{
+		assert(Bitwise::isPow2(capacity) && capacity >= MAX_INLINE_SIZE * 4);
+
+		mBuffer = (UINT8*)bs_alloc_aligned16(capacity);
+		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
+	}
+
+	CommandRingQueue::~CommandRingQueue()
+	{
+		// Destroy any commands that were never executed
+		UINT64 pos = mReadPos.load(std::memory_order_acquire);
+		const UINT64 end = mWritePos.load(std::memory_order_acquire);
+
+		while(pos < end)
+		{
+			CommandHeader* header = (CommandHeader*)(mBuffer + (pos & (mCapacity - 1)));
+			if(header->destroy != nullptr)
+				header->destroy(header + 1);
+
+			pos += header->size;
+		}
+
+		bs_free_aligned16(mBuffer);
+	}
+
+	void* CommandRingQueue::allocate(UINT32 size, void(*execute)(void*), void(*destroy)(void*))
+	{
+		static constexpr UINT32 HEADER_SIZE = sizeof(CommandHeader);
+
+		const UINT32 recordSize = HEADER_SIZE + Math::divideAndRoundUp(size, HEADER_SIZE) * HEADER_SIZE;
+
+		UINT64 pos = mWritePos.load(std::memory_order_relaxed);
+		const UINT64 readPos = mReadPos.load(std::memory_order_acquire);
+
+		// Records are never split across the end of the buffer, instead the remaining space is skipped
+		UINT32 offset = (UINT32)(pos & (mCapacity - 1));
+		const UINT32 padding = (offset + recordSize > mCapacity) ? mCapacity - offset : 0;
+
+		if((pos - readPos) + padding + recordSize > mCapacity)
+			return nullptr;
+
+		if(padding > 0)
+		{
+			CommandHeader* paddingHeader = (CommandHeader*)(mBuffer + offset);
+			paddingHeader->execute = nullptr;
+			paddingHeader->destroy = nullptr;
+			paddingHeader->size = padding;
+
+			pos += padding;
+			offset = 0;
+		}
+
+		CommandHeader* header = (CommandHeader*)(mBuffer + offset);
+		header->execute = execute;
+		header->destroy = destroy;
+		header->size = recordSize;
+
+		mPendingWritePos = pos + recordSize;
+		return header + 1;
+	}
+
+	bool CommandRingQueue::tryQueueReturn(const std::function<void(AsyncOp&)>& commandCallback, AsyncOp& op)
+	{
+		AsyncOp newOp(mAsyncOpSyncData);
+		const bool queued = tryQueue([commandCallback, newOp]() mutable
+		{
+			commandCallback(newOp);
+
+			if(!newOp.hasCompleted())
+			{
+				BS_LOG(Warning, CoreThread,
+					"Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
+					"Make sure to complete the operation before returning from the command callback method.");
+				newOp._completeOperation(nullptr);
+			}
+		});
+
+		if(!queued)
+			return false;
+
+		op = newOp;
+		return true;
+	}
+
+	void CommandRingQueue::playback(UINT64 end)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		end = std::min(end, mWritePos.load(std::memory_order_acquire));
+
+		UINT64 pos = mReadPos.load(std::memory_order_relaxed);
+		while(pos < end)
+		{
+			CommandHeader* header = (CommandHeader*)(mBuffer + (pos & (mCapacity - 1)));
+			const UINT32 size = header->size;
+
+			if(header->execute != nullptr)
+				header->execute(header + 1);
+
+			// Release the space as soon as possible, in case the producer is waiting on it
+			pos += size;
+			mReadPos.store(pos, std::memory_order_release);
+		}
+	}
+
+	bool CommandRingQueue::isEmpty() const
+	{
+		return mReadPos.load(std::memory_order_acquire) == mWritePos.load(std::memory_order_acquire);
+	}
+
 #if BS_DEBUG_MODE
 	Mutex CommandQueueBase::CommandQueueBreakpointMutex;
 
@@ -361,5 +361,168 @@ namespace bs
 		}
 	};
 
+	/**
+	 * Fixed capacity command queue that allows a single producer thread to record commands and a single consumer thread to
+	 * execute them, without any locks or per-command allocations. Commands are stored in a ring buffer as type-erased
+	 * records, with the callable stored inline in the record itself.
+	 *
+	 * Commands are not executed until they are published. Publishing returns a position in the queue, and the consumer
+	 * can then execute all commands up to that position by calling playback(). It is up to the caller to deliver that
+	 * position to the consumer.
+	 *
+	 * @note
+	 * tryQueue() and queueReturn() may only be called from the producer thread, and playback() only from the consumer
+	 * thread. publish() may be called from any thread.
+	 */
+	class BS_CORE_EXPORT CommandRingQueue
+	{
+		/** Header preceding each command in the ring buffer. */
+		struct alignas(16) CommandHeader
+		{
+			/** Executes the command and destroys it. Null for padding records. */
+			void(*execute)(void*);
+
+			/** Destroys the command without executing it. Null for padding records. */
+			void(*destroy)(void*);
+
+			/** Size of the record in bytes, including the header. Always a multiple of the header size. */
+			UINT32 size;
+		};
+
+		/** Type-erased command storing a callable of type T. */
+		template<class T>
+		struct Command
+		{
+			static void execute(void* data)
+			{
+				T& callable = *(T*)data;
+				callable();
+				callable.~T();
+			}
+
+			static void destroy(void* data)
+			{
+				((T*)data)->~T();
+			}
+		};
+
+		/** Command storing a callable too large to store inline. Only a pointer to the callable is stored in the ring. */
+		template<class T>
+		struct LargeCommand
+		{
+			static void execute(void* data)
+			{
+				T* callable = *(T**)data;
+				(*callable)();
+				bs_delete(callable);
+			}
+
+			static void destroy(void* data)
+			{
+				bs_delete(*(T**)data);
+			}
+		};
+
+	public:
+		/** Default size of the ring buffer, in bytes. */
+		static constexpr UINT32 DEFAULT_CAPACITY = 1024 * 1024;
+
+		/**
+		 * Constructor.
+		 *
+		 * @param[in]	threadId	Identifier of the thread that will be recording commands.
+		 * @param[in]	capacity	Size of the ring buffer in bytes. Must be a power of two.
+		 */
+		CommandRingQueue(ThreadId threadId, UINT32 capacity = DEFAULT_CAPACITY);
+		~CommandRingQueue();
+
+		/** Returns the identifier of the thread that is allowed to record commands. */
+		ThreadId getThreadId() const { return mMyThreadId; }
+
+		/**
+		 * Attempts to queue a new command for execution. Returns false if there is not enough room in the queue, in which
+		 * case the callable is left untouched. The caller should then make sure all the recorded commands are published,
+		 * and retry after the consumer executes some of them.
+		 */
+		template<class T>
+		bool tryQueue(T&& commandCallback)
+		{
+			using CallableType = typename std::decay<T>::type;
+
+			if(sizeof(CallableType) <= MAX_INLINE_SIZE && alignof(CallableType) <= alignof(CommandHeader))
+			{
+				void* data = allocate(sizeof(CallableType), &Command<CallableType>::execute,
+					&Command<CallableType>::destroy);
+
+				if(data == nullptr)
+					return false;
+
+				new (data) CallableType(std::forward<T>(commandCallback));
+			}
+			else
+			{
+				void* data = allocate(sizeof(CallableType*), &LargeCommand<CallableType>::execute,
+					&LargeCommand<CallableType>::destroy);
+
+				if(data == nullptr)
+					return false;
+
+				*(CallableType**)data = bs_new<CallableType>(std::forward<T>(commandCallback));
+			}
+
+			commit();
+			return true;
+		}
+
+		/**
+		 * Attempts to queue a command that returns a value through an AsyncOp. Returns false if there is not enough room
+		 * in the queue, in which case @p op is not modified. See CommandQueueBase::queueReturn.
+		 */
+		bool tryQueueReturn(const std::function<void(AsyncOp&)>& commandCallback, AsyncOp& op);
+
+		/**
+		 * Makes all commands recorded so far available for execution. Returns the position the consumer should pass to
+		 * playback() in order to execute them.
+		 */
+		UINT64 publish() const { return mWritePos.load(std::memory_order_acquire); }
+
+		/**
+		 * Executes all commands up to the provided position, as returned by publish(). Commands that have already been
+		 * executed are skipped.
+		 */
+		void playback(UINT64 end);
+
+		/** Returns true if all the recorded commands have been executed. */
+		bool isEmpty() const;
+
+	private:
+		/** Maximum size of a callable stored directly in the ring buffer. Larger ones are allocated separately. */
+		static constexpr UINT32 MAX_INLINE_SIZE = 256;
+
+		/**
+		 * Reserves space for a new command with @p size bytes of data and writes its header. Returns a pointer to where
+		 * the command data should be written, or null if there is not enough room in the ring buffer. Must be followed
+		 * by a call to commit() once the data is written.
+		 */
+		void* allocate(UINT32 size, void(*execute)(void*), void(*destroy)(void*));
+
+		/** Makes the last allocated command visible to the consumer. */
+		void commit()
+		{
+			mWritePos.store(mPendingWritePos, std::memory_order_release);
+		}
+
+		UINT8* mBuffer;
+		UINT32 mCapacity;
+		ThreadId mMyThreadId;
+		SPtr<AsyncOpSyncData> mAsyncOpSyncData;
+		UINT64 mPendingWritePos = 0;
+
+		// Written by different threads, keep them on separate cache lines
+		std::atomic<UINT64> mWritePos{0};
+		UINT8 mPadding[64 - sizeof(std::atomic<UINT64>)];
+		std::atomic<UINT64> mReadPos{0};
+	};
+
 	/** @} */
 }
@@ -30,6 +30,10 @@ namespace bs
 		mCoreThreadId = mSimThreadId; // For now
 		mCommandQueue = bs_new<CommandQueue<CommandQueueSync>>(BS_THREAD_CURRENT_ID);
 
+#if !BS_FORCE_SINGLETHREADED_RENDERING
+		mSimThreadQueue = bs_new<CommandRingQueue>(BS_THREAD_CURRENT_ID);
+#endif
+
 		initCoreThread();
 	}
 
@@ -53,6 +57,12 @@ namespace bs
 			mCommandQueue = nullptr;
 		}
 
+		if(mSimThreadQueue != nullptr)
+		{
+			bs_delete(mSimThreadQueue);
+			mSimThreadQueue = nullptr;
+		}
+
 		for (UINT32 i = 0; i < NUM_SYNC_BUFFERS; i++)
 		{
 			mFrameAllocs[i]->setOwnerThread(BS_THREAD_CURRENT_ID); // Sim thread
@@ -128,9 +138,7 @@ namespace bs
 						return;
 					}
 
-					TaskScheduler::instance().addWorker(); // Do something else while we wait, otherwise this core will be unused
 					mCommandReadyCondition.wait(lock);
-					TaskScheduler::instance().removeWorker();
 				}
 
 				commands = mCommandQueue->flush();
@@ -190,6 +198,24 @@ namespace bs
 		queueCommand(std::bind(&CommandQueueBase::playback, &queue, commands), flags);
 	}
 
+	void CoreThread::submitSimThreadQueue()
+	{
+		// Any commands recorded after this point will be picked up by the next submit
+		CommandRingQueue* queue = mSimThreadQueue;
+		const UINT64 end = queue->publish();
+
+		queueCommand([queue, end]() { queue->playback(end); }, CTQF_InternalQueue);
+	}
+
+	void CoreThread::onSimThreadQueueFull()
+	{
+		submitSimThreadQueue();
+
+		// Nothing is recorded in the ring until next submit, so commands recorded in the synchronized queue execute
+		// after all the ones in the ring
+		mSimThreadQueueOverflow = true;
+	}
+
 	void CoreThread::submitAll(bool blockUntilComplete)
 	{
 		UINT32 blockCommandId = (UINT32)-1;
@@ -213,6 +239,14 @@ namespace bs
 			if (mainQueue != nullptr)
 				submitCommandQueue(*mainQueue->queue, false);
 
+#if !BS_FORCE_SINGLETHREADED_RENDERING
+			submitSimThreadQueue();
+
+			// Sim thread queue overflow, if any, was submitted above along with the main queue
+			if(BS_THREAD_CURRENT_ID == mSimThreadId)
+				mSimThreadQueueOverflow = false;
+#endif
+
 			if(blockUntilComplete)
 			{
 				Lock lock2(mCommandQueueMutex);
@@ -233,8 +267,27 @@ namespace bs
 	{
 		Lock lock(mSubmitMutex);
 
-		CommandQueue<CommandQueueSync>& queue = *getQueue();
-		Queue<QueuedCommand>* commands = queue.flush();
+		std::function<void()> playbackCommand;
+#if !BS_FORCE_SINGLETHREADED_RENDERING
+		if (BS_THREAD_CURRENT_ID == mSimThreadId && !mSimThreadQueueOverflow)
+		{
+			CommandRingQueue* queue = mSimThreadQueue;
+			const UINT64 end = queue->publish();
+
+			playbackCommand = [queue, end]() { queue->playback(end); };
+		}
+		else
+#endif
+		{
+			// If the sim thread queue overflowed, the ring was already submitted and the remaining commands are here
+			CommandQueue<CommandQueueSync>& queue = *getQueue();
+			Queue<QueuedCommand>* commands = queue.flush();
+
+			playbackCommand = [commands, &queue]() { queue.playback(commands); };
+
+			if (BS_THREAD_CURRENT_ID == mSimThreadId)
+				mSimThreadQueueOverflow = false;
+		}
 
 		UINT32 commandId = -1;
 		{
@@ -244,10 +297,10 @@ namespace bs
 			{
 				commandId = mMaxCommandNotifyId++;
 
-				mCommandQueue->queue([commands, &queue]() { queue.playback(commands); }, true, commandId);
+				mCommandQueue->queue(playbackCommand, true, commandId);
 			}
 			else
-				mCommandQueue->queue([commands, &queue]() { queue.playback(commands); });
+				mCommandQueue->queue(playbackCommand);
 		}
 
 		mCommandReadyCondition.notify_all();
@@ -262,6 +315,18 @@ namespace bs
 		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
 #endif
 
+#if !BS_FORCE_SINGLETHREADED_RENDERING
+		if (!flags.isSet(CTQF_InternalQueue) && BS_THREAD_CURRENT_ID == mSimThreadId && !mSimThreadQueueOverflow)
+		{
+			AsyncOp op;
+			if (mSimThreadQueue->tryQueueReturn(commandCallback, op))
+				return op;
+
+			// Queue is full, record in the synchronized queue instead (see queueCommand())
+			onSimThreadQueueFull();
+		}
+#endif
+
 		if (!flags.isSet(CTQF_InternalQueue))
 			return getQueue()->queueReturn(commandCallback);
 		else
@@ -291,7 +356,7 @@ namespace bs
 		}
 	}
 
-	void CoreThread::queueCommand(std::function<void()> commandCallback, CoreThreadQueueFlags flags)
+	void CoreThread::queueCommandSync(std::function<void()> commandCallback, CoreThreadQueueFlags flags)
 	{
 #if !BS_FORCE_SINGLETHREADED_RENDERING
 		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
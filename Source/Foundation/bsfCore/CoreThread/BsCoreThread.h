@@ -108,7 +108,24 @@ namespace bs
 		 * @see		CommandQueue::queue()
 		 * @note	Thread safe
 		 */
-		void queueCommand(std::function<void()> commandCallback, CoreThreadQueueFlags flags = CTQF_Default);
+		template<class T>
+		void queueCommand(T&& commandCallback, CoreThreadQueueFlags flags = CTQF_Default)
+		{
+#if !BS_FORCE_SINGLETHREADED_RENDERING
+			// Commands queued by the sim thread go into a lock-free queue, with the callable stored inline
+			if(!flags.isSet(CTQF_InternalQueue) && BS_THREAD_CURRENT_ID == mSimThreadId && !mSimThreadQueueOverflow)
+			{
+				if(mSimThreadQueue->tryQueue(std::forward<T>(commandCallback)))
+					return;
+
+				// Queue is full. Never wait for it to drain, as the caller might be holding a lock a queued command needs.
+				// Instead submit what was recorded so far, and record the rest in the synchronized queue until next submit.
+				onSimThreadQueueFull();
+			}
+#endif
+
+			queueCommandSync(std::forward<T>(commandCallback), flags);
+		}
 
 		/**
 		 * Called once every frame.
@@ -186,6 +203,8 @@ namespace bs
 #endif
 
 		CommandQueue<CommandQueueSync>* mCommandQueue = nullptr;
+		CommandRingQueue* mSimThreadQueue = nullptr;
+		bool mSimThreadQueueOverflow = false; /**< True if sim thread commands are recorded in its synchronized queue. */
 
 		UINT32 mMaxCommandNotifyId = 0; /**< ID that will be assigned to the next command with a notifier callback. */
 		Vector<UINT32> mCommandsCompleted; /**< Completed commands that have notifier callbacks set up */
@@ -208,6 +227,24 @@ namespace bs
 		 */
 		void submitCommandQueue(CommandQueue<CommandQueueSync>& queue, bool blockUntilComplete);
 
+		/**
+		 * Submits all the commands recorded in the sim thread queue to the internal command queue. Unlike other queues,
+		 * this may be called from any thread.
+		 */
+		void submitSimThreadQueue();
+
+		/**
+		 * Called when the sim thread queue runs out of space. Submits all commands recorded so far and switches the sim
+		 * thread to the synchronized per-thread queue, until its next submit.
+		 */
+		void onSimThreadQueueFull();
+
+		/**
+		 * Queues a new command in the command queue of the calling thread, or in the internal command queue, depending
+		 * on the provided flags. Used for all commands not queued by the sim thread.
+		 */
+		void queueCommandSync(std::function<void()> commandCallback, CoreThreadQueueFlags flags);
+
 		/**
 		 * Blocks the calling thread until the command with the specified ID completes. Make sure that the specified ID
 		 * actually exists, otherwise this will block forever.
@@ -6,7 +6,11 @@
 #include "Math/BsMath.h"
 #include "Error/BsException.h"
 #include "Image/BsTexture.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Private/Image/BsPixelConversionKernels.h"
+#include "Private/Image/BsBCDecompressionKernels.h"
 #include <nvtt.h>
+#include <atomic>
 
 namespace bs
 {
@@ -1920,6 +1924,9 @@ namespace bs
 		}
 	}
 
+	/** Minimum number of pixels in a conversion before it is split over the task scheduler. */
+	static constexpr UINT32 PARALLEL_CONVERSION_THRESHOLD = 256 * 1024;
+
 	void PixelUtil::bulkPixelConversion(const PixelData &src, PixelData &dst)
 	{
 		if(src.getWidth() != dst.getWidth() || src.getHeight() != dst.getHeight() || src.getDepth() != dst.getDepth())
@@ -1991,14 +1998,27 @@ namespace bs
 			return;
 		}
 
-		// Check for compressed formats, we don't support decompression
+		// Check for decompression, re-compressing the data if converting to another compressed format
 		if (isCompressed(src.getFormat()))
 		{
-			if (src.getFormat() != dst.getFormat())
+			if (!isCompressed(dst.getFormat()))
 			{
-				BS_LOG(Error, PixelUtility, "Cannot convert from a compressed format to another format.");
+				decompress(src, dst);
 				return;
 			}
+
+			PixelData interimData(src.getWidth(), src.getHeight(), src.getDepth(), PF_RGBA8);
+			interimData.allocateInternalBuffer();
+
+			// Don't compress uninitialized data if the source can't be decompressed. Reason is logged by decompress().
+			if (!decompress(src, interimData))
+				return;
+
+			CompressionOptions co;
+			co.format = dst.getFormat();
+			compress(interimData, dst, co);
+
+			return;
 		}
 
 		// Check for compression
@@ -2021,6 +2041,39 @@ namespace bs
 		UINT8 *dstptr = static_cast<UINT8*>(dst.getData())
 			+ dst.getLeft() * dstPixelSize + dst.getTop() * dst.getRowPitch() + dst.getFront() * dst.getSlicePitch();
 
+		// Use a specialized kernel for common formats, converting whole rows at once
+		PixelConversionKernels::ConvertRowFn kernel = PixelConversionKernels::find(src.getFormat(), dst.getFormat());
+		if(kernel != nullptr)
+		{
+			const UINT32 width = src.getWidth();
+			const UINT32 height = src.getHeight();
+			const UINT32 numRows = height * src.getDepth();
+
+			const UINT32 srcRowPitch = src.getRowPitch();
+			const UINT32 srcSlicePitch = src.getSlicePitch();
+			const UINT32 dstRowPitch = dst.getRowPitch();
+			const UINT32 dstSlicePitch = dst.getSlicePitch();
+
+			const auto convertRows = [=](UINT32 start, UINT32 end)
+			{
+				for(UINT32 i = start; i < end; i++)
+				{
+					const UINT32 z = i / height;
+					const UINT32 y = i % height;
+
+					kernel(srcptr + z * srcSlicePitch + y * srcRowPitch, dstptr + z * dstSlicePitch + y * dstRowPitch,
+						width);
+				}
+			};
+
+			if((UINT64)width * numRows >= PARALLEL_CONVERSION_THRESHOLD && TaskScheduler::isStarted())
+				TaskScheduler::instance().parallelFor("PixelConversion", numRows, 0, convertRows);
+			else
+				convertRows(0, numRows);
+
+			return;
+		}
+
 		// Get pitches+skips in bytes
 		UINT32 srcRowSkipBytes = src.getRowSkip();
 		UINT32 srcSliceSkipBytes = src.getSliceSkip();
@@ -2405,8 +2458,31 @@ namespace bs
 		}
 	}
 
+	/**
+	 * Converts each row of the pixel data between linear and sRGB space using the provided kernel. Returns false if the
+	 * kernel doesn't support the pixel format, in which case the pixel data is left unchanged.
+	 */
+	static bool convertSRGBRows(PixelData& pixelData, bool(*kernel)(UINT8*, PixelFormat, UINT32))
+	{
+		UINT8* data = pixelData.getData();
+		for (UINT32 z = 0; z < pixelData.getDepth(); z++)
+		{
+			for (UINT32 y = 0; y < pixelData.getHeight(); y++)
+			{
+				UINT8* row = data + z * pixelData.getSlicePitch() + y * pixelData.getRowPitch();
+				if (!kernel(row, pixelData.getFormat(), pixelData.getWidth()))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
 	void PixelUtil::linearToSRGB(PixelData& pixelData)
 	{
+		if (convertSRGBRows(pixelData, &PixelConversionKernels::linearToSRGB))
+			return;
+
 		UINT32 depth = pixelData.getDepth();
 		UINT32 height = pixelData.getHeight();
 		UINT32 width = pixelData.getWidth();
@@ -2439,6 +2515,9 @@ namespace bs
 
 	void PixelUtil::SRGBToLinear(PixelData& pixelData)
 	{
+		if (convertSRGBRows(pixelData, &PixelConversionKernels::SRGBToLinear))
+			return;
+
 		UINT32 depth = pixelData.getDepth();
 		UINT32 height = pixelData.getHeight();
 		UINT32 width = pixelData.getWidth();
@@ -2469,6 +2548,56 @@ namespace bs
 		}
 	}
 
+	/** Number of pixel rows in a band of an image compressed in parallel. Must be a multiple of the block height. */
+	static constexpr UINT32 COMPRESSION_BAND_HEIGHT = 64;
+
+	/**
+	 * Compresses an image using NVTT.
+	 *
+	 * @param[in]	src				Pixels of the image, tightly packed, in the @p srcFormat format.
+	 * @param[in]	width			Width of the image, in pixels.
+	 * @param[in]	height			Height of the image, in pixels.
+	 * @param[in]	srcFormat		Format of the pixels, either PF_BGRA8 or PF_RGBA32F.
+	 * @param[out]	dst				Buffer to receive the compressed data.
+	 * @param[in]	dstSize			Size of the @p dst buffer, in bytes.
+	 * @param[in]	options			Options controlling the compression.
+	 * @return						True if the compression succeeded.
+	 */
+	static bool compressNVTT(const UINT8* src, UINT32 width, UINT32 height, PixelFormat srcFormat, UINT8* dst,
+		UINT32 dstSize, const CompressionOptions& options)
+	{
+		nvtt::InputOptions io;
+		io.setTextureLayout(nvtt::TextureType_2D, width, height);
+		io.setMipmapGeneration(false);
+		io.setAlphaMode(toNVTTAlphaMode(options.alphaMode));
+		io.setNormalMap(options.isNormalMap);
+
+		if (srcFormat == PF_RGBA32F)
+			io.setFormat(nvtt::InputFormat_RGBA_32F);
+		else
+			io.setFormat(nvtt::InputFormat_BGRA_8UB);
+
+		if (options.isSRGB)
+			io.setGamma(2.2f, 2.2f);
+		else
+			io.setGamma(1.0f, 1.0f);
+
+		io.setMipmapData(src, width, height);
+
+		nvtt::CompressionOptions co;
+		co.setFormat(toNVTTFormat(options.format));
+		co.setQuality(toNVTTQuality(options.quality));
+
+		NVTTCompressOutputHandler outputHandler(dst, dstSize);
+
+		nvtt::OutputOptions oo;
+		oo.setOutputHeader(false);
+		oo.setOutputHandler(&outputHandler);
+
+		nvtt::Compressor compressor;
+		return compressor.process(io, co, oo);
+	}
+
 	void PixelUtil::compress(const PixelData& src, PixelData& dst, const CompressionOptions& options)
 	{
 		if (!isCompressed(options.format))
@@ -2495,42 +2624,138 @@ namespace bs
 		interimData.allocateInternalBuffer();
 		bulkPixelConversion(src, interimData);
 
-		nvtt::InputOptions io;
-		io.setTextureLayout(nvtt::TextureType_2D, src.getWidth(), src.getHeight());
-		io.setMipmapGeneration(false);
-		io.setAlphaMode(toNVTTAlphaMode(options.alphaMode));
-		io.setNormalMap(options.isNormalMap);
+		const UINT32 width = src.getWidth();
+		const UINT32 height = src.getHeight();
+		const UINT32 numBands = Math::divideAndRoundUp(height, COMPRESSION_BAND_HEIGHT);
 
-		if (interimFormat == PF_RGBA32F)
-			io.setFormat(nvtt::InputFormat_RGBA_32F);
-		else
-			io.setFormat(nvtt::InputFormat_BGRA_8UB);
+		// Formats up to BC5 encode each block independently, so large images can be split into bands of block rows that
+		// are compressed in parallel, producing the same output as compressing the entire image at once
+		const bool canSplit = options.format >= PF_BC1 && options.format <= PF_BC5;
+		if(canSplit && numBands > 1 && (UINT64)width * height >= PARALLEL_CONVERSION_THRESHOLD &&
+			TaskScheduler::isStarted())
+		{
+			const UINT32 srcBandSize = interimData.getRowPitch() * COMPRESSION_BAND_HEIGHT;
+			const UINT32 dstBandSize = getMemorySize(width, COMPRESSION_BAND_HEIGHT, 1, options.format);
 
-		if (options.isSRGB)
-			io.setGamma(2.2f, 2.2f);
-		else
-			io.setGamma(1.0f, 1.0f);
+			std::atomic<bool> failed(false);
+			const auto compressBands = [&](UINT32 start, UINT32 end)
+			{
+				for(UINT32 i = start; i < end; i++)
+				{
+					const UINT32 bandHeight = std::min(COMPRESSION_BAND_HEIGHT, height - i * COMPRESSION_BAND_HEIGHT);
+					const UINT32 bandSize = getMemorySize(width, bandHeight, 1, options.format);
 
-		io.setMipmapData(interimData.getData(), src.getWidth(), src.getHeight());
+					if(!compressNVTT(interimData.getData() + i * srcBandSize, width, bandHeight, interimFormat,
+						dst.getData() + i * dstBandSize, bandSize, options))
+					{
+						failed = true;
+					}
+				}
+			};
 
-		nvtt::CompressionOptions co;
-		co.setFormat(toNVTTFormat(options.format));
-		co.setQuality(toNVTTQuality(options.quality));
+			TaskScheduler::instance().parallelFor("PixelCompression", numBands, 1, compressBands);
 
-		NVTTCompressOutputHandler outputHandler(dst.getData(), dst.getConsecutiveSize());
+			if(failed)
+				BS_LOG(Error, PixelUtility, "Compression failed. Internal error.");
 
-		nvtt::OutputOptions oo;
-		oo.setOutputHeader(false);
-		oo.setOutputHandler(&outputHandler);
+			return;
+		}
 
-		nvtt::Compressor compressor;
-		if (!compressor.process(io, co, oo))
+		if(!compressNVTT(interimData.getData(), width, height, interimFormat, dst.getData(), dst.getConsecutiveSize(),
+			options))
 		{
 			BS_LOG(Error, PixelUtility, "Compression failed. Internal error.");
 			return;
 		}
 	}
 
+	bool PixelUtil::decompress(const PixelData& src, PixelData& dst)
+	{
+		BCDecompressionKernels::DecodeRowFn decoder = BCDecompressionKernels::find(src.getFormat());
+		if (decoder == nullptr)
+		{
+			BS_LOG(Error, PixelUtility, "Decompression failed. Source format {0} is not supported.",
+				getFormatName(src.getFormat()));
+			return false;
+		}
+
+		if (isCompressed(dst.getFormat()))
+		{
+			BS_LOG(Error, PixelUtility, "Decompression failed. Destination format cannot be compressed.");
+			return false;
+		}
+
+		if (src.getWidth() != dst.getWidth() || src.getHeight() != dst.getHeight() || src.getDepth() != dst.getDepth())
+		{
+			BS_LOG(Error, PixelUtility, "Decompression failed. Source and destination sizes don't match.");
+			return false;
+		}
+
+		const UINT32 width = src.getWidth();
+		const UINT32 height = src.getHeight();
+		const UINT32 numBlocksX = Math::divideAndRoundUp(width, 4U);
+		const UINT32 numBlocksY = Math::divideAndRoundUp(height, 4U);
+		const UINT32 numBlockRows = numBlocksY * src.getDepth();
+
+		const PixelFormat dstFormat = dst.getFormat();
+		const UINT32 dstPixelSize = getNumElemBytes(dstFormat);
+
+		const UINT32 srcRowPitch = src.getRowPitch();
+		const UINT32 srcSlicePitch = src.getSlicePitch();
+		const UINT32 dstRowPitch = dst.getRowPitch();
+		const UINT32 dstSlicePitch = dst.getSlicePitch();
+
+		const UINT8* srcData = src.getData() + (src.getLeft() / 4) * getBlockSize(src.getFormat()) +
+			(src.getTop() / 4) * srcRowPitch + src.getFront() * srcSlicePitch;
+		UINT8* dstData = dst.getData() + dst.getLeft() * dstPixelSize + dst.getTop() * dstRowPitch +
+			dst.getFront() * dstSlicePitch;
+
+		// Blocks are decoded to RGBA8 one row of blocks at a time, and then copied or converted to the destination
+		PixelConversionKernels::ConvertRowFn convert = PixelConversionKernels::find(PF_RGBA8, dstFormat);
+		const UINT32 decodedRowPitch = numBlocksX * 4 * 4;
+
+		const auto decodeRows = [&](UINT32 start, UINT32 end)
+		{
+			Vector<UINT8> decoded(decodedRowPitch * 4);
+			for (UINT32 i = start; i < end; i++)
+			{
+				const UINT32 slice = i / numBlocksY;
+				const UINT32 blockY = i % numBlocksY;
+
+				decoder(srcData + slice * srcSlicePitch + blockY * srcRowPitch, decoded.data(), decodedRowPitch,
+					numBlocksX);
+
+				const UINT32 numRows = std::min(4U, height - blockY * 4);
+				for (UINT32 y = 0; y < numRows; y++)
+				{
+					const UINT8* decodedRow = decoded.data() + y * decodedRowPitch;
+					UINT8* dstRow = dstData + slice * dstSlicePitch + (blockY * 4 + y) * dstRowPitch;
+
+					if (dstFormat == PF_RGBA8)
+						memcpy(dstRow, decodedRow, width * 4);
+					else if (convert != nullptr)
+						convert(decodedRow, dstRow, width);
+					else
+					{
+						float r, g, b, a;
+						for (UINT32 x = 0; x < width; x++)
+						{
+							unpackColor(&r, &g, &b, &a, PF_RGBA8, decodedRow + x * 4);
+							packColor(r, g, b, a, dstFormat, dstRow + x * dstPixelSize);
+						}
+					}
+				}
+			}
+		};
+
+		if((UINT64)width * height * src.getDepth() >= PARALLEL_CONVERSION_THRESHOLD && TaskScheduler::isStarted())
+			TaskScheduler::instance().parallelFor("PixelDecompression", numBlockRows, 0, decodeRows);
+		else
+			decodeRows(0, numBlockRows);
+
+		return true;
+	}
+
 	Vector<SPtr<PixelData>> PixelUtil::genMipmaps(const PixelData& src, const MipMapGenOptions& options)
 	{
 		Vector<SPtr<PixelData>> outputMipBuffers;
@@ -255,16 +255,27 @@ namespace bs
 
 		/**
 		 * Converts pixels from one format to another. Provided pixel data objects must have previously allocated buffers
-		 * of adequate size and their sizes must match.
+		 * of adequate size and their sizes must match. Compressed source data is decompressed, which is only supported
+		 * for formats supported by decompress().
 		 */
 		static void bulkPixelConversion(const PixelData& src, PixelData& dst);
 
 		/** Flips the order of components in each individual pixel. For example RGBA -> ABGR. */
 		static void flipComponentOrder(PixelData& data);
 
-		/** Compresses the provided data using the specified compression options.  */
+		/**
+		 * Compresses the provided data using the specified compression options. Large images compressed to BC1 - BC5
+		 * formats are split into bands that are compressed in parallel, if the task scheduler is running.
+		 */
 		static void compress(const PixelData& src, PixelData& dst, const CompressionOptions& options);
 
+		/**
+		 * Decompresses block compressed data into an uncompressed format. Supported source formats are BC1 - BC5. Large
+		 * images are split into rows of blocks that are decompressed in parallel, if the task scheduler is running.
+		 * Returns false and logs an error if the data couldn't be decompressed, leaving the destination unchanged.
+		 */
+		static bool decompress(const PixelData& src, PixelData& dst);
+
 		/**
 		 * Generates mip-maps from the provided source data using the specified compression options. Returned list includes
 		 * the base level.
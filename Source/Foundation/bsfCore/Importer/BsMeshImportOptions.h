@@ -121,6 +121,27 @@ namespace bs
 		BS_SCRIPT_EXPORT()
 		bool importRootMotion = false;
 
+		/**
+		 * Enables or disables lossy compression of imported animation clips. Compressed clips remove keyframes that can be
+		 * reconstructed within the error tolerances below, and store the remaining keyframes at reduced precision. This
+		 * significantly reduces the memory used by the clips, at the cost of small deviations from the original
+		 * animation.
+		 */
+		BS_SCRIPT_EXPORT()
+		bool compressAnimation = false;
+
+		/** Maximum distance a compressed bone position is allowed to deviate from the original, in meters. */
+		BS_SCRIPT_EXPORT()
+		float animationPositionError = 0.0005f;
+
+		/** Maximum angle a compressed bone rotation is allowed to deviate from the original, in radians. */
+		BS_SCRIPT_EXPORT()
+		float animationRotationError = 0.0005f;
+
+		/** Maximum difference allowed between the components of a compressed bone scale and the original. */
+		BS_SCRIPT_EXPORT()
+		float animationScaleError = 0.0005f;
+
 		/** Uniformly scales the imported mesh by the specified value. */
 		BS_SCRIPT_EXPORT()
 		float importScale = 1.0f;
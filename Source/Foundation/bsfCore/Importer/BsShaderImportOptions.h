@@ -99,6 +99,19 @@ namespace bs
 		BS_SCRIPT_EXPORT()
 		ShadingLanguageFlags languages = ShadingLanguageFlag::All;
 
+		/**
+		 * Determines should the GPU programs generated from the shader be cached on disk. This allows programs that
+		 * haven't changed to be reused when the shader is re-imported, instead of being compiled again.
+		 */
+		BS_SCRIPT_EXPORT()
+		bool useCompileCache = true;
+
+		/**
+		 * Folder to store the compiled GPU program cache in, if enabled by @p useCompileCache. Can be set to a folder
+		 * within the project to use a per-project cache. If empty, a per-user folder is used.
+		 */
+		Path compileCacheFolder;
+
 		/** Creates a new import options object that allows you to customize how are meshes imported. */
 		BS_SCRIPT_EXPORT(ec:T)
 		static SPtr<ShaderImportOptions> create() { return bs_shared_ptr_new<ShaderImportOptions>(); }
@@ -162,6 +162,16 @@ namespace bs
 		return paramBlockPtr;
 	}
 
+	SPtr<GpuParamBlockBuffer> HardwareBufferManager::createGpuParamBlockBufferRange(
+		const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size)
+	{
+		SPtr<GpuParamBlockBuffer> paramBlockPtr = createGpuParamBlockBufferRangeInternal(parent, offset, size);
+		if(paramBlockPtr != nullptr)
+			paramBlockPtr->initialize();
+
+		return paramBlockPtr;
+	}
+
 	SPtr<GpuBuffer> HardwareBufferManager::createGpuBuffer(const GPU_BUFFER_DESC& desc,
 		GpuDeviceFlags deviceMask)
 	{
@@ -180,6 +190,12 @@ namespace bs
 		return gbuf;
 	}
 
+	SPtr<GpuParamBlockBuffer> HardwareBufferManager::createGpuParamBlockBufferRangeInternal(
+		const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size)
+	{
+		return nullptr;
+	}
+
 	SPtr<VertexDeclaration> HardwareBufferManager::createVertexDeclarationInternal(
 		const Vector<VertexElement>& elements, GpuDeviceFlags deviceMask)
 	{
@@ -121,6 +121,20 @@ namespace bs
 		SPtr<GpuParamBlockBuffer> createGpuParamBlockBuffer(UINT32 size,
 			GpuBufferUsage usage = GBU_DYNAMIC, GpuDeviceFlags deviceMask = GDF_DEFAULT);
 
+		/**
+		 * Creates a parameter block buffer representing a range of a larger parameter block buffer. The range can be
+		 * bound to GPU programs like any other buffer, while its data is uploaded together with the parent buffer.
+		 *
+		 * @param[in]	parent		Buffer to create a range of.
+		 * @param[in]	offset		Offset of the range in @p parent, in bytes. Must be a multiple of
+		 *							RenderAPICapabilities::paramBlockBufferOffsetAlignment.
+		 * @param[in]	size		Size of the range in bytes.
+		 * @return					New buffer, or null if the render backend doesn't support
+		 *							RSC_PARAM_BLOCK_BUFFER_RANGES.
+		 */
+		SPtr<GpuParamBlockBuffer> createGpuParamBlockBufferRange(const SPtr<GpuParamBlockBuffer>& parent,
+			UINT32 offset, UINT32 size);
+
 		/**
 		 * @copydoc bs::HardwareBufferManager::createGpuBuffer
 		 * @param[in]	deviceMask		Mask that determines on which GPU devices should the object be created on.
@@ -175,6 +189,10 @@ namespace bs
 		virtual SPtr<GpuParamBlockBuffer> createGpuParamBlockBufferInternal(UINT32 size,
 			GpuBufferUsage usage = GBU_DYNAMIC, GpuDeviceFlags deviceMask = GDF_DEFAULT) = 0;
 
+		/** @copydoc createGpuParamBlockBufferRange */
+		virtual SPtr<GpuParamBlockBuffer> createGpuParamBlockBufferRangeInternal(
+			const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size);
+
 		/** @copydoc createGpuBuffer(const GPU_BUFFER_DESC&, GpuDeviceFlags) */
 		virtual SPtr<GpuBuffer> createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
 			GpuDeviceFlags deviceMask = GDF_DEFAULT) = 0;
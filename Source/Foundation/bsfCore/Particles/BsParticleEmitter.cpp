@@ -7,6 +7,7 @@
 #include "Math/BsRandom.h"
 #include "Components/BsCRenderable.h"
 #include "Private/Particles/BsParticleSet.h"
+#include "Private/Particles/BsParticleKernels.h"
 #include "Private/RTTI/BsParticleSystemRTTI.h"
 #include "Animation/BsAnimation.h"
 #include "Animation/BsAnimationManager.h"
@@ -1450,17 +1451,13 @@ namespace bs
 		for(UINT32 i = firstIdx; i < endIdx; i++)
 			particles.seed[i] = random.get();
 
-		for(UINT32 i = firstIdx; i < endIdx; i++)
-			particles.frame[i] = 0.0f;
+		std::fill(particles.frame + firstIdx, particles.frame + endIdx, 0.0f);
 
 		// If in world-space we apply the transform here, otherwise we apply it in the rendering code
 		if(state.worldSpace)
 		{
-			for (UINT32 i = firstIdx; i < endIdx; i++)
-				particles.position[i] = state.localToWorld.multiplyAffine(particles.position[i]);
-
-			for (UINT32 i = firstIdx; i < endIdx; i++)
-				particles.velocity[i] = state.localToWorld.multiplyDirection(particles.velocity[i]);
+			ParticleKernels::transformPoints(particles.position + firstIdx, state.localToWorld, count);
+			ParticleKernels::transformDirections(particles.velocity + firstIdx, state.localToWorld, count);
 		}
 
 		bs_stack_free(emitterT);
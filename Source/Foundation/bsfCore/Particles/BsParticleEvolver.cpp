@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Particles/BsParticleEvolver.h"
 #include "Private/Particles/BsParticleSet.h"
+#include "Private/Particles/BsParticleKernels.h"
 #include "Private/RTTI/BsParticleSystemRTTI.h"
 #include "Particles/BsVectorField.h"
 #include "Image/BsSpriteTexture.h"
@@ -234,6 +235,16 @@ namespace bs
 		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
+		// Constant velocity moves all particles by the same amount, unless they are spaced over the time-step
+		if(!spacing && mDesc.velocity.getType() == PDT_Constant)
+		{
+			const Vector3 velocity = evaluateTransformed<true>(mDesc.velocity, state, 0.0f, Random(),
+				mDesc.worldSpace) * state.timeStep;
+
+			ParticleKernels::add(particles.position + startIdx, velocity, count);
+			return;
+		}
+
 		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
 		for (UINT32 i = startIdx; i < endIdx; i++)
 		{
@@ -285,6 +296,16 @@ namespace bs
 		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
+		// Constant force accelerates all particles by the same amount, unless they are spaced over the time-step
+		if(!spacing && mDesc.force.getType() == PDT_Constant)
+		{
+			const Vector3 force = evaluateTransformed<true>(mDesc.force, state, 0.0f, Random(),
+				mDesc.worldSpace) * state.timeStep;
+
+			ParticleKernels::add(particles.velocity + startIdx, force * state.timeStep, count);
+			return;
+		}
+
 		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
 		for (UINT32 i = startIdx; i < endIdx; i++)
 		{
@@ -341,7 +362,13 @@ namespace bs
 		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
-		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
+		if(!spacing)
+		{
+			ParticleKernels::add(particles.velocity + startIdx, gravity * state.timeStep, count);
+			return;
+		}
+
+		const float subFrameSpacing = count > 0 ? 1.0f / count : 1.0f;
 		for (UINT32 i = startIdx; i < endIdx; i++)
 		{
 			float timeStep = state.timeStep;
@@ -386,13 +413,24 @@ namespace bs
 		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
+		if(mDesc.color.getType() == PDT_Constant)
+		{
+			const auto color = mDesc.color.evaluate(0.0f, Random());
+			std::fill(particles.color + startIdx, particles.color + endIdx, color);
+			return;
+		}
+
+		float* particleT = bs_stack_alloc<float>(count);
+		ParticleKernels::normalizedAge(particles.initialLifetime + startIdx, particles.lifetime + startIdx, particleT,
+			count);
+
 		for (UINT32 i = startIdx; i < endIdx; i++)
 		{
 			const UINT32 colorSeed = particles.seed[i] + PARTICLE_COLOR;
-			const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
-
-			particles.color[i] = mDesc.color.evaluate(particleT, Random(colorSeed));
+			particles.color[i] = mDesc.color.evaluate(particleT[i - startIdx], Random(colorSeed));
 		}
+
+		bs_stack_free(particleT);
 	}
 
 	SPtr<ParticleColor> ParticleColor::create(const PARTICLE_COLOR_DESC& desc)
@@ -425,14 +463,31 @@ namespace bs
 		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
+		if(!mDesc.use3DSize && mDesc.size.getType() == PDT_Constant)
+		{
+			const float size = mDesc.size.evaluate(0.0f, Random());
+			std::fill(particles.size + startIdx, particles.size + endIdx, Vector3(size, size, size));
+			return;
+		}
+
+		if(mDesc.use3DSize && mDesc.size3D.getType() == PDT_Constant)
+		{
+			const Vector3 size = mDesc.size3D.evaluate(0.0f, Random());
+			std::fill(particles.size + startIdx, particles.size + endIdx, size);
+			return;
+		}
+
+		float* particleT = bs_stack_alloc<float>(count);
+		ParticleKernels::normalizedAge(particles.initialLifetime + startIdx, particles.lifetime + startIdx, particleT,
+			count);
+
 		if(!mDesc.use3DSize)
 		{
 			for (UINT32 i = startIdx; i < endIdx; i++)
 			{
 				const UINT32 sizeSeed = particles.seed[i] + PARTICLE_SIZE;
-				const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
 
-				const float size = mDesc.size.evaluate(particleT, Random(sizeSeed));
+				const float size = mDesc.size.evaluate(particleT[i - startIdx], Random(sizeSeed));
 				particles.size[i] = Vector3(size, size, size);
 			}
 		}
@@ -441,11 +496,11 @@ namespace bs
 			for (UINT32 i = startIdx; i < endIdx; i++)
 			{
 				const UINT32 sizeSeed = particles.seed[i] + PARTICLE_SIZE;
-				const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
-
-				particles.size[i] = mDesc.size3D.evaluate(particleT, Random(sizeSeed));
+				particles.size[i] = mDesc.size3D.evaluate(particleT[i - startIdx], Random(sizeSeed));
 			}
 		}
+
+		bs_stack_free(particleT);
 	}
 
 	SPtr<ParticleSize> ParticleSize::create(const PARTICLE_SIZE_DESC& desc)
@@ -668,8 +723,21 @@ namespace bs
 
 			numPlanes[1] = (UINT32)mCollisionPlanes.size();
 
-			for(UINT32 i = startIdx; i < endIdx; i++)
+			// Most particles are nowhere near a plane, so find the ones that are first and only process those further.
+			// Both plane sets are tested at once for simplicity, the response below still handles them in order.
+			const UINT32 numAllPlanes = numPlanes[0] + numPlanes[1];
+			Plane* allPlanes = bs_stack_alloc<Plane>(numAllPlanes);
+			std::copy(planes[0], planes[0] + numPlanes[0], allPlanes);
+			std::copy(planes[1], planes[1] + numPlanes[1], allPlanes + numPlanes[0]);
+
+			UINT32* candidates = bs_stack_alloc<UINT32>(count);
+			const UINT32 numCandidates = ParticleKernels::findPlaneCollisions(particles.position + startIdx, count,
+				allPlanes, numAllPlanes, mDesc.radius, candidates);
+
+			for(UINT32 c = 0; c < numCandidates; c++)
 			{
+				const UINT32 i = startIdx + candidates[c];
+
 				Vector3& position = particles.position[i];
 				Vector3& velocity = particles.velocity[i];
 
@@ -705,11 +773,15 @@ namespace bs
 				}
 			}
 
-			if(objPlanes)
-				bs_stack_free(objPlanes);
+			bs_stack_free(candidates);
+			bs_stack_free(allPlanes);
 
+			// Note: Freed in opposite order of allocation, as required by the stack allocator
 			if(localPlanes)
 				bs_stack_free(localPlanes);
+
+			if(objPlanes)
+				bs_stack_free(objPlanes);
 		}
 		else
 		{
@@ -375,93 +375,76 @@ namespace bs
 		simulationData.cpuData.clear();
 		simulationData.gpuData.clear();
 
-		// Queue evaluation tasks
-		{
-			Lock lock(mMutex);
-			mNumActiveWorkers = (UINT32)mSystems.size();
-		}
-
 		float timeDelta = gTime().getFrameDelta();
 
 		ParticleSimulationDataPool& simDataPool = m->simDataPool[mWriteBufferIdx];
 		simDataPool.clear();
 
-		for (auto& system : mSystems)
+		// Queue evaluation tasks
+		Vector<ParticleSystem*> systems(mSystems.begin(), mSystems.end());
+		const auto evaluateWorker = [this, timeDelta, &systems, &animData, &simDataPool, &simulationData](UINT32 idx)
 		{
-			const auto evaluateWorker = [this, timeDelta, system, &animData, &simDataPool, &simulationData]()
+			ParticleSystem* system = systems[idx];
+
+			// Advance the simulation
+			system->_simulate(timeDelta, &animData);
+
+			ParticleRenderData* simulationDataCPU = nullptr;
+			ParticleGPUSimulationData* simulationDataGPU = nullptr;
+			if(system->mParticleSet)
 			{
-				// Advance the simulation
-				system->_simulate(timeDelta, &animData);
+				// Generate simulation data to transfer to the core thread
+				const UINT32 numParticles = system->mParticleSet->getParticleCount();
+				const ParticleSystemSettings& settings = system->getSettings();
 
-				ParticleRenderData* simulationDataCPU = nullptr;
-				ParticleGPUSimulationData* simulationDataGPU = nullptr;
-				if(system->mParticleSet)
+				if(settings.gpuSimulation)
+					simulationDataGPU = simDataPool.allocGPU(*system->mParticleSet);
+				else
 				{
-					// Generate simulation data to transfer to the core thread
-					const UINT32 numParticles = system->mParticleSet->getParticleCount();
-					const ParticleSystemSettings& settings = system->getSettings();
-
-					if(settings.gpuSimulation)
-						simulationDataGPU = simDataPool.allocGPU(*system->mParticleSet);
+					if(settings.renderMode == ParticleRenderMode::Billboard)
+						simulationDataCPU = simDataPool.allocCPUBillboard(*system->mParticleSet);
 					else
-					{
-						if(settings.renderMode == ParticleRenderMode::Billboard)
-							simulationDataCPU = simDataPool.allocCPUBillboard(*system->mParticleSet);
-						else
-							simulationDataCPU = simDataPool.allocCPUMesh(*system->mParticleSet);
-
-						simulationDataCPU->numParticles = numParticles;
-
-						if(settings.useAutomaticBounds)
-							simulationDataCPU->bounds = system->_calculateBounds();
-						else
-							simulationDataCPU->bounds = settings.customBounds;
-
-						// If using a camera-independant sorting mode, sort the particles right away
-						switch (settings.sortMode)
-						{
-						default:
-						case ParticleSortMode::None: // No sort, just point the indices back to themselves
-							for (UINT32 i = 0; i < numParticles; i++)
-								simulationDataCPU->indices[i] = i;
-							break;
-						case ParticleSortMode::OldToYoung:
-						case ParticleSortMode::YoungToOld:
-							sortParticles(*system->mParticleSet, settings.sortMode, Vector3::ZERO, simulationDataCPU->indices.data());
-							break;
-						case ParticleSortMode::Distance: break;
-						}
-					}
-				}
+						simulationDataCPU = simDataPool.allocCPUMesh(*system->mParticleSet);
 
-				{
-					Lock lock(mMutex);
+					simulationDataCPU->numParticles = numParticles;
 
-					assert(mNumActiveWorkers > 0);
-					mNumActiveWorkers--;
+					if(settings.useAutomaticBounds)
+						simulationDataCPU->bounds = system->_calculateBounds();
+					else
+						simulationDataCPU->bounds = settings.customBounds;
 
-					if(simulationDataCPU)
-						simulationData.cpuData[system->mId] = simulationDataCPU;
-					else if(simulationDataGPU)
-						simulationData.gpuData[system->mId] = simulationDataGPU;
+					// If using a camera-independant sorting mode, sort the particles right away
+					switch (settings.sortMode)
+					{
+					default:
+					case ParticleSortMode::None: // No sort, just point the indices back to themselves
+						for (UINT32 i = 0; i < numParticles; i++)
+							simulationDataCPU->indices[i] = i;
+						break;
+					case ParticleSortMode::OldToYoung:
+					case ParticleSortMode::YoungToOld:
+						sortParticles(*system->mParticleSet, settings.sortMode, Vector3::ZERO, simulationDataCPU->indices.data());
+						break;
+					case ParticleSortMode::Distance: break;
+					}
 				}
+			}
 
-				mWorkerDoneSignal.notify_one();
-			};
+			{
+				Lock lock(mMutex);
 
-			SPtr<Task> task = Task::create("ParticleWorker", evaluateWorker);
-			TaskScheduler::instance().addTask(task);
-		}
+				if(simulationDataCPU)
+					simulationData.cpuData[system->mId] = simulationDataCPU;
+				else if(simulationDataGPU)
+					simulationData.gpuData[system->mId] = simulationDataGPU;
+			}
+		};
 
-		// Wait for tasks to complete
-		TaskScheduler::instance().addWorker(); // Make the current core available for work (since this thread waits)
-		{
-			Lock lock(mMutex);
+		SPtr<TaskGroup> taskGroup = TaskGroup::create("ParticleWorker", evaluateWorker, (UINT32)systems.size());
+		TaskScheduler::instance().addTaskGroup(taskGroup);
 
-			while (mNumActiveWorkers > 0)
-				mWorkerDoneSignal.wait(lock);
-		}
-		TaskScheduler::instance().removeWorker();
+		// Wait for tasks to complete, executing them on this thread as well
+		taskGroup->wait();
 
 		mSwapBuffers = true;
 
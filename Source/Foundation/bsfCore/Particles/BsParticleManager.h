@@ -161,10 +161,7 @@ namespace bs
 		UINT32 mReadBufferIdx = 1;
 		UINT32 mWriteBufferIdx = 0;
 		
-		Signal mWorkerDoneSignal;
 		Mutex mMutex;
-
-		UINT32 mNumActiveWorkers = 0;
 		bool mSwapBuffers = false;
 	};
 
@@ -5,6 +5,7 @@
 #include "Particles/BsParticleEmitter.h"
 #include "Particles/BsParticleEvolver.h"
 #include "Private/Particles/BsParticleSet.h"
+#include "Private/Particles/BsParticleKernels.h"
 #include "Private/RTTI/BsParticleSystemRTTI.h"
 #include "Allocators/BsPoolAlloc.h"
 #include "Material/BsMaterial.h"
@@ -303,18 +304,18 @@ namespace bs
 		const UINT32 endIdx = startIdx + count;
 
 		// Decrement lifetime
-		for (UINT32 i = startIdx; i < endIdx; i++)
+		if(!spacing)
+			ParticleKernels::subtract(particles.lifetime + startIdx, state.timeStep, count);
+		else
 		{
-			float timeStep = state.timeStep;
-			if(spacing)
+			for (UINT32 i = startIdx; i < endIdx; i++)
 			{
 				// Note: We're calculating this in a few places during a single frame. Store it and re-use?
 				const UINT32 localIdx = i - startIdx;
 				const float subFrameOffset = ((float)localIdx + spacingOffset) * subFrameSpacing;
-				timeStep *= subFrameOffset;
-			}
 
-			particles.lifetime[i] -= timeStep;
+				particles.lifetime[i] -= state.timeStep * subFrameOffset;
+			}
 		}
 
 		// Kill expired particles
@@ -332,8 +333,7 @@ namespace bs
 		}
 
 		// Remember old positions
-		for (UINT32 i = startIdx; i < endIdx; i++)
-			particles.prevPosition[i] = particles.position[i];
+		bs_copy(particles.prevPosition + startIdx, particles.position + startIdx, count);
 
 		// Evolve pre-simulation
 		for(auto& evolver : mEvolvers)
@@ -353,18 +353,21 @@ namespace bs
 		float spacingOffset)
 	{
 		const ParticleSetData& particles = mParticleSet->getParticles();
-		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
+
+		if(!spacing)
+		{
+			ParticleKernels::addScaled(particles.position + startIdx, particles.velocity + startIdx, state.timeStep, count);
+			return;
+		}
+
+		const float subFrameSpacing = count > 0 ? 1.0f / count : 1.0f;
 		const UINT32 endIdx = startIdx + count;
 
 		for (UINT32 i = startIdx; i < endIdx; i++)
 		{
-			float timeStep = state.timeStep;
-			if(spacing)
-			{
-				const UINT32 localIdx = i - startIdx;
-				const float subFrameOffset = ((float)localIdx + spacingOffset) * subFrameSpacing;
-				timeStep *= subFrameOffset;
-			}
+			const UINT32 localIdx = i - startIdx;
+			const float subFrameOffset = ((float)localIdx + spacingOffset) * subFrameSpacing;
+			const float timeStep = state.timeStep * subFrameOffset;
 
 			particles.position[i] += particles.velocity[i] * timeStep;
 		}
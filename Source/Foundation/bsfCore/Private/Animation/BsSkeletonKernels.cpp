@@ -0,0 +1,420 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Animation/BsSkeletonKernels.h"
+#include "Math/BsSIMD.h"
+
+namespace bs
+{
+	constexpr UINT32 SkeletonKernels::SIMD_WIDTH;
+
+	static_assert(sizeof(Vector3) == sizeof(float) * 3, "Kernels assume Vector3 arrays are tightly packed floats.");
+	static_assert(sizeof(Quaternion) == sizeof(float) * 4, "Kernels assume Quaternion arrays are packed floats.");
+	static_assert(sizeof(Matrix4) == sizeof(float) * 16, "Kernels assume Matrix4 is stored as 16 row-major floats.");
+
+	/** Number of floats in the upper 3x4 part of a matrix. */
+	static constexpr UINT32 AFFINE_SIZE = 12;
+
+	/** Returns the number of bones rounded up to a multiple of the SIMD width. */
+	static UINT32 getPaddedNumBones(UINT32 numBones)
+	{
+		return Math::divideAndRoundUp(numBones, SkeletonKernels::SIMD_WIDTH) * SkeletonKernels::SIMD_WIDTH;
+	}
+
+	/** Vector components of four bones, one register per component. */
+	struct SIMDVector3
+	{
+		simd::float32x4 x, y, z;
+	};
+
+	/** Quaternion components of four bones, one register per component. */
+	struct SIMDQuaternion
+	{
+		simd::float32x4 x, y, z, w;
+	};
+
+	/** Loads the vector components of four bones, starting at bone @p idx. */
+	static SIMDVector3 loadVector3(float* const (&components)[3], UINT32 idx)
+	{
+		return
+		{
+			simd::load_u<simd::float32x4>(components[0] + idx),
+			simd::load_u<simd::float32x4>(components[1] + idx),
+			simd::load_u<simd::float32x4>(components[2] + idx)
+		};
+	}
+
+	/** Loads the quaternion components of four bones, starting at bone @p idx. */
+	static SIMDQuaternion loadQuaternion(float* const (&components)[4], UINT32 idx)
+	{
+		return
+		{
+			simd::load_u<simd::float32x4>(components[0] + idx),
+			simd::load_u<simd::float32x4>(components[1] + idx),
+			simd::load_u<simd::float32x4>(components[2] + idx),
+			simd::load_u<simd::float32x4>(components[3] + idx)
+		};
+	}
+
+	/** Stores the quaternion components of four bones, starting at bone @p idx. */
+	static void storeQuaternion(float* const (&components)[4], const SIMDQuaternion& value, UINT32 idx)
+	{
+		simd::store_u(components[0] + idx, value.x);
+		simd::store_u(components[1] + idx, value.y);
+		simd::store_u(components[2] + idx, value.z);
+		simd::store_u(components[3] + idx, value.w);
+	}
+
+	/** Returns the dot product of two sets of four quaternions, in the same order as Quaternion::dot(). */
+	static simd::float32x4 dot(const SIMDQuaternion& a, const SIMDQuaternion& b)
+	{
+		simd::float32x4 output = simd::mul(a.w, b.w);
+		output = simd::add(output, simd::mul(a.x, b.x));
+		output = simd::add(output, simd::mul(a.y, b.y));
+		output = simd::add(output, simd::mul(a.z, b.z));
+
+		return output;
+	}
+
+	/** Multiplies each quaternion component with @p factor. */
+	static SIMDQuaternion scale(const SIMDQuaternion& value, const simd::float32x4& factor)
+	{
+		return { simd::mul(value.x, factor), simd::mul(value.y, factor), simd::mul(value.z, factor),
+			simd::mul(value.w, factor) };
+	}
+
+	/** Selects between two sets of quaternions, per bone. */
+	static SIMDQuaternion select(const SIMDQuaternion& on, const SIMDQuaternion& off, const simd::mask_float32x4& mask)
+	{
+		return { simd::blend(on.x, off.x, mask), simd::blend(on.y, off.y, mask), simd::blend(on.z, off.z, mask),
+			simd::blend(on.w, off.w, mask) };
+	}
+
+	UINT32 SkeletonKernels::getPoseSize(UINT32 numBones)
+	{
+		return getPaddedNumBones(numBones) * 10;
+	}
+
+	void SkeletonKernels::initPose(SoABonePose& pose, float* buffer, UINT32 numBones)
+	{
+		const UINT32 paddedNumBones = getPaddedNumBones(numBones);
+
+		for(auto& entry : pose.positions)
+		{
+			entry = buffer;
+			std::fill(entry, entry + paddedNumBones, 0.0f);
+
+			buffer += paddedNumBones;
+		}
+
+		for(auto& entry : pose.rotations)
+		{
+			entry = buffer;
+			std::fill(entry, entry + paddedNumBones, 0.0f);
+
+			buffer += paddedNumBones;
+		}
+
+		for(auto& entry : pose.scales)
+		{
+			entry = buffer;
+			std::fill(entry, entry + paddedNumBones, 1.0f);
+
+			buffer += paddedNumBones;
+		}
+	}
+
+	void SkeletonKernels::blendPositions(const SoABonePose& pose, const SoABonePose& values, const float* weights,
+		UINT32 numBones)
+	{
+		// Components are independent, so each can be processed as a separate array
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			float* dst = pose.positions[i];
+			const float* src = values.positions[i];
+
+			for(UINT32 j = 0; j < numBones; j += SIMD_WIDTH)
+			{
+				const simd::float32x4 weight = simd::load_u<simd::float32x4>(weights + j);
+				const simd::float32x4 value = simd::mul(simd::load_u<simd::float32x4>(src + j), weight);
+
+				simd::store_u(dst + j, simd::add(simd::load_u<simd::float32x4>(dst + j), value));
+			}
+		}
+	}
+
+	void SkeletonKernels::blendScales(const SoABonePose& pose, const SoABonePose& values, const float* weights,
+		UINT32 numBones)
+	{
+		const simd::float32x4 zero = simd::splat(0.0f);
+
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			float* dst = pose.scales[i];
+			const float* src = values.scales[i];
+
+			for(UINT32 j = 0; j < numBones; j += SIMD_WIDTH)
+			{
+				const simd::float32x4 weight = simd::load_u<simd::float32x4>(weights + j);
+				const simd::float32x4 current = simd::load_u<simd::float32x4>(dst + j);
+				const simd::float32x4 value = simd::mul(simd::load_u<simd::float32x4>(src + j), weight);
+
+				simd::store_u(dst + j, simd::blend(simd::mul(current, value), current, simd::cmp_neq(weight, zero)));
+			}
+		}
+	}
+
+	void SkeletonKernels::blendRotations(const SoABonePose& pose, const SoABonePose& values, const float* weights,
+		UINT32 numBones)
+	{
+		// Local copies, so the pointers don't need to be reloaded after every store
+		const SoABonePose dst = pose;
+		const SoABonePose src = values;
+		const simd::float32x4 zero = simd::splat(0.0f);
+
+		for(UINT32 i = 0; i < numBones; i += SIMD_WIDTH)
+		{
+			const simd::float32x4 weight = simd::load_u<simd::float32x4>(weights + i);
+
+			SIMDQuaternion current = loadQuaternion(dst.rotations, i);
+			SIMDQuaternion value = scale(loadQuaternion(src.rotations, i), weight);
+
+			const simd::mask_float32x4 flip = simd::cmp_lt(dot(value, current), zero);
+			value = select(scale(value, simd::splat(-1.0f)), value, flip);
+
+			current.x = simd::add(current.x, value.x);
+			current.y = simd::add(current.y, value.y);
+			current.z = simd::add(current.z, value.z);
+			current.w = simd::add(current.w, value.w);
+
+			storeQuaternion(dst.rotations, current, i);
+		}
+	}
+
+	void SkeletonKernels::blendRotationsAdditive(const SoABonePose& pose, const SoABonePose& values,
+		const float* weights, UINT32 numBones)
+	{
+		const SoABonePose dst = pose;
+		const SoABonePose src = values;
+
+		const simd::float32x4 zero = simd::splat(0.0f);
+		const simd::float32x4 one = simd::splat(1.0f);
+		const simd::float32x4 minusOne = simd::splat(-1.0f);
+		const simd::float32x4 normalizeTolerance = simd::splat(1e-04f);
+		const SIMDQuaternion identity = { zero, zero, zero, one };
+
+		for(UINT32 i = 0; i < numBones; i += SIMD_WIDTH)
+		{
+			const simd::float32x4 weight = simd::load_u<simd::float32x4>(weights + i);
+
+			// Rotations that weren't assigned yet start off as identity
+			const SIMDQuaternion original = loadQuaternion(dst.rotations, i);
+			const SIMDQuaternion current = select(identity, original, simd::cmp_eq(original.w, zero));
+
+			// Quaternion::lerp() from identity, the dot product with identity reduces to the W component
+			const SIMDQuaternion target = loadQuaternion(src.rotations, i);
+			const simd::float32x4 flip = simd::blend(one, minusOne, simd::cmp_ge(target.w, zero));
+
+			SIMDQuaternion value;
+			value.x = simd::mul(weight, target.x);
+			value.y = simd::mul(weight, target.y);
+			value.z = simd::mul(weight, target.z);
+			value.w = simd::add(simd::mul(flip, simd::sub(one, weight)), simd::mul(weight, target.w));
+
+			const simd::float32x4 lengthSqrd = dot(value, value);
+			const simd::float32x4 invLength = simd::div(one, simd::sqrt(lengthSqrd));
+			value = select(scale(value, invLength), value, simd::cmp_gt(lengthSqrd, normalizeTolerance));
+
+			// Quaternion multiplication, current * value, same order of operations as Quaternion::operator*
+			SIMDQuaternion product;
+			product.w = simd::mul(current.w, value.w);
+			product.w = simd::sub(product.w, simd::mul(current.x, value.x));
+			product.w = simd::sub(product.w, simd::mul(current.y, value.y));
+			product.w = simd::sub(product.w, simd::mul(current.z, value.z));
+
+			product.x = simd::mul(current.w, value.x);
+			product.x = simd::add(product.x, simd::mul(current.x, value.w));
+			product.x = simd::add(product.x, simd::mul(current.y, value.z));
+			product.x = simd::sub(product.x, simd::mul(current.z, value.y));
+
+			product.y = simd::mul(current.w, value.y);
+			product.y = simd::add(product.y, simd::mul(current.y, value.w));
+			product.y = simd::add(product.y, simd::mul(current.z, value.x));
+			product.y = simd::sub(product.y, simd::mul(current.x, value.z));
+
+			product.z = simd::mul(current.w, value.z);
+			product.z = simd::add(product.z, simd::mul(current.z, value.w));
+			product.z = simd::add(product.z, simd::mul(current.x, value.y));
+			product.z = simd::sub(product.z, simd::mul(current.y, value.x));
+
+			// Bones without a curve are left unchanged
+			storeQuaternion(dst.rotations, select(product, original, simd::cmp_neq(weight, zero)), i);
+		}
+	}
+
+	void SkeletonKernels::normalizeRotations(const SoABonePose& pose, UINT32 numBones)
+	{
+		const SoABonePose dst = pose;
+
+		const simd::float32x4 zero = simd::splat(0.0f);
+		const simd::float32x4 one = simd::splat(1.0f);
+		const simd::float32x4 normalizeTolerance = simd::splat(1e-04f * 1e-04f);
+		const SIMDQuaternion identity = { zero, zero, zero, one };
+
+		for(UINT32 i = 0; i < numBones; i += SIMD_WIDTH)
+		{
+			SIMDQuaternion rotation = loadQuaternion(dst.rotations, i);
+
+			const simd::float32x4 length = simd::sqrt(dot(rotation, rotation));
+			const simd::float32x4 invLength = simd::div(one, length);
+
+			const simd::mask_float32x4 unassigned = simd::cmp_eq(rotation.w, zero);
+			rotation = select(scale(rotation, invLength), rotation, simd::cmp_gt(length, normalizeTolerance));
+			rotation = select(identity, rotation, unassigned);
+
+			storeQuaternion(dst.rotations, rotation, i);
+		}
+	}
+
+	void SkeletonKernels::storePose(const SoABonePose& pose, Vector3* positions, Quaternion* rotations,
+		Vector3* scales, UINT32 numBones)
+	{
+		const SoABonePose src = pose;
+
+		for(UINT32 i = 0; i < numBones; i += SIMD_WIDTH)
+		{
+			const UINT32 numLanes = std::min(SIMD_WIDTH, numBones - i);
+
+			alignas(16) float vectorEntries[SIMD_WIDTH * 3];
+
+			const SIMDVector3 position = loadVector3(src.positions, i);
+			simd::store_packed3(vectorEntries, position.x, position.y, position.z);
+			memcpy(&positions[i], vectorEntries, sizeof(Vector3) * numLanes);
+
+			const SIMDVector3 scale = loadVector3(src.scales, i);
+			simd::store_packed3(vectorEntries, scale.x, scale.y, scale.z);
+			memcpy(&scales[i], vectorEntries, sizeof(Vector3) * numLanes);
+
+			alignas(16) float rotationEntries[SIMD_WIDTH * 4];
+
+			const SIMDQuaternion rotation = loadQuaternion(src.rotations, i);
+			simd::store_packed4(rotationEntries, rotation.x, rotation.y, rotation.z, rotation.w);
+			memcpy(&rotations[i], rotationEntries, sizeof(Quaternion) * numLanes);
+		}
+	}
+
+	void SkeletonKernels::calculateLocalTransforms(const SoABonePose& pose, const bool* skip, Matrix4* output,
+		UINT32 numBones)
+	{
+		const SoABonePose src = pose;
+		const simd::float32x4 one = simd::splat(1.0f);
+
+		for(UINT32 i = 0; i < numBones; i += SIMD_WIDTH)
+		{
+			const SIMDVector3 position = loadVector3(src.positions, i);
+			const SIMDQuaternion rotation = loadQuaternion(src.rotations, i);
+			const SIMDVector3 scale = loadVector3(src.scales, i);
+
+			// Same operations as Quaternion::toRotationMatrix() and Matrix4::setTRS()
+			const simd::float32x4 tx = simd::add(rotation.x, rotation.x);
+			const simd::float32x4 ty = simd::add(rotation.y, rotation.y);
+			const simd::float32x4 tz = simd::add(rotation.z, rotation.z);
+			const simd::float32x4 twx = simd::mul(tx, rotation.w);
+			const simd::float32x4 twy = simd::mul(ty, rotation.w);
+			const simd::float32x4 twz = simd::mul(tz, rotation.w);
+			const simd::float32x4 txx = simd::mul(tx, rotation.x);
+			const simd::float32x4 txy = simd::mul(ty, rotation.x);
+			const simd::float32x4 txz = simd::mul(tz, rotation.x);
+			const simd::float32x4 tyy = simd::mul(ty, rotation.y);
+			const simd::float32x4 tyz = simd::mul(tz, rotation.y);
+			const simd::float32x4 tzz = simd::mul(tz, rotation.z);
+
+			simd::float32x4 m00 = simd::mul(scale.x, simd::sub(one, simd::add(tyy, tzz)));
+			simd::float32x4 m01 = simd::mul(scale.y, simd::sub(txy, twz));
+			simd::float32x4 m02 = simd::mul(scale.z, simd::add(txz, twy));
+			simd::float32x4 m03 = position.x;
+
+			simd::float32x4 m10 = simd::mul(scale.x, simd::add(txy, twz));
+			simd::float32x4 m11 = simd::mul(scale.y, simd::sub(one, simd::add(txx, tzz)));
+			simd::float32x4 m12 = simd::mul(scale.z, simd::sub(tyz, twx));
+			simd::float32x4 m13 = position.y;
+
+			simd::float32x4 m20 = simd::mul(scale.x, simd::sub(txz, twy));
+			simd::float32x4 m21 = simd::mul(scale.y, simd::add(tyz, twx));
+			simd::float32x4 m22 = simd::mul(scale.z, simd::sub(one, simd::add(txx, tyy)));
+			simd::float32x4 m23 = position.z;
+
+			// Transpose so each register holds a single row of one bone's matrix
+			simd::transpose4(m00, m01, m02, m03);
+			simd::transpose4(m10, m11, m12, m13);
+			simd::transpose4(m20, m21, m22, m23);
+
+			alignas(16) float entries[SIMD_WIDTH][AFFINE_SIZE];
+			simd::store(&entries[0][0], m00);
+			simd::store(&entries[0][4], m10);
+			simd::store(&entries[0][8], m20);
+			simd::store(&entries[1][0], m01);
+			simd::store(&entries[1][4], m11);
+			simd::store(&entries[1][8], m21);
+			simd::store(&entries[2][0], m02);
+			simd::store(&entries[2][4], m12);
+			simd::store(&entries[2][8], m22);
+			simd::store(&entries[3][0], m03);
+			simd::store(&entries[3][4], m13);
+			simd::store(&entries[3][8], m23);
+
+			const UINT32 numLanes = std::min(SIMD_WIDTH, numBones - i);
+			for(UINT32 lane = 0; lane < numLanes; lane++)
+			{
+				if(skip != nullptr && skip[i + lane])
+					continue;
+
+				Matrix4& matrix = output[i + lane];
+				memcpy(&matrix, entries[lane], sizeof(entries[lane]));
+				matrix[3] = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
+			}
+		}
+	}
+
+	void SkeletonKernels::multiplyAffine(const Matrix4& lhs, const Matrix4& rhs, Matrix4& output)
+	{
+		const float* lhsEntries = (const float*)&lhs;
+		const float* rhsEntries = (const float*)&rhs;
+
+		const simd::float32x4 rhsRows[4] =
+		{
+			simd::load_u<simd::float32x4>(rhsEntries + 0),
+			simd::load_u<simd::float32x4>(rhsEntries + 4),
+			simd::load_u<simd::float32x4>(rhsEntries + 8),
+			simd::make_float(0.0f, 0.0f, 0.0f, 1.0f)
+		};
+
+		// Same order of operations as Matrix4::operator*
+		simd::float32x4 rows[3];
+		for(UINT32 row = 0; row < 3; row++)
+		{
+			// Broadcast from a register rather than from memory, as the matrix was usually just written to
+			const simd::float32x4 lhsRow = simd::load_u<simd::float32x4>(lhsEntries + row * 4);
+			const simd::float32x4 lhs0 = simd::permute4<0, 0, 0, 0>(lhsRow);
+			const simd::float32x4 lhs1 = simd::permute4<1, 1, 1, 1>(lhsRow);
+			const simd::float32x4 lhs2 = simd::permute4<2, 2, 2, 2>(lhsRow);
+			const simd::float32x4 lhs3 = simd::permute4<3, 3, 3, 3>(lhsRow);
+
+			rows[row] = simd::mul(lhs0, rhsRows[0]);
+			rows[row] = simd::add(rows[row], simd::mul(lhs1, rhsRows[1]));
+			rows[row] = simd::add(rows[row], simd::mul(lhs2, rhsRows[2]));
+			rows[row] = simd::add(rows[row], simd::mul(lhs3, rhsRows[3]));
+		}
+
+		float* outputEntries = (float*)&output;
+		for(UINT32 row = 0; row < 3; row++)
+			simd::store_u(outputEntries + row * 4, rows[row]);
+
+		output[3] = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	void SkeletonKernels::multiplyAffine(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, UINT32 count)
+	{
+		for(UINT32 i = 0; i < count; i++)
+			multiplyAffine(lhs[i], rhs[i], output[i]);
+	}
+}
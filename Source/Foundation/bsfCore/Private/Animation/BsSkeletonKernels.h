@@ -0,0 +1,98 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Math/BsVector3.h"
+#include "Math/BsQuaternion.h"
+#include "Math/BsMatrix4.h"
+
+namespace bs
+{
+	/** @addtogroup Animation-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Local transforms of a set of bones, in structure-of-arrays layout. Each array holds a single component of all the
+	 * bones, padded to a multiple of SkeletonKernels::SIMD_WIDTH bones.
+	 */
+	struct SoABonePose
+	{
+		float* positions[3] = { }; /**< X, Y and Z components of the bone positions. */
+		float* rotations[4] = { }; /**< X, Y, Z and W components of the bone rotations. */
+		float* scales[3] = { }; /**< X, Y and Z components of the bone scales. */
+	};
+
+	/**
+	 * SIMD kernels used by Skeleton::getPose() for blending animated bone poses and calculating bone matrices. Pose
+	 * kernels process four bones at a time and expect their arrays to be padded accordingly. Matrix kernels only handle
+	 * affine matrices, and only calculate their upper 3x4 part.
+	 */
+	struct BS_CORE_EXPORT SkeletonKernels
+	{
+		/** Number of bones processed at once by the pose kernels. */
+		static constexpr UINT32 SIMD_WIDTH = 4;
+
+		/** Returns the number of floats needed for storing a pose of @p numBones bones. */
+		static UINT32 getPoseSize(UINT32 numBones);
+
+		/**
+		 * Initializes the pose arrays to point to @p buffer, which must be able to hold getPoseSize() floats, and sets
+		 * all bones to zero position and rotation, and unit scale.
+		 */
+		static void initPose(SoABonePose& pose, float* buffer, UINT32 numBones);
+
+		/** Adds each of the @p values positions, multiplied by its entry in @p weights, to the @p pose positions. */
+		static void blendPositions(const SoABonePose& pose, const SoABonePose& values, const float* weights,
+			UINT32 numBones);
+
+		/**
+		 * Multiplies each of the @p pose scales with the @p values scale, multiplied by its entry in @p weights. Bones
+		 * with zero weight are left unchanged.
+		 */
+		static void blendScales(const SoABonePose& pose, const SoABonePose& values, const float* weights,
+			UINT32 numBones);
+
+		/**
+		 * Adds each of the @p values rotations, multiplied by its entry in @p weights, to the @p pose rotations. Values
+		 * are negated if needed, so they are accumulated along the shortest path. Accumulated rotations must be
+		 * normalized using normalizeRotations() once blending is done.
+		 */
+		static void blendRotations(const SoABonePose& pose, const SoABonePose& values, const float* weights,
+			UINT32 numBones);
+
+		/**
+		 * Applies each of the @p values rotations on top of the @p pose rotations, after interpolating them from
+		 * identity by their entry in @p weights. Bones with zero weight are left unchanged. Pose rotations that were not
+		 * yet assigned (zero W component) are treated as identity.
+		 */
+		static void blendRotationsAdditive(const SoABonePose& pose, const SoABonePose& values, const float* weights,
+			UINT32 numBones);
+
+		/** Normalizes the pose rotations. Rotations that were never assigned (zero W component) are set to identity. */
+		static void normalizeRotations(const SoABonePose& pose, UINT32 numBones);
+
+		/** Copies the bone transforms from the SoA pose into separate arrays of positions, rotations and scales. */
+		static void storePose(const SoABonePose& pose, Vector3* positions, Quaternion* rotations, Vector3* scales,
+			UINT32 numBones);
+
+		/**
+		 * Calculates the local transform matrix of each bone in the pose. Bones for which @p skip is true are not
+		 * written to. @p skip can be null, in which case all bones are written.
+		 */
+		static void calculateLocalTransforms(const SoABonePose& pose, const bool* skip, Matrix4* output,
+			UINT32 numBones);
+
+		/** Multiplies two affine matrices. @p output is allowed to be the same as either of the inputs. */
+		static void multiplyAffine(const Matrix4& lhs, const Matrix4& rhs, Matrix4& output);
+
+		/**
+		 * Multiplies each of the @p count affine matrices in @p lhs with the matching matrix in @p rhs. @p output is
+		 * allowed to be the same as either of the inputs.
+		 */
+		static void multiplyAffine(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, UINT32 count);
+	};
+
+	/** @} */
+}
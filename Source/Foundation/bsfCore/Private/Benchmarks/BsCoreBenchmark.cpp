@@ -0,0 +1,1250 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsCorePrerequisites.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationUtility.h"
+#include "Animation/BsCompressedAnimationCurves.h"
+#include "Animation/BsCurveCache.h"
+#include "Animation/BsSkeleton.h"
+#include "Animation/BsSkeletonMask.h"
+#include "Math/BsRandom.h"
+#include "Private/Animation/BsSkeletonKernels.h"
+#include "Private/Particles/BsParticleKernels.h"
+#include "Profiling/BsProfilerCPU.h"
+#include "Scene/BsGameObjectManager.h"
+#include "Scene/BsSceneObject.h"
+#include "Private/Scene/BsSceneTransformPass.h"
+#include "Image/BsPixelUtil.h"
+#include "Image/BsColor.h"
+#include "Private/Image/BsPixelConversionKernels.h"
+#include "Private/Image/BsTextureImportUtility.h"
+#include "Private/Image/BsBCDecompressionKernels.h"
+#include "Importer/BsTextureImportOptions.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTimer.h"
+
+#include <iostream>
+#include <random>
+
+namespace bs
+{
+	/**
+	 * Measures the throughput of commands queued through CoreThread::queueCommand and submitted with CoreThread::submit.
+	 * Commands queued from the sim thread go through the lock-free ring queue, while commands from other threads go
+	 * through the per-thread synchronized queues.
+	 */
+	void benchmarkCoreThreadQueue()
+	{
+		static constexpr UINT32 NUM_COMMANDS = 1000000;
+		static constexpr UINT32 NUM_COMMANDS_PER_SUBMIT = 1000;
+
+		CoreThread::startUp();
+
+		// Large enough that std::function can't store it inline
+		struct LargePayload
+		{
+			UINT64 values[8];
+		};
+
+		UINT64 sink = 0;
+		LargePayload payload = {};
+
+		const auto queueCommands = [&sink, &payload](bool large)
+		{
+			for(UINT32 i = 0; i < NUM_COMMANDS; i++)
+			{
+				if(large)
+					gCoreThread().queueCommand([&sink, payload]() { sink += payload.values[0]; });
+				else
+					gCoreThread().queueCommand([&sink]() { sink++; });
+
+				if(((i + 1) % NUM_COMMANDS_PER_SUBMIT) == 0)
+					gCoreThread().submit();
+			}
+
+			gCoreThread().submit(true);
+		};
+
+		const auto toCommandsPerSecond = [](UINT64 time) { return NUM_COMMANDS * 1000000.0 / std::max(time, (UINT64)1); };
+
+		std::cout << "CoreThread command queue (" << NUM_COMMANDS_PER_SUBMIT << " commands per submit)" << std::endl;
+		for(auto large : { false, true })
+		{
+			Timer timer;
+			queueCommands(large);
+			const UINT64 simThreadTime = timer.getMicroseconds();
+
+			timer.reset();
+			HThread thread = ThreadPool::instance().run("Benchmark", [&queueCommands, large]() { queueCommands(large); });
+			thread.blockUntilComplete();
+			const UINT64 otherThreadTime = timer.getMicroseconds();
+
+			std::cout << "  " << (large ? "Large" : "Small") << " commands" << std::endl;
+			std::cout << "    Sim thread (ring queue):    " << toCommandsPerSecond(simThreadTime) << " commands/s" << std::endl;
+			std::cout << "    Other thread (sync queue):  " << toCommandsPerSecond(otherThreadTime) << " commands/s" << std::endl;
+		}
+
+		CoreThread::shutDown();
+	}
+
+	/**
+	 * Measures the cost of taking CPU profiler samples in each of the profiler modes, and compares it against the
+	 * overhead the profiler estimates for itself on start-up.
+	 */
+	void benchmarkProfilerCPU()
+	{
+		static constexpr UINT32 NUM_FRAMES = 100;
+		static constexpr UINT32 NUM_SAMPLES_PER_FRAME = 2000;
+
+		ProfilerCPU::startUp();
+
+		const CPUProfilerOverhead& overhead = gProfilerCPU().getOverhead();
+		const auto toNs = [](double timeMs) { return timeMs * 1000000.0; };
+
+		std::cout << "CPU profiler (" << NUM_SAMPLES_PER_FRAME << " samples per frame)" << std::endl;
+		std::cout << "  Estimated overhead" << std::endl;
+		std::cout << "    Timer:           " << toNs(overhead.timerMs) << " ns" << std::endl;
+		std::cout << "    Basic sample:    " << toNs(overhead.basicSampleMs) << " ns" << std::endl;
+		std::cout << "    Precise sample:  " << toNs(overhead.preciseSampleMs) << " ns" << std::endl;
+		std::cout << "    Trace sample:    " << toNs(overhead.traceSampleMs) << " ns" << std::endl;
+
+		std::cout << "  Measured" << std::endl;
+		const std::pair<CPUProfilerMode, const char*> modes[] =
+		{
+			{ CPUProfilerMode::Report, "Report:          " },
+			{ CPUProfilerMode::Trace, "Trace:           " },
+			{ CPUProfilerMode::ReportAndTrace, "Report + trace:  " }
+		};
+
+		for(auto& mode : modes)
+		{
+			gProfilerCPU().setMode(mode.first);
+
+			UINT64 sampleTime = 0;
+			for(UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+			{
+				Timer timer;
+				gProfilerCPU().beginThread("Benchmark");
+				for(UINT32 i = 0; i < NUM_SAMPLES_PER_FRAME / 2; i++)
+				{
+					gProfilerCPU().beginSample("Outer");
+					gProfilerCPU().beginSample("Inner");
+					gProfilerCPU().endSample("Inner");
+					gProfilerCPU().endSample("Outer");
+				}
+				gProfilerCPU().endThread();
+				sampleTime += timer.getMicroseconds();
+
+				// Same as ProfilingManager does at the end of every frame
+				gProfilerCPU().generateReport();
+				gProfilerCPU().reset();
+				gProfilerCPU().mergeTraceEvents();
+			}
+
+			const double timePerSampleNs = sampleTime * 1000.0 / (NUM_FRAMES * NUM_SAMPLES_PER_FRAME);
+			std::cout << "    " << mode.second << timePerSampleNs << " ns/sample" << std::endl;
+
+			gProfilerCPU().clearTrace();
+		}
+
+		ProfilerCPU::shutDown();
+	}
+
+	/**
+	 * Measures particle simulation throughput on a single core, comparing the original per-particle update loops against
+	 * the SIMD particle kernels. A frame consists of the lifetime update, gravity and a constant force, integration,
+	 * evaluating the normalized particle age (as used by the over-lifetime evolvers) and testing against collision
+	 * planes. Operates on particle buffers directly so no scene or physics is required.
+	 */
+	void benchmarkParticles()
+	{
+		static constexpr UINT32 NUM_FRAMES = 20;
+		static constexpr float TIME_STEP = 1.0f / 60.0f;
+		static constexpr float COLLISION_RADIUS = 0.1f;
+
+		const Vector3 gravity(0.0f, -9.81f, 0.0f);
+		const Vector3 force(1.5f, 0.0f, -0.5f);
+		const Plane planes[] =
+		{
+			Plane(Vector3::UNIT_Y, Vector3(0.0f, -39.0f, 0.0f)),
+			Plane(Vector3::UNIT_X, Vector3(-39.0f, 0.0f, 0.0f)),
+			Plane(-Vector3::UNIT_X, Vector3(39.0f, 0.0f, 0.0f)),
+			Plane(Vector3::UNIT_Z, Vector3(0.0f, 0.0f, -39.0f)),
+			Plane(-Vector3::UNIT_Z, Vector3(0.0f, 0.0f, 39.0f))
+		};
+		const UINT32 numPlanes = (UINT32)bs_size(planes);
+
+		std::cout << "Particle simulation (" << NUM_FRAMES << " frames, single core)" << std::endl;
+		for(UINT32 numParticles : { 10000, 100000, 1000000 })
+		{
+			struct Particles
+			{
+				Vector<Vector3> prevPosition;
+				Vector<Vector3> position;
+				Vector<Vector3> velocity;
+				Vector<float> initialLifetime;
+				Vector<float> lifetime;
+				Vector<float> age;
+				Vector<UINT32> collisions;
+			};
+
+			Random random(1234);
+			Particles scalar;
+			scalar.prevPosition.resize(numParticles);
+			scalar.age.resize(numParticles);
+			scalar.collisions.resize(numParticles);
+			for(UINT32 i = 0; i < numParticles; i++)
+			{
+				scalar.position.push_back(Vector3(random.getSNorm(), random.getSNorm(), random.getSNorm()) * 40.0f);
+				scalar.velocity.push_back(Vector3(random.getSNorm(), random.getSNorm(), random.getSNorm()) * 5.0f);
+				scalar.initialLifetime.push_back(100.0f + random.getUNorm() * 10.0f);
+				scalar.lifetime.push_back(scalar.initialLifetime.back());
+			}
+
+			Particles simd = scalar;
+
+			// Original per-particle loops
+			UINT32 numScalarCollisions = 0;
+			Timer timer;
+			for(UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+			{
+				for(UINT32 i = 0; i < numParticles; i++)
+					scalar.lifetime[i] -= TIME_STEP;
+
+				for(UINT32 i = 0; i < numParticles; i++)
+					scalar.prevPosition[i] = scalar.position[i];
+
+				for(UINT32 i = 0; i < numParticles; i++)
+					scalar.velocity[i] += gravity * TIME_STEP;
+
+				for(UINT32 i = 0; i < numParticles; i++)
+				{
+					const Vector3 frameForce = force * TIME_STEP;
+					scalar.velocity[i] += frameForce * TIME_STEP;
+				}
+
+				for(UINT32 i = 0; i < numParticles; i++)
+					scalar.position[i] += scalar.velocity[i] * TIME_STEP;
+
+				for(UINT32 i = 0; i < numParticles; i++)
+					scalar.age[i] = (scalar.initialLifetime[i] - scalar.lifetime[i]) / scalar.initialLifetime[i];
+
+				numScalarCollisions = 0;
+				for(UINT32 i = 0; i < numParticles; i++)
+				{
+					for(UINT32 j = 0; j < numPlanes; j++)
+					{
+						if(planes[j].getDistance(scalar.position[i]) > COLLISION_RADIUS)
+							continue;
+
+						scalar.collisions[numScalarCollisions++] = i;
+						break;
+					}
+				}
+			}
+			const UINT64 scalarTime = timer.getMicroseconds();
+
+			// SIMD kernels
+			UINT32 numSIMDCollisions = 0;
+			timer.reset();
+			for(UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+			{
+				ParticleKernels::subtract(simd.lifetime.data(), TIME_STEP, numParticles);
+				bs_copy(simd.prevPosition.data(), simd.position.data(), numParticles);
+				ParticleKernels::add(simd.velocity.data(), gravity * TIME_STEP, numParticles);
+				ParticleKernels::add(simd.velocity.data(), (force * TIME_STEP) * TIME_STEP, numParticles);
+				ParticleKernels::addScaled(simd.position.data(), simd.velocity.data(), TIME_STEP, numParticles);
+				ParticleKernels::normalizedAge(simd.initialLifetime.data(), simd.lifetime.data(), simd.age.data(),
+					numParticles);
+				numSIMDCollisions = ParticleKernels::findPlaneCollisions(simd.position.data(), numParticles, planes,
+					numPlanes, COLLISION_RADIUS, simd.collisions.data());
+			}
+			const UINT64 simdTime = timer.getMicroseconds();
+
+			UINT32 numMismatches = 0;
+			for(UINT32 i = 0; i < numParticles; i++)
+			{
+				if(scalar.position[i] != simd.position[i] || scalar.velocity[i] != simd.velocity[i] ||
+					scalar.age[i] != simd.age[i])
+					numMismatches++;
+			}
+
+			if(numScalarCollisions != numSIMDCollisions)
+				numMismatches++;
+
+			const auto toParticlesPerMs = [numParticles](UINT64 time)
+			{
+				return (double)numParticles * NUM_FRAMES * 1000.0 / std::max(time, (UINT64)1);
+			};
+
+			std::cout << "  " << numParticles << " particles (" << numSIMDCollisions << " colliding, " << numMismatches <<
+				" mismatches)" << std::endl;
+			std::cout << "    Scalar:  " << toParticlesPerMs(scalarTime) << " particles/ms" << std::endl;
+			std::cout << "    SIMD:    " << toParticlesPerMs(simdTime) << " particles/ms" << std::endl;
+		}
+	}
+
+	/**
+	 * Measures skeletal animation evaluation throughput for a crowd of characters with varying bone counts. Compares
+	 * scheduling one task per character (synchronized through a mutex and a condition variable) against evaluating
+	 * characters in batches of similar bone counts through a task group, the same way AnimationManager does. Poses are
+	 * evaluated directly through Skeleton::getPose(), so no scene, renderer or resources are required.
+	 */
+	void benchmarkAnimation()
+	{
+		static constexpr UINT32 NUM_FRAMES = 20;
+		static constexpr UINT32 MAX_BONES = 128;
+		static constexpr UINT32 MIN_BATCH_COST = 256;
+		static constexpr float FRAME_STEP = 1.0f / 60.0f;
+
+		// One position and rotation curve per bone, shared by all characters
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+		for(UINT32 i = 0; i < MAX_BONES; i++)
+		{
+			const float phase = i * 0.1f;
+			const String name = "Bone" + toString(i);
+
+			TAnimationCurve<Vector3> positionCurve({
+				TKeyframe<Vector3>{ Vector3(0.0f, 1.0f, 0.0f), Vector3::ZERO, Vector3::ZERO, 0.0f },
+				TKeyframe<Vector3>{ Vector3(phase, 1.0f, 0.5f), Vector3::ZERO, Vector3::ZERO, 0.5f },
+				TKeyframe<Vector3>{ Vector3(0.0f, 1.0f, 0.0f), Vector3::ZERO, Vector3::ZERO, 1.0f }
+			});
+
+			TAnimationCurve<Quaternion> rotationCurve({
+				TKeyframe<Quaternion>{ Quaternion::IDENTITY, Quaternion::ZERO, Quaternion::ZERO, 0.0f },
+				TKeyframe<Quaternion>{ Quaternion(Degree(0.0f), Degree(30.0f + phase), Degree(0.0f)), Quaternion::ZERO,
+					Quaternion::ZERO, 0.5f },
+				TKeyframe<Quaternion>{ Quaternion::IDENTITY, Quaternion::ZERO, Quaternion::ZERO, 1.0f }
+			});
+
+			curves->addPositionCurve(name, positionCurve);
+			curves->addRotationCurve(name, rotationCurve);
+		}
+
+		// A few different skeleton sizes, with each bone parented to the previous one
+		struct SkeletonInfo
+		{
+			SPtr<Skeleton> skeleton;
+			SkeletonMask mask;
+		};
+
+		Vector<SkeletonInfo> skeletons;
+		for(UINT32 numBones : { 16U, 64U, MAX_BONES })
+		{
+			Vector<BONE_DESC> bones(numBones);
+			for(UINT32 i = 0; i < numBones; i++)
+			{
+				bones[i].name = "Bone" + toString(i);
+				bones[i].parent = i > 0 ? i - 1 : (UINT32)-1;
+				bones[i].localTfrm = Transform(Vector3(0.0f, 1.0f, 0.0f), Quaternion::IDENTITY, Vector3::ONE);
+				bones[i].invBindPose = Matrix4::IDENTITY;
+			}
+
+			skeletons.push_back({ Skeleton::create(bones.data(), numBones), SkeletonMask(numBones) });
+		}
+
+		struct Character
+		{
+			const SkeletonInfo* skeleton = nullptr;
+			LocalSkeletonPose localPose;
+			Vector<AnimationCurveMapping> mapping;
+			Vector<TCurveCache<Vector3>> positionCaches;
+			Vector<TCurveCache<Quaternion>> rotationCaches;
+			AnimationState state;
+			AnimationStateLayer layer;
+			UINT32 boneStart = 0;
+		};
+
+		std::cout << "Animation evaluation (" << NUM_FRAMES << " frames, " << TaskScheduler::instance().getNumWorkers() <<
+			" workers)" << std::endl;
+		for(UINT32 numCharacters : { 200, 2000 })
+		{
+			Vector<Character> characters(numCharacters);
+
+			UINT32 totalNumBones = 0;
+			for(UINT32 i = 0; i < numCharacters; i++)
+			{
+				Character& character = characters[i];
+				character.skeleton = &skeletons[i % skeletons.size()];
+
+				const UINT32 numBones = character.skeleton->skeleton->getNumBones();
+				character.localPose = LocalSkeletonPose(numBones);
+				character.mapping.resize(numBones);
+				for(UINT32 j = 0; j < numBones; j++)
+					character.mapping[j] = { j, j, (UINT32)-1 };
+
+				character.positionCaches.resize(curves->position.size());
+				character.rotationCaches.resize(curves->rotation.size());
+
+				character.boneStart = totalNumBones;
+				totalNumBones += numBones;
+			}
+
+			// Set up pointers once the characters are in their final location
+			for(UINT32 i = 0; i < numCharacters; i++)
+			{
+				Character& character = characters[i];
+
+				AnimationState& state = character.state;
+				state.curves = curves;
+				state.boneToCurveMapping = character.mapping.data();
+				state.soToCurveMapping = nullptr;
+				state.positionCaches = character.positionCaches.data();
+				state.rotationCaches = character.rotationCaches.data();
+				state.scaleCaches = nullptr;
+				state.genericCaches = nullptr;
+				state.time = (i % 60) * FRAME_STEP;
+				state.weight = 1.0f;
+				state.loop = true;
+				state.disabled = false;
+
+				character.layer.states = &character.state;
+				character.layer.numStates = 1;
+				character.layer.index = 0;
+				character.layer.additive = false;
+			}
+
+			Vector<Matrix4> transforms(totalNumBones);
+			const auto evaluate = [&characters, &transforms](UINT32 idx)
+			{
+				Character& character = characters[idx];
+				character.skeleton->skeleton->getPose(transforms.data() + character.boneStart, character.localPose,
+					character.skeleton->mask, &character.layer, 1);
+
+				character.state.time += FRAME_STEP;
+			};
+
+			// Single threaded
+			Timer timer;
+			for(UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+			{
+				for(UINT32 i = 0; i < numCharacters; i++)
+					evaluate(i);
+			}
+			const UINT64 serialTime = timer.getMicroseconds();
+
+			// One task per character
+			timer.reset();
+			for(UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+			{
+				Mutex mutex;
+				Signal signal;
+				UINT32 numActive = numCharacters;
+
+				for(UINT32 i = 0; i < numCharacters; i++)
+				{
+					SPtr<Task> task = Task::create("AnimWorker", [&evaluate, &mutex, &signal, &numActive, i]()
+					{
+						evaluate(i);
+
+						Lock lock(mutex);
+						numActive--;
+						signal.notify_one();
+					});
+
+					TaskScheduler::instance().addTask(task);
+				}
+
+				Lock lock(mutex);
+				while(numActive > 0)
+					signal.wait(lock);
+			}
+			const UINT64 perCharacterTime = timer.getMicroseconds();
+
+			// Batches of similar cost, through a task group
+			const UINT32 numWorkers = std::max(1U, TaskScheduler::instance().getNumWorkers());
+			const UINT32 targetCost = std::max(MIN_BATCH_COST,
+				Math::divideAndRoundUp(totalNumBones + numCharacters, numWorkers * 4));
+
+			Vector<UINT32> batchStarts = { 0 };
+			UINT32 batchCost = 0;
+			for(UINT32 i = 0; i < numCharacters; i++)
+			{
+				batchCost += characters[i].skeleton->skeleton->getNumBones() + 1;
+				if(batchCost >= targetCost && (i + 1) < numCharacters)
+				{
+					batchStarts.push_back(i + 1);
+					batchCost = 0;
+				}
+			}
+			batchStarts.push_back(numCharacters);
+
+			const auto numBatches = (UINT32)batchStarts.size() - 1;
+
+			timer.reset();
+			for(UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+			{
+				std::atomic<UINT32> numRemaining{numBatches};
+				SPtr<TaskGroup> taskGroup = TaskGroup::create("AnimWorker",
+					[&evaluate, &batchStarts, &numRemaining](UINT32 idx)
+				{
+					for(UINT32 i = batchStarts[idx]; i < batchStarts[idx + 1]; i++)
+						evaluate(i);
+
+					numRemaining.fetch_sub(1, std::memory_order_acq_rel);
+				}, numBatches);
+
+				TaskScheduler::instance().addTaskGroup(taskGroup);
+				taskGroup->wait();
+
+				assert(numRemaining == 0);
+			}
+			const UINT64 batchedTime = timer.getMicroseconds();
+
+			const auto toBonesPerMs = [totalNumBones](UINT64 time)
+			{
+				return (double)totalNumBones * NUM_FRAMES * 1000.0 / std::max(time, (UINT64)1);
+			};
+
+			std::cout << "  " << numCharacters << " characters (" << totalNumBones << " bones, " << numBatches <<
+				" batches)" << std::endl;
+			std::cout << "    Single threaded:  " << toBonesPerMs(serialTime) << " bones/ms" << std::endl;
+			std::cout << "    Task per anim:    " << toBonesPerMs(perCharacterTime) << " bones/ms" << std::endl;
+			std::cout << "    Batched:          " << toBonesPerMs(batchedTime) << " bones/ms" << std::endl;
+		}
+	}
+	/**
+	 * Compares memory use and evaluation speed of densely sampled animation curves (similar to imported animation) and
+	 * their compressed version. Both are evaluated sequentially, the way a playing animation evaluates them.
+	 */
+	void benchmarkAnimationCompression()
+	{
+		static constexpr UINT32 NUM_BONES = 64;
+		static constexpr UINT32 NUM_KEYS = 121;
+		static constexpr float LENGTH = 4.0f;
+		static constexpr UINT32 NUM_FRAMES = 2400;
+		static constexpr float FRAME_STEP = 1.0f / 60.0f;
+
+		AnimationCurves curves;
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			const float phase = i * 0.1f;
+
+			Vector<TKeyframe<Vector3>> positionKeys(NUM_KEYS);
+			Vector<TKeyframe<Quaternion>> rotationKeys(NUM_KEYS);
+			Vector<TKeyframe<Vector3>> scaleKeys(NUM_KEYS);
+			for(UINT32 j = 0; j < NUM_KEYS; j++)
+			{
+				const float time = j * LENGTH / (NUM_KEYS - 1);
+				const float angle = time * Math::PI + phase;
+
+				positionKeys[j] = { Vector3(std::sin(angle), 1.0f, 0.0f), Vector3::ZERO, Vector3::ZERO, time };
+				rotationKeys[j] = { Quaternion(Radian(0.0f), Radian(std::sin(angle)), Radian(0.0f)), Quaternion::ZERO,
+					Quaternion::ZERO, time };
+				scaleKeys[j] = { Vector3::ONE, Vector3::ZERO, Vector3::ZERO, time };
+			}
+
+			AnimationUtility::calculateTangents(positionKeys);
+			AnimationUtility::calculateTangents(rotationKeys);
+
+			const String name = "Bone" + toString(i);
+			curves.addPositionCurve(name, TAnimationCurve<Vector3>(positionKeys));
+			curves.addRotationCurve(name, TAnimationCurve<Quaternion>(rotationKeys));
+			curves.addScaleCurve(name, TAnimationCurve<Vector3>(scaleKeys));
+		}
+
+		SPtr<CompressedAnimationCurves> compressed = CompressedAnimationCurves::create(curves);
+
+		const UINT32 numVectorKeys = NUM_BONES * NUM_KEYS * 2;
+		const UINT32 numRotationKeys = NUM_BONES * NUM_KEYS;
+		const UINT32 originalSize = numVectorKeys * sizeof(TKeyframe<Vector3>) +
+			numRotationKeys * sizeof(TKeyframe<Quaternion>);
+
+		// Keyframe curves
+		Vector<TCurveCache<Vector3>> positionCaches(NUM_BONES);
+		Vector<TCurveCache<Quaternion>> rotationCaches(NUM_BONES);
+		Vector<TCurveCache<Vector3>> scaleCaches(NUM_BONES);
+
+		float checksum = 0.0f;
+		Timer timer;
+		for(UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+		{
+			const float time = frame * FRAME_STEP;
+			for(UINT32 i = 0; i < NUM_BONES; i++)
+			{
+				checksum += curves.position[i].curve.evaluate(time, positionCaches[i], true).x;
+				checksum += curves.rotation[i].curve.evaluate(time, rotationCaches[i], true).y;
+				checksum += curves.scale[i].curve.evaluate(time, scaleCaches[i], true).z;
+			}
+		}
+		const UINT64 keyframeTime = timer.getMicroseconds();
+
+		// Compressed curves
+		CompressedCurveCache compressedCache;
+
+		timer.reset();
+		for(UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+		{
+			compressed->evaluate(frame * FRAME_STEP, true, compressedCache);
+			for(UINT32 i = 0; i < NUM_BONES; i++)
+			{
+				checksum += compressedCache.getPositions()[i].x;
+				checksum += compressedCache.getRotations()[i].y;
+				checksum += compressedCache.getScales()[i].z;
+			}
+		}
+		const UINT64 compressedTime = timer.getMicroseconds();
+
+		const auto toCurvesPerMs = [](UINT64 time)
+		{
+			return (double)NUM_BONES * 3 * NUM_FRAMES * 1000.0 / std::max(time, (UINT64)1);
+		};
+
+		std::cout << "Animation compression (" << NUM_BONES << " bones, " << NUM_KEYS << " keys per curve, checksum " <<
+			checksum << ")" << std::endl;
+		std::cout << "  Memory:" << std::endl;
+		std::cout << "    Keyframes:   " << originalSize << " bytes (" << numVectorKeys + numRotationKeys << " keys)" <<
+			std::endl;
+		std::cout << "    Compressed:  " << compressed->getMemorySize() << " bytes (" << compressed->getNumKeys() <<
+			" keys)" << std::endl;
+		std::cout << "  Evaluation:" << std::endl;
+		std::cout << "    Keyframes:   " << toCurvesPerMs(keyframeTime) << " curves/ms" << std::endl;
+		std::cout << "    Compressed:  " << toCurvesPerMs(compressedTime) << " curves/ms" << std::endl;
+	}
+
+	/**
+	 * Compares per-bone scalar code with the SIMD kernels used by Skeleton::getPose(), for the work done after the
+	 * animation curves are evaluated: blending values of multiple animation states, building local bone matrices,
+	 * transforming them to model space and applying the inverse bind pose.
+	 */
+	void benchmarkSkeletonKernels()
+	{
+		static constexpr UINT32 NUM_BONES = 128;
+		static constexpr UINT32 NUM_STATES = 3;
+		static constexpr UINT32 NUM_ITERATIONS = 5000;
+
+		Random random(1234);
+		const auto randomRotation = [&random]()
+		{
+			return Quaternion(Degree(random.getSNorm() * 90.0f), Degree(random.getSNorm() * 90.0f),
+				Degree(random.getSNorm() * 90.0f));
+		};
+
+		// Evaluated curve values of each state, and a skeleton where each bone is parented to the previous one
+		Vector<Vector3> statePositions(NUM_BONES * NUM_STATES);
+		Vector<Quaternion> stateRotations(NUM_BONES * NUM_STATES);
+		Vector<Vector3> stateScales(NUM_BONES * NUM_STATES);
+		for(UINT32 i = 0; i < NUM_BONES * NUM_STATES; i++)
+		{
+			statePositions[i] = Vector3(random.getSNorm(), 1.0f, random.getSNorm());
+			stateRotations[i] = randomRotation();
+			stateScales[i] = Vector3::ONE;
+		}
+
+		Vector<UINT32> parents(NUM_BONES);
+		Vector<Matrix4> invBindPoses(NUM_BONES);
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			parents[i] = i > 0 ? i - 1 : (UINT32)-1;
+			invBindPoses[i] = Matrix4::TRS(Vector3(0.0f, -(float)i, 0.0f), Quaternion::IDENTITY, Vector3::ONE);
+		}
+
+		const float weights[NUM_STATES] = { 0.5f, 0.3f, 0.2f };
+		Vector<Matrix4> pose(NUM_BONES);
+
+		// Scalar
+		Vector<Vector3> positions(NUM_BONES);
+		Vector<Quaternion> rotations(NUM_BONES);
+		Vector<Vector3> scales(NUM_BONES);
+
+		Timer timer;
+		for(UINT32 iteration = 0; iteration < NUM_ITERATIONS; iteration++)
+		{
+			for(UINT32 i = 0; i < NUM_BONES; i++)
+			{
+				positions[i] = Vector3::ZERO;
+				rotations[i] = Quaternion::ZERO;
+				scales[i] = Vector3::ONE;
+			}
+
+			for(UINT32 j = 0; j < NUM_STATES; j++)
+			{
+				for(UINT32 i = 0; i < NUM_BONES; i++)
+				{
+					const UINT32 valueIdx = j * NUM_BONES + i;
+					positions[i] += statePositions[valueIdx] * weights[j];
+					scales[i] *= stateScales[valueIdx] * weights[j];
+
+					Quaternion value = stateRotations[valueIdx] * weights[j];
+					if(value.dot(rotations[i]) < 0.0f)
+						value = -value;
+
+					rotations[i] += value;
+				}
+			}
+
+			for(UINT32 i = 0; i < NUM_BONES; i++)
+			{
+				rotations[i].normalize();
+				pose[i] = Matrix4::TRS(positions[i], rotations[i], scales[i]);
+			}
+
+			for(UINT32 i = 1; i < NUM_BONES; i++)
+				pose[i] = pose[parents[i]] * pose[i];
+
+			for(UINT32 i = 0; i < NUM_BONES; i++)
+				pose[i] = pose[i] * invBindPoses[i];
+		}
+		const UINT64 scalarTime = timer.getMicroseconds();
+
+		// SIMD
+		const UINT32 poseSize = SkeletonKernels::getPoseSize(NUM_BONES);
+		Vector<float> poseBuffer(poseSize * (NUM_STATES + 1));
+
+		SoABonePose statePoses[NUM_STATES];
+		for(UINT32 j = 0; j < NUM_STATES; j++)
+		{
+			SkeletonKernels::initPose(statePoses[j], poseBuffer.data() + poseSize * (j + 1), NUM_BONES);
+
+			for(UINT32 i = 0; i < NUM_BONES; i++)
+			{
+				const UINT32 valueIdx = j * NUM_BONES + i;
+				for(UINT32 k = 0; k < 3; k++)
+				{
+					statePoses[j].positions[k][i] = statePositions[valueIdx][k];
+					statePoses[j].scales[k][i] = stateScales[valueIdx][k];
+				}
+
+				for(UINT32 k = 0; k < 4; k++)
+					statePoses[j].rotations[k][i] = stateRotations[valueIdx][k];
+			}
+		}
+
+		Vector<float> stateWeights[NUM_STATES];
+		for(UINT32 j = 0; j < NUM_STATES; j++)
+			stateWeights[j].assign(poseSize / 10, weights[j]);
+
+		bool overrides[NUM_BONES] = { };
+
+		timer.reset();
+		for(UINT32 iteration = 0; iteration < NUM_ITERATIONS; iteration++)
+		{
+			SoABonePose blended;
+			SkeletonKernels::initPose(blended, poseBuffer.data(), NUM_BONES);
+
+			for(UINT32 j = 0; j < NUM_STATES; j++)
+			{
+				SkeletonKernels::blendPositions(blended, statePoses[j], stateWeights[j].data(), NUM_BONES);
+				SkeletonKernels::blendScales(blended, statePoses[j], stateWeights[j].data(), NUM_BONES);
+				SkeletonKernels::blendRotations(blended, statePoses[j], stateWeights[j].data(), NUM_BONES);
+			}
+
+			SkeletonKernels::normalizeRotations(blended, NUM_BONES);
+			SkeletonKernels::calculateLocalTransforms(blended, overrides, pose.data(), NUM_BONES);
+
+			for(UINT32 i = 1; i < NUM_BONES; i++)
+				SkeletonKernels::multiplyAffine(pose[parents[i]], pose[i], pose[i]);
+
+			SkeletonKernels::multiplyAffine(pose.data(), invBindPoses.data(), pose.data(), NUM_BONES);
+		}
+		const UINT64 simdTime = timer.getMicroseconds();
+
+		const auto toBonesPerMs = [](UINT64 time)
+		{
+			return (double)NUM_BONES * NUM_ITERATIONS * 1000.0 / std::max(time, (UINT64)1);
+		};
+
+		std::cout << "Skeleton pose kernels (" << NUM_BONES << " bones, " << NUM_STATES << " blended states)" <<
+			std::endl;
+		std::cout << "  Scalar:  " << toBonesPerMs(scalarTime) << " bones/ms" << std::endl;
+		std::cout << "  SIMD:    " << toBonesPerMs(simdTime) << " bones/ms" << std::endl;
+	}
+
+	/** Game object without any components or hierarchy, used for measuring the GameObjectManager overhead. */
+	class BenchmarkGameObject : public GameObject
+	{
+	protected:
+		void destroyInternal(GameObjectHandleBase& handle, bool immediate) override
+		{
+			if(immediate)
+				GameObjectManager::instance().unregisterObject(handle);
+			else
+				GameObjectManager::instance().queueForDestroy(handle);
+		}
+	};
+
+	/**
+	 * Measures registering, looking up and destroying a large number of game objects through the GameObjectManager.
+	 * Lookups and removals are also performed on an ordered map guarded by a mutex, the way the manager used to store
+	 * its objects, for comparison.
+	 */
+	void benchmarkGameObjectManager()
+	{
+		static constexpr UINT32 NUM_OBJECTS = 1000000;
+
+		GameObjectManager::startUp();
+		GameObjectManager& manager = GameObjectManager::instance();
+
+		// Objects are allocated up front, so only registration is measured
+		Vector<SPtr<GameObject>> objects(NUM_OBJECTS);
+		for(auto& entry : objects)
+			entry = bs_shared_ptr_new<BenchmarkGameObject>();
+
+		Vector<GameObjectHandleBase> handles(NUM_OBJECTS);
+		Vector<UINT64> ids(NUM_OBJECTS);
+
+		Timer timer;
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+			handles[i] = manager.registerObject(objects[i]);
+		const UINT64 registerTime = timer.getMicroseconds();
+
+		objects.clear();
+
+		// Look objects up in random order, as references between objects rarely follow creation order
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+			ids[i] = handles[i].getInstanceId();
+
+		std::shuffle(ids.begin(), ids.end(), std::mt19937(1234));
+
+		UINT32 numFound = 0;
+		timer.reset();
+		for(auto& id : ids)
+			numFound += manager.objectExists(id) ? 1 : 0;
+		const UINT64 lookupTime = timer.getMicroseconds();
+
+		timer.reset();
+		for(auto& entry : handles)
+			manager.queueForDestroy(entry);
+
+		manager.destroyQueuedObjects();
+		const UINT64 destroyTime = timer.getMicroseconds();
+
+		GameObjectManager::shutDown();
+
+		// Ordered map under a mutex, with the same IDs
+		Map<UINT64, GameObjectHandleBase> mapObjects;
+		Mutex mapMutex;
+
+		timer.reset();
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			Lock lock(mapMutex);
+			mapObjects[ids[i]] = handles[i];
+		}
+		const UINT64 mapRegisterTime = timer.getMicroseconds();
+
+		UINT32 mapNumFound = 0;
+		timer.reset();
+		for(auto& id : ids)
+		{
+			Lock lock(mapMutex);
+			mapNumFound += mapObjects.find(id) != mapObjects.end() ? 1 : 0;
+		}
+		const UINT64 mapLookupTime = timer.getMicroseconds();
+
+		timer.reset();
+		for(auto& id : ids)
+		{
+			Lock lock(mapMutex);
+			mapObjects.erase(id);
+		}
+		const UINT64 mapDestroyTime = timer.getMicroseconds();
+
+		const auto toNsPerObject = [](UINT64 time)
+		{
+			return (double)time * 1000.0 / NUM_OBJECTS;
+		};
+
+		std::cout << "Game object manager (" << NUM_OBJECTS << " objects, found " << numFound << "/" << mapNumFound <<
+			")" << std::endl;
+		std::cout << "  Slot map:" << std::endl;
+		std::cout << "    Register:  " << toNsPerObject(registerTime) << " ns/object" << std::endl;
+		std::cout << "    Lookup:    " << toNsPerObject(lookupTime) << " ns/object" << std::endl;
+		std::cout << "    Destroy:   " << toNsPerObject(destroyTime) << " ns/object" << std::endl;
+		std::cout << "  Map with mutex:" << std::endl;
+		std::cout << "    Insert:    " << toNsPerObject(mapRegisterTime) << " ns/object" << std::endl;
+		std::cout << "    Lookup:    " << toNsPerObject(mapLookupTime) << " ns/object" << std::endl;
+		std::cout << "    Erase:     " << toNsPerObject(mapDestroyTime) << " ns/object" << std::endl;
+	}
+
+	/**
+	 * Compares calculating world transforms of moved scene objects lazily on first access, with updating them up front
+	 * using SceneTransformPass. Runs on a deep hierarchy made out of long chains, and a wide hierarchy with many
+	 * siblings per level. Every world matrix is read once per frame, in random order, as other systems would.
+	 */
+	void benchmarkSceneTransforms()
+	{
+		static constexpr UINT32 NUM_FRAMES = 100;
+		static constexpr UINT32 NUM_ROOTS = 16;
+
+		struct HierarchyDesc
+		{
+			const char* name;
+			UINT32 numLevels;
+			UINT32 numChildren;
+		};
+
+		GameObjectManager::startUp();
+
+		for(auto& desc : { HierarchyDesc{ "Deep", 1024, 1 }, HierarchyDesc{ "Wide", 3, 32 } })
+		{
+			// Objects aren't instantiated, so only the pass below updates them
+			Vector<HSceneObject> roots;
+			Vector<HSceneObject> objects;
+			for(UINT32 i = 0; i < NUM_ROOTS; i++)
+			{
+				HSceneObject root = SceneObject::create("Root", SOF_DontInstantiate);
+				roots.push_back(root);
+				objects.push_back(root);
+
+				Vector<HSceneObject> level = { root };
+				for(UINT32 j = 1; j < desc.numLevels; j++)
+				{
+					Vector<HSceneObject> nextLevel;
+					for(auto& parent : level)
+					{
+						for(UINT32 k = 0; k < desc.numChildren; k++)
+						{
+							HSceneObject child = SceneObject::create("Child", SOF_DontInstantiate);
+							child->setParent(parent, false);
+							child->setPosition(Vector3(1.0f, (float)k, 0.0f));
+							child->setRotation(Quaternion(Degree(0.0f), Degree(5.0f), Degree(0.0f)));
+
+							nextLevel.push_back(child);
+							objects.push_back(child);
+						}
+					}
+
+					level = std::move(nextLevel);
+				}
+			}
+
+			Vector<SceneObject*> accessOrder(objects.size());
+			for(UINT32 i = 0; i < (UINT32)objects.size(); i++)
+				accessOrder[i] = objects[i].get();
+
+			std::shuffle(accessOrder.begin(), accessOrder.end(), std::mt19937(1234));
+
+			float checksum = 0.0f;
+			const auto moveRoots = [&roots](UINT32 frame)
+			{
+				for(auto& root : roots)
+					root->setPosition(Vector3((float)frame, 0.0f, 0.0f));
+			};
+
+			Timer timer;
+			for(UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+			{
+				moveRoots(frame);
+
+				for(auto& entry : accessOrder)
+					checksum += entry->getWorldMatrix()[0][3];
+			}
+			const UINT64 lazyTime = timer.getMicroseconds();
+
+			SceneTransformPass pass;
+
+			timer.reset();
+			for(UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+			{
+				moveRoots(frame);
+				pass.update(roots);
+
+				for(auto& entry : accessOrder)
+					checksum += entry->getWorldMatrix()[0][3];
+			}
+			const UINT64 passTime = timer.getMicroseconds();
+
+			for(auto& root : roots)
+				root->destroy(true);
+
+			std::cout << "Scene transforms (" << desc.name << ", " << objects.size() << " objects, checksum " <<
+				checksum << ")" << std::endl;
+			std::cout << "  Lazy:  " << lazyTime / NUM_FRAMES << " us/frame" << std::endl;
+			std::cout << "  Pass:  " << passTime / NUM_FRAMES << " us/frame" << std::endl;
+		}
+
+		GameObjectManager::shutDown();
+	}
+
+	/**
+	 * Compares converting pixels one by one through floating point, as PixelUtil did for all formats, with the
+	 * specialized conversion kernels on a single thread, and with PixelUtil::bulkPixelConversion() which splits large
+	 * images over the task scheduler.
+	 */
+	void benchmarkPixelConversion()
+	{
+		static constexpr UINT32 SIZE = 1024;
+		static constexpr UINT32 NUM_PIXELS = SIZE * SIZE;
+		static constexpr UINT32 NUM_ITERATIONS = 10;
+
+		struct ConversionDesc
+		{
+			const char* name;
+			PixelFormat src;
+			PixelFormat dst;
+		};
+
+		const ConversionDesc conversions[] =
+		{
+			{ "RGBA8 -> BGRA8", PF_RGBA8, PF_BGRA8 },
+			{ "RGB8 -> RGBA8", PF_RGB8, PF_RGBA8 },
+			{ "RGBA8 -> RGB8", PF_RGBA8, PF_RGB8 },
+			{ "R8 -> RGBA8", PF_R8, PF_RGBA8 },
+			{ "RGBA8 -> R8", PF_RGBA8, PF_R8 },
+			{ "RGBA8 -> RGBA16F", PF_RGBA8, PF_RGBA16F },
+			{ "RGBA16F -> RGBA8", PF_RGBA16F, PF_RGBA8 },
+			{ "RGBA8 -> RGBA32F", PF_RGBA8, PF_RGBA32F },
+			{ "RGBA32F -> RGBA8", PF_RGBA32F, PF_RGBA8 }
+		};
+
+		const auto toMPixelsPerSecond = [](UINT64 time)
+		{
+			return (double)NUM_PIXELS * NUM_ITERATIONS / (double)std::max(time, (UINT64)1);
+		};
+
+		std::cout << "Pixel conversion (" << SIZE << "x" << SIZE << ", MPixels/s)" << std::endl;
+		for(auto& desc : conversions)
+		{
+			const SPtr<PixelData> src = PixelData::create(SIZE, SIZE, 1, desc.src);
+			const SPtr<PixelData> dst = PixelData::create(SIZE, SIZE, 1, desc.dst);
+
+			std::mt19937 random(1234);
+			std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+			for(UINT32 y = 0; y < SIZE; y++)
+			{
+				for(UINT32 x = 0; x < SIZE; x++)
+				{
+					src->setColorAt(Color(distribution(random), distribution(random), distribution(random),
+						distribution(random)), x, y);
+				}
+			}
+
+			const UINT32 srcPixelSize = PixelUtil::getNumElemBytes(desc.src);
+			const UINT32 dstPixelSize = PixelUtil::getNumElemBytes(desc.dst);
+
+			Timer timer;
+			for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			{
+				const UINT8* srcData = src->getData();
+				UINT8* dstData = dst->getData();
+
+				float r, g, b, a;
+				for(UINT32 j = 0; j < NUM_PIXELS; j++)
+				{
+					PixelUtil::unpackColor(&r, &g, &b, &a, desc.src, srcData + j * srcPixelSize);
+					PixelUtil::packColor(r, g, b, a, desc.dst, dstData + j * dstPixelSize);
+				}
+			}
+			const UINT64 genericTime = timer.getMicroseconds();
+
+			PixelConversionKernels::ConvertRowFn kernel = PixelConversionKernels::find(desc.src, desc.dst);
+
+			timer.reset();
+			for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+				kernel(src->getData(), dst->getData(), NUM_PIXELS);
+			const UINT64 kernelTime = timer.getMicroseconds();
+
+			timer.reset();
+			for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+				PixelUtil::bulkPixelConversion(*src, *dst);
+			const UINT64 parallelTime = timer.getMicroseconds();
+
+			std::cout << "  " << desc.name << ":" << std::endl;
+			std::cout << "    Per pixel:  " << toMPixelsPerSecond(genericTime) << std::endl;
+			std::cout << "    Kernel:     " << toMPixelsPerSecond(kernelTime) << std::endl;
+			std::cout << "    Parallel:   " << toMPixelsPerSecond(parallelTime) << std::endl;
+		}
+
+		const SPtr<PixelData> pixels = PixelData::create(SIZE, SIZE, 1, PF_RGBA8);
+		pixels->setColors(Color(0.25f, 0.5f, 0.75f, 1.0f));
+
+		Timer timer;
+		for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			UINT8* data = pixels->getData();
+			for(UINT32 j = 0; j < NUM_PIXELS; j++)
+			{
+				Color color;
+				PixelUtil::unpackColor(&color, PF_RGBA8, data + j * 4);
+				PixelUtil::packColor(color.getGamma(), PF_RGBA8, data + j * 4);
+			}
+		}
+		const UINT64 genericTime = timer.getMicroseconds();
+
+		timer.reset();
+		for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			PixelUtil::linearToSRGB(*pixels);
+		const UINT64 tableTime = timer.getMicroseconds();
+
+		std::cout << "  RGBA8 linear -> sRGB:" << std::endl;
+		std::cout << "    Per pixel:  " << toMPixelsPerSecond(genericTime) << std::endl;
+		std::cout << "    Table:      " << toMPixelsPerSecond(tableTime) << std::endl;
+	}
+
+	/**
+	 * Measures generation of mip-maps and compression of the data of imported textures, as done by texture importers,
+	 * for a set of 4K PBR textures and an HDR cubemap. Processing is split over the task scheduler if it is running,
+	 * so running this before the scheduler is started provides the single threaded baseline.
+	 */
+	void benchmarkTextureImport()
+	{
+		struct TextureDesc
+		{
+			const char* name;
+			UINT32 size;
+			UINT32 numFaces;
+			PixelFormat sourceFormat;
+			PixelFormat format;
+			bool sRGB;
+		};
+
+		const TextureDesc textures[] =
+		{
+			{ "Albedo", 4096, 1, PF_RGBA8, PF_BC1, true },
+			{ "Normal", 4096, 1, PF_RGBA8, PF_BC5, false },
+			{ "Roughness", 4096, 1, PF_R8, PF_BC4, false },
+			{ "Metalness", 4096, 1, PF_R8, PF_BC4, false },
+			{ "Sky", 1024, 6, PF_RGBA16F, PF_RGBA16F, false }
+		};
+
+		std::mt19937 random(1234);
+		std::uniform_int_distribution<UINT32> distribution(0, 255);
+
+		UINT64 totalTime = 0;
+		std::cout << "Texture import (mip-map generation and compression, " <<
+			(TaskScheduler::isStarted() ? "task scheduler" : "single thread") << ")" << std::endl;
+		for(auto& desc : textures)
+		{
+			TextureImportOptions importOptions;
+			importOptions.format = desc.format;
+			importOptions.generateMips = true;
+			importOptions.sRGB = desc.sRGB;
+			importOptions.cubemap = desc.numFaces == 6;
+
+			// Smooth gradients with some noise, so the compressor doesn't get an unrealistically easy input
+			Vector<SPtr<PixelData>> faces;
+			for(UINT32 i = 0; i < desc.numFaces; i++)
+			{
+				SPtr<PixelData> face = PixelData::create(desc.size, desc.size, 1, PF_RGBA8);
+
+				UINT8* data = face->getData();
+				for(UINT32 y = 0; y < desc.size; y++)
+				{
+					for(UINT32 x = 0; x < desc.size; x++)
+					{
+						UINT8* pixel = data + (y * desc.size + x) * 4;
+						pixel[0] = (UINT8)((x * 255 / desc.size + distribution(random) / 8) & 0xFF);
+						pixel[1] = (UINT8)((y * 255 / desc.size + distribution(random) / 8) & 0xFF);
+						pixel[2] = (UINT8)((i * 40 + distribution(random) / 8) & 0xFF);
+						pixel[3] = 255;
+					}
+				}
+
+				SPtr<PixelData> sourceFace = PixelData::create(desc.size, desc.size, 1, desc.sourceFormat);
+				PixelUtil::bulkPixelConversion(*face, *sourceFace);
+
+				faces.push_back(sourceFace);
+			}
+
+			const UINT32 numMips = TextureImportUtility::getNumMips(*faces[0], importOptions);
+
+			Timer timer;
+			TextureImportUtility::generateSurfaces(faces, importOptions.format, numMips, importOptions);
+			const UINT64 time = timer.getMilliseconds();
+
+			totalTime += time;
+
+			std::cout << "  " << desc.name << " (" << desc.size << "x" << desc.size << "x" << desc.numFaces << ", " <<
+				PixelUtil::getFormatName(desc.format) << ", " << numMips + 1 << " mips): " << time << " ms" << std::endl;
+		}
+
+		std::cout << "  Total: " << totalTime << " ms" << std::endl;
+	}
+
+	/**
+	 * Measures decompression of block compressed data, decoding rows of blocks with the kernels on a single thread, and
+	 * decompressing through PixelUtil which splits large images over the task scheduler.
+	 */
+	void benchmarkBCDecompression()
+	{
+		static constexpr UINT32 SIZE = 2048;
+		static constexpr UINT32 NUM_PIXELS = SIZE * SIZE;
+		static constexpr UINT32 NUM_ITERATIONS = 10;
+
+		const PixelFormat formats[] = { PF_BC1, PF_BC1a, PF_BC2, PF_BC3, PF_BC4, PF_BC5 };
+
+		const auto toMPixelsPerSecond = [](UINT64 time)
+		{
+			return (double)NUM_PIXELS * NUM_ITERATIONS / (double)std::max(time, (UINT64)1);
+		};
+
+		const SPtr<PixelData> decoded = PixelData::create(SIZE, SIZE, 1, PF_RGBA8);
+		const SPtr<PixelData> decodedHalf = PixelData::create(SIZE, SIZE, 1, PF_RGBA16F);
+
+		std::cout << "BC decompression (" << SIZE << "x" << SIZE << ", MPixels/s)" << std::endl;
+		for(auto& format : formats)
+		{
+			// Any bit pattern is a valid block
+			const SPtr<PixelData> compressed = PixelData::create(SIZE, SIZE, 1, format);
+
+			std::mt19937 random(1234);
+			for(UINT32 i = 0; i < compressed->getConsecutiveSize(); i++)
+				compressed->getData()[i] = (UINT8)(random() & 0xFF);
+
+			BCDecompressionKernels::DecodeRowFn decoder = BCDecompressionKernels::find(format);
+
+			const UINT32 numBlocks = SIZE / 4;
+			const UINT32 blockRowSize = compressed->getRowPitch();
+			const UINT32 decodedRowPitch = decoded->getRowPitch();
+
+			Timer timer;
+			for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			{
+				for(UINT32 j = 0; j < numBlocks; j++)
+				{
+					decoder(compressed->getData() + j * blockRowSize, decoded->getData() + j * 4 * decodedRowPitch,
+						decodedRowPitch, numBlocks);
+				}
+			}
+			const UINT64 kernelTime = timer.getMicroseconds();
+
+			timer.reset();
+			for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+				PixelUtil::bulkPixelConversion(*compressed, *decoded);
+			const UINT64 parallelTime = timer.getMicroseconds();
+
+			timer.reset();
+			for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+				PixelUtil::bulkPixelConversion(*compressed, *decodedHalf);
+			const UINT64 halfTime = timer.getMicroseconds();
+
+			std::cout << "  " << PixelUtil::getFormatName(format) << ":" << std::endl;
+			std::cout << "    Kernel:             " << toMPixelsPerSecond(kernelTime) << std::endl;
+			std::cout << "    Parallel:           " << toMPixelsPerSecond(parallelTime) << std::endl;
+			std::cout << "    Parallel, RGBA16F:  " << toMPixelsPerSecond(halfTime) << std::endl;
+		}
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	MemStack::beginThread();
+	ThreadPool::startUp<TThreadPool<ThreadDefaultPolicy>>(BS_THREAD_HARDWARE_CONCURRENCY + 2);
+
+	// Single threaded baseline for the run with the task scheduler below
+	benchmarkTextureImport();
+
+	TaskScheduler::startUp();
+
+	benchmarkCoreThreadQueue();
+	benchmarkProfilerCPU();
+	benchmarkParticles();
+	benchmarkAnimation();
+	benchmarkAnimationCompression();
+	benchmarkSkeletonKernels();
+	benchmarkGameObjectManager();
+	benchmarkSceneTransforms();
+	benchmarkPixelConversion();
+	benchmarkTextureImport();
+	benchmarkBCDecompression();
+
+	TaskScheduler::shutDown();
+	ThreadPool::shutDown();
+	MemStack::endThread();
+
+	return 0;
+}
@@ -0,0 +1,316 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Image/BsBCDecompressionKernels.h"
+#include "Math/BsSIMD.h"
+
+namespace bs
+{
+	/** Marks a byte in a shuffle mask that should be set to zero. */
+	static constexpr UINT8 ZERO = 0x80;
+
+	/** Number of pixels in a row or a column of a block. */
+	static constexpr UINT32 BLOCK_DIM = 4;
+
+	/** Decoded rows of a single block, each containing four RGBA8 pixels. */
+	typedef simd::uint8x16 BlockRows[BLOCK_DIM];
+
+	/** Tables used for expanding indices into pixels, mostly masks for simd::permute_zbytes16(). */
+	struct ShuffleTables
+	{
+		ShuffleTables()
+		{
+			// A byte of 2-bit indices into a palette of four RGBA8 colors picks four whole pixels
+			for(UINT32 i = 0; i < 256; i++)
+			{
+				for(UINT32 x = 0; x < BLOCK_DIM; x++)
+				{
+					const UINT32 index = (i >> (x * 2)) & 0x3;
+					for(UINT32 channel = 0; channel < 4; channel++)
+						colorRows[i][x * 4 + channel] = (UINT8)(index * 4 + channel);
+				}
+			}
+
+			// Moves the single channel values of a row of pixels, from 16 values in row major order, into one channel
+			for(UINT32 channel = 0; channel < 4; channel++)
+			{
+				for(UINT32 y = 0; y < BLOCK_DIM; y++)
+				{
+					for(UINT32 i = 0; i < 16; i++)
+						channelRows[channel][y][i] = ZERO;
+
+					for(UINT32 x = 0; x < BLOCK_DIM; x++)
+						channelRows[channel][y][x * 4 + channel] = (UINT8)(y * BLOCK_DIM + x);
+				}
+			}
+
+			// Twelve bits of 3-bit indices of single channel blocks, unpacked to a byte per index
+			for(UINT32 i = 0; i < 4096; i++)
+			{
+				channelIndices[i] = 0;
+				for(UINT32 x = 0; x < BLOCK_DIM; x++)
+					channelIndices[i] |= ((i >> (x * 3)) & 0x7) << (x * 8);
+			}
+		}
+
+		UINT8 colorRows[256][16];
+		UINT8 channelRows[4][BLOCK_DIM][16];
+		UINT32 channelIndices[4096];
+	};
+
+	static const ShuffleTables& getShuffleTables()
+	{
+		static const ShuffleTables tables;
+		return tables;
+	}
+
+	/** Expands a 5:6:5 color to 8 bits per channel, with zero alpha. */
+	static UINT32 expand565(UINT16 color)
+	{
+		const UINT32 r = (color >> 11) & 0x1F;
+		const UINT32 g = (color >> 5) & 0x3F;
+		const UINT32 b = color & 0x1F;
+
+		return ((r << 3) | (r >> 2)) | (((g << 2) | (g >> 4)) << 8) | (((b << 3) | (b >> 2)) << 16);
+	}
+
+	/** Returns a weighted average of the RGB channels of two colors, with zero alpha. */
+	static UINT32 blendColors(UINT32 a, UINT32 b, UINT32 weightA, UINT32 weightB)
+	{
+		const UINT32 divisor = weightA + weightB;
+
+		UINT32 output = 0;
+		for(UINT32 shift = 0; shift < 24; shift += 8)
+		{
+			const UINT32 value = (((a >> shift) & 0xFF) * weightA + ((b >> shift) & 0xFF) * weightB) / divisor;
+			output |= value << shift;
+		}
+
+		return output;
+	}
+
+	/**
+	 * Decodes the color part of a block, as used by BC1, BC2 and BC3.
+	 *
+	 * @param[in]	block				Eight bytes of color block data.
+	 * @param[out]	rows				Decoded pixels.
+	 * @param[in]	alpha				Alpha assigned to the pixels, in the highest byte.
+	 * @param[in]	allowThreeColors	If true, blocks with the first endpoint not larger than the second one have
+	 *									three colors, and the fourth index is black with @p transparentAlpha. If false,
+	 *									four colors are always used.
+	 * @param[in]	transparentAlpha	Alpha of the fourth index in three color blocks, in the highest byte.
+	 */
+	static void decodeColorBlock(const UINT8* block, BlockRows& rows, UINT32 alpha, bool allowThreeColors,
+		UINT32 transparentAlpha)
+	{
+		UINT16 endpoints[2];
+		UINT32 indices;
+		memcpy(endpoints, block, sizeof(endpoints));
+		memcpy(&indices, block + 4, sizeof(indices));
+
+		UINT32 palette[4];
+		palette[0] = expand565(endpoints[0]) | alpha;
+		palette[1] = expand565(endpoints[1]) | alpha;
+
+		if(!allowThreeColors || endpoints[0] > endpoints[1])
+		{
+			palette[2] = blendColors(palette[0], palette[1], 2, 1) | alpha;
+			palette[3] = blendColors(palette[0], palette[1], 1, 2) | alpha;
+		}
+		else
+		{
+			palette[2] = blendColors(palette[0], palette[1], 1, 1) | alpha;
+			palette[3] = transparentAlpha;
+		}
+
+		const ShuffleTables& tables = getShuffleTables();
+		const simd::uint8x16 colors = simd::load_u<simd::uint8x16>(palette);
+		for(UINT32 y = 0; y < BLOCK_DIM; y++)
+		{
+			const UINT32 rowIndices = (indices >> (y * 8)) & 0xFF;
+			rows[y] = simd::permute_zbytes16(colors, simd::load_u<simd::uint8x16>(tables.colorRows[rowIndices]));
+		}
+	}
+
+	/**
+	 * Decodes a block of interpolated single channel values, as used by BC3 alpha, BC4 and BC5. Returns the values of
+	 * the 16 pixels in row major order.
+	 */
+	static simd::uint8x16 decodeChannelBlock(const UINT8* block)
+	{
+		const UINT32 endpoint0 = block[0];
+		const UINT32 endpoint1 = block[1];
+
+		UINT8 palette[16] = { (UINT8)endpoint0, (UINT8)endpoint1 };
+		if(endpoint0 > endpoint1)
+		{
+			for(UINT32 i = 1; i < 7; i++)
+				palette[i + 1] = (UINT8)(((7 - i) * endpoint0 + i * endpoint1) / 7);
+		}
+		else
+		{
+			for(UINT32 i = 1; i < 5; i++)
+				palette[i + 1] = (UINT8)(((5 - i) * endpoint0 + i * endpoint1) / 5);
+
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		UINT64 bits = 0;
+		memcpy(&bits, block + 2, 6);
+
+		const ShuffleTables& tables = getShuffleTables();
+
+		UINT32 indices[4];
+		for(UINT32 y = 0; y < BLOCK_DIM; y++)
+			indices[y] = tables.channelIndices[(bits >> (y * 12)) & 0xFFF];
+
+		return simd::permute_zbytes16(simd::load_u<simd::uint8x16>(palette), simd::load_u<simd::uint8x16>(indices));
+	}
+
+	/**
+	 * Decodes a block of explicit 4-bit alpha values, as used by BC2. Returns the values of the 16 pixels in row major
+	 * order, expanded to 8 bits.
+	 */
+	static simd::uint8x16 decodeExplicitAlphaBlock(const UINT8* block)
+	{
+		// Only the low half is used, the block is 16 bytes long so the load is safe
+		const simd::uint8x16 packed = simd::load_u<simd::uint8x16>(block);
+		const simd::uint8x16 nibbleMask = simd::splat(0x0F);
+
+		// Pixels with even indices are stored in the low nibbles
+		const simd::uint8x16 low = simd::bit_and(packed, nibbleMask);
+		const simd::uint8x16 high = simd::bit_and(simd::shift_r<4>(packed), nibbleMask);
+		const simd::uint8x16 values = simd::zip16_lo(low, high);
+
+		return simd::bit_or(values, simd::shift_l<4>(values));
+	}
+
+	/** Adds single channel values of 16 pixels in row major order into a channel of the decoded rows. */
+	static void insertChannel(BlockRows& rows, const simd::uint8x16& values, UINT32 channel)
+	{
+		const ShuffleTables& tables = getShuffleTables();
+		for(UINT32 y = 0; y < BLOCK_DIM; y++)
+		{
+			const simd::uint8x16 shuffle = simd::load_u<simd::uint8x16>(tables.channelRows[channel][y]);
+			rows[y] = simd::bit_or(rows[y], simd::permute_zbytes16(values, shuffle));
+		}
+	}
+
+	/** Initializes the decoded rows to pixels with all channels zero, except alpha which is one. */
+	static void clearOpaque(BlockRows& rows)
+	{
+		const simd::uint8x16 opaque = simd::bit_cast<simd::uint8x16>(simd::splat<simd::uint32x4>(0xFF000000));
+		for(UINT32 y = 0; y < BLOCK_DIM; y++)
+			rows[y] = opaque;
+	}
+
+	/** Decodes blocks of a specific compressed format. */
+	template<PixelFormat FORMAT>
+	struct BlockDecoder;
+
+	template<>
+	struct BlockDecoder<PF_BC1>
+	{
+		static constexpr UINT32 SIZE = 8;
+
+		static void decode(const UINT8* block, BlockRows& rows)
+		{
+			decodeColorBlock(block, rows, 0xFF000000, true, 0xFF000000);
+		}
+	};
+
+	template<>
+	struct BlockDecoder<PF_BC1a>
+	{
+		static constexpr UINT32 SIZE = 8;
+
+		static void decode(const UINT8* block, BlockRows& rows)
+		{
+			decodeColorBlock(block, rows, 0xFF000000, true, 0);
+		}
+	};
+
+	template<>
+	struct BlockDecoder<PF_BC2>
+	{
+		static constexpr UINT32 SIZE = 16;
+
+		static void decode(const UINT8* block, BlockRows& rows)
+		{
+			decodeColorBlock(block + 8, rows, 0, false, 0);
+			insertChannel(rows, decodeExplicitAlphaBlock(block), 3);
+		}
+	};
+
+	template<>
+	struct BlockDecoder<PF_BC3>
+	{
+		static constexpr UINT32 SIZE = 16;
+
+		static void decode(const UINT8* block, BlockRows& rows)
+		{
+			decodeColorBlock(block + 8, rows, 0, false, 0);
+			insertChannel(rows, decodeChannelBlock(block), 3);
+		}
+	};
+
+	template<>
+	struct BlockDecoder<PF_BC4>
+	{
+		static constexpr UINT32 SIZE = 8;
+
+		static void decode(const UINT8* block, BlockRows& rows)
+		{
+			clearOpaque(rows);
+			insertChannel(rows, decodeChannelBlock(block), 0);
+		}
+	};
+
+	template<>
+	struct BlockDecoder<PF_BC5>
+	{
+		static constexpr UINT32 SIZE = 16;
+
+		static void decode(const UINT8* block, BlockRows& rows)
+		{
+			clearOpaque(rows);
+			insertChannel(rows, decodeChannelBlock(block), 0);
+			insertChannel(rows, decodeChannelBlock(block + 8), 1);
+		}
+	};
+
+	template<PixelFormat FORMAT>
+	static void decodeRow(const UINT8* src, UINT8* dst, UINT32 dstRowPitch, UINT32 count)
+	{
+		for(UINT32 i = 0; i < count; i++)
+		{
+			BlockRows rows;
+			BlockDecoder<FORMAT>::decode(src + i * BlockDecoder<FORMAT>::SIZE, rows);
+
+			UINT8* output = dst + i * BLOCK_DIM * 4;
+			for(UINT32 y = 0; y < BLOCK_DIM; y++)
+				simd::store_u(output + y * dstRowPitch, rows[y]);
+		}
+	}
+
+	BCDecompressionKernels::DecodeRowFn BCDecompressionKernels::find(PixelFormat format)
+	{
+		switch(format)
+		{
+		case PF_BC1:
+			return &decodeRow<PF_BC1>;
+		case PF_BC1a:
+			return &decodeRow<PF_BC1a>;
+		case PF_BC2:
+			return &decodeRow<PF_BC2>;
+		case PF_BC3:
+			return &decodeRow<PF_BC3>;
+		case PF_BC4:
+			return &decodeRow<PF_BC4>;
+		case PF_BC5:
+			return &decodeRow<PF_BC5>;
+		default:
+			return nullptr;
+		}
+	}
+}
@@ -0,0 +1,37 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Image/BsPixelData.h"
+
+namespace bs
+{
+	/** @addtogroup Utility-Core-Internal
+	 *  @{
+	 */
+
+	/**
+	 * SIMD kernels used by PixelUtil for decoding block compressed data to PF_RGBA8 pixels. Supported are PF_BC1,
+	 * PF_BC1a, PF_BC2, PF_BC3, PF_BC4 and PF_BC5. Palettes are evaluated the same way as NVTT evaluates them. Channels
+	 * not present in a format are decoded as zero, and alpha as one if the format has no alpha.
+	 */
+	struct BS_CORE_EXPORT BCDecompressionKernels
+	{
+		/**
+		 * Decodes a row of blocks.
+		 *
+		 * @param[in]	src			Blocks in the compressed format.
+		 * @param[out]	dst			Buffer to receive the decoded pixels. Receives four rows of pixels, each four times
+		 *							@p count pixels wide.
+		 * @param[in]	dstRowPitch	Offset between the rows in @p dst, in bytes.
+		 * @param[in]	count		Number of blocks to decode.
+		 */
+		typedef void(*DecodeRowFn)(const UINT8* src, UINT8* dst, UINT32 dstRowPitch, UINT32 count);
+
+		/** Returns a kernel decoding blocks of the provided format, or null if the format is not supported. */
+		static DecodeRowFn find(PixelFormat format);
+	};
+
+	/** @} */
+}
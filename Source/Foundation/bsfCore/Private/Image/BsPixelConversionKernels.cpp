@@ -0,0 +1,394 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Image/BsPixelConversionKernels.h"
+#include "Image/BsPixelUtil.h"
+#include "Image/BsColor.h"
+#include "Math/BsSIMD.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	static constexpr UINT32 SIMD_WIDTH = PixelConversionKernels::SIMD_WIDTH;
+
+	/** Marks a byte in a shuffle mask that should be set to zero. */
+	static constexpr UINT8 ZERO = 0x80;
+
+	/** Builds a mask for simd::permute_zbytes16() that applies the same byte shuffle to each of four pixels. */
+	static simd::uint8x16 makePixelShuffle(UINT8 b0, UINT8 b1, UINT8 b2, UINT8 b3)
+	{
+		const auto entry = [](UINT8 value, UINT8 offset) { return value == ZERO ? ZERO : (UINT8)(value + offset); };
+
+		return simd::make_uint(
+			entry(b0, 0), entry(b1, 0), entry(b2, 0), entry(b3, 0),
+			entry(b0, 4), entry(b1, 4), entry(b2, 4), entry(b3, 4),
+			entry(b0, 8), entry(b1, 8), entry(b2, 8), entry(b3, 8),
+			entry(b0, 12), entry(b1, 12), entry(b2, 12), entry(b3, 12));
+	}
+
+	/** Returns a vector with the alpha byte of each of four RGBA8 pixels set. */
+	static simd::uint8x16 makeAlphaMask()
+	{
+		return simd::bit_cast<simd::uint8x16>(simd::splat<simd::uint32x4>(0xFF000000));
+	}
+
+	/** Returns half precision values for each possible value of an 8-bit normalized channel. */
+	static const UINT16* getUnormToHalfTable()
+	{
+		struct Table
+		{
+			Table()
+			{
+				for(UINT32 i = 0; i < 256; i++)
+					values[i] = Bitwise::floatToHalf(Bitwise::uintToUnorm<8>(i));
+			}
+
+			UINT16 values[256];
+		};
+
+		static const Table table;
+		return table.values;
+	}
+
+	/**
+	 * Converts four pixels worth of float channels to 8-bit normalized values, the same way as Bitwise::unormToUint(),
+	 * and returns them packed in a single vector.
+	 */
+	static simd::uint8x16 floatToUnorm(const float* channels)
+	{
+		const simd::float32<16> zero = simd::splat(0.0f);
+		const simd::float32<16> one = simd::splat(1.0f);
+		const simd::float32<16> scale = simd::splat(255.0f);
+		const simd::float32<16> half = simd::splat(0.5f);
+
+		simd::float32<16> values = simd::load_u(channels);
+
+		// Clamping first also maps NaN to zero, as max() returns its second operand if either one is NaN
+		values = simd::min(simd::max(values, zero), one);
+		values = simd::floor(simd::add(simd::mul(values, scale), half));
+
+		return simd::to_uint8(simd::to_uint32(values));
+	}
+
+	/** Converts four pixels worth of 8-bit normalized channels to floats, the same way as Bitwise::uintToUnorm(). */
+	static void unormToFloat(const simd::uint8x16& bytes, float* channels)
+	{
+		const simd::float32<16> max = simd::splat(255.0f);
+		const simd::float32<16> values = simd::to_float32(simd::to_int32(bytes));
+
+		simd::store_u(channels, simd::div(values, max));
+	}
+
+	/**
+	 * Loads and stores groups of SIMD_WIDTH pixels of a specific format. Pixels are converted to and from four RGBA8
+	 * pixels packed in a single vector, which is lossless for all supported 8-bit formats.
+	 */
+	template<PixelFormat FORMAT>
+	struct PixelIO;
+
+	template<>
+	struct PixelIO<PF_RGBA8>
+	{
+		static constexpr UINT32 SIZE = 4;
+
+		static simd::uint8x16 load(const UINT8* src)
+		{
+			return simd::load_u<simd::uint8x16>(src);
+		}
+
+		static void store(UINT8* dst, const simd::uint8x16& rgba)
+		{
+			simd::store_u(dst, rgba);
+		}
+	};
+
+	template<>
+	struct PixelIO<PF_BGRA8>
+	{
+		static constexpr UINT32 SIZE = 4;
+
+		static simd::uint8x16 load(const UINT8* src)
+		{
+			return simd::permute_zbytes16(simd::load_u<simd::uint8x16>(src), makePixelShuffle(2, 1, 0, 3));
+		}
+
+		static void store(UINT8* dst, const simd::uint8x16& rgba)
+		{
+			simd::store_u(dst, simd::permute_zbytes16(rgba, makePixelShuffle(2, 1, 0, 3)));
+		}
+	};
+
+	template<>
+	struct PixelIO<PF_RGB8>
+	{
+		static constexpr UINT32 SIZE = 4;
+
+		static simd::uint8x16 load(const UINT8* src)
+		{
+			// The fourth byte is unused, and the missing alpha is treated as fully opaque
+			return simd::bit_or(simd::load_u<simd::uint8x16>(src), makeAlphaMask());
+		}
+
+		static void store(UINT8* dst, const simd::uint8x16& rgba)
+		{
+			simd::store_u(dst, simd::bit_andnot(rgba, makeAlphaMask()));
+		}
+	};
+
+	template<>
+	struct PixelIO<PF_BGR8>
+	{
+		static constexpr UINT32 SIZE = 4;
+
+		static simd::uint8x16 load(const UINT8* src)
+		{
+			const simd::uint8x16 rgb = simd::permute_zbytes16(simd::load_u<simd::uint8x16>(src),
+				makePixelShuffle(2, 1, 0, ZERO));
+
+			return simd::bit_or(rgb, makeAlphaMask());
+		}
+
+		static void store(UINT8* dst, const simd::uint8x16& rgba)
+		{
+			simd::store_u(dst, simd::permute_zbytes16(rgba, makePixelShuffle(2, 1, 0, ZERO)));
+		}
+	};
+
+	template<>
+	struct PixelIO<PF_R8>
+	{
+		static constexpr UINT32 SIZE = 1;
+
+		static simd::uint8x16 load(const UINT8* src)
+		{
+			UINT32 value;
+			memcpy(&value, src, sizeof(value));
+
+			const simd::uint8x16 red = simd::permute_zbytes16(
+				simd::bit_cast<simd::uint8x16>(simd::make_uint<simd::uint32x4>(value, 0, 0, 0)),
+				simd::make_uint<simd::uint8x16>(0, ZERO, ZERO, ZERO, 1, ZERO, ZERO, ZERO, 2, ZERO, ZERO, ZERO, 3, ZERO,
+					ZERO, ZERO));
+
+			return simd::bit_or(red, makeAlphaMask());
+		}
+
+		static void store(UINT8* dst, const simd::uint8x16& rgba)
+		{
+			const simd::uint8x16 red = simd::permute_zbytes16(rgba,
+				simd::make_uint<simd::uint8x16>(0, 4, 8, 12, ZERO, ZERO, ZERO, ZERO, ZERO, ZERO, ZERO, ZERO, ZERO, ZERO,
+					ZERO, ZERO));
+
+			const UINT32 value = simd::extract<0>(simd::bit_cast<simd::uint32x4>(red));
+			memcpy(dst, &value, sizeof(value));
+		}
+	};
+
+	template<>
+	struct PixelIO<PF_RGBA32F>
+	{
+		static constexpr UINT32 SIZE = 16;
+
+		static simd::uint8x16 load(const UINT8* src)
+		{
+			return floatToUnorm((const float*)src);
+		}
+
+		static void store(UINT8* dst, const simd::uint8x16& rgba)
+		{
+			unormToFloat(rgba, (float*)dst);
+		}
+	};
+
+	template<>
+	struct PixelIO<PF_RGBA16F>
+	{
+		static constexpr UINT32 SIZE = 8;
+
+		static simd::uint8x16 load(const UINT8* src)
+		{
+			// No hardware half conversion in SSE4.1, so only the quantization is vectorized
+			alignas(16) float channels[SIMD_WIDTH * 4];
+			for(UINT32 i = 0; i < SIMD_WIDTH * 4; i++)
+			{
+				UINT16 value;
+				memcpy(&value, src + i * sizeof(UINT16), sizeof(value));
+
+				channels[i] = Bitwise::halfToFloat(value);
+			}
+
+			return floatToUnorm(channels);
+		}
+
+		static void store(UINT8* dst, const simd::uint8x16& rgba)
+		{
+			const UINT16* table = getUnormToHalfTable();
+
+			alignas(16) UINT8 bytes[SIMD_WIDTH * 4];
+			simd::store(bytes, rgba);
+
+			UINT16 values[SIMD_WIDTH * 4];
+			for(UINT32 i = 0; i < SIMD_WIDTH * 4; i++)
+				values[i] = table[bytes[i]];
+
+			memcpy(dst, values, sizeof(values));
+		}
+	};
+
+	/**
+	 * Converts a row of pixels from format SRC to format DST. Pixels that don't fill a whole SIMD group are converted
+	 * through a temporary buffer, so loads and stores never go past the end of the row.
+	 */
+	template<PixelFormat SRC, PixelFormat DST>
+	static void convertRow(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		static constexpr UINT32 SRC_SIZE = PixelIO<SRC>::SIZE;
+		static constexpr UINT32 DST_SIZE = PixelIO<DST>::SIZE;
+
+		UINT32 i = 0;
+		for(; (i + SIMD_WIDTH) <= count; i += SIMD_WIDTH)
+			PixelIO<DST>::store(dst + i * DST_SIZE, PixelIO<SRC>::load(src + i * SRC_SIZE));
+
+		if(i < count)
+		{
+			const UINT32 numRemaining = count - i;
+
+			UINT8 srcPixels[SIMD_WIDTH * SRC_SIZE] = { };
+			UINT8 dstPixels[SIMD_WIDTH * DST_SIZE];
+
+			memcpy(srcPixels, src + i * SRC_SIZE, numRemaining * SRC_SIZE);
+			PixelIO<DST>::store(dstPixels, PixelIO<SRC>::load(srcPixels));
+			memcpy(dst + i * DST_SIZE, dstPixels, numRemaining * DST_SIZE);
+		}
+	}
+
+	/** Formats handled by the conversion kernels. */
+	static constexpr PixelFormat KERNEL_FORMATS[] =
+		{ PF_R8, PF_RGB8, PF_BGR8, PF_RGBA8, PF_BGRA8, PF_RGBA16F, PF_RGBA32F };
+	static constexpr UINT32 NUM_KERNEL_FORMATS = sizeof(KERNEL_FORMATS) / sizeof(KERNEL_FORMATS[0]);
+
+	/**
+	 * Returns the row conversion kernel between the provided formats. Conversions between two floating point formats
+	 * don't go through 8-bit values, and have no kernel.
+	 */
+	template<PixelFormat SRC, PixelFormat DST>
+	static constexpr PixelConversionKernels::ConvertRowFn getKernel()
+	{
+		return (SRC == DST || (PixelIO<SRC>::SIZE > 4 && PixelIO<DST>::SIZE > 4)) ? nullptr : &convertRow<SRC, DST>;
+	}
+
+#define BS_PIXEL_KERNEL_ROW(SRC)																				\
+	{																										\
+		getKernel<SRC, PF_R8>(), getKernel<SRC, PF_RGB8>(), getKernel<SRC, PF_BGR8>(),						\
+		getKernel<SRC, PF_RGBA8>(), getKernel<SRC, PF_BGRA8>(), getKernel<SRC, PF_RGBA16F>(),				\
+		getKernel<SRC, PF_RGBA32F>()																		\
+	}
+
+	/** Kernels for each pair of formats, indexed by the positions of the formats in KERNEL_FORMATS. */
+	static const PixelConversionKernels::ConvertRowFn KERNELS[NUM_KERNEL_FORMATS][NUM_KERNEL_FORMATS] =
+	{
+		BS_PIXEL_KERNEL_ROW(PF_R8),
+		BS_PIXEL_KERNEL_ROW(PF_RGB8),
+		BS_PIXEL_KERNEL_ROW(PF_BGR8),
+		BS_PIXEL_KERNEL_ROW(PF_RGBA8),
+		BS_PIXEL_KERNEL_ROW(PF_BGRA8),
+		BS_PIXEL_KERNEL_ROW(PF_RGBA16F),
+		BS_PIXEL_KERNEL_ROW(PF_RGBA32F)
+	};
+
+#undef BS_PIXEL_KERNEL_ROW
+
+	/** Returns the position of @p format in KERNEL_FORMATS, or NUM_KERNEL_FORMATS if not supported. */
+	static UINT32 findKernelFormat(PixelFormat format)
+	{
+		UINT32 i = 0;
+		while(i < NUM_KERNEL_FORMATS && KERNEL_FORMATS[i] != format)
+			i++;
+
+		return i;
+	}
+
+	PixelConversionKernels::ConvertRowFn PixelConversionKernels::find(PixelFormat src, PixelFormat dst)
+	{
+		const UINT32 srcIdx = findKernelFormat(src);
+		const UINT32 dstIdx = findKernelFormat(dst);
+
+		if(srcIdx == NUM_KERNEL_FORMATS || dstIdx == NUM_KERNEL_FORMATS)
+			return nullptr;
+
+		return KERNELS[srcIdx][dstIdx];
+	}
+
+	/** Lookup tables converting 8-bit normalized channels between linear and sRGB space. */
+	struct SRGBTables
+	{
+		SRGBTables()
+		{
+			// Built using the same per-pixel operations as the generic path, so the results are identical
+			for(UINT32 i = 0; i < 256; i++)
+			{
+				const UINT8 value = (UINT8)i;
+
+				Color color;
+				PixelUtil::unpackColor(&color, PF_R8, &value);
+
+				PixelUtil::packColor(color.getGamma(), PF_R8, &toSRGB[i]);
+				PixelUtil::packColor(color.getLinear(), PF_R8, &toLinear[i]);
+			}
+		}
+
+		UINT8 toSRGB[256];
+		UINT8 toLinear[256];
+	};
+
+	/**
+	 * Applies the lookup table to the color channels of @p count pixels. Returns false if the format isn't an 8-bit
+	 * normalized format.
+	 */
+	static bool applyChannelTable(UINT8* data, PixelFormat format, UINT32 count, const UINT8* table)
+	{
+		// Color channels are always the leading bytes of the pixel, followed by alpha or padding
+		UINT32 pixelSize;
+		UINT32 numColorChannels;
+		switch(format)
+		{
+		case PF_R8: pixelSize = 1; numColorChannels = 1; break;
+		case PF_RG8: pixelSize = 2; numColorChannels = 2; break;
+		case PF_RGB8: case PF_BGR8: case PF_RGBA8: case PF_BGRA8: pixelSize = 4; numColorChannels = 3; break;
+		default:
+			return false;
+		}
+
+		if(pixelSize == numColorChannels)
+		{
+			for(UINT32 i = 0; i < count * pixelSize; i++)
+				data[i] = table[data[i]];
+		}
+		else
+		{
+			for(UINT32 i = 0; i < count; i++)
+			{
+				UINT8* pixel = data + i * pixelSize;
+				pixel[0] = table[pixel[0]];
+				pixel[1] = table[pixel[1]];
+				pixel[2] = table[pixel[2]];
+			}
+		}
+
+		return true;
+	}
+
+	static const SRGBTables& getSRGBTables()
+	{
+		static const SRGBTables tables;
+		return tables;
+	}
+
+	bool PixelConversionKernels::linearToSRGB(UINT8* data, PixelFormat format, UINT32 count)
+	{
+		return applyChannelTable(data, format, count, getSRGBTables().toSRGB);
+	}
+
+	bool PixelConversionKernels::SRGBToLinear(UINT8* data, PixelFormat format, UINT32 count)
+	{
+		return applyChannelTable(data, format, count, getSRGBTables().toLinear);
+	}
+}
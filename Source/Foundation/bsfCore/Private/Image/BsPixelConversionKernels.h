@@ -0,0 +1,56 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Image/BsPixelData.h"
+
+namespace bs
+{
+	/** @addtogroup Utility-Core-Internal
+	 *  @{
+	 */
+
+	/**
+	 * SIMD kernels used by PixelUtil for converting pixels between common formats directly, instead of unpacking each
+	 * pixel to floating point and packing it again. Supported are conversions between any two of PF_R8, PF_RGB8,
+	 * PF_BGR8, PF_RGBA8 and PF_BGRA8, and conversions between those formats and PF_RGBA16F or PF_RGBA32F.
+	 *
+	 * Conversions between 8-bit formats copy the channels exactly. Conversions from floating point formats quantize
+	 * the values the same way as PixelUtil::packColor(), and conversions to floating point formats produce the same
+	 * values as PixelUtil::unpackColor().
+	 */
+	struct BS_CORE_EXPORT PixelConversionKernels
+	{
+		/**
+		 * Converts a row of pixels.
+		 *
+		 * @param[in]	src		Pixels in the source format.
+		 * @param[out]	dst		Buffer to receive the converted pixels. Must not overlap with @p src.
+		 * @param[in]	count	Number of pixels to convert.
+		 */
+		typedef void(*ConvertRowFn)(const UINT8* src, UINT8* dst, UINT32 count);
+
+		/** Number of pixels processed at once by the SIMD kernels. */
+		static constexpr UINT32 SIMD_WIDTH = 4;
+
+		/** Returns a kernel converting pixels from format @p src to format @p dst, or null if there is none. */
+		static ConvertRowFn find(PixelFormat src, PixelFormat dst);
+
+		/**
+		 * Converts the color channels of @p count pixels in format @p format from linear to sRGB space, in place.
+		 * Returns false if the format is not supported, in which case the pixels are left unchanged. Only 8-bit
+		 * normalized formats are supported.
+		 */
+		static bool linearToSRGB(UINT8* data, PixelFormat format, UINT32 count);
+
+		/**
+		 * Converts the color channels of @p count pixels in format @p format from sRGB to linear space, in place.
+		 * Returns false if the format is not supported, in which case the pixels are left unchanged. Only 8-bit
+		 * normalized formats are supported.
+		 */
+		static bool SRGBToLinear(UINT8* data, PixelFormat format, UINT32 count);
+	};
+
+	/** @} */
+}
@@ -0,0 +1,107 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Image/BsTextureImportUtility.h"
+#include "Image/BsPixelUtil.h"
+#include "Importer/BsTextureImportOptions.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	/** Runs the worker over the range [0, @p count), one item per task if the task scheduler is running. */
+	static void parallelForEach(const String& name, UINT32 count, const std::function<void(UINT32, UINT32)>& worker)
+	{
+		if(count > 1 && TaskScheduler::isStarted())
+			TaskScheduler::instance().parallelFor(name, count, 1, worker);
+		else
+			worker(0, count);
+	}
+
+	UINT32 TextureImportUtility::getNumMips(const PixelData& face, const TextureImportOptions& options)
+	{
+		if (!options.generateMips || !Bitwise::isPow2(face.getWidth()) || !Bitwise::isPow2(face.getHeight()))
+			return 0;
+
+		const UINT32 maxPossibleMip = PixelUtil::getMaxMipmaps(face.getWidth(), face.getHeight(), face.getDepth(),
+			face.getFormat());
+
+		if (options.maxMip == 0)
+			return maxPossibleMip;
+
+		return std::min(maxPossibleMip, options.maxMip);
+	}
+
+	Vector<Vector<SPtr<PixelData>>> TextureImportUtility::generateSurfaces(const Vector<SPtr<PixelData>>& faces,
+		PixelFormat format, UINT32 numMips, const TextureImportOptions& options)
+	{
+		struct Surface
+		{
+			UINT32 face;
+			UINT32 mip;
+		};
+
+		const UINT32 numFaces = (UINT32)faces.size();
+		Vector<Vector<SPtr<PixelData>>> output(numFaces);
+
+		// Uncompressed mip chains can be much larger than the output, so only a limited number of faces is processed
+		// at once, enough to keep all threads busy
+		const UINT32 maxFacesInFlight = std::max(1U, (UINT32)BS_THREAD_HARDWARE_CONCURRENCY);
+		for (UINT32 firstFace = 0; firstFace < numFaces; firstFace += maxFacesInFlight)
+		{
+			const UINT32 numFacesInFlight = std::min(maxFacesInFlight, numFaces - firstFace);
+
+			// Each mip chain is generated from the previous level, so only separate faces can be generated in parallel
+			Vector<Vector<SPtr<PixelData>>> mipLevels(numFacesInFlight);
+			parallelForEach("TextureMipGeneration", numFacesInFlight, [&](UINT32 start, UINT32 end)
+			{
+				for (UINT32 i = start; i < end; i++)
+				{
+					const PixelData& face = *faces[firstFace + i];
+					if (numMips > 0)
+					{
+						MipMapGenOptions mipOptions;
+						mipOptions.isSRGB = options.sRGB;
+
+						mipLevels[i] = PixelUtil::genMipmaps(face, mipOptions);
+
+						// Full chain is always generated, even if fewer levels were requested
+						if (mipLevels[i].size() > numMips + 1)
+							mipLevels[i].resize(numMips + 1);
+					}
+					else
+						mipLevels[i].push_back(faces[firstFace + i]);
+				}
+			});
+
+			Vector<Surface> surfaces;
+			for (UINT32 i = 0; i < numFacesInFlight; i++)
+			{
+				output[firstFace + i].resize(mipLevels[i].size());
+
+				for (UINT32 mip = 0; mip < (UINT32)mipLevels[i].size(); mip++)
+					surfaces.push_back({ i, mip });
+			}
+
+			// Conversion and compression of each level is independent, so all levels of the faces are processed at
+			// once. Compression of large levels is further split over the task scheduler by PixelUtil.
+			parallelForEach("TextureSurfaceConversion", (UINT32)surfaces.size(), [&](UINT32 start, UINT32 end)
+			{
+				for (UINT32 i = start; i < end; i++)
+				{
+					const Surface& surface = surfaces[i];
+					SPtr<PixelData>& src = mipLevels[surface.face][surface.mip];
+
+					SPtr<PixelData> dst = PixelData::create(src->getWidth(), src->getHeight(), 1, format);
+					PixelUtil::bulkPixelConversion(*src, *dst);
+
+					output[firstFace + surface.face][surface.mip] = dst;
+
+					// Source level is no longer needed
+					src = nullptr;
+				}
+			});
+		}
+
+		return output;
+	}
+}
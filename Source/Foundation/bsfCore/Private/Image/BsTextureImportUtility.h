@@ -0,0 +1,43 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Image/BsPixelData.h"
+
+namespace bs
+{
+	class TextureImportOptions;
+
+	/** @addtogroup Importer-Internal
+	 *  @{
+	 */
+
+	/** Helper methods used by texture importers for generating the data of imported textures. */
+	struct BS_CORE_EXPORT TextureImportUtility
+	{
+		/**
+		 * Returns the number of mip levels to generate for a texture, not counting the top level, according to the
+		 * import options. Returns zero if mip generation is disabled, or not possible for the texture's size.
+		 */
+		static UINT32 getNumMips(const PixelData& face, const TextureImportOptions& options);
+
+		/**
+		 * Generates the mip levels of every face of a texture and converts them to the texture's format, compressing
+		 * them if the format is compressed. If the task scheduler is running, faces are processed in parallel, as are
+		 * all the mip levels of those faces once generated. To limit memory use, at most as many faces as there are
+		 * hardware threads are processed at once, and each generated level is released as soon as it is converted.
+		 *
+		 * @param[in]	faces		Top mip level of every face of the texture (e.g. cubemap faces or array slices). All
+		 *							faces must be of the same size.
+		 * @param[in]	format		Format to convert the data to.
+		 * @param[in]	numMips		Number of mip levels to generate, not counting the top level.
+		 * @param[in]	options		Options the texture is being imported with.
+		 * @return					Data of every mip level of every face, indexed by face, then by mip level.
+		 */
+		static Vector<Vector<SPtr<PixelData>>> generateSurfaces(const Vector<SPtr<PixelData>>& faces,
+			PixelFormat format, UINT32 numMips, const TextureImportOptions& options);
+	};
+
+	/** @} */
+}
@@ -0,0 +1,208 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Particles/BsParticleKernels.h"
+#include "Math/BsSIMD.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	static_assert(sizeof(Vector3) == sizeof(float) * 3, "Kernels assume Vector3 arrays are tightly packed floats.");
+
+	/** Number of particles processed at once by the SIMD kernels. */
+	static constexpr UINT32 SIMD_WIDTH = 4;
+
+	/** Converts a SIMD comparison mask into a bit mask, with one bit per element. */
+	static UINT32 toBitMask(const simd::mask_float32x4& mask)
+	{
+		// One bit per byte, convert to one bit per element
+		const UINT32 byteMask = simd::extract_bits_any(simd::bit_cast<simd::uint8x16>(mask));
+		return (byteMask & 0x1) | ((byteMask >> 3) & 0x2) | ((byteMask >> 6) & 0x4) | ((byteMask >> 9) & 0x8);
+	}
+
+	/**
+	 * Transforms vectors by the upper 3x4 part of the provided matrix. Translation is only applied if @p point is true,
+	 * otherwise the vectors are treated as directions.
+	 */
+	template<bool point>
+	static void transformVectors(Vector3* data, const Matrix4& tfrm, UINT32 count)
+	{
+		simd::float32x4 m[3][4];
+		for(UINT32 row = 0; row < 3; row++)
+		{
+			for(UINT32 column = 0; column < 4; column++)
+				m[row][column] = simd::splat(tfrm[row][column]);
+		}
+
+		UINT32 i = 0;
+		for(; (i + SIMD_WIDTH) <= count; i += SIMD_WIDTH)
+		{
+			// Packed loads and stores require aligned memory, which particle buffers don't provide
+			alignas(16) float entries[SIMD_WIDTH * 3];
+			memcpy(entries, &data[i], sizeof(entries));
+
+			simd::float32x4 x, y, z;
+			simd::load_packed3(x, y, z, entries);
+
+			simd::float32x4 output[3];
+			for(UINT32 row = 0; row < 3; row++)
+			{
+				output[row] = simd::mul(m[row][0], x);
+				output[row] = simd::add(output[row], simd::mul(m[row][1], y));
+				output[row] = simd::add(output[row], simd::mul(m[row][2], z));
+
+				if(point)
+					output[row] = simd::add(output[row], m[row][3]);
+			}
+
+			simd::store_packed3(entries, output[0], output[1], output[2]);
+			memcpy(&data[i], entries, sizeof(entries));
+		}
+
+		for(; i < count; i++)
+			data[i] = point ? tfrm.multiplyAffine(data[i]) : tfrm.multiplyDirection(data[i]);
+	}
+
+	void ParticleKernels::add(Vector3* dst, const Vector3& value, UINT32 count)
+	{
+		// Four vectors span three SIMD registers, each one needing the vector components in a different order
+		const simd::float32x4 value0 = simd::make_float(value.x, value.y, value.z, value.x);
+		const simd::float32x4 value1 = simd::make_float(value.y, value.z, value.x, value.y);
+		const simd::float32x4 value2 = simd::make_float(value.z, value.x, value.y, value.z);
+
+		float* data = (float*)dst;
+
+		UINT32 i = 0;
+		for(; (i + SIMD_WIDTH) <= count; i += SIMD_WIDTH)
+		{
+			float* entry = data + i * 3;
+
+			simd::store_u(entry + 0, simd::add(simd::load_u<simd::float32x4>(entry + 0), value0));
+			simd::store_u(entry + 4, simd::add(simd::load_u<simd::float32x4>(entry + 4), value1));
+			simd::store_u(entry + 8, simd::add(simd::load_u<simd::float32x4>(entry + 8), value2));
+		}
+
+		for(; i < count; i++)
+			dst[i] += value;
+	}
+
+	void ParticleKernels::addScaled(Vector3* dst, const Vector3* src, float scale, UINT32 count)
+	{
+		const simd::float32x4 scaleVec = simd::splat(scale);
+
+		// Same operation is applied to every component, so the data can be processed as a flat array of floats
+		float* dstData = (float*)dst;
+		const float* srcData = (const float*)src;
+		const UINT32 numFloats = count * 3;
+
+		UINT32 i = 0;
+		for(; (i + SIMD_WIDTH) <= numFloats; i += SIMD_WIDTH)
+		{
+			const simd::float32x4 srcValue = simd::load_u<simd::float32x4>(srcData + i);
+			const simd::float32x4 dstValue = simd::load_u<simd::float32x4>(dstData + i);
+
+			simd::store_u(dstData + i, simd::add(dstValue, simd::mul(srcValue, scaleVec)));
+		}
+
+		for(; i < numFloats; i++)
+			dstData[i] += srcData[i] * scale;
+	}
+
+	void ParticleKernels::subtract(float* dst, float value, UINT32 count)
+	{
+		const simd::float32x4 valueVec = simd::splat(value);
+
+		UINT32 i = 0;
+		for(; (i + SIMD_WIDTH) <= count; i += SIMD_WIDTH)
+			simd::store_u(dst + i, simd::sub(simd::load_u<simd::float32x4>(dst + i), valueVec));
+
+		for(; i < count; i++)
+			dst[i] -= value;
+	}
+
+	void ParticleKernels::normalizedAge(const float* initialLifetime, const float* lifetime, float* output, UINT32 count)
+	{
+		UINT32 i = 0;
+		for(; (i + SIMD_WIDTH) <= count; i += SIMD_WIDTH)
+		{
+			const simd::float32x4 initial = simd::load_u<simd::float32x4>(initialLifetime + i);
+			const simd::float32x4 remaining = simd::load_u<simd::float32x4>(lifetime + i);
+
+			simd::store_u(output + i, simd::div(simd::sub(initial, remaining), initial));
+		}
+
+		for(; i < count; i++)
+			output[i] = (initialLifetime[i] - lifetime[i]) / initialLifetime[i];
+	}
+
+	void ParticleKernels::transformPoints(Vector3* data, const Matrix4& tfrm, UINT32 count)
+	{
+		transformVectors<true>(data, tfrm, count);
+	}
+
+	void ParticleKernels::transformDirections(Vector3* data, const Matrix4& tfrm, UINT32 count)
+	{
+		transformVectors<false>(data, tfrm, count);
+	}
+
+	UINT32 ParticleKernels::findPlaneCollisions(const Vector3* positions, UINT32 count, const Plane* planes,
+		UINT32 numPlanes, float radius, UINT32* output)
+	{
+		if(numPlanes == 0)
+			return 0;
+
+		const simd::float32x4 radiusVec = simd::splat(radius);
+
+		UINT32 numFound = 0;
+		UINT32 i = 0;
+		for(; (i + SIMD_WIDTH) <= count; i += SIMD_WIDTH)
+		{
+			// Packed loads require aligned memory, which particle buffers don't provide
+			alignas(16) float entries[SIMD_WIDTH * 3];
+			memcpy(entries, &positions[i], sizeof(entries));
+
+			simd::float32x4 x, y, z;
+			simd::load_packed3(x, y, z, entries);
+
+			// Note: Testing for "outside" rather than "inside" so NaN distances are treated the same as in scalar code
+			UINT32 outside = 0xF;
+			for(UINT32 j = 0; j < numPlanes; j++)
+			{
+				const Plane& plane = planes[j];
+				const simd::float32x4 normalX = simd::splat(plane.normal.x);
+				const simd::float32x4 normalY = simd::splat(plane.normal.y);
+				const simd::float32x4 normalZ = simd::splat(plane.normal.z);
+				const simd::float32x4 d = simd::splat(plane.d);
+
+				simd::float32x4 dist = simd::mul(normalX, x);
+				dist = simd::add(dist, simd::mul(normalY, y));
+				dist = simd::add(dist, simd::mul(normalZ, z));
+				dist = simd::sub(dist, d);
+
+				outside &= toBitMask(simd::cmp_gt(dist, radiusVec));
+			}
+
+			UINT32 mask = ~outside & 0xF;
+			while(mask != 0)
+			{
+				const UINT32 lane = Bitwise::leastSignificantBit(mask);
+				output[numFound++] = i + lane;
+
+				mask &= mask - 1;
+			}
+		}
+
+		for(; i < count; i++)
+		{
+			for(UINT32 j = 0; j < numPlanes; j++)
+			{
+				if(!(planes[j].getDistance(positions[i]) > radius))
+				{
+					output[numFound++] = i;
+					break;
+				}
+			}
+		}
+
+		return numFound;
+	}
+}
@@ -0,0 +1,54 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Math/BsVector3.h"
+#include "Math/BsPlane.h"
+#include "Math/BsMatrix4.h"
+
+namespace bs
+{
+	/** @addtogroup Particles-Internal
+	 *  @{
+	 */
+
+	/**
+	 * SIMD kernels used for updating particle data stored in ParticleSetData. Each kernel processes four particles at a
+	 * time and handles the remainder using scalar code. The kernels perform the same operations in the same order as
+	 * the per-particle code they replace, so the results are identical.
+	 */
+	struct BS_CORE_EXPORT ParticleKernels
+	{
+		/** Adds @p value to each of the @p count vectors in @p dst. */
+		static void add(Vector3* dst, const Vector3& value, UINT32 count);
+
+		/** Adds each of the @p count vectors in @p src, multiplied by @p scale, to the vectors in @p dst. */
+		static void addScaled(Vector3* dst, const Vector3* src, float scale, UINT32 count);
+
+		/** Subtracts @p value from each of the @p count values in @p dst. */
+		static void subtract(float* dst, float value, UINT32 count);
+
+		/**
+		 * Calculates the normalized age of @p count particles, in range [0, 1], from their initial and remaining
+		 * lifetime. Results are written to @p output.
+		 */
+		static void normalizedAge(const float* initialLifetime, const float* lifetime, float* output, UINT32 count);
+
+		/** Transforms each of the @p count points in @p data by the affine transform @p tfrm. */
+		static void transformPoints(Vector3* data, const Matrix4& tfrm, UINT32 count);
+
+		/** Transforms each of the @p count directions in @p data by the affine transform @p tfrm. */
+		static void transformDirections(Vector3* data, const Matrix4& tfrm, UINT32 count);
+
+		/**
+		 * Finds particles that are within @p radius of, or behind, any of the provided planes. Indices (relative to
+		 * @p positions) of such particles are written to @p output, which must be able to hold @p count entries. Returns
+		 * the number of found particles.
+		 */
+		static UINT32 findPlaneCollisions(const Vector3* positions, UINT32 count, const Plane* planes, UINT32 numPlanes,
+			float radius, UINT32* output);
+	};
+
+	/** @} */
+}
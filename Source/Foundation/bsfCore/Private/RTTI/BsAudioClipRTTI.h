@@ -44,7 +44,9 @@ namespace bs
 
 		void setData(AudioClip* obj, const SPtr<DataStream>& val, UINT32 size)
 		{
-			obj->mStreamData = val->clone(); // Making sure that the AudioClip cannot modify the source stream, which is still used by the deserializer
+			// Making sure that the AudioClip cannot modify the source stream, which is still used by the deserializer. Data
+			// in memory mapped streams is referenced directly, as the clone keeps the mapping alive.
+			obj->mStreamData = val->clone(!val->isMemoryMapped());
 			obj->mStreamSize = size;
 			obj->mStreamOffset = (UINT32)val->tell();
 		}
@@ -41,6 +41,13 @@ namespace bs
 
 		void setData(MeshData* obj, const SPtr<DataStream>& value, UINT32 size)
 		{
+			// Reference the data directly if loading from a memory mapped file
+			if(value->isMemoryMapped())
+			{
+				obj->setMappedBuffer(std::static_pointer_cast<MemoryMappedDataStream>(value));
+				return;
+			}
+
 			obj->allocateInternalBuffer(size);
 			value->read(obj->getData(), size);
 		}
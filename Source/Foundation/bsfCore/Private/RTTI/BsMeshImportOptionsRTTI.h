@@ -30,6 +30,10 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(reduceKeyFrames, 9)
 			BS_RTTI_MEMBER_REFL_ARRAY(animationEvents, 10)
 			BS_RTTI_MEMBER_PLAIN(importRootMotion, 11)
+			BS_RTTI_MEMBER_PLAIN(compressAnimation, 12)
+			BS_RTTI_MEMBER_PLAIN(animationPositionError, 13)
+			BS_RTTI_MEMBER_PLAIN(animationRotationError, 14)
+			BS_RTTI_MEMBER_PLAIN(animationScaleError, 15)
 		BS_END_RTTI_MEMBERS
 	public:
 		const String& getRTTIName() override
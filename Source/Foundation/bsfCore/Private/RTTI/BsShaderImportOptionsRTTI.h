@@ -18,6 +18,8 @@ namespace bs
 	private:
 		BS_BEGIN_RTTI_MEMBERS
 			BS_RTTI_MEMBER_PLAIN(languages, 1)
+			BS_RTTI_MEMBER_PLAIN(useCompileCache, 2)
+			BS_RTTI_MEMBER_PLAIN(compileCacheFolder, 3)
 		BS_END_RTTI_MEMBERS
 
 		std::pair<String, String>& getDefinePair(ShaderImportOptions* obj, UINT32 idx)
@@ -0,0 +1,160 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Scene/BsSceneTransformPass.h"
+#include "Private/Animation/BsSkeletonKernels.h"
+#include "Scene/BsSceneObject.h"
+#include "Threading/BsTaskScheduler.h"
+
+namespace bs
+{
+	/** Number of objects whose matrices are built at once by the SIMD kernel. */
+	static constexpr UINT32 BATCH_SIZE = 64;
+
+	static_assert(BATCH_SIZE % SkeletonKernels::SIMD_WIDTH == 0, "Batch size must be a multiple of the SIMD width.");
+
+	/** Minimum number of objects in a level for the level to be split across the task scheduler. */
+	static constexpr UINT32 PARALLEL_THRESHOLD = 1024;
+
+	/** Maximum number of objects processed by a single task. */
+	static constexpr UINT32 PARALLEL_GRANULARITY = 256;
+
+	SceneObject* SceneTransformPass::getParent(const SceneObject* so)
+	{
+		// Accessing the member directly avoids copying the handle, which would touch its reference count from workers
+		const HSceneObject& parent = so->mParent;
+		return !parent.isDestroyed() ? parent.get() : nullptr;
+	}
+
+	void SceneTransformPass::update(const Vector<HSceneObject>& roots)
+	{
+		mObjects.clear();
+		mLevelOffsets.clear();
+		mFrontier.clear();
+
+		// Mark all roots first, so roots nested under other roots can be found by walking up their parents
+		for (auto& entry : roots)
+		{
+			if (!entry.isDestroyed())
+				entry->mWorldTfrmQueued = true;
+		}
+
+		for (auto& entry : roots)
+		{
+			if (entry.isDestroyed())
+				continue;
+
+			bool hasQueuedAncestor = false;
+			for (SceneObject* parent = getParent(entry.get()); parent != nullptr; parent = getParent(parent))
+			{
+				if (parent->mWorldTfrmQueued)
+				{
+					hasQueuedAncestor = true;
+					break;
+				}
+			}
+
+			if (hasQueuedAncestor)
+				continue;
+
+			// Parents of the roots are outside of the pass, so make sure they're up to date before workers read them
+			SceneObject* parent = getParent(entry.get());
+			if (parent != nullptr)
+				parent->updateTransformsIfDirty();
+
+			mFrontier.push_back(entry.get());
+		}
+
+		for (auto& entry : roots)
+		{
+			if (!entry.isDestroyed())
+				entry->mWorldTfrmQueued = false;
+		}
+
+		// Flatten the hierarchies breadth first, so each level only depends on the levels before it. Clean objects are
+		// still visited since their descendants can be dirty (e.g. immovable objects are never marked dirty).
+		while (!mFrontier.empty())
+		{
+			mLevelOffsets.push_back((UINT32)mObjects.size());
+
+			mNextFrontier.clear();
+			for (auto& so : mFrontier)
+			{
+				if (!so->isCachedWorldTfrmUpToDate())
+					mObjects.push_back(so);
+
+				for (auto& child : so->mChildren)
+					mNextFrontier.push_back(child.get());
+			}
+
+			std::swap(mFrontier, mNextFrontier);
+		}
+
+		mLevelOffsets.push_back((UINT32)mObjects.size());
+
+		const bool canRunInParallel = TaskScheduler::isStarted();
+		for (UINT32 i = 0; i < (UINT32)mLevelOffsets.size() - 1; i++)
+		{
+			SceneObject* const* levelObjects = mObjects.data() + mLevelOffsets[i];
+			const UINT32 numLevelObjects = mLevelOffsets[i + 1] - mLevelOffsets[i];
+
+			if (numLevelObjects >= PARALLEL_THRESHOLD && canRunInParallel)
+			{
+				TaskScheduler::instance().parallelFor("SceneTransformPass", numLevelObjects, PARALLEL_GRANULARITY,
+					[levelObjects](UINT32 start, UINT32 end)
+				{
+					updateObjects(levelObjects + start, end - start);
+				});
+			}
+			else
+				updateObjects(levelObjects, numLevelObjects);
+		}
+	}
+
+	void SceneTransformPass::updateObjects(SceneObject* const* objects, UINT32 count)
+	{
+		// Three position, four rotation and three scale components per object
+		alignas(16) float poseBuffer[BATCH_SIZE * 10];
+		Matrix4 matrices[BATCH_SIZE];
+
+		for (UINT32 i = 0; i < count; i += BATCH_SIZE)
+		{
+			const UINT32 numBatchObjects = std::min(BATCH_SIZE, count - i);
+
+			SoABonePose pose;
+			SkeletonKernels::initPose(pose, poseBuffer, numBatchObjects);
+
+			// Same as SceneObject::updateWorldTfrm(), except the matrices are built together below
+			for (UINT32 j = 0; j < numBatchObjects; j++)
+			{
+				SceneObject* so = objects[i + j];
+				so->mWorldTfrm = so->mLocalTfrm;
+
+				const SceneObject* parent = getParent(so);
+				if (parent != nullptr && so->mMobility == ObjectMobility::Movable)
+					so->mWorldTfrm.makeWorld(parent->mWorldTfrm);
+
+				const Vector3& position = so->mWorldTfrm.getPosition();
+				const Quaternion& rotation = so->mWorldTfrm.getRotation();
+				const Vector3& scale = so->mWorldTfrm.getScale();
+
+				for (UINT32 k = 0; k < 3; k++)
+				{
+					pose.positions[k][j] = position[k];
+					pose.scales[k][j] = scale[k];
+				}
+
+				for (UINT32 k = 0; k < 4; k++)
+					pose.rotations[k][j] = rotation[k];
+			}
+
+			SkeletonKernels::calculateLocalTransforms(pose, nullptr, matrices, numBatchObjects);
+
+			for (UINT32 j = 0; j < numBatchObjects; j++)
+			{
+				SceneObject* so = objects[i + j];
+				so->mCachedWorldTfrm = matrices[j];
+				so->mDirtyFlags &= ~SceneObject::DirtyFlags::WorldTfrmDirty;
+			}
+		}
+	}
+}
@@ -0,0 +1,46 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Scene-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Updates cached world transforms of scene objects in an explicit pass, rather than lazily when they are first
+	 * accessed. Dirty objects in the provided hierarchies are flattened into levels by their depth, so every object is
+	 * processed after its parent. Objects within a level are independent and large levels are split across the task
+	 * scheduler, while transform matrices are built using SIMD.
+	 */
+	class BS_CORE_EXPORT SceneTransformPass
+	{
+	public:
+		/**
+		 * Updates the world transforms of all the dirty objects in the hierarchies under @p roots, including the
+		 * roots. Roots that are descendants of other provided roots are skipped, as they get updated along with their
+		 * ancestor.
+		 *
+		 * @note	Sim thread only. Transforms of the objects must not be accessed from other threads during the
+		 *			update.
+		 */
+		void update(const Vector<HSceneObject>& roots);
+
+	private:
+		/** Returns the parent of the scene object, or null if it has none. */
+		static SceneObject* getParent(const SceneObject* so);
+
+		/** Updates the world transforms of a range of objects whose parents have already been updated. */
+		static void updateObjects(SceneObject* const* objects, UINT32 count);
+
+		Vector<SceneObject*> mObjects;
+		Vector<UINT32> mLevelOffsets;
+		Vector<SceneObject*> mFrontier;
+		Vector<SceneObject*> mNextFrontier;
+	};
+
+	/** @} */
+}
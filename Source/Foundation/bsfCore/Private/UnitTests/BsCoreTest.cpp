@@ -3,7 +3,50 @@
 #include "Testing/BsConsoleTestOutput.h"
 #include "Testing/BsTestSuite.h"
 #include "Animation/BsAnimationCurve.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsCompressedAnimationCurves.h"
+#include "Animation/BsAnimationUtility.h"
+#include "Animation/BsSkeleton.h"
+#include "Animation/BsSkeletonMask.h"
+#include "Animation/BsAnimation.h"
+#include "Animation/BsAnimationManager.h"
 #include "Particles/BsParticleDistribution.h"
+#include "Private/Particles/BsParticleKernels.h"
+#include "Private/Animation/BsSkeletonKernels.h"
+#include "Math/BsRandom.h"
+#include "Math/BsQuaternion.h"
+#include "Utility/BsTime.h"
+#include "Profiling/BsProfilerCPU.h"
+#include "FileSystem/BsDataStream.h"
+#include "FileSystem/BsFileSystem.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "Serialization/BsFileSerializer.h"
+#include "Scene/BsGameObjectManager.h"
+#include "Scene/BsSceneObject.h"
+#include "Scene/BsSceneManager.h"
+#include "Scene/BsSceneActor.h"
+#include "Physics/BsPhysics.h"
+#include "Private/Scene/BsSceneTransformPass.h"
+#include "Image/BsPixelUtil.h"
+#include "Image/BsColor.h"
+#include "Private/Image/BsPixelConversionKernels.h"
+#include "Private/Image/BsBCDecompressionKernels.h"
+#include "CoreThread/BsCoreThread.h"
+#include "CoreThread/BsCoreObject.h"
+#include "CoreThread/BsCoreObjectManager.h"
+#include "CoreThread/BsCoreObjectCore.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Threading/BsThreadPool.h"
+#include "Managers/BsHardwareBufferManager.h"
+#include "Profiling/BsRenderStats.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+#include "RenderAPI/BsGpuParamBlockBufferPool.h"
+#include "RenderAPI/BsHardwareBuffer.h"
+#include "RenderAPI/BsRenderAPICapabilities.h"
+#include "Resources/BsResources.h"
+#include "Resources/BsResource.h"
+#include "Managers/BsResourceListenerManager.h"
+#include "Reflection/BsRTTIType.h"
 
 namespace bs
 {
@@ -17,20 +60,347 @@ namespace bs
 		return acceleration * time;
 	}
 
+	/** Game object without any components or hierarchy, used for testing the GameObjectManager. */
+	class TestGameObject : public GameObject
+	{
+	protected:
+		void destroyInternal(GameObjectHandleBase& handle, bool immediate) override
+		{
+			if(immediate)
+				GameObjectManager::instance().unregisterObject(handle);
+			else
+				GameObjectManager::instance().queueForDestroy(handle);
+		}
+	};
+
+	/** Physics implementation that creates no physics objects. Required by the SceneManager, which creates a scene. */
+	class TestPhysics : public Physics
+	{
+	public:
+		TestPhysics(const PHYSICS_INIT_DESC& desc)
+			:Physics(desc)
+		{ }
+
+		void setPaused(bool paused) override { }
+
+		SPtr<PhysicsMaterial> createMaterial(float staticFriction, float dynamicFriction, float restitution) override
+		{
+			return nullptr;
+		}
+
+		SPtr<PhysicsMesh> createMesh(const SPtr<MeshData>& meshData, PhysicsMeshType type) override { return nullptr; }
+		SPtr<PhysicsScene> createPhysicsScene() override { return nullptr; }
+		void fixedUpdate(float step) override { }
+
+		bool _rayCast(const Vector3& origin, const Vector3& unitDir, const Collider& collider, PhysicsQueryHit& hit,
+			float maxDist = FLT_MAX) const override { return false; }
+	};
+
+	/** Scene actor that counts how many times its state was updated from the scene object it is bound to. */
+	class TestSceneActor : public SceneActor
+	{
+	public:
+		void _updateState(const SceneObject& so, bool force = false) override
+		{
+			numUpdates++;
+			SceneActor::_updateState(so, force);
+		}
+
+		UINT32 numUpdates = 0;
+	};
+
+	/** Core object that queues a large number of core thread commands while its sync data is being generated. */
+	class TestQueueFloodCoreObject : public CoreObject
+	{
+	public:
+		/** Number of commands to queue, enough to overflow the sim thread command queue. */
+		static constexpr UINT32 NUM_COMMANDS = CommandRingQueue::DEFAULT_CAPACITY / 128;
+
+		TestQueueFloodCoreObject()
+			:CoreObject(false)
+		{ }
+
+		/** Marks the object as dirty, so the next sync calls syncToCore(). */
+		void markDirty() { markCoreDirty(); }
+
+		std::atomic<bool> syncStarted{false};
+		std::atomic<UINT32> numExecuted{0};
+		std::atomic<bool> inOrder{true};
+
+	protected:
+		SPtr<ct::CoreObject> createCore() const override
+		{
+			SPtr<ct::CoreObject> core = bs_shared_ptr_new<ct::CoreObject>();
+			core->_setThisPtr(core);
+
+			return core;
+		}
+
+		CoreSyncData syncToCore(FrameAlloc* allocator) override
+		{
+			syncStarted = true;
+
+			for(UINT32 i = 0; i < NUM_COMMANDS; i++)
+			{
+				// Large enough payload for the commands to take up multiple times the queue capacity
+				std::array<UINT32, 56> payload;
+				payload.fill(i);
+
+				gCoreThread().queueCommand([this, payload]()
+				{
+					if(numExecuted++ != payload[0])
+						inOrder = false;
+				});
+			}
+
+			return CoreSyncData();
+		}
+	};
+
+	/** Resource with a value and references to other resources, used for testing resource loading. */
+	class TestResource : public Resource
+	{
+	public:
+		TestResource()
+			:Resource(false)
+		{ }
+
+		/** Creates a new resource and a handle for it. */
+		static HResource create(UINT32 value, const Vector<HResource>& dependencies = {})
+		{
+			SPtr<TestResource> resource = _createPtr();
+			resource->value = value;
+			resource->dependencies = dependencies;
+
+			return gResources()._createResourceHandle(resource);
+		}
+
+		/** Creates a new resource without a handle. */
+		static SPtr<TestResource> _createPtr()
+		{
+			SPtr<TestResource> resource = bs_core_ptr<TestResource>(new (bs_alloc<TestResource>()) TestResource());
+			resource->_setThisPtr(resource);
+			resource->initialize();
+
+			return resource;
+		}
+
+		UINT32 value = 0;
+		Vector<HResource> dependencies;
+
+		friend class TestResourceRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	class TestResourceRTTI : public RTTIType<TestResource, Resource, TestResourceRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(value, 0)
+			BS_RTTI_MEMBER_REFL_ARRAY(dependencies, 1)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "TestResource";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return 60100;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return TestResource::_createPtr();
+		}
+	};
+
+	RTTITypeBase* TestResource::getRTTIStatic()
+	{
+		return TestResourceRTTI::instance();
+	}
+
+	RTTITypeBase* TestResource::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+
+	namespace ct
+	{
+	/** Hardware buffer that only counts the writes made to it. */
+	class TestHardwareBuffer : public HardwareBuffer
+	{
+	public:
+		TestHardwareBuffer(UINT32 size)
+			:HardwareBuffer(size, GBU_DYNAMIC, GDF_DEFAULT)
+		{ }
+
+		void readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx = 0, UINT32 queueIdx = 0) override { }
+
+		void writeData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags = BWT_NORMAL,
+			UINT32 queueIdx = 0) override
+		{
+			numWrites++;
+		}
+
+		void copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length,
+			bool discardWholeBuffer = false, const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		UINT32 numWrites = 0;
+	};
+
+	/** Parameter block buffer backed by a TestHardwareBuffer. */
+	class TestGpuParamBlockBuffer : public GpuParamBlockBuffer
+	{
+	public:
+		TestGpuParamBlockBuffer(UINT32 size)
+			:GpuParamBlockBuffer(size, GBU_DYNAMIC, GDF_DEFAULT)
+		{ }
+
+		TestGpuParamBlockBuffer(const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size)
+			:GpuParamBlockBuffer(parent, offset, size)
+		{ }
+
+		~TestGpuParamBlockBuffer()
+		{
+			if(mParentBuffer == nullptr)
+				bs_delete(static_cast<TestHardwareBuffer*>(mBuffer));
+		}
+
+		/** Returns the number of writes made to the hardware buffer, shared with the parent buffer for ranges. */
+		UINT32 getNumWrites() const { return static_cast<TestHardwareBuffer*>(mBuffer)->numWrites; }
+
+	protected:
+		void initialize() override
+		{
+			if(mParentBuffer == nullptr)
+				mBuffer = bs_new<TestHardwareBuffer>(mSize);
+
+			GpuParamBlockBuffer::initialize();
+		}
+	};
+
+	/** Creates test parameter block buffers. Ranges are only created if @p supportsRanges is set. */
+	class TestHardwareBufferManager : public HardwareBufferManager
+	{
+	public:
+		bool supportsRanges = true;
+
+	protected:
+		SPtr<VertexBuffer> createVertexBufferInternal(const VERTEX_BUFFER_DESC& desc,
+			GpuDeviceFlags deviceMask = GDF_DEFAULT) override { return nullptr; }
+
+		SPtr<IndexBuffer> createIndexBufferInternal(const INDEX_BUFFER_DESC& desc,
+			GpuDeviceFlags deviceMask = GDF_DEFAULT) override { return nullptr; }
+
+		SPtr<GpuParamBlockBuffer> createGpuParamBlockBufferInternal(UINT32 size,
+			GpuBufferUsage usage = GBU_DYNAMIC, GpuDeviceFlags deviceMask = GDF_DEFAULT) override
+		{
+			SPtr<GpuParamBlockBuffer> buffer = bs_shared_ptr_new<TestGpuParamBlockBuffer>(size);
+			buffer->_setThisPtr(buffer);
+
+			return buffer;
+		}
+
+		SPtr<GpuParamBlockBuffer> createGpuParamBlockBufferRangeInternal(const SPtr<GpuParamBlockBuffer>& parent,
+			UINT32 offset, UINT32 size) override
+		{
+			if(!supportsRanges)
+				return HardwareBufferManager::createGpuParamBlockBufferRangeInternal(parent, offset, size);
+
+			SPtr<GpuParamBlockBuffer> buffer = bs_shared_ptr_new<TestGpuParamBlockBuffer>(parent, offset, size);
+			buffer->_setThisPtr(buffer);
+
+			return buffer;
+		}
+
+		SPtr<GpuBuffer> createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
+			GpuDeviceFlags deviceMask = GDF_DEFAULT) override { return nullptr; }
+
+		SPtr<GpuBuffer> createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
+			SPtr<HardwareBuffer> underlyingBuffer) override { return nullptr; }
+	};
+	}
+
 	class CoreTestSuite : public TestSuite
 	{
 	public:
 		CoreTestSuite();
 
+		void startUp() override;
+		void shutDown() override;
+
 	private:
 		void testAnimCurveIntegration();
 		void testLookupTable();
+		void testProfilerTrace();
+		void testParticleKernels();
+		void testCompressedAnimationCurves();
+		void testSkeletonKernels();
+		void testSkeletonMask();
+		void testAnimationBatches();
+		void testGameObjectManager();
+		void testSceneTransformPass();
+		void testSceneActorBinding();
+		void testPixelConversionKernels();
+		void testBCDecompression();
+		void testMappedPixelData();
+		void testCommandQueueOverflow();
+		void testGpuParamBlockBufferPool();
+		void testResourceLoading();
 	};
 
+	void CoreTestSuite::startUp()
+	{
+		// Modules cannot be restarted, so modules needed by more than one test are shared by all tests
+		GameObjectManager::startUp();
+		// Tests can occupy every task scheduler worker at once, on top of the core thread
+		ThreadPool::startUp<TThreadPool<>>(BS_THREAD_HARDWARE_CONCURRENCY, BS_THREAD_HARDWARE_CONCURRENCY + 16);
+		TaskScheduler::startUp();
+		CoreObjectManager::startUp();
+		CoreThread::startUp();
+		Resources::startUp();
+		ResourceListenerManager::startUp();
+		Physics::startUp<TestPhysics>(PHYSICS_INIT_DESC());
+		SceneManager::startUp();
+	}
+
+	void CoreTestSuite::shutDown()
+	{
+		SceneManager::shutDown();
+		Physics::shutDown();
+		ResourceListenerManager::shutDown();
+		Resources::shutDown();
+		CoreThread::shutDown();
+		CoreObjectManager::shutDown();
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+		GameObjectManager::shutDown();
+	}
+
 	CoreTestSuite::CoreTestSuite()
 	{
 		BS_ADD_TEST(CoreTestSuite::testAnimCurveIntegration);
 		BS_ADD_TEST(CoreTestSuite::testLookupTable);
+		BS_ADD_TEST(CoreTestSuite::testProfilerTrace);
+		BS_ADD_TEST(CoreTestSuite::testParticleKernels);
+		BS_ADD_TEST(CoreTestSuite::testCompressedAnimationCurves);
+		BS_ADD_TEST(CoreTestSuite::testSkeletonKernels);
+		BS_ADD_TEST(CoreTestSuite::testSkeletonMask);
+		BS_ADD_TEST(CoreTestSuite::testAnimationBatches);
+		BS_ADD_TEST(CoreTestSuite::testGameObjectManager);
+		BS_ADD_TEST(CoreTestSuite::testSceneTransformPass);
+		BS_ADD_TEST(CoreTestSuite::testSceneActorBinding);
+		BS_ADD_TEST(CoreTestSuite::testPixelConversionKernels);
+		BS_ADD_TEST(CoreTestSuite::testBCDecompression);
+		BS_ADD_TEST(CoreTestSuite::testMappedPixelData);
+		BS_ADD_TEST(CoreTestSuite::testCommandQueueOverflow);
+		BS_ADD_TEST(CoreTestSuite::testGpuParamBlockBufferPool);
+		BS_ADD_TEST(CoreTestSuite::testResourceLoading);
 	}
 
 	void CoreTestSuite::testAnimCurveIntegration()
@@ -143,6 +513,1747 @@ namespace bs
 				BS_TEST_ASSERT(Math::approxEquals(valueLookup[j], valueCurve[j], EPSILON));
 		}
 	}
+
+	void CoreTestSuite::testProfilerTrace()
+	{
+		static constexpr UINT32 NUM_SAMPLES = 100;
+
+		const auto countOccurrences = [](const String& string, const char* pattern)
+		{
+			UINT32 count = 0;
+			for(size_t pos = string.find(pattern); pos != String::npos; pos = string.find(pattern, pos + 1))
+				count++;
+
+			return count;
+		};
+
+		ProfilerCPU::startUp();
+		gProfilerCPU().setMode(CPUProfilerMode::Trace);
+
+		// Nested samples, with names that need escaping or truncating
+		gProfilerCPU().beginThread("Test \"thread\"");
+		for(UINT32 i = 0; i < NUM_SAMPLES; i++)
+		{
+			gProfilerCPU().beginSample("Outer");
+			gProfilerCPU().beginSamplePrecise("Inner with a name long enough that it needs to be truncated");
+			gProfilerCPU().endSamplePrecise("Inner with a name long enough that it needs to be truncated");
+			gProfilerCPU().endSample("Outer");
+		}
+
+		// Left open on purpose, should get closed by endThread()
+		gProfilerCPU().beginSample("Unclosed");
+		gProfilerCPU().endThread();
+
+		Thread thread([]()
+		{
+			gProfilerCPU().beginThread("Worker");
+			gProfilerCPU().beginSample("WorkerSample");
+			gProfilerCPU().endSample("WorkerSample");
+			gProfilerCPU().endThread();
+		});
+		thread.join();
+
+		gProfilerCPU().mergeTraceEvents();
+		BS_TEST_ASSERT(gProfilerCPU().getNumTraceEvents() == (NUM_SAMPLES * 4 + 4) + 4);
+		BS_TEST_ASSERT(gProfilerCPU().getNumDroppedTraceEvents() == 0);
+
+		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(1024 * 1024);
+		gProfilerCPU().writeChromeTrace(stream);
+
+		const String trace((const char*)stream->getPtr(), stream->tell());
+		BS_TEST_ASSERT(trace.find("{\"traceEvents\":[") == 0);
+		BS_TEST_ASSERT(trace.find("\"args\":{\"name\":\"Test \\\"thread\\\"\"}") != String::npos);
+		BS_TEST_ASSERT(trace.find("\"args\":{\"name\":\"Worker\"}") != String::npos);
+		BS_TEST_ASSERT(trace.find("\"name\":\"Inner with a name long enough that it needs to \"") != String::npos);
+		BS_TEST_ASSERT(trace.find("\"otherData\":{\"timerOverheadMs\":") != String::npos);
+		BS_TEST_ASSERT(countOccurrences(trace, "\"ph\":\"B\"") == NUM_SAMPLES * 2 + 4);
+		BS_TEST_ASSERT(countOccurrences(trace, "\"ph\":\"E\"") == NUM_SAMPLES * 2 + 4);
+
+		// Overflow the event buffer within a single frame, begin/end events must still match
+		gProfilerCPU().clearTrace();
+		gProfilerCPU().beginThread("Overflow");
+		for(UINT32 i = 0; i < 20000; i++)
+		{
+			gProfilerCPU().beginSample("Outer");
+			gProfilerCPU().beginSample("Inner");
+			gProfilerCPU().endSample("Inner");
+			gProfilerCPU().endSample("Outer");
+		}
+		gProfilerCPU().endThread();
+		gProfilerCPU().mergeTraceEvents();
+
+		const UINT32 numEvents = gProfilerCPU().getNumTraceEvents();
+		BS_TEST_ASSERT(numEvents > 0 && (numEvents % 2) == 0);
+		BS_TEST_ASSERT(numEvents + gProfilerCPU().getNumDroppedTraceEvents() == 20000 * 4 + 2);
+
+		// Reaching the merged trace limit drops whole samples, while samples already in the trace still get closed. Samples
+		// open while the trace is cleared don't get their end events.
+		gProfilerCPU().clearTrace();
+		gProfilerCPU().setMaxTraceEvents(5);
+		gProfilerCPU().beginThread("Limit");
+		gProfilerCPU().beginSample("Cleared");
+		gProfilerCPU().mergeTraceEvents();
+		gProfilerCPU().clearTrace();
+
+		gProfilerCPU().beginSample("Open");
+		for(UINT32 i = 0; i < 10; i++)
+		{
+			gProfilerCPU().beginSample("Sample");
+			gProfilerCPU().endSample("Sample");
+		}
+		gProfilerCPU().endSample("Open");
+		gProfilerCPU().endSample("Cleared");
+		gProfilerCPU().endThread();
+		gProfilerCPU().mergeTraceEvents();
+
+		BS_TEST_ASSERT(gProfilerCPU().getNumTraceEvents() == 6);
+		BS_TEST_ASSERT(gProfilerCPU().getNumDroppedTraceEvents() == 16);
+
+		stream = bs_shared_ptr_new<MemoryDataStream>(1024 * 1024);
+		gProfilerCPU().writeChromeTrace(stream);
+
+		const String limitedTrace((const char*)stream->getPtr(), stream->tell());
+		BS_TEST_ASSERT(countOccurrences(limitedTrace, "\"ph\":\"B\"") == 3);
+		BS_TEST_ASSERT(countOccurrences(limitedTrace, "\"ph\":\"E\"") == 3);
+		BS_TEST_ASSERT(limitedTrace.find("\"droppedEvents\":16}") != String::npos);
+
+		gProfilerCPU().reset();
+		ProfilerCPU::shutDown();
+	}
+
+	void CoreTestSuite::testParticleKernels()
+	{
+		// Not a multiple of the SIMD width, so the scalar remainder is tested as well
+		static constexpr UINT32 NUM_PARTICLES = 1023;
+
+		Random random(1234);
+		Vector<Vector3> positions(NUM_PARTICLES);
+		Vector<Vector3> velocities(NUM_PARTICLES);
+		Vector<float> initialLifetimes(NUM_PARTICLES);
+		Vector<float> lifetimes(NUM_PARTICLES);
+
+		for(UINT32 i = 0; i < NUM_PARTICLES; i++)
+		{
+			positions[i] = Vector3(random.getSNorm(), random.getSNorm(), random.getSNorm()) * 50.0f;
+			velocities[i] = Vector3(random.getSNorm(), random.getSNorm(), random.getSNorm()) * 10.0f;
+			initialLifetimes[i] = 1.0f + random.getUNorm() * 4.0f;
+			lifetimes[i] = initialLifetimes[i] * random.getUNorm();
+		}
+
+		const Vector3 offset(0.1f, -0.981f, 0.3f);
+		const float timeStep = 1.0f / 60.0f;
+
+		// Kernels must produce the exact same results as the per-particle code they replace
+		Vector<Vector3> simdVectors = positions;
+		ParticleKernels::add(simdVectors.data(), offset, NUM_PARTICLES);
+		for(UINT32 i = 0; i < NUM_PARTICLES; i++)
+			BS_TEST_ASSERT(simdVectors[i] == positions[i] + offset);
+
+		simdVectors = positions;
+		ParticleKernels::addScaled(simdVectors.data(), velocities.data(), timeStep, NUM_PARTICLES);
+		for(UINT32 i = 0; i < NUM_PARTICLES; i++)
+			BS_TEST_ASSERT(simdVectors[i] == positions[i] + velocities[i] * timeStep);
+
+		Vector<float> simdFloats = lifetimes;
+		ParticleKernels::subtract(simdFloats.data(), timeStep, NUM_PARTICLES);
+		for(UINT32 i = 0; i < NUM_PARTICLES; i++)
+			BS_TEST_ASSERT(simdFloats[i] == lifetimes[i] - timeStep);
+
+		ParticleKernels::normalizedAge(initialLifetimes.data(), lifetimes.data(), simdFloats.data(), NUM_PARTICLES);
+		for(UINT32 i = 0; i < NUM_PARTICLES; i++)
+			BS_TEST_ASSERT(simdFloats[i] == (initialLifetimes[i] - lifetimes[i]) / initialLifetimes[i]);
+
+		Matrix4 tfrm;
+		tfrm.setTRS(Vector3(1.0f, 2.0f, 3.0f), Quaternion(Degree(10.0f), Degree(20.0f), Degree(30.0f)),
+			Vector3(1.0f, 2.0f, 0.5f));
+
+		simdVectors = positions;
+		ParticleKernels::transformPoints(simdVectors.data(), tfrm, NUM_PARTICLES);
+		for(UINT32 i = 0; i < NUM_PARTICLES; i++)
+			BS_TEST_ASSERT(simdVectors[i] == tfrm.multiplyAffine(positions[i]));
+
+		simdVectors = velocities;
+		ParticleKernels::transformDirections(simdVectors.data(), tfrm, NUM_PARTICLES);
+		for(UINT32 i = 0; i < NUM_PARTICLES; i++)
+			BS_TEST_ASSERT(simdVectors[i] == tfrm.multiplyDirection(velocities[i]));
+
+		const Plane planes[] =
+		{
+			Plane(Vector3::UNIT_Y, Vector3(0.0f, -30.0f, 0.0f)),
+			Plane(-Vector3::UNIT_X, Vector3(40.0f, 0.0f, 0.0f))
+		};
+
+		static constexpr float RADIUS = 0.5f;
+		Vector<UINT32> candidates(NUM_PARTICLES);
+		const UINT32 numCandidates = ParticleKernels::findPlaneCollisions(positions.data(), NUM_PARTICLES, planes,
+			(UINT32)bs_size(planes), RADIUS, candidates.data());
+
+		UINT32 candidateIdx = 0;
+		for(UINT32 i = 0; i < NUM_PARTICLES; i++)
+		{
+			bool expected = false;
+			for(auto& plane : planes)
+				expected |= plane.getDistance(positions[i]) <= RADIUS;
+
+			if(expected)
+			{
+				BS_TEST_ASSERT(candidateIdx < numCandidates && candidates[candidateIdx] == i);
+				candidateIdx++;
+			}
+		}
+
+		BS_TEST_ASSERT(candidateIdx == numCandidates && numCandidates > 0);
+	}
+
+	void CoreTestSuite::testCompressedAnimationCurves()
+	{
+		static constexpr UINT32 NUM_KEYS = 61;
+		static constexpr float LENGTH = 2.0f;
+
+		// Densely sampled curves, similar to imported animation
+		Vector<TKeyframe<Vector3>> positionKeys(NUM_KEYS);
+		Vector<TKeyframe<Quaternion>> rotationKeys(NUM_KEYS);
+		Vector<TKeyframe<Vector3>> scaleKeys(NUM_KEYS);
+		for(UINT32 i = 0; i < NUM_KEYS; i++)
+		{
+			const float time = i * LENGTH / (NUM_KEYS - 1);
+			const float angle = time * Math::PI;
+
+			positionKeys[i] = { Vector3(std::sin(angle), time * 0.5f, 1.0f), Vector3::ZERO, Vector3::ZERO, time };
+			positionKeys[i].inTangent = positionKeys[i].outTangent =
+				Vector3(std::cos(angle) * Math::PI, 0.5f, 0.0f);
+
+			const Quaternion rotation(Radian(angle * 0.5f), Radian(angle), Radian(0.3f));
+			rotationKeys[i] = { rotation, Quaternion::ZERO, Quaternion::ZERO, time };
+			scaleKeys[i] = { Vector3::ONE, Vector3::ZERO, Vector3::ZERO, time };
+		}
+
+		AnimationUtility::calculateTangents(rotationKeys);
+
+		AnimationCurves curves;
+		curves.addPositionCurve("bone0", TAnimationCurve<Vector3>(positionKeys));
+		curves.addRotationCurve("bone0", TAnimationCurve<Quaternion>(rotationKeys));
+		curves.addScaleCurve("bone0", TAnimationCurve<Vector3>(scaleKeys));
+		curves.addPositionCurve("bone1", TAnimationCurve<Vector3>({ { Vector3::ONE, Vector3::ZERO, Vector3::ZERO, 0.0f } }));
+
+		AnimationCompressionSettings settings;
+		SPtr<CompressedAnimationCurves> compressed = CompressedAnimationCurves::create(curves, settings);
+		BS_TEST_ASSERT(compressed != nullptr);
+
+		// Linear keys need to be denser than the original hermite keys to stay within the tolerance, but they are much
+		// smaller
+		const UINT32 originalSize = NUM_KEYS * (sizeof(TKeyframe<Vector3>) * 2 + sizeof(TKeyframe<Quaternion>));
+		BS_TEST_ASSERT(compressed->getMemorySize() < originalSize / 2);
+		BS_TEST_ASSERT(compressed->getTimeRange().second == LENGTH);
+
+		auto verify = [&](float time, const CompressedCurveCache& cache)
+		{
+			compressed->evaluate(time, true, cache);
+
+			const Vector3 position = curves.position[0].curve.evaluate(time, true);
+			BS_TEST_ASSERT(cache.getPositions()[0].distance(position) <= settings.positionError);
+			BS_TEST_ASSERT(cache.getPositions()[1].distance(Vector3::ONE) <= settings.positionError);
+
+			Quaternion rotation = curves.rotation[0].curve.evaluate(time, true);
+			rotation.normalize();
+
+			// Angle between the rotations, calculated from their distance since acos() is imprecise for small angles
+			const Quaternion& value = cache.getRotations()[0];
+			const Quaternion diff = value.dot(rotation) < 0.0f ? value + rotation : value - rotation;
+			const float angle = 4.0f * Math::asin(std::min(1.0f, std::sqrt(diff.dot(diff)) * 0.5f)).valueRadians();
+			BS_TEST_ASSERT(angle <= settings.rotationError);
+
+			const Vector3 scaleDiff = cache.getScales()[0] - Vector3::ONE;
+			BS_TEST_ASSERT(std::max(std::max(Math::abs(scaleDiff.x), Math::abs(scaleDiff.y)), Math::abs(scaleDiff.z)) <=
+				settings.scaleError);
+		};
+
+		// Sequential playback, including looping past the end
+		CompressedCurveCache sequentialCache;
+		for(float time = 0.0f; time < LENGTH * 2.5f; time += 1.0f / 60.0f)
+			verify(time, sequentialCache);
+
+		// Random access
+		Random random(1234);
+		CompressedCurveCache randomCache;
+		for(UINT32 i = 0; i < 200; i++)
+			verify(random.getUNorm() * LENGTH, randomCache);
+	}
+
+	void CoreTestSuite::testSkeletonKernels()
+	{
+		// Not a multiple of the SIMD width, so the padding is tested as well
+		static constexpr UINT32 NUM_BONES = 37;
+		static constexpr float EPSILON = 0.00001f;
+
+		Random random(1234);
+		const auto randomVector = [&random]()
+		{
+			return Vector3(random.getSNorm(), random.getSNorm(), random.getSNorm()) * 2.0f;
+		};
+
+		const auto randomRotation = [&random]()
+		{
+			return Quaternion(Degree(random.getSNorm() * 180.0f), Degree(random.getSNorm() * 180.0f),
+				Degree(random.getSNorm() * 180.0f));
+		};
+
+		Vector<Vector3> positions(NUM_BONES), scales(NUM_BONES), valuePositions(NUM_BONES), valueScales(NUM_BONES);
+		Vector<Quaternion> rotations(NUM_BONES), valueRotations(NUM_BONES);
+		Vector<float> weights(NUM_BONES + SkeletonKernels::SIMD_WIDTH, 0.0f);
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			positions[i] = randomVector();
+			scales[i] = randomVector();
+			valuePositions[i] = randomVector();
+			valueScales[i] = randomVector();
+
+			// Unassigned rotations are handled separately by the kernels
+			rotations[i] = (i % 5) == 0 ? Quaternion::ZERO : randomRotation() * (0.5f + random.getUNorm());
+			valueRotations[i] = randomRotation();
+
+			// Bones without a curve have zero weight
+			weights[i] = (i % 3) == 0 ? 0.0f : random.getUNorm();
+		}
+
+		const UINT32 poseSize = SkeletonKernels::getPoseSize(NUM_BONES);
+		Vector<float> buffer(poseSize * 2);
+
+		SoABonePose pose, values;
+		SkeletonKernels::initPose(pose, buffer.data(), NUM_BONES);
+		SkeletonKernels::initPose(values, buffer.data() + poseSize, NUM_BONES);
+
+		const auto setPose = [](const SoABonePose& dst, const Vector<Vector3>& positions,
+			const Vector<Quaternion>& rotations, const Vector<Vector3>& scales)
+		{
+			for(UINT32 i = 0; i < NUM_BONES; i++)
+			{
+				for(UINT32 j = 0; j < 3; j++)
+				{
+					dst.positions[j][i] = positions[i][j];
+					dst.scales[j][i] = scales[i][j];
+				}
+
+				for(UINT32 j = 0; j < 4; j++)
+					dst.rotations[j][i] = rotations[i][j];
+			}
+		};
+
+		setPose(pose, positions, rotations, scales);
+		setPose(values, valuePositions, valueRotations, valueScales);
+
+		// Blend the same values using scalar code, the same way Skeleton::getPose() used to
+		Vector<Vector3> expectedPositions = positions;
+		Vector<Vector3> expectedScales = scales;
+		Vector<Quaternion> expectedRotations = rotations;
+		Vector<Quaternion> expectedAdditiveRotations = rotations;
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			const float weight = weights[i];
+
+			expectedPositions[i] += valuePositions[i] * weight;
+
+			if(weight == 0.0f)
+				continue;
+
+			expectedScales[i] *= valueScales[i] * weight;
+
+			Quaternion value = valueRotations[i] * weight;
+			if(value.dot(expectedRotations[i]) < 0.0f)
+				value = -value;
+
+			expectedRotations[i] += value;
+
+			if(expectedAdditiveRotations[i].w == 0.0f)
+				expectedAdditiveRotations[i] = Quaternion::IDENTITY;
+
+			expectedAdditiveRotations[i] *= Quaternion::lerp(weight, Quaternion::IDENTITY, valueRotations[i]);
+		}
+
+		Vector<Vector3> outputPositions(NUM_BONES), outputScales(NUM_BONES);
+		Vector<Quaternion> outputRotations(NUM_BONES);
+
+		SkeletonKernels::blendPositions(pose, values, weights.data(), NUM_BONES);
+		SkeletonKernels::blendScales(pose, values, weights.data(), NUM_BONES);
+		SkeletonKernels::blendRotations(pose, values, weights.data(), NUM_BONES);
+		SkeletonKernels::storePose(pose, outputPositions.data(), outputRotations.data(), outputScales.data(),
+			NUM_BONES);
+
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			BS_TEST_ASSERT(Math::approxEquals(outputPositions[i], expectedPositions[i], EPSILON));
+			BS_TEST_ASSERT(Math::approxEquals(outputScales[i], expectedScales[i], EPSILON));
+			BS_TEST_ASSERT(Math::approxEquals(outputRotations[i], expectedRotations[i], EPSILON));
+		}
+
+		setPose(pose, positions, rotations, scales);
+		SkeletonKernels::blendRotationsAdditive(pose, values, weights.data(), NUM_BONES);
+		SkeletonKernels::storePose(pose, outputPositions.data(), outputRotations.data(), outputScales.data(),
+			NUM_BONES);
+
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+			BS_TEST_ASSERT(Math::approxEquals(outputRotations[i], expectedAdditiveRotations[i], EPSILON));
+
+		// Normalization and local transforms
+		setPose(pose, positions, rotations, scales);
+		SkeletonKernels::normalizeRotations(pose, NUM_BONES);
+		SkeletonKernels::storePose(pose, outputPositions.data(), outputRotations.data(), outputScales.data(),
+			NUM_BONES);
+
+		bool skip[NUM_BONES];
+		Vector<Matrix4> transforms(NUM_BONES, Matrix4::ZERO);
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+			skip[i] = (i % 7) == 0;
+
+		SkeletonKernels::calculateLocalTransforms(pose, skip, transforms.data(), NUM_BONES);
+
+		const auto matrixEquals = [](const Matrix4& a, const Matrix4& b)
+		{
+			for(UINT32 row = 0; row < 4; row++)
+			{
+				if(!Math::approxEquals(a[row], b[row], EPSILON))
+					return false;
+			}
+
+			return true;
+		};
+
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			Quaternion expectedRotation = rotations[i];
+			if(expectedRotation.w == 0.0f)
+				expectedRotation = Quaternion::IDENTITY;
+			else
+				expectedRotation.normalize();
+
+			BS_TEST_ASSERT(Math::approxEquals(outputRotations[i], expectedRotation, EPSILON));
+
+			if(skip[i])
+			{
+				BS_TEST_ASSERT(transforms[i] == Matrix4::ZERO);
+			}
+			else
+			{
+				const Matrix4 expected = Matrix4::TRS(positions[i], expectedRotation, scales[i]);
+				BS_TEST_ASSERT(matrixEquals(transforms[i], expected));
+			}
+		}
+
+		// Affine matrix multiplication, including in-place
+		Vector<Matrix4> lhs(NUM_BONES), rhs(NUM_BONES), products(NUM_BONES);
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			lhs[i] = Matrix4::TRS(randomVector(), randomRotation(), randomVector());
+			rhs[i] = Matrix4::TRS(randomVector(), randomRotation(), randomVector());
+		}
+
+		SkeletonKernels::multiplyAffine(lhs.data(), rhs.data(), products.data(), NUM_BONES);
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+			BS_TEST_ASSERT(matrixEquals(products[i], lhs[i] * rhs[i]));
+
+		Matrix4 inPlace = lhs[0];
+		SkeletonKernels::multiplyAffine(inPlace, rhs[0], inPlace);
+		BS_TEST_ASSERT(matrixEquals(inPlace, lhs[0] * rhs[0]));
+	}
+
+	void CoreTestSuite::testSkeletonMask()
+	{
+		// Bones are intentionally not ordered parent first. Levels (longest path to a leaf): finger 1, hand 2, arm 3,
+		// head 1, spine 4, leg 1, root 5.
+		struct BoneHierarchyEntry
+		{
+			const char* name;
+			UINT32 parent;
+		};
+
+		const BoneHierarchyEntry hierarchy[] =
+		{
+			{ "Finger", 3 },
+			{ "Root", (UINT32)-1 },
+			{ "Spine", 1 },
+			{ "Hand", 4 },
+			{ "Arm", 2 },
+			{ "Head", 2 },
+			{ "Leg", 1 }
+		};
+
+		static constexpr UINT32 NUM_BONES = sizeof(hierarchy) / sizeof(hierarchy[0]);
+		BONE_DESC bones[NUM_BONES];
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			bones[i].name = hierarchy[i].name;
+			bones[i].parent = hierarchy[i].parent;
+			bones[i].localTfrm = Transform(Vector3(0.0f, 1.0f, (float)i), Quaternion(Degree(0.0f), Degree(30.0f * i),
+				Degree(0.0f)), Vector3::ONE * 0.9f);
+			bones[i].invBindPose = Matrix4::IDENTITY;
+		}
+
+		SPtr<Skeleton> skeleton = Skeleton::create(bones, NUM_BONES);
+
+		const auto getDisabled = [&skeleton](const SkeletonMask& mask)
+		{
+			String output;
+			for(UINT32 i = 0; i < skeleton->getNumBones(); i++)
+				output += mask.isEnabled(i) ? "0" : "1";
+
+			return output;
+		};
+
+		const char* expected[] = { "0000000", "1000011", "1001011", "1001111", "1011111", "1111111", "1111111" };
+		for(UINT32 i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+		{
+			SkeletonMaskBuilder builder(skeleton);
+			builder.disableLeafBones(i);
+
+			BS_TEST_ASSERT(getDisabled(builder.getMask()) == expected[i]);
+		}
+
+		// Bones disabled in the original mask stay disabled
+		SkeletonMaskBuilder spineBuilder(skeleton);
+		spineBuilder.setBoneState("Spine", false);
+
+		SkeletonMaskBuilder leafBuilder(skeleton, spineBuilder.getMask());
+		leafBuilder.disableLeafBones(1);
+		BS_TEST_ASSERT(getDisabled(leafBuilder.getMask()) == "1010011");
+
+		// Evaluating a pose from the bind pose local transforms yields identity matrices when relative to the bind pose
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+			bones[i].invBindPose = skeleton->calcBoneTransform(i).getInvMatrix();
+
+		SPtr<Skeleton> boundSkeleton = Skeleton::create(bones, NUM_BONES);
+
+		LocalSkeletonPose localPose(NUM_BONES);
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			localPose.positions[i] = bones[i].localTfrm.getPosition();
+			localPose.rotations[i] = bones[i].localTfrm.getRotation();
+			localPose.scales[i] = bones[i].localTfrm.getScale();
+			localPose.hasOverride[i] = false;
+		}
+
+		Matrix4 pose[NUM_BONES];
+		boundSkeleton->getPose(pose, localPose);
+
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			for(UINT32 row = 0; row < 4; row++)
+			{
+				for(UINT32 col = 0; col < 4; col++)
+					BS_TEST_ASSERT(Math::approxEquals(pose[i][row][col], Matrix4::IDENTITY[row][col], 0.0001f));
+			}
+		}
+	}
+
+	void CoreTestSuite::testAnimationBatches()
+	{
+		static constexpr UINT32 NUM_ANIMATIONS = 200;
+
+		Time::startUp();
+		AnimationManager::startUp();
+
+		// Animations update at a fixed rate. Time reports no delta for its first frame, so that frame is started here.
+		AnimationManager& animManager = AnimationManager::instance();
+		animManager.setUpdateRate(1000);
+		gTime()._update();
+
+		// Skeletons of varying size, so the animations are split into batches of different lengths. Bones have no
+		// inverse bind pose, so the evaluated transforms are unique for each bone of each skeleton.
+		const auto createSkeleton = [](UINT32 numBones, float offset)
+		{
+			Vector<BONE_DESC> bones(numBones);
+			for(UINT32 i = 0; i < numBones; i++)
+			{
+				bones[i].name = "Bone" + toString(i);
+				bones[i].parent = i > 0 ? (i - 1) / 2 : (UINT32)-1;
+				bones[i].localTfrm = Transform(Vector3(offset, (float)i, 0.0f),
+					Quaternion(Degree(0.0f), Degree(10.0f * i), Degree(0.0f)), Vector3::ONE);
+				bones[i].invBindPose = Matrix4::IDENTITY;
+			}
+
+			return Skeleton::create(bones.data(), numBones);
+		};
+
+		struct TestAnimation
+		{
+			SPtr<Animation> animation;
+			SPtr<Skeleton> skeleton;
+		};
+
+		Vector<TestAnimation> animations;
+		for(UINT32 i = 0; i < NUM_ANIMATIONS; i++)
+		{
+			TestAnimation entry;
+			entry.animation = Animation::create();
+			entry.skeleton = createSkeleton(1 + (i * 37) % 96, (float)i);
+
+			entry.animation->setCulling(false);
+			entry.animation->setSkeleton(entry.skeleton);
+
+			animations.push_back(entry);
+		}
+
+		// Batched evaluation must produce the same output as evaluating every animation on its own, with every
+		// animation's bones in their own range of the output
+		const auto checkEvaluated = [this, &animations](const EvaluatedAnimationData& data)
+		{
+			BS_TEST_ASSERT(data.infos.size() == animations.size());
+
+			UINT32 totalNumBones = 0;
+			for(auto& entry : animations)
+				totalNumBones += entry.skeleton->getNumBones();
+
+			BS_TEST_ASSERT(data.transforms.size() == totalNumBones);
+
+			Vector<bool> isBoneWritten(totalNumBones, false);
+			for(auto& entry : animations)
+			{
+				auto iterFind = data.infos.find(entry.animation->_getId());
+				BS_TEST_ASSERT(iterFind != data.infos.end());
+				if(iterFind == data.infos.end())
+					continue;
+
+				const SPtr<Skeleton>& skeleton = entry.skeleton;
+				const UINT32 numBones = skeleton->getNumBones();
+
+				const EvaluatedAnimationData::PoseInfo& poseInfo = iterFind->second.poseInfo;
+				BS_TEST_ASSERT(poseInfo.numBones == numBones);
+				BS_TEST_ASSERT(poseInfo.startIdx + numBones <= totalNumBones);
+				if(poseInfo.numBones != numBones || poseInfo.startIdx + numBones > totalNumBones)
+					continue;
+
+				LocalSkeletonPose localPose(numBones);
+				memset(localPose.hasOverride, 0, sizeof(bool) * numBones);
+
+				Vector<Matrix4> expected(numBones);
+				skeleton->getPose(expected.data(), localPose, SkeletonMask(), nullptr, 0);
+
+				for(UINT32 i = 0; i < numBones; i++)
+				{
+					BS_TEST_ASSERT(!isBoneWritten[poseInfo.startIdx + i]);
+					BS_TEST_ASSERT(data.transforms[poseInfo.startIdx + i] == expected[i]);
+
+					isBoneWritten[poseInfo.startIdx + i] = true;
+				}
+			}
+		};
+
+		const EvaluatedAnimationData* data = animManager.update(false);
+		checkEvaluated(*data);
+
+		// Removing and changing animations moves the bone ranges and batch boundaries of the others
+		for(INT32 i = NUM_ANIMATIONS - 1; i >= 0; i -= 3)
+			animations.erase(animations.begin() + i);
+
+		TestAnimation& changed = animations[animations.size() / 2];
+		changed.skeleton = createSkeleton(128, -1.0f);
+		changed.animation->setSkeleton(changed.skeleton);
+
+		// Wait until the next update is due
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		gTime()._update();
+
+		data = animManager.update(false);
+		checkEvaluated(*data);
+
+		animations.clear();
+
+		AnimationManager::shutDown();
+		Time::shutDown();
+	}
+
+	void CoreTestSuite::testGameObjectManager()
+	{
+		GameObjectManager& manager = GameObjectManager::instance();
+
+		auto createObject = [&manager]()
+		{
+			return manager.registerObject(bs_shared_ptr_new<TestGameObject>());
+		};
+
+		// Changes the object's ID the same way prefab instance data is restored
+		auto changeId = [](GameObjectHandleBase& object, UINT64 id)
+		{
+			GameObjectInstanceDataPtr instanceData = bs_shared_ptr_new<GameObjectInstanceData>();
+			instanceData->mInstanceId = id;
+
+			SPtr<GameObject> objectPtr = object.getInternalPtr();
+			objectPtr->_setInstanceData(instanceData);
+			object._setHandleData(objectPtr);
+		};
+
+		GameObjectHandleBase first = createObject();
+		GameObjectHandleBase second = createObject();
+		const UINT64 firstId = first.getInstanceId();
+		const UINT64 secondId = second.getInstanceId();
+
+		BS_TEST_ASSERT(firstId != 0 && secondId != 0 && firstId != secondId);
+		BS_TEST_ASSERT(manager.getObject(firstId).get() == first.get());
+		BS_TEST_ASSERT(manager.getObject(secondId).get() == second.get());
+
+		// IDs of destroyed objects must not resolve to new objects reusing their slot
+		manager.unregisterObject(first);
+		BS_TEST_ASSERT(first.isDestroyed());
+		BS_TEST_ASSERT(!manager.objectExists(firstId));
+
+		GameObjectHandleBase third = createObject();
+		const UINT64 thirdId = third.getInstanceId();
+		BS_TEST_ASSERT(thirdId != firstId && thirdId != secondId);
+		BS_TEST_ASSERT(!manager.objectExists(firstId));
+		BS_TEST_ASSERT(manager.getObject(thirdId).get() == third.get());
+
+		// Remapping to a reserved ID, and to the ID of a destroyed object
+		const UINT64 reservedId = manager.reserveId();
+		BS_TEST_ASSERT(reservedId != 0 && !manager.objectExists(reservedId));
+
+		changeId(second, reservedId);
+		BS_TEST_ASSERT(!manager.objectExists(secondId));
+		BS_TEST_ASSERT(manager.getObject(reservedId).get() == second.get());
+
+		changeId(third, firstId);
+		BS_TEST_ASSERT(!manager.objectExists(thirdId));
+		BS_TEST_ASSERT(manager.getObject(firstId).get() == third.get());
+
+		GameObjectHandleBase found;
+		BS_TEST_ASSERT(manager.tryGetObject(firstId, found) && found.get() == third.get());
+
+		manager.unregisterObject(second);
+		manager.unregisterObject(third);
+		BS_TEST_ASSERT(!manager.objectExists(reservedId));
+		BS_TEST_ASSERT(!manager.objectExists(firstId));
+		BS_TEST_ASSERT(!manager.tryGetObject(firstId, found));
+
+		// Queued destruction, with the same object queued more than once
+		GameObjectHandleBase queued = createObject();
+		const UINT64 queuedId = queued.getInstanceId();
+
+		manager.queueForDestroy(queued);
+		manager.queueForDestroy(queued);
+		BS_TEST_ASSERT(manager.objectExists(queuedId));
+
+		manager.destroyQueuedObjects();
+		BS_TEST_ASSERT(queued.isDestroyed());
+		BS_TEST_ASSERT(!manager.objectExists(queuedId));
+
+		// Queued objects are destroyed in queue order rather than creation order, and objects queued during destruction
+		// are destroyed in the same pass
+		{
+			GameObjectHandleBase objects[] = { createObject(), createObject(), createObject() };
+			GameObjectHandleBase late = createObject();
+
+			// Handles can't be dereferenced once their objects are destroyed, so objects are compared by address
+			const Vector<GameObject*> expectedOrder =
+				{ objects[2].get(), objects[0].get(), objects[1].get(), late.get() };
+
+			Vector<GameObject*> destroyOrder;
+			HEvent destroyedConn = manager.onDestroyed.connect(
+				[&manager, &destroyOrder, &expectedOrder, &late](const HGameObject& object)
+			{
+				destroyOrder.push_back(object.get());
+
+				if(object.get() == expectedOrder[1])
+					manager.queueForDestroy(late);
+			});
+
+			manager.queueForDestroy(objects[2]);
+			manager.queueForDestroy(objects[0]);
+			manager.queueForDestroy(objects[2]);
+			manager.queueForDestroy(objects[1]);
+			manager.destroyQueuedObjects();
+
+			destroyedConn.disconnect();
+
+			BS_TEST_ASSERT(destroyOrder == expectedOrder);
+			BS_TEST_ASSERT(late.isDestroyed());
+		}
+
+		// Reserved IDs that never get used return their slot to the free list, both when released explicitly and when
+		// remapping an object to them fails. The freed slot is reused first, but under a different ID.
+		const UINT64 releasedId = manager.reserveId();
+		manager.releaseId(releasedId);
+
+		const UINT64 failedId = manager.reserveId();
+		BS_TEST_ASSERT((UINT32)failedId == (UINT32)releasedId && failedId != releasedId);
+
+		manager.remapId(queuedId, failedId);
+		BS_TEST_ASSERT(!manager.objectExists(failedId));
+
+		const UINT64 reusedId = manager.reserveId();
+		BS_TEST_ASSERT((UINT32)reusedId == (UINT32)failedId && reusedId != failedId);
+		manager.releaseId(reusedId);
+	}
+
+	void CoreTestSuite::testSceneTransformPass()
+	{
+		static constexpr UINT32 NUM_OBJECTS = 500;
+		static constexpr float EPSILON = 0.0001f;
+
+		Random random(4321);
+		const auto randomVector = [&random]()
+		{
+			return Vector3(random.getSNorm(), random.getSNorm(), random.getSNorm()) * 2.0f;
+		};
+
+		const auto randomRotation = [&random]()
+		{
+			return Quaternion(Degree(random.getSNorm() * 180.0f), Degree(random.getSNorm() * 180.0f),
+				Degree(random.getSNorm() * 180.0f));
+		};
+
+		// Objects aren't instantiated, so they aren't queued with the scene manager and are only updated by the pass
+		Vector<HSceneObject> objects;
+		Vector<UINT32> parents;
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			HSceneObject so = SceneObject::create("Object", SOF_DontInstantiate);
+
+			// A few separate hierarchies, with both deep chains and wide levels
+			const UINT32 parent = (i < 4) ? (UINT32)-1 : (UINT32)random.getRange(std::max((INT32)i - 8, 0), i - 1);
+			if(parent != (UINT32)-1)
+				so->setParent(objects[parent], false);
+
+			so->setPosition(randomVector());
+			so->setRotation(randomRotation());
+			so->setScale(Vector3(0.5f, 0.5f, 0.5f) + Vector3(random.getUNorm(), random.getUNorm(), random.getUNorm()));
+
+			if((i % 13) == 0)
+				so->setMobility(ObjectMobility::Static);
+
+			objects.push_back(so);
+			parents.push_back(parent);
+		}
+
+		// Move every hierarchy, one of them through a root nested in another root, and include a destroyed root
+		Vector<HSceneObject> roots;
+		for(UINT32 i = 0; i < 4; i++)
+		{
+			objects[i]->setPosition(randomVector());
+			roots.push_back(objects[i]);
+		}
+
+		objects[20]->setRotation(randomRotation());
+		roots.push_back(objects[20]);
+
+		HSceneObject destroyed = SceneObject::create("Destroyed", SOF_DontInstantiate);
+		destroyed->destroy(true);
+		roots.push_back(destroyed);
+
+		SceneTransformPass pass;
+		pass.update(roots);
+
+		// Expected transforms, calculated the same way as SceneObject::updateWorldTfrm()
+		Vector<Transform> worldTransforms(NUM_OBJECTS);
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			worldTransforms[i] = objects[i]->getLocalTransform();
+			if(parents[i] != (UINT32)-1 && objects[i]->getMobility() == ObjectMobility::Movable)
+				worldTransforms[i].makeWorld(worldTransforms[parents[i]]);
+
+			const Matrix4 expected = worldTransforms[i].getMatrix();
+			const Matrix4& actual = objects[i]->getWorldMatrix();
+			for(UINT32 row = 0; row < 4; row++)
+			{
+				for(UINT32 column = 0; column < 4; column++)
+					BS_TEST_ASSERT(Math::approxEquals(actual[row][column], expected[row][column], EPSILON));
+			}
+		}
+
+		objects[0]->destroy(true);
+		objects[1]->destroy(true);
+		objects[2]->destroy(true);
+		objects[3]->destroy(true);
+	}
+
+	void CoreTestSuite::testSceneActorBinding()
+	{
+		SceneManager& sceneManager = gSceneManager();
+
+		HSceneObject parent = SceneObject::create("Parent");
+		HSceneObject child = SceneObject::create("Child");
+		child->setParent(parent);
+
+		SPtr<TestSceneActor> parentActor = bs_shared_ptr_new<TestSceneActor>();
+		SPtr<TestSceneActor> childActor = bs_shared_ptr_new<TestSceneActor>();
+		sceneManager._bindActor(parentActor, parent);
+		sceneManager._bindActor(childActor, child);
+
+		// Binding updates the actors immediately, so there is nothing left to update
+		sceneManager._updateCoreObjectTransforms();
+		BS_TEST_ASSERT(parentActor->numUpdates == 1 && childActor->numUpdates == 1);
+
+		// Moving the parent updates the child as well, and each actor is updated once no matter how many times its
+		// object changed
+		parent->setPosition(Vector3(1.0f, 2.0f, 3.0f));
+		parent->setRotation(Quaternion(Degree(0.0f), Degree(90.0f), Degree(0.0f)));
+		sceneManager._updateCoreObjectTransforms();
+		BS_TEST_ASSERT(parentActor->numUpdates == 2 && childActor->numUpdates == 2);
+		BS_TEST_ASSERT(parentActor->getTransform().getPosition() == Vector3(1.0f, 2.0f, 3.0f));
+		BS_TEST_ASSERT(childActor->getTransform().getPosition() == Vector3(1.0f, 2.0f, 3.0f));
+
+		sceneManager._updateCoreObjectTransforms();
+		BS_TEST_ASSERT(parentActor->numUpdates == 2 && childActor->numUpdates == 2);
+
+		// Moving the child doesn't affect the parent
+		child->setPosition(Vector3(5.0f, 0.0f, 0.0f));
+		sceneManager._updateCoreObjectTransforms();
+		BS_TEST_ASSERT(parentActor->numUpdates == 2 && childActor->numUpdates == 3);
+		BS_TEST_ASSERT(childActor->getTransform().getPosition() == child->getTransform().getPosition());
+
+		// Deactivation and reactivation
+		parent->setActive(false);
+		sceneManager._updateCoreObjectTransforms();
+		BS_TEST_ASSERT(!parentActor->getActive() && !childActor->getActive());
+
+		parent->setActive(true);
+		sceneManager._updateCoreObjectTransforms();
+		BS_TEST_ASSERT(parentActor->getActive() && childActor->getActive());
+
+		// Mobility changes
+		child->setMobility(ObjectMobility::Static);
+		sceneManager._updateCoreObjectTransforms();
+		BS_TEST_ASSERT(childActor->getMobility() == ObjectMobility::Static);
+		BS_TEST_ASSERT(parentActor->getMobility() == ObjectMobility::Movable);
+
+		child->setMobility(ObjectMobility::Movable);
+		sceneManager._updateCoreObjectTransforms();
+		BS_TEST_ASSERT(childActor->getMobility() == ObjectMobility::Movable);
+
+		// Unbinding an actor whose object is queued. The actor is released, so it must not be referenced afterwards.
+		{
+			SPtr<TestSceneActor> unboundActor = bs_shared_ptr_new<TestSceneActor>();
+			sceneManager._bindActor(unboundActor, child);
+
+			child->setPosition(Vector3(6.0f, 0.0f, 0.0f));
+			sceneManager._unbindActor(unboundActor);
+			BS_TEST_ASSERT(sceneManager._getActorSO(unboundActor) == nullptr);
+		}
+
+		const UINT32 childUpdates = childActor->numUpdates;
+		sceneManager._updateCoreObjectTransforms();
+		BS_TEST_ASSERT(childActor->numUpdates == childUpdates + 1);
+		BS_TEST_ASSERT(childActor->getTransform().getPosition() == child->getTransform().getPosition());
+
+		// Rebinding moves the actor from the old object to the new one, so the old object no longer updates it
+		sceneManager._bindActor(childActor, parent);
+		BS_TEST_ASSERT(sceneManager._getActorSO(childActor) == parent);
+		BS_TEST_ASSERT(childActor->getTransform().getPosition() == Vector3(1.0f, 2.0f, 3.0f));
+
+		const UINT32 reboundUpdates = childActor->numUpdates;
+		child->setPosition(Vector3(7.0f, 0.0f, 0.0f));
+		sceneManager._updateCoreObjectTransforms();
+		BS_TEST_ASSERT(childActor->numUpdates == reboundUpdates);
+		BS_TEST_ASSERT(childActor->getTransform().getPosition() == Vector3(1.0f, 2.0f, 3.0f));
+
+		// Destroying objects that are queued, while their actors are still bound
+		const UINT32 parentUpdates = parentActor->numUpdates;
+		const UINT32 childActorUpdates = childActor->numUpdates;
+		parent->setPosition(Vector3(0.0f, 1.0f, 0.0f));
+		parent->destroy(true);
+		BS_TEST_ASSERT(parent.isDestroyed() && child.isDestroyed());
+
+		sceneManager._updateCoreObjectTransforms();
+		BS_TEST_ASSERT(parentActor->numUpdates == parentUpdates && childActor->numUpdates == childActorUpdates);
+
+		sceneManager._unbindActor(parentActor);
+		sceneManager._unbindActor(childActor);
+		BS_TEST_ASSERT(sceneManager._getActorSO(parentActor) == nullptr);
+		BS_TEST_ASSERT(sceneManager._getActorSO(childActor) == nullptr);
+	}
+
+	void CoreTestSuite::testPixelConversionKernels()
+	{
+		// Not a multiple of the SIMD width, so the remainder is tested as well
+		static constexpr UINT32 NUM_PIXELS = 37;
+		static constexpr PixelFormat FORMATS[] = { PF_R8, PF_RGB8, PF_BGR8, PF_RGBA8, PF_BGRA8, PF_RGBA16F, PF_RGBA32F };
+
+		Random random(5678);
+		const auto isFloat = [](PixelFormat format) { return format == PF_RGBA16F || format == PF_RGBA32F; };
+
+		const auto fillRandom = [&random, &isFloat](PixelFormat format, UINT8* data, UINT32 count)
+		{
+			const UINT32 pixelSize = PixelUtil::getNumElemBytes(format);
+			for(UINT32 i = 0; i < count; i++)
+			{
+				UINT8* pixel = data + i * pixelSize;
+				if(isFloat(format))
+				{
+					// Include values outside of the normalized range, which get clamped when converted to 8 bits
+					const auto randomValue = [&random]() { return random.getUNorm() * 1.5f - 0.25f; };
+					PixelUtil::packColor(randomValue(), randomValue(), randomValue(), randomValue(), format, pixel);
+				}
+				else
+				{
+					for(UINT32 j = 0; j < pixelSize; j++)
+						pixel[j] = (UINT8)(random.get() & 0xFF);
+				}
+			}
+		};
+
+		for(auto srcFormat : FORMATS)
+		{
+			for(auto dstFormat : FORMATS)
+			{
+				PixelConversionKernels::ConvertRowFn kernel = PixelConversionKernels::find(srcFormat, dstFormat);
+				if(srcFormat == dstFormat || (isFloat(srcFormat) && isFloat(dstFormat)))
+				{
+					BS_TEST_ASSERT(kernel == nullptr);
+					continue;
+				}
+
+				BS_TEST_ASSERT(kernel != nullptr);
+				if(kernel == nullptr)
+					continue;
+
+				const UINT32 srcPixelSize = PixelUtil::getNumElemBytes(srcFormat);
+				const UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dstFormat);
+
+				Vector<UINT8> src(NUM_PIXELS * srcPixelSize);
+				Vector<UINT8> expected(NUM_PIXELS * dstPixelSize, 0xCD);
+				Vector<UINT8> actual(NUM_PIXELS * dstPixelSize, 0xCD);
+
+				fillRandom(srcFormat, src.data(), NUM_PIXELS);
+				for(UINT32 i = 0; i < NUM_PIXELS; i++)
+				{
+					float r, g, b, a;
+					PixelUtil::unpackColor(&r, &g, &b, &a, srcFormat, src.data() + i * srcPixelSize);
+					PixelUtil::packColor(r, g, b, a, dstFormat, expected.data() + i * dstPixelSize);
+				}
+
+				kernel(src.data(), actual.data(), NUM_PIXELS);
+				BS_TEST_ASSERT(actual == expected);
+			}
+		}
+
+		// sRGB conversion only changes the color channels, using the same curve as the per-pixel path
+		{
+			static constexpr UINT32 PIXEL_SIZE = 4;
+
+			Vector<UINT8> original(NUM_PIXELS * PIXEL_SIZE);
+			fillRandom(PF_RGBA8, original.data(), NUM_PIXELS);
+
+			for(UINT32 toSRGB = 0; toSRGB < 2; toSRGB++)
+			{
+				Vector<UINT8> actual = original;
+				const bool converted = toSRGB ?
+					PixelConversionKernels::linearToSRGB(actual.data(), PF_RGBA8, NUM_PIXELS) :
+					PixelConversionKernels::SRGBToLinear(actual.data(), PF_RGBA8, NUM_PIXELS);
+
+				BS_TEST_ASSERT(converted);
+
+				for(UINT32 i = 0; i < NUM_PIXELS; i++)
+				{
+					const UINT8* pixel = original.data() + i * PIXEL_SIZE;
+
+					Color color;
+					PixelUtil::unpackColor(&color, PF_RGBA8, pixel);
+					color = toSRGB ? color.getGamma() : color.getLinear();
+
+					UINT8 expected[PIXEL_SIZE];
+					PixelUtil::packColor(color, PF_RGBA8, expected);
+
+					const UINT8* actualPixel = actual.data() + i * PIXEL_SIZE;
+					BS_TEST_ASSERT(actualPixel[0] == expected[0]);
+					BS_TEST_ASSERT(actualPixel[1] == expected[1]);
+					BS_TEST_ASSERT(actualPixel[2] == expected[2]);
+					BS_TEST_ASSERT(actualPixel[3] == pixel[3]);
+				}
+			}
+
+			float values[4] = { 0.5f, 0.5f, 0.5f, 1.0f };
+			BS_TEST_ASSERT(!PixelConversionKernels::linearToSRGB((UINT8*)values, PF_RGBA32F, 1));
+			BS_TEST_ASSERT(values[0] == 0.5f);
+		}
+
+		// Conversions through PixelUtil step over rows and slices, and round trip through floating point exactly
+		{
+			const SPtr<PixelData> src = PixelData::create(NUM_PIXELS, 5, 2, PF_RGBA8);
+			const SPtr<PixelData> swizzled = PixelData::create(NUM_PIXELS, 5, 2, PF_BGRA8);
+			const SPtr<PixelData> floats = PixelData::create(NUM_PIXELS, 5, 2, PF_RGBA32F);
+			const SPtr<PixelData> roundTrip = PixelData::create(NUM_PIXELS, 5, 2, PF_RGBA8);
+
+			const UINT32 size = src->getConsecutiveSize();
+			fillRandom(PF_RGBA8, src->getData(), size / 4);
+
+			PixelUtil::bulkPixelConversion(*src, *swizzled);
+			PixelUtil::bulkPixelConversion(*src, *floats);
+			PixelUtil::bulkPixelConversion(*floats, *roundTrip);
+
+			for(UINT32 i = 0; i < size; i += 4)
+			{
+				BS_TEST_ASSERT(swizzled->getData()[i + 0] == src->getData()[i + 2]);
+				BS_TEST_ASSERT(swizzled->getData()[i + 1] == src->getData()[i + 1]);
+				BS_TEST_ASSERT(swizzled->getData()[i + 2] == src->getData()[i + 0]);
+				BS_TEST_ASSERT(swizzled->getData()[i + 3] == src->getData()[i + 3]);
+			}
+
+			BS_TEST_ASSERT(memcmp(src->getData(), roundTrip->getData(), size) == 0);
+		}
+	}
+
+	void CoreTestSuite::testBCDecompression()
+	{
+		// Decodes a single block and compares the pixels of each row against the expected ones
+		const auto checkBlock = [this](PixelFormat format, const UINT8* block, const UINT32 (&expected)[4][4])
+		{
+			BCDecompressionKernels::DecodeRowFn decoder = BCDecompressionKernels::find(format);
+			BS_TEST_ASSERT(decoder != nullptr);
+			if(decoder == nullptr)
+				return;
+
+			UINT32 pixels[4][4];
+			decoder(block, (UINT8*)pixels, sizeof(pixels[0]), 1);
+
+			BS_TEST_ASSERT(memcmp(pixels, expected, sizeof(pixels)) == 0);
+		};
+
+		const auto rgba = [](UINT32 r, UINT32 g, UINT32 b, UINT32 a) { return r | (g << 8) | (b << 16) | (a << 24); };
+
+		// Red and blue endpoints, each row containing all four indices in order
+		const UINT8 fourColorBlock[8] = { 0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4 };
+		const UINT32 fourColorRow[4] =
+			{ rgba(255, 0, 0, 255), rgba(0, 0, 255, 255), rgba(170, 0, 85, 255), rgba(85, 0, 170, 255) };
+
+		// Same as above with endpoints swapped, which selects three colors and black
+		const UINT8 threeColorBlock[8] = { 0x1F, 0x00, 0x00, 0xF8, 0xE4, 0xE4, 0xE4, 0xE4 };
+		const UINT32 threeColorRow[4] =
+			{ rgba(0, 0, 255, 255), rgba(255, 0, 0, 255), rgba(127, 0, 127, 255), rgba(0, 0, 0, 255) };
+
+		UINT32 expected[4][4];
+		for(UINT32 y = 0; y < 4; y++)
+			memcpy(expected[y], fourColorRow, sizeof(fourColorRow));
+
+		checkBlock(PF_BC1, fourColorBlock, expected);
+		checkBlock(PF_BC1a, fourColorBlock, expected);
+
+		for(UINT32 y = 0; y < 4; y++)
+			memcpy(expected[y], threeColorRow, sizeof(threeColorRow));
+
+		checkBlock(PF_BC1, threeColorBlock, expected);
+
+		for(UINT32 y = 0; y < 4; y++)
+			expected[y][3] = 0;
+
+		checkBlock(PF_BC1a, threeColorBlock, expected);
+
+		// Explicit alpha equal to 17 times the pixel index. Colors always use four entries, even if the endpoints
+		// would select three colors in BC1.
+		UINT8 explicitAlphaBlock[16];
+		for(UINT32 i = 0; i < 8; i++)
+			explicitAlphaBlock[i] = (UINT8)((i * 2) | ((i * 2 + 1) << 4));
+
+		memcpy(explicitAlphaBlock + 8, threeColorBlock, sizeof(threeColorBlock));
+		for(UINT32 y = 0; y < 4; y++)
+		{
+			expected[y][0] = rgba(0, 0, 255, 0);
+			expected[y][1] = rgba(255, 0, 0, 0);
+			expected[y][2] = rgba(85, 0, 170, 0);
+			expected[y][3] = rgba(170, 0, 85, 0);
+
+			for(UINT32 x = 0; x < 4; x++)
+				expected[y][x] |= ((y * 4 + x) * 17) << 24;
+		}
+
+		checkBlock(PF_BC2, explicitAlphaBlock, expected);
+
+		// Single channel blocks with eight interpolated values, and six values plus zero and one, each pixel using the
+		// index equal to its position modulo eight
+		const UINT8 eightValueBlock[8] = { 200, 10, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA };
+		const UINT8 sixValueBlock[8] = { 10, 200, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA };
+		const UINT8 eightValues[8] = { 200, 10, 172, 145, 118, 91, 64, 37 };
+		const UINT8 sixValues[8] = { 10, 200, 48, 86, 124, 162, 0, 255 };
+
+		for(UINT32 i = 0; i < 16; i++)
+			expected[i / 4][i % 4] = rgba(eightValues[i % 8], 0, 0, 255);
+
+		checkBlock(PF_BC4, eightValueBlock, expected);
+
+		UINT8 twoChannelBlock[16];
+		memcpy(twoChannelBlock, eightValueBlock, sizeof(eightValueBlock));
+		memcpy(twoChannelBlock + 8, sixValueBlock, sizeof(sixValueBlock));
+
+		for(UINT32 i = 0; i < 16; i++)
+			expected[i / 4][i % 4] = rgba(eightValues[i % 8], sixValues[i % 8], 0, 255);
+
+		checkBlock(PF_BC5, twoChannelBlock, expected);
+
+		UINT8 interpolatedAlphaBlock[16];
+		memcpy(interpolatedAlphaBlock, sixValueBlock, sizeof(sixValueBlock));
+		memcpy(interpolatedAlphaBlock + 8, fourColorBlock, sizeof(fourColorBlock));
+
+		for(UINT32 i = 0; i < 16; i++)
+			expected[i / 4][i % 4] = (fourColorRow[i % 4] & 0x00FFFFFF) | ((UINT32)sixValues[i % 8] << 24);
+
+		checkBlock(PF_BC3, interpolatedAlphaBlock, expected);
+
+		// Decompression through PixelUtil clips partial blocks, and converts to formats other than RGBA8 the same way
+		// as converting the decoded RGBA8 pixels would
+		{
+			const SPtr<PixelData> compressed = PixelData::create(7, 3, 1, PF_BC1a);
+			memcpy(compressed->getData(), fourColorBlock, sizeof(fourColorBlock));
+			memcpy(compressed->getData() + sizeof(fourColorBlock), threeColorBlock, sizeof(threeColorBlock));
+
+			const SPtr<PixelData> decoded = PixelData::create(7, 3, 1, PF_RGBA8);
+			const SPtr<PixelData> decodedHalf = PixelData::create(7, 3, 1, PF_RGBA16F);
+			const SPtr<PixelData> convertedHalf = PixelData::create(7, 3, 1, PF_RGBA16F);
+
+			PixelUtil::bulkPixelConversion(*compressed, *decoded);
+			PixelUtil::bulkPixelConversion(*compressed, *decodedHalf);
+			PixelUtil::bulkPixelConversion(*decoded, *convertedHalf);
+
+			for(UINT32 y = 0; y < 3; y++)
+			{
+				for(UINT32 x = 0; x < 7; x++)
+				{
+					UINT32 pixel;
+					memcpy(&pixel, decoded->getData() + y * decoded->getRowPitch() + x * 4, sizeof(pixel));
+
+					BS_TEST_ASSERT(pixel == (x < 4 ? fourColorRow[x] : threeColorRow[x - 4]));
+				}
+			}
+
+			BS_TEST_ASSERT(memcmp(decodedHalf->getData(), convertedHalf->getData(),
+				decodedHalf->getConsecutiveSize()) == 0);
+		}
+
+		// Round trip through the compressor, using smooth gradients that every format can represent closely
+		{
+			static constexpr UINT32 WIDTH = 30;
+			static constexpr UINT32 HEIGHT = 18;
+
+			struct FormatDesc
+			{
+				PixelFormat format;
+				UINT32 numChannels;
+				bool hasAlpha;
+				UINT32 tolerance;
+			};
+
+			const FormatDesc formats[] =
+			{
+				{ PF_BC1, 3, false, 16 },
+				{ PF_BC1a, 3, false, 16 },
+				{ PF_BC2, 3, true, 16 },
+				{ PF_BC3, 3, true, 16 },
+				{ PF_BC4, 1, false, 4 },
+				{ PF_BC5, 2, false, 4 }
+			};
+
+			for(auto& desc : formats)
+			{
+				const SPtr<PixelData> original = PixelData::create(WIDTH, HEIGHT, 1, PF_RGBA8);
+				for(UINT32 y = 0; y < HEIGHT; y++)
+				{
+					for(UINT32 x = 0; x < WIDTH; x++)
+					{
+						const UINT32 value = (x + y) * 255 / (WIDTH + HEIGHT - 2);
+
+						UINT8* pixel = original->getData() + y * original->getRowPitch() + x * 4;
+						pixel[0] = (UINT8)value;
+						pixel[1] = (UINT8)(255 - value);
+						pixel[2] = (UINT8)(value / 2);
+						pixel[3] = desc.hasAlpha ? (UINT8)(255 - value / 2) : 255;
+					}
+				}
+
+				CompressionOptions options;
+				options.format = desc.format;
+				options.alphaMode = desc.hasAlpha ? AlphaMode::Transparency : AlphaMode::None;
+
+				const SPtr<PixelData> compressed = PixelData::create(WIDTH, HEIGHT, 1, desc.format);
+				const SPtr<PixelData> decoded = PixelData::create(WIDTH, HEIGHT, 1, PF_RGBA8);
+
+				PixelUtil::compress(*original, *compressed, options);
+				PixelUtil::bulkPixelConversion(*compressed, *decoded);
+
+				UINT32 maxError = 0;
+				for(UINT32 y = 0; y < HEIGHT; y++)
+				{
+					const UINT8* originalRow = original->getData() + y * original->getRowPitch();
+					const UINT8* decodedRow = decoded->getData() + y * decoded->getRowPitch();
+
+					for(UINT32 x = 0; x < WIDTH; x++)
+					{
+						for(UINT32 channel = 0; channel < 4; channel++)
+						{
+							if(channel >= desc.numChannels && (channel != 3 || !desc.hasAlpha))
+								continue;
+
+							const INT32 error = (INT32)originalRow[x * 4 + channel] - (INT32)decodedRow[x * 4 + channel];
+							maxError = std::max(maxError, (UINT32)std::abs(error));
+						}
+					}
+				}
+
+				BS_TEST_ASSERT(maxError <= desc.tolerance);
+			}
+		}
+
+		// Formats that can't be decompressed fail, and leave the destination untouched when re-compressing
+		{
+			const SPtr<PixelData> unsupported = PixelData::create(16, 16, 1, PF_BC7);
+			const SPtr<PixelData> decoded = PixelData::create(16, 16, 1, PF_RGBA8);
+			BS_TEST_ASSERT(!PixelUtil::decompress(*unsupported, *decoded));
+
+			const SPtr<PixelData> recompressed = PixelData::create(16, 16, 1, PF_BC1);
+			memset(recompressed->getData(), 0xAB, recompressed->getConsecutiveSize());
+			PixelUtil::bulkPixelConversion(*unsupported, *recompressed);
+
+			bool isUntouched = true;
+			for(UINT32 i = 0; i < recompressed->getConsecutiveSize(); i++)
+				isUntouched &= recompressed->getData()[i] == 0xAB;
+
+			BS_TEST_ASSERT(isUntouched);
+		}
+	}
+
+	void CoreTestSuite::testMappedPixelData()
+	{
+		SPtr<PixelData> source = PixelData::create(4, 4, 1, PF_RGBA8);
+		for(UINT32 y = 0; y < 4; y++)
+		{
+			for(UINT32 x = 0; x < 4; x++)
+				source->setColorAt(Color(x * 0.25f, y * 0.25f, 0.5f, 1.0f), x, y);
+		}
+
+		const Vector<Color> sourceColors = source->getColors();
+
+		const Path path = FileSystem::getTempDirectoryPath() + "bsfMappedPixelDataTest.asset";
+		{
+			FileEncoder encoder(path);
+			encoder.encode(source.get());
+		}
+
+		// Decoding from a mapped file references the pixels in the mapping
+		SPtr<MemoryMappedDataStream> stream = FileSystem::openFileMapped(path);
+		BS_TEST_ASSERT(stream != nullptr);
+
+		UINT32 objectSize = 0;
+		stream->read(&objectSize, sizeof(objectSize));
+
+		BinarySerializer bs;
+		SPtr<PixelData> mapped = std::static_pointer_cast<PixelData>(bs.decode(stream, objectSize));
+
+		const UINT8* mappingStart = stream->getMappedFile()->getData();
+		const UINT8* mappingEnd = mappingStart + stream->getMappedFile()->getSize();
+		BS_TEST_ASSERT(mapped->getData() >= mappingStart && mapped->getData() < mappingEnd);
+		BS_TEST_ASSERT(mapped->getColors() == sourceColors);
+
+		// Mapped pixels can be modified in-place through the public API
+		const auto modify = [](PixelData& pixelData)
+		{
+			pixelData.setColorAt(Color::White, 1, 2);
+			PixelUtil::flipComponentOrder(pixelData);
+			PixelUtil::linearToSRGB(pixelData);
+		};
+
+		modify(*source);
+		modify(*mapped);
+
+		BS_TEST_ASSERT(memcmp(mapped->getData(), source->getData(), source->getConsecutiveSize()) == 0);
+
+		// Modifications aren't written to the file
+		{
+			FileDecoder decoder(path);
+			SPtr<PixelData> reloaded = std::static_pointer_cast<PixelData>(decoder.decode());
+			BS_TEST_ASSERT(reloaded != nullptr && reloaded->getColors() == sourceColors);
+		}
+
+		mapped = nullptr;
+		stream = nullptr;
+		FileSystem::remove(path);
+	}
+
+	void CoreTestSuite::testCommandQueueOverflow()
+	{
+		SPtr<TestQueueFloodCoreObject> object = bs_core_ptr_new<TestQueueFloodCoreObject>();
+		object->_setThisPtr(object);
+		object->initialize();
+
+		CoreObjectManager::instance().syncToCore();
+		gCoreThread().submit(true);
+
+		// Command that needs the core object manager lock, which is held by the sim thread while it syncs the object.
+		// If the sim thread waited for the full queue to drain, it would never release the lock.
+		TestQueueFloodCoreObject* objectPtr = object.get();
+		gCoreThread().queueCommand([objectPtr]()
+		{
+			while(!objectPtr->syncStarted)
+				std::this_thread::yield();
+
+			CoreObjectManager::instance().generateId();
+		});
+		gCoreThread().submit();
+
+		object->markDirty();
+		CoreObjectManager::instance().syncToCore(object.get());
+
+		// Queue more commands after the overflow, they must still execute after the ones queued during the sync
+		std::atomic<bool> executedLast{false};
+		gCoreThread().queueCommand([objectPtr, &executedLast]()
+		{
+			executedLast = objectPtr->numExecuted == TestQueueFloodCoreObject::NUM_COMMANDS;
+		});
+		gCoreThread().submit(true);
+
+		BS_TEST_ASSERT(object->numExecuted == TestQueueFloodCoreObject::NUM_COMMANDS);
+		BS_TEST_ASSERT(object->inOrder);
+		BS_TEST_ASSERT(executedLast);
+
+		// Regular ring queue operation resumes after the submit
+		std::atomic<UINT32> numAfterSubmit{0};
+		for(UINT32 i = 0; i < 16; i++)
+			gCoreThread().queueCommand([&numAfterSubmit]() { numAfterSubmit++; });
+
+		gCoreThread().submit(true);
+		BS_TEST_ASSERT(numAfterSubmit == 16);
+
+		object->destroy();
+		object = nullptr;
+
+		CoreObjectManager::instance().syncToCore();
+		gCoreThread().submit(true);
+	}
+
+	void CoreTestSuite::testGpuParamBlockBufferPool()
+	{
+		RenderStats::startUp();
+		ct::HardwareBufferManager::startUp<ct::TestHardwareBufferManager>();
+
+		// Buffers are core objects, so they're created and destroyed on the core thread
+		gCoreThread().queueCommand([this]()
+		{
+			static constexpr UINT32 PAGE_SIZE = 1024;
+			static constexpr UINT32 ALIGNMENT = 256;
+
+			RenderAPICapabilities caps;
+			caps.setCapability(RSC_PARAM_BLOCK_BUFFER_RANGES);
+			caps.paramBlockBufferOffsetAlignment = ALIGNMENT;
+
+			// Ranges are allocated back to back at aligned offsets, until the page is full
+			{
+				ct::GpuParamBlockBufferPool pool(caps, PAGE_SIZE);
+
+				SPtr<ct::GpuParamBlockBuffer> a = pool.alloc(100);
+				SPtr<ct::GpuParamBlockBuffer> b = pool.alloc(300);
+				SPtr<ct::GpuParamBlockBuffer> c = pool.alloc(ALIGNMENT);
+				SPtr<ct::GpuParamBlockBuffer> d = pool.alloc(ALIGNMENT);
+
+				BS_TEST_ASSERT(a->getParentBuffer() != nullptr);
+				BS_TEST_ASSERT(a->getSize() == 100 && b->getSize() == 300);
+				BS_TEST_ASSERT(a->getParentBuffer() == b->getParentBuffer());
+				BS_TEST_ASSERT(a->getParentBuffer() == c->getParentBuffer());
+				BS_TEST_ASSERT(a->getParentOffset() == 0);
+				BS_TEST_ASSERT(b->getParentOffset() == ALIGNMENT);
+				BS_TEST_ASSERT(c->getParentOffset() == ALIGNMENT * 3);
+
+				BS_TEST_ASSERT(d->getParentBuffer() != nullptr && d->getParentBuffer() != a->getParentBuffer());
+				BS_TEST_ASSERT(d->getParentOffset() == 0);
+
+				// Buffers that don't fit in a page are allocated separately
+				SPtr<ct::GpuParamBlockBuffer> large = pool.alloc(PAGE_SIZE + 1);
+				BS_TEST_ASSERT(large->getParentBuffer() == nullptr && large->getSize() == PAGE_SIZE + 1);
+
+				// Writes to ranges are uploaded with a single write of their page
+				const UINT32 value = 0xABCD;
+				a->write(0, &value, sizeof(value));
+				b->write(0, &value, sizeof(value));
+
+				const UINT32 numWrites = static_cast<ct::TestGpuParamBlockBuffer*>(a.get())->getNumWrites();
+				a->flushToGPU();
+				b->flushToGPU();
+				BS_TEST_ASSERT(static_cast<ct::TestGpuParamBlockBuffer*>(a.get())->getNumWrites() == numWrites + 1);
+
+				UINT32 readValue = 0;
+				a->getParentBuffer()->read(ALIGNMENT, &readValue, sizeof(readValue));
+				BS_TEST_ASSERT(readValue == value);
+
+				// Freed ranges are reused by allocations of the same aligned size, and are zeroed out
+				const SPtr<ct::GpuParamBlockBuffer> firstPage = a->getParentBuffer();
+				pool.free(a);
+				a = nullptr;
+
+				SPtr<ct::GpuParamBlockBuffer> reused = pool.alloc(ALIGNMENT - 1);
+				BS_TEST_ASSERT(reused->getParentBuffer() == firstPage);
+				BS_TEST_ASSERT(reused->getParentOffset() == 0);
+
+				readValue = 1;
+				reused->read(0, &readValue, sizeof(readValue));
+				BS_TEST_ASSERT(readValue == 0);
+
+				// Ranges of a different aligned size don't reuse the freed memory
+				pool.free(b);
+				b = nullptr;
+
+				SPtr<ct::GpuParamBlockBuffer> other = pool.alloc(100);
+				BS_TEST_ASSERT(other->getParentBuffer() == d->getParentBuffer());
+				BS_TEST_ASSERT(other->getParentOffset() == ALIGNMENT);
+			}
+
+			// Backends without range support get separate buffers
+			{
+				ct::GpuParamBlockBufferPool pool(RenderAPICapabilities(), PAGE_SIZE);
+
+				SPtr<ct::GpuParamBlockBuffer> buffer = pool.alloc(100);
+				BS_TEST_ASSERT(buffer != nullptr && buffer->getParentBuffer() == nullptr);
+				BS_TEST_ASSERT(buffer->getSize() == 100);
+
+				pool.free(buffer);
+			}
+
+			// Backends that report range support, but fail to create a range, fall back to separate buffers
+			{
+				auto& bufferManager = static_cast<ct::TestHardwareBufferManager&>(ct::HardwareBufferManager::instance());
+				bufferManager.supportsRanges = false;
+
+				ct::GpuParamBlockBufferPool pool(caps, PAGE_SIZE);
+
+				SPtr<ct::GpuParamBlockBuffer> first = pool.alloc(100);
+				SPtr<ct::GpuParamBlockBuffer> second = pool.alloc(100);
+				BS_TEST_ASSERT(first != nullptr && first->getParentBuffer() == nullptr);
+				BS_TEST_ASSERT(second != nullptr && second->getParentBuffer() == nullptr);
+
+				pool.free(first);
+				bufferManager.supportsRanges = true;
+			}
+		});
+		gCoreThread().submit(true);
+
+		ct::HardwareBufferManager::shutDown();
+		RenderStats::shutDown();
+	}
+
+	void CoreTestSuite::testResourceLoading()
+	{
+		// The core thread reserves one of the workers, which leaves none for async loads on single core machines
+		const bool addedWorker = TaskScheduler::instance().getNumWorkers() == 0;
+		if(addedWorker)
+			TaskScheduler::instance().addWorker();
+
+		// Events are triggered from the worker threads performing the loads
+		Mutex loadedMutex;
+		Vector<UUID> loadedOrder;
+		HEvent loadedConn = gResources().onResourceLoaded.connect([&loadedMutex, &loadedOrder](const HResource& resource)
+		{
+			Lock lock(loadedMutex);
+			loadedOrder.push_back(resource.getUUID());
+		});
+
+		const auto waitFor = [](const std::function<bool()>& predicate)
+		{
+			const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+			while(!predicate())
+			{
+				if(std::chrono::steady_clock::now() > timeout)
+					return false;
+
+				std::this_thread::yield();
+			}
+
+			return true;
+		};
+
+		const auto clearLoadEvents = [&loadedMutex, &loadedOrder]()
+		{
+			Lock lock(loadedMutex);
+			loadedOrder.clear();
+		};
+
+		const auto waitForLoadEvent = [&waitFor, &loadedMutex, &loadedOrder](const UUID& uuid)
+		{
+			return waitFor([&loadedMutex, &loadedOrder, &uuid]()
+			{
+				Lock lock(loadedMutex);
+				return std::find(loadedOrder.begin(), loadedOrder.end(), uuid) != loadedOrder.end();
+			});
+		};
+
+		// Occupies every task scheduler worker, so queued loads don't start until the workers are released
+		std::atomic<UINT32> numBlocked{0};
+		std::atomic<UINT32> numToRelease{0};
+		std::atomic<bool> releaseAll{false};
+		Vector<SPtr<Task>> blockers;
+
+		const auto blockWorkers = [&waitFor, &numBlocked, &numToRelease, &releaseAll, &blockers]()
+		{
+			const UINT32 numWorkers = TaskScheduler::instance().getNumWorkers();
+			numBlocked = 0;
+			numToRelease = 0;
+			releaseAll = false;
+
+			for(UINT32 i = 0; i < numWorkers; i++)
+			{
+				SPtr<Task> blocker = Task::create("Blocker", [&numBlocked, &numToRelease, &releaseAll]()
+				{
+					numBlocked++;
+
+					while(!releaseAll)
+					{
+						UINT32 toRelease = numToRelease;
+						if(toRelease > 0 && numToRelease.compare_exchange_weak(toRelease, toRelease - 1))
+							break;
+
+						std::this_thread::yield();
+					}
+				});
+
+				TaskScheduler::instance().addTask(blocker);
+				blockers.push_back(blocker);
+			}
+
+			return waitFor([&numBlocked, numWorkers]() { return numBlocked == numWorkers; });
+		};
+
+		const auto releaseWorkers = [&releaseAll, &blockers]()
+		{
+			releaseAll = true;
+
+			for(auto& blocker : blockers)
+				blocker->wait();
+
+			blockers.clear();
+		};
+
+		const Path directory = FileSystem::getTempDirectoryPath() + "bsfResourceLoadingTest/";
+		const Path pathA = directory + "A.asset";
+		const Path pathB = directory + "B.asset";
+		const Path pathC = directory + "C.asset";
+
+		// A depends on B and C, which are of equal size
+		{
+			HResource b = TestResource::create(2);
+			HResource c = TestResource::create(3);
+			HResource a = TestResource::create(1, { b, c });
+
+			gResources().save(b, pathB, true, false);
+			gResources().save(c, pathC, true, false);
+			gResources().save(a, pathA, true, false);
+			gResources().unloadAll();
+		}
+
+		const auto checkLoaded = [](const HResource& resource)
+		{
+			if(!resource.isLoaded(false))
+				return false;
+
+			const auto* a = static_cast<const TestResource*>(resource.get());
+			if(a->value != 1 || a->dependencies.size() != 2)
+				return false;
+
+			for(UINT32 i = 0; i < 2; i++)
+			{
+				const HResource& dependency = a->dependencies[i];
+				if(!dependency.isLoaded(false) || static_cast<const TestResource*>(dependency.get())->value != i + 2)
+					return false;
+			}
+
+			return true;
+		};
+
+		// Loading again while a canceled load is still queued resumes it, along with the loads of its dependencies
+		{
+			clearLoadEvents();
+			BS_TEST_ASSERT(blockWorkers());
+
+			HResource a = gResources().loadAsync(pathA);
+			gResources().cancelLoad(a);
+
+			HResource reloaded = gResources().loadAsync(pathA);
+			BS_TEST_ASSERT(reloaded == a);
+
+			releaseWorkers();
+			BS_TEST_ASSERT(waitForLoadEvent(a.getUUID()));
+			BS_TEST_ASSERT(checkLoaded(a));
+
+			gResources().unloadAll();
+		}
+
+		// Loading again after a canceled load completed without data starts a new load
+		{
+			clearLoadEvents();
+			BS_TEST_ASSERT(blockWorkers());
+
+			HResource a = gResources().loadAsync(pathA);
+			const UUID uuid = a.getUUID();
+			gResources().cancelLoad(a);
+
+			releaseWorkers();
+			BS_TEST_ASSERT(waitForLoadEvent(uuid));
+			BS_TEST_ASSERT(!a.isLoaded(false));
+
+			clearLoadEvents();
+
+			HResource reloaded = gResources().loadAsync(pathA);
+			BS_TEST_ASSERT(reloaded == a);
+			BS_TEST_ASSERT(waitForLoadEvent(uuid));
+			BS_TEST_ASSERT(checkLoaded(a));
+
+			gResources().unloadAll();
+		}
+
+		// Only the global queue orders tasks by priority, and executes queued tasks on a thread waiting for them
+		if(TaskScheduler::instance().getMode() == TaskSchedulerMode::GlobalQueue)
+		{
+			// Progress is reported per dependency level, so a sync load of one of the two dependencies completes half of
+			// the second level
+			{
+				clearLoadEvents();
+				BS_TEST_ASSERT(blockWorkers());
+				HResource a = gResources().loadAsync(pathA);
+
+				UUID uuidB;
+				BS_TEST_ASSERT(gResources().getUUIDFromFilePath(pathB, uuidB));
+
+				HResource b = gResources().loadFromUUID(uuidB, false);
+				BS_TEST_ASSERT(b.isLoaded(false));
+
+				const Vector<float> progress = gResources().getLoadProgressPerLevel(a);
+				BS_TEST_ASSERT(progress.size() == 2);
+				BS_TEST_ASSERT(progress.size() == 2 && progress[0] == 0.0f && Math::approxEquals(progress[1], 0.5f));
+
+				releaseWorkers();
+				BS_TEST_ASSERT(waitForLoadEvent(a.getUUID()));
+				BS_TEST_ASSERT(checkLoaded(a));
+
+				gResources().unloadAll();
+			}
+
+			// Queued loads execute in priority order once a worker frees up
+			{
+				clearLoadEvents();
+				BS_TEST_ASSERT(blockWorkers());
+
+				ResourceLoadFlags flags = ResourceLoadFlag::KeepInternalRef;
+				HResource b = gResources().loadAsync(pathB, flags, TaskPriority::Low);
+				HResource c = gResources().loadAsync(pathC, flags, TaskPriority::High);
+				HResource a = gResources().loadAsync(pathA, flags, TaskPriority::Normal);
+
+				// A single worker executes the loads one after another
+				numToRelease++;
+				BS_TEST_ASSERT(waitFor([&loadedMutex, &loadedOrder]()
+				{
+					Lock lock(loadedMutex);
+					return loadedOrder.size() == 3;
+				}));
+
+				{
+					Lock lock(loadedMutex);
+					BS_TEST_ASSERT(loadedOrder.size() == 3);
+					BS_TEST_ASSERT(loadedOrder.size() == 3 && loadedOrder[0] == c.getUUID() &&
+						loadedOrder[1] == a.getUUID() && loadedOrder[2] == b.getUUID());
+				}
+
+				releaseWorkers();
+
+				gResources().unloadAll();
+			}
+		}
+
+		loadedConn.disconnect();
+
+		if(addedWorker)
+			TaskScheduler::instance().removeWorker();
+
+		FileSystem::remove(directory);
+	}
 }
 
 using namespace bs;
@@ -3,7 +3,10 @@
 #include "Profiling/BsProfilerCPU.h"
 #include "Debug/BsDebug.h"
 #include "Platform/BsPlatform.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
 #include <chrono>
+#include <iomanip>
 
 #if BS_COMPILER == BS_COMPILER_MSVC
 	#include <intrin.h>
@@ -25,6 +28,32 @@ using namespace std::chrono;
 
 namespace bs
 {
+	/** Returns the current time used for trace event timestamps, in nanoseconds. */
+	static UINT64 getTraceTimeNs()
+	{
+		return (UINT64)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+	}
+
+	/** Writes the provided string as a quoted JSON string, escaping any characters as needed. */
+	static void writeJsonString(StringStream& output, const char* string)
+	{
+		output << '"';
+		for(const char* iter = string; *iter != '\0'; ++iter)
+		{
+			const char ch = *iter;
+			if(ch == '"' || ch == '\\')
+				output << '\\' << ch;
+			else if((UINT8)ch < 0x20)
+			{
+				static const char* HEX = "0123456789abcdef";
+				output << "\\u00" << HEX[(ch >> 4) & 0xF] << HEX[ch & 0xF];
+			}
+			else
+				output << ch;
+		}
+		output << '"';
+	}
+
 	ProfilerCPU::Timer::Timer()
 	{
 		time = 0.0f;
@@ -108,6 +137,9 @@ namespace bs
 		memAllocs = MemoryCounter::getNumAllocs();
 		memFrees = MemoryCounter::getNumFrees();
 
+		for(UINT32 i = 0; i < (UINT32)MemoryCategory::Count; i++)
+			memAllocatedBytes[i] = MemoryCounter::getNumAllocatedBytes((MemoryCategory)i);
+
 		timer.reset();
 		timer.start();
 	}
@@ -119,7 +151,11 @@ namespace bs
 		UINT64 numAllocs = MemoryCounter::getNumAllocs() - memAllocs;
 		UINT64 numFrees = MemoryCounter::getNumFrees() - memFrees;
 
-		samples.push_back(ProfileSample(timer.time, numAllocs, numFrees));
+		ProfileSample sample(timer.time, numAllocs, numFrees);
+		for(UINT32 i = 0; i < (UINT32)MemoryCategory::Count; i++)
+			sample.numAllocatedBytes[i] = MemoryCounter::getNumAllocatedBytes((MemoryCategory)i) - memAllocatedBytes[i];
+
+		samples.push_back(sample);
 	}
 
 	void ProfilerCPU::ProfileData::resumeLastSample()
@@ -137,6 +173,9 @@ namespace bs
 		memAllocs = MemoryCounter::getNumAllocs();
 		memFrees = MemoryCounter::getNumFrees();
 
+		for(UINT32 i = 0; i < (UINT32)MemoryCategory::Count; i++)
+			memAllocatedBytes[i] = MemoryCounter::getNumAllocatedBytes((MemoryCategory)i);
+
 		timer.reset();
 		timer.start();
 	}
@@ -148,7 +187,11 @@ namespace bs
 		UINT64 numAllocs = MemoryCounter::getNumAllocs() - memAllocs;
 		UINT64 numFrees = MemoryCounter::getNumFrees() - memFrees;
 
-		samples.push_back(PreciseProfileSample(timer.cycles, numAllocs, numFrees));
+		PreciseProfileSample sample(timer.cycles, numAllocs, numFrees);
+		for(UINT32 i = 0; i < (UINT32)MemoryCategory::Count; i++)
+			sample.numAllocatedBytes[i] = MemoryCounter::getNumAllocatedBytes((MemoryCategory)i) - memAllocatedBytes[i];
+
+		samples.push_back(sample);
 	}
 
 	void ProfilerCPU::PreciseProfileData::resumeLastSample()
@@ -157,15 +200,137 @@ namespace bs
 		samples.erase(samples.end() - 1);
 	}
 
+	void ProfilerCPU::TraceEventBuffer::push(TraceEventType type, const char* name)
+	{
+		if(type == TraceEventType::End)
+		{
+			const UINT64 timeNs = getTraceTimeNs();
+
+			if(droppedDepth > 0)
+			{
+				droppedDepth--;
+				numDropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			// Room for the end event was reserved when its begin event was recorded
+			const UINT32 write = writeIdx.load(std::memory_order_relaxed);
+			TraceEvent& event = events[write % CAPACITY];
+			event.timeNs = timeNs;
+			event.type = type;
+			event.name[0] = '\0';
+
+			depth--;
+			writeIdx.store(write + 1, std::memory_order_release);
+		}
+		else
+		{
+			if(droppedDepth > 0)
+			{
+				droppedDepth++;
+				numDropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			const UINT32 write = writeIdx.load(std::memory_order_relaxed);
+			const UINT32 read = readIdx.load(std::memory_order_acquire);
+			if((write - read) + depth + 2 > CAPACITY)
+			{
+				droppedDepth++;
+				numDropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			TraceEvent& event = events[write % CAPACITY];
+			event.type = type;
+
+			UINT32 length = 0;
+			while(length < TraceEvent::MAX_NAME_LENGTH && name[length] != '\0')
+			{
+				event.name[length] = name[length];
+				length++;
+			}
+			event.name[length] = '\0';
+
+			depth++;
+
+			event.timeNs = getTraceTimeNs();
+			writeIdx.store(write + 1, std::memory_order_release);
+		}
+	}
+
+	UINT64 ProfilerCPU::TraceEventBuffer::drain(UINT32 threadIdx, ProfilerVector<TraceEvent>& output, UINT32 maxEvents)
+	{
+		const UINT32 read = readIdx.load(std::memory_order_relaxed);
+		const UINT32 write = writeIdx.load(std::memory_order_acquire);
+
+		UINT64 numDrainDropped = 0;
+		for(UINT32 i = read; i != write; i++)
+		{
+			const TraceEvent& event = events[i % CAPACITY];
+
+			// Events nest, so begin events dropped here are always nested within the kept ones, which are nested within
+			// the cleared ones
+			if(event.type == TraceEventType::Begin)
+			{
+				if(drainDroppedDepth > 0 || output.size() >= maxEvents)
+				{
+					drainDroppedDepth++;
+					numDrainDropped++;
+					continue;
+				}
+
+				drainedDepth++;
+			}
+			else
+			{
+				if(drainDroppedDepth > 0)
+				{
+					drainDroppedDepth--;
+					numDrainDropped++;
+					continue;
+				}
+
+				if(drainedDepth == 0)
+				{
+					if(clearedDepth > 0)
+						clearedDepth--;
+
+					continue;
+				}
+
+				drainedDepth--;
+			}
+
+			output.push_back(event);
+			output.back().threadIdx = threadIdx;
+		}
+
+		readIdx.store(write, std::memory_order_release);
+		return numDrainDropped;
+	}
+
+	void ProfilerCPU::TraceEventBuffer::onOutputCleared()
+	{
+		clearedDepth += drainedDepth;
+		drainedDepth = 0;
+	}
+
 	BS_THREADLOCAL ProfilerCPU::ThreadInfo* ProfilerCPU::ThreadInfo::activeThread = nullptr;
 	
-	ProfilerCPU::ThreadInfo::ThreadInfo()
-		:frameAlloc(1024 * 512)
+	ProfilerCPU::ThreadInfo::ThreadInfo(UINT32 index)
+		:index(index), frameAlloc(1024 * 512)
 	{
 
 	}
+
+	ProfilerCPU::ThreadInfo::~ThreadInfo()
+	{
+		if(traceEvents != nullptr)
+			bs_delete<TraceEventBuffer, ProfilerAlloc>(traceEvents);
+	}
 	
-	void ProfilerCPU::ThreadInfo::begin(const char* _name)
+	void ProfilerCPU::ThreadInfo::begin(const char* _name, CPUProfilerMode _mode)
 	{
 		if(isActive)
 		{
@@ -173,6 +338,10 @@ namespace bs
 			return;
 		}
 
+		mode = _mode;
+		if(recordsTrace())
+			traceEvents->push(TraceEventType::Begin, _name);
+
 		if(rootBlock == nullptr)
 			rootBlock = getBlock(_name);
 
@@ -216,6 +385,13 @@ namespace bs
 			}
 		}
 
+		if(recordsTrace())
+		{
+			// Closes the root block, as well as any samples that were left open
+			while(traceEvents->depth > 0 || traceEvents->droppedDepth > 0)
+				traceEvents->push(TraceEventType::End, nullptr);
+		}
+
 		isActive = false;
 		activeBlock = ActiveBlock();
 
@@ -277,6 +453,8 @@ namespace bs
 
 	ProfilerCPU::ProfilerCPU()
 	{
+		mTraceStartTimeNs = getTraceTimeNs();
+
 		// TODO - We only estimate overhead on program start. It might be better to estimate it each time beginThread is called,
 		// and keep separate values per thread.
 		estimateTimerOverhead();
@@ -297,17 +475,31 @@ namespace bs
 		ThreadInfo* thread = ThreadInfo::activeThread;
 		if(thread == nullptr)
 		{
-			ThreadInfo::activeThread = bs_new<ThreadInfo, ProfilerAlloc>();
-			thread = ThreadInfo::activeThread;
+			Lock lock(mThreadSync);
 
-			{
-				Lock lock(mThreadSync);
+			thread = bs_new<ThreadInfo, ProfilerAlloc>((UINT32)mActiveThreads.size());
+			thread->name = name;
 
-				mActiveThreads.push_back(thread);
-			}
+			mActiveThreads.push_back(thread);
+			mThreadNames.push_back(thread->name);
+
+			ThreadInfo::activeThread = thread;
 		}
 
-		thread->begin(name);
+		const CPUProfilerMode mode = mMode.load(std::memory_order_relaxed);
+		if(mode != CPUProfilerMode::Report && (thread->traceEvents == nullptr || thread->name != name))
+		{
+			// Both the buffer and the name are read when merging and exporting the trace from another thread
+			Lock lock(mThreadSync);
+
+			if(thread->traceEvents == nullptr)
+				thread->traceEvents = bs_new<TraceEventBuffer, ProfilerAlloc>();
+
+			thread->name = name;
+			mThreadNames[thread->index] = thread->name;
+		}
+
+		thread->begin(name, mode);
 	}
 
 	void ProfilerCPU::endThread()
@@ -325,6 +517,14 @@ namespace bs
 			thread = ThreadInfo::activeThread;
 		}
 
+		if(thread->recordsTrace())
+		{
+			thread->traceEvents->push(TraceEventType::Begin, name);
+
+			if(!thread->recordsReport())
+				return;
+		}
+
 		ProfiledBlock* parent = thread->activeBlock.block;
 		ProfiledBlock* block = nullptr;
 		
@@ -350,6 +550,12 @@ namespace bs
 	void ProfilerCPU::endSample(const char* name)
 	{
 		ThreadInfo* thread = ThreadInfo::activeThread;
+		if(!thread->recordsReport())
+		{
+			thread->traceEvents->push(TraceEventType::End, name);
+			return;
+		}
+
 		ProfiledBlock* block = thread->activeBlock.block;
 
 #if BS_DEBUG_MODE
@@ -375,6 +581,9 @@ namespace bs
 
 		block->basic.endSample();
 
+		if(thread->recordsTrace())
+			thread->traceEvents->push(TraceEventType::End, name);
+
 		thread->activeBlocks->pop();
 
 		if (!thread->activeBlocks->empty())
@@ -390,7 +599,18 @@ namespace bs
 		
 		ThreadInfo* thread = ThreadInfo::activeThread;
 		if(thread == nullptr || !thread->isActive)
+		{
 			beginThread("Unknown");
+			thread = ThreadInfo::activeThread;
+		}
+
+		if(thread->recordsTrace())
+		{
+			thread->traceEvents->push(TraceEventType::Begin, name);
+
+			if(!thread->recordsReport())
+				return;
+		}
 
 		ProfiledBlock* parent = thread->activeBlock.block;
 		ProfiledBlock* block = nullptr;
@@ -417,6 +637,12 @@ namespace bs
 	void ProfilerCPU::endSamplePrecise(const char* name)
 	{
 		ThreadInfo* thread = ThreadInfo::activeThread;
+		if(!thread->recordsReport())
+		{
+			thread->traceEvents->push(TraceEventType::End, name);
+			return;
+		}
+
 		ProfiledBlock* block = thread->activeBlock.block;
 
 #if BS_DEBUG_MODE
@@ -442,6 +668,9 @@ namespace bs
 
 		block->precise.endSample();
 
+		if(thread->recordsTrace())
+			thread->traceEvents->push(TraceEventType::End, name);
+
 		thread->activeBlocks->pop();
 
 		if (!thread->activeBlocks->empty())
@@ -450,6 +679,149 @@ namespace bs
 			thread->activeBlock = ActiveBlock();
 	}
 
+	void ProfilerCPU::mergeTraceEvents()
+	{
+		Lock traceLock(mTraceSync);
+		Lock threadLock(mThreadSync);
+
+		for(auto& thread : mActiveThreads)
+		{
+			if(thread->traceEvents == nullptr)
+				continue;
+
+			// Keep the trace from growing without bounds if it never gets exported or cleared
+			mNumDroppedTraceEvents += thread->traceEvents->drain(thread->index, mTraceEvents, mMaxTraceEvents);
+		}
+	}
+
+	void ProfilerCPU::writeChromeTrace(const SPtr<DataStream>& stream) const
+	{
+		static constexpr UINT32 EVENTS_PER_WRITE = 4096;
+
+		const UINT64 numDropped = getNumDroppedTraceEvents();
+
+		ProfilerVector<ProfilerString> threadNames;
+		{
+			Lock lock(mThreadSync);
+			threadNames = mThreadNames;
+		}
+
+		Lock lock(mTraceSync);
+
+		StringStream output;
+		output << std::fixed << std::setprecision(3);
+
+		const auto flush = [&output, &stream]()
+		{
+			const String data = output.str();
+			stream->write(data.data(), data.size());
+
+			output.str("");
+		};
+
+		output << "{\"traceEvents\":[\n";
+		for(UINT32 i = 0; i < (UINT32)threadNames.size(); i++)
+		{
+			if(i > 0)
+				output << ",\n";
+
+			output << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i << ",\"args\":{\"name\":";
+			writeJsonString(output, threadNames[i].c_str());
+			output << "}}";
+		}
+
+		for(UINT32 i = 0; i < (UINT32)mTraceEvents.size(); i++)
+		{
+			const TraceEvent& event = mTraceEvents[i];
+
+			// Timestamps are in microseconds, relative to profiler start-up
+			const double timeUs = (INT64)(event.timeNs - mTraceStartTimeNs) / 1000.0;
+
+			if(i > 0 || !threadNames.empty())
+				output << ",\n";
+
+			if(event.type == TraceEventType::Begin)
+			{
+				output << "{\"name\":";
+				writeJsonString(output, event.name);
+				output << ",\"ph\":\"B\",\"pid\":0,\"tid\":" << event.threadIdx << ",\"ts\":" << timeUs << "}";
+			}
+			else
+				output << "{\"ph\":\"E\",\"pid\":0,\"tid\":" << event.threadIdx << ",\"ts\":" << timeUs << "}";
+
+			if(((i + 1) % EVENTS_PER_WRITE) == 0)
+				flush();
+		}
+
+		output << "\n],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{";
+		output << std::setprecision(9);
+		output << "\"timerOverheadMs\":" << mOverhead.timerMs << ",";
+		output << "\"timerOverheadCycles\":" << mOverhead.timerCycles << ",";
+		output << "\"basicSampleOverheadMs\":" << mOverhead.basicSampleMs << ",";
+		output << "\"preciseSampleOverheadMs\":" << mOverhead.preciseSampleMs << ",";
+		output << "\"traceSampleOverheadMs\":" << mOverhead.traceSampleMs << ",";
+		output << "\"droppedEvents\":" << numDropped << "}}\n";
+		flush();
+	}
+
+	void ProfilerCPU::saveChromeTrace(const Path& path) const
+	{
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+		if(stream == nullptr)
+		{
+			BS_LOG(Error, Profiler, "Unable to save the profiler trace. Cannot open the file at: {0}", path);
+			return;
+		}
+
+		writeChromeTrace(stream);
+		stream->close();
+	}
+
+	void ProfilerCPU::clearTrace()
+	{
+		Lock traceLock(mTraceSync);
+		Lock threadLock(mThreadSync);
+
+		mTraceEvents.clear();
+		mNumDroppedTraceEvents = 0;
+
+		for(auto& thread : mActiveThreads)
+		{
+			if(thread->traceEvents != nullptr)
+			{
+				thread->traceEvents->numDropped.store(0, std::memory_order_relaxed);
+				thread->traceEvents->onOutputCleared();
+			}
+		}
+	}
+
+	void ProfilerCPU::setMaxTraceEvents(UINT32 maxEvents)
+	{
+		Lock lock(mTraceSync);
+		mMaxTraceEvents = maxEvents;
+	}
+
+	UINT32 ProfilerCPU::getNumTraceEvents() const
+	{
+		Lock lock(mTraceSync);
+		return (UINT32)mTraceEvents.size();
+	}
+
+	UINT64 ProfilerCPU::getNumDroppedTraceEvents() const
+	{
+		Lock traceLock(mTraceSync);
+		Lock threadLock(mThreadSync);
+
+		UINT64 numDropped = mNumDroppedTraceEvents;
+		for(auto& thread : mActiveThreads)
+		{
+			if(thread->traceEvents != nullptr)
+				numDropped += thread->traceEvents->numDropped.load(std::memory_order_relaxed);
+		}
+
+		return numDropped;
+	}
+
 	void ProfilerCPU::reset()
 	{
 		ThreadInfo* thread = ThreadInfo::activeThread;
@@ -531,6 +903,9 @@ namespace bs
 
 			entryBasic->data.memAllocs = 0;
 			entryBasic->data.memFrees = 0;
+			for(auto& entry : entryBasic->data.memAllocatedBytes)
+				entry = 0;
+
 			entryBasic->data.totalTimeMs = 0.0;
 			entryBasic->data.maxTimeMs = 0.0;
 			for(auto& sample : curBlock->basic.samples)
@@ -539,6 +914,9 @@ namespace bs
 				entryBasic->data.maxTimeMs = std::max(entryBasic->data.maxTimeMs, sample.time);
 				entryBasic->data.memAllocs += sample.numAllocs;
 				entryBasic->data.memFrees += sample.numFrees;
+
+				for(UINT32 i = 0; i < (UINT32)MemoryCategory::Count; i++)
+					entryBasic->data.memAllocatedBytes[i] += sample.numAllocatedBytes[i];
 			}
 
 			entryBasic->data.numCalls = (UINT32)curBlock->basic.samples.size();
@@ -571,6 +949,9 @@ namespace bs
 
 			entryPrecise->data.memAllocs = 0;
 			entryPrecise->data.memFrees = 0;
+			for(auto& entry : entryPrecise->data.memAllocatedBytes)
+				entry = 0;
+
 			entryPrecise->data.totalCycles = 0;
 			entryPrecise->data.maxCycles = 0;
 			for(auto& sample : curBlock->precise.samples)
@@ -579,6 +960,9 @@ namespace bs
 				entryPrecise->data.maxCycles = std::max(entryPrecise->data.maxCycles, sample.cycles);
 				entryPrecise->data.memAllocs += sample.numAllocs;
 				entryPrecise->data.memFrees += sample.numFrees;
+
+				for(UINT32 i = 0; i < (UINT32)MemoryCategory::Count; i++)
+					entryPrecise->data.memAllocatedBytes[i] += sample.numAllocatedBytes[i];
 			}
 
 			entryPrecise->data.numCalls = (UINT32)curBlock->precise.samples.size();
@@ -794,6 +1178,7 @@ namespace bs
 		mPreciseSamplingOverheadMs = 1000000.0;
 		mBasicSamplingOverheadCycles = 1000000;
 		mPreciseSamplingOverheadCycles = 1000000;
+		double traceSamplingOverheadMs = 1000000.0;
 		for (UINT32 tries = 0; tries < 3; tries++)
 		{
 			/************************************************************************/
@@ -994,7 +1379,67 @@ namespace bs
 			UINT64 avgCyclesPrecise = timerPreciseB.cycles/(sampleReps * 10 + sampleReps * 5);
 			if (avgCyclesPrecise < mPreciseSamplingOverheadCycles)
 				mPreciseSamplingOverheadCycles = avgCyclesPrecise;
+
+			/************************************************************************/
+			/* 				AVERAGE TIME IN MS FOR TRACE SAMPLING                   */
+			/************************************************************************/
+
+			const CPUProfilerMode prevMode = mMode.load();
+			mMode.store(CPUProfilerMode::Trace);
+
+			Timer timerC;
+			timerC.start();
+			beginThread("Main");
+
+			for (UINT32 i = 0; i < sampleReps; i++)
+			{
+				beginSample("TestAvg1");
+				endSample("TestAvg1");
+				beginSample("TestAvg2");
+				endSample("TestAvg2");
+				beginSample("TestAvg3");
+				endSample("TestAvg3");
+				beginSample("TestAvg4");
+				endSample("TestAvg4");
+				beginSample("TestAvg5");
+				endSample("TestAvg5");
+				beginSample("TestAvg6");
+				endSample("TestAvg6");
+				beginSample("TestAvg7");
+				endSample("TestAvg7");
+				beginSample("TestAvg8");
+				endSample("TestAvg8");
+				beginSample("TestAvg9");
+				endSample("TestAvg9");
+				beginSample("TestAvg10");
+				endSample("TestAvg10");
+			}
+
+			endThread();
+			timerC.stop();
+
+			reset();
+			mMode.store(prevMode);
+
+			double avgTimeTrace = double(timerC.time)/double(sampleReps * 10) - mBasicTimerOverhead;
+			if (avgTimeTrace < traceSamplingOverheadMs)
+				traceSamplingOverheadMs = avgTimeTrace;
 		}
+
+		// Discard the events recorded above along with the event buffer, it is re-created once trace mode is enabled
+		ThreadInfo* thread = ThreadInfo::activeThread;
+		{
+			Lock lock(mThreadSync);
+
+			bs_delete<TraceEventBuffer, ProfilerAlloc>(thread->traceEvents);
+			thread->traceEvents = nullptr;
+		}
+
+		mOverhead.timerMs = mBasicTimerOverhead;
+		mOverhead.timerCycles = mPreciseTimerOverhead;
+		mOverhead.basicSampleMs = mBasicSamplingOverheadMs;
+		mOverhead.preciseSampleMs = mPreciseSamplingOverheadMs;
+		mOverhead.traceSampleMs = std::max(traceSamplingOverheadMs, 0.0);
 	}
 
 	ProfilerCPU& gProfilerCPU()
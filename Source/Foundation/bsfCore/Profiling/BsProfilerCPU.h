@@ -13,6 +13,35 @@ namespace bs
 
 	class CPUProfilerReport;
 
+	/** Determines what kind of data does the CPU profiler record when samples are taken. */
+	enum class CPUProfilerMode
+	{
+		/**
+		 * Samples are accumulated in a hierarchy of named blocks, from which a CPUProfilerReport is generated at the end
+		 * of the frame.
+		 */
+		Report,
+		/**
+		 * Only a begin and end timestamp is recorded for each sample, in a per-thread lock-free buffer. The events are
+		 * merged at the end of the frame and can be exported in the Chrome trace format. This has significantly lower
+		 * overhead than Report, but CPUProfilerReport will contain no data apart from the thread's root block.
+		 */
+		Trace,
+		/** Both the report hierarchy and the trace events are recorded. */
+		ReportAndTrace
+	};
+
+	/** Contains the estimated overhead introduced by the profiler itself. */
+	struct CPUProfilerOverhead
+	{
+		double timerMs = 0.0; /**< Time it takes to start and stop the timer used for basic samples. In milliseconds. */
+		UINT64 timerCycles = 0; /**< Number of cycles it takes to start and stop the timer used for precise samples. */
+
+		double basicSampleMs = 0.0; /**< Time a single beginSample/endSample pair takes. In milliseconds. */
+		double preciseSampleMs = 0.0; /**< Time a single beginSamplePrecise/endSamplePrecise pair takes. In milliseconds. */
+		double traceSampleMs = 0.0; /**< Time a single beginSample/endSample pair takes in Trace mode. In milliseconds. */
+	};
+
 	/**
 	 * Provides various performance measuring methods.
 	 * 			
@@ -83,6 +112,7 @@ namespace bs
 			double time;
 			UINT64 numAllocs;
 			UINT64 numFrees;
+			UINT64 numAllocatedBytes[(UINT32)MemoryCategory::Count] = { };
 		};
 
 		/**
@@ -101,6 +131,7 @@ namespace bs
 			UINT64 cycles;
 			UINT64 numAllocs;
 			UINT64 numFrees;
+			UINT64 numAllocatedBytes[(UINT32)MemoryCategory::Count] = { };
 		};
 
 		/**	Contains basic (time based) profiling data contained in a profiling block. */
@@ -128,6 +159,7 @@ namespace bs
 
 			UINT64 memAllocs;
 			UINT64 memFrees;
+			UINT64 memAllocatedBytes[(UINT32)MemoryCategory::Count];
 		};
 
 		/**	Contains precise (CPU cycle based) profiling data contained in a profiling block. */
@@ -155,6 +187,7 @@ namespace bs
 
 			UINT64 memAllocs;
 			UINT64 memFrees;
+			UINT64 memAllocatedBytes[(UINT32)MemoryCategory::Count];
 		};
 
 		/**
@@ -177,6 +210,74 @@ namespace bs
 			Vector<ProfiledBlock*, StdFrameAlloc<ProfiledBlock*>> children;
 		};
 
+		/** Type of an event recorded in trace mode. */
+		enum class TraceEventType : UINT8
+		{
+			Begin,
+			End
+		};
+
+		/**
+		 * Single timestamped event recorded in trace mode. The name is stored inline so the event doesn't depend on the
+		 * lifetime of the string provided to beginSample().
+		 */
+		struct TraceEvent
+		{
+			static constexpr UINT32 MAX_NAME_LENGTH = 47;
+
+			UINT64 timeNs;
+			UINT32 threadIdx;
+			TraceEventType type;
+			char name[MAX_NAME_LENGTH + 1];
+		};
+
+		/**
+		 * Fixed capacity ring buffer of trace events. Written to only by the thread that owns it, and drained by the thread
+		 * merging the events at the end of the frame, so neither side needs to lock.
+		 */
+		struct TraceEventBuffer
+		{
+			static constexpr UINT32 CAPACITY = 16384;
+
+			/**
+			 * Records a new event. Room for the end event of every recorded begin event is reserved up front. If the buffer
+			 * is full the begin event is dropped, together with all events nested within it and its end event, so the
+			 * recorded begin/end pairs always match.
+			 */
+			void push(TraceEventType type, const char* name);
+
+			/**
+			 * Moves all events written so far to the provided output vector, and tags them with the provided thread index.
+			 * Once the output holds @p maxEvents events any further begin events are dropped, together with all events
+			 * nested within them and their end events. End events of begin events already in the output are always kept,
+			 * so the output may exceed the limit by the number of samples open on the thread.
+			 *
+			 * @return	Number of events that were dropped.
+			 *
+			 * @note	Only one thread may drain the buffer at a time.
+			 */
+			UINT64 drain(UINT32 threadIdx, ProfilerVector<TraceEvent>& output, UINT32 maxEvents);
+
+			/**
+			 * Notifies the buffer that the output it was draining into has been cleared. End events of begin events that
+			 * were drained before will be skipped, as their begin events no longer exist in the output.
+			 */
+			void onOutputCleared();
+
+			TraceEvent events[CAPACITY];
+			std::atomic<UINT32> writeIdx{0};
+			std::atomic<UINT32> readIdx{0};
+
+			UINT32 depth = 0; /**< Number of recorded begin events not yet closed. */
+			UINT32 droppedDepth = 0; /**< Number of dropped begin events not yet closed. */
+			std::atomic<UINT64> numDropped{0};
+
+			// Accessed only by the thread draining the buffer
+			UINT32 drainedDepth = 0; /**< Number of drained begin events not yet closed. */
+			UINT32 drainDroppedDepth = 0; /**< Number of begin events dropped during drain, not yet closed. */
+			UINT32 clearedDepth = 0; /**< Number of drained begin events removed from the output, not yet closed. */
+		};
+
 		/**	CPU sampling type. */
 		enum class ActiveSamplingType
 		{
@@ -202,12 +303,13 @@ namespace bs
 		/** Contains data about an active profiling thread. */
 		struct ThreadInfo
 		{
-			ThreadInfo();
+			ThreadInfo(UINT32 index);
+			~ThreadInfo();
 
 			/**
 			 * Starts profiling on the thread. New primary profiling block is created with the given name.
 			 */
-			void begin(const char* _name);
+			void begin(const char* _name, CPUProfilerMode _mode);
 
 			/**
 			 * Ends profiling on the thread. You should end all samples before calling this, but if you don't they will be
@@ -227,9 +329,20 @@ namespace bs
 			/** Deletes the provided block. */
 			void releaseBlock(ProfiledBlock* block);
 
+			/** Returns true if samples should be recorded in the report hierarchy. */
+			bool recordsReport() const { return mode != CPUProfilerMode::Trace; }
+
+			/** Returns true if samples should be recorded as trace events. */
+			bool recordsTrace() const { return mode != CPUProfilerMode::Report; }
+
 			static BS_THREADLOCAL ThreadInfo* activeThread;
 			bool isActive = false;
 
+			UINT32 index;
+			ProfilerString name;
+			CPUProfilerMode mode = CPUProfilerMode::Report;
+			TraceEventBuffer* traceEvents = nullptr;
+
 			ProfiledBlock* rootBlock = nullptr;
 
 			FrameAlloc frameAlloc;
@@ -296,6 +409,54 @@ namespace bs
 		/** Clears all sampling data, and ends any unfinished sampling blocks. */
 		void reset();
 
+		/**
+		 * Changes what kind of data is recorded when samples are taken. The change takes effect on each thread the next
+		 * time beginThread() is called on it.
+		 */
+		void setMode(CPUProfilerMode mode) { mMode.store(mode); }
+
+		/** Returns the mode set by setMode(). */
+		CPUProfilerMode getMode() const { return mMode.load(); }
+
+		/** Returns the estimated overhead the profiler introduces when taking samples. */
+		const CPUProfilerOverhead& getOverhead() const { return mOverhead; }
+
+		/**
+		 * Moves all trace events recorded by all threads since the last call into the merged trace. Normally called once
+		 * per frame by the ProfilingManager. Does nothing if no thread records trace events.
+		 */
+		void mergeTraceEvents();
+
+		/**
+		 * Writes all merged trace events in the Chrome trace event JSON format, readable by chrome://tracing and Perfetto.
+		 * Each thread is named according to the name provided to beginThread(). Estimated profiler overhead is written in
+		 * the "otherData" field.
+		 *
+		 * @note	Only events merged by mergeTraceEvents() are written.
+		 */
+		void writeChromeTrace(const SPtr<DataStream>& stream) const;
+
+		/** Saves all merged trace events to a file at the provided path. See writeChromeTrace(). */
+		void saveChromeTrace(const Path& path) const;
+
+		/** Discards all the merged trace events. */
+		void clearTrace();
+
+		/**
+		 * Sets the maximum number of events kept in the merged trace. Once reached, new samples are dropped until the
+		 * trace is cleared, while samples already in the trace still get their end events.
+		 */
+		void setMaxTraceEvents(UINT32 maxEvents);
+
+		/** Returns the number of trace events currently in the merged trace. */
+		UINT32 getNumTraceEvents() const;
+
+		/**
+		 * Returns the number of trace events that were dropped because a thread's event buffer was full, or the merged
+		 * trace reached its maximum size.
+		 */
+		UINT64 getNumDroppedTraceEvents() const;
+
 		/**
 		 * Generates a report from all previously sampled data.
 		 * 			
@@ -312,6 +473,9 @@ namespace bs
 		void estimateTimerOverhead();
 
 	private:
+		/** Default maximum number of events that will be kept in the merged trace. */
+		static constexpr UINT32 DEFAULT_MAX_TRACE_EVENTS = 4 * 1024 * 1024;
+
 		double mBasicTimerOverhead = 0.0;
 		UINT64 mPreciseTimerOverhead = 0;
 
@@ -320,8 +484,19 @@ namespace bs
 		UINT64 mBasicSamplingOverheadCycles = 0;
 		UINT64 mPreciseSamplingOverheadCycles = 0;
 
+		CPUProfilerOverhead mOverhead;
+
+		std::atomic<CPUProfilerMode> mMode{CPUProfilerMode::Report};
+
 		ProfilerVector<ThreadInfo*> mActiveThreads;
-		Mutex mThreadSync;
+		ProfilerVector<ProfilerString> mThreadNames;
+		mutable Mutex mThreadSync;
+
+		ProfilerVector<TraceEvent> mTraceEvents;
+		UINT64 mTraceStartTimeNs = 0;
+		UINT64 mNumDroppedTraceEvents = 0;
+		UINT32 mMaxTraceEvents = DEFAULT_MAX_TRACE_EVENTS;
+		mutable Mutex mTraceSync;
 	};
 
 	/** Profiling entry containing information about a single CPU profiling block containing timing information. */
@@ -337,6 +512,9 @@ namespace bs
 			UINT64 memAllocs; /**< Number of memory allocations that happened within the block. */
 			UINT64 memFrees; /**< Number of memory deallocations that happened within the block. */
 
+			/** Number of bytes allocated within the block, for each MemoryCategory. */
+			UINT64 memAllocatedBytes[(UINT32)MemoryCategory::Count] = { };
+
 			double avgTimeMs = 0.0; /**< Average time it took to execute the block, per call. In milliseconds. */
 			double maxTimeMs = 0.0; /**< Maximum time of a single call in the block. In milliseconds. */
 			double totalTimeMs = 0.0; /**< Total time the block took, across all calls. In milliseconds. */
@@ -369,6 +547,9 @@ namespace bs
 			UINT64 memAllocs; /**< Number of memory allocations that happened within the block. */
 			UINT64 memFrees; /**< Number of memory deallocations that happened within the block. */
 
+			/** Number of bytes allocated within the block, for each MemoryCategory. */
+			UINT64 memAllocatedBytes[(UINT32)MemoryCategory::Count] = { };
+
 			UINT64 avgCycles = 0; /**< Average number of cycles it took to execute the block, per call. */
 			UINT64 maxCycles = 0; /**< Maximum number of cycles of a single call in the block. */
 			UINT64 totalCycles = 0; /**< Total number of cycles across all calls in the block. */
@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Profiling/BsProfilingManager.h"
 #include "Math/BsMath.h"
+#include "Threading/BsThreadPool.h"
 
 namespace bs
 {
@@ -29,6 +30,18 @@ namespace bs
 
 		gProfilerCPU().reset();
 
+		// Events from all threads, including the core thread, are merged once per frame from the sim thread
+		gProfilerCPU().mergeTraceEvents();
+
+		// Threads are created by the pool from any thread, so just report the difference since the last frame
+		if(ThreadPool::isStarted())
+		{
+			const UINT64 numThreadsCreated = ThreadPool::instance().getNumCreated();
+			mSavedSimReports[mNextSimReportIdx].numThreadsCreated = (UINT32)(numThreadsCreated - mLastNumThreadsCreated);
+
+			mLastNumThreadsCreated = numThreadsCreated;
+		}
+
 		mNextSimReportIdx = (mNextSimReportIdx + 1) % NUM_SAVED_FRAMES;
 #endif
 	}
@@ -16,6 +16,9 @@ namespace bs
 	struct ProfilerReport
 	{
 		CPUProfilerReport cpuReport;
+
+		/** Number of threads that were created by the ThreadPool during the frame. Should be zero in steady state. */
+		UINT32 numThreadsCreated = 0;
 	};
 
 	/**	Type of thread used by the profiler. */
@@ -68,6 +71,8 @@ namespace bs
 		ProfilerReport* mSavedCoreReports = nullptr;
 		UINT32 mNextCoreReportIdx = 0;
 
+		UINT64 mLastNumThreadsCreated = 0;
+
 		mutable Mutex mSync;
 	};
 
@@ -102,9 +102,17 @@ namespace bs
 		}
 	}
 
+	GpuParamBlockBuffer::GpuParamBlockBuffer(const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size)
+		: mBuffer(parent->mBuffer), mUsage(parent->mUsage), mSize(size), mCachedData(parent->mCachedData + offset)
+		, mGPUBufferDirty(false), mParentBuffer(parent), mParentOffset(offset)
+	{
+		assert(mBuffer != nullptr && (offset + size) <= parent->mSize);
+	}
+
 	GpuParamBlockBuffer::~GpuParamBlockBuffer()
 	{
-		if (mCachedData != nullptr)
+		// Ranges reference the data of their parent
+		if (mCachedData != nullptr && mParentBuffer == nullptr)
 			bs_free(mCachedData);
 
 		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_GpuParamBuffer);
@@ -129,7 +137,7 @@ namespace bs
 #endif
 
 		memcpy(mCachedData + offset, data, size);
-		mGPUBufferDirty = true;
+		markGPUDirty();
 	}
 
 	void GpuParamBlockBuffer::read(UINT32 offset, void* data, UINT32 size)
@@ -158,11 +166,17 @@ namespace bs
 #endif
 
 		memset(mCachedData + offset, 0, size);
-		mGPUBufferDirty = true;
+		markGPUDirty();
 	}
 
 	void GpuParamBlockBuffer::flushToGPU(UINT32 queueIdx)
 	{
+		if (mParentBuffer != nullptr)
+		{
+			mParentBuffer->flushToGPU(queueIdx);
+			return;
+		}
+
 		if (mGPUBufferDirty)
 		{
 			writeToGPU(mCachedData, queueIdx);
@@ -172,11 +186,26 @@ namespace bs
 
 	void GpuParamBlockBuffer::writeToGPU(const UINT8* data, UINT32 queueIdx)
 	{
+		if (mParentBuffer != nullptr)
+		{
+			write(0, data, mSize);
+			mParentBuffer->flushToGPU(queueIdx);
+			return;
+		}
+
 		mBuffer->writeData(0, mSize, data, BWT_DISCARD, queueIdx);
 
 		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
 	}
 
+	void GpuParamBlockBuffer::markGPUDirty()
+	{
+		if (mParentBuffer != nullptr)
+			mParentBuffer->mGPUBufferDirty = true;
+		else
+			mGPUBufferDirty = true;
+	}
+
 	void GpuParamBlockBuffer::syncToCore(const CoreSyncData& data)
 	{
 		assert(mSize == data.getBufferSize());
@@ -89,6 +89,18 @@ namespace bs
 	{
 	public:
 		GpuParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask);
+
+		/**
+		 * Creates a buffer representing a range of a larger parameter block buffer. The range shares both the GPU
+		 * buffer and the cached CPU data of the parent, and writes to it are uploaded together with the rest of the
+		 * parent.
+		 *
+		 * @param[in]	parent		Buffer to reference a range of. Must be initialized.
+		 * @param[in]	offset		Offset of the range in the parent buffer, in bytes. Must be a multiple of
+		 *							RenderAPICapabilities::paramBlockBufferOffsetAlignment.
+		 * @param[in]	size		Size of the range in bytes.
+		 */
+		GpuParamBlockBuffer(const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size);
 		virtual ~GpuParamBlockBuffer();
 
 		/**
@@ -100,7 +112,8 @@ namespace bs
 		void writeToGPU(const UINT8* data, UINT32 queueIdx = 0);
 
 		/**
-		 * Flushes any cached data into the actual GPU buffer.
+		 * Flushes any cached data into the actual GPU buffer. If the buffer is a range of another buffer, the entire
+		 * parent buffer is flushed, including the changes to any of its other ranges.
 		 *
 		 * @param[in]	queueIdx	Device queue to perform the write operation on. See @ref queuesDoc.
 		 */
@@ -132,6 +145,12 @@ namespace bs
 		/**	Returns the size of the buffer in bytes. */
 		UINT32 getSize() const { return mSize; }
 
+		/** Returns the buffer this buffer is a range of, or null if the buffer has its own storage. */
+		const SPtr<GpuParamBlockBuffer>& getParentBuffer() const { return mParentBuffer; }
+
+		/** Returns the offset of the buffer's data in the parent buffer, in bytes. Zero if the buffer has no parent. */
+		UINT32 getParentOffset() const { return mParentOffset; }
+
 		/** @copydoc HardwareBufferManager::createGpuParamBlockBuffer */
 		static SPtr<GpuParamBlockBuffer> create(UINT32 size, GpuBufferUsage usage = GBU_DYNAMIC,
 			GpuDeviceFlags deviceMask = GDF_DEFAULT);
@@ -145,6 +164,9 @@ namespace bs
 		/** @copydoc CoreObject::initialize */
 		void initialize() override;
 
+		/** Marks the cached data as changed, so it gets uploaded on the next flush. */
+		void markGPUDirty();
+
 		HardwareBuffer* mBuffer;
 
 		GpuBufferUsage mUsage;
@@ -152,6 +174,9 @@ namespace bs
 
 		UINT8* mCachedData;
 		bool mGPUBufferDirty;
+
+		SPtr<GpuParamBlockBuffer> mParentBuffer;
+		UINT32 mParentOffset = 0;
 	};
 
 	/** @} */
@@ -0,0 +1,95 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "RenderAPI/BsGpuParamBlockBufferPool.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+#include "RenderAPI/BsRenderAPI.h"
+#include "Managers/BsHardwareBufferManager.h"
+
+namespace bs { namespace ct
+{
+	GpuParamBlockBufferPool::GpuParamBlockBufferPool(UINT32 pageSize)
+		:GpuParamBlockBufferPool(RenderAPI::instance().getCapabilities(0), pageSize)
+	{ }
+
+	GpuParamBlockBufferPool::GpuParamBlockBufferPool(const RenderAPICapabilities& caps, UINT32 pageSize)
+		:mPageSize(pageSize)
+	{
+		if(caps.hasCapability(RSC_PARAM_BLOCK_BUFFER_RANGES))
+		{
+			mUseRanges = true;
+			mAlignment = std::max(caps.paramBlockBufferOffsetAlignment, 1U);
+		}
+	}
+
+	SPtr<GpuParamBlockBuffer> GpuParamBlockBufferPool::alloc(UINT32 size)
+	{
+		const UINT32 alignedSize = getAlignedSize(size);
+		if(!mUseRanges || alignedSize > mPageSize)
+			return GpuParamBlockBuffer::create(size);
+
+		Range range;
+		Vector<Range>& freeRanges = mFreeRanges[alignedSize];
+		if(!freeRanges.empty())
+		{
+			range = freeRanges.back();
+			freeRanges.pop_back();
+		}
+		else
+		{
+			if(mPages.empty() || (mLastPageOffset + alignedSize) > mPageSize)
+			{
+				mPages.push_back(GpuParamBlockBuffer::create(mPageSize));
+				mLastPageOffset = 0;
+			}
+
+			range.page = (UINT32)mPages.size() - 1;
+			range.offset = mLastPageOffset;
+
+			mLastPageOffset += alignedSize;
+		}
+
+		SPtr<GpuParamBlockBuffer> buffer = HardwareBufferManager::instance().createGpuParamBlockBufferRange(
+			mPages[range.page], range.offset, size);
+
+		if(buffer == nullptr)
+		{
+			BS_LOG(Warning, RenderBackend, "Failed to create a parameter block buffer range. Allocating separate buffers "
+				"instead.");
+
+			freeRanges.push_back(range);
+			mUseRanges = false;
+
+			return GpuParamBlockBuffer::create(size);
+		}
+
+		// Ranges can be reused, in which case they contain data from their previous owner
+		buffer->zeroOut(0, size);
+		return buffer;
+	}
+
+	void GpuParamBlockBufferPool::free(const SPtr<GpuParamBlockBuffer>& buffer)
+	{
+		// Buffers that aren't ranges get released together with their last reference
+		const SPtr<GpuParamBlockBuffer>& parent = buffer->getParentBuffer();
+		if(parent == nullptr)
+			return;
+
+		const auto iterFind = std::find(mPages.begin(), mPages.end(), parent);
+		if(iterFind == mPages.end())
+		{
+			assert(false && "Freeing a buffer not allocated from this pool.");
+			return;
+		}
+
+		Range range;
+		range.page = (UINT32)(iterFind - mPages.begin());
+		range.offset = buffer->getParentOffset();
+
+		mFreeRanges[getAlignedSize(buffer->getSize())].push_back(range);
+	}
+
+	UINT32 GpuParamBlockBufferPool::getAlignedSize(UINT32 size) const
+	{
+		return Math::divideAndRoundUp(size, mAlignment) * mAlignment;
+	}
+}}
@@ -0,0 +1,74 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderAPI-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Allocates parameter block buffers as ranges of a few large buffers (pages). Data of all the ranges in a page is
+	 * uploaded to the GPU with a single write, instead of a write per buffer, which makes this useful for large numbers
+	 * of small buffers such as per-object parameters. Flushing any range uploads its entire page, so ideally all the
+	 * ranges are written to before any of them is flushed.
+	 *
+	 * If the render backend doesn't support RSC_PARAM_BLOCK_BUFFER_RANGES, or fails to create a range, normal buffers are
+	 * allocated instead.
+	 *
+	 * @note	Core thread only.
+	 */
+	class BS_CORE_EXPORT GpuParamBlockBufferPool
+	{
+	public:
+		/**
+		 * Constructs a new pool.
+		 *
+		 * @param[in]	pageSize	Size of the buffers ranges are allocated from, in bytes. Larger pages require fewer
+		 *							writes when many of the ranges change, but upload more data when only a few do.
+		 */
+		GpuParamBlockBufferPool(UINT32 pageSize = 16 * 1024);
+
+		/**
+		 * Constructs a new pool that allocates buffers according to the provided capabilities, instead of the
+		 * capabilities of the active render API.
+		 *
+		 * @param[in]	caps		Capabilities determining if ranges are used, and the alignment of their offsets.
+		 * @param[in]	pageSize	Size of the buffers ranges are allocated from, in bytes.
+		 */
+		GpuParamBlockBufferPool(const RenderAPICapabilities& caps, UINT32 pageSize = 16 * 1024);
+
+		/** Allocates a new parameter block buffer of the provided size. Contents of the buffer are zeroed out. */
+		SPtr<GpuParamBlockBuffer> alloc(UINT32 size);
+
+		/**
+		 * Releases a buffer allocated with alloc(), allowing its memory to be used for other buffers. The buffer must
+		 * not be written to or bound after this call.
+		 */
+		void free(const SPtr<GpuParamBlockBuffer>& buffer);
+
+	private:
+		/** Location of an allocated range. */
+		struct Range
+		{
+			UINT32 page;
+			UINT32 offset;
+		};
+
+		/** Returns the size of the memory taken up by a range of the provided size. */
+		UINT32 getAlignedSize(UINT32 size) const;
+
+		UINT32 mPageSize;
+		UINT32 mAlignment = 1;
+		bool mUseRanges = false;
+
+		Vector<SPtr<GpuParamBlockBuffer>> mPages;
+		UINT32 mLastPageOffset = 0;
+		UnorderedMap<UINT32, Vector<Range>> mFreeRanges;
+	};
+
+	/** @} */
+}}
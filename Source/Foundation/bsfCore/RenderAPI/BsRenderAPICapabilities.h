@@ -59,6 +59,8 @@ namespace bs
 		RSC_RENDER_TARGET_LAYERS		= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 10),
 		/** Has native support for command buffers that can be populated from secondary threads. */
 		RSC_MULTI_THREADED_CB			= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 11),
+		/** Supports binding a range of a larger parameter block buffer to a GPU program. */
+		RSC_PARAM_BLOCK_BUFFER_RANGES	= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 12),
 	};
 
 	/** Conventions used for a specific render backend. */
@@ -164,6 +166,12 @@ namespace bs
 		/** Total number of load-store texture units available. */
 		UINT16 numCombinedLoadStoreTextureUnits = 0;
 
+		/**
+		 * Alignment required for the offset of a parameter block buffer range in its parent buffer, in bytes. Only
+		 * relevant if RSC_PARAM_BLOCK_BUFFER_RANGES is supported.
+		 */
+		UINT32 paramBlockBufferOffsetAlignment = 256;
+
 		/** Maximum number of vertex buffers we can bind at once. */
 		UINT32 maxBoundVertexBuffers = 0;
 
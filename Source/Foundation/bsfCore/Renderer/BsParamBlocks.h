@@ -7,6 +7,7 @@
 #include "RenderAPI/BsGpuParams.h"
 #include "RenderAPI/BsRenderAPI.h"
 #include "RenderAPI/BsGpuParamBlockBuffer.h"
+#include "RenderAPI/BsGpuParamBlockBufferPool.h"
 
 namespace bs { namespace ct
 {
@@ -130,6 +131,7 @@ namespace bs { namespace ct
 		}																													\
 																															\
 		SPtr<GpuParamBlockBuffer> createBuffer() const { return GpuParamBlockBuffer::create(mBlockSize); }					\
+		SPtr<GpuParamBlockBuffer> createBuffer(GpuParamBlockBufferPool& pool) const { return pool.alloc(mBlockSize); }		\
 																															\
 	private:																												\
 		friend class ParamBlockManager;																						\
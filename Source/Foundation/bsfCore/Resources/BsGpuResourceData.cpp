@@ -4,6 +4,7 @@
 #include "Private/RTTI/BsGpuResourceDataRTTI.h"
 #include "CoreThread/BsCoreThread.h"
 #include "Error/BsException.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace
 {
@@ -27,6 +28,7 @@ namespace bs
 		mData = copy.mData;
 		mLocked = copy.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
+		mMappedData = copy.mMappedData;
 	}
 
 	GpuResourceData::~GpuResourceData()
@@ -39,6 +41,7 @@ namespace bs
 		mData = rhs.mData;
 		mLocked = rhs.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
+		mMappedData = rhs.mMappedData;
 
 		return *this;
 	}
@@ -76,6 +79,13 @@ namespace bs
 
 	void GpuResourceData::freeInternalBuffer()
 	{
+		if(mMappedData != nullptr)
+		{
+			mData = nullptr;
+			mMappedData = nullptr;
+			return;
+		}
+
 		if(mData == nullptr || !mOwnsData)
 			return;
 
@@ -95,6 +105,17 @@ namespace bs
 		mOwnsData = false;
 	}
 
+	void GpuResourceData::setMappedBuffer(const SPtr<MemoryMappedDataStream>& stream)
+	{
+		verifyLockAndThread(this);
+
+		freeInternalBuffer();
+
+		mData = stream->getCurrentPtr();
+		mOwnsData = false;
+		mMappedData = stream;
+	}
+
 	void GpuResourceData::_lock() const
 	{
 		mLocked = true;
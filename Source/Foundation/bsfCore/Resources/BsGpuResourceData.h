@@ -73,6 +73,16 @@ namespace bs
 		 */
 		void setExternalBuffer(UINT8* data);
 
+		/**
+		 * Makes the internal data pointer point to data in a memory mapped file, starting at the current position of the
+		 * provided stream. No copying is done, and the stream (and therefore the mapping) is kept alive for as long as
+		 * the data is referenced by this object or any of its copies. The mapping is private, so the data can be modified
+		 * in-place without modifying the file.
+		 *
+		 * @note	If any internal data is allocated, it is freed.
+		 */
+		void setMappedBuffer(const SPtr<MemoryMappedDataStream>& stream);
+
 		/** Checks if the internal buffer is locked due to some other thread using it. */
 		bool isLocked() const { return mLocked; }
 
@@ -92,6 +102,7 @@ namespace bs
 	private:
 		UINT8* mData = nullptr;
 		bool mOwnsData = false;
+		SPtr<MemoryMappedDataStream> mMappedData;
 		mutable bool mLocked = false;
 
 		/************************************************************************/
@@ -62,6 +62,11 @@ namespace bs
 	}
 
 	HResource Resources::loadAsync(const Path& filePath, ResourceLoadFlags loadFlags)
+	{
+		return loadAsync(filePath, loadFlags, TaskPriority::Normal);
+	}
+
+	HResource Resources::loadAsync(const Path& filePath, ResourceLoadFlags loadFlags, TaskPriority priority)
 	{
 		if (!FileSystem::isFile(filePath))
 		{
@@ -75,19 +80,159 @@ namespace bs
 		if (!foundUUID)
 			uuid = UUIDGenerator::generateRandom();
 
-		return loadInternal(uuid, filePath, false, loadFlags).resource;
+		return loadInternal(uuid, filePath, false, loadFlags, priority).resource;
 	}
 
 	HResource Resources::loadFromUUID(const UUID& uuid, bool async, ResourceLoadFlags loadFlags)
+	{
+		return loadFromUUID(uuid, async, loadFlags, TaskPriority::Normal);
+	}
+
+	HResource Resources::loadFromUUID(const UUID& uuid, bool async, ResourceLoadFlags loadFlags, TaskPriority priority)
 	{
 		Path filePath;
 		getFilePathFromUUID(uuid, filePath);
 
-		return loadInternal(uuid, filePath, !async, loadFlags).resource;
+		return loadInternal(uuid, filePath, !async, loadFlags, priority).resource;
+	}
+
+	void Resources::cancelLoad(const HResource& resource)
+	{
+		Lock inProgressLock(mInProgressResourcesMutex);
+
+		auto iterFind = mInProgressResources.find(resource.getUUID());
+		if (iterFind != mInProgressResources.end())
+			cancelLoadInternal(iterFind->second);
+	}
+
+	void Resources::cancelLoadInternal(ResourceLoadData* loadData)
+	{
+		loadData->canceled = true;
+
+		for (auto& dependency : loadData->dependencies)
+		{
+			const UUID& depUUID = dependency.getUUID();
+
+			auto iterFind = mInProgressResources.find(depUUID);
+			if (iterFind == mInProgressResources.end() || iterFind->second->canceled)
+				continue;
+
+			// Keep loading dependencies that are still needed by other loads
+			bool hasActiveDependants = false;
+			auto iterFind2 = mDependantLoads.find(depUUID);
+			if (iterFind2 != mDependantLoads.end())
+			{
+				for (auto& dependant : iterFind2->second)
+					hasActiveDependants |= !dependant->canceled;
+			}
+
+			if (!hasActiveDependants)
+				cancelLoadInternal(iterFind->second);
+		}
+	}
+
+	void Resources::resumeLoadInternal(ResourceLoadData* loadData, TaskPriority priority)
+	{
+		loadData->canceled = false;
+
+		for (auto& dependency : loadData->dependencies)
+		{
+			auto iterFind = mInProgressResources.find(dependency.getUUID());
+			if (iterFind != mInProgressResources.end() && iterFind->second->canceled)
+				resumeLoadInternal(iterFind->second, priority);
+		}
+
+		// Entry is still registered, so it won't complete until the file is read again
+		if (loadData->readSkipped)
+		{
+			loadData->readSkipped = false;
+			loadData->remainingDependencies++; // Self
+			loadData->progress.store(0.0f, std::memory_order_relaxed);
+
+			HResource resource = loadData->resData.resource.lock();
+			String taskName = "Resource load: " + loadData->filePath.getFilename();
+
+			loadData->task = Task::create(taskName,
+				std::bind(&Resources::loadCallback, this, loadData->filePath, resource, loadData->loadFlags), priority);
+
+			TaskScheduler::instance().addTask(loadData->task);
+		}
+	}
+
+	SPtr<Resources::LoadGraph> Resources::buildLoadGraph(const UUID& uuid, UINT32 size, const Vector<UUID>& dependencies)
+	{
+		SPtr<LoadGraph> graph = bs_shared_ptr_new<LoadGraph>();
+
+		LoadGraph::Node& root = graph->nodes[uuid];
+		root.size = size;
+		graph->levels.push_back({ uuid });
+
+		// Walk the graph breadth first, so all resources at the same depth can be read in parallel
+		Vector<UUID> toVisit = dependencies;
+		while (!toVisit.empty())
+		{
+			const auto level = (UINT32)graph->levels.size();
+
+			Vector<UUID> levelUUIDs;
+			Vector<Path> levelPaths;
+			for (auto& entry : toVisit)
+			{
+				if (graph->nodes.find(entry) != graph->nodes.end() || isLoaded(entry, false))
+					continue;
+
+				Path filePath;
+				if (!getFilePathFromUUID(entry, filePath) || !FileSystem::isFile(filePath))
+					continue;
+
+				graph->nodes[entry].level = level;
+				levelUUIDs.push_back(entry);
+				levelPaths.push_back(filePath);
+			}
+
+			if (levelUUIDs.empty())
+				break;
+
+			const auto numEntries = (UINT32)levelUUIDs.size();
+			Vector<SPtr<SavedResourceData>> savedData(numEntries);
+			Vector<UINT32> sizes(numEntries);
+
+			const auto readSavedData = [&levelPaths, &savedData, &sizes](UINT32 start, UINT32 end)
+			{
+				for (UINT32 i = start; i < end; i++)
+				{
+					FileDecoder fs(levelPaths[i]);
+					savedData[i] = std::static_pointer_cast<SavedResourceData>(fs.decode());
+					sizes[i] = fs.getSize();
+				}
+			};
+
+			if (TaskScheduler::isStarted())
+				TaskScheduler::instance().parallelFor("Resource dependency prefetch", numEntries, 1, readSavedData);
+			else
+				readSavedData(0, numEntries);
+
+			toVisit.clear();
+			for (UINT32 i = 0; i < numEntries; i++)
+			{
+				LoadGraph::Node& node = graph->nodes[levelUUIDs[i]];
+				node.savedData = savedData[i];
+				node.size = sizes[i];
+
+				if (savedData[i] != nullptr)
+				{
+					const Vector<UUID>& nodeDependencies = savedData[i]->getDependencies();
+					toVisit.insert(toVisit.end(), nodeDependencies.begin(), nodeDependencies.end());
+				}
+			}
+
+			graph->levels.push_back(std::move(levelUUIDs));
+		}
+
+		return graph;
 	}
 
 	Resources::LoadInfo Resources::loadInternal(const UUID& uuid, const Path& filePath, bool synchronous,
-		ResourceLoadFlags loadFlags)
+		ResourceLoadFlags loadFlags, TaskPriority priority, const SPtr<LoadGraph>& graph)
 	{
 		LoadInfo output;
 
@@ -106,6 +251,10 @@ namespace bs
 			auto iterFind2 = mInProgressResources.find(uuid);
 			if (iterFind2 != mInProgressResources.end())
 			{
+				// Loading a resource whose load was canceled resumes the load, instead of completing without data
+				if (iterFind2->second->canceled)
+					resumeLoadInternal(iterFind2->second, priority);
+
 				LoadedResourceData& resData = iterFind2->second->resData;
 				output.resource = resData.resource.lock();
 				output.state = LoadInfo::AlreadyInProgress;
@@ -149,7 +298,14 @@ namespace bs
 
 				auto iterFind = mHandles.find(uuid);
 				if (iterFind != mHandles.end())
+				{
 					output.resource = iterFind->second.lock();
+
+					// Handles of canceled or failed loads are marked as loaded even though they have no data, so they
+					// need to be reset for the new load to be waited on
+					if (!output.resource.isLoaded(false))
+						output.resource.clearHandleData();
+				}
 				else
 				{
 					output.resource = HResource(uuid);
@@ -180,13 +336,26 @@ namespace bs
 				SPtr<SavedResourceData> savedResourceData;
 				if (!filePath.isEmpty())
 				{
-					// Note: Ideally this data gets cached eventually (e.g. as part of the manifest). When loading objects
-					// with a lot of dependencies (e.g. scenes) this will get called for every dependency, synchronously,
-					// which might take a while. It would be nice to just read it from a single location. Another option is
-					// to make this whole block asynchronous so every dependency does it on its own thread.
-					FileDecoder fs(filePath);
-					savedResourceData = std::static_pointer_cast<SavedResourceData>(fs.decode());
-					output.size = fs.getSize();
+					// Dependencies have their data read ahead of time by the resource that initiated the load
+					const LoadGraph::Node* prefetched = nullptr;
+					if (graph != nullptr)
+					{
+						const auto iterFindNode = graph->nodes.find(uuid);
+						if (iterFindNode != graph->nodes.end() && iterFindNode->second.savedData != nullptr)
+							prefetched = &iterFindNode->second;
+					}
+
+					if (prefetched != nullptr)
+					{
+						savedResourceData = prefetched->savedData;
+						output.size = prefetched->size;
+					}
+					else
+					{
+						FileDecoder fs(filePath);
+						savedResourceData = std::static_pointer_cast<SavedResourceData>(fs.decode());
+						output.size = fs.getSize();
+					}
 				}
 
 				// Register an in-progress load unless there is an existing load operation, or the resource is already
@@ -194,6 +363,8 @@ namespace bs
 				if(!alreadyLoading)
 				{
 					ResourceLoadData* loadData = bs_new<ResourceLoadData>(output.resource.getWeak(), 0, output.size);
+					loadData->filePath = filePath;
+					loadData->loadFlags = loadFlags;
 					mInProgressResources[uuid] = loadData;
 
 					if (loadFlags.isSet(ResourceLoadFlag::KeepInternalRef))
@@ -314,6 +485,23 @@ namespace bs
 			if (loadFlags.isSet(ResourceLoadFlag::KeepSourceData))
 				depLoadFlags |= ResourceLoadFlag::KeepSourceData;
 
+			if (loadFlags.isSet(ResourceLoadFlag::MapFile))
+				depLoadFlags |= ResourceLoadFlag::MapFile;
+
+			// Read saved data of the entire dependency graph up front, instead of every dependency reading its own data
+			// one after another before its dependencies can be issued
+			SPtr<LoadGraph> loadGraph = graph;
+			if (loadGraph == nullptr)
+			{
+				loadGraph = buildLoadGraph(uuid, output.size, dependenciesToLoad);
+
+				Lock inProgressLock(mInProgressResourcesMutex);
+
+				const auto iterFind = mInProgressResources.find(uuid);
+				if(iterFind != mInProgressResources.end())
+					iterFind->second->graph = loadGraph;
+			}
+
 			Vector<HResource> dependencies(numDependencies);
 			UINT32 dependencySize = 0;
 			for (UINT32 i = 0; i < numDependencies; i++)
@@ -323,7 +511,7 @@ namespace bs
 				Path depFilePath;
 				getFilePathFromUUID(depUUID, depFilePath);
 
-				LoadInfo loadInfo = loadInternal(depUUID, depFilePath, synchronous, depLoadFlags);
+				LoadInfo loadInfo = loadInternal(depUUID, depFilePath, synchronous, depLoadFlags, priority, loadGraph);
 				dependencies[i] = loadInfo.resource;
 
 				// Calculate the size of dependencies that still need to be loaded, for progress reporting
@@ -388,16 +576,15 @@ namespace bs
 			// Synchronous or the resource doesn't support async, read the file immediately
 			if (synchronous)
 			{
-				loadCallback(filePath, output.resource, loadFlags.isSet(ResourceLoadFlag::KeepSourceData));
+				loadCallback(filePath, output.resource, loadFlags);
 			}
 			else // Asynchronous, read the file on a worker thread
 			{
 				String fileName = filePath.getFilename();
 				String taskName = "Resource load: " + fileName;
 
-				bool keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
 				SPtr<Task> task = Task::create(taskName,
-					std::bind(&Resources::loadCallback, this, filePath, output.resource, keepSourceData));
+					std::bind(&Resources::loadCallback, this, filePath, output.resource, loadFlags), priority);
 
 				// Register the task
 				{
@@ -424,12 +611,26 @@ namespace bs
 		return output;
 	}
 
-	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData,
+	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, ResourceLoadFlags loadFlags,
 		std::atomic<float>& progress)
 	{
 		Lock fileLock = FileScheduler::getLock(filePath);
 
-		SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
+		const bool loadWithSaveData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
+
+		// Mapping the file allows large data blocks (e.g. texture pixels, mesh vertices) to be referenced directly from
+		// the mapping, instead of being copied to the heap. Resources that keep their source data are likely to be
+		// re-saved, so they are always read normally. On Windows a mapped file cannot be replaced, which would break
+		// saving over a loaded resource, so the file is read normally there as well.
+		SPtr<DataStream> stream;
+#if BS_PLATFORM != BS_PLATFORM_WIN32
+		if (loadFlags.isSet(ResourceLoadFlag::MapFile) && !loadWithSaveData)
+			stream = FileSystem::openFileMapped(filePath);
+#endif
+
+		if (stream == nullptr)
+			stream = FileSystem::openFile(filePath, true);
+
 		if (stream == nullptr)
 			return nullptr;
 
@@ -465,16 +666,24 @@ namespace bs
 
 				if (metaData->getCompressionMethod() != 0)
 				{
-					stream = Compression::decompress(stream, [&progress](float val)
+					const auto reportProgress = [&progress](float val)
 					{
 						progress.exchange(val * 0.9f, std::memory_order_relaxed);
-					});
+					};
 
-					BinarySerializer bs;
-					loadedData = bs.decode(stream, objectSize, &serzContext, [&progress](float val)
+					if (metaData->getCompressionMethod() == 2)
+						stream = Compression::decompressBlocks(stream, reportProgress);
+					else
+						stream = Compression::decompress(stream, reportProgress);
+
+					if (stream != nullptr)
 					{
-						progress.exchange(0.9f + val * 0.1f, std::memory_order_relaxed);
-					});
+						BinarySerializer bs;
+						loadedData = bs.decode(stream, objectSize, &serzContext, [&progress](float val)
+						{
+							progress.exchange(0.9f + val * 0.1f, std::memory_order_relaxed);
+						});
+					}
 				}
 				else
 				{
@@ -638,7 +847,8 @@ namespace bs
 		resource.clearHandleData();
 	}
 
-	void Resources::save(const HResource& resource, const Path& filePath, bool overwrite, bool compress)
+	void Resources::save(const HResource& resource, const Path& filePath, bool overwrite, bool compress,
+		CompressionCodec codec)
 	{
 		if (resource == nullptr)
 			return;
@@ -671,20 +881,20 @@ namespace bs
 			mDefaultResourceManifest->registerResource(resource.getUUID(), filePath);
 		}
 
-		_save(resource.getInternalPtr(), filePath, compress);
+		_save(resource.getInternalPtr(), filePath, compress, codec);
 	}
 
-	void Resources::save(const HResource& resource, bool compress)
+	void Resources::save(const HResource& resource, bool compress, CompressionCodec codec)
 	{
 		if (resource == nullptr)
 			return;
 
 		Path path;
 		if (getFilePathFromUUID(resource.getUUID(), path))
-			save(resource, path, true, compress);
+			save(resource, path, true, compress, codec);
 	}
 
-	void Resources::_save(const SPtr<Resource>& resource, const Path& filePath, bool compress)
+	void Resources::_save(const SPtr<Resource>& resource, const Path& filePath, bool compress, CompressionCodec codec)
 	{
 		if (!resource->mKeepSourceData)
 		{
@@ -697,7 +907,7 @@ namespace bs
 		for (UINT32 i = 0; i < (UINT32)dependencyList.size(); i++)
 			dependencyUUIDs[i] = dependencyList[i].resource.getUUID();
 
-		UINT32 compressionMethod = (compress && resource->isCompressible()) ? 1 : 0;
+		UINT32 compressionMethod = (compress && resource->isCompressible()) ? 2 : 0;
 		SPtr<SavedResourceData> resourceData = bs_shared_ptr_new<SavedResourceData>(dependencyUUIDs,
 			resource->allowAsyncLoading(), compressionMethod);
 
@@ -764,7 +974,7 @@ namespace bs
 			if (compressionMethod != 0)
 			{
 				SPtr<DataStream> srcStream = std::static_pointer_cast<DataStream>(objStream);
-				objStream = Compression::compress(srcStream);
+				objStream = Compression::compressBlocks(srcStream, codec);
 			}
 
 			stream.write((char*)&numBytes, sizeof(numBytes));
@@ -916,6 +1126,58 @@ namespace bs
 		return std::min(1.0f, totalBytesLoaded / totalBytesToLoad);
 	}
 
+	Vector<float> Resources::getLoadProgressPerLevel(const HResource& resource)
+	{
+		const UUID& uuid = resource.getUUID();
+		if(uuid.empty())
+			return {};
+
+		Lock inProgressLock(mInProgressResourcesMutex);
+		Lock loadedLock(mLoadedResourceMutex);
+
+		// Fully loaded
+		auto iterFind = mLoadedResources.find(uuid);
+		if (iterFind != mLoadedResources.end())
+			return { 1.0f };
+
+		// Not loaded nor being loaded
+		auto iterFind2 = mInProgressResources.find(uuid);
+		if (iterFind2 == mInProgressResources.end())
+			return {};
+
+		ResourceLoadData* loadData = iterFind2->second;
+		if(loadData->graph == nullptr)
+			return { loadData->progress.load(std::memory_order_relaxed) };
+
+		const LoadGraph& graph = *loadData->graph;
+
+		Vector<float> output;
+		output.reserve(graph.levels.size());
+		for(auto& level : graph.levels)
+		{
+			float totalBytesLoaded = 0.0f;
+			float totalBytesToLoad = 0.0f;
+			for(auto& entry : level)
+			{
+				// Avoid resources without data being ignored
+				const float size = (float)std::max(1U, graph.nodes.at(entry).size);
+				totalBytesToLoad += size;
+
+				// Only count completed loads. Resources neither in progress nor loaded either weren't issued yet, or
+				// their load failed or was canceled.
+				auto iterFind3 = mInProgressResources.find(entry);
+				if (iterFind3 != mInProgressResources.end())
+					totalBytesLoaded += size * iterFind3->second->progress.load(std::memory_order_relaxed);
+				else if (mLoadedResources.find(entry) != mLoadedResources.end())
+					totalBytesLoaded += size;
+			}
+
+			output.push_back(std::min(1.0f, totalBytesLoaded / totalBytesToLoad));
+		}
+
+		return output;
+	}
+
 	HResource Resources::_createResourceHandle(const SPtr<Resource>& obj)
 	{
 		UUID uuid = UUIDGenerator::generateRandom();
@@ -1052,22 +1314,34 @@ namespace bs
 		}
 	}
 
-	void Resources::loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData)
+	void Resources::loadCallback(const Path& filePath, HResource& resource, ResourceLoadFlags loadFlags)
 	{
 		ResourceLoadData* myLoadData;
+		bool skipRead;
 		{
 			Lock lock(mInProgressResourcesMutex);
 			myLoadData = mInProgressResources[resource.getUUID()];
+
+			// Decided under the lock, so a load resumed after this point knows it has to read the file again
+			skipRead = myLoadData->canceled;
+			myLoadData->readSkipped = skipRead;
 		}
 
-		SPtr<Resource> rawResource = loadFromDiskAndDeserialize(filePath, loadWithSaveData, myLoadData->progress);
+		SPtr<Resource> rawResource;
+		if (!skipRead)
+			rawResource = loadFromDiskAndDeserialize(filePath, loadFlags, myLoadData->progress);
 
 		{
 			Lock lock(mInProgressResourcesMutex);
 
-			myLoadData->loadedData = rawResource;
+			// Skipped reads must not overwrite data read by a resumed load
+			if (!skipRead)
+			{
+				myLoadData->loadedData = rawResource;
+				myLoadData->progress.exchange(1.0f, std::memory_order_relaxed);
+			}
+
 			myLoadData->remainingDependencies--;
-			myLoadData->progress.exchange(1.0f, std::memory_order_relaxed);
 		}
 
 		loadComplete(resource, true);
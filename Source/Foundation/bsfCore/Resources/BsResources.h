@@ -4,6 +4,8 @@
 
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
+#include "Utility/BsCompression.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -32,8 +34,15 @@ namespace bs
 		 * use up extra memory. Normally you want to keep this enabled if you plan on saving the resource to disk.
 		 */
 		KeepSourceData = 1 << 2,
+		/**
+		 * If enabled the resource file will be memory mapped instead of read into memory, allowing large data blocks
+		 * (e.g. texture pixels, mesh vertices) to be referenced directly from the mapping. The file must not be modified
+		 * or truncated while the resource is loaded. Ignored if KeepSourceData is enabled, as well as on platforms where
+		 * a mapped file cannot be replaced on save.
+		 */
+		MapFile = 1 << 3,
 		/** Default set of flags used for resource loading. */
-		Default = LoadDependencies | KeepInternalRef
+		Default = LoadDependencies | KeepInternalRef | MapFile
 	};
 
 	typedef Flags<ResourceLoadFlag> ResourceLoadFlags;
@@ -59,11 +68,28 @@ namespace bs
 			UINT32 size = 0;
 		};
 
+		/**
+		 * Dependency graph of a resource load. Contains saved data of all the dependencies that aren't loaded yet, read
+		 * ahead of time level by level, so dependency loads can be issued without touching the disk.
+		 */
+		struct LoadGraph
+		{
+			struct Node
+			{
+				SPtr<SavedResourceData> savedData;
+				UINT32 size = 0;
+				UINT32 level = 0;
+			};
+
+			UnorderedMap<UUID, Node> nodes;
+			Vector<Vector<UUID>> levels; // First level contains only the root resource
+		};
+
 		/** Information about a resource that's currently being loaded. */
 		struct ResourceLoadData
 		{
 			ResourceLoadData(const WeakResourceHandle<Resource>& resource, UINT32 numDependencies, UINT32 size)
-				:resData(resource, size), remainingDependencies(numDependencies)
+				:resData(resource, size), remainingDependencies(numDependencies), canceled(false)
 			{ }
 
 			LoadedResourceData resData;
@@ -74,10 +100,18 @@ namespace bs
 			bool loadStarted = false;
 			SPtr<Task> task;
 
+			// Required for reading the file again, if a load resumes after its read was skipped due to cancellation
+			Path filePath;
+			ResourceLoadFlags loadFlags;
+			bool readSkipped = false;
+
 			// Progress reporting
 			UINT32 dependencySize = 0;
 			UINT32 dependencyLoadedAmount = 0;
 			std::atomic<float> progress;
+			SPtr<LoadGraph> graph; // Only present on the resource that initiated the load of its dependencies
+
+			std::atomic<bool> canceled;
 		};
 
 		/** Information about an issued resource load. */
@@ -148,6 +182,19 @@ namespace bs
 			return static_resource_cast<T>(loadAsync(filePath, loadFlags));
 		}
 
+		/**
+		 * Loads the resource asynchronously, with the provided priority.
+		 *
+		 * @param[in]	filePath	Full pathname of the file.
+		 * @param[in]	loadFlags	Flags used to control the load process.
+		 * @param[in]	priority	Priority of the tasks loading the resource and its dependencies, relative to other
+		 *							tasks queued in the task scheduler. Has no effect if the resource is already being
+		 *							loaded.
+		 *
+		 * @see		loadAsync(const Path&, ResourceLoadFlags)
+		 */
+		HResource loadAsync(const Path& filePath, ResourceLoadFlags loadFlags, TaskPriority priority);
+
 		/**
 		 * Loads the resource with the given UUID. Returns an empty handle if resource can't be loaded.
 		 *
@@ -161,6 +208,25 @@ namespace bs
 		BS_SCRIPT_EXPORT()
 		HResource loadFromUUID(const UUID& uuid, bool async = false, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default);
 
+		/**
+		 * Loads the resource with the given UUID, with the provided priority.
+		 *
+		 * @see		loadFromUUID(const UUID&, bool, ResourceLoadFlags), loadAsync(const Path&, ResourceLoadFlags, TaskPriority)
+		 */
+		HResource loadFromUUID(const UUID& uuid, bool async, ResourceLoadFlags loadFlags, TaskPriority priority);
+
+		/**
+		 * Cancels an asynchronous load of the resource. Resources whose loads are canceled before being read from the disk
+		 * will finish loading without any data, same as if the load failed. Loads that are already reading their data
+		 * will complete normally.
+		 *
+		 * Dependencies of the resource are canceled as well, unless other loads that aren't canceled depend on them.
+		 *
+		 * Loading the resource again while the canceled load is still in progress resumes the load, along with the loads
+		 * of its canceled dependencies.
+		 */
+		void cancelLoad(const HResource& resource);
+
 		/**
 		 * Releases an internal reference to the resource held by the resources system. This allows the resource to be
 		 * unloaded when it goes out of scope, if the resource was loaded with @p keepInternalReference parameter.
@@ -197,6 +263,10 @@ namespace bs
 		 * @param[in]	overwrite	If true, any existing resource at the specified location will be overwritten.
 		 * @param[in]	compress	Should the resource be compressed before saving. Some resources have data that is
 		 *							already	compressed and this option will be ignored for such resources.
+		 * @param[in]	codec		Algorithm to compress the resource with, if @p compress is true. Snappy is always
+		 *							available. LZ4 yields the fastest loads, while Zstd yields the smallest files, but
+		 *							they are only available if support for them was compiled in (see
+		 *							Compression::isSupported()), otherwise Snappy is used and a warning is logged.
 		 * 			
 		 * @note
 		 * If the resource is used on the GPU and you are in some way modifying it from the core thread, make sure all
@@ -209,7 +279,8 @@ namespace bs
 		 * Thread safe if you guarantee the resource isn't being written to from another thread.
 		 */
 		BS_SCRIPT_EXPORT()
-		void save(BS_NORREF const HResource& resource, const Path& filePath, bool overwrite, bool compress = false);
+		void save(BS_NORREF const HResource& resource, const Path& filePath, bool overwrite, bool compress = false,
+			CompressionCodec codec = CompressionCodec::Snappy);
 
 		/**
 		 * Saves an existing resource to its previous location.
@@ -217,6 +288,10 @@ namespace bs
 		 * @param[in]	resource 	Handle to the resource.
 		 * @param[in]	compress	Should the resource be compressed before saving. Some resources have data that is
 		 *							already compressed and this option will be ignored for such resources.
+		 * @param[in]	codec		Algorithm to compress the resource with, if @p compress is true. Snappy is always
+		 *							available. LZ4 yields the fastest loads, while Zstd yields the smallest files, but
+		 *							they are only available if support for them was compiled in (see
+		 *							Compression::isSupported()), otherwise Snappy is used and a warning is logged.
 		 *
 		 * @note
 		 * If the resource is used on the GPU and you are in some way modifying it from the core thread, make sure all
@@ -229,7 +304,8 @@ namespace bs
 		 * Thread safe if you guarantee the resource isn't being written to from another thread.
 		 */
 		BS_SCRIPT_EXPORT()
-		void save(BS_NORREF const HResource& resource, bool compress = false);
+		void save(BS_NORREF const HResource& resource, bool compress = false,
+			CompressionCodec codec = CompressionCodec::Snappy);
 
 		/**
 		 * Updates an existing resource handle with a new resource. Caller must ensure that new resource type matches the
@@ -270,6 +346,18 @@ namespace bs
 		BS_SCRIPT_EXPORT()
 		float getLoadProgress(const HResource& resource, bool includeDependencies = true);
 
+		/**
+		 * Returns the loading progress of a resource that's being asynchronously loaded and of all of its dependencies,
+		 * grouped by the depth of the dependencies in the dependency graph.
+		 *
+		 * @param[in]	resource	Resource whose load progress to check.
+		 * @return					Load progress in range [0, 1] for each level of the dependency graph. The first entry
+		 *							is the resource itself, the second its direct dependencies, and so on. Empty if the
+		 *							resource is neither loaded nor being loaded. Only completed loads are counted, so
+		 *							dependencies whose load wasn't issued yet, failed or was canceled count as not loaded.
+		 */
+		Vector<float> getLoadProgressPerLevel(const HResource& resource);
+
 		/**
 		 *Allows you to set a resource manifest containing UUID <-> file path mapping that is used when resolving
 		 * resource references.
@@ -358,7 +446,8 @@ namespace bs
 		 * Same as save() except it saves the resource without registering it in the default manifest, requiring a handle,
 		 * or checking for overwrite.
 		 */
-		void _save(const SPtr<Resource>& resource, const Path& filePath, bool compress);
+		void _save(const SPtr<Resource>& resource, const Path& filePath, bool compress,
+			CompressionCodec codec = CompressionCodec::Snappy);
 
 		/** @} */
 	private:
@@ -369,16 +458,40 @@ namespace bs
 		 * resource, although you may provide an empty path in which case the resource will be retrieved from memory if its
 		 * currently loaded.
 		 */
-		LoadInfo loadInternal(const UUID& UUID, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags);
+		LoadInfo loadInternal(const UUID& UUID, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags,
+			TaskPriority priority = TaskPriority::Normal, const SPtr<LoadGraph>& graph = nullptr);
+
+		/**
+		 * Builds the dependency graph of a resource, reading saved data of all the dependencies that aren't loaded yet.
+		 * Each level of the graph is read in parallel.
+		 *
+		 * @param[in]	uuid			UUID of the root resource.
+		 * @param[in]	size			Size of the root resource, in bytes.
+		 * @param[in]	dependencies	Direct dependencies of the root resource.
+		 */
+		SPtr<LoadGraph> buildLoadGraph(const UUID& uuid, UINT32 size, const Vector<UUID>& dependencies);
+
+		/**
+		 * Marks the load as canceled, as well as loads of its dependencies that have no other dependants. Caller must
+		 * hold the in-progress resource lock.
+		 */
+		void cancelLoadInternal(ResourceLoadData* loadData);
+
+		/**
+		 * Resumes a canceled load, as well as canceled loads of its dependencies. If the load already skipped reading the
+		 * resource file, a new read is queued with the provided priority. Caller must hold the in-progress resource lock.
+		 */
+		void resumeLoadInternal(ResourceLoadData* loadData, TaskPriority priority);
 
 		/** Performs actually reading and deserializing of the resource file. Called from various worker threads. */
-		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData, std::atomic<float>& progress);
+		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, ResourceLoadFlags loadFlags,
+			std::atomic<float>& progress);
 
 		/**	Triggered when individual resource has finished loading. */
 		void loadComplete(HResource& resource, bool notifyProgress);
 
 		/**	Callback triggered when the task manager is ready to process the loading task. */
-		void loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData);
+		void loadCallback(const Path& filePath, HResource& resource, ResourceLoadFlags loadFlags);
 
 		/**	Destroys a resource, freeing its memory. */
 		void destroy(ResourceHandleBase& resource);
@@ -5,6 +5,33 @@
 
 namespace bs
 {
+	/** Returns the index of the slot encoded in a game object ID. */
+	static UINT32 getSlotIndex(UINT64 id)
+	{
+		return (UINT32)id;
+	}
+
+	/** Returns the slot generation encoded in a game object ID. */
+	static UINT32 getSlotGeneration(UINT64 id)
+	{
+		return (UINT32)(id >> 32);
+	}
+
+	/** Creates a game object ID from a slot index and generation. */
+	static UINT64 makeId(UINT32 slotIndex, UINT32 generation)
+	{
+		return ((UINT64)generation << 32) | slotIndex;
+	}
+
+	/** Returns the object referenced by handle data, or null if the object was destroyed. */
+	static GameObject* getObjectPtr(const SPtr<GameObjectHandleData>& handleData)
+	{
+		if(handleData == nullptr || handleData->mPtr == nullptr)
+			return nullptr;
+
+		return handleData->mPtr->object.get();
+	}
+
 	GameObjectManager::~GameObjectManager()
 	{
 		destroyQueuedObjects();
@@ -12,23 +39,23 @@ namespace bs
 
 	GameObjectHandleBase GameObjectManager::getObject(UINT64 id) const
 	{
-		Lock lock(mMutex);
+		ScopedSpinLock lock(mLock);
 
-		const auto iterFind = mObjects.find(id);
-		if (iterFind != mObjects.end())
-			return iterFind->second;
+		const SPtr<GameObjectHandleData>* handleData = findObject(id);
+		if (handleData != nullptr)
+			return GameObjectHandleBase(*handleData);
 
 		return nullptr;
 	}
 
 	bool GameObjectManager::tryGetObject(UINT64 id, GameObjectHandleBase& object) const
 	{
-		Lock lock(mMutex);
+		ScopedSpinLock lock(mLock);
 
-		const auto iterFind = mObjects.find(id);
-		if (iterFind != mObjects.end())
+		const SPtr<GameObjectHandleData>* handleData = findObject(id);
+		if (handleData != nullptr)
 		{
-			object = iterFind->second;
+			object = GameObjectHandleBase(*handleData);
 			return true;
 		}
 
@@ -37,9 +64,9 @@ namespace bs
 
 	bool GameObjectManager::objectExists(UINT64 id) const
 	{
-		Lock lock(mMutex);
+		ScopedSpinLock lock(mLock);
 
-		return mObjects.find(id) != mObjects.end();
+		return findObject(id) != nullptr;
 	}
 
 	void GameObjectManager::remapId(UINT64 oldId, UINT64 newId)
@@ -47,14 +74,42 @@ namespace bs
 		if (oldId == newId)
 			return;
 
-		Lock lock(mMutex);
-		mObjects[newId] = mObjects[oldId];
-		mObjects.erase(oldId);
+		ScopedSpinLock lock(mLock);
+
+		SPtr<GameObjectHandleData> handleData = removeObject(oldId);
+		if (handleData == nullptr)
+		{
+			// Don't leak the slot if the new ID was reserved for the object
+			const ObjectSlot* slot = findSlot(newId);
+			if (slot != nullptr && slot->handleData == nullptr)
+				freeSlot(newId);
+
+			return;
+		}
+
+		// The new ID keeps pointing to its slot only if the slot was reserved for it, or if it's still used by an object
+		// that is queued for destruction (in which case the remapped object replaces it)
+		ObjectSlot* slot = findSlot(newId);
+		if (slot != nullptr)
+			slot->handleData = std::move(handleData);
+		else
+			mRemappedObjects[newId] = std::move(handleData);
 	}
 
 	UINT64 GameObjectManager::reserveId()
 	{
-		return mNextAvailableID.fetch_add(1, std::memory_order_relaxed);
+		ScopedSpinLock lock(mLock);
+
+		return allocateSlot();
+	}
+
+	void GameObjectManager::releaseId(UINT64 id)
+	{
+		ScopedSpinLock lock(mLock);
+
+		const ObjectSlot* slot = findSlot(id);
+		if (slot != nullptr && slot->handleData == nullptr)
+			freeSlot(id);
 	}
 
 	void GameObjectManager::queueForDestroy(const GameObjectHandleBase& object)
@@ -62,27 +117,37 @@ namespace bs
 		if (object.isDestroyed())
 			return;
 
-		const UINT64 instanceId = object->getInstanceId();
-		mQueuedForDestroy[instanceId] = object;
+		mQueuedForDestroy.push_back(object);
 	}
 
 	void GameObjectManager::destroyQueuedObjects()
 	{
-		for (auto& objPair : mQueuedForDestroy)
-			objPair.second->destroyInternal(objPair.second, true);
+		// Objects can get queued while others are being destroyed, so the size is re-checked every iteration. The same
+		// object can also be queued more than once, or be destroyed along with its parent.
+		for (UINT32 i = 0; i < (UINT32)mQueuedForDestroy.size(); i++)
+		{
+			GameObjectHandleBase object = mQueuedForDestroy[i];
+			if (!object.isDestroyed())
+				object->destroyInternal(object, true);
+		}
 
 		mQueuedForDestroy.clear();
 	}
 
 	GameObjectHandleBase GameObjectManager::registerObject(const SPtr<GameObject>& object)
 	{
-		const UINT64 id = mNextAvailableID.fetch_add(1, std::memory_order_relaxed);
+		UINT64 id;
+		{
+			ScopedSpinLock lock(mLock);
+			id = allocateSlot();
+		}
+
 		object->initialize(object, id);
 
 		GameObjectHandleBase handle(object);
 		{
-			Lock lock(mMutex);
-			mObjects[id] = handle;
+			ScopedSpinLock lock(mLock);
+			mSlots[getSlotIndex(id)].handleData = handle.mData;
 		}
 
 		return handle;
@@ -91,14 +156,115 @@ namespace bs
 	void GameObjectManager::unregisterObject(GameObjectHandleBase& object)
 	{
 		{
-			Lock lock(mMutex);
-			mObjects.erase(object->getInstanceId());
+			ScopedSpinLock lock(mLock);
+			removeObject(object->getInstanceId(), object.get());
 		}
 
 		onDestroyed(static_object_cast<GameObject>(object));
 		object.destroy();
 	}
 
+	UINT64 GameObjectManager::allocateSlot()
+	{
+		UINT32 slotIndex = mFirstFreeSlot;
+		if (slotIndex != INVALID_SLOT)
+			mFirstFreeSlot = mSlots[slotIndex].nextFree;
+		else
+		{
+			slotIndex = (UINT32)mSlots.size();
+			mSlots.emplace_back();
+		}
+
+		ObjectSlot& slot = mSlots[slotIndex];
+		slot.nextFree = INVALID_SLOT;
+		slot.isUsed = true;
+
+		return makeId(slotIndex, slot.generation);
+	}
+
+	void GameObjectManager::freeSlot(UINT64 id)
+	{
+		const UINT32 slotIndex = getSlotIndex(id);
+
+		ObjectSlot& slot = mSlots[slotIndex];
+		slot.handleData = nullptr;
+		slot.isUsed = false;
+
+		// Zero is never used as a generation, so IDs are never zero
+		if (++slot.generation == 0)
+			slot.generation = 1;
+
+		slot.nextFree = mFirstFreeSlot;
+		mFirstFreeSlot = slotIndex;
+	}
+
+	GameObjectManager::ObjectSlot* GameObjectManager::findSlot(UINT64 id)
+	{
+		const UINT32 slotIndex = getSlotIndex(id);
+		if (slotIndex >= (UINT32)mSlots.size())
+			return nullptr;
+
+		ObjectSlot& slot = mSlots[slotIndex];
+		if (!slot.isUsed || slot.generation != getSlotGeneration(id))
+			return nullptr;
+
+		return &slot;
+	}
+
+	const GameObjectManager::ObjectSlot* GameObjectManager::findSlot(UINT64 id) const
+	{
+		return const_cast<GameObjectManager*>(this)->findSlot(id);
+	}
+
+	const SPtr<GameObjectHandleData>* GameObjectManager::findObject(UINT64 id) const
+	{
+		const ObjectSlot* slot = findSlot(id);
+		if (slot != nullptr)
+			return slot->handleData != nullptr ? &slot->handleData : nullptr;
+
+		if (mRemappedObjects.empty())
+			return nullptr;
+
+		const auto iterFind = mRemappedObjects.find(id);
+		if (iterFind != mRemappedObjects.end())
+			return &iterFind->second;
+
+		return nullptr;
+	}
+
+	SPtr<GameObjectHandleData> GameObjectManager::removeObject(UINT64 id, const GameObject* object)
+	{
+		SPtr<GameObjectHandleData> output;
+
+		ObjectSlot* slot = findSlot(id);
+		if (slot != nullptr && slot->handleData != nullptr)
+		{
+			// Slot might have been taken over by an object that was remapped to this ID
+			if (object != nullptr && getObjectPtr(slot->handleData) != object)
+				return nullptr;
+
+			output = std::move(slot->handleData);
+			freeSlot(id);
+
+			return output;
+		}
+
+		if (mRemappedObjects.empty())
+			return nullptr;
+
+		const auto iterFind = mRemappedObjects.find(id);
+		if (iterFind == mRemappedObjects.end())
+			return nullptr;
+
+		if (object != nullptr && getObjectPtr(iterFind->second) != object)
+			return nullptr;
+
+		output = std::move(iterFind->second);
+		mRemappedObjects.erase(iterFind);
+
+		return output;
+	}
+
 	GameObjectDeserializationState::GameObjectDeserializationState(UINT32 options)
 		:mOptions(options)
 	{ }
@@ -34,10 +34,24 @@ namespace bs
 	/**
 	 * Tracks GameObject creation and destructions. Also resolves GameObject references from GameObject handles.
 	 *
+	 * Objects are stored in a generational slot map. The lower 32 bits of an instance ID hold the index of the object's
+	 * slot, and the upper 32 bits hold the slot's generation, which is incremented every time an object is removed from
+	 * the slot. This allows objects to be registered, looked up and removed in constant time, while IDs of destroyed
+	 * objects are never resolved to new objects that reuse their slot.
+	 *
 	 * @note	Sim thread only.
 	 */
 	class BS_CORE_EXPORT GameObjectManager : public Module<GameObjectManager>
 	{
+		/** Entry in the slot map, holding a single game object. */
+		struct ObjectSlot
+		{
+			SPtr<GameObjectHandleData> handleData;
+			UINT32 generation = 1;
+			UINT32 nextFree = INVALID_SLOT; /**< Index of the next slot in the free list, if this slot is free. */
+			bool isUsed = false;
+		};
+
 	public:
 		GameObjectManager() = default;
 		~GameObjectManager();
@@ -92,27 +106,78 @@ namespace bs
 		void remapId(UINT64 oldId, UINT64 newId);
 
 		/**
-		 * Allocates a new unique game object ID.
+		 * Allocates a new unique game object ID. The ID stays reserved until an object is remapped to it and then
+		 * unregistered, or until it is released through releaseId(). If remapping an object to the ID fails because the
+		 * object doesn't exist, the ID is released.
 		 *
 		 * @note	Thread safe.
 		 */
 		UINT64 reserveId();
 
-		/**	Queues the object to be destroyed at the end of a GameObject update cycle. */
+		/**
+		 * Releases an ID returned by reserveId() that no object was remapped to, e.g. because registering the object
+		 * that was meant to use it failed. Does nothing if an object uses the ID.
+		 *
+		 * @note	Thread safe.
+		 */
+		void releaseId(UINT64 id);
+
+		/**
+		 * Queues the object to be destroyed at the end of a GameObject update cycle. Queuing an object more than once has
+		 * no additional effect.
+		 */
 		void queueForDestroy(const GameObjectHandleBase& object);
 
-		/**	Destroys any GameObjects that were queued for destruction. */
+		/**
+		 * Destroys any GameObjects that were queued for destruction. Objects are destroyed in the order they were queued
+		 * in (not in the order of their instance IDs), which is also the order in which onDestroyed is triggered for
+		 * them. Objects queued while this method is executing are destroyed after the rest, during the same call.
+		 */
 		void destroyQueuedObjects();
 
 		/**	Triggered when a game object is being destroyed. */
 		Event<void(const HGameObject&)> onDestroyed;
 
 	private:
-		std::atomic<UINT64> mNextAvailableID = { 1 } ; // 0 is not a valid ID
-		Map<UINT64, GameObjectHandleBase> mObjects;
-		Map<UINT64, GameObjectHandleBase> mQueuedForDestroy;
+		/** Marks the index of a slot that doesn't exist. */
+		static constexpr UINT32 INVALID_SLOT = (UINT32)-1;
+
+		/** Takes a slot from the free list, or creates a new one, and returns its ID. Caller must hold the lock. */
+		UINT64 allocateSlot();
+
+		/**
+		 * Returns the slot of the provided ID to the free list, and increments its generation so the ID becomes stale.
+		 * Caller must hold the lock.
+		 */
+		void freeSlot(UINT64 id);
+
+		/** Returns the slot of a used, non-stale ID, or null if there is none. Caller must hold the lock. */
+		ObjectSlot* findSlot(UINT64 id);
+
+		/** @copydoc findSlot(UINT64) */
+		const ObjectSlot* findSlot(UINT64 id) const;
+
+		/** Finds the handle data of the object with the specified ID, or null if none. Caller must hold the lock. */
+		const SPtr<GameObjectHandleData>* findObject(UINT64 id) const;
+
+		/**
+		 * Removes the object with the specified ID and returns its handle data, or null if no such object exists. If
+		 * @p object is provided, the entry is only removed if it holds the same object. Caller must hold the lock.
+		 */
+		SPtr<GameObjectHandleData> removeObject(UINT64 id, const GameObject* object = nullptr);
+
+		Vector<ObjectSlot> mSlots;
+		UINT32 mFirstFreeSlot = INVALID_SLOT;
+
+		/**
+		 * Objects whose IDs do not map to their own slot, e.g. objects that were remapped to an ID of an object
+		 * that has since been destroyed.
+		 */
+		UnorderedMap<UINT64, SPtr<GameObjectHandleData>> mRemappedObjects;
+
+		Vector<GameObjectHandleBase> mQueuedForDestroy;
 
-		mutable Mutex mMutex;
+		mutable SpinLock mLock;
 	};
 
 	/** Resolves game object handles and ID during deserialization of a game object hierarchy. */
@@ -13,6 +13,7 @@
 #include "Scene/BsSceneActor.h"
 #include "Scene/BsPrefab.h"
 #include "Physics/BsPhysics.h"
+#include "Private/Scene/BsSceneTransformPass.h"
 
 namespace bs
 {
@@ -43,6 +44,7 @@ namespace bs
 			bs_shared_ptr_new<SceneInstance>(SceneInstance::ConstructPrivately(), "Main",
 				SceneObject::createInternal("SceneRoot"),
 				gPhysics().createPhysicsScene()))
+		, mTransformPass(bs_unique_ptr_new<SceneTransformPass>())
 	{
 		mMainScene->mRoot->setScene(mMainScene);
 	}
@@ -123,13 +125,34 @@ namespace bs
 
 	void SceneManager::_bindActor(const SPtr<SceneActor>& actor, const HSceneObject& so)
 	{
-		mBoundActors[actor.get()] = BoundActorData(actor, so);
+		BoundActorData& boundActor = mBoundActors[actor.get()];
+		removeFromBoundSO(boundActor);
+
+		boundActor = BoundActorData(actor, so);
+		so->mBoundActors.push_back(actor.get());
+
 		actor->_updateState(*so, true);
 	}
 
 	void SceneManager::_unbindActor(const SPtr<SceneActor>& actor)
 	{
-		mBoundActors.erase(actor.get());
+		auto iterFind = mBoundActors.find(actor.get());
+		if (iterFind == mBoundActors.end())
+			return;
+
+		removeFromBoundSO(iterFind->second);
+		mBoundActors.erase(iterFind);
+	}
+
+	void SceneManager::removeFromBoundSO(const BoundActorData& boundActor)
+	{
+		if (boundActor.so.isDestroyed())
+			return;
+
+		Vector<SceneActor*>& actors = boundActor.so->mBoundActors;
+		auto iterFind = std::find(actors.begin(), actors.end(), boundActor.actor.get());
+		if (iterFind != actors.end())
+			bs_swap_and_erase(actors, iterFind);
 	}
 
 	HSceneObject SceneManager::_getActorSO(const SPtr<SceneActor>& actor) const
@@ -186,10 +209,41 @@ namespace bs
 		}
 	}
 
+	void SceneManager::notifyBoundActorsDirty(const HSceneObject& so)
+	{
+		mDirtyBoundSOs.push_back(so);
+	}
+
+	void SceneManager::notifyWorldTransformDirty(const HSceneObject& so)
+	{
+		mDirtyTransformRoots.push_back(so);
+	}
+
+	void SceneManager::_updateWorldTransforms()
+	{
+		mTransformPass->update(mDirtyTransformRoots);
+		mDirtyTransformRoots.clear();
+	}
+
 	void SceneManager::_updateCoreObjectTransforms()
 	{
-		for (auto& entry : mBoundActors)
-			entry.second.actor->_updateState(*entry.second.so);
+		_updateWorldTransforms();
+
+		// Scene objects queue themselves as their transform or state changes. Changes high in the hierarchy queue all
+		// the bound descendants along with them, so they all get processed in this single pass.
+		for (auto& entry : mDirtyBoundSOs)
+		{
+			if (entry.isDestroyed())
+				continue;
+
+			const SceneObject& so = *entry;
+			so.mBoundActorsDirty = false;
+
+			for (auto& actor : so.mBoundActors)
+				actor->_updateState(so);
+		}
+
+		mDirtyBoundSOs.clear();
 	}
 
 	SPtr<Camera> SceneManager::getMainCamera() const
@@ -10,6 +10,7 @@ namespace bs
 {
 	class LightProbeVolume;
 	class PhysicsScene;
+	class SceneTransformPass;
 
 	/** @addtogroup Scene-Internal
 	 *  @{
@@ -167,9 +168,18 @@ namespace bs
 		/** Called at fixed time internals. Calls the fixed update method on all active components. */
 		void _fixedUpdate();
 
-		/** Updates dirty transforms on any core objects that may be tied with scene objects. */
+		/**
+		 * Updates dirty transforms on any core objects that may be tied with scene objects. Only actors whose scene
+		 * objects had their transform, active state or mobility changed since the last call are updated.
+		 */
 		void _updateCoreObjectTransforms();
 
+		/**
+		 * Updates the cached world transforms of all scene objects moved since the last call, so they don't need to be
+		 * calculated when first accessed. Called at the start of _updateCoreObjectTransforms().
+		 */
+		void _updateWorldTransforms();
+
 		/** Notifies the manager that a new component has just been created. The manager triggers necessary callbacks. */
 		void _notifyComponentCreated(const HComponent& component, bool parentActive);
 
@@ -221,6 +231,21 @@ namespace bs
 		 */
 		void registerNewSO(const HSceneObject& node);
 
+		/**
+		 * Queues the actors bound to the scene object for an update during the next call to
+		 * _updateCoreObjectTransforms(). Called by the scene object when its transform or state changes.
+		 */
+		void notifyBoundActorsDirty(const HSceneObject& so);
+
+		/**
+		 * Queues the scene object for a world transform update during the next call to _updateWorldTransforms(). Called
+		 * by the scene object when it is moved, unless its parent was moved as well.
+		 */
+		void notifyWorldTransformDirty(const HSceneObject& so);
+
+		/** Removes the actor from the list of actors bound to the scene object it was bound to. */
+		static void removeFromBoundSO(const BoundActorData& boundActor);
+
 		/**	Callback that is triggered when the main render target size is changed. */
 		void onMainRenderTargetResized();
 
@@ -252,6 +277,9 @@ namespace bs
 		SPtr<SceneInstance> mMainScene;
 
 		UnorderedMap<SceneActor*, BoundActorData> mBoundActors;
+		Vector<HSceneObject> mDirtyBoundSOs;
+		Vector<HSceneObject> mDirtyTransformRoots;
+		UPtr<SceneTransformPass> mTransformPass;
 		UnorderedMap<Camera*, SPtr<Camera>> mCameras;
 		Vector<SPtr<Camera>> mMainCameras;
 
@@ -426,12 +426,22 @@ namespace bs
 
 	void SceneObject::notifyTransformChanged(TransformChangedFlags flags) const
 	{
+		markBoundActorsDirty();
+
 		// If object is immovable, don't send transform changed events nor mark the transform dirty
 		TransformChangedFlags componentFlags = flags;
 		if (mMobility != ObjectMobility::Movable)
 			componentFlags = (TransformChangedFlags)(componentFlags & ~TCF_Transform);
 		else
 		{
+			// Only the top-most moved object is queued, its descendants are found by walking the hierarchy
+			const bool isParentDirty = mParent != nullptr && !mParent->isCachedWorldTfrmUpToDate();
+			if (!mWorldTfrmQueued && !isParentDirty && isInstantiated())
+			{
+				mWorldTfrmQueued = true;
+				gSceneManager().notifyWorldTransformDirty(mThisHandle);
+			}
+
 			mDirtyFlags |= DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty;
 			mDirtyHash++;
 		}
@@ -459,6 +469,15 @@ namespace bs
 		}
 	}
 
+	void SceneObject::markBoundActorsDirty() const
+	{
+		if (mBoundActors.empty() || mBoundActorsDirty)
+			return;
+
+		mBoundActorsDirty = true;
+		gSceneManager().notifyBoundActorsDirty(mThisHandle);
+	}
+
 	void SceneObject::updateWorldTfrm() const
 	{
 		mWorldTfrm = mLocalTfrm;
@@ -709,6 +728,7 @@ namespace bs
 		if (mActiveHierarchy != activeHierarchy)
 		{
 			mActiveHierarchy = activeHierarchy;
+			markBoundActorsDirty();
 
 			if (triggerEvents)
 			{
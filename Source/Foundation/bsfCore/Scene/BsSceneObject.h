@@ -50,6 +50,7 @@ namespace bs
 		};
 
 		friend class SceneManager;
+		friend class SceneTransformPass;
 		friend class Prefab;
 		friend class PrefabDiff;
 		friend class PrefabUtility;
@@ -313,6 +314,10 @@ namespace bs
 		mutable UINT32 mDirtyFlags = 0xFFFFFFFF;
 		mutable UINT32 mDirtyHash = 0;
 
+		Vector<SceneActor*> mBoundActors; /**< Actors bound to this object through SceneManager::_bindActor(). */
+		mutable bool mBoundActorsDirty = false;
+		mutable bool mWorldTfrmQueued = false; /**< True if queued for SceneManager::_updateWorldTransforms(). */
+
 		/**
 		 * Notifies components and child scene object that a transform has been changed.
 		 *
@@ -320,6 +325,12 @@ namespace bs
 		 */
 		void notifyTransformChanged(TransformChangedFlags flags) const;
 
+		/**
+		 * Queues actors bound to this object for an update in SceneManager::_updateCoreObjectTransforms(). Does nothing
+		 * if no actors are bound, or if they are already queued.
+		 */
+		void markBoundActorsDirty() const;
+
 		/** Updates the local transform. Normally just reconstructs the transform matrix from the position/rotation/scale. */
 		void updateLocalTfrm() const;
 
@@ -68,6 +68,16 @@ namespace bs
 		Vector<GUIGroupElement> elements;
 	};
 
+	/** Creates a new mesh data object with the same layout and contents as the provided one. */
+	static SPtr<MeshData> copyMeshData(const MeshData& meshData)
+	{
+		SPtr<MeshData> copy = MeshData::create(meshData.getNumVertices(), meshData.getNumIndices(),
+			meshData.getVertexDesc(), meshData.getIndexType());
+		memcpy(copy->getData(), meshData.getData(), meshData.getSize());
+
+		return copy;
+	}
+
 	const UINT32 GUIManager::DRAG_DISTANCE = 3;
 	const float GUIManager::TOOLTIP_HOVER_TIME = 1.0f;
 
@@ -210,6 +220,18 @@ namespace bs
 				renderData.widgets.erase(findIter);
 		}
 
+		{
+			// Discard the widget's batch, so it cannot get reused by a new widget allocated at the same address
+			auto findIter = std::find_if(begin(renderData.batches), end(renderData.batches),
+				[widget](const GUIWidgetBatch& x)
+			{
+				return std::find(begin(x.widgets), end(x.widgets), widget) != end(x.widgets);
+			});
+
+			if(findIter != end(renderData.batches))
+				renderData.batches.erase(findIter);
+		}
+
 		if(renderData.widgets.size() == 0)
 		{
 			mCachedGUIData.erase(renderTarget);
@@ -401,7 +423,7 @@ namespace bs
 
 				for (auto& entry : renderData.cachedMeshes)
 				{
-					const SPtr<Mesh>& mesh = entry.isLine ? renderData.lineMesh : renderData.triangleMesh;
+					const SPtr<Mesh>& mesh = entry.mesh;
 					if(!mesh)
 						continue;
 
@@ -455,288 +477,572 @@ namespace bs
 		for(auto& cachedMeshData : mCachedGUIData)
 		{
 			GUIRenderData& renderData = cachedMeshData.second;
+			const UINT32 numWidgets = (UINT32)renderData.widgets.size();
 
-			// Check if anything is dirty. If nothing is we can skip the update
-			bool isDirty = renderData.isDirty;
-			renderData.isDirty = false;
-
-			for(auto& widget : renderData.widgets)
+			bs_frame_mark();
 			{
-				if (widget->isDirty(true))
-				{
-					isDirty = true;
-				}
-			}
+				// Check if anything is dirty. If nothing is we can skip the update
+				bool isDirty = renderData.isDirty;
+				renderData.isDirty = false;
 
-			if(!isDirty)
-				continue;
+				FrameVector<bool> isWidgetDirty(numWidgets);
+				FrameVector<bool> isWidgetMeshDirty(numWidgets);
+				for(UINT32 i = 0; i < numWidgets; i++)
+				{
+					isWidgetMeshDirty[i] = renderData.widgets[i]->_isMeshDirty();
 
-			mCoreDirty = true;
+					if (renderData.widgets[i]->isDirty(true))
+					{
+						isWidgetDirty[i] = true;
+						isDirty = true;
+					}
+				}
 
-			bs_frame_mark();
-			{
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
+				if(isDirty)
 				{
-					UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
-					UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
+					mCoreDirty = true;
 
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-					return (aDepth > bDepth) ||
-						(aDepth == bDepth && a.element > b.element) ||
-						(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement);
-				};
+					// Find which widgets need to be batched together. Elements of widgets with the same depth can be
+					// interleaved, so if such widgets overlap they must be grouped and sorted together.
+					FrameVector<UINT32> batchRoots(numWidgets);
+					for(UINT32 i = 0; i < numWidgets; i++)
+						batchRoots[i] = mSeparateMeshesByWidget ? i : 0;
 
-				FrameSet<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
+					const auto findRoot = [&batchRoots](UINT32 idx)
+					{
+						while(batchRoots[idx] != idx)
+							idx = batchRoots[idx] = batchRoots[batchRoots[idx]];
 
-				for (auto& widget : renderData.widgets)
-				{
-					const Vector<GUIElement*>& elements = widget->getElements();
+						return idx;
+					};
 
-					for (auto& element : elements)
+					if(mSeparateMeshesByWidget)
 					{
-						if (!element->_isVisible())
-							continue;
+						FrameVector<Rect2I> widgetBounds(numWidgets);
+						for(UINT32 i = 0; i < numWidgets; i++)
+						{
+							widgetBounds[i] = renderData.widgets[i]->getBounds();
+							widgetBounds[i].transform(renderData.widgets[i]->getWorldTfrm());
+						}
 
-						UINT32 numRenderElems = element->_getNumRenderElements();
-						for (UINT32 i = 0; i < numRenderElems; i++)
+						for(UINT32 i = 1; i < numWidgets; i++)
 						{
-							allElements.insert(GUIGroupElement(element, i));
+							for(UINT32 j = 0; j < i; j++)
+							{
+								if(renderData.widgets[i]->getDepth() != renderData.widgets[j]->getDepth())
+									continue;
+
+								if(!widgetBounds[i].overlaps(widgetBounds[j]))
+									continue;
+
+								const UINT32 rootA = findRoot(i);
+								const UINT32 rootB = findRoot(j);
+								if(rootA != rootB)
+									batchRoots[std::max(rootA, rootB)] = std::min(rootA, rootB);
+							}
 						}
 					}
-				}
 
-				// Group the elements in such a way so that we end up with a smallest amount of
-				// meshes, without breaking back to front rendering order
-				FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
-				for (auto& elem : allElements)
-				{
-					GUIElement* guiElem = elem.element;
-					UINT32 renderElemIdx = elem.renderElement;
-					UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
+					Vector<GUIWidgetBatch> batches;
+					FrameVector<bool> isBatchDirty;
+					FrameVector<bool> isBatchMeshDirty;
+					FrameVector<UINT32> batchLookup(numWidgets, (UINT32)-1);
+					for(UINT32 i = 0; i < numWidgets; i++)
+					{
+						const UINT32 root = findRoot(i);
+						if(batchLookup[root] == (UINT32)-1)
+						{
+							batchLookup[root] = (UINT32)batches.size();
+							batches.push_back(GUIWidgetBatch());
+							isBatchDirty.push_back(false);
+							isBatchMeshDirty.push_back(false);
+						}
 
-					Rect2I tfrmedBounds = guiElem->_getClippedBounds();
-					tfrmedBounds.transform(guiElem->_getParentWidget()->getWorldTfrm());
+						const UINT32 batchIdx = batchLookup[root];
+						batches[batchIdx].widgets.push_back(renderData.widgets[i]);
 
-					SpriteMaterial* spriteMaterial = nullptr;
-					const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(renderElemIdx, &spriteMaterial);
-					assert(spriteMaterial != nullptr);
+						if(isWidgetDirty[i])
+						{
+							isBatchDirty[batchIdx] = true;
 
-					UINT64 hash = spriteMaterial->getMergeHash(matInfo);
-					FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[hash];
-					
-					// Try to find a group this material will fit in:
-					//  - Group that has a depth value same or one below elements depth will always be a match
-					//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
-					//    overlap the current elements bounds.
-					GUIMaterialGroup* foundGroup = nullptr;
+							if(isWidgetMeshDirty[i])
+								isBatchMeshDirty[batchIdx] = true;
+						}
+					}
 
-					if(spriteMaterial->allowBatching())
+					// Only rebuild batches with dirty widgets, or whose widgets changed. If only contents of some
+					// elements changed, try to refill just the vertex and index ranges of those elements.
+					for(UINT32 i = 0; i < (UINT32)batches.size(); i++)
 					{
-						for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
+						GUIWidgetBatch& batch = batches[i];
+
+						auto iterFind = std::find_if(renderData.batches.begin(), renderData.batches.end(),
+							[&batch](const GUIWidgetBatch& x) { return x.widgets == batch.widgets; });
+
+						if(iterFind != renderData.batches.end())
 						{
-							// If we separate meshes by widget, ignore any groups with widget parents other than mine
-							if (mSeparateMeshesByWidget)
+							if(!isBatchDirty[i] || (!isBatchMeshDirty[i] && updateBatchElements(*iterFind)))
 							{
-								if (groupIter->elements.size() > 0)
-								{
-									GUIElement* otherElem = groupIter->elements.begin()->element; // We only need to check the first element
-									if (otherElem->_getParentWidget() != guiElem->_getParentWidget())
-										continue;
-								}
+								batch = std::move(*iterFind);
+								continue;
 							}
+						}
+
+						updateBatchMeshes(batch);
+					}
+
+					renderData.batches = std::move(batches);
 
-							GUIMaterialGroup& group = *groupIter;
-							if (group.depth == elemDepth)
+					// Sort meshes from all batches from farthest to nearest (highest depth to lowest)
+					renderData.cachedMeshes.clear();
+					for(auto& batch : renderData.batches)
+					{
+						renderData.cachedMeshes.insert(renderData.cachedMeshes.end(), batch.cachedMeshes.begin(),
+							batch.cachedMeshes.end());
+					}
+
+					std::stable_sort(renderData.cachedMeshes.begin(), renderData.cachedMeshes.end(),
+						[](const GUIMeshData& a, const GUIMeshData& b) { return a.depth > b.depth; });
+				}
+			}
+			bs_frame_clear();
+		}
+	}
+
+	void GUIManager::updateBatchMeshes(GUIWidgetBatch& batch)
+	{
+		bs_frame_mark();
+		{
+			// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
+			auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
+			{
+				UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
+				UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
+
+				// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
+				// requires all elements to be unique
+				return (aDepth > bDepth) ||
+					(aDepth == bDepth && a.element > b.element) ||
+					(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement);
+			};
+
+			FrameSet<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
+
+			for (auto& widget : batch.widgets)
+			{
+				const Vector<GUIElement*>& elements = widget->getElements();
+
+				for (auto& element : elements)
+				{
+					if (!element->_isVisible())
+						continue;
+
+					UINT32 numRenderElems = element->_getNumRenderElements();
+					for (UINT32 i = 0; i < numRenderElems; i++)
+					{
+						allElements.insert(GUIGroupElement(element, i));
+					}
+				}
+			}
+
+			// Group the elements in such a way so that we end up with a smallest amount of
+			// meshes, without breaking back to front rendering order
+			FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
+			for (auto& elem : allElements)
+			{
+				GUIElement* guiElem = elem.element;
+				UINT32 renderElemIdx = elem.renderElement;
+				UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
+
+				Rect2I tfrmedBounds = guiElem->_getClippedBounds();
+				tfrmedBounds.transform(guiElem->_getParentWidget()->getWorldTfrm());
+
+				SpriteMaterial* spriteMaterial = nullptr;
+				const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(renderElemIdx, &spriteMaterial);
+				assert(spriteMaterial != nullptr);
+
+				UINT64 hash = spriteMaterial->getMergeHash(matInfo);
+				FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[hash];
+				
+				// Try to find a group this material will fit in:
+				//  - Group that has a depth value same or one below elements depth will always be a match
+				//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
+				//    overlap the current elements bounds.
+				GUIMaterialGroup* foundGroup = nullptr;
+
+				if(spriteMaterial->allowBatching())
+				{
+					for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
+					{
+						// If we separate meshes by widget, ignore any groups with widget parents other than mine
+						if (mSeparateMeshesByWidget)
+						{
+							if (groupIter->elements.size() > 0)
 							{
-								foundGroup = &group;
-								break;
+								GUIElement* otherElem = groupIter->elements.begin()->element; // We only need to check the first element
+								if (otherElem->_getParentWidget() != guiElem->_getParentWidget())
+									continue;
 							}
-							else
-							{
-								UINT32 startDepth = elemDepth;
-								UINT32 endDepth = group.depth;
+						}
+
+						GUIMaterialGroup& group = *groupIter;
+						if (group.depth == elemDepth)
+						{
+							foundGroup = &group;
+							break;
+						}
+						else
+						{
+							UINT32 startDepth = elemDepth;
+							UINT32 endDepth = group.depth;
 
-								Rect2I potentialGroupBounds = group.bounds;
-								potentialGroupBounds.encapsulate(tfrmedBounds);
+							Rect2I potentialGroupBounds = group.bounds;
+							potentialGroupBounds.encapsulate(tfrmedBounds);
 
-								bool foundOverlap = false;
-								for (auto& material : materialGroups)
+							bool foundOverlap = false;
+							for (auto& material : materialGroups)
+							{
+								for (auto& matGroup : material.second)
 								{
-									for (auto& matGroup : material.second)
-									{
-										if (&matGroup == &group)
-											continue;
+									if (&matGroup == &group)
+										continue;
 
-										if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
-											|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
+									if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
+										|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
+									{
+										if (matGroup.bounds.overlaps(potentialGroupBounds))
 										{
-											if (matGroup.bounds.overlaps(potentialGroupBounds))
-											{
-												foundOverlap = true;
-												break;
-											}
+											foundOverlap = true;
+											break;
 										}
 									}
 								}
+							}
 
-								if (!foundOverlap)
-								{
-									foundGroup = &group;
-									break;
-								}
+							if (!foundOverlap)
+							{
+								foundGroup = &group;
+								break;
 							}
 						}
 					}
+				}
 
-					if (foundGroup == nullptr)
-					{
-						groupsPerMaterial.push_back(GUIMaterialGroup());
-						foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
+				if (foundGroup == nullptr)
+				{
+					groupsPerMaterial.push_back(GUIMaterialGroup());
+					foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
 
-						foundGroup->depth = elemDepth;
-						foundGroup->minDepth = elemDepth;
-						foundGroup->bounds = tfrmedBounds;
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->matInfo = matInfo.clone();
-						foundGroup->material = spriteMaterial;
+					foundGroup->depth = elemDepth;
+					foundGroup->minDepth = elemDepth;
+					foundGroup->bounds = tfrmedBounds;
+					foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
+					foundGroup->matInfo = matInfo.clone();
+					foundGroup->material = spriteMaterial;
 
-						guiElem->_getMeshInfo(renderElemIdx, foundGroup->numVertices, foundGroup->numIndices, foundGroup->meshType);
-					}
-					else
-					{
-						foundGroup->bounds.encapsulate(tfrmedBounds);
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
-						
-						UINT32 numVertices;
-						UINT32 numIndices;
-						GUIMeshType meshType;
-						guiElem->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
-						assert(meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
+					guiElem->_getMeshInfo(renderElemIdx, foundGroup->numVertices, foundGroup->numIndices, foundGroup->meshType);
+				}
+				else
+				{
+					foundGroup->bounds.encapsulate(tfrmedBounds);
+					foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
+					foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
+					
+					UINT32 numVertices;
+					UINT32 numIndices;
+					GUIMeshType meshType;
+					guiElem->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
+					assert(meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
 
-						foundGroup->numVertices += numVertices;
-						foundGroup->numIndices += numIndices;
+					foundGroup->numVertices += numVertices;
+					foundGroup->numIndices += numIndices;
 
-						spriteMaterial->merge(foundGroup->matInfo, matInfo);
-					}
+					spriteMaterial->merge(foundGroup->matInfo, matInfo);
 				}
+			}
 
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
-				{
-					return (a->depth > b->depth) || (a->depth == b->depth && a > b);
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-				};
+			// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
+			auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
+			{
+				return (a->depth > b->depth) || (a->depth == b->depth && a > b);
+				// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
+				// requires all elements to be unique
+			};
 
-				UINT32 numMeshes = 0;
-				UINT32 numIndices[2] = { 0, 0 };
-				UINT32 numVertices[2] = { 0, 0 };
+			UINT32 numMeshes = 0;
+			UINT32 numIndices[2] = { 0, 0 };
+			UINT32 numVertices[2] = { 0, 0 };
 
-				FrameSet<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
-				for(auto& material : materialGroups)
+			FrameSet<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
+			for(auto& material : materialGroups)
+			{
+				for(auto& group : material.second)
 				{
-					for(auto& group : material.second)
-					{
-						sortedGroups.insert(&group);
+					sortedGroups.insert(&group);
 
-						UINT32 typeIdx = (UINT32)group.meshType;
-						numIndices[typeIdx] += group.numIndices;
-						numVertices[typeIdx] += group.numVertices;
+					UINT32 typeIdx = (UINT32)group.meshType;
+					numIndices[typeIdx] += group.numIndices;
+					numVertices[typeIdx] += group.numVertices;
 
-						numMeshes++;
-					}
+					numMeshes++;
 				}
+			}
 
-				renderData.triangleMesh = nullptr;
-				renderData.lineMesh = nullptr;
+			batch.triangleMesh = nullptr;
+			batch.lineMesh = nullptr;
 
-				renderData.cachedMeshes.resize(numMeshes);
+			batch.cachedMeshes.resize(numMeshes);
+			batch.elements.clear();
+			batch.elements.reserve(allElements.size());
 
-				SPtr<MeshData> meshData[2];
-				SPtr<VertexDataDesc> vertexDesc[2] = { mTriangleVertexDesc, mLineVertexDesc };
+			SPtr<MeshData> meshData[2];
+			SPtr<VertexDataDesc> vertexDesc[2] = { mTriangleVertexDesc, mLineVertexDesc };
 
-				UINT8* vertices[2] = { nullptr, nullptr };
-				UINT32* indices[2] = { nullptr, nullptr };
+			for(UINT32 i = 0; i < 2; i++)
+			{
+				if(numVertices[i] > 0 && numIndices[i] > 0)
+					meshData[i] = MeshData::create(numVertices[i], numIndices[i], vertexDesc[i]);
+			}
 
-				for(UINT32 i = 0; i < 2; i++)
+			// Fill buffers for each group and update their meshes
+			UINT32 meshIdx = 0;
+			UINT32 vertexOffset[2] = { 0, 0 };
+			UINT32 indexOffset[2] = { 0, 0 };
+
+			for(auto& group : sortedGroups)
+			{
+				GUIWidget* widget;
+
+				if (group->elements.size() == 0)
+					widget = nullptr;
+				else
 				{
-					if(numVertices[i] > 0 && numIndices[i] > 0)
-					{
-						meshData[i] = MeshData::create(numVertices[i], numIndices[i], vertexDesc[i]);
+					GUIElement* elem = group->elements.begin()->element;
+					widget = elem->_getParentWidget();
+				}
 
-						vertices[i] = meshData[i]->getElementData(VES_POSITION);
-						indices[i] = meshData[i]->getIndices32();
-					}
+				GUIMeshData& guiMeshData = batch.cachedMeshes[meshIdx];
+				guiMeshData.depth = group->depth;
+				guiMeshData.matInfo = group->matInfo;
+				guiMeshData.material = group->material;
+				guiMeshData.widget = widget;
+				guiMeshData.isLine = group->meshType == GUIMeshType::Line;
+
+				UINT32 typeIdx = (UINT32)group->meshType;
+				guiMeshData.indexOffset = indexOffset[typeIdx];
+
+				const UINT64 mergeHash = group->material->getMergeHash(group->matInfo);
+
+				UINT32 groupNumIndices = 0;
+				for(auto& matElement : group->elements)
+				{
+					_fillElementMeshData(matElement.element, matElement.renderElement, *meshData[typeIdx],
+						vertexOffset[typeIdx], indexOffset[typeIdx]);
+
+					UINT32 elemNumVertices;
+					UINT32 elemNumIndices;
+					GUIMeshType meshType;
+					matElement.element->_getMeshInfo(matElement.renderElement, elemNumVertices, elemNumIndices, meshType);
+
+					UINT32 indexStart = indexOffset[typeIdx];
+
+					GUIBatchElement batchElement;
+					batchElement.element = matElement.element;
+					batchElement.renderElement = matElement.renderElement;
+					batchElement.meshIdx = meshIdx;
+					batchElement.vertexOffset = vertexOffset[typeIdx];
+					batchElement.numVertices = elemNumVertices;
+					batchElement.indexOffset = indexStart;
+					batchElement.numIndices = elemNumIndices;
+					batchElement.depth = matElement.element->_getRenderElementDepth(matElement.renderElement);
+					batchElement.mergeHash = mergeHash;
+					batchElement.bounds = matElement.element->_getClippedBounds();
+					batchElement.bounds.transform(matElement.element->_getParentWidget()->getWorldTfrm());
+
+					batch.elements.push_back(batchElement);
+
+					indexOffset[typeIdx] += elemNumIndices;
+					vertexOffset[typeIdx] += elemNumVertices;
+
+					groupNumIndices += elemNumIndices;
 				}
 
-				// Fill buffers for each group and update their meshes
-				UINT32 meshIdx = 0;
-				UINT32 vertexOffset[2] = { 0, 0 };
-				UINT32 indexOffset[2] = { 0, 0 };
+				guiMeshData.indexCount = groupNumIndices;
+
+				meshIdx++;
+			}
+
+			batch.elementLookup.resize(batch.elements.size());
+			for(UINT32 i = 0; i < (UINT32)batch.elements.size(); i++)
+				batch.elementLookup[i] = i;
+
+			std::sort(batch.elementLookup.begin(), batch.elementLookup.end(),
+				[&elements = batch.elements](UINT32 a, UINT32 b)
+			{
+				return (elements[a].element < elements[b].element) ||
+					(elements[a].element == elements[b].element && elements[a].renderElement < elements[b].renderElement);
+			});
+
+			// Mesh data is locked while the core thread uploads it, so keep a separate copy that individual elements
+			// can later be refilled into
+			for(UINT32 i = 0; i < 2; i++)
+			{
+				batch.meshData[i] = meshData[i];
 
-				for(auto& group : sortedGroups)
+				if(meshData[i])
+					meshData[i] = copyMeshData(*meshData[i]);
+			}
+
+			if(meshData[0])
+				batch.triangleMesh = Mesh::_createPtr(meshData[0], MU_STATIC, DOT_TRIANGLE_LIST);
+
+			if(meshData[1])
+				batch.lineMesh = Mesh::_createPtr(meshData[1], MU_STATIC, DOT_LINE_LIST);
+
+			for(auto& entry : batch.cachedMeshes)
+				entry.mesh = entry.isLine ? batch.lineMesh : batch.triangleMesh;
+		}
+		bs_frame_clear();
+	}
+
+	bool GUIManager::updateBatchElements(GUIWidgetBatch& batch)
+	{
+		bool canUpdate = true;
+
+		bs_frame_mark();
+		{
+			const auto lookupComp = [&elements = batch.elements](UINT32 a, const GUIElement* b)
+			{
+				return elements[a].element < b;
+			};
+
+			FrameVector<bool> isMeshDirty(batch.cachedMeshes.size(), false);
+			bool isTypeDirty[2] = { false, false };
+
+			for(auto& widget : batch.widgets)
+			{
+				for(auto& element : widget->_getUpdatedElements())
 				{
-					GUIWidget* widget;
+					auto iterStart = std::lower_bound(batch.elementLookup.begin(), batch.elementLookup.end(), element,
+						lookupComp);
 
-					if (group->elements.size() == 0)
-						widget = nullptr;
-					else
+					UINT32 numRecorded = 0;
+					while(iterStart + numRecorded != batch.elementLookup.end() &&
+						batch.elements[*(iterStart + numRecorded)].element == element)
+						numRecorded++;
+
+					// Elements that were shown, hidden or changed the number of render elements need a full rebuild
+					const UINT32 numRenderElems = element->_isVisible() ? element->_getNumRenderElements() : 0;
+					if(numRecorded != numRenderElems)
 					{
-						GUIElement* elem = group->elements.begin()->element;
-						widget = elem->_getParentWidget();
+						canUpdate = false;
+						break;
 					}
 
-					GUIMeshData& guiMeshData = renderData.cachedMeshes[meshIdx];
-					guiMeshData.matInfo = group->matInfo;
-					guiMeshData.material = group->material;
-					guiMeshData.widget = widget;
-					guiMeshData.isLine = group->meshType == GUIMeshType::Line;
-
-					UINT32 typeIdx = (UINT32)group->meshType;
-					guiMeshData.indexOffset = indexOffset[typeIdx];
+					Rect2I tfrmedBounds = element->_getClippedBounds();
+					tfrmedBounds.transform(widget->getWorldTfrm());
 
-					UINT32 groupNumIndices = 0;
-					for(auto& matElement : group->elements)
+					for(UINT32 i = 0; i < numRenderElems; i++)
 					{
-						matElement.element->_fillBuffer(
-							vertices[typeIdx], indices[typeIdx],
-							vertexOffset[typeIdx], indexOffset[typeIdx],
-							numVertices[typeIdx], numIndices[typeIdx], matElement.renderElement);
+						const GUIBatchElement& batchElement = batch.elements[*(iterStart + i)];
+						const UINT32 renderElemIdx = batchElement.renderElement;
 
-						UINT32 elemNumVertices;
-						UINT32 elemNumIndices;
+						UINT32 numVertices;
+						UINT32 numIndices;
 						GUIMeshType meshType;
-						matElement.element->_getMeshInfo(matElement.renderElement, elemNumVertices, elemNumIndices, meshType);
+						element->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
+
+						SpriteMaterial* spriteMaterial = nullptr;
+						const SpriteMaterialInfo& matInfo = element->_getMaterial(renderElemIdx, &spriteMaterial);
+
+						// Elements that grew outside of their original bounds could now overlap elements they were
+						// previously grouped or ordered around, so their mesh group is no longer guaranteed to be valid
+						const Rect2I& bounds = batchElement.bounds;
+						const bool isWithinBounds = tfrmedBounds.x >= bounds.x && tfrmedBounds.y >= bounds.y &&
+							(tfrmedBounds.x + (INT32)tfrmedBounds.width) <= (bounds.x + (INT32)bounds.width) &&
+							(tfrmedBounds.y + (INT32)tfrmedBounds.height) <= (bounds.y + (INT32)bounds.height);
+
+						const GUIMeshData& meshData = batch.cachedMeshes[batchElement.meshIdx];
+						if(numVertices != batchElement.numVertices || numIndices != batchElement.numIndices ||
+							meshType != (meshData.isLine ? GUIMeshType::Line : GUIMeshType::Triangle) ||
+							element->_getRenderElementDepth(renderElemIdx) != batchElement.depth ||
+							spriteMaterial->getMergeHash(matInfo) != batchElement.mergeHash || !isWithinBounds)
+						{
+							canUpdate = false;
+							break;
+						}
 
-						UINT32 indexStart = indexOffset[typeIdx];
-						UINT32 indexEnd = indexStart + elemNumIndices;
+						const UINT32 typeIdx = (UINT32)meshType;
+						_fillElementMeshData(element, renderElemIdx, *batch.meshData[typeIdx], batchElement.vertexOffset,
+							batchElement.indexOffset);
 
-						for(UINT32 i = indexStart; i < indexEnd; i++)
-							indices[typeIdx][i] += vertexOffset[typeIdx];
+						isMeshDirty[batchElement.meshIdx] = true;
+						isTypeDirty[typeIdx] = true;
+					}
 
-						indexOffset[typeIdx] += elemNumIndices;
-						vertexOffset[typeIdx] += elemNumVertices;
+					if(!canUpdate)
+						break;
+				}
 
-						groupNumIndices += elemNumIndices;
-					}
+				if(!canUpdate)
+					break;
+			}
 
-					guiMeshData.indexCount = groupNumIndices;
+			if(canUpdate)
+			{
+				// Material info of a mesh is merged from all of its elements, so it must be re-merged if any changed
+				for(UINT32 i = 0; i < (UINT32)batch.cachedMeshes.size(); i++)
+				{
+					if(!isMeshDirty[i])
+						continue;
 
-					meshIdx++;
-				}
+					auto iterStart = std::lower_bound(batch.elements.begin(), batch.elements.end(), i,
+						[](const GUIBatchElement& a, UINT32 b) { return a.meshIdx < b; });
 
-				if(meshData[0])
-					renderData.triangleMesh = Mesh::_createPtr(meshData[0], MU_STATIC, DOT_TRIANGLE_LIST);
+					GUIMeshData& meshData = batch.cachedMeshes[i];
+					for(auto iter = iterStart; iter != batch.elements.end() && iter->meshIdx == i; ++iter)
+					{
+						SpriteMaterial* spriteMaterial = nullptr;
+						const SpriteMaterialInfo& matInfo = iter->element->_getMaterial(iter->renderElement,
+							&spriteMaterial);
+
+						if(iter == iterStart)
+							meshData.matInfo = matInfo.clone();
+						else
+							meshData.material->merge(meshData.matInfo, matInfo);
+					}
+				}
 
-				if(meshData[1])
-					renderData.lineMesh = Mesh::_createPtr(meshData[1], MU_STATIC, DOT_LINE_LIST);
+				SPtr<Mesh> meshes[2] = { batch.triangleMesh, batch.lineMesh };
+				for(UINT32 i = 0; i < 2; i++)
+				{
+					if(isTypeDirty[i])
+						meshes[i]->writeData(copyMeshData(*batch.meshData[i]), false);
+				}
 			}
-
-			bs_frame_clear();
 		}
+		bs_frame_clear();
+
+		return canUpdate;
+	}
+
+	void GUIManager::_fillElementMeshData(GUIElement* element, UINT32 renderElementIdx, MeshData& meshData,
+		UINT32 vertexOffset, UINT32 indexOffset)
+	{
+		UINT8* vertices = meshData.getElementData(VES_POSITION);
+		UINT32* indices = meshData.getIndices32();
+
+		element->_fillBuffer(vertices, indices, vertexOffset, indexOffset, meshData.getNumVertices(),
+			meshData.getNumIndices(), renderElementIdx);
+
+		UINT32 numVertices;
+		UINT32 numIndices;
+		GUIMeshType meshType;
+		element->_getMeshInfo(renderElementIdx, numVertices, numIndices, meshType);
+
+		const UINT32 indexEnd = indexOffset + numIndices;
+		for(UINT32 i = indexOffset; i < indexEnd; i++)
+			indices[i] += vertexOffset;
 	}
 
 	void GUIManager::updateCaretTexture()
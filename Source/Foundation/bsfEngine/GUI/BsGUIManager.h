@@ -54,12 +54,45 @@ namespace bs
 		{
 			UINT32 indexOffset = 0;
 			UINT32 indexCount = 0;
+			UINT32 depth = 0;
 			SpriteMaterial* material;
 			SpriteMaterialInfo matInfo;
 			GUIWidget* widget;
+			SPtr<Mesh> mesh;
 			bool isLine;
 		};
 
+		/** Location of a single render element of a GUI element, within the meshes of a widget batch. */
+		struct GUIBatchElement
+		{
+			GUIElement* element;
+			UINT32 renderElement;
+			UINT32 meshIdx; /**< Index into GUIWidgetBatch::cachedMeshes. */
+			UINT32 vertexOffset;
+			UINT32 numVertices;
+			UINT32 indexOffset;
+			UINT32 numIndices;
+			UINT32 depth;
+			UINT64 mergeHash;
+			Rect2I bounds; /**< Clipped bounds transformed by the widget transform, when the meshes were built. */
+		};
+
+		/**
+		 * Set of widgets on a viewport whose meshes are built together. Widgets are only batched together if they share
+		 * the same depth and overlap, otherwise each widget gets its own batch. This way batches can be rebuilt
+		 * independently, as they cannot affect how elements in other batches are grouped or ordered.
+		 */
+		struct GUIWidgetBatch
+		{
+			SPtr<Mesh> triangleMesh;
+			SPtr<Mesh> lineMesh;
+			SPtr<MeshData> meshData[2]; /**< Copy of the triangle and line mesh contents, never used by the core thread. */
+			Vector<GUIMeshData> cachedMeshes;
+			Vector<GUIWidget*> widgets;
+			Vector<GUIBatchElement> elements; /**< Render elements, in the order they were written to the meshes. */
+			Vector<UINT32> elementLookup; /**< Indices into @p elements, sorted by element and render element index. */
+		};
+
 		/**	GUI render data for a single viewport. */
 		struct GUIRenderData
 		{
@@ -67,9 +100,8 @@ namespace bs
 				:isDirty(true)
 			{ }
 
-			SPtr<Mesh> triangleMesh;
-			SPtr<Mesh> lineMesh;
-			Vector<GUIMeshData> cachedMeshes;
+			Vector<GUIWidgetBatch> batches;
+			Vector<GUIMeshData> cachedMeshes; /**< Meshes of all batches, sorted from farthest to nearest. */
 			Vector<GUIWidget*> widgets;
 			bool isDirty;
 		};
@@ -240,12 +272,45 @@ namespace bs
 		/**	Returns the parent render window of the specified widget. */
 		const RenderWindow* getWidgetWindow(const GUIWidget& widget) const;
 
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Fills the vertices and indices of a single render element of a GUI element into the provided mesh data, and
+		 * offsets the indices so they reference the element's vertices. Only the vertex and index range belonging to the
+		 * render element is written to, as reported by GUIElement::_getMeshInfo().
+		 *
+		 * @param[in]	element				Element whose render element to fill.
+		 * @param[in]	renderElementIdx	Index of the render element to fill.
+		 * @param[in]	meshData			Mesh data to write the vertices and indices to.
+		 * @param[in]	vertexOffset		First vertex in @p meshData to write to.
+		 * @param[in]	indexOffset			First index in @p meshData to write to.
+		 */
+		static void _fillElementMeshData(GUIElement* element, UINT32 renderElementIdx, MeshData& meshData,
+			UINT32 vertexOffset, UINT32 indexOffset);
+
+		/** @} */
+
 	private:
 		friend class ct::GUIRenderer;
 
 		/**	Recreates all dirty GUI meshes and makes them ready for rendering. */
 		void updateMeshes();
 
+		/** Recreates the meshes of all the widgets in the batch. */
+		void updateBatchMeshes(GUIWidgetBatch& batch);
+
+		/**
+		 * Refills the vertices and indices of only those elements in the batch whose contents were updated this frame,
+		 * and uploads the modified meshes. This is only possible if none of the updated elements changed their size,
+		 * depth or material, or grew outside of their previous bounds.
+		 *
+		 * @return	True if the batch was updated, false if the batch meshes must be fully rebuilt instead. If false is
+		 *			returned the batch contents are left in an undefined state.
+		 */
+		bool updateBatchElements(GUIWidgetBatch& batch);
+
 		/**	Recreates the input caret texture. */
 		void updateCaretTexture();
 
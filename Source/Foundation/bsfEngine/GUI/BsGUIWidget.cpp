@@ -78,6 +78,7 @@ namespace bs
 
 		mElements.clear();
 		mDirtyContents.clear();
+		mUpdatedElements.clear();
 	}
 
 	void GUIWidget::setDepth(UINT8 depth)
@@ -284,7 +285,11 @@ namespace bs
 		}
 
 		if (elem->_getType() == GUIElementBase::Type::Element)
+		{
 			mDirtyContents.erase(static_cast<GUIElement*>(elem));
+			mUpdatedElements.erase(std::remove(mUpdatedElements.begin(), mUpdatedElements.end(), elem),
+				mUpdatedElements.end());
+		}
 	}
 
 	void GUIWidget::_markMeshDirty(GUIElementBase* elem)
@@ -340,6 +345,9 @@ namespace bs
 
 	bool GUIWidget::isDirty(bool cleanIfDirty)
 	{
+		if (cleanIfDirty)
+			mUpdatedElements.clear();
+
 		if (!mIsActive)
 			return false;
 
@@ -355,7 +363,10 @@ namespace bs
 				mDirtyContentsTemp.swap(mDirtyContents);
 
 				for (auto& dirtyElement : mDirtyContentsTemp)
+				{
 					dirtyElement->_updateRenderElements();
+					mUpdatedElements.push_back(dirtyElement);
+				}
 
 				mDirtyContentsTemp.clear();
 			}
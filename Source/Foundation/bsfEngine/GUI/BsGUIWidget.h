@@ -133,6 +133,19 @@ namespace bs
 		 */
 		void _markContentDirty(GUIElementBase* elem);
 
+		/**
+		 * Checks if the widget mesh needs to be fully rebuilt, because elements were added, removed or changed in a way
+		 * that isn't limited to their own contents (e.g. visibility or widget transform changed). Must be called before
+		 * isDirty() cleans the widget.
+		 */
+		bool _isMeshDirty() const { return mWidgetIsDirty; }
+
+		/**
+		 * Returns a list of elements whose contents were updated during the last call to isDirty() with @p cleanIfDirty
+		 * set to true. May contain duplicates.
+		 */
+		const Vector<GUIElement*>& _getUpdatedElements() const { return mUpdatedElements; }
+
 		/**	Updates the layout of all child elements, repositioning and resizing them as needed. */
 		void _updateLayout();
 
@@ -196,6 +209,7 @@ namespace bs
 
 		Set<GUIElement*> mDirtyContents;
 		Set<GUIElement*> mDirtyContentsTemp;
+		Vector<GUIElement*> mUpdatedElements;
 
 		mutable UINT64 mCachedRTId;
 		mutable bool mWidgetIsDirty;
@@ -358,6 +358,29 @@ namespace bs
 		mTitlePreciseAvgCyclesSelf = GUILabel::create(HEString(u8"Avg. self cycles"), GUIOptions(GUIOption::fixedWidth(100)));
 		mTitlePreciseTotalCyclesSelf = GUILabel::create(HEString(u8"Total self cycles"), GUIOptions(GUIOption::fixedWidth(100)));
 
+		// Set up the memory summary, shown above the basic samples
+		mCPUMemoryStr = HEString(u8"__ProfOvMemory",
+			u8"General: {0} / {1} KB, frame: {2} / {3} KB, stack: {4} / {5} KB");
+		mCPUMemoryLbl = GUILabel::create(mCPUMemoryStr);
+
+		mBasicLayoutLabels->addElement(GUILabel::create(HEString(u8"__ProfOvMemoryTitle",
+			u8"Allocated bytes (sim / core)")));
+		mBasicLayoutContents->addElement(mCPUMemoryLbl);
+
+		mCPUThreadCachesStr = HEString(u8"__ProfOvThreadCaches", u8"{0} KB in use, {1} KB reserved, {2} caches");
+		mCPUThreadCachesLbl = GUILabel::create(mCPUThreadCachesStr);
+
+		GUILabel* threadCachesTitleLbl = GUILabel::create(HEString(u8"__ProfOvThreadCachesTitle",
+			u8"Thread caching allocator"));
+
+		mBasicLayoutLabels->addElement(threadCachesTitleLbl);
+		mBasicLayoutContents->addElement(mCPUThreadCachesLbl);
+
+#if !BS_THREAD_CACHING_ALLOCATOR
+		threadCachesTitleLbl->setActive(false);
+		mCPUThreadCachesLbl->setActive(false);
+#endif
+
 		GUILayout* basicTitleLabelLayout = mBasicLayoutLabels->addNewElement<GUILayoutX>();
 		GUILayout* preciseTitleLabelLayout = mPreciseLayoutLabels->addNewElement<GUILayoutX>();
 		GUILayout* basicTitleContentLayout = mBasicLayoutContents->addNewElement<GUILayoutX>();
@@ -674,6 +697,26 @@ namespace bs
 			}
 		}
 
+		// Memory summary
+		const UINT64* simAllocatedBytes = simBasicRootEntry.data.memAllocatedBytes;
+		const UINT64* coreAllocatedBytes = coreBasicRootEntry.data.memAllocatedBytes;
+		for(UINT32 i = 0; i < (UINT32)MemoryCategory::Count; i++)
+		{
+			mCPUMemoryStr.setParameter(i * 2 + 0, toString(simAllocatedBytes[i] / 1024));
+			mCPUMemoryStr.setParameter(i * 2 + 1, toString(coreAllocatedBytes[i] / 1024));
+		}
+
+		mCPUMemoryLbl->setContent(mCPUMemoryStr);
+
+#if BS_THREAD_CACHING_ALLOCATOR
+		const ThreadCachingAlloc::Stats allocStats = ThreadCachingAlloc::getStats();
+		mCPUThreadCachesStr.setParameter(0, toString(allocStats.bytesInUse / 1024));
+		mCPUThreadCachesStr.setParameter(1, toString(allocStats.bytesReserved / 1024));
+		mCPUThreadCachesStr.setParameter(2, toString(allocStats.numThreadCaches));
+
+		mCPUThreadCachesLbl->setContent(mCPUThreadCachesStr);
+#endif
+
 		PreciseRowFiller preciseRowFiller(mPreciseRows, *mBasicLayoutLabels, *mBasicLayoutContents, *mWidget->_getInternal());
 		Stack<TodoPrecise> todoPrecise;
 
@@ -166,6 +166,9 @@ namespace bs
 		GUIElement* mTitlePreciseAvgCyclesSelf = nullptr;
 		GUIElement* mTitlePreciseTotalCyclesSelf = nullptr;
 
+		GUILabel* mCPUMemoryLbl = nullptr;
+		GUILabel* mCPUThreadCachesLbl = nullptr;
+
 		GUILayout* mGPULayoutFrameContents = nullptr;
 		GUILayout* mGPULayoutFrameContentsLeft = nullptr;
 		GUILayout* mGPULayoutFrameContentsRight = nullptr;
@@ -211,6 +214,9 @@ namespace bs
 		HString mGPUVertexBufferBindsStr;
 		HString mGPUIndexBufferBindsStr;
 
+		HString mCPUMemoryStr;
+		HString mCPUThreadCachesStr;
+
 		Vector<BasicRow> mBasicRows;
 		Vector<PreciseRow> mPreciseRows;
 		Vector<GPUSampleRow> mGPUSampleRows[GPU_NUM_SAMPLE_COLUMNS];
@@ -0,0 +1,255 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Testing/BsConsoleTestOutput.h"
+#include "Testing/BsTestSuite.h"
+#include "GUI/BsGUIManager.h"
+#include "GUI/BsGUIElement.h"
+#include "GUI/BsGUIDimensions.h"
+#include "2D/BsSpriteMaterial.h"
+#include "Mesh/BsMeshData.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+#include "Math/BsVector2.h"
+
+namespace bs
+{
+	/**
+	 * GUI element with two render elements, each a strip of quads. Vertex positions and UVs are derived from the
+	 * element's value, so changing the value changes the element's contents without changing its vertex or index count.
+	 */
+	class TestGUIElement : public GUIElement
+	{
+	public:
+		TestGUIElement(UINT32 numQuads, float value)
+			: GUIElement("", GUIDimensions::create()), mNumQuads(numQuads), mValue(value)
+		{ }
+
+		/** Changes the value the vertices are derived from. */
+		void setValue(float value) { mValue = value; }
+
+		/** Returns the vertex position and UV the element writes for the specified vertex of a render element. */
+		void getVertex(UINT32 renderElementIdx, UINT32 vertexIdx, Vector2& position, Vector2& uv) const
+		{
+			position = Vector2(mValue + (float)vertexIdx, (float)renderElementIdx);
+			uv = Vector2(mValue * 0.5f, (float)vertexIdx);
+		}
+
+		/** Returns the index the element writes for the specified index of a render element, before any offset. */
+		static UINT32 getIndex(UINT32 indexIdx)
+		{
+			static constexpr UINT32 QUAD_INDICES[] = { 0, 1, 2, 2, 3, 0 };
+			return (indexIdx / 6) * 4 + QUAD_INDICES[indexIdx % 6];
+		}
+
+		UINT32 _getNumRenderElements() const override { return 2; }
+
+		const SpriteMaterialInfo& _getMaterial(UINT32 renderElementIdx, SpriteMaterial** material) const override
+		{
+			*material = nullptr;
+			return mMatInfo;
+		}
+
+		void _getMeshInfo(UINT32 renderElementIdx, UINT32& numVertices, UINT32& numIndices,
+			GUIMeshType& type) const override
+		{
+			const UINT32 numQuads = mNumQuads + renderElementIdx;
+
+			numVertices = numQuads * 4;
+			numIndices = numQuads * 6;
+			type = GUIMeshType::Triangle;
+		}
+
+		void _fillBuffer(UINT8* vertices, UINT32* indices, UINT32 vertexOffset, UINT32 indexOffset,
+			UINT32 maxNumVerts, UINT32 maxNumIndices, UINT32 renderElementIdx) const override
+		{
+			static constexpr UINT32 VERTEX_STRIDE = sizeof(Vector2) * 2;
+
+			UINT32 numVertices, numIndices;
+			GUIMeshType type;
+			_getMeshInfo(renderElementIdx, numVertices, numIndices, type);
+
+			assert((vertexOffset + numVertices) <= maxNumVerts);
+			assert((indexOffset + numIndices) <= maxNumIndices);
+
+			UINT8* vertDst = vertices + vertexOffset * VERTEX_STRIDE;
+			for(UINT32 i = 0; i < numVertices; i++)
+			{
+				Vector2 position, uv;
+				getVertex(renderElementIdx, i, position, uv);
+
+				memcpy(vertDst, &position, sizeof(position));
+				memcpy(vertDst + sizeof(Vector2), &uv, sizeof(uv));
+
+				vertDst += VERTEX_STRIDE;
+			}
+
+			for(UINT32 i = 0; i < numIndices; i++)
+				indices[indexOffset + i] = getIndex(i);
+		}
+
+		Vector2I _getOptimalSize() const override { return Vector2I(); }
+
+	private:
+		UINT32 mNumQuads;
+		float mValue;
+		SpriteMaterialInfo mMatInfo;
+	};
+
+	class EngineTestSuite : public TestSuite
+	{
+	public:
+		EngineTestSuite();
+
+	private:
+		void testGUIBatchElementRefill();
+	};
+
+	EngineTestSuite::EngineTestSuite()
+	{
+		BS_ADD_TEST(EngineTestSuite::testGUIBatchElementRefill);
+	}
+
+	void EngineTestSuite::testGUIBatchElementRefill()
+	{
+		static constexpr UINT32 NUM_ELEMENTS = 5;
+		static constexpr UINT32 CHANGED_ELEMENT = 2;
+
+		// Same layout as the triangle meshes built by GUIManager
+		SPtr<VertexDataDesc> vertexDesc = bs_shared_ptr_new<VertexDataDesc>();
+		vertexDesc->addVertElem(VET_FLOAT2, VES_POSITION);
+		vertexDesc->addVertElem(VET_FLOAT2, VES_TEXCOORD);
+
+		Vector<TestGUIElement*> elements;
+		for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+			elements.push_back(bs_new<TestGUIElement>(1 + i % 3, (float)i * 10.0f));
+
+		// Lay out all render elements of all elements one after another, like a batch mesh does
+		struct ElementRange
+		{
+			UINT32 element;
+			UINT32 renderElement;
+			UINT32 vertexOffset;
+			UINT32 numVertices;
+			UINT32 indexOffset;
+			UINT32 numIndices;
+		};
+
+		Vector<ElementRange> ranges;
+		UINT32 totalNumVertices = 0;
+		UINT32 totalNumIndices = 0;
+		for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+		{
+			for(UINT32 j = 0; j < elements[i]->_getNumRenderElements(); j++)
+			{
+				ElementRange range;
+				range.element = i;
+				range.renderElement = j;
+				range.vertexOffset = totalNumVertices;
+				range.indexOffset = totalNumIndices;
+
+				GUIMeshType type;
+				elements[i]->_getMeshInfo(j, range.numVertices, range.numIndices, type);
+
+				totalNumVertices += range.numVertices;
+				totalNumIndices += range.numIndices;
+
+				ranges.push_back(range);
+			}
+		}
+
+		SPtr<MeshData> meshData = MeshData::create(totalNumVertices, totalNumIndices, vertexDesc);
+		for(auto& range : ranges)
+		{
+			GUIManager::_fillElementMeshData(elements[range.element], range.renderElement, *meshData,
+				range.vertexOffset, range.indexOffset);
+		}
+
+		const UINT32 vertexStride = vertexDesc->getVertexStride();
+		const auto checkRange = [&meshData, &elements, vertexStride](const ElementRange& range)
+		{
+			const UINT8* vertices = meshData->getElementData(VES_POSITION) + range.vertexOffset * vertexStride;
+			for(UINT32 i = 0; i < range.numVertices; i++)
+			{
+				Vector2 expectedPosition, expectedUV;
+				elements[range.element]->getVertex(range.renderElement, i, expectedPosition, expectedUV);
+
+				Vector2 position, uv;
+				memcpy(&position, vertices + i * vertexStride, sizeof(position));
+				memcpy(&uv, vertices + i * vertexStride + sizeof(Vector2), sizeof(uv));
+
+				if(position != expectedPosition || uv != expectedUV)
+					return false;
+			}
+
+			// Indices must reference the element's own vertices within the shared mesh
+			const UINT32* indices = meshData->getIndices32() + range.indexOffset;
+			for(UINT32 i = 0; i < range.numIndices; i++)
+			{
+				if(indices[i] != range.vertexOffset + TestGUIElement::getIndex(i))
+					return false;
+			}
+
+			return true;
+		};
+
+		for(auto& range : ranges)
+			BS_TEST_ASSERT(checkRange(range));
+
+		// Snapshot the batch contents, then change one element and refill only its ranges
+		const UINT32 vertexBufferSize = totalNumVertices * vertexStride;
+		Vector<UINT8> verticesBefore(vertexBufferSize);
+		memcpy(verticesBefore.data(), meshData->getElementData(VES_POSITION), vertexBufferSize);
+
+		Vector<UINT32> indicesBefore(totalNumIndices);
+		memcpy(indicesBefore.data(), meshData->getIndices32(), totalNumIndices * sizeof(UINT32));
+
+		elements[CHANGED_ELEMENT]->setValue(1000.0f);
+		for(auto& range : ranges)
+		{
+			if(range.element == CHANGED_ELEMENT)
+			{
+				GUIManager::_fillElementMeshData(elements[range.element], range.renderElement, *meshData,
+					range.vertexOffset, range.indexOffset);
+			}
+		}
+
+		const UINT8* vertices = meshData->getElementData(VES_POSITION);
+		const UINT32* indices = meshData->getIndices32();
+		for(auto& range : ranges)
+		{
+			if(range.element == CHANGED_ELEMENT)
+			{
+				BS_TEST_ASSERT(checkRange(range));
+
+				// Make sure the new contents actually differ from the old ones
+				BS_TEST_ASSERT(memcmp(vertices + range.vertexOffset * vertexStride,
+					verticesBefore.data() + range.vertexOffset * vertexStride, range.numVertices * vertexStride) != 0);
+			}
+			else
+			{
+				BS_TEST_ASSERT(memcmp(vertices + range.vertexOffset * vertexStride,
+					verticesBefore.data() + range.vertexOffset * vertexStride, range.numVertices * vertexStride) == 0);
+				BS_TEST_ASSERT(memcmp(indices + range.indexOffset, indicesBefore.data() + range.indexOffset,
+					range.numIndices * sizeof(UINT32)) == 0);
+			}
+		}
+
+		for(auto& element : elements)
+			bs_delete(element);
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	MemStack::beginThread();
+
+	SPtr<TestSuite> tests = EngineTestSuite::create<EngineTestSuite>();
+
+	ExceptionTestOutput testOutput;
+	tests->run(testOutput);
+
+	MemStack::endThread();
+
+	return 0;
+}
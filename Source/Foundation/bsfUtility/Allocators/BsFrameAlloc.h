@@ -427,6 +427,10 @@ namespace bs
 		/** @copydoc MemoryAllocator::allocate */
 		static void* allocate(size_t bytes)
 		{
+#if BS_PROFILING_ENABLED
+			addAllocatedBytes(MemoryCategory::Frame, bytes);
+#endif
+
 			return bs_frame_alloc((UINT32)bytes);
 		}
 
@@ -435,6 +439,7 @@ namespace bs
 		{
 #if BS_PROFILING_ENABLED
 			incAllocCount();
+			addAllocatedBytes(MemoryCategory::Frame, bytes);
 #endif
 
 			return bs_frame_alloc_aligned((UINT32)bytes, (UINT32)alignment);
@@ -445,6 +450,7 @@ namespace bs
 		{
 #if BS_PROFILING_ENABLED
 			incAllocCount();
+			addAllocatedBytes(MemoryCategory::Frame, bytes);
 #endif
 
 			return bs_frame_alloc_aligned((UINT32)bytes, 16);
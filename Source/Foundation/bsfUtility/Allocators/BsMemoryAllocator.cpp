@@ -6,4 +6,5 @@ namespace bs
 {
 	UINT64 BS_THREADLOCAL MemoryCounter::Allocs = 0;
 	UINT64 BS_THREADLOCAL MemoryCounter::Frees = 0;
+	UINT64 BS_THREADLOCAL MemoryCounter::AllocatedBytes[(int)MemoryCategory::Count] = { };
 }
@@ -13,6 +13,8 @@
 #  include <malloc.h>
 #endif
 
+#include "Allocators/BsThreadCachingAlloc.h"
+
 namespace bs
 {
 	class MemoryAllocatorBase;
@@ -96,6 +98,15 @@ namespace bs
 	}
 #endif
 
+	/** Categories of memory allocations tracked by MemoryCounter, one for each kind of allocator. */
+	enum class MemoryCategory
+	{
+		General, /**< Allocations made through the general allocator (GenAlloc). */
+		Frame, /**< Allocations made through the frame allocator (FrameAlloc). */
+		Stack, /**< Allocations made through the stack allocator (StackAlloc). */
+		Count // Keep at end
+	};
+
 	/**
 	 * Thread safe class used for storing total number of memory allocations and deallocations, primarily for statistic
 	 * purposes.
@@ -113,15 +124,26 @@ namespace bs
 			return Frees;
 		}
 
+		/** Returns the total number of bytes allocated by the calling thread in the specified category. */
+		static BS_UTILITY_EXPORT uint64_t getNumAllocatedBytes(MemoryCategory category)
+		{
+			return AllocatedBytes[(int)category];
+		}
+
 	private:
 		friend class MemoryAllocatorBase;
 
 		// Threadlocal data can't be exported, so some magic to make it accessible from MemoryAllocator
 		static BS_UTILITY_EXPORT void incAllocCount() { ++Allocs; }
 		static BS_UTILITY_EXPORT void incFreeCount() { ++Frees; }
+		static BS_UTILITY_EXPORT void addAllocatedBytes(MemoryCategory category, size_t bytes)
+		{
+			AllocatedBytes[(int)category] += bytes;
+		}
 
 		static BS_THREADLOCAL uint64_t Allocs;
 		static BS_THREADLOCAL uint64_t Frees;
+		static BS_THREADLOCAL uint64_t AllocatedBytes[(int)MemoryCategory::Count];
 	};
 
 	/** Base class all memory allocators need to inherit. Provides allocation and free counting. */
@@ -130,13 +152,18 @@ namespace bs
 	protected:
 		static void incAllocCount() { MemoryCounter::incAllocCount(); }
 		static void incFreeCount() { MemoryCounter::incFreeCount(); }
+		static void addAllocatedBytes(MemoryCategory category, size_t bytes)
+		{
+			MemoryCounter::addAllocatedBytes(category, bytes);
+		}
 	};
 
 	/**
 	 * Memory allocator providing a generic implementation. Specialize for specific categories as needed.
 	 *
 	 * @note	For example you might implement a pool allocator for specific types in order
-	 * 			to reduce allocation overhead. By default standard malloc/free are used.
+	 * 			to reduce allocation overhead. By default standard malloc/free are used, or ThreadCachingAlloc if the
+	 * 			GENERAL_ALLOCATOR CMake option is set to ThreadCaching.
 	 */
 	template<class T>
 	class MemoryAllocator : public MemoryAllocatorBase
@@ -147,9 +174,14 @@ namespace bs
 		{
 #if BS_PROFILING_ENABLED
 			incAllocCount();
+			addAllocatedBytes(MemoryCategory::General, bytes);
 #endif
 
+#if BS_THREAD_CACHING_ALLOCATOR
+			return ThreadCachingAlloc::allocate(bytes);
+#else
 			return malloc(bytes);
+#endif
 		}
 
 		/**
@@ -160,6 +192,7 @@ namespace bs
 		{
 #if BS_PROFILING_ENABLED
 			incAllocCount();
+			addAllocatedBytes(MemoryCategory::General, bytes);
 #endif
 
 			return platformAlignedAlloc(bytes, alignment);
@@ -170,9 +203,14 @@ namespace bs
 		{
 #if BS_PROFILING_ENABLED
 			incAllocCount();
+			addAllocatedBytes(MemoryCategory::General, bytes);
 #endif
 
+#if BS_THREAD_CACHING_ALLOCATOR
+			return ThreadCachingAlloc::allocate(bytes);
+#else
 			return platformAlignedAlloc16(bytes);
+#endif
 		}
 
 		/** Frees the memory at the specified location. */
@@ -182,7 +220,11 @@ namespace bs
 			incFreeCount();
 #endif
 
+#if BS_THREAD_CACHING_ALLOCATOR
+			ThreadCachingAlloc::free(ptr);
+#else
 			::free(ptr);
+#endif
 		}
 
 		/** Frees memory allocated with allocateAligned() */
@@ -202,7 +244,11 @@ namespace bs
 			incFreeCount();
 #endif
 
+#if BS_THREAD_CACHING_ALLOCATOR
+			ThreadCachingAlloc::free(ptr);
+#else
 			platformAlignedFree16(ptr);
+#endif
 		}
 	};
 
@@ -492,6 +492,10 @@ namespace bs
 	public:
 		static void* allocate(size_t bytes)
 		{
+#if BS_PROFILING_ENABLED
+			addAllocatedBytes(MemoryCategory::Stack, bytes);
+#endif
+
 			return bs_stack_alloc((UINT32)bytes);
 		}
 
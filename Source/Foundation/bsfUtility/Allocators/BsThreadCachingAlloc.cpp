@@ -0,0 +1,419 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Allocators/BsThreadCachingAlloc.h"
+#include "Utility/BsBitwise.h"
+#include <atomic>
+
+namespace bs
+{
+	constexpr size_t ThreadCachingAlloc::MAX_SMALL_SIZE;
+
+	namespace
+	{
+		struct ThreadCache;
+
+		/** Number of size classes in 16 byte steps, from 32 to 128 bytes. */
+		constexpr UINT32 NUM_LINEAR_CLASSES = 7;
+
+		/** Number of size classes between each two powers of two, for sizes larger than 128 bytes. */
+		constexpr UINT32 CLASSES_PER_POW2 = 4;
+
+		/** Total number of size classes, with the largest one being ThreadCachingAlloc::MAX_SMALL_SIZE (2^15). */
+		constexpr UINT32 NUM_SIZE_CLASSES = NUM_LINEAR_CLASSES + (15 - 7) * CLASSES_PER_POW2;
+
+		/** Minimum size of a slab that blocks of a size class are carved from. */
+		constexpr size_t SLAB_SIZE = 64 * 1024;
+
+		/** Minimum number of blocks in a slab, for size classes whose blocks are large compared to SLAB_SIZE. */
+		constexpr UINT32 MIN_BLOCKS_PER_SLAB = 4;
+
+		/** Number of blocks belonging to another thread that are collected before handing them over. */
+		constexpr UINT32 REMOTE_BATCH_SIZE = 32;
+
+		/** Number of other threads a thread can collect freed blocks for at once. */
+		constexpr UINT32 NUM_REMOTE_BATCHES = 4;
+
+		/** Header stored in front of every allocated block. */
+		struct alignas(16) BlockHeader
+		{
+			ThreadCache* owner; /**< Cache the block belongs to, or null for blocks from the system allocator. */
+			UINT64 info; /**< Size class of the block, or the total block size for blocks from the system allocator. */
+		};
+
+		/** Block that is currently not allocated, linked into a free list. */
+		struct FreeBlock
+		{
+			BlockHeader header;
+			FreeBlock* next;
+		};
+
+		/** Blocks freed by the current thread that belong to another thread, waiting to be handed over. */
+		struct RemoteBatch
+		{
+			ThreadCache* owner = nullptr;
+			FreeBlock* first = nullptr;
+			FreeBlock* last = nullptr;
+			UINT32 count = 0;
+		};
+
+		/**
+		 * Cache of free blocks, used by a single thread at a time. Counters are only written by the thread using the
+		 * cache, so they don't need atomic read-modify-write operations, but can be read from any thread.
+		 */
+		struct ThreadCache
+		{
+			FreeBlock* freeLists[NUM_SIZE_CLASSES] = { };
+			UINT8* slabPositions[NUM_SIZE_CLASSES] = { };
+			UINT8* slabEnds[NUM_SIZE_CLASSES] = { };
+			RemoteBatch remoteBatches[NUM_REMOTE_BATCHES];
+
+			/** Blocks handed over by other threads, as a lock-free stack. Only ever emptied as a whole. */
+			std::atomic<FreeBlock*> remoteFrees { nullptr };
+
+			std::atomic<UINT64> bytesAllocated { 0 };
+			std::atomic<UINT64> bytesFreed { 0 };
+			std::atomic<UINT64> systemBytesAllocated { 0 };
+			std::atomic<UINT64> systemBytesFreed { 0 };
+			std::atomic<UINT64> slabBytes { 0 };
+
+			ThreadCache* nextCache = nullptr;
+			ThreadCache* nextUnusedCache = nullptr;
+		};
+
+		/** Returns the size of blocks in the specified size class. */
+		constexpr UINT32 getClassSize(UINT32 sizeClass)
+		{
+			return sizeClass < NUM_LINEAR_CLASSES ?
+				(sizeClass + 2) * 16 :
+				(CLASSES_PER_POW2 + 1 + (sizeClass - NUM_LINEAR_CLASSES) % CLASSES_PER_POW2) <<
+					(5 + (sizeClass - NUM_LINEAR_CLASSES) / CLASSES_PER_POW2);
+		}
+
+		static_assert(getClassSize(NUM_SIZE_CLASSES - 1) == ThreadCachingAlloc::MAX_SMALL_SIZE,
+			"Largest size class must match the maximum small allocation size.");
+		static_assert(sizeof(FreeBlock) <= getClassSize(0), "Smallest size class must be able to hold a free block.");
+
+		/** Returns the smallest size class able to hold @p size bytes. */
+		UINT32 getSizeClass(UINT32 size)
+		{
+			if (size <= 128)
+				return size <= 32 ? 0 : (size + 15) / 16 - 2;
+
+			const UINT32 value = size - 1;
+			const UINT32 pow2 = Bitwise::mostSignificantBit(value);
+			const UINT32 step = pow2 - 2;
+
+			return NUM_LINEAR_CLASSES + (pow2 - 7) * CLASSES_PER_POW2 + ((value >> step) - CLASSES_PER_POW2);
+		}
+
+		/** Adds to a counter that only the current thread writes to. */
+		void addToCounter(std::atomic<UINT64>& counter, UINT64 amount)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
+
+		Mutex gCacheMutex;
+		ThreadCache* gFirstCache = nullptr;
+		ThreadCache* gFirstUnusedCache = nullptr;
+		UINT32 gNumCaches = 0;
+
+		// Counters for allocations made by threads after their cache was released
+		std::atomic<UINT64> gDetachedBytesFreed { 0 };
+		std::atomic<UINT64> gDetachedSystemBytesAllocated { 0 };
+		std::atomic<UINT64> gDetachedSystemBytesFreed { 0 };
+
+		BS_THREADLOCAL ThreadCache* tCache = nullptr;
+		BS_THREADLOCAL bool tCacheReleased = false;
+
+		void releaseCache();
+
+		/** Releases the cache of the thread when the thread exits. */
+		struct ThreadCacheReleaser
+		{
+			~ThreadCacheReleaser() { releaseCache(); }
+
+			bool active = false;
+		};
+
+		thread_local ThreadCacheReleaser tCacheReleaser;
+
+		/** Adds the blocks from @p first to @p last to the blocks handed over to @p owner. */
+		void pushRemoteFrees(ThreadCache* owner, FreeBlock* first, FreeBlock* last)
+		{
+			FreeBlock* head = owner->remoteFrees.load(std::memory_order_relaxed);
+			do
+			{
+				last->next = head;
+			} while (!owner->remoteFrees.compare_exchange_weak(head, first, std::memory_order_release,
+				std::memory_order_relaxed));
+		}
+
+		/** Hands over all blocks in the batch to their owner and clears the batch. */
+		void flushRemoteBatch(RemoteBatch& batch)
+		{
+			if (batch.owner != nullptr)
+				pushRemoteFrees(batch.owner, batch.first, batch.last);
+
+			batch = RemoteBatch();
+		}
+
+		/** Returns a cache for the current thread to use, or null if the thread's cache was already released. */
+		ThreadCache* acquireCache()
+		{
+			if (tCacheReleased)
+				return nullptr;
+
+			ThreadCache* cache;
+			{
+				Lock lock(gCacheMutex);
+
+				if (gFirstUnusedCache != nullptr)
+				{
+					cache = gFirstUnusedCache;
+					gFirstUnusedCache = cache->nextUnusedCache;
+				}
+				else
+				{
+					// Caches are never freed, as blocks in use by other threads can still point to them
+					cache = new (::malloc(sizeof(ThreadCache))) ThreadCache();
+					cache->nextCache = gFirstCache;
+					gFirstCache = cache;
+					gNumCaches++;
+				}
+			}
+
+			tCache = cache;
+			tCacheReleaser.active = true;
+
+			return cache;
+		}
+
+		/** Hands over the cache of the current thread to be reused by other threads. */
+		void releaseCache()
+		{
+			ThreadCache* cache = tCache;
+			if (cache == nullptr)
+				return;
+
+			for (auto& batch : cache->remoteBatches)
+				flushRemoteBatch(batch);
+
+			tCache = nullptr;
+			tCacheReleased = true;
+
+			Lock lock(gCacheMutex);
+			cache->nextUnusedCache = gFirstUnusedCache;
+			gFirstUnusedCache = cache;
+		}
+
+		/**
+		 * Returns a block of the specified size class when its free list is empty, either from blocks handed over by
+		 * other threads, or carved from the current slab of the size class. Returns null if out of memory.
+		 */
+		FreeBlock* allocateSlow(ThreadCache& cache, UINT32 sizeClass)
+		{
+			if (cache.remoteFrees.load(std::memory_order_relaxed) != nullptr)
+			{
+				FreeBlock* block = cache.remoteFrees.exchange(nullptr, std::memory_order_acquire);
+				while (block != nullptr)
+				{
+					FreeBlock* next = block->next;
+
+					const UINT64 blockClass = block->header.info;
+					block->next = cache.freeLists[blockClass];
+					cache.freeLists[blockClass] = block;
+
+					block = next;
+				}
+
+				FreeBlock* first = cache.freeLists[sizeClass];
+				if (first != nullptr)
+				{
+					cache.freeLists[sizeClass] = first->next;
+					return first;
+				}
+			}
+
+			// Blocks are carved from the slab as needed, rather than all at once, so unused parts are never touched
+			const UINT32 blockSize = getClassSize(sizeClass);
+			if ((size_t)(cache.slabEnds[sizeClass] - cache.slabPositions[sizeClass]) < blockSize)
+			{
+				const size_t slabSize = std::max(SLAB_SIZE, (size_t)blockSize * MIN_BLOCKS_PER_SLAB);
+
+				UINT8* slab = (UINT8*)::malloc(slabSize);
+				if (slab == nullptr)
+					return nullptr;
+
+				addToCounter(cache.slabBytes, slabSize);
+
+				cache.slabPositions[sizeClass] = slab;
+				cache.slabEnds[sizeClass] = slab + slabSize;
+			}
+
+			FreeBlock* block = (FreeBlock*)cache.slabPositions[sizeClass];
+			block->header.owner = &cache;
+			block->header.info = sizeClass;
+
+			cache.slabPositions[sizeClass] += blockSize;
+			return block;
+		}
+
+		/** Allocates a block directly from the system allocator. */
+		void* allocateSystem(ThreadCache* cache, size_t size)
+		{
+			BlockHeader* header = (BlockHeader*)::malloc(size);
+			if (header == nullptr)
+				return nullptr;
+
+			header->owner = nullptr;
+			header->info = size;
+
+			if (cache != nullptr)
+				addToCounter(cache->systemBytesAllocated, size);
+			else
+				gDetachedSystemBytesAllocated.fetch_add(size, std::memory_order_relaxed);
+
+			return header + 1;
+		}
+	}
+
+	void* ThreadCachingAlloc::allocate(size_t bytes)
+	{
+		ThreadCache* cache = tCache;
+
+		if (bytes <= MAX_SMALL_SIZE - sizeof(BlockHeader))
+		{
+			if (cache == nullptr)
+				cache = acquireCache();
+
+			if (cache != nullptr)
+			{
+				const UINT32 sizeClass = getSizeClass((UINT32)(bytes + sizeof(BlockHeader)));
+
+				FreeBlock* block = cache->freeLists[sizeClass];
+				if (block != nullptr)
+					cache->freeLists[sizeClass] = block->next;
+				else
+				{
+					block = allocateSlow(*cache, sizeClass);
+					if (block == nullptr)
+						return nullptr;
+				}
+
+				addToCounter(cache->bytesAllocated, getClassSize(sizeClass));
+
+				return &block->header + 1;
+			}
+		}
+
+		if (bytes > std::numeric_limits<size_t>::max() - sizeof(BlockHeader))
+			return nullptr;
+
+		return allocateSystem(cache, bytes + sizeof(BlockHeader));
+	}
+
+	void ThreadCachingAlloc::free(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		FreeBlock* block = (FreeBlock*)((BlockHeader*)ptr - 1);
+		ThreadCache* owner = block->header.owner;
+
+		ThreadCache* cache = tCache;
+		if (cache == nullptr)
+			cache = acquireCache();
+
+		if (owner == nullptr)
+		{
+			if (cache != nullptr)
+				addToCounter(cache->systemBytesFreed, block->header.info);
+			else
+				gDetachedSystemBytesFreed.fetch_add(block->header.info, std::memory_order_relaxed);
+
+			::free(block);
+			return;
+		}
+
+		const UINT32 sizeClass = (UINT32)block->header.info;
+		if (cache == nullptr)
+		{
+			// Thread is exiting, hand over the block right away
+			gDetachedBytesFreed.fetch_add(getClassSize(sizeClass), std::memory_order_relaxed);
+
+			pushRemoteFrees(owner, block, block);
+			return;
+		}
+
+		addToCounter(cache->bytesFreed, getClassSize(sizeClass));
+
+		if (owner == cache)
+		{
+			block->next = cache->freeLists[sizeClass];
+			cache->freeLists[sizeClass] = block;
+			return;
+		}
+
+		RemoteBatch& batch = cache->remoteBatches[((size_t)owner / sizeof(ThreadCache)) % NUM_REMOTE_BATCHES];
+		if (batch.owner != owner)
+		{
+			flushRemoteBatch(batch);
+
+			batch.owner = owner;
+			batch.last = block;
+		}
+
+		block->next = batch.first;
+		batch.first = block;
+		batch.count++;
+
+		if (batch.count >= REMOTE_BATCH_SIZE)
+			flushRemoteBatch(batch);
+	}
+
+	void ThreadCachingAlloc::flushRemoteFrees()
+	{
+		ThreadCache* cache = tCache;
+		if (cache == nullptr)
+			return;
+
+		for (auto& batch : cache->remoteBatches)
+			flushRemoteBatch(batch);
+	}
+
+	ThreadCachingAlloc::Stats ThreadCachingAlloc::getStats()
+	{
+		UINT64 bytesAllocated = 0;
+		UINT64 bytesFreed = gDetachedBytesFreed.load(std::memory_order_relaxed);
+		UINT64 systemBytesAllocated = gDetachedSystemBytesAllocated.load(std::memory_order_relaxed);
+		UINT64 systemBytesFreed = gDetachedSystemBytesFreed.load(std::memory_order_relaxed);
+		UINT64 slabBytes = 0;
+
+		Stats stats;
+		{
+			Lock lock(gCacheMutex);
+
+			for (ThreadCache* cache = gFirstCache; cache != nullptr; cache = cache->nextCache)
+			{
+				bytesAllocated += cache->bytesAllocated.load(std::memory_order_relaxed);
+				bytesFreed += cache->bytesFreed.load(std::memory_order_relaxed);
+				systemBytesAllocated += cache->systemBytesAllocated.load(std::memory_order_relaxed);
+				systemBytesFreed += cache->systemBytesFreed.load(std::memory_order_relaxed);
+				slabBytes += cache->slabBytes.load(std::memory_order_relaxed);
+			}
+
+			stats.numThreadCaches = gNumCaches;
+		}
+
+		// Counters of different threads aren't read at the same time, so a free can be seen before its allocation
+		const UINT64 systemBytesInUse =
+			systemBytesAllocated > systemBytesFreed ? systemBytesAllocated - systemBytesFreed : 0;
+		const UINT64 cachedBytesInUse = bytesAllocated > bytesFreed ? bytesAllocated - bytesFreed : 0;
+
+		stats.bytesInUse = cachedBytesInUse + systemBytesInUse;
+		stats.bytesReserved = slabBytes + systemBytesInUse;
+
+		return stats;
+	}
+}
@@ -0,0 +1,64 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
+	/**
+	 * General purpose allocator that serves small allocations from per-thread caches, so most allocations and frees
+	 * don't need to synchronize with other threads. Allocation sizes are rounded up to one of a set of size classes,
+	 * and each thread carves the blocks of a size class from larger slabs it owns. Blocks freed on a thread other than
+	 * the one that allocated them are collected in batches and handed back to the owning thread using a single atomic
+	 * operation per batch. Allocations larger than MAX_SMALL_SIZE are passed to the system allocator.
+	 *
+	 * Freed memory is kept in the caches for reuse rather than returned to the system. When a thread exits its cache
+	 * is handed over to the next thread that starts allocating.
+	 *
+	 * @note	Used by MemoryAllocator<GenAlloc> when the GENERAL_ALLOCATOR CMake option is set to ThreadCaching.
+	 */
+	class BS_UTILITY_EXPORT ThreadCachingAlloc
+	{
+	public:
+		/** Statistics about the memory managed by the allocator, across all threads. */
+		struct Stats
+		{
+			/** Bytes in blocks that are currently allocated, including the size class rounding and block headers. */
+			uint64_t bytesInUse = 0;
+
+			/** Bytes currently requested from the system, including slabs and blocks kept in the caches. */
+			uint64_t bytesReserved = 0;
+
+			/** Number of thread caches that were created. */
+			uint32_t numThreadCaches = 0;
+		};
+
+		/** Allocates @p bytes bytes, aligned to a 16 byte boundary. */
+		static void* allocate(size_t bytes);
+
+		/** Frees memory previously allocated with allocate(). Can be called from any thread. */
+		static void free(void* ptr);
+
+		/**
+		 * Hands over any blocks freed by the calling thread that belong to other threads, instead of waiting until
+		 * enough of them are collected. Called automatically when a thread exits.
+		 */
+		static void flushRemoteFrees();
+
+		/** Returns statistics about the memory managed by the allocator. Can be called from any thread. */
+		static Stats getStats();
+
+		/** Largest allocation size, including the block header, that is served from the thread caches. */
+		static constexpr size_t MAX_SMALL_SIZE = 32768;
+	};
+
+	/** @} */
+	/** @} */
+}
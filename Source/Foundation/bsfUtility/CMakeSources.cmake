@@ -4,6 +4,7 @@ set(BS_UTILITY_INC_THREADING
 	"bsfUtility/Threading/BsSpinLock.h"
 	"bsfUtility/Threading/BsThreadPool.h"
 	"bsfUtility/Threading/BsTaskScheduler.h"
+	"bsfUtility/Threading/BsWorkStealingQueue.h"
 )
 
 set(BS_UTILITY_SRC_THIRDPARTY
@@ -112,6 +113,7 @@ set(BS_UTILITY_SRC_ALLOCATORS
 	"bsfUtility/Allocators/BsFrameAlloc.cpp"
 	"bsfUtility/Allocators/BsStackAlloc.cpp"
 	"bsfUtility/Allocators/BsMemoryAllocator.cpp"
+	"bsfUtility/Allocators/BsThreadCachingAlloc.cpp"
 )
 
 set(BS_UTILITY_SRC_REFLECTION
@@ -141,6 +143,7 @@ set(BS_UTILITY_INC_ALLOCATORS
 	"bsfUtility/Allocators/BsGroupAlloc.h"
 	"bsfUtility/Allocators/BsFreeAlloc.h"
 	"bsfUtility/Allocators/BsPoolAlloc.h"
+	"bsfUtility/Allocators/BsThreadCachingAlloc.h"
 )
 
 set(BS_UTILITY_INC_THIRDPARTY
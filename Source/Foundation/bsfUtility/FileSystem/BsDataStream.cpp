@@ -309,6 +309,45 @@ namespace bs
 		}
 	}
 
+	MemoryMappedDataStream::MemoryMappedDataStream(const SPtr<MemoryMappedFile>& file)
+		:MemoryDataStream(file->getData(), file->getSize(), false), mFile(file)
+	{
+		mAccess = READ;
+	}
+
+	MemoryMappedDataStream::MemoryMappedDataStream(const SPtr<MemoryMappedFile>& file, UINT8* data, size_t size)
+		:MemoryDataStream(data, size, false), mFile(file)
+	{
+		assert(data >= file->getData() && (data + size) <= (file->getData() + file->getSize()));
+
+		mAccess = READ;
+	}
+
+	SPtr<MemoryMappedDataStream> MemoryMappedDataStream::createView(size_t size) const
+	{
+		size = std::min(size, (size_t)(mEnd - mPos));
+		return bs_shared_ptr_new<MemoryMappedDataStream>(mFile, mPos, size);
+	}
+
+	SPtr<DataStream> MemoryMappedDataStream::clone(bool copyData) const
+	{
+		if (!copyData)
+		{
+			SPtr<MemoryMappedDataStream> stream = bs_shared_ptr_new<MemoryMappedDataStream>(mFile, mData, mSize);
+			stream->seek(tell());
+
+			return stream;
+		}
+
+		UINT8* data = (UINT8*)bs_alloc((UINT32)mSize);
+		memcpy(data, mData, mSize);
+
+		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(data, mSize, true);
+		stream->seek(tell());
+
+		return stream;
+	}
+
 	FileDataStream::FileDataStream(const Path& path, AccessMode accessMode, bool freeOnClose)
 		: DataStream(accessMode), mPath(path), mFreeOnClose(freeOnClose)
 	{
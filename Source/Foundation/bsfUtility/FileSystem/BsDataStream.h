@@ -50,6 +50,19 @@ namespace bs
 		virtual bool isWriteable() const { return (mAccess & WRITE) != 0; }
 		virtual bool isFile() const = 0;
 
+		/**
+		 * Returns true if the stream reads from a file mapped into memory. Such streams are always of
+		 * MemoryMappedDataStream type, and allow their data to be referenced directly instead of being copied.
+		 */
+		virtual bool isMemoryMapped() const { return false; }
+
+		/**
+		 * Returns true if the stream's data is stored contiguously in memory. Such streams are always of
+		 * MemoryDataStream type, and their data can be read directly through MemoryDataStream::getPtr() instead of
+		 * through the stream.
+		 */
+		virtual bool isMemory() const { return false; }
+
 		/** Reads data from the buffer and copies it to the specified value. */
 		template<typename T> DataStream& operator>>(T& val);
 
@@ -191,6 +204,9 @@ namespace bs
 
 		bool isFile() const override { return false; }
 
+		/** @copydoc DataStream::isMemory */
+		bool isMemory() const override { return true; }
+
 		/** Get a pointer to the start of the memory block this stream holds. */
 		UINT8* getPtr() const { return mData; }
 		
@@ -282,6 +298,68 @@ namespace bs
 		bool mFreeOnClose;	
 	};
 
+	/**
+	 * Contents of a file mapped into memory, unmapped when the object is destroyed. The mapping is private to the process
+	 * so the mapped memory can be written to without affecting the file. Pages are only copied once they are written to.
+	 *
+	 * @see		FileSystem::openFileMapped
+	 */
+	class BS_UTILITY_EXPORT MemoryMappedFile
+	{
+	public:
+		/** Takes ownership of an existing mapping. Use FileSystem::openFileMapped to create one. */
+		MemoryMappedFile(UINT8* data, size_t size)
+			:mData(data), mSize(size)
+		{ }
+
+		~MemoryMappedFile();
+
+		/** Returns a pointer to the start of the mapped memory. */
+		UINT8* getData() const { return mData; }
+
+		/** Returns the size of the mapped memory, in bytes. */
+		size_t getSize() const { return mSize; }
+
+	private:
+		UINT8* mData;
+		size_t mSize;
+	};
+
+	/**
+	 * Data stream reading from a file mapped into memory. Reading from the stream is as fast as reading from a
+	 * MemoryDataStream, but the file is never loaded in its entirety and its pages are backed by the file rather than
+	 * the heap. Parts of the stream can be referenced through views that keep the mapping alive, allowing large blocks of
+	 * data to be used directly from the mapping without copying. The stream is read-only.
+	 */
+	class BS_UTILITY_EXPORT MemoryMappedDataStream : public MemoryDataStream
+	{
+	public:
+		/** Creates a stream over the entire mapped file. */
+		MemoryMappedDataStream(const SPtr<MemoryMappedFile>& file);
+
+		/** Creates a stream over a part of the mapped file. @p data must point within the mapped memory. */
+		MemoryMappedDataStream(const SPtr<MemoryMappedFile>& file, UINT8* data, size_t size);
+
+		/** @copydoc DataStream::isMemoryMapped */
+		bool isMemoryMapped() const override { return true; }
+
+		/**
+		 * Creates a new stream referencing the next @p size bytes of this stream, starting at the current position. No
+		 * data is copied, and the mapping remains valid for as long as the view exists. The position of this stream is not
+		 * modified.
+		 */
+		SPtr<MemoryMappedDataStream> createView(size_t size) const;
+
+		/** Returns the mapped file the stream reads from. */
+		const SPtr<MemoryMappedFile>& getMappedFile() const { return mFile; }
+
+		/** @copydoc DataStream::clone */
+		SPtr<DataStream> clone(bool copyData = true) const override;
+
+	private:
+		SPtr<MemoryMappedFile> mFile;
+	};
+
 	/** @} */
 }
 
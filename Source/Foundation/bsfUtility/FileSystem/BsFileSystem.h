@@ -30,6 +30,21 @@ namespace bs
 		 */
 		static SPtr<DataStream> createAndOpenFile(const Path& fullPath);
 
+		/**
+		 * Opens a file for reading by mapping it into memory. Data can be referenced directly from the returned stream
+		 * without copying it. See MemoryMappedDataStream.
+		 *
+		 * @param[in]	fullPath	Full path to a file.
+		 * @return					Stream over the mapped file, or null if the file cannot be mapped.
+		 *
+		 * @note
+		 * The mapping is private. Mapped memory can be written to, in which case the modified pages are copied and the file
+		 * is left unchanged. The file must not be truncated or modified in-place while the mapping is alive, as on Unix
+		 * platforms accessing such data will terminate the process. Replacing the file (removing it and creating a new one
+		 * at the same path) is safe on Unix platforms, but not possible on Windows while it is mapped.
+		 */
+		static SPtr<MemoryMappedDataStream> openFileMapped(const Path& fullPath);
+
 		/**
 		 * Returns the size of a file in bytes.
 		 *
@@ -131,6 +146,12 @@ namespace bs
 		/** Returns the path to a directory where temporary files may be stored. */
 		static Path getTempDirectoryPath();
 
+		/**
+		 * Returns the path to a directory private to the current user, where data that can be regenerated if lost may
+		 * be cached between runs. The directory is not guaranteed to exist.
+		 */
+		static Path getCacheDirectoryPath();
+
 	private:
 		/** Copy a single file. Internal function used by copy(). */
 		static void copyFile(const Path& oldPath, const Path& newPath);
@@ -139,10 +139,13 @@ namespace bs
 	class DataStream;
 	class MemoryDataStream;
 	class FileDataStream;
+	class MemoryMappedFile;
+	class MemoryMappedDataStream;
 	class MeshData;
 	class FileSystem;
 	class Timer;
 	class Task;
+	class TaskGroup;
 	class GpuResourceData;
 	class PixelData;
 	class HString;
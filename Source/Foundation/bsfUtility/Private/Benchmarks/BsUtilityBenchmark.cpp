@@ -0,0 +1,537 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTimer.h"
+#include "Utility/BsCompression.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Math/BsQuaternion.h"
+#include "Math/BsVector3.h"
+#include "Reflection/BsRTTIType.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Allocators/BsThreadCachingAlloc.h"
+#include "BsEngineConfig.h"
+
+#include <iostream>
+
+namespace bs
+{
+	/** Returns a human readable name of a task scheduler mode. */
+	const char* toString(TaskSchedulerMode mode)
+	{
+		return mode == TaskSchedulerMode::WorkStealing ? "WorkStealing" : "GlobalQueue";
+	}
+
+	/** Object similar to a scene object with a few components, used for benchmarking the binary serializer. */
+	class BenchmarkSerializable : public IReflectable
+	{
+	public:
+		String name;
+		Vector3 position;
+		Quaternion rotation;
+		Vector3 scale;
+		UINT32 flags = 0;
+		Vector<float> values;
+		Vector<SPtr<BenchmarkSerializable>> children;
+
+		friend class BenchmarkSerializableRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	class BenchmarkSerializableRTTI : public RTTIType<BenchmarkSerializable, IReflectable, BenchmarkSerializableRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(name, 0)
+			BS_RTTI_MEMBER_PLAIN(position, 1)
+			BS_RTTI_MEMBER_PLAIN(rotation, 2)
+			BS_RTTI_MEMBER_PLAIN(scale, 3)
+			BS_RTTI_MEMBER_PLAIN(flags, 4)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(values, 5)
+			BS_RTTI_MEMBER_REFLPTR_ARRAY(children, 6)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "BenchmarkSerializable";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return 60000;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<BenchmarkSerializable>();
+		}
+	};
+
+	RTTITypeBase* BenchmarkSerializable::getRTTIStatic()
+	{
+		return BenchmarkSerializableRTTI::instance();
+	}
+
+	RTTITypeBase* BenchmarkSerializable::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+
+	/**
+	 * Measures throughput of a large number of small tasks, as well as the latency between a task being queued and
+	 * starting to execute, for each task scheduler mode.
+	 */
+	void benchmarkTaskScheduler()
+	{
+		static constexpr UINT32 NUM_TASKS = 20000;
+		static constexpr UINT32 NUM_LATENCY_SAMPLES = 1000;
+		static constexpr UINT32 NUM_ITERATIONS_PER_TASK = 256;
+
+		std::cout << "TaskScheduler (" << BS_THREAD_HARDWARE_CONCURRENCY << " hardware threads)" << std::endl;
+		for(auto mode : { TaskSchedulerMode::GlobalQueue, TaskSchedulerMode::WorkStealing })
+		{
+			// Not using the module interface, as modules cannot be restarted
+			auto scheduler = bs_new<TaskScheduler>(mode);
+
+			std::atomic<UINT32> sink{0};
+			const auto work = [&sink]()
+			{
+				UINT32 value = 0;
+				for(UINT32 i = 0; i < NUM_ITERATIONS_PER_TASK; i++)
+					value = value * 1664525 + 1013904223;
+
+				sink += value;
+			};
+
+			// Individual tasks
+			Timer timer;
+			Vector<SPtr<Task>> tasks(NUM_TASKS);
+			for(UINT32 i = 0; i < NUM_TASKS; i++)
+			{
+				tasks[i] = Task::create("Benchmark", work);
+				scheduler->addTask(tasks[i]);
+			}
+
+			for(auto& entry : tasks)
+				entry->wait();
+
+			const UINT64 taskTime = timer.getMicroseconds();
+			tasks.clear();
+
+			// Task group
+			timer.reset();
+			SPtr<TaskGroup> taskGroup = TaskGroup::create("Benchmark", [&work](UINT32) { work(); }, NUM_TASKS);
+			scheduler->addTaskGroup(taskGroup);
+			taskGroup->wait();
+
+			const UINT64 groupTime = timer.getMicroseconds();
+
+			// Parallel for, with one item per batch
+			timer.reset();
+			scheduler->parallelFor("Benchmark", NUM_TASKS, 1, [&work](UINT32 start, UINT32 end)
+			{
+				for(UINT32 i = start; i < end; i++)
+					work();
+			});
+
+			const UINT64 parallelForTime = timer.getMicroseconds();
+
+			// Latency from queuing a task to a worker starting it, measured one task at a time
+			UINT64 totalLatency = 0;
+			for(UINT32 i = 0; i < NUM_LATENCY_SAMPLES; i++)
+			{
+				UINT64 startTime = 0;
+				Timer latencyTimer;
+
+				SPtr<Task> task = Task::create("Latency", [&startTime, &latencyTimer]()
+				{
+					startTime = latencyTimer.getMicroseconds();
+				});
+
+				latencyTimer.reset();
+				scheduler->addTask(task);
+
+				// Don't use wait(), as it might execute the task on this thread
+				while(!task->isComplete())
+					std::this_thread::yield();
+
+				totalLatency += startTime;
+			}
+
+			const auto toTasksPerMs = [](UINT64 time) { return NUM_TASKS * 1000.0 / std::max(time, (UINT64)1); };
+
+			std::cout << "  " << toString(mode) << " (" << scheduler->getNumWorkers() << " workers)" << std::endl;
+			std::cout << "    Tasks:        " << toTasksPerMs(taskTime) << " tasks/ms" << std::endl;
+			std::cout << "    Task group:   " << toTasksPerMs(groupTime) << " tasks/ms" << std::endl;
+			std::cout << "    Parallel for: " << toTasksPerMs(parallelForTime) << " tasks/ms" << std::endl;
+			std::cout << "    Latency:      " << totalLatency / (double)NUM_LATENCY_SAMPLES << " us" << std::endl;
+
+			bs_delete(scheduler);
+		}
+	}
+
+	/** Returns a human readable name of a compression codec. */
+	const char* toString(CompressionCodec codec)
+	{
+		switch(codec)
+		{
+		case CompressionCodec::LZ4:
+			return "LZ4";
+		case CompressionCodec::Zstd:
+			return "Zstd";
+		default:
+			return "Snappy";
+		}
+	}
+
+	/**
+	 * Measures compression ratio and compression/decompression times of all files in the provided folder, for the
+	 * legacy whole-stream Snappy compression and for each available block compression codec. Files are measured both
+	 * individually (as resources are stored) and concatenated into a single stream, with and without the task scheduler
+	 * distributing the blocks over multiple threads.
+	 */
+	void benchmarkCompression(const Path& folder)
+	{
+		static constexpr UINT32 NUM_ITERATIONS = 10;
+
+		Vector<SPtr<MemoryDataStream>> files;
+		size_t totalSize = 0;
+		FileSystem::iterate(folder, [&files, &totalSize](const Path& path)
+		{
+			SPtr<DataStream> file = FileSystem::openFile(path);
+			if(file != nullptr && file->size() > 0)
+			{
+				files.push_back(bs_shared_ptr_new<MemoryDataStream>(file));
+				totalSize += file->size();
+			}
+
+			return true;
+		});
+
+		SPtr<MemoryDataStream> bundle = bs_shared_ptr_new<MemoryDataStream>(std::max(totalSize, (size_t)1));
+		for(auto& entry : files)
+			bundle->write(entry->getPtr(), entry->size());
+
+		std::cout << "Compression (" << files.size() << " files, " << totalSize / 1024 << " KB in \"" <<
+			folder.toString() << "\", " << NUM_ITERATIONS << " iterations)" << std::endl;
+
+		if(files.empty())
+			return;
+
+		struct Result
+		{
+			size_t compressedSize = 0;
+			UINT64 compressTime = 0;
+			UINT64 decompressTime = 0;
+		};
+
+		// Compresses and decompresses the provided streams, using the block codec or the legacy method if not provided
+		const auto measure = [](const Vector<SPtr<MemoryDataStream>>& streams, const CompressionCodec* codec)
+		{
+			Result result;
+			for(auto& entry : streams)
+			{
+				SPtr<MemoryDataStream> compressed;
+
+				Timer timer;
+				for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+				{
+					SPtr<DataStream> input = entry->clone(false);
+					compressed = codec ? Compression::compressBlocks(input, *codec) : Compression::compress(input);
+				}
+				result.compressTime += timer.getMicroseconds();
+				result.compressedSize += compressed->size();
+
+				timer.reset();
+				for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+				{
+					SPtr<DataStream> input = compressed->clone(false);
+					SPtr<MemoryDataStream> decompressed = codec ? Compression::decompressBlocks(input) :
+						Compression::decompress(input);
+
+					if(decompressed == nullptr || decompressed->size() != entry->size())
+						std::cout << "    Decompressed data doesn't match the source" << std::endl;
+				}
+				result.decompressTime += timer.getMicroseconds();
+			}
+
+			return result;
+		};
+
+		const auto print = [totalSize](const char* name, const Result& result)
+		{
+			const auto toMsPerIteration = [](UINT64 time) { return time / (1000.0 * NUM_ITERATIONS); };
+
+			std::cout << "    " << name << ": ratio " << totalSize / (double)result.compressedSize <<
+				", compress " << toMsPerIteration(result.compressTime) << " ms, decompress " <<
+				toMsPerIteration(result.decompressTime) << " ms" << std::endl;
+		};
+
+		Vector<SPtr<MemoryDataStream>> bundles = { bundle };
+		const CompressionCodec codecs[] = { CompressionCodec::Snappy, CompressionCodec::LZ4, CompressionCodec::Zstd };
+
+		// The task scheduler cannot be restarted, so run all the single threaded measurements first
+		for(auto parallel : { false, true })
+		{
+			if(parallel)
+				TaskScheduler::startUp();
+
+			for(auto* streams : { &files, &bundles })
+			{
+				std::cout << "  " << (streams == &files ? "Per file" : "Concatenated") <<
+					(parallel ? " (parallel)" : "") << std::endl;
+
+				if(!parallel)
+					print("Snappy (whole stream)", measure(*streams, nullptr));
+
+				for(auto codec : codecs)
+				{
+					if(!Compression::isSupported(codec))
+						continue;
+
+					const String name = String(toString(codec)) + " (blocks)";
+					print(name.c_str(), measure(*streams, &codec));
+				}
+			}
+
+			if(parallel)
+				TaskScheduler::shutDown();
+		}
+	}
+
+	/**
+	 * Measures the throughput of BinarySerializer when decoding a large hierarchy of objects, similar to a scene or a
+	 * prefab, from a file stream, from memory, and from a memory mapped file.
+	 */
+	void benchmarkBinarySerializer()
+	{
+		static constexpr UINT32 NUM_OBJECTS = 20000;
+		static constexpr UINT32 NUM_CHILDREN = 8;
+		static constexpr UINT32 NUM_VALUES = 16;
+		static constexpr UINT32 NUM_ITERATIONS = 10;
+
+		Vector<SPtr<BenchmarkSerializable>> objects;
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			SPtr<BenchmarkSerializable> object = bs_shared_ptr_new<BenchmarkSerializable>();
+			object->name = "Object " + toString(i);
+			object->position = Vector3((float)i, 1.0f, 2.0f);
+			object->rotation = Quaternion::IDENTITY;
+			object->scale = Vector3::ONE;
+			object->flags = i;
+			object->values.resize(NUM_VALUES, (float)i);
+
+			if(i > 0)
+				objects[(i - 1) / NUM_CHILDREN]->children.push_back(object);
+
+			objects.push_back(object);
+		}
+
+		MemorySerializer memorySerializer;
+		UINT32 size = 0;
+		UINT8* encoded = memorySerializer.encode(objects[0].get(), size);
+		objects.clear();
+
+		const Path path = FileSystem::getTempDirectoryPath() + "bsfBinarySerializerBenchmark.asset";
+		FileSystem::createAndOpenFile(path)->write(encoded, size);
+
+		std::cout << "Binary serializer (" << NUM_OBJECTS << " objects, " << size / 1024 << " KB)" << std::endl;
+
+		const auto measure = [size](const char* name, const std::function<SPtr<DataStream>()>& openStream)
+		{
+			Timer timer;
+			for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			{
+				SPtr<DataStream> stream = openStream();
+
+				BinarySerializer serializer;
+				SPtr<IReflectable> decoded = serializer.decode(stream, size);
+
+				if(decoded == nullptr)
+					std::cout << "    Failed to decode the data" << std::endl;
+			}
+
+			const double seconds = timer.getMicroseconds() / 1000000.0;
+			const double megabytes = (size * (double)NUM_ITERATIONS) / (1024 * 1024);
+			std::cout << "    " << name << ": " << megabytes / seconds << " MB/s" << std::endl;
+		};
+
+		measure("File stream", [&path]() { return FileSystem::openFile(path); });
+		measure("Memory", [encoded, size]() { return bs_shared_ptr_new<MemoryDataStream>(encoded, size, false); });
+		measure("Memory mapped", [&path]() { return FileSystem::openFileMapped(path); });
+
+		FileSystem::remove(path);
+		bs_free(encoded);
+	}
+
+	/**
+	 * Compares the system allocator with ThreadCachingAlloc, using a pattern of small, short lived allocations similar
+	 * to containers and shared pointers. Measured on one thread, on all hardware threads at once, and with blocks
+	 * allocated on one thread and freed on another.
+	 */
+	void benchmarkThreadCachingAlloc()
+	{
+		static constexpr UINT32 NUM_OPERATIONS = 2000000;
+		static constexpr UINT32 NUM_LIVE_ALLOCATIONS = 1024;
+
+		struct Allocator
+		{
+			const char* name;
+			void* (*allocate)(size_t);
+			void (*free)(void*);
+		};
+
+		const Allocator allocators[] =
+		{
+			{ "System", [](size_t size) { return ::malloc(size); }, [](void* ptr) { ::free(ptr); } },
+			{ "ThreadCaching", &ThreadCachingAlloc::allocate, &ThreadCachingAlloc::free }
+		};
+
+		// Replaces allocations at random slots, with sizes mostly in the range of small objects
+		const auto run = [](const Allocator& allocator, UINT32 seed)
+		{
+			void* live[NUM_LIVE_ALLOCATIONS] = { };
+
+			UINT32 random = seed;
+			for(UINT32 i = 0; i < NUM_OPERATIONS; i++)
+			{
+				random = random * 1664525 + 1013904223;
+
+				const UINT32 slot = (random >> 8) % NUM_LIVE_ALLOCATIONS;
+				const size_t size = (random >> 24) < 8 ? 4096 : 16 + (random >> 24);
+
+				allocator.free(live[slot]);
+				live[slot] = allocator.allocate(size);
+				*(UINT8*)live[slot] = (UINT8)i;
+			}
+
+			for(auto& entry : live)
+				allocator.free(entry);
+		};
+
+		const UINT32 numThreads = std::max(BS_THREAD_HARDWARE_CONCURRENCY, 2U);
+		const auto toOpsPerUs = [](UINT64 numOperations, UINT64 time)
+		{
+			return numOperations / (double)std::max(time, (UINT64)1);
+		};
+
+		std::cout << "General allocator (" << numThreads << " threads)" << std::endl;
+		for(auto& allocator : allocators)
+		{
+			// Single thread
+			Timer timer;
+			run(allocator, 0);
+
+			const UINT64 singleThreadTime = timer.getMicroseconds();
+
+			// All threads allocating at once
+			timer.reset();
+			Vector<Thread> threads;
+			for(UINT32 i = 0; i < numThreads; i++)
+				threads.emplace_back([&allocator, &run, i]() { run(allocator, i); });
+
+			for(auto& entry : threads)
+				entry.join();
+
+			const UINT64 multiThreadTime = timer.getMicroseconds();
+			threads.clear();
+
+			// Pairs of threads, with one thread allocating blocks and the other one freeing them
+			static constexpr UINT32 NUM_BLOCKS_PER_BATCH = 256;
+			const UINT32 numPairs = numThreads / 2;
+			const UINT32 numBatches = NUM_OPERATIONS / NUM_BLOCKS_PER_BATCH;
+
+			struct Pair
+			{
+				Mutex mutex;
+				Signal signal;
+				Vector<Vector<void*>> batches;
+			};
+
+			Vector<UPtr<Pair>> pairs;
+			for(UINT32 i = 0; i < numPairs; i++)
+				pairs.push_back(bs_unique_ptr_new<Pair>());
+
+			timer.reset();
+			for(auto& pair : pairs)
+			{
+				Pair* pairPtr = pair.get();
+				threads.emplace_back([&allocator, pairPtr, numBatches]()
+				{
+					for(UINT32 i = 0; i < numBatches; i++)
+					{
+						Vector<void*> batch(NUM_BLOCKS_PER_BATCH);
+						for(UINT32 j = 0; j < NUM_BLOCKS_PER_BATCH; j++)
+							batch[j] = allocator.allocate(16 + (j % 16) * 16);
+
+						Lock lock(pairPtr->mutex);
+						pairPtr->batches.push_back(std::move(batch));
+						pairPtr->signal.notify_one();
+					}
+				});
+
+				threads.emplace_back([&allocator, pairPtr, numBatches]()
+				{
+					for(UINT32 i = 0; i < numBatches; i++)
+					{
+						Vector<void*> batch;
+						{
+							Lock lock(pairPtr->mutex);
+							pairPtr->signal.wait(lock, [pairPtr]() { return !pairPtr->batches.empty(); });
+
+							batch = std::move(pairPtr->batches.back());
+							pairPtr->batches.pop_back();
+						}
+
+						for(auto& entry : batch)
+							allocator.free(entry);
+					}
+
+					ThreadCachingAlloc::flushRemoteFrees();
+				});
+			}
+
+			for(auto& entry : threads)
+				entry.join();
+
+			const UINT64 crossThreadTime = timer.getMicroseconds();
+
+			std::cout << "  " << allocator.name << std::endl;
+			std::cout << "    Single thread: " << toOpsPerUs(NUM_OPERATIONS, singleThreadTime)
+				<< " ops/us" << std::endl;
+			std::cout << "    All threads:   " << toOpsPerUs((UINT64)NUM_OPERATIONS * numThreads, multiThreadTime)
+				<< " ops/us" << std::endl;
+			std::cout << "    Cross thread:  " << toOpsPerUs((UINT64)numBatches * NUM_BLOCKS_PER_BATCH * numPairs,
+				crossThreadTime) << " ops/us" << std::endl;
+		}
+
+		const ThreadCachingAlloc::Stats stats = ThreadCachingAlloc::getStats();
+		std::cout << "  Thread caching: " << stats.numThreadCaches << " caches, " << stats.bytesReserved / 1024
+			<< " KB reserved" << std::endl;
+	}
+}
+
+using namespace bs;
+
+int main(int argc, char* argv[])
+{
+	MemStack::beginThread();
+	ThreadPool::startUp<TThreadPool<>>(BS_THREAD_HARDWARE_CONCURRENCY);
+
+	benchmarkTaskScheduler();
+	benchmarkBinarySerializer();
+	benchmarkThreadCachingAlloc();
+
+	// Built-in framework data, unless a different folder is provided
+	benchmarkCompression(argc > 1 ? Path(argv[1]) : Path(RAW_APP_ROOT) + Path("Data/"));
+
+	ThreadPool::shutDown();
+	MemStack::endThread();
+
+	return 0;
+}
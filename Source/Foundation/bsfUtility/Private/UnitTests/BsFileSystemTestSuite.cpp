@@ -5,6 +5,7 @@
 #include "Debug/BsDebug.h"
 #include "Error/BsException.h"
 #include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
 
 #include <algorithm>
 #include <fstream>
@@ -38,6 +39,9 @@ namespace bs
 
 	void FileSystemTestSuite::startUp()
 	{
+		// Path comparisons convert case using stack allocations
+		MemStack::beginThread();
+
 		mTestDirectory = FileSystem::getWorkingDirectoryPath() + testDirectoryName;
 		if (FileSystem::exists(mTestDirectory))
 		{
@@ -57,9 +61,11 @@ namespace bs
 		FileSystem::remove(mTestDirectory, true);
 		if (FileSystem::exists(mTestDirectory))
 		{
-			LOGERR("FileSystemTestSuite failed to delete '" + mTestDirectory.toString()
+			BS_LOG(Error, FileSystem, "FileSystemTestSuite failed to delete '" + mTestDirectory.toString()
 				   + "', you should remove it manually.");
 		}
+
+		MemStack::endThread();
 	}
 
 	FileSystemTestSuite::FileSystemTestSuite()
@@ -84,6 +90,7 @@ namespace bs
 		BS_ADD_TEST(FileSystemTestSuite::testGetChildren);
 		BS_ADD_TEST(FileSystemTestSuite::testGetLastModifiedTime);
 		BS_ADD_TEST(FileSystemTestSuite::testGetTempDirectoryPath);
+		BS_ADD_TEST(FileSystemTestSuite::testOpenFileMapped);
 	}
 
 	void FileSystemTestSuite::testExists_yes_file()
@@ -299,4 +306,56 @@ namespace bs
 		/* No judging. */
 		BS_TEST_ASSERT(!path.toString().empty());
 	}
+
+	void FileSystemTestSuite::testOpenFileMapped()
+	{
+		BS_TEST_ASSERT(FileSystem::openFileMapped(mTestDirectory + "mapped-file-missing") == nullptr);
+
+		Path path = mTestDirectory + "mapped-file";
+		createFile(path, "mapped-data-0123456789");
+
+		SPtr<MemoryMappedDataStream> stream = FileSystem::openFileMapped(path);
+		BS_TEST_ASSERT(stream != nullptr);
+		BS_TEST_ASSERT(stream->isMemoryMapped());
+		BS_TEST_ASSERT(stream->size() == 22);
+
+		// Streams over the mapping are read-only
+		BS_TEST_ASSERT(!stream->isWriteable());
+		BS_TEST_ASSERT(stream->write("x", 1) == 0);
+
+		char prefix[7];
+		BS_TEST_ASSERT(stream->read(prefix, sizeof(prefix)) == sizeof(prefix));
+		BS_TEST_ASSERT(memcmp(prefix, "mapped-", sizeof(prefix)) == 0);
+
+		// Views reference the mapped memory directly, and don't modify the source stream
+		SPtr<MemoryMappedDataStream> view = stream->createView(4);
+		BS_TEST_ASSERT(view->getCurrentPtr() == stream->getCurrentPtr());
+		BS_TEST_ASSERT(view->size() == 4);
+		BS_TEST_ASSERT(!view->isWriteable());
+		BS_TEST_ASSERT(stream->tell() == 7);
+
+		// Copies don't reference the mapping, and can be modified
+		SPtr<DataStream> copy = stream->clone(true);
+		BS_TEST_ASSERT(!copy->isMemoryMapped());
+		BS_TEST_ASSERT(copy->isWriteable());
+		BS_TEST_ASSERT(copy->tell() == 7);
+
+		// Mapped memory can be modified in-place, without modifying the file
+		UINT8* mappedData = stream->getMappedFile()->getData();
+		mappedData[0] = 'M';
+		BS_TEST_ASSERT(readFile(path) == "mapped-data-0123456789");
+		BS_TEST_ASSERT(mappedData[0] == 'M');
+
+#if BS_PLATFORM != BS_PLATFORM_WIN32
+		// Mapping must remain valid while a view exists, even if the file is replaced
+		stream = nullptr;
+		FileSystem::remove(path);
+		createFile(path, "replaced");
+
+		char data[4];
+		BS_TEST_ASSERT(view->read(data, sizeof(data)) == sizeof(data));
+		BS_TEST_ASSERT(memcmp(data, "data", sizeof(data)) == 0);
+		BS_TEST_ASSERT(view->eof());
+#endif
+	}
 }
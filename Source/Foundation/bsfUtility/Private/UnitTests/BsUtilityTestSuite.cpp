@@ -10,6 +10,14 @@
 #include "Utility/BsQuadtree.h"
 #include "Utility/BsBitstream.h"
 #include "Utility/BsUSPtr.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsCompression.h"
+#include "FileSystem/BsDataStream.h"
+#include "FileSystem/BsFileSystem.h"
+#include "Reflection/BsRTTIType.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Allocators/BsThreadCachingAlloc.h"
 
 namespace bs
 {
@@ -78,14 +86,74 @@ namespace bs
 	};
 
 	typedef Quadtree<UINT32, DebugQuadtreeOptions> DebugQuadtree;
+
+	/** Object with a mix of field types, used for testing the binary serializer. */
+	class DebugSerializable : public IReflectable
+	{
+	public:
+		UINT32 intValue = 0;
+		float floatValue = 0.0f;
+		String stringValue;
+		Vector<Vector3> vectors;
+		Vector<String> strings;
+		SPtr<DebugSerializable> child;
+
+		friend class DebugSerializableRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	class DebugSerializableRTTI : public RTTIType<DebugSerializable, IReflectable, DebugSerializableRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(intValue, 0)
+			BS_RTTI_MEMBER_PLAIN(floatValue, 1)
+			BS_RTTI_MEMBER_PLAIN(stringValue, 2)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(vectors, 3)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(strings, 4)
+			BS_RTTI_MEMBER_REFLPTR(child, 10)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "DebugSerializable";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return 60000;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<DebugSerializable>();
+		}
+	};
+
+	RTTITypeBase* DebugSerializable::getRTTIStatic()
+	{
+		return DebugSerializableRTTI::instance();
+	}
+
+	RTTITypeBase* DebugSerializable::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
 	void UtilityTestSuite::startUp()
 	{
 		SPtr<TestSuite> fileSystemTests = create<FileSystemTestSuite>();
 		add(fileSystemTests);
+
+		// Modules cannot be restarted, so the thread pool is shared by all tests that need it
+		ThreadPool::startUp<TThreadPool<>>(BS_THREAD_HARDWARE_CONCURRENCY);
 	}
 
 	void UtilityTestSuite::shutDown()
 	{
+		ThreadPool::shutDown();
 	}
 
 	UtilityTestSuite::UtilityTestSuite()
@@ -99,6 +167,10 @@ namespace bs
 		BS_ADD_TEST(UtilityTestSuite::testQuadtree)
 		BS_ADD_TEST(UtilityTestSuite::testVarInt)
 		BS_ADD_TEST(UtilityTestSuite::testBitStream)
+		BS_ADD_TEST(UtilityTestSuite::testTaskScheduler)
+		BS_ADD_TEST(UtilityTestSuite::testCompression)
+		BS_ADD_TEST(UtilityTestSuite::testBinarySerializer)
+		BS_ADD_TEST(UtilityTestSuite::testThreadCachingAlloc)
 	}
 
 	void UtilityTestSuite::testBitfield()
@@ -262,9 +334,33 @@ namespace bs
 			elemIdx++;
 		}
 
+		// Remove every other element, and ensure the remaining elements can still be found
+		Vector<bool> removed(octreeData.elements.size(), false);
+		for(UINT32 i = 0; i < (UINT32)octreeData.elements.size(); i += 2)
+		{
+			octree.removeElement(octreeData.elements[i].octreeId);
+			removed[i] = true;
+		}
+
+		Vector<bool> found(octreeData.elements.size(), false);
+		DebugOctree::BoxIntersectIterator remainingIter(octree, AABox(Vector3::ONE * -1000.0f, Vector3::ONE * 1000.0f));
+		while(remainingIter.moveNext())
+		{
+			UINT32 element = remainingIter.getElement();
+			BS_TEST_ASSERT(!removed[element] && !found[element]);
+
+			found[element] = true;
+		}
+
+		for(UINT32 i = 0; i < (UINT32)octreeData.elements.size(); i++)
+			BS_TEST_ASSERT(found[i] != removed[i]);
+
 		// Ensure nothing goes wrong during element removal
-		for(auto& entry : octreeData.elements)
-			octree.removeElement(entry.octreeId);
+		for(UINT32 i = 0; i < (UINT32)octreeData.elements.size(); i++)
+		{
+			if(!removed[i])
+				octree.removeElement(octreeData.elements[i].octreeId);
+		}
 	}
 
 	void UtilityTestSuite::testSmallVector()
@@ -844,4 +940,424 @@ namespace bs
 		bs.read(ulv);
 		BS_TEST_ASSERT(ulv == v11);
 	}
+
+	void UtilityTestSuite::testTaskScheduler()
+	{
+		for(auto mode : { TaskSchedulerMode::GlobalQueue, TaskSchedulerMode::WorkStealing })
+		{
+			// Not using the module interface, as modules cannot be restarted
+			auto scheduler = bs_new<TaskScheduler>(mode);
+
+			// Parallel for
+			static constexpr UINT32 NUM_ITEMS = 10000;
+			Vector<UINT32> items(NUM_ITEMS, 0);
+
+			scheduler->parallelFor("Test", NUM_ITEMS, 0, [&items](UINT32 start, UINT32 end)
+			{
+				for(UINT32 i = start; i < end; i++)
+					items[i]++;
+			});
+
+			bool allProcessedOnce = true;
+			for(auto& entry : items)
+				allProcessedOnce &= entry == 1;
+
+			BS_TEST_ASSERT(allProcessedOnce);
+
+			// Dependencies
+			std::atomic<UINT32> order{0};
+			UINT32 firstOrder = 0;
+			UINT32 secondOrder = 0;
+
+			SPtr<Task> first = Task::create("First", [&order, &firstOrder]() { firstOrder = ++order; });
+			SPtr<Task> second = Task::create("Second", [&order, &secondOrder]() { secondOrder = ++order; },
+				TaskPriority::High, first);
+
+			scheduler->addTask(second);
+			scheduler->addTask(first);
+
+			second->wait();
+			BS_TEST_ASSERT(first->isComplete());
+			BS_TEST_ASSERT(second->isComplete());
+			BS_TEST_ASSERT(firstOrder == 1 && secondOrder == 2);
+
+			// Child tasks
+			static constexpr UINT32 NUM_CHILDREN = 64;
+			std::atomic<UINT32> numChildrenDone{0};
+
+			SPtr<Task> parent;
+			parent = Task::create("Parent", [scheduler, &parent, &numChildrenDone]()
+			{
+				for(UINT32 i = 0; i < NUM_CHILDREN; i++)
+				{
+					scheduler->addChildTask(parent, Task::create("Child", [&numChildrenDone]()
+					{
+						numChildrenDone++;
+					}));
+				}
+			});
+
+			scheduler->addTask(parent);
+			parent->wait();
+
+			BS_TEST_ASSERT(parent->isComplete());
+			BS_TEST_ASSERT(numChildrenDone == NUM_CHILDREN);
+
+			// Waiting on tasks from within tasks, with more waiting tasks than there are workers. Waiting threads
+			// must execute queued tasks themselves, without the thread pool creating any new threads.
+			static constexpr UINT32 NUM_OUTER = 32;
+			std::atomic<UINT32> numInnerDone{0};
+			const UINT64 numThreadsCreated = ThreadPool::instance().getNumCreated();
+
+			SPtr<TaskGroup> outerGroup = TaskGroup::create("Outer", [scheduler, &numInnerDone](UINT32)
+			{
+				SPtr<Task> inner = Task::create("Inner", [&numInnerDone]() { numInnerDone++; });
+				scheduler->addTask(inner);
+				inner->wait();
+			}, NUM_OUTER);
+
+			scheduler->addTaskGroup(outerGroup);
+			outerGroup->wait();
+
+			BS_TEST_ASSERT(numInnerDone == NUM_OUTER);
+			BS_TEST_ASSERT(ThreadPool::instance().getNumCreated() == numThreadsCreated);
+
+			// Waiting on task groups whose tasks depend on a task outside of the group, with all workers waiting. Waiting
+			// threads must execute the dependency themselves.
+			std::atomic<UINT32> numDependentDone{0};
+
+			SPtr<TaskGroup> waitingGroup = TaskGroup::create("Waiting", [scheduler, &numDependentDone](UINT32)
+			{
+				SPtr<Task> gate = Task::create("Gate", []() { }, TaskPriority::Low);
+				SPtr<TaskGroup> dependent = TaskGroup::create("Dependent", [&numDependentDone](UINT32)
+				{
+					numDependentDone++;
+				}, 2, TaskPriority::Normal, gate);
+
+				scheduler->addTaskGroup(dependent);
+				scheduler->addTask(gate);
+				dependent->wait();
+			}, NUM_OUTER);
+
+			scheduler->addTaskGroup(waitingGroup);
+			waitingGroup->wait();
+
+			BS_TEST_ASSERT(numDependentDone == NUM_OUTER * 2);
+			BS_TEST_ASSERT(ThreadPool::instance().getNumCreated() == numThreadsCreated);
+
+			// In global queue mode waiting threads don't execute tasks unrelated to the ones they're waiting on, even if
+			// the awaited tasks are blocked by a dependency running on another thread
+			if(mode == TaskSchedulerMode::GlobalQueue)
+			{
+				std::atomic<bool> blockerStarted{false};
+				SPtr<Task> blocker = Task::create("Blocker", [&blockerStarted]()
+				{
+					blockerStarted = true;
+					BS_THREAD_SLEEP(100);
+				});
+
+				scheduler->addTask(blocker);
+				while(!blockerStarted)
+					std::this_thread::yield();
+
+				ThreadId unrelatedThreadId;
+				SPtr<Task> unrelated = Task::create("Unrelated", [&unrelatedThreadId]()
+				{
+					unrelatedThreadId = BS_THREAD_CURRENT_ID;
+				}, TaskPriority::High);
+
+				SPtr<Task> awaited = Task::create("Awaited", []() { }, TaskPriority::Normal, blocker);
+
+				scheduler->addTask(unrelated);
+				scheduler->addTask(awaited);
+				awaited->wait();
+
+				BS_TEST_ASSERT(awaited->isComplete());
+
+				while(!unrelated->isComplete())
+					std::this_thread::yield();
+
+				BS_TEST_ASSERT(unrelatedThreadId != BS_THREAD_CURRENT_ID);
+			}
+
+			bs_delete(scheduler);
+		}
+	}
+
+	void UtilityTestSuite::testCompression()
+	{
+		// Mix of compressible and random data, not a multiple of the block size
+		static constexpr UINT32 HEADER_SIZE = 16;
+		static constexpr UINT32 DATA_SIZE = 100000;
+		static constexpr UINT32 BLOCK_SIZE = 8192;
+
+		Vector<UINT8> source(HEADER_SIZE + DATA_SIZE);
+		UINT32 seed = 1234;
+		for(UINT32 i = 0; i < (UINT32)source.size(); i++)
+		{
+			seed = seed * 1664525 + 1013904223;
+			source[i] = i < source.size() / 2 ? (UINT8)(i % 7) : (UINT8)(seed >> 24);
+		}
+
+		for(auto codec : { CompressionCodec::Snappy, CompressionCodec::LZ4, CompressionCodec::Zstd })
+		{
+			// Unsupported codecs fall back to Snappy, so this should work regardless of which codecs are available.
+			// Start past the beginning of the stream to ensure the current position is respected.
+			SPtr<DataStream> input = bs_shared_ptr_new<MemoryDataStream>(source.data(), source.size(), false);
+			input->seek(HEADER_SIZE);
+
+			SPtr<MemoryDataStream> compressed = Compression::compressBlocks(input, codec, BLOCK_SIZE);
+			BS_TEST_ASSERT(input->eof());
+
+			// Ensure the data that follows the compressed blocks is left in the stream
+			SPtr<MemoryDataStream> padded = bs_shared_ptr_new<MemoryDataStream>(compressed->size() + 4);
+			padded->write(compressed->getPtr(), compressed->size());
+
+			const UINT32 trailer = 0xDEADBEEF;
+			padded->write(&trailer, sizeof(trailer));
+			padded->seek(0);
+
+			SPtr<DataStream> paddedInput = padded;
+			SPtr<MemoryDataStream> decompressed = Compression::decompressBlocks(paddedInput);
+			BS_TEST_ASSERT(decompressed != nullptr);
+			if(decompressed == nullptr)
+				continue;
+
+			BS_TEST_ASSERT(decompressed->size() == DATA_SIZE);
+			BS_TEST_ASSERT(memcmp(decompressed->getPtr(), source.data() + HEADER_SIZE, DATA_SIZE) == 0);
+
+			UINT32 readTrailer = 0;
+			paddedInput->read(&readTrailer, sizeof(readTrailer));
+			BS_TEST_ASSERT(readTrailer == trailer);
+		}
+
+		// Empty input
+		SPtr<DataStream> empty = bs_shared_ptr_new<MemoryDataStream>(source.data(), 0, false);
+		SPtr<DataStream> compressedEmpty = Compression::compressBlocks(empty, CompressionCodec::Snappy);
+		SPtr<MemoryDataStream> decompressedEmpty = Compression::decompressBlocks(compressedEmpty);
+		BS_TEST_ASSERT(decompressedEmpty != nullptr && decompressedEmpty->size() == 0);
+
+		// Data that isn't a block container
+		SPtr<DataStream> invalid = bs_shared_ptr_new<MemoryDataStream>(source.data(), source.size(), false);
+		BS_TEST_ASSERT(Compression::decompressBlocks(invalid) == nullptr);
+
+		// Progress callbacks while blocks are processed in parallel must not overlap, and must report increasing values
+		TaskScheduler::startUp();
+		{
+			std::atomic<UINT32> numInCallback{0};
+			std::atomic<bool> overlapped{false};
+			float lastProgress = 0.0f;
+			bool ordered = true;
+
+			auto reportProgress = [&](float progress)
+			{
+				if(numInCallback.fetch_add(1) != 0)
+					overlapped = true;
+
+				// Give other blocks a chance to finish while the callback is running
+				BS_THREAD_SLEEP(1);
+
+				if(progress < lastProgress)
+					ordered = false;
+
+				lastProgress = progress;
+				numInCallback--;
+			};
+
+			SPtr<DataStream> input = bs_shared_ptr_new<MemoryDataStream>(source.data(), source.size(), false);
+			SPtr<DataStream> compressed = Compression::compressBlocks(input, CompressionCodec::Snappy, 4096,
+				reportProgress);
+			BS_TEST_ASSERT(!overlapped && ordered && lastProgress == 1.0f);
+
+			lastProgress = 0.0f;
+			SPtr<MemoryDataStream> decompressed = Compression::decompressBlocks(compressed, reportProgress);
+			BS_TEST_ASSERT(decompressed != nullptr);
+			BS_TEST_ASSERT(!overlapped && ordered && lastProgress == 1.0f);
+		}
+		TaskScheduler::shutDown();
+	}
+
+	void UtilityTestSuite::testBinarySerializer()
+	{
+		// Decoding from streams uses stack allocations
+		MemStack::beginThread();
+
+		SPtr<DebugSerializable> root = bs_shared_ptr_new<DebugSerializable>();
+		SPtr<DebugSerializable> parent = root;
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			parent->intValue = i + 1;
+			parent->floatValue = i * 0.5f;
+			parent->stringValue = "Object " + toString(i);
+
+			for(UINT32 j = 0; j < 100; j++)
+				parent->vectors.push_back(Vector3((float)i, (float)j, -1.0f));
+
+			for(UINT32 j = 0; j < 10 * i; j++)
+				parent->strings.push_back(String(j, 'a'));
+
+			if(i < 2)
+			{
+				parent->child = bs_shared_ptr_new<DebugSerializable>();
+				parent = parent->child;
+			}
+		}
+
+		MemorySerializer memorySerializer;
+		UINT32 size = 0;
+		UINT8* encoded = memorySerializer.encode(root.get(), size);
+
+		const auto checkDecoded = [this, &root](const SPtr<IReflectable>& decodedObject)
+		{
+			BS_TEST_ASSERT(decodedObject != nullptr && rtti_is_of_type<DebugSerializable>(decodedObject));
+			if(decodedObject == nullptr)
+				return;
+
+			SPtr<DebugSerializable> decoded = std::static_pointer_cast<DebugSerializable>(decodedObject);
+			SPtr<DebugSerializable> expected = root;
+			while(expected != nullptr)
+			{
+				BS_TEST_ASSERT(decoded != nullptr);
+				if(decoded == nullptr)
+					return;
+
+				BS_TEST_ASSERT(decoded->intValue == expected->intValue);
+				BS_TEST_ASSERT(decoded->floatValue == expected->floatValue);
+				BS_TEST_ASSERT(decoded->stringValue == expected->stringValue);
+				BS_TEST_ASSERT(decoded->vectors == expected->vectors);
+				BS_TEST_ASSERT(decoded->strings == expected->strings);
+
+				expected = expected->child;
+				decoded = decoded->child;
+			}
+
+			BS_TEST_ASSERT(decoded == nullptr);
+		};
+
+		// Decodes directly from memory
+		checkDecoded(memorySerializer.decode(encoded, size));
+
+		// Decodes through a file stream, and from a memory mapped file. Offset the data to ensure the start position of
+		// the stream is respected.
+		const Path path = FileSystem::getTempDirectoryPath() + "bsfBinarySerializerTest.asset";
+		{
+			SPtr<DataStream> file = FileSystem::createAndOpenFile(path);
+			const UINT32 header = 0xDEADBEEF;
+			file->write(&header, sizeof(header));
+			file->write(encoded, size);
+		}
+
+		for(auto mapped : { false, true })
+		{
+			SPtr<DataStream> file;
+			if(mapped)
+				file = FileSystem::openFileMapped(path);
+			else
+				file = FileSystem::openFile(path);
+
+			BS_TEST_ASSERT(file != nullptr && file->isMemory() == mapped);
+			if(file == nullptr)
+				continue;
+
+			file->seek(sizeof(UINT32));
+
+			BinarySerializer serializer;
+			checkDecoded(serializer.decode(file, size));
+			BS_TEST_ASSERT(file->tell() == sizeof(UINT32) + size);
+		}
+
+		FileSystem::remove(path);
+		bs_free(encoded);
+
+		MemStack::endThread();
+	}
+	void UtilityTestSuite::testThreadCachingAlloc()
+	{
+		// Sizes around the size class boundaries, and on both sides of the small allocation limit
+		const size_t sizes[] = { 0, 1, 16, 17, 100, 112, 113, 129, 1000, 4097, 20000,
+			ThreadCachingAlloc::MAX_SMALL_SIZE - 16, ThreadCachingAlloc::MAX_SMALL_SIZE, 100000 };
+		const UINT32 numSizes = (UINT32)bs_size(sizes);
+
+		const ThreadCachingAlloc::Stats startStats = ThreadCachingAlloc::getStats();
+
+		// Containers might use the same allocator, so make sure they are released before the final check
+		{
+			Vector<UINT8*> allocations;
+			for (UINT32 i = 0; i < 8; i++)
+			{
+				for (auto& size : sizes)
+				{
+					UINT8* data = (UINT8*)ThreadCachingAlloc::allocate(size);
+					BS_TEST_ASSERT(data != nullptr && ((size_t)data & 15) == 0);
+
+					memset(data, (int)i, size);
+					allocations.push_back(data);
+				}
+			}
+
+			const ThreadCachingAlloc::Stats stats = ThreadCachingAlloc::getStats();
+			BS_TEST_ASSERT(stats.numThreadCaches >= 1);
+			BS_TEST_ASSERT(stats.bytesInUse > startStats.bytesInUse);
+			BS_TEST_ASSERT(stats.bytesReserved >= stats.bytesInUse);
+
+			// Allocations must not overlap
+			bool valid = true;
+			for (UINT32 i = 0; i < 8; i++)
+			{
+				for (UINT32 j = 0; j < numSizes; j++)
+				{
+					const UINT8* data = allocations[i * numSizes + j];
+					for (size_t k = 0; k < sizes[j]; k++)
+						valid &= data[k] == i;
+				}
+			}
+
+			BS_TEST_ASSERT(valid);
+
+			// Freed blocks are reused by the same thread
+			UINT8* freed = allocations[1];
+			ThreadCachingAlloc::free(freed);
+			allocations[1] = (UINT8*)ThreadCachingAlloc::allocate(sizes[1]);
+			BS_TEST_ASSERT(allocations[1] == freed);
+
+			// Free half of the allocations on another thread, and allocate some there to be freed on this thread
+			Vector<UINT8*> remoteAllocations(100);
+			Thread thread([&allocations, &remoteAllocations]()
+			{
+				for (size_t i = 0; i < allocations.size(); i += 2)
+					ThreadCachingAlloc::free(allocations[i]);
+
+				for (auto& entry : remoteAllocations)
+					entry = (UINT8*)ThreadCachingAlloc::allocate(64);
+			});
+			thread.join();
+
+			for (auto& entry : remoteAllocations)
+				ThreadCachingAlloc::free(entry);
+
+			ThreadCachingAlloc::flushRemoteFrees();
+
+			for (size_t i = 1; i < allocations.size(); i += 2)
+				ThreadCachingAlloc::free(allocations[i]);
+
+			// Blocks freed on the other thread are handed back and can be allocated again
+			Vector<UINT8*> newAllocations;
+			for (UINT32 i = 0; i < 8; i++)
+			{
+				for (auto& size : sizes)
+				{
+					UINT8* data = (UINT8*)ThreadCachingAlloc::allocate(size);
+					BS_TEST_ASSERT(data != nullptr && ((size_t)data & 15) == 0);
+
+					newAllocations.push_back(data);
+				}
+			}
+
+			for (auto& entry : newAllocations)
+				ThreadCachingAlloc::free(entry);
+		}
+
+		const ThreadCachingAlloc::Stats stats = ThreadCachingAlloc::getStats();
+		BS_TEST_ASSERT(stats.bytesInUse == startStats.bytesInUse);
+	}
 }
@@ -23,5 +23,9 @@ namespace bs
 		void testQuadtree();
 		void testVarInt();
 		void testBitStream();
+		void testTaskScheduler();
+		void testCompression();
+		void testBinarySerializer();
+		void testThreadCachingAlloc();
 	};
 }
@@ -8,6 +8,8 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -150,6 +152,43 @@ namespace bs
 		return bs_shared_ptr_new<FileDataStream>(path, DataStream::AccessMode::WRITE, true);
 	}
 
+	SPtr<MemoryMappedDataStream> FileSystem::openFileMapped(const Path& path)
+	{
+		String pathString = path.toString();
+
+		int fd = open(pathString.c_str(), O_RDONLY);
+		if (fd == -1)
+			return nullptr;
+
+		struct stat st_buf;
+		if (fstat(fd, &st_buf) != 0 || st_buf.st_size == 0)
+		{
+			::close(fd);
+			return nullptr;
+		}
+
+		// Private mapping, so users can modify the data in-place. Modified pages are copied and never written to the file.
+		const size_t size = (size_t)st_buf.st_size;
+		void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+		// Mapping remains valid after the descriptor is closed
+		::close(fd);
+
+		if (data == MAP_FAILED)
+		{
+			HANDLE_PATH_ERROR(pathString, errno);
+			return nullptr;
+		}
+
+		SPtr<MemoryMappedFile> file = bs_shared_ptr_new<MemoryMappedFile>((UINT8*)data, size);
+		return bs_shared_ptr_new<MemoryMappedDataStream>(file);
+	}
+
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		munmap(mData, mSize);
+	}
+
 	UINT64 FileSystem::getFileSize(const Path& path)
 	{
 		struct stat st_buf;
@@ -349,4 +388,25 @@ namespace bs
 
 		return Path(String(directoryName) + "/");
 	}
+
+	Path FileSystem::getCacheDirectoryPath()
+	{
+		const char* HOME = getenv("HOME");
+
+#if BS_PLATFORM == BS_PLATFORM_OSX
+		if (HOME != nullptr)
+			return Path(String(HOME) + "/Library/Caches/");
+#else
+		// Follow the XDG base directory specification
+		const char* XDG_CACHE_HOME = getenv("XDG_CACHE_HOME");
+		if (XDG_CACHE_HOME != nullptr && XDG_CACHE_HOME[0] == '/')
+			return Path(String(XDG_CACHE_HOME) + "/");
+
+		if (HOME != nullptr)
+			return Path(String(HOME) + "/.cache/");
+#endif
+
+		BS_LOG(Warning, FileSystem, "Unable to determine the user's home directory, caching in a temporary directory.");
+		return getTempDirectoryPath();
+	}
 }
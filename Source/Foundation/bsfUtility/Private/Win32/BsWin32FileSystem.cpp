@@ -293,6 +293,54 @@ namespace bs
 		return bs_shared_ptr_new<FileDataStream>(fullPath, DataStream::AccessMode::WRITE, true);
 	}
 
+	SPtr<MemoryMappedDataStream> FileSystem::openFileMapped(const Path& fullPath)
+	{
+		WString pathWString = UTF8::toWide(fullPath.toString());
+
+		HANDLE file = CreateFileW(pathWString.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return nullptr;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return nullptr;
+		}
+
+		// Copy-on-write, so users can modify the data in-place. Modified pages are copied and never written to the file.
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+
+		// Mapping remains valid after the file handle is closed
+		CloseHandle(file);
+
+		if (mapping == nullptr)
+		{
+			win32_handleError(GetLastError(), pathWString);
+			return nullptr;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+
+		// View remains valid after the mapping handle is closed
+		CloseHandle(mapping);
+
+		if (data == nullptr)
+		{
+			win32_handleError(GetLastError(), pathWString);
+			return nullptr;
+		}
+
+		SPtr<MemoryMappedFile> mappedFile = bs_shared_ptr_new<MemoryMappedFile>((UINT8*)data, (size_t)fileSize.QuadPart);
+		return bs_shared_ptr_new<MemoryMappedDataStream>(mappedFile);
+	}
+
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		UnmapViewOfFile(mData);
+	}
+
 	UINT64 FileSystem::getFileSize(const Path& fullPath)
 	{
 		return win32_getFileSize(UTF8::toWide(fullPath.toString()));
@@ -474,4 +522,29 @@ namespace bs
 		const String utf8dir = UTF8::fromWide(win32_getTempDirectory());
 		return Path(utf8dir);
 	}
+
+	Path FileSystem::getCacheDirectoryPath()
+	{
+		DWORD len = GetEnvironmentVariableW(L"LOCALAPPDATA", NULL, 0);
+		if (len > 0)
+		{
+			wchar_t* buffer = (wchar_t*)bs_alloc(len * sizeof(wchar_t));
+
+			DWORD n = GetEnvironmentVariableW(L"LOCALAPPDATA", buffer, len);
+			if (n > 0 && n < len)
+			{
+				WString result(buffer);
+				if (result[result.size() - 1] != L'\\')
+					result.append(L"\\");
+
+				bs_free(buffer);
+				return Path(UTF8::fromWide(result));
+			}
+
+			bs_free(buffer);
+		}
+
+		// Temporary directory is already user specific on Windows
+		return getTempDirectoryPath();
+	}
 }
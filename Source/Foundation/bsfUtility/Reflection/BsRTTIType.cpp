@@ -26,12 +26,10 @@ namespace bs
 
 	RTTIField* RTTITypeBase::findField(int uniqueFieldId)
 	{
-		auto foundElement = std::find_if(mFields.begin(), mFields.end(), [&uniqueFieldId](RTTIField* x) { return x->mUniqueId == uniqueFieldId; });
-
-		if(foundElement == mFields.end())
+		if(uniqueFieldId < 0 || uniqueFieldId >= (int)mFieldsById.size())
 			return nullptr;
 
-		return *foundElement;
+		return mFieldsById[uniqueFieldId];
 	}
 
 	void RTTITypeBase::addNewField(RTTIField* field)
@@ -61,6 +59,12 @@ namespace bs
 		}
 
 		mFields.push_back(field);
+
+		// Field IDs are small and densely packed, so a table indexed by the ID is used for lookups during decoding
+		if(uniqueId >= (int)mFieldsById.size())
+			mFieldsById.resize(uniqueId + 1, nullptr);
+
+		mFieldsById[uniqueId] = field;
 	}
 
 	class SerializationContextRTTI : public RTTIType<SerializationContext, IReflectable, SerializationContextRTTI>
@@ -365,7 +365,8 @@ namespace bs
 
 		/**
 		 * Tries to find a field with the specified unique ID. Doesn't throw an exception if it can't find the field
-		 * (Unlike findField(const String&)).
+		 * (Unlike findField(const String&)). Fields are looked up directly by their ID, so this is cheap enough to call
+		 * for every decoded field.
 		 *
 		 * @param	uniqueFieldId	Unique identifier for the field.
 		 *
@@ -400,6 +401,7 @@ namespace bs
 
 	private:
 		Vector<RTTIField*> mFields;
+		Vector<RTTIField*> mFieldsById;
 	};
 
 	/** Used for initializing a certain type as soon as the program is loaded. */
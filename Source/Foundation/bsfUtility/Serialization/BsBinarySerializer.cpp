@@ -51,30 +51,43 @@ buffer += size;															\
 		mReportProgress(mTotalBytesRead / (float)mTotalBytesToRead);	\
 	}																	\
 }
+/** Makes sure the next @p size bytes of the data buffer are accessible through mReadPos. */
+#define ENSURE_READABLE(size)											\
+if(!ensureReadable(data, size))											\
+{																		\
+	BS_EXCEPT(InternalErrorException, "Error decoding data.");			\
+}
+
 /** Reads from the data buffer into the provided output and advances the read position. */
 #define READ_FROM_BUFFER(output, size)									\
 {																		\
-	if(data->read(output, size) != size)								\
-	{																	\
-		BS_EXCEPT(InternalErrorException, "Error decoding data.");		\
-	}																	\
-																		\
+	ENSURE_READABLE(size)												\
+	memcpy(output, mReadPos, size);										\
+	mReadPos += size;													\
 	REPORT_READ(size)													\
 }
 
+/** Reads from the data buffer into the provided output, without advancing the read position. */
+#define PEEK_FROM_BUFFER(output, size)									\
+{																		\
+	ENSURE_READABLE(size)												\
+	memcpy(output, mReadPos, size);										\
+}
+
 /** Skips the next @p size bytes data buffer and advances the read position. */
 #define SKIP_READ(size)													\
 {																		\
-	data->skip(size);													\
+	seekRead(tellRead() + (size));										\
 	REPORT_READ(size)													\
 }
 
 /** Moves the current read buffer read position back @p size bytes. */
 #define SEEK_BACK(size)													\
-data->seek(data->tell() - size);										\
+seekRead(tellRead() - (size));											\
 mTotalBytesRead -= size;												\
 
 	constexpr UINT32 BinarySerializer::REPORT_AFTER_BYTES;
+	constexpr UINT32 BinarySerializer::READ_BUFFER_SIZE;
 
 	BinarySerializer::BinarySerializer()
 		:mAlloc(&gFrameAlloc())
@@ -179,6 +192,26 @@ mTotalBytesRead -= size;												\
 		const size_t end = start + dataLength;
 		mDecodeObjectMap.clear();
 
+		// Read directly from memory when possible, avoiding a virtual stream call and a copy for every read. Otherwise
+		// read from the stream in large chunks, as seeking and peeking at file streams is expensive.
+		mReadFromMemory = data->isMemory();
+		mReadLimit = end;
+		if(mReadFromMemory)
+		{
+			const MemoryDataStream& memoryData = static_cast<const MemoryDataStream&>(*data);
+			mReadStart = memoryData.getPtr() + start;
+			mReadEnd = memoryData.getPtr() + std::max(start, std::min(end, data->size()));
+		}
+		else
+		{
+			mReadBuffer.resize(READ_BUFFER_SIZE);
+			mReadStart = mReadBuffer.data();
+			mReadEnd = mReadStart;
+		}
+
+		mReadPos = mReadStart;
+		mReadOffset = start;
+
 		// Note: Ideally we can avoid iterating twice over the stream data
 		// Create empty instances of all ptr objects
 		SPtr<IReflectable> rootObject = nullptr;
@@ -188,12 +221,7 @@ mTotalBytesRead -= size;												\
 			objectMetaData.objectMeta = 0;
 			objectMetaData.typeId = 0;
 
-			if(data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
-			{
-				BS_EXCEPT(InternalErrorException, "Error decoding data.");
-			}
-
-			data->seek(data->tell() - sizeof(ObjectMetaData));
+			PEEK_FROM_BUFFER(&objectMetaData, sizeof(ObjectMetaData))
 
 			UINT32 objectId = 0;
 			UINT32 objectTypeId = 0;
@@ -207,7 +235,7 @@ mTotalBytesRead -= size;												\
 			}
 
 			SPtr<IReflectable> object = IReflectable::createInstanceFromTypeId(objectTypeId);
-			mDecodeObjectMap.insert(std::make_pair(objectId, ObjectToDecode(object, data->tell())));
+			mDecodeObjectMap.insert(std::make_pair(objectId, ObjectToDecode(object, tellRead())));
 
 			if(rootObject == nullptr)
 				rootObject = object;
@@ -228,7 +256,7 @@ mTotalBytesRead -= size;												\
 			if(objToDecode.isDecoded)
 				continue;
 
-			data->seek(objToDecode.offset);
+			seekRead(objToDecode.offset);
 
 			objToDecode.decodeInProgress = true;
 			decodeEntry(data, end, objToDecode.object);
@@ -237,6 +265,12 @@ mTotalBytesRead -= size;												\
 		}
 
 		mDecodeObjectMap.clear();
+
+		mReadStart = nullptr;
+		mReadPos = nullptr;
+		mReadEnd = nullptr;
+		mReadBuffer.clear();
+		mReadBuffer.shrink_to_fit();
 		data->seek(end);
 
 		assert(mTotalBytesRead == mTotalBytesToRead);
@@ -542,7 +576,7 @@ mTotalBytesRead -= size;												\
 		if(!rttiInstances.empty())
 			rttiInstance = rttiInstances[0];
 
-		while (data->tell() < dataEnd)
+		while (tellRead() < dataEnd)
 		{
 			int metaData = -1;
 			READ_FROM_BUFFER(&metaData, META_SIZE)
@@ -687,10 +721,10 @@ mTotalBytesRead -= size;												\
 									{
 										objToDecode.decodeInProgress = true;
 
-										const size_t curOffset = data->tell();
-										data->seek(objToDecode.offset);
+										const size_t curOffset = tellRead();
+										seekRead(objToDecode.offset);
 										decodeEntry(data, dataEnd, objToDecode.object);
-										data->seek(curOffset);
+										seekRead(curOffset);
 
 										objToDecode.decodeInProgress = false;
 										objToDecode.isDecoded = true;
@@ -733,24 +767,20 @@ mTotalBytesRead -= size;												\
 						UINT32 typeSize = fieldSize;
 						if (hasDynamicSize)
 						{
-							data->read(&typeSize, sizeof(UINT32));
-							data->seek(data->tell() - sizeof(UINT32));
+							PEEK_FROM_BUFFER(&typeSize, sizeof(UINT32))
 						}
 
 						if (curField != nullptr)
 						{
-							// Note: Two data copies that can potentially be avoided:
-							//  - Copy from stream into a temporary buffer (use stream directly for decoding)
-							//  - Internally the field will do a value copy of the decoded object (ideally we decode directly into the destination)
-							void* fieldValue = bs_stack_alloc(typeSize);
-							READ_FROM_BUFFER(fieldValue, typeSize)
-
-							curField->arrayElemFromBuffer(rttiInstance, output.get(), i, fieldValue);
-							bs_stack_free(fieldValue);
+							// Note: Internally the field will do a value copy of the decoded object (ideally we decode
+							// directly into the destination)
+							ENSURE_READABLE(typeSize)
+							curField->arrayElemFromBuffer(rttiInstance, output.get(), i, mReadPos);
 						}
-						else
-							SKIP_READ(typeSize);
+
+						SKIP_READ(typeSize);
 					}
+
 					break;
 				}
 				default:
@@ -803,10 +833,10 @@ mTotalBytesRead -= size;												\
 								{
 									objToDecode.decodeInProgress = true;
 
-									const size_t curOffset = data->tell();
-									data->seek(objToDecode.offset);
+									const size_t curOffset = tellRead();
+									seekRead(objToDecode.offset);
 									decodeEntry(data, dataEnd, objToDecode.object);
-									data->seek(curOffset);
+									seekRead(curOffset);
 
 									objToDecode.decodeInProgress = false;
 									objToDecode.isDecoded = true;
@@ -845,23 +875,18 @@ mTotalBytesRead -= size;												\
 					UINT32 typeSize = fieldSize;
 					if (hasDynamicSize)
 					{
-						data->read(&typeSize, sizeof(UINT32));
-						data->seek(data->tell() - sizeof(UINT32));
+						PEEK_FROM_BUFFER(&typeSize, sizeof(UINT32))
 					}
 
 					if (curField != nullptr)
 					{
-						// Note: Two data copies that can potentially be avoided:
-						//  - Copy from stream into a temporary buffer (use stream directly for decoding)
-						//  - Internally the field will do a value copy of the decoded object (ideally we decode directly into the destination)
-						void* fieldValue = bs_stack_alloc(typeSize);
-						READ_FROM_BUFFER(fieldValue, typeSize)
-
-						curField->fromBuffer(rttiInstance, output.get(), fieldValue);
-						bs_stack_free(fieldValue);
+						// Note: Internally the field will do a value copy of the decoded object (ideally we decode
+						// directly into the destination)
+						ENSURE_READABLE(typeSize)
+						curField->fromBuffer(rttiInstance, output.get(), mReadPos);
 					}
-					else
-						SKIP_READ(typeSize);
+
+					SKIP_READ(typeSize);
 
 					break;
 				}
@@ -878,12 +903,26 @@ mTotalBytesRead -= size;												\
 					{
 						if (data->isFile()) // Allow streaming
 						{
-							const size_t dataBlockOffset = data->tell();
+							// Stream position isn't kept in sync with the read position, as data is read in chunks
+							const size_t dataBlockOffset = tellRead();
+							data->seek(dataBlockOffset);
+
 							curField->setValue(rttiInstance, output.get(), data, dataBlockSize);
 							REPORT_READ(dataBlockSize);
 
 							// Seek past the data (use original offset in case the field read from the stream)
-							data->seek(dataBlockOffset + dataBlockSize);
+							seekRead(dataBlockOffset + dataBlockSize);
+						}
+						else if (data->isMemoryMapped()) // Allow the field to reference the data without copying
+						{
+							// Stream position isn't kept in sync with the read position, as data is read from memory
+							data->seek(tellRead());
+
+							const MemoryMappedDataStream& mappedData = static_cast<const MemoryMappedDataStream&>(*data);
+							SPtr<DataStream> stream = mappedData.createView(dataBlockSize);
+
+							curField->setValue(rttiInstance, output.get(), stream, dataBlockSize);
+							SKIP_READ(dataBlockSize);
 						}
 						else
 						{
@@ -1015,6 +1054,57 @@ mTotalBytesRead -= size;												\
 		return ((encodedData & 0x01) != 0);
 	}
 
+	bool BinarySerializer::ensureReadable(const SPtr<DataStream>& data, size_t size)
+	{
+		if ((size_t)(mReadEnd - mReadPos) >= size)
+			return true;
+
+		// All of the data is available from the start when reading from memory
+		if (mReadFromMemory)
+			return false;
+
+		const size_t offset = tellRead();
+		if (offset + size > mReadLimit)
+			return false;
+
+		// Keep the remaining buffered bytes and read the rest in a single chunk
+		const size_t numBuffered = (size_t)(mReadEnd - mReadPos);
+		const size_t bufferedStart = (size_t)(mReadPos - mReadStart);
+		const size_t readSize = std::min(std::max(size, (size_t)READ_BUFFER_SIZE), mReadLimit - offset);
+
+		if (mReadBuffer.size() < readSize)
+			mReadBuffer.resize(readSize);
+
+		UINT8* buffer = mReadBuffer.data();
+		memmove(buffer, buffer + bufferedStart, numBuffered);
+
+		data->seek(offset + numBuffered);
+		const size_t numRead = data->read(buffer + numBuffered, readSize - numBuffered);
+
+		mReadOffset = offset;
+		mReadStart = buffer;
+		mReadPos = buffer;
+		mReadEnd = buffer + numBuffered + numRead;
+
+		return (size_t)(mReadEnd - mReadPos) >= size;
+	}
+
+	void BinarySerializer::seekRead(size_t offset)
+	{
+		const size_t numBuffered = (size_t)(mReadEnd - mReadStart);
+		if (offset >= mReadOffset && (offset - mReadOffset) <= numBuffered)
+			mReadPos = mReadStart + (offset - mReadOffset);
+		else if (mReadFromMemory)
+			mReadPos = offset < mReadOffset ? mReadStart : mReadEnd;
+		else
+		{
+			// Outside of the buffered data, start with an empty buffer at the new offset
+			mReadOffset = offset;
+			mReadPos = mReadStart;
+			mReadEnd = mReadStart;
+		}
+	}
+
 	UINT8* BinarySerializer::dataBlockToBuffer(UINT8* data, UINT32 size, UINT8* buffer, UINT32& bufferLength, UINT32* bytesWritten,
 		std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback)
 	{
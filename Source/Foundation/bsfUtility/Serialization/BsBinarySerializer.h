@@ -59,7 +59,9 @@ namespace bs
 			bool shallow = false, SerializationContext* context = nullptr);
 
 		/**
-		 * Decodes an object from binary data.
+		 * Decodes an object from binary data. If @p data is a memory stream (see DataStream::isMemory()), such as a
+		 * memory mapped file, the data is read directly from memory. Otherwise it is read from the stream in large
+		 * chunks.
 		 *
 		 * @param[in]	data  		Binary data to decode.
 		 * @param[in]	dataLength	Length of the data in bytes.
@@ -78,6 +80,9 @@ namespace bs
 		/** Determines how many bytes need to be read before the progress report callback is triggered. */
 		static constexpr UINT32 REPORT_AFTER_BYTES = 32768;
 
+		/** Number of bytes read from the stream at once, when decoding from a stream that isn't in memory. */
+		static constexpr UINT32 READ_BUFFER_SIZE = 65536;
+
 		struct ObjectMetaData
 		{
 			UINT32 objectMeta;
@@ -155,6 +160,18 @@ namespace bs
 		/** Returns true if the provided encoded meta data represents object meta data. */
 		static bool isObjectMetaData(UINT32 encodedData);
 
+		/**
+		 * Makes sure at least @p size bytes following the current read position are available in the read buffer,
+		 * reading them from the stream if needed. Returns false if the stream doesn't have enough data.
+		 */
+		bool ensureReadable(const SPtr<DataStream>& data, size_t size);
+
+		/** Returns the stream offset of the current read position. */
+		size_t tellRead() const { return mReadOffset + (size_t)(mReadPos - mReadStart); }
+
+		/** Moves the current read position to the specified stream offset. */
+		void seekRead(size_t offset);
+
 		Map<UINT32, ObjectToDecode> mDecodeObjectMap;
 		Vector<ObjectToEncode> mObjectsToEncode;
 		UnorderedMap<void*, UINT32> mObjectAddrToId;
@@ -168,6 +185,16 @@ namespace bs
 		SerializationContext* mContext = nullptr;
 		std::function<void(float)> mReportProgress = nullptr;
 
+		// Portion of the stream data currently available for reading, starting at stream offset mReadOffset. When
+		// decoding from memory this is all of the data, otherwise it points to mReadBuffer.
+		UINT8* mReadStart = nullptr;
+		UINT8* mReadPos = nullptr;
+		UINT8* mReadEnd = nullptr;
+		size_t mReadOffset = 0;
+		size_t mReadLimit = 0;
+		bool mReadFromMemory = false;
+		Vector<UINT8> mReadBuffer;
+
 		static constexpr const int META_SIZE = 4; // Meta field size
 		static constexpr const int NUM_ELEM_FIELD_SIZE = 4; // Size of the field storing number of array elements
 		static constexpr const int COMPLEX_TYPE_FIELD_SIZE = 4; // Size of the field storing the size of a child complex type
@@ -2,9 +2,13 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Threading/BsTaskScheduler.h"
 #include "Threading/BsThreadPool.h"
+#include "Math/BsMath.h"
 
 namespace bs
 {
+	/** Index of the work stealing worker running on the current thread, offset by one. Zero if not a worker thread. */
+	static BS_THREADLOCAL UINT32 gWorkerIdx = 0;
+
 	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
 		TaskPriority priority, SPtr<Task> dependency)
 		: mName(name), mPriority(priority), mTaskWorker(std::move(taskWorker)), mTaskDependency(std::move(dependency))
@@ -72,16 +76,83 @@ namespace bs
 			mParent->waitUntilComplete(this);
 	}
 
-	TaskScheduler::TaskScheduler()
-		:mTaskQueue(&TaskScheduler::taskCompare)
+	TaskScheduler::TaskScheduler(TaskSchedulerMode mode)
+		:mMode(mode), mTaskQueue(&TaskScheduler::taskCompare)
 	{
-		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
+		if(mMode == TaskSchedulerMode::WorkStealing)
+		{
+			// Workers are persistent, so reserve one core for the core thread (same as it does by calling removeWorker()
+			// in global queue mode). Threads waiting on tasks execute tasks themselves and don't need an extra worker.
+			UINT32 numAvailable = ThreadPool::instance().getNumAvailable();
+			numAvailable = numAvailable > 1 ? numAvailable - 1 : 1;
+
+			UINT32 numWorkers = BS_THREAD_HARDWARE_CONCURRENCY;
+			numWorkers = numWorkers > 1 ? numWorkers - 1 : 1;
+			numWorkers = std::min(numWorkers, numAvailable);
+
+			mMaxActiveTasks = numWorkers;
+
+			mWorkers.resize(numWorkers);
+			for(UINT32 i = 0; i < numWorkers; i++)
+				mWorkers[i] = bs_new<WorkerData>();
+
+			for(UINT32 i = 0; i < numWorkers; i++)
+				mWorkers[i]->thread = ThreadPool::instance().run("TaskWorker", std::bind(&TaskScheduler::runWorker, this, i));
+		}
+		else
+		{
+			mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
 
-		mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler", std::bind(&TaskScheduler::runMain, this));
+			// Workers are persistent, so start them up front rather than creating threads once tasks are queued. Leave a
+			// thread in the pool for the core thread, further workers are started on demand.
+			UINT32 numAvailable = ThreadPool::instance().getNumAvailable();
+			numAvailable = numAvailable > 1 ? numAvailable - 1 : 1;
+
+			const UINT32 numWorkers = std::min(mMaxActiveTasks, numAvailable);
+
+			Lock lock(mReadyMutex);
+			for(UINT32 i = 0; i < numWorkers; i++)
+			{
+				mGlobalWorkers.push_back(ThreadPool::instance().run("TaskWorker",
+					std::bind(&TaskScheduler::runGlobalWorker, this)));
+			}
+		}
 	}
 
 	TaskScheduler::~TaskScheduler()
 	{
+		if(mMode == TaskSchedulerMode::WorkStealing)
+		{
+			// Workers will drain their queues before exiting
+			{
+				Lock lock(mSleepMutex);
+				mShutdown = true;
+			}
+
+			mSleepCond.notify_all();
+
+			for(auto& worker : mWorkers)
+				worker->thread.blockUntilComplete();
+
+			// Release any tasks that were never executed (e.g. tasks queued after shutdown started)
+			for(auto& worker : mWorkers)
+			{
+				while(Task* task = worker->queue.pop())
+					task->mQueuedSelf = nullptr;
+
+				bs_delete(worker);
+			}
+
+			while(!mSharedQueue.empty())
+			{
+				mSharedQueue.front()->mQueuedSelf = nullptr;
+				mSharedQueue.pop();
+			}
+
+			mWorkers.clear();
+			return;
+		}
+
 		// Wait until all tasks complete
 		{
 			Lock activeTaskLock(mReadyMutex);
@@ -96,37 +167,96 @@ namespace bs
 			}
 		}
 
-		// Start shutdown of the main queue worker and wait until it exits
+		// Start shutdown of the workers and wait until they exit
 		{
 			Lock lock(mReadyMutex);
 
 			mShutdown = true;
 		}
 
-		mTaskReadyCond.notify_one();
+		mTaskReadyCond.notify_all();
+
+		for(auto& worker : mGlobalWorkers)
+			worker.blockUntilComplete();
 
-		mTaskSchedulerThread.blockUntilComplete();
+		mGlobalWorkers.clear();
 	}
 
 	void TaskScheduler::addTask(SPtr<Task> task)
 	{
-		Lock lock(mReadyMutex);
-
 		assert(task->mState != 1 && "Task is already executing, it cannot be executed again until it finishes.");
 
+		if(mMode == TaskSchedulerMode::WorkStealing)
+		{
+			task->mParent = this;
+			task->mState.store(0); // Reset state in case the task is getting re-queued
+			task->mNumUnfinished.store(1);
+
+			// If the dependency isn't done, queue the task once it finishes
+			const SPtr<Task>& dependency = task->mTaskDependency;
+			if(dependency != nullptr)
+			{
+				ScopedSpinLock lock(dependency->mContinuationLock);
+
+				if(!dependency->isComplete())
+				{
+					dependency->mContinuations.push_back(std::move(task));
+					return;
+				}
+			}
+
+			queueReadyTask(std::move(task));
+			return;
+		}
+
+		Lock lock(mReadyMutex);
+
 		task->mParent = this;
 		task->mTaskId = mNextTaskId++;
 		task->mState.store(0); // Reset state in case the task is getting re-queued
+		task->mNumUnfinished.store(1);
 
-		mCheckTasks = true;
 		mTaskQueue.insert(std::move(task));
+		startGlobalWorkers();
 
-		// Wake main scheduler thread
+		// Wake an idle worker
 		mTaskReadyCond.notify_one();
+		notifyTaskQueued();
+	}
+
+	void TaskScheduler::addChildTask(const SPtr<Task>& parent, SPtr<Task> task)
+	{
+		assert(!parent->isComplete() && "Child tasks cannot be added to a task that already completed.");
+
+		parent->mNumUnfinished++;
+		task->mParentTask = parent;
+
+		addTask(std::move(task));
 	}
 
 	void TaskScheduler::addTaskGroup(const SPtr<TaskGroup>& taskGroup)
 	{
+		if(mMode == TaskSchedulerMode::WorkStealing)
+		{
+			taskGroup->mParent = this;
+
+			for(UINT32 i = 0; i < taskGroup->mCount; i++)
+			{
+				const auto worker = [i, taskGroup]
+				{
+					taskGroup->mTaskWorker(i);
+					--taskGroup->mNumRemainingTasks;
+				};
+
+				SPtr<Task> task = Task::create(taskGroup->mName, worker, taskGroup->mPriority, taskGroup->mTaskDependency);
+				task->mTaskGroup = taskGroup.get();
+
+				addTask(std::move(task));
+			}
+
+			return;
+		}
+
 		Lock lock(mReadyMutex);
 
 		for(UINT32 i = 0; i < taskGroup->mCount; i++)
@@ -138,88 +268,125 @@ namespace bs
 			};
 
 			SPtr<Task> task = Task::create(taskGroup->mName, worker, taskGroup->mPriority, taskGroup->mTaskDependency);
+			task->mTaskGroup = taskGroup.get();
 			task->mParent = this;
 			task->mTaskId = mNextTaskId++;
 			task->mState.store(0); // Reset state in case the task is getting re-queued
 
-			mCheckTasks = true;
 			mTaskQueue.insert(std::move(task));
 		}
 
 		taskGroup->mParent = this;
+		startGlobalWorkers();
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+		// Wake idle workers
+		mTaskReadyCond.notify_all();
+		notifyTaskQueued();
+	}
+
+	void TaskScheduler::notifyTaskQueued()
+	{
+		// Threads waiting on tasks might be able to execute the new task themselves
+		Lock lock(mCompleteMutex);
+
+		mQueueVersion++;
+		mTaskCompleteCond.notify_all();
+	}
+
+	void TaskScheduler::parallelFor(const String& name, UINT32 count, UINT32 granularity,
+		const std::function<void(UINT32, UINT32)>& worker, TaskPriority priority)
+	{
+		if(count == 0)
+			return;
+
+		// Aim for a few batches per worker, so workers that finish early can steal the remaining ones
+		if(granularity == 0)
+			granularity = std::max(1U, count / (std::max(1U, mMaxActiveTasks) * 4));
+
+		const UINT32 numBatches = Math::divideAndRoundUp(count, granularity);
+		if(numBatches == 1)
+		{
+			worker(0, count);
+			return;
+		}
+
+		const auto batchWorker = [count, granularity, &worker](UINT32 idx)
+		{
+			const UINT32 start = idx * granularity;
+			const UINT32 end = std::min(start + granularity, count);
+
+			worker(start, end);
+		};
+
+		SPtr<TaskGroup> taskGroup = TaskGroup::create(name, batchWorker, numBatches, priority);
+		addTaskGroup(taskGroup);
+
+		taskGroup->wait();
 	}
 
 	void TaskScheduler::addWorker()
 	{
+		if(mMode == TaskSchedulerMode::WorkStealing)
+			return;
+
 		Lock lock(mReadyMutex);
 
 		mMaxActiveTasks++;
+		startGlobalWorkers();
 
-		// A spot freed up, queue new tasks on main scheduler thread if they exist
+		// A spot freed up, let an idle worker execute queued tasks if they exist
 		mTaskReadyCond.notify_one();
 	}
 
 	void TaskScheduler::removeWorker()
 	{
+		if(mMode == TaskSchedulerMode::WorkStealing)
+			return;
+
 		Lock lock(mReadyMutex);
 
 		if(mMaxActiveTasks > 0)
 			mMaxActiveTasks--;
 	}
 
-	void TaskScheduler::runMain()
+	void TaskScheduler::runGlobalWorker()
 	{
-		while(true)
-		{
-			Lock lock(mReadyMutex);
-
-			while((!mCheckTasks || (UINT32)mActiveTasks.size() >= mMaxActiveTasks) && !mShutdown)
-				mTaskReadyCond.wait(lock);
+		const auto acceptAll = [](const Task&) { return true; };
 
-			mCheckTasks = false;
-
-			if(mShutdown)
-				break;
+		Lock lock(mReadyMutex);
+		while(!mShutdown)
+		{
+			SPtr<Task> task;
+			if((UINT32)mActiveTasks.size() < mMaxActiveTasks)
+				task = popQueuedTask(acceptAll);
 
-			for(auto iter = mTaskQueue.begin(); iter != mTaskQueue.end();)
+			if(task == nullptr)
 			{
-				if ((UINT32)mActiveTasks.size() >= mMaxActiveTasks)
-					break;	
-
-				SPtr<Task> curTask = *iter;
-
-				if(curTask->isCanceled())
-				{
-					iter = mTaskQueue.erase(iter);
-					continue;
-				}
+				mTaskReadyCond.wait(lock);
+				continue;
+			}
 
-				if(curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete())
-				{
-					++iter;
-					continue;
-				}
+			mActiveTasks.push_back(task);
+			lock.unlock();
 
-				// Spin until a thread becomes available. This happens primarily because our mActiveTask count and
-				// ThreadPool's thread idle count aren't synced, so while the task manager thinks it's free to run new
-				// tasks, the ThreadPool might still have those threads as running, meaning their allocation will fail.
-				// So we just spin here for a bit, in that rare case.
-				if(ThreadPool::instance().getNumAvailable() == 0)
-				{
-					mCheckTasks = true;
-					break;
-				}
+			runTask(std::move(task));
 
-				iter = mTaskQueue.erase(iter);
+			lock.lock();
+		}
+	}
 
-				curTask->mState.store(1);
-				mActiveTasks.push_back(curTask);
+	void TaskScheduler::startGlobalWorkers()
+	{
+		// Only start new threads if the existing workers are all busy, so no threads get created once enough workers are
+		// running
+		while((UINT32)mGlobalWorkers.size() < mMaxActiveTasks &&
+			(mGlobalWorkers.size() - mActiveTasks.size()) < mTaskQueue.size())
+		{
+			if(ThreadPool::instance().getNumAvailable() == 0)
+				break;
 
-				ThreadPool::instance().run(curTask->mName, std::bind(&TaskScheduler::runTask, this, curTask));
-			}
+			mGlobalWorkers.push_back(ThreadPool::instance().run("TaskWorker",
+				std::bind(&TaskScheduler::runGlobalWorker, this)));
 		}
 	}
 
@@ -235,6 +402,36 @@ namespace bs
 				mActiveTasks.erase(findIter);
 		}
 
+		finishTask(task.get());
+
+		// Wake idle workers, as a worker slot freed up and this task might have been someone's dependency
+		{
+			Lock lock(mReadyMutex);
+			mTaskReadyCond.notify_all();
+		}
+	}
+
+	void TaskScheduler::finishTask(Task* task)
+	{
+		if(--task->mNumUnfinished > 0)
+			return;
+
+		if(mMode == TaskSchedulerMode::WorkStealing)
+		{
+			Vector<SPtr<Task>> continuations;
+			{
+				ScopedSpinLock lock(task->mContinuationLock);
+				task->mState.store(2);
+
+				std::swap(continuations, task->mContinuations);
+			}
+
+			for(auto& entry : continuations)
+				queueReadyTask(std::move(entry));
+
+			wakeSleeping(true);
+		}
+		else
 		{
 			Lock lock(mCompleteMutex);
 			task->mState.store(2);
@@ -242,13 +439,160 @@ namespace bs
 			mTaskCompleteCond.notify_all();
 		}
 
-		// Wake the main scheduler thread in case there are other tasks waiting or this task was someone's dependency
+		SPtr<Task> parentTask = std::move(task->mParentTask);
+		if(parentTask != nullptr)
+			finishTask(parentTask.get());
+	}
+
+	void TaskScheduler::runWorker(UINT32 workerIdx)
+	{
+		gWorkerIdx = workerIdx + 1;
+
+		while(true)
 		{
-			Lock lock(mReadyMutex);
+			Task* task = findQueuedTask(workerIdx);
+			if(task != nullptr)
+			{
+				runQueuedTask(task);
+				continue;
+			}
+
+			bool shutdown;
+			mNumSleeping++;
+			{
+				Lock lock(mSleepMutex);
 
-			mCheckTasks = true;
-			mTaskReadyCond.notify_one();
+				while(mNumQueuedTasks == 0 && !mShutdown)
+					mSleepCond.wait(lock);
+
+				shutdown = mShutdown && mNumQueuedTasks == 0;
+			}
+			mNumSleeping--;
+
+			if(shutdown)
+				break;
+		}
+
+		gWorkerIdx = 0;
+	}
+
+	void TaskScheduler::queueReadyTask(SPtr<Task> task)
+	{
+		Task* taskPtr = task.get();
+		taskPtr->mQueuedSelf = std::move(task);
+
+		// Tasks queued from workers go to their local queue, others go to the shared queue
+		const UINT32 workerIdx = gWorkerIdx;
+		if(workerIdx == 0 || !mWorkers[workerIdx - 1]->queue.push(taskPtr))
+		{
+			Lock lock(mSharedQueueMutex);
+
+			mSharedQueue.push(taskPtr);
+			mNumSharedTasks++;
 		}
+
+		mNumQueuedTasks++;
+		wakeSleeping(false);
+	}
+
+	Task* TaskScheduler::findQueuedTask(UINT32 workerIdx)
+	{
+		if(mNumQueuedTasks == 0)
+			return nullptr;
+
+		const auto numWorkers = (UINT32)mWorkers.size();
+
+		Task* task = nullptr;
+		if(workerIdx < numWorkers)
+			task = mWorkers[workerIdx]->queue.pop();
+
+		if(task == nullptr && mNumSharedTasks > 0)
+		{
+			Lock lock(mSharedQueueMutex);
+
+			if(!mSharedQueue.empty())
+			{
+				task = mSharedQueue.front();
+				mSharedQueue.pop();
+				mNumSharedTasks--;
+			}
+		}
+
+		if(task == nullptr)
+		{
+			const UINT32 startIdx = workerIdx < numWorkers ? workerIdx + 1 : 0;
+			for(UINT32 i = 0; i < numWorkers && task == nullptr; i++)
+			{
+				const UINT32 victimIdx = (startIdx + i) % numWorkers;
+				if(victimIdx != workerIdx)
+					task = mWorkers[victimIdx]->queue.steal();
+			}
+		}
+
+		if(task != nullptr)
+			mNumQueuedTasks--;
+
+		return task;
+	}
+
+	void TaskScheduler::runQueuedTask(Task* task)
+	{
+		SPtr<Task> taskPtr = std::move(task->mQueuedSelf);
+
+		// Task might have been canceled while it was queued
+		UINT32 inactiveState = 0;
+		if(!taskPtr->mState.compare_exchange_strong(inactiveState, 1))
+		{
+			// Canceled tasks never execute, don't hold up their parent
+			SPtr<Task> parentTask = std::move(taskPtr->mParentTask);
+			if(parentTask != nullptr)
+				finishTask(parentTask.get());
+
+			// Wake anyone waiting on the canceled task
+			wakeSleeping(true);
+			return;
+		}
+
+		taskPtr->mTaskWorker();
+		finishTask(taskPtr.get());
+	}
+
+	void TaskScheduler::waitAndExecute(const std::function<bool()>& predicate)
+	{
+		const UINT32 workerIdx = gWorkerIdx - 1;
+
+		while(!predicate())
+		{
+			Task* task = findQueuedTask(workerIdx);
+			if(task != nullptr)
+			{
+				runQueuedTask(task);
+				continue;
+			}
+
+			// Nothing to execute, sleep until a task completes or a new one gets queued
+			mNumSleeping++;
+			{
+				Lock lock(mSleepMutex);
+
+				while(!predicate() && mNumQueuedTasks == 0)
+					mSleepCond.wait(lock);
+			}
+			mNumSleeping--;
+		}
+	}
+
+	void TaskScheduler::wakeSleeping(bool all)
+	{
+		if(mNumSleeping == 0)
+			return;
+
+		Lock lock(mSleepMutex);
+
+		if(all)
+			mSleepCond.notify_all();
+		else
+			mSleepCond.notify_one();
 	}
 
 	void TaskScheduler::waitUntilComplete(const Task* task)
@@ -259,54 +603,139 @@ namespace bs
 		if(task->mTaskDependency)
 			task->mTaskDependency->wait();
 
-		// If we haven't started executing the task yet, just execute it right here
-		SPtr<Task> queuedTask;
+		if(mMode == TaskSchedulerMode::WorkStealing)
 		{
-			Lock lock(mReadyMutex);
+			waitAndExecute([task]() { return task->isComplete() || task->isCanceled(); });
+			return;
+		}
 
-			if(!task->hasStarted())
+		// Rather than blocking, execute the task and its children on this thread if they haven't started yet
+		const auto filter = [task](const Task& entry)
+		{
+			for(const Task* cur = &entry; cur != nullptr; cur = cur->mParentTask.get())
 			{
-				auto iterFind = std::find_if(mTaskQueue.begin(), mTaskQueue.end(),
-					[task](const SPtr<Task>& x) { return x.get() == task; });
-
-				assert(iterFind != mTaskQueue.end());
+				if(cur == task)
+					return true;
+			}
 
-				queuedTask = *iterFind;
-				mTaskQueue.erase(iterFind);
+			return false;
+		};
 
-				queuedTask->mState.store(1);
-			}
-		}
+		waitAndExecuteQueued(filter, [task]() { return task->isComplete() || task->isCanceled(); });
+	}
 
-		if(queuedTask)
+	void TaskScheduler::waitUntilComplete(const TaskGroup* taskGroup)
+	{
+		if(mMode == TaskSchedulerMode::WorkStealing)
 		{
-			runTask(queuedTask);
+			waitAndExecute([taskGroup]() { return taskGroup->mNumRemainingTasks == 0; });
 			return;
 		}
 
-		// Otherwise we wait until the task completes
+		// Rather than blocking, execute tasks from the group on this thread if they haven't started yet
+		const auto filter = [taskGroup](const Task& entry) { return entry.mTaskGroup == taskGroup; };
+		waitAndExecuteQueued(filter, [taskGroup]() { return taskGroup->mNumRemainingTasks == 0; });
+	}
+
+	void TaskScheduler::waitAndExecuteQueued(const std::function<bool(const Task&)>& filter,
+		const std::function<bool()>& predicate)
+	{
+		// Only tasks the caller is waiting on, and the tasks they depend on, are executed on this thread. The caller might
+		// be the core or the sim thread, and executing unrelated tasks could block it for an arbitrary amount of time, or
+		// run a task that itself waits on the caller, which would deadlock.
+		while(true)
 		{
-			Lock lock(mCompleteMutex);
+			const UINT64 queueVersion = mQueueVersion;
+
+			SPtr<Task> queuedTask;
+			SPtr<Task> dependency;
+			{
+				Lock lock(mReadyMutex);
+
+				queuedTask = popQueuedTask(filter);
+				if(queuedTask == nullptr)
+					dependency = findBlockingDependency(filter);
+			}
 
-			while(!task->isComplete())
+			if(queuedTask)
 			{
-				addWorker();
-				mTaskCompleteCond.wait(lock);
-				removeWorker();
+				runTask(queuedTask);
+				continue;
 			}
+
+			// Awaited tasks can't execute until their dependency completes. Execute the dependency here as well, the
+			// workers might all be blocked waiting and nothing else would run it.
+			if(dependency)
+			{
+				dependency->wait();
+				continue;
+			}
+
+			// Nothing to execute, wait until something completes or a new task gets queued
+			Lock lock(mCompleteMutex);
+			if(predicate())
+				break;
+
+			if(queueVersion != mQueueVersion)
+				continue;
+
+			mTaskCompleteCond.wait(lock);
 		}
 	}
 
-	void TaskScheduler::waitUntilComplete(const TaskGroup* taskGroup)
+	SPtr<Task> TaskScheduler::popQueuedTask(const std::function<bool(const Task&)>& filter)
 	{
-		Lock lock(mCompleteMutex);
+		for(auto iter = mTaskQueue.begin(); iter != mTaskQueue.end();)
+		{
+			const SPtr<Task>& curTask = *iter;
 
-		while (taskGroup->mNumRemainingTasks > 0)
+			if(curTask->isCanceled())
+			{
+				SPtr<Task> parentTask = std::move(curTask->mParentTask);
+				iter = mTaskQueue.erase(iter);
+
+				// Canceled tasks never execute, don't hold up their parent
+				if(parentTask != nullptr)
+				{
+					finishTask(parentTask.get());
+					mTaskReadyCond.notify_all();
+				}
+
+				continue;
+			}
+
+			if(!filter(*curTask) ||
+				(curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete()))
+			{
+				++iter;
+				continue;
+			}
+
+			SPtr<Task> output = curTask;
+			mTaskQueue.erase(iter);
+
+			output->mState.store(1);
+			return output;
+		}
+
+		return nullptr;
+	}
+
+	SPtr<Task> TaskScheduler::findBlockingDependency(const std::function<bool(const Task&)>& filter) const
+	{
+		for(auto& entry : mTaskQueue)
 		{
-			addWorker();
-			mTaskCompleteCond.wait(lock);
-			removeWorker();
+			if(entry->isCanceled() || !filter(*entry))
+				continue;
+
+			// Dependencies that were never queued or were canceled cannot be executed
+			const SPtr<Task>& dependency = entry->mTaskDependency;
+			if(dependency != nullptr && dependency->mParent != nullptr && !dependency->isComplete() &&
+				!dependency->isCanceled())
+				return dependency;
 		}
+
+		return nullptr;
 	}
 
 	bool TaskScheduler::taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs)
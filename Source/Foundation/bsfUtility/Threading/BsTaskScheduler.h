@@ -5,6 +5,8 @@
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Utility/BsModule.h"
 #include "Threading/BsThreadPool.h"
+#include "Threading/BsSpinLock.h"
+#include "Threading/BsWorkStealingQueue.h"
 
 namespace bs
 {
@@ -12,6 +14,7 @@ namespace bs
 	 *  @{
 	 */
 	class TaskScheduler;
+	class TaskGroup;
 
 	/** Task priority. Tasks with higher priority will get executed sooner. */
 	enum class TaskPriority
@@ -23,6 +26,21 @@ namespace bs
 		VeryHigh = 102
 	};
 
+	/** Determines how does the TaskScheduler distribute queued tasks to worker threads. */
+	enum class TaskSchedulerMode
+	{
+		/**
+		 * All tasks are stored in a single priority sorted queue, from which they are taken by persistent worker threads.
+		 * Best suited for a smaller number of coarse grained tasks.
+		 */
+		GlobalQueue,
+		/**
+		 * Each worker thread owns a lock-free task queue, and idle workers steal tasks from the queues of other workers.
+		 * Best suited for a large number of fine grained tasks. Task priorities are ignored in this mode.
+		 */
+		WorkStealing
+	};
+
 	/**
 	 * Represents a single task that may be queued in the TaskScheduler.
 	 *
@@ -60,7 +78,11 @@ namespace bs
 		/**
 		 * Blocks the current thread until the task has completed.
 		 *
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * @note
+		 * Rather than just blocking, the calling thread will execute the task and any of its child tasks itself, if they
+		 * haven't been started by a worker yet, as well as any queued tasks they depend on. In
+		 * TaskSchedulerMode::GlobalQueue mode no other tasks are executed by the calling thread. In
+		 * TaskSchedulerMode::WorkStealing mode any queued task may be executed.
 		 */
 		void wait();
 
@@ -78,6 +100,14 @@ namespace bs
 		std::atomic<UINT32> mState{0}; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
 
 		TaskScheduler* mParent = nullptr;
+
+		SPtr<Task> mParentTask;
+		const TaskGroup* mTaskGroup = nullptr;
+		std::atomic<UINT32> mNumUnfinished{1}; /**< Number of unfinished child tasks, including the task itself. */
+
+		SpinLock mContinuationLock;
+		Vector<SPtr<Task>> mContinuations;
+		SPtr<Task> mQueuedSelf;
 	};
 
 	/**
@@ -113,7 +143,11 @@ namespace bs
 		/**
 		 * Blocks the current thread until all tasks in the group have completed.
 		 *
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * @note
+		 * Rather than just blocking, the calling thread will execute tasks from the group itself, if they haven't been
+		 * started by a worker yet, as well as any queued tasks they depend on. In TaskSchedulerMode::GlobalQueue mode no
+		 * other tasks are executed by the calling thread. In TaskSchedulerMode::WorkStealing mode any queued task may be
+		 * executed.
 		 */
 		void wait();
 
@@ -137,39 +171,82 @@ namespace bs
 	 * @note
 	 * Thread safe.
 	 * @note
-	 * This type of task scheduler uses a global queue and is best used for coarse granularity of tasks. (Number of tasks
-	 * in the order of hundreds. Higher number of tasks might require different queuing and locking mechanism, potentially
-	 * at the cost of flexibility.)
+	 * In TaskSchedulerMode::GlobalQueue mode the task scheduler uses a global queue and is best used for coarse
+	 * granularity of tasks (number of tasks in the order of hundreds). For a higher number of tasks use
+	 * TaskSchedulerMode::WorkStealing mode, at the cost of task priorities being ignored.
 	 * @note
-	 * By default the task scheduler will create as many threads as there are physical CPU cores. You may add or remove
-	 * threads using addWorker()/removeWorker() methods.
+	 * By default the task scheduler will create as many threads as there are physical CPU cores. In
+	 * TaskSchedulerMode::GlobalQueue mode you may add or remove threads using addWorker()/removeWorker() methods.
 	 */
 	class BS_UTILITY_EXPORT TaskScheduler : public Module<TaskScheduler>
 	{
 	public:
-		TaskScheduler();
+		TaskScheduler(TaskSchedulerMode mode = BS_TASK_SCHEDULER_WORK_STEALING ?
+			TaskSchedulerMode::WorkStealing : TaskSchedulerMode::GlobalQueue);
 		~TaskScheduler();
 
 		/** Queues a new task. */
 		void addTask(SPtr<Task> task);
 
+		/**
+		 * Queues a new task as a child of another task. The parent task will not be considered complete until all of its
+		 * children complete, meaning any tasks waiting on, or depending on the parent will also wait for the children.
+		 * Must be called before the parent task completes, normally from within the parent task's worker method.
+		 */
+		void addChildTask(const SPtr<Task>& parent, SPtr<Task> task);
+
 		/** Queues a new task group. */
 		void addTaskGroup(const SPtr<TaskGroup>& taskGroup);
 
-		/**	Adds a new worker thread which will be used for executing queued tasks. */
+		/**
+		 * Splits the range [0, @p count) into batches and processes them in parallel, using a task group. Blocks until all
+		 * batches have been processed.
+		 *
+		 * @param[in]	name		Name you can use to more easily identify the tasks.
+		 * @param[in]	count		Number of items to process.
+		 * @param[in]	granularity	Maximum number of items to process in a single batch. If zero the granularity will be
+		 *							determined automatically, depending on the number of workers.
+		 * @param[in]	worker		Worker method that will get called for each batch. Receives the first item in the batch,
+		 *							and one past the last item in the batch.
+		 * @param[in]	priority	(optional) Higher priority means the tasks will be executed sooner.
+		 */
+		void parallelFor(const String& name, UINT32 count, UINT32 granularity,
+			const std::function<void(UINT32, UINT32)>& worker, TaskPriority priority = TaskPriority::Normal);
+
+		/**
+		 * Adds a new worker thread which will be used for executing queued tasks.
+		 *
+		 * @note	Has no effect in TaskSchedulerMode::WorkStealing mode, where the number of workers is fixed.
+		 */
 		void addWorker();
 
-		/**	Removes a worker thread (as soon as its current task is finished). */
+		/**
+		 * Removes a worker thread (as soon as its current task is finished).
+		 *
+		 * @note	Has no effect in TaskSchedulerMode::WorkStealing mode, where the number of workers is fixed.
+		 */
 		void removeWorker();
 
 		/** Returns the maximum available worker threads (maximum number of tasks that can be executed simultaneously). */
 		UINT32 getNumWorkers() const { return mMaxActiveTasks; }
+
+		/** Returns the mode that determines how are tasks distributed to worker threads. */
+		TaskSchedulerMode getMode() const { return mMode; }
 	protected:
 		friend class Task;
 		friend class TaskGroup;
 
-		/**	Main task scheduler method that dispatches tasks to other threads. */
-		void runMain();
+		/**
+		 * Worker thread method used in TaskSchedulerMode::GlobalQueue mode. Executes tasks from the global queue until the
+		 * scheduler shuts down.
+		 */
+		void runGlobalWorker();
+
+		/**
+		 * Starts new worker threads if there are more queued tasks than idle workers, up to the maximum number of workers.
+		 * Must be called with mReadyMutex locked. Only used in TaskSchedulerMode::GlobalQueue mode.
+		 */
+		void startGlobalWorkers();
 
 		/**	Worker method that runs a single task. */
 		void runTask(SPtr<Task> task);
@@ -180,21 +257,96 @@ namespace bs
 		/**	Blocks the calling thread until all the tasks in the provided task group have completed. */
 		void waitUntilComplete(const TaskGroup* taskGroup);
 
+		/**
+		 * Blocks the calling thread until the provided predicate returns true. While waiting, executes queued tasks
+		 * accepted by the filter, and queued tasks those depend on. Only used in TaskSchedulerMode::GlobalQueue mode.
+		 */
+		void waitAndExecuteQueued(const std::function<bool(const Task&)>& filter, const std::function<bool()>& predicate);
+
+		/** Wakes up threads blocked in waitAndExecuteQueued() after a new task has been queued. */
+		void notifyTaskQueued();
+
+		/**
+		 * Removes the first task from the global queue that is ready for execution and accepted by the provided filter,
+		 * and marks it as started. Returns null if no such task exists. Must be called with mReadyMutex locked. Only used
+		 * in TaskSchedulerMode::GlobalQueue mode.
+		 */
+		SPtr<Task> popQueuedTask(const std::function<bool(const Task&)>& filter);
+
+		/**
+		 * Finds a task in the global queue accepted by the provided filter that cannot execute because its dependency
+		 * hasn't completed, and returns the dependency. Returns null if no such task exists. Must be called with
+		 * mReadyMutex locked. Only used in TaskSchedulerMode::GlobalQueue mode.
+		 */
+		SPtr<Task> findBlockingDependency(const std::function<bool(const Task&)>& filter) const;
+
+		/**
+		 * Notifies the scheduler that the task's worker method, or one of its child tasks has finished executing. Once
+		 * the task and all of its children finish the task is marked as complete.
+		 */
+		void finishTask(Task* task);
+
 		/**	Method used for sorting tasks. */
 		static bool taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs);
 
-		HThread mTaskSchedulerThread;
+		/** Data used by a single worker thread in TaskSchedulerMode::WorkStealing mode. */
+		struct WorkerData
+		{
+			WorkStealingQueue<Task> queue;
+			HThread thread;
+		};
+
+		/** Worker thread method used in TaskSchedulerMode::WorkStealing mode. */
+		void runWorker(UINT32 workerIdx);
+
+		/**
+		 * Pushes a task whose dependencies are complete to one of the worker queues. Only used in
+		 * TaskSchedulerMode::WorkStealing mode.
+		 */
+		void queueReadyTask(SPtr<Task> task);
+
+		/**
+		 * Finds a queued task ready for execution, either from the local worker queue, the shared queue or by stealing
+		 * from other workers. Returns null if no tasks are queued. Only used in TaskSchedulerMode::WorkStealing mode.
+		 */
+		Task* findQueuedTask(UINT32 workerIdx);
+
+		/** Executes a task previously retrieved from findQueuedTask(). */
+		void runQueuedTask(Task* task);
+
+		/**
+		 * Blocks the calling thread until the provided predicate returns true, executing queued tasks while it waits. Only
+		 * used in TaskSchedulerMode::WorkStealing mode.
+		 */
+		void waitAndExecute(const std::function<bool()>& predicate);
+
+		/** Wakes up threads sleeping in runWorker() or waitAndExecute(). */
+		void wakeSleeping(bool all);
+
+		TaskSchedulerMode mMode;
+
+		Vector<HThread> mGlobalWorkers;
 		Set<SPtr<Task>, std::function<bool(const SPtr<Task>&, const SPtr<Task>&)>> mTaskQueue;
 		Vector<SPtr<Task>> mActiveTasks;
 		UINT32 mMaxActiveTasks = 0;
 		UINT32 mNextTaskId = 0;
 		bool mShutdown = false;
-		bool mCheckTasks = false;
 
 		Mutex mReadyMutex;
 		Mutex mCompleteMutex;
 		Signal mTaskReadyCond;
 		Signal mTaskCompleteCond;
+		std::atomic<UINT64> mQueueVersion{0}; /**< Incremented whenever a task is queued in global queue mode. */
+
+		Vector<WorkerData*> mWorkers;
+		Queue<Task*> mSharedQueue;
+		std::atomic<UINT32> mNumSharedTasks{0};
+		std::atomic<UINT32> mNumQueuedTasks{0};
+		std::atomic<UINT32> mNumSleeping{0};
+
+		Mutex mSharedQueueMutex;
+		Mutex mSleepMutex;
+		Signal mSleepCond;
 	};
 
 	/** @} */
@@ -296,6 +296,7 @@ namespace bs
 
 		PooledThread* newThread = createThread(name);
 		mThreads.push_back(newThread);
+		mNumCreated++;
 
 		return newThread;
 	}
@@ -334,4 +335,11 @@ namespace bs
 
 		return (UINT32)mThreads.size();
 	}
+
+	UINT64 ThreadPool::getNumCreated() const
+	{
+		Lock lock(mMutex);
+
+		return mNumCreated;
+	}
 }
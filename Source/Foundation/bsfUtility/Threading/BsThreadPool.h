@@ -186,6 +186,12 @@ namespace bs
 		/**	Returns the total number of created threads in the pool	(both running and unused). */
 		UINT32 getNumAllocated() const;
 
+		/**
+		 * Returns the total number of threads the pool has created since it was started. Threads that were destroyed in
+		 * the meantime are also counted. Useful for detecting frequent thread creation.
+		 */
+		UINT64 getNumCreated() const;
+
 	protected:
 		friend class HThread;
 
@@ -211,6 +217,7 @@ namespace bs
 		UINT32 mIdleTimeout;
 		/** unused check counter */
 		UINT32 mAge = 0;
+		UINT64 mNumCreated = 0;
 
 		std::atomic_uint mUniqueId;
 		mutable Mutex mMutex;
@@ -0,0 +1,127 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Threading-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Lock-free double ended queue of pointers, based on the Chase-Lev algorithm. A single thread owns the queue and is
+	 * allowed to push and pop elements from its bottom, while any number of other threads may steal elements from its top.
+	 *
+	 * @tparam	T			Type of the elements pointed to by the stored pointers. The queue does not own the elements.
+	 * @tparam	Capacity	Maximum number of elements the queue can hold. Must be a power of two.
+	 *
+	 * @note	push() and pop() may only be called from the owner thread. steal() may be called from any thread.
+	 */
+	template<class T, UINT32 Capacity = 4096>
+	class WorkStealingQueue
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Work stealing queue capacity must be a power of two.");
+
+	public:
+		WorkStealingQueue()
+		{
+			for(auto& entry : mEntries)
+				entry.store(nullptr, std::memory_order_relaxed);
+		}
+
+		/**
+		 * Pushes a new element to the bottom of the queue. Returns false if the queue is full, in which case the element
+		 * is not added and the caller is expected to queue it elsewhere.
+		 */
+		bool push(T* element)
+		{
+			const INT64 bottom = mBottom.load(std::memory_order_relaxed);
+			const INT64 top = mTop.load(std::memory_order_acquire);
+
+			if((bottom - top) >= (INT64)Capacity)
+				return false;
+
+			mEntries[bottom & MASK].store(element, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		/** Removes the most recently pushed element from the bottom of the queue. Returns null if the queue is empty. */
+		T* pop()
+		{
+			const INT64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+			mBottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			INT64 top = mTop.load(std::memory_order_relaxed);
+			if(top > bottom)
+			{
+				// Empty
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T* element = mEntries[bottom & MASK].load(std::memory_order_relaxed);
+			if(top == bottom)
+			{
+				// Last element, race against any thieves
+				if(!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					element = nullptr;
+
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return element;
+		}
+
+		/**
+		 * Removes the oldest element from the top of the queue. Returns null if the queue is empty, or if another thread
+		 * removed the element first.
+		 */
+		T* steal()
+		{
+			INT64 top = mTop.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const INT64 bottom = mBottom.load(std::memory_order_acquire);
+
+			if(top >= bottom)
+				return nullptr;
+
+			T* element = mEntries[top & MASK].load(std::memory_order_relaxed);
+			if(!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return element;
+		}
+
+		/** Returns true if the queue holds no elements. The value might be out of date by the time the method returns. */
+		bool isEmpty() const
+		{
+			const INT64 top = mTop.load(std::memory_order_relaxed);
+			const INT64 bottom = mBottom.load(std::memory_order_relaxed);
+
+			return top >= bottom;
+		}
+
+	private:
+		static constexpr INT64 MASK = Capacity - 1;
+
+		// Top and bottom are written by different threads, keep them on separate cache lines
+		std::atomic<INT64> mTop{0};
+		UINT8 mPadding0[64 - sizeof(std::atomic<INT64>)];
+		std::atomic<INT64> mBottom{0};
+		UINT8 mPadding1[64 - sizeof(std::atomic<INT64>)];
+		std::atomic<T*> mEntries[Capacity];
+	};
+
+	/** @} */
+	/** @} */
+}
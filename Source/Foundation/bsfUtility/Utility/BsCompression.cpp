@@ -2,11 +2,29 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Utility/BsCompression.h"
 #include "FileSystem/BsDataStream.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Debug/BsDebug.h"
+#include "Math/BsMath.h"
 
 // Third party
 #include "snappy.h"
 #include "snappy-sinksource.h"
-#include "Debug/BsDebug.h"
+
+#ifndef BS_COMPRESSION_LZ4
+	#define BS_COMPRESSION_LZ4 0
+#endif
+
+#ifndef BS_COMPRESSION_ZSTD
+	#define BS_COMPRESSION_ZSTD 0
+#endif
+
+#if BS_COMPRESSION_LZ4
+#include "lz4.h"
+#endif
+
+#if BS_COMPRESSION_ZSTD
+#include "zstd.h"
+#endif
 
 namespace bs
 {
@@ -22,6 +40,8 @@ namespace bs
 
 			if (mStream->isFile())
 				mReadBuffer = (char*)bs_alloc(32768);
+			else
+				mStart = (char*)std::static_pointer_cast<MemoryDataStream>(mStream)->getCurrentPtr();
 		}
 
 		virtual ~DataStreamSource()
@@ -39,10 +59,8 @@ namespace bs
 		{
 			if (!mStream->isFile())
 			{
-				SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(mStream);
-
 				*len = Available();
-				return (char*)memStream->getPtr() + mBufferOffset;
+				return mStart + mBufferOffset;
 			}
 			else
 			{
@@ -76,6 +94,9 @@ namespace bs
 		size_t mTotal;
 		size_t mBufferOffset = 0;
 
+		// Memory streams only
+		char* mStart = nullptr;
+
 		// File streams only
 		char* mReadBuffer = nullptr;
 		size_t mReadBufferContentSize = 0;
@@ -198,4 +219,354 @@ namespace bs
 
 		return dst.GetOutput();
 	}
+
+	/** Identifier written at the start of data compressed using Compression::compressBlocks(). Reads "BSCZ". */
+	static constexpr UINT32 BLOCK_CONTAINER_MAGIC = 0x5A435342;
+
+	/** Version of the block container format. Increment when the layout changes. */
+	static constexpr UINT8 BLOCK_CONTAINER_VERSION = 1;
+
+	/** Bit set in the compressed size of a block if the block is stored uncompressed, as compression didn't help. */
+	static constexpr UINT32 BLOCK_STORED_FLAG = 0x80000000;
+
+	/** Compression level used for Zstd. The codec is meant for shipping data, so favor size over compression speed. */
+	static constexpr int ZSTD_COMPRESSION_LEVEL = 12;
+
+	/**
+	 * Header written at the start of the block container. Followed by a table of compressed block sizes (one UINT32 per
+	 * block), followed by the compressed blocks themselves.
+	 */
+	struct BlockContainerHeader
+	{
+		UINT32 magic;
+		UINT8 version;
+		UINT8 codec;
+		UINT16 reserved;
+		UINT32 blockSize;
+		UINT32 numBlocks;
+		UINT64 uncompressedSize;
+	};
+
+	/** Returns the maximum size of the output when compressing a block of @p size bytes using the specified codec. */
+	static size_t getMaxCompressedSize(CompressionCodec codec, size_t size)
+	{
+		switch(codec)
+		{
+#if BS_COMPRESSION_LZ4
+		case CompressionCodec::LZ4:
+			return (size_t)LZ4_compressBound((int)size);
+#endif
+#if BS_COMPRESSION_ZSTD
+		case CompressionCodec::Zstd:
+			return ZSTD_compressBound(size);
+#endif
+		default:
+			return snappy::MaxCompressedLength(size);
+		}
+	}
+
+	/**
+	 * Compresses a single block of data using the specified codec. Output buffer must be at least
+	 * getMaxCompressedSize() in size. Returns the number of bytes written, or 0 on failure.
+	 */
+	static size_t compressBlock(CompressionCodec codec, const UINT8* src, size_t srcSize, UINT8* dst,
+		size_t dstCapacity)
+	{
+		switch(codec)
+		{
+#if BS_COMPRESSION_LZ4
+		case CompressionCodec::LZ4:
+		{
+			const int written = LZ4_compress_default((const char*)src, (char*)dst, (int)srcSize, (int)dstCapacity);
+			return written > 0 ? (size_t)written : 0;
+		}
+#endif
+#if BS_COMPRESSION_ZSTD
+		case CompressionCodec::Zstd:
+		{
+			const size_t written = ZSTD_compress(dst, dstCapacity, src, srcSize, ZSTD_COMPRESSION_LEVEL);
+			return ZSTD_isError(written) ? 0 : written;
+		}
+#endif
+		default:
+		{
+			size_t written = 0;
+			snappy::RawCompress((const char*)src, srcSize, (char*)dst, &written);
+			return written;
+		}
+		}
+	}
+
+	/** Decompresses a single block of data, which must decompress to exactly @p dstSize bytes. */
+	static bool decompressBlock(CompressionCodec codec, const UINT8* src, size_t srcSize, UINT8* dst, size_t dstSize)
+	{
+		switch(codec)
+		{
+#if BS_COMPRESSION_LZ4
+		case CompressionCodec::LZ4:
+			return LZ4_decompress_safe((const char*)src, (char*)dst, (int)srcSize, (int)dstSize) == (int)dstSize;
+#endif
+#if BS_COMPRESSION_ZSTD
+		case CompressionCodec::Zstd:
+			return ZSTD_decompress(dst, dstSize, src, srcSize) == dstSize;
+#endif
+		case CompressionCodec::Snappy:
+		{
+			size_t uncompressedSize = 0;
+			if(!snappy::GetUncompressedLength((const char*)src, srcSize, &uncompressedSize) || uncompressedSize != dstSize)
+				return false;
+
+			return snappy::RawUncompress((const char*)src, srcSize, (char*)dst);
+		}
+		default:
+			return false;
+		}
+	}
+
+	/** Executes the provided function for each block. Blocks are distributed over the task scheduler, if running. */
+	static void forEachBlock(const char* name, UINT32 numBlocks, const std::function<void(UINT32)>& func)
+	{
+		if(numBlocks > 1 && TaskScheduler::isStarted())
+		{
+			TaskScheduler::instance().parallelFor(name, numBlocks, 1, [&func](UINT32 start, UINT32 end)
+			{
+				for(UINT32 i = start; i < end; i++)
+					func(i);
+			});
+		}
+		else
+		{
+			for(UINT32 i = 0; i < numBlocks; i++)
+				func(i);
+		}
+	}
+
+	SPtr<MemoryDataStream> Compression::compressBlocks(SPtr<DataStream>& input, CompressionCodec codec, UINT32 blockSize,
+		std::function<void(float)> reportProgress)
+	{
+		if(!isSupported(codec))
+		{
+			static std::atomic<bool> warned[3];
+			if(!warned[(UINT32)codec].exchange(true))
+			{
+				BS_LOG(Warning, Generic, "Compression codec {0} is not supported by this build, falling back to Snappy.",
+					(UINT32)codec);
+			}
+
+			codec = CompressionCodec::Snappy;
+		}
+
+		// Keep the blocks (and the size table) addressable with 32-bit values
+		blockSize = Math::clamp(blockSize, 4096U, BLOCK_STORED_FLAG - 1);
+
+		const size_t uncompressedSize = input->size() - input->tell();
+
+		// Reference memory streams directly, otherwise read all the data in memory
+		const UINT8* src;
+		UINT8* srcBuffer = nullptr;
+		if(!input->isFile())
+		{
+			src = std::static_pointer_cast<MemoryDataStream>(input)->getCurrentPtr();
+			input->skip(uncompressedSize);
+		}
+		else
+		{
+			srcBuffer = (UINT8*)bs_alloc(uncompressedSize);
+			input->read(srcBuffer, uncompressedSize);
+			src = srcBuffer;
+		}
+
+		const UINT32 numBlocks = (UINT32)((uncompressedSize + blockSize - 1) / blockSize);
+		const size_t maxCompressedSize = getMaxCompressedSize(codec, blockSize);
+
+		Vector<UINT8*> blocks(numBlocks);
+		Vector<UINT32> blockSizes(numBlocks);
+
+		Mutex progressMutex;
+		UINT32 numProcessed = 0;
+
+		forEachBlock("CompressBlocks", numBlocks, [&](UINT32 idx)
+		{
+			const size_t offset = idx * (size_t)blockSize;
+			const size_t size = std::min((size_t)blockSize, uncompressedSize - offset);
+
+			blocks[idx] = (UINT8*)bs_alloc(maxCompressedSize);
+			const size_t compressedSize = compressBlock(codec, src + offset, size, blocks[idx], maxCompressedSize);
+
+			// Store incompressible blocks as they are, so decompression becomes a copy
+			if(compressedSize == 0 || compressedSize >= size)
+			{
+				memcpy(blocks[idx], src + offset, size);
+				blockSizes[idx] = (UINT32)size | BLOCK_STORED_FLAG;
+			}
+			else
+				blockSizes[idx] = (UINT32)compressedSize;
+
+			if(reportProgress)
+			{
+				// Serialize the callback so it doesn't need to be thread safe, and so progress is reported in order
+				Lock lock(progressMutex);
+				reportProgress(++numProcessed / (float)numBlocks);
+			}
+		});
+
+		if(srcBuffer != nullptr)
+			bs_free(srcBuffer);
+
+		size_t outputSize = sizeof(BlockContainerHeader) + numBlocks * sizeof(UINT32);
+		for(auto& entry : blockSizes)
+			outputSize += entry & ~BLOCK_STORED_FLAG;
+
+		BlockContainerHeader header;
+		header.magic = BLOCK_CONTAINER_MAGIC;
+		header.version = BLOCK_CONTAINER_VERSION;
+		header.codec = (UINT8)codec;
+		header.reserved = 0;
+		header.blockSize = blockSize;
+		header.numBlocks = numBlocks;
+		header.uncompressedSize = uncompressedSize;
+
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>(outputSize);
+		output->write(&header, sizeof(header));
+
+		if(numBlocks > 0)
+			output->write(blockSizes.data(), numBlocks * sizeof(UINT32));
+
+		for(UINT32 i = 0; i < numBlocks; i++)
+		{
+			output->write(blocks[i], blockSizes[i] & ~BLOCK_STORED_FLAG);
+			bs_free(blocks[i]);
+		}
+
+		output->seek(0);
+		return output;
+	}
+
+	SPtr<MemoryDataStream> Compression::decompressBlocks(SPtr<DataStream>& input,
+		std::function<void(float)> reportProgress)
+	{
+		BlockContainerHeader header;
+		if(input->read(&header, sizeof(header)) != sizeof(header) || header.magic != BLOCK_CONTAINER_MAGIC ||
+			header.version != BLOCK_CONTAINER_VERSION || header.blockSize == 0)
+		{
+			BS_LOG(Error, Generic, "Decompression failed, invalid block container header.");
+			return nullptr;
+		}
+
+		const CompressionCodec codec = (CompressionCodec)header.codec;
+		if(!isSupported(codec))
+		{
+			BS_LOG(Error, Generic, "Decompression failed, compression codec {0} is not supported by this build.",
+				(UINT32)header.codec);
+			return nullptr;
+		}
+
+		const UINT64 expectedNumBlocks = (header.uncompressedSize + header.blockSize - 1) / header.blockSize;
+		if(header.numBlocks != expectedNumBlocks)
+		{
+			BS_LOG(Error, Generic, "Decompression failed, corrupt data.");
+			return nullptr;
+		}
+
+		const UINT32 numBlocks = header.numBlocks;
+		Vector<UINT32> blockSizes(numBlocks);
+		Vector<size_t> blockOffsets(numBlocks);
+
+		size_t compressedSize = 0;
+		if(numBlocks > 0)
+		{
+			const size_t tableSize = numBlocks * sizeof(UINT32);
+			if(input->read(blockSizes.data(), tableSize) != tableSize)
+			{
+				BS_LOG(Error, Generic, "Decompression failed, corrupt data.");
+				return nullptr;
+			}
+
+			for(UINT32 i = 0; i < numBlocks; i++)
+			{
+				blockOffsets[i] = compressedSize;
+				compressedSize += blockSizes[i] & ~BLOCK_STORED_FLAG;
+			}
+		}
+
+		if(compressedSize > input->size() - input->tell())
+		{
+			BS_LOG(Error, Generic, "Decompression failed, corrupt data.");
+			return nullptr;
+		}
+
+		// Reference memory streams (including memory mapped files) directly, otherwise read the blocks in memory
+		const UINT8* src;
+		UINT8* srcBuffer = nullptr;
+		if(!input->isFile())
+		{
+			src = std::static_pointer_cast<MemoryDataStream>(input)->getCurrentPtr();
+			input->skip(compressedSize);
+		}
+		else
+		{
+			srcBuffer = (UINT8*)bs_alloc(compressedSize);
+			input->read(srcBuffer, compressedSize);
+			src = srcBuffer;
+		}
+
+		const size_t uncompressedSize = (size_t)header.uncompressedSize;
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>(uncompressedSize);
+		UINT8* dst = output->getPtr();
+
+		std::atomic<bool> failed{false};
+
+		Mutex progressMutex;
+		UINT32 numProcessed = 0;
+
+		forEachBlock("DecompressBlocks", numBlocks, [&](UINT32 idx)
+		{
+			const size_t offset = idx * (size_t)header.blockSize;
+			const size_t size = std::min((size_t)header.blockSize, uncompressedSize - offset);
+			const UINT32 blockSize = blockSizes[idx] & ~BLOCK_STORED_FLAG;
+
+			if((blockSizes[idx] & BLOCK_STORED_FLAG) != 0)
+			{
+				if(blockSize == size)
+					memcpy(dst + offset, src + blockOffsets[idx], size);
+				else
+					failed = true;
+			}
+			else if(!decompressBlock(codec, src + blockOffsets[idx], blockSize, dst + offset, size))
+				failed = true;
+
+			if(reportProgress)
+			{
+				// Serialize the callback so it doesn't need to be thread safe, and so progress is reported in order
+				Lock lock(progressMutex);
+				reportProgress(++numProcessed / (float)numBlocks);
+			}
+		});
+
+		if(srcBuffer != nullptr)
+			bs_free(srcBuffer);
+
+		if(failed)
+		{
+			BS_LOG(Error, Generic, "Decompression failed, corrupt data.");
+			return nullptr;
+		}
+
+		return output;
+	}
+
+	bool Compression::isSupported(CompressionCodec codec)
+	{
+		switch(codec)
+		{
+		case CompressionCodec::Snappy:
+			return true;
+		case CompressionCodec::LZ4:
+			return BS_COMPRESSION_LZ4 != 0;
+		case CompressionCodec::Zstd:
+			return BS_COMPRESSION_ZSTD != 0;
+		default:
+			return false;
+		}
+	}
 }
@@ -10,10 +10,30 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Algorithms that can be used for compressing the individual blocks in the block compressed container. */
+	enum class BS_SCRIPT_EXPORT(m:Resources) CompressionCodec
+	{
+		/** Snappy compression. Always available. */
+		Snappy,
+		/**
+		 * LZ4 compression. Very fast decompression with a moderate compression ratio, best suited for data that needs
+		 * to load quickly.
+		 */
+		LZ4,
+		/**
+		 * Zstandard compression. Higher compression ratio than LZ4 at the cost of slower compression and decompression,
+		 * best suited for reducing the shipping size.
+		 */
+		Zstd
+	};
+
 	/** Performs generic compression and decompression on raw data. */
 	class BS_UTILITY_EXPORT Compression
 	{
 	public:
+		/** Default size of a single independently compressed block used by compressBlocks(), in bytes. */
+		static constexpr UINT32 DEFAULT_BLOCK_SIZE = 256 * 1024;
+
 		/**
 		 * Compresses the data from the provided data stream and outputs the new stream with compressed data. Accepts
 		 * an optional callback to be triggered during the process to report progress in range [0, 1].
@@ -27,6 +47,39 @@ namespace bs
 		 */
 		static SPtr<MemoryDataStream> decompress(SPtr<DataStream>& input,
 			std::function<void(float)> reportProgress = nullptr);
+
+		/**
+		 * Compresses the data from the provided data stream (from its current position until its end) and outputs a
+		 * new stream containing the data split into independently compressed blocks. Blocks are compressed in parallel
+		 * if the task scheduler is running.
+		 *
+		 * @param[in]	input			Stream containing the data to compress.
+		 * @param[in]	codec			Algorithm to compress the blocks with. If support for the codec wasn't compiled
+		 *								in, Snappy is used instead and a warning is logged.
+		 * @param[in]	blockSize		Size of a single block of uncompressed data, in bytes. Smaller blocks allow for
+		 *								more parallelism but yield a worse compression ratio.
+		 * @param[in]	reportProgress	Optional callback triggered during the process to report progress in range
+		 *								[0, 1]. Might be called from worker threads, but calls are never concurrent and
+		 *								reported values never decrease.
+		 */
+		static SPtr<MemoryDataStream> compressBlocks(SPtr<DataStream>& input, CompressionCodec codec,
+			UINT32 blockSize = DEFAULT_BLOCK_SIZE, std::function<void(float)> reportProgress = nullptr);
+
+		/**
+		 * Decompresses data previously compressed with compressBlocks(), starting at the current position of the provided
+		 * stream. The stream is advanced past the compressed data. Blocks are decompressed in parallel if the task
+		 * scheduler is running. Accepts an optional callback to be triggered during the process to report progress in
+		 * range [0, 1]. The callback might be called from worker threads, but calls are never concurrent and reported
+		 * values never decrease.
+		 *
+		 * @return	Stream containing the decompressed data, or null if the data is corrupt or was compressed using a codec
+		 *			not supported by this build.
+		 */
+		static SPtr<MemoryDataStream> decompressBlocks(SPtr<DataStream>& input,
+			std::function<void(float)> reportProgress = nullptr);
+
+		/** Checks if support for the specified codec was compiled in. */
+		static bool isSupported(CompressionCodec codec);
 	};
 
 	/** @} */
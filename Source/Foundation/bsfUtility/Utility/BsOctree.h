@@ -758,7 +758,7 @@ namespace bs
 
 			ElementGroup* elemGroup;
 			ElementBoundGroup* boundGroup;
-			elementIdx = node->mapToGroup(elementIdx, &elemGroup, &boundGroup);
+			UINT32 groupElementIdx = node->mapToGroup(elementIdx, &elemGroup, &boundGroup);
 
 			ElementGroup* lastElemGroup;
 			ElementBoundGroup* lastBoundGroup;
@@ -766,10 +766,11 @@ namespace bs
 
 			if(elements.count > 1)
 			{
-				std::swap(elemGroup->v[elementIdx], lastElemGroup->v[lastElementIdx]);
-				std::swap(boundGroup->v[elementIdx], lastBoundGroup->v[lastElementIdx]);
+				std::swap(elemGroup->v[groupElementIdx], lastElemGroup->v[lastElementIdx]);
+				std::swap(boundGroup->v[groupElementIdx], lastBoundGroup->v[lastElementIdx]);
 
-				Options::setElementId(elemGroup->v[elementIdx], OctreeElementId(node, elementIdx), mContext);
+				// Note: Element ID must be the index within the node, not the index within the group
+				Options::setElementId(elemGroup->v[groupElementIdx], OctreeElementId(node, elementIdx), mContext);
 			}
 
 			if(lastElementIdx == 0) // Last element in that group, remove it completely
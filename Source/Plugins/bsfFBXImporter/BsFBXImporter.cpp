@@ -167,6 +167,16 @@ namespace bs
 				SPtr<AnimationClip> clip = AnimationClip::_createPtr(entry.curves, entry.isAdditive, entry.sampleRate,
 					entry.rootMotion);
 				clip->setName(entry.name);
+
+				if(meshImportOptions->compressAnimation)
+				{
+					AnimationCompressionSettings compressionSettings;
+					compressionSettings.positionError = meshImportOptions->animationPositionError;
+					compressionSettings.rotationError = meshImportOptions->animationRotationError;
+					compressionSettings.scaleError = meshImportOptions->animationScaleError;
+
+					clip->_compress(compressionSettings);
+				}
 				
 				for(auto& eventsEntry : events)
 				{
@@ -7,6 +7,7 @@
 #include "Managers/BsTextureManager.h"
 #include "Image/BsTexture.h"
 #include "Importer/BsTextureImportOptions.h"
+#include "Private/Image/BsTextureImportUtility.h"
 #include "FileSystem/BsFileSystem.h"
 #include "BsCoreApplication.h"
 #include "CoreThread/BsCoreThread.h"
@@ -154,18 +155,7 @@ namespace bs
 			faceData.push_back(imgData);
 		}
 
-		UINT32 numMips = 0;
-		if (textureImportOptions->generateMips &&
-			Bitwise::isPow2(faceData[0]->getWidth()) && Bitwise::isPow2(faceData[0]->getHeight()))
-		{
-			UINT32 maxPossibleMip = PixelUtil::getMaxMipmaps(faceData[0]->getWidth(), faceData[0]->getHeight(),
-				faceData[0]->getDepth(), faceData[0]->getFormat());
-
-			if (textureImportOptions->maxMip == 0)
-				numMips = maxPossibleMip;
-			else
-				numMips = std::min(maxPossibleMip, textureImportOptions->maxMip);
-		}
+		UINT32 numMips = TextureImportUtility::getNumMips(*faceData[0], *textureImportOptions);
 
 		int usage = TU_DEFAULT;
 		if (textureImportOptions->cpuCached)
@@ -184,27 +174,14 @@ namespace bs
 
 		SPtr<Texture> newTexture = Texture::_createPtr(texDesc);
 
-		UINT32 numFaces = (UINT32)faceData.size();
+		Vector<Vector<SPtr<PixelData>>> surfaces = TextureImportUtility::generateSurfaces(faceData,
+			newTexture->getProperties().getFormat(), numMips, *textureImportOptions);
+
+		UINT32 numFaces = (UINT32)surfaces.size();
 		for (UINT32 i = 0; i < numFaces; i++)
 		{
-			Vector<SPtr<PixelData>> mipLevels;
-			if (numMips > 0)
-			{
-				MipMapGenOptions mipOptions;
-				mipOptions.isSRGB = sRGB;
-
-				mipLevels = PixelUtil::genMipmaps(*faceData[i], mipOptions);
-			}
-			else
-				mipLevels.push_back(faceData[i]);
-
-			for (UINT32 mip = 0; mip < (UINT32)mipLevels.size(); ++mip)
-			{
-				SPtr<PixelData> dst = newTexture->getProperties().allocBuffer(0, mip);
-
-				PixelUtil::bulkPixelConversion(*mipLevels[mip], *dst);
-				newTexture->writeData(dst, i, mip);
-			}
+			for (UINT32 mip = 0; mip < (UINT32)surfaces[i].size(); ++mip)
+				newTexture->writeData(surfaces[i][mip], i, mip);
 		}
 
 		const String fileName = filePath.getFilename(false);
@@ -11,15 +11,22 @@ namespace bs { namespace ct
 		assert((deviceMask == GDF_DEFAULT || deviceMask == GDF_PRIMARY) && "Multiple GPUs not supported natively on OpenGL.");
 	}
 
+	GLGpuParamBlockBuffer::GLGpuParamBlockBuffer(const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size)
+		:GpuParamBlockBuffer(parent, offset, size)
+	{ }
+
 	GLGpuParamBlockBuffer::~GLGpuParamBlockBuffer()
 	{
-		if(mBuffer)
+		// Ranges share the hardware buffer of their parent
+		if(mBuffer && !mParentBuffer)
 			bs_pool_delete(static_cast<GLHardwareBuffer*>(mBuffer));
 	}
 
 	void GLGpuParamBlockBuffer::initialize()
 	{
-		mBuffer = bs_pool_new<GLHardwareBuffer>(GL_UNIFORM_BUFFER, mSize, mUsage);
+		if(!mParentBuffer)
+			mBuffer = bs_pool_new<GLHardwareBuffer>(GL_UNIFORM_BUFFER, mSize, mUsage);
+
 		GpuParamBlockBuffer::initialize();
 	}
 }}
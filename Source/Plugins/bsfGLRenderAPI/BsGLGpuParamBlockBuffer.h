@@ -17,6 +17,9 @@ namespace bs { namespace ct
 	{
 	public:
 		GLGpuParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask);
+
+		/** @copydoc GpuParamBlockBuffer::GpuParamBlockBuffer(const SPtr<GpuParamBlockBuffer>&, UINT32, UINT32) */
+		GLGpuParamBlockBuffer(const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size);
 		~GLGpuParamBlockBuffer();
 
 		/**	Returns internal OpenGL uniform buffer handle. */
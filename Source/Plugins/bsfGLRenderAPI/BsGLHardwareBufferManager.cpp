@@ -41,6 +41,18 @@ namespace bs { namespace ct
 		return paramBlockBufferPtr;
 	}
 
+	SPtr<GpuParamBlockBuffer> GLHardwareBufferManager::createGpuParamBlockBufferRangeInternal(
+		const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size)
+	{
+		GLGpuParamBlockBuffer* paramBlockBuffer =
+			new (bs_alloc<GLGpuParamBlockBuffer>()) GLGpuParamBlockBuffer(parent, offset, size);
+
+		SPtr<GpuParamBlockBuffer> paramBlockBufferPtr = bs_shared_ptr<GLGpuParamBlockBuffer>(paramBlockBuffer);
+		paramBlockBufferPtr->_setThisPtr(paramBlockBufferPtr);
+
+		return paramBlockBufferPtr;
+	}
+
 	SPtr<GpuBuffer> GLHardwareBufferManager::createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
 		GpuDeviceFlags deviceMask)
 	{
@@ -34,6 +34,10 @@ namespace bs { namespace ct
 		SPtr<GpuParamBlockBuffer> createGpuParamBlockBufferInternal(UINT32 size,
 			GpuBufferUsage usage = GBU_DYNAMIC, GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
 
+		/** @copydoc HardwareBufferManager::createGpuParamBlockBufferRangeInternal */
+		SPtr<GpuParamBlockBuffer> createGpuParamBlockBufferRangeInternal(const SPtr<GpuParamBlockBuffer>& parent,
+			UINT32 offset, UINT32 size) override;
+
 		/** @copydoc HardwareBufferManager::createGpuBufferInternal(const GPU_BUFFER_DESC&, GpuDeviceFlags) */
 		SPtr<GpuBuffer> createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
 			GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
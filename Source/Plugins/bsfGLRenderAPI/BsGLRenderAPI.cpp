@@ -886,7 +886,14 @@ namespace bs { namespace ct
 							glUniformBlockBinding(glProgram, binding - 1, unit);
 							BS_CHECK_GL_ERROR();
 
-							glBindBufferBase(GL_UNIFORM_BUFFER, unit, glParamBlockBuffer->getGLBufferId());
+							if (glParamBlockBuffer->getParentBuffer() != nullptr)
+							{
+								glBindBufferRange(GL_UNIFORM_BUFFER, unit, glParamBlockBuffer->getGLBufferId(),
+									glParamBlockBuffer->getParentOffset(), glParamBlockBuffer->getSize());
+							}
+							else
+								glBindBufferBase(GL_UNIFORM_BUFFER, unit, glParamBlockBuffer->getGLBufferId());
+
 							BS_CHECK_GL_ERROR();
 						}
 					}
@@ -2514,6 +2521,8 @@ namespace bs { namespace ct
 		caps.setCapability(RSC_RENDER_TARGET_LAYERS);
 #endif
 
+		caps.setCapability(RSC_PARAM_BLOCK_BUFFER_RANGES);
+
 		caps.conventions.uvYAxis = Conventions::Axis::Up;
 		caps.conventions.matrixOrder = Conventions::MatrixOrder::ColumnMajor;
 		caps.minDepth = -1.0f;
@@ -2674,6 +2683,12 @@ namespace bs { namespace ct
 		BS_CHECK_GL_ERROR();
 
 		caps.numCombinedParamBlockBuffers = static_cast<UINT16>(combinedUniformBlockUnits);
+
+		GLint uniformBufferOffsetAlignment;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformBufferOffsetAlignment);
+		BS_CHECK_GL_ERROR();
+
+		caps.paramBlockBufferOffsetAlignment = static_cast<UINT32>(uniformBufferOffsetAlignment);
 		caps.numMultiRenderTargets = 8;
 	}
 
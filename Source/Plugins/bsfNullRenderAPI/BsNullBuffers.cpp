@@ -31,6 +31,16 @@ namespace bs { namespace ct
 		return paramBlockBufferPtr;
 	}
 
+	SPtr<GpuParamBlockBuffer> NullHardwareBufferManager::createGpuParamBlockBufferRangeInternal(
+		const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size)
+	{
+		SPtr<GpuParamBlockBuffer> paramBlockBufferPtr =
+			bs_shared_ptr_new<NullGpuParamBlockBuffer>(parent, offset, size);
+		paramBlockBufferPtr->_setThisPtr(paramBlockBufferPtr);
+
+		return paramBlockBufferPtr;
+	}
+
 	SPtr<GpuBuffer> NullHardwareBufferManager::createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
 		GpuDeviceFlags deviceMask)
 	{
@@ -78,15 +88,52 @@ namespace bs { namespace ct
 		:GpuParamBlockBuffer(size, usage, deviceMask)
 	{ }
 
+	NullGpuParamBlockBuffer::NullGpuParamBlockBuffer(const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset,
+		UINT32 size)
+		:GpuParamBlockBuffer(parent, offset, size)
+	{ }
+
+	NullGpuParamBlockBuffer::~NullGpuParamBlockBuffer()
+	{
+		// Ranges share the hardware buffer of their parent
+		if (mBuffer != nullptr && mParentBuffer == nullptr)
+			bs_pool_delete(static_cast<NullHardwareBuffer*>(mBuffer));
+	}
+
 	void NullGpuParamBlockBuffer::initialize()
 	{
-		mBuffer = bs_pool_new<NullHardwareBuffer>(mUsage, 1, mSize);
+		if (mParentBuffer == nullptr)
+			mBuffer = bs_pool_new<NullHardwareBuffer>(mUsage, 1, mSize, true);
+
 		GpuParamBlockBuffer::initialize();
 	}
 
-	NullHardwareBuffer::NullHardwareBuffer(GpuBufferUsage usage, UINT32 elementCount, UINT32 elementSize)
+	NullHardwareBuffer::NullHardwareBuffer(GpuBufferUsage usage, UINT32 elementCount, UINT32 elementSize,
+		bool storeData)
 		: HardwareBuffer(elementCount * elementSize, usage, GDF_DEFAULT)
-	{ }
+	{
+		if (storeData)
+			mData = (UINT8*)bs_alloc(mSize);
+	}
+
+	NullHardwareBuffer::~NullHardwareBuffer()
+	{
+		if (mData != nullptr)
+			bs_free(mData);
+	}
+
+	void NullHardwareBuffer::readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+		if (mData != nullptr)
+			memcpy(dest, mData + offset, length);
+	}
+
+	void NullHardwareBuffer::writeData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags,
+		UINT32 queueIdx)
+	{
+		if (mData != nullptr)
+			memcpy(mData + offset, source, length);
+	}
 
 	void* NullHardwareBuffer::map(UINT32 offset, UINT32 length, GpuLockOptions options, UINT32 deviceIdx, UINT32 queueIdx)
 	{
@@ -30,6 +30,10 @@ namespace bs { namespace ct
 		SPtr<GpuParamBlockBuffer> createGpuParamBlockBufferInternal(UINT32 size,
 			GpuBufferUsage usage = GBU_DYNAMIC, GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
 
+		/** @copydoc HardwareBufferManager::createGpuParamBlockBufferRangeInternal */
+		SPtr<GpuParamBlockBuffer> createGpuParamBlockBufferRangeInternal(const SPtr<GpuParamBlockBuffer>& parent,
+			UINT32 offset, UINT32 size) override;
+
 		/** @copydoc HardwareBufferManager::createGpuBufferInternal(const GPU_BUFFER_DESC&, GpuDeviceFlags) */
 		SPtr<GpuBuffer> createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
 			GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
@@ -43,14 +47,19 @@ namespace bs { namespace ct
 	class NullHardwareBuffer final : public HardwareBuffer
 	{
 	public:
-		NullHardwareBuffer(GpuBufferUsage usage, UINT32 elementCount, UINT32 elementSize);
+		/**
+		 * Creates a new buffer. If @p storeData is true, the buffer keeps a copy of the data written to it, so writes
+		 * cost the same CPU time as a copy to GPU memory would. Otherwise writes are ignored.
+		 */
+		NullHardwareBuffer(GpuBufferUsage usage, UINT32 elementCount, UINT32 elementSize, bool storeData = false);
+		~NullHardwareBuffer();
 
 		/** @copydoc HardwareBuffer::readData */
-		void readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx = 0, UINT32 queueIdx = 0) override { }
+		void readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx = 0, UINT32 queueIdx = 0) override;
 
 		/** @copydoc HardwareBuffer::writeData */
 		void writeData(UINT32 offset, UINT32 length, const void* source,
-			BufferWriteType writeFlags = BWT_NORMAL, UINT32 queueIdx = 0) override { }
+			BufferWriteType writeFlags = BWT_NORMAL, UINT32 queueIdx = 0) override;
 
 		/** @copydoc HardwareBuffer::copyData */
 		void copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length,
@@ -64,6 +73,7 @@ namespace bs { namespace ct
 		void unmap() override;
 
 		void* mStagingBuffer = nullptr;
+		UINT8* mData = nullptr;
 	};
 
 	/**	Null implementation of a generic GPU buffer. */
@@ -86,6 +96,10 @@ namespace bs { namespace ct
 	public:
 		NullGpuParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask);
 
+		/** @copydoc GpuParamBlockBuffer::GpuParamBlockBuffer(const SPtr<GpuParamBlockBuffer>&, UINT32, UINT32) */
+		NullGpuParamBlockBuffer(const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size);
+		~NullGpuParamBlockBuffer();
+
 	protected:
 		/** @copydoc GpuParamBlockBuffer::initialize */
 		void initialize() override;
@@ -5,6 +5,9 @@
 #include "Math/BsMatrix4.h"
 #include "RenderAPI/BsGpuParamDesc.h"
 #include "RenderAPI/BsGpuParams.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+#include "RenderAPI/BsGpuPipelineParamInfo.h"
+#include "Profiling/BsRenderStats.h"
 #include "Managers/BsGpuProgramManager.h"
 #include "BsNullCommandBuffer.h"
 #include "BsNullTexture.h"
@@ -57,6 +60,7 @@ namespace bs { namespace ct
 		mCurrentCapabilities->deviceName = "Null";
 		mCurrentCapabilities->renderAPIName = getName();
 		mCurrentCapabilities->deviceVendor = GPU_UNKNOWN;
+		mCurrentCapabilities->setCapability(RSC_PARAM_BLOCK_BUFFER_RANGES);
 				
 		RenderAPI::initialize();
 	}
@@ -93,6 +97,36 @@ namespace bs { namespace ct
 		RenderAPI::destroyCore();
 	}
 
+	void NullRenderAPI::setGpuParams(const SPtr<GpuParams>& gpuParams, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		const SPtr<GpuPipelineParamInfoBase>& paramInfo = gpuParams->getParamInfo();
+		const UINT32 numParamBlocks = paramInfo->getNumElements(GpuPipelineParamInfo::ParamType::ParamBlock);
+
+		for (UINT32 i = 0; i < numParamBlocks; i++)
+		{
+			UINT32 set, slot;
+			paramInfo->getBinding(GpuPipelineParamInfo::ParamType::ParamBlock, i, set, slot);
+
+			SPtr<GpuParamBlockBuffer> buffer = gpuParams->getParamBlockBuffer(set, slot);
+			if (buffer != nullptr)
+				buffer->flushToGPU();
+		}
+
+		BS_INC_RENDER_STAT(NumGpuParamBinds);
+	}
+
+	void NullRenderAPI::draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		BS_INC_RENDER_STAT(NumDrawCalls);
+	}
+
+	void NullRenderAPI::drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
+		UINT32 instanceCount, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		BS_INC_RENDER_STAT(NumDrawCalls);
+	}
+
 	void NullRenderAPI::convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest)
 	{
 		dest = matrix;
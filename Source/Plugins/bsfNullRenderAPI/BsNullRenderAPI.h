@@ -28,9 +28,14 @@ namespace bs { namespace ct
 		void setComputePipeline(const SPtr<ComputePipelineState>& pipelineState,
 			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
 
-		/** @copydoc RenderAPI::setGpuParams */
+		/**
+		 * @copydoc RenderAPI::setGpuParams
+		 *
+		 * Flushes the bound parameter block buffers the same way other render backends do, so the CPU cost of uploading
+		 * parameters can be measured without a GPU.
+		 */
 		void setGpuParams(const SPtr<GpuParams>& gpuParams,
-			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
 
 		/** @copydoc RenderAPI::clearRenderTarget */
 		void clearRenderTarget(UINT32 buffers, const Color& color = Color::Black, float depth = 1.0f, UINT16 stencil = 0,
@@ -72,11 +77,11 @@ namespace bs { namespace ct
 
 		/** @copydoc RenderAPI::draw */
 		void draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount = 0,
-			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
 
 		/** @copydoc RenderAPI::drawIndexed */
 		void drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
-			UINT32 instanceCount = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+			UINT32 instanceCount = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
 
 		/** @copydoc RenderAPI::dispatchCompute */
 		void dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY = 1, UINT32 numGroupsZ = 1,
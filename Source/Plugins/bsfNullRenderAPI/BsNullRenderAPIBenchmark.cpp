@@ -0,0 +1,119 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullBuffers.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Math/BsMatrix4.h"
+#include "Profiling/BsRenderStats.h"
+#include "RenderAPI/BsGpuParamBlockBufferPool.h"
+#include "RenderAPI/BsRenderAPICapabilities.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Threading/BsThreadPool.h"
+#include "Utility/BsTimer.h"
+
+#include <iostream>
+
+namespace bs
+{
+	/**
+	 * Measures the CPU cost of submitting per-object parameter blocks on the null render API. Every frame the parameters
+	 * of all objects are written, and then each object's block is flushed the same way NullRenderAPI::setGpuParams()
+	 * flushes the blocks bound for a draw. Compares blocks allocated as separate buffers against blocks allocated as
+	 * ranges from a GpuParamBlockBufferPool. Null buffers copy the data written to them, so the flush cost includes the
+	 * copy a real backend would make.
+	 */
+	void benchmarkParamBlockSubmit()
+	{
+		static constexpr UINT32 NUM_FRAMES = 50;
+
+		// Size of the per-object block used by RenderBeast: four world matrices, previous frame world matrix and extras
+		static constexpr UINT32 BLOCK_SIZE = 5 * sizeof(Matrix4) + 16;
+
+		// Same capabilities as reported by NullRenderAPI
+		RenderAPICapabilities caps;
+		caps.setCapability(RSC_PARAM_BLOCK_BUFFER_RANGES);
+
+		UINT8 data[BLOCK_SIZE];
+		memset(data, 0, sizeof(data));
+
+		std::cout << "Parameter block submit (" << NUM_FRAMES << " frames)" << std::endl;
+		for(UINT32 numObjects : { 1000, 10000, 100000 })
+		{
+			const auto measure = [numObjects, &caps, &data](bool useRanges, UINT64& writeTime, UINT64& submitTime,
+				UINT32& numUploads)
+			{
+				ct::GpuParamBlockBufferPool pool(useRanges ? caps : RenderAPICapabilities());
+
+				Vector<SPtr<ct::GpuParamBlockBuffer>> buffers(numObjects);
+				for(UINT32 i = 0; i < numObjects; i++)
+					buffers[i] = pool.alloc(BLOCK_SIZE);
+
+				const UINT64 numWritesBefore = RenderStats::instance().getData().numResourceWrites;
+
+				writeTime = 0;
+				submitTime = 0;
+				for(UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+				{
+					Timer timer;
+					for(UINT32 i = 0; i < numObjects; i++)
+					{
+						memcpy(data, &frame, sizeof(frame));
+						buffers[i]->write(0, data, BLOCK_SIZE);
+					}
+					writeTime += timer.getMicroseconds();
+
+					timer.reset();
+					for(UINT32 i = 0; i < numObjects; i++)
+						buffers[i]->flushToGPU();
+					submitTime += timer.getMicroseconds();
+				}
+
+				const UINT64 numWrites = RenderStats::instance().getData().numResourceWrites - numWritesBefore;
+				numUploads = (UINT32)(numWrites / NUM_FRAMES);
+
+				for(auto& buffer : buffers)
+					pool.free(buffer);
+			};
+
+			UINT64 separateWriteTime, separateSubmitTime;
+			UINT32 separateUploads;
+			measure(false, separateWriteTime, separateSubmitTime, separateUploads);
+
+			UINT64 rangeWriteTime, rangeSubmitTime;
+			UINT32 rangeUploads;
+			measure(true, rangeWriteTime, rangeSubmitTime, rangeUploads);
+
+			const auto toMsPerFrame = [](UINT64 time) { return time / (1000.0 * NUM_FRAMES); };
+
+			std::cout << "  " << numObjects << " objects:" << std::endl;
+			std::cout << "    Separate buffers:  write " << toMsPerFrame(separateWriteTime) << " ms, submit " <<
+				toMsPerFrame(separateSubmitTime) << " ms, " << separateUploads << " uploads/frame" << std::endl;
+			std::cout << "    Pooled ranges:     write " << toMsPerFrame(rangeWriteTime) << " ms, submit " <<
+				toMsPerFrame(rangeSubmitTime) << " ms, " << rangeUploads << " uploads/frame" << std::endl;
+		}
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	MemStack::beginThread();
+	ThreadPool::startUp<TThreadPool<ThreadDefaultPolicy>>(2);
+	TaskScheduler::startUp();
+	CoreThread::startUp();
+	RenderStats::startUp();
+	ct::HardwareBufferManager::startUp<ct::NullHardwareBufferManager>();
+
+	// Buffers are core objects, so they're created, used and destroyed on the core thread
+	gCoreThread().queueCommand(&benchmarkParamBlockSubmit);
+	gCoreThread().submit(true);
+
+	ct::HardwareBufferManager::shutDown();
+	RenderStats::shutDown();
+	CoreThread::shutDown();
+	TaskScheduler::shutDown();
+	ThreadPool::shutDown();
+	MemStack::endThread();
+
+	return 0;
+}
@@ -0,0 +1,497 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsCullBuffer.h"
+#include "Math/BsSIMD.h"
+
+namespace bs { namespace ct
+{
+	/** Number of objects processed at once by the SIMD culling code. */
+	static constexpr UINT32 SIMD_WIDTH = 4;
+
+	/** Maximum number of planes to cull against. Views normally use a six plane frustum, any extra planes are ignored. */
+	static constexpr UINT32 MAX_PLANES = 8;
+
+	/** Converts a SIMD comparison mask into a bit mask, with one bit per element. */
+	static UINT32 toBitMask(const simd::mask_float32x4& mask)
+	{
+		// One bit per byte, convert to one bit per element
+		const UINT32 byteMask = simd::extract_bits_any(simd::bit_cast<simd::uint8x16>(mask));
+		return (byteMask & 0x1) | ((byteMask >> 3) & 0x2) | ((byteMask >> 6) & 0x4) | ((byteMask >> 9) & 0x8);
+	}
+
+	/** Root node extent of the octree used as the spatial index. Objects outside of it are stored in the root node. */
+	static constexpr float OCTREE_EXTENT = 8192.0f;
+
+	CullBuffer::~CullBuffer()
+	{
+		if(mOctree)
+			bs_delete(mOctree);
+	}
+
+	void CullBuffer::add(const CullInfo& info)
+	{
+		const auto idx = (UINT32)mInfos.size();
+		mInfos.push_back(info);
+
+		resizeArrays(idx + 1);
+		writeBounds(idx);
+		mCullDistanceFactor[idx] = info.cullDistanceFactor;
+		mLayers[idx] = info.layer;
+
+		if(mOctree)
+			addToOctree(idx);
+	}
+
+	void CullBuffer::setBounds(UINT32 idx, const Bounds& bounds)
+	{
+		mInfos[idx].bounds = bounds;
+		writeBounds(idx);
+
+		if(mOctree)
+			updateInOctree(idx);
+	}
+
+	void CullBuffer::setCullDistanceFactor(UINT32 idx, float cullDistanceFactor)
+	{
+		mInfos[idx].cullDistanceFactor = cullDistanceFactor;
+		mCullDistanceFactor[idx] = cullDistanceFactor;
+
+		if(mOctree)
+			updateInOctree(idx);
+	}
+
+	void CullBuffer::swap(UINT32 a, UINT32 b)
+	{
+		std::swap(mInfos[a], mInfos[b]);
+
+		std::swap(mSphereCenterX[a], mSphereCenterX[b]);
+		std::swap(mSphereCenterY[a], mSphereCenterY[b]);
+		std::swap(mSphereCenterZ[a], mSphereCenterZ[b]);
+		std::swap(mSphereRadius[a], mSphereRadius[b]);
+		std::swap(mBoxCenterX[a], mBoxCenterX[b]);
+		std::swap(mBoxCenterY[a], mBoxCenterY[b]);
+		std::swap(mBoxCenterZ[a], mBoxCenterZ[b]);
+		std::swap(mBoxExtentX[a], mBoxExtentX[b]);
+		std::swap(mBoxExtentY[a], mBoxExtentY[b]);
+		std::swap(mBoxExtentZ[a], mBoxExtentZ[b]);
+		std::swap(mCullDistanceFactor[a], mCullDistanceFactor[b]);
+		std::swap(mLayers[a], mLayers[b]);
+
+		if(mOctree)
+		{
+			std::swap(mObjectToSlot[a], mObjectToSlot[b]);
+
+			mSlotToObject[mObjectToSlot[a]] = a;
+			mSlotToObject[mObjectToSlot[b]] = b;
+		}
+	}
+
+	void CullBuffer::removeLast()
+	{
+		if(mOctree)
+			removeFromOctree((UINT32)mInfos.size() - 1);
+
+		mInfos.erase(mInfos.end() - 1);
+		resizeArrays((UINT32)mInfos.size());
+	}
+
+	void CullBuffer::setSpatialIndexEnabled(bool enabled)
+	{
+		if(enabled == isSpatialIndexEnabled())
+			return;
+
+		if(enabled)
+		{
+			mOctree = bs_new<ObjectOctree>(Vector3::ZERO, OCTREE_EXTENT, this);
+
+			for(UINT32 i = 0; i < (UINT32)mInfos.size(); i++)
+				addToOctree(i);
+		}
+		else
+		{
+			bs_delete(mOctree);
+			mOctree = nullptr;
+
+			mSlotOctreeIds.clear();
+			mSlotToObject.clear();
+			mObjectToSlot.clear();
+			mFreeSlots.clear();
+		}
+	}
+
+	void CullBuffer::addToOctree(UINT32 idx)
+	{
+		UINT32 slot;
+		if(!mFreeSlots.empty())
+		{
+			slot = mFreeSlots.back();
+			mFreeSlots.erase(mFreeSlots.end() - 1);
+		}
+		else
+		{
+			slot = (UINT32)mSlotToObject.size();
+			mSlotToObject.push_back(0);
+			mSlotOctreeIds.push_back(OctreeElementId());
+		}
+
+		assert(idx == (UINT32)mObjectToSlot.size());
+		mObjectToSlot.push_back(slot);
+		mSlotToObject[slot] = idx;
+
+		insertSlot(slot);
+	}
+
+	void CullBuffer::updateInOctree(UINT32 idx)
+	{
+		const UINT32 slot = mObjectToSlot[idx];
+		mOctree->removeElement(mSlotOctreeIds[slot]);
+
+		insertSlot(slot);
+	}
+
+	void CullBuffer::insertSlot(UINT32 slot)
+	{
+		const CullInfo& info = mInfos[mSlotToObject[slot]];
+
+		OctreeElement elem;
+		elem.slot = slot;
+		elem.cullDistanceFactor = info.cullDistanceFactor;
+		elem.layer = info.layer;
+		elem.sphere = info.bounds.getSphere();
+
+		mOctree->addElement(elem);
+	}
+
+	void CullBuffer::removeFromOctree(UINT32 idx)
+	{
+		assert(idx == (UINT32)mObjectToSlot.size() - 1);
+
+		const UINT32 slot = mObjectToSlot[idx];
+		mOctree->removeElement(mSlotOctreeIds[slot]);
+
+		mObjectToSlot.erase(mObjectToSlot.end() - 1);
+		mFreeSlots.push_back(slot);
+	}
+
+	simd::AABox CullBuffer::OctreeOptions::getBounds(const OctreeElement& elem, void* context)
+	{
+		const auto cullBuffer = (const CullBuffer*)context;
+		const UINT32 idx = cullBuffer->mSlotToObject[elem.slot];
+
+		return simd::AABox(cullBuffer->mInfos[idx].bounds.getBox());
+	}
+
+	void CullBuffer::OctreeOptions::setElementId(const OctreeElement& elem, const OctreeElementId& id, void* context)
+	{
+		const auto cullBuffer = (CullBuffer*)context;
+		cullBuffer->mSlotOctreeIds[elem.slot] = id;
+	}
+
+	void CullBuffer::resizeArrays(UINT32 count)
+	{
+		const UINT32 paddedCount = Math::divideAndRoundUp(count, SIMD_WIDTH) * SIMD_WIDTH;
+
+		mSphereCenterX.resize(paddedCount);
+		mSphereCenterY.resize(paddedCount);
+		mSphereCenterZ.resize(paddedCount);
+		mSphereRadius.resize(paddedCount);
+		mBoxCenterX.resize(paddedCount);
+		mBoxCenterY.resize(paddedCount);
+		mBoxCenterZ.resize(paddedCount);
+		mBoxExtentX.resize(paddedCount);
+		mBoxExtentY.resize(paddedCount);
+		mBoxExtentZ.resize(paddedCount);
+		mCullDistanceFactor.resize(paddedCount);
+		mLayers.resize(paddedCount);
+	}
+
+	void CullBuffer::writeBounds(UINT32 idx)
+	{
+		const Sphere& sphere = mInfos[idx].bounds.getSphere();
+		const Vector3& sphereCenter = sphere.getCenter();
+
+		mSphereCenterX[idx] = sphereCenter.x;
+		mSphereCenterY[idx] = sphereCenter.y;
+		mSphereCenterZ[idx] = sphereCenter.z;
+		mSphereRadius[idx] = sphere.getRadius();
+
+		const AABox& box = mInfos[idx].bounds.getBox();
+		const Vector3 boxCenter = box.getCenter();
+		const Vector3 boxExtents = box.getHalfSize();
+
+		mBoxCenterX[idx] = boxCenter.x;
+		mBoxCenterY[idx] = boxCenter.y;
+		mBoxCenterZ[idx] = boxCenter.z;
+		mBoxExtentX[idx] = Math::abs(boxExtents.x);
+		mBoxExtentY[idx] = Math::abs(boxExtents.y);
+		mBoxExtentZ[idx] = Math::abs(boxExtents.z);
+	}
+
+	void CullBuffer::cull(const CullView& view, UINT32 start, UINT32 end, UINT64* output) const
+	{
+		assert((start % 64) == 0);
+
+		struct SIMDPlane
+		{
+			simd::float32x4 normalX, normalY, normalZ;
+			simd::float32x4 absNormalX, absNormalY, absNormalZ;
+			simd::float32x4 d;
+		};
+
+		SIMDPlane planes[MAX_PLANES];
+
+		const auto numPlanes = std::min((UINT32)view.planes.size(), MAX_PLANES);
+		for(UINT32 i = 0; i < numPlanes; i++)
+		{
+			const Plane& plane = view.planes[i];
+
+			planes[i].normalX = simd::splat(plane.normal.x);
+			planes[i].normalY = simd::splat(plane.normal.y);
+			planes[i].normalZ = simd::splat(plane.normal.z);
+			planes[i].absNormalX = simd::splat(Math::abs(plane.normal.x));
+			planes[i].absNormalY = simd::splat(Math::abs(plane.normal.y));
+			planes[i].absNormalZ = simd::splat(Math::abs(plane.normal.z));
+			planes[i].d = simd::splat(plane.d);
+		}
+
+		const simd::float32x4 originX = simd::splat(view.origin.x);
+		const simd::float32x4 originY = simd::splat(view.origin.y);
+		const simd::float32x4 originZ = simd::splat(view.origin.z);
+		const simd::float32x4 cullDistance = simd::splat(view.cullDistance);
+
+		UINT64 word = 0;
+		for(UINT32 i = start; i < end; i += SIMD_WIDTH)
+		{
+			const simd::float32x4 sphereX = simd::load_u<simd::float32x4>(&mSphereCenterX[i]);
+			const simd::float32x4 sphereY = simd::load_u<simd::float32x4>(&mSphereCenterY[i]);
+			const simd::float32x4 sphereZ = simd::load_u<simd::float32x4>(&mSphereCenterZ[i]);
+			const simd::float32x4 radius = simd::load_u<simd::float32x4>(&mSphereRadius[i]);
+
+			// Distance culling
+			const simd::float32x4 diffX = simd::sub(sphereX, originX);
+			const simd::float32x4 diffY = simd::sub(sphereY, originY);
+			const simd::float32x4 diffZ = simd::sub(sphereZ, originZ);
+			const simd::float32x4 distanceSq = simd::add(simd::add(simd::mul(diffX, diffX), simd::mul(diffY, diffY)),
+				simd::mul(diffZ, diffZ));
+
+			const simd::float32x4 cullDistanceFactor = simd::load_u<simd::float32x4>(&mCullDistanceFactor[i]);
+			const simd::float32x4 maxDistance = simd::add(simd::mul(cullDistanceFactor, cullDistance), radius);
+			const simd::float32x4 maxDistanceSq = simd::mul(maxDistance, maxDistance);
+
+			// Only cull if strictly out of range. Infinite factors (e.g. lights) multiplied by a zero cull distance
+			// result in NaN, and such objects must stay visible.
+			const simd::mask_float32x4 inRange = simd::bit_not(simd::cmp_gt(distanceSq, maxDistanceSq));
+
+			UINT32 mask = toBitMask(inRange);
+
+			// Layer culling
+			for(UINT32 j = 0; j < SIMD_WIDTH; j++)
+			{
+				if((mLayers[i + j] & view.layers) == 0)
+					mask &= ~(1U << j);
+			}
+
+			// Frustum culling, first using the sphere and then the box. Skipped if all objects were already culled.
+			if(mask != 0)
+			{
+				const simd::float32x4 boxX = simd::load_u<simd::float32x4>(&mBoxCenterX[i]);
+				const simd::float32x4 boxY = simd::load_u<simd::float32x4>(&mBoxCenterY[i]);
+				const simd::float32x4 boxZ = simd::load_u<simd::float32x4>(&mBoxCenterZ[i]);
+				const simd::float32x4 extentX = simd::load_u<simd::float32x4>(&mBoxExtentX[i]);
+				const simd::float32x4 extentY = simd::load_u<simd::float32x4>(&mBoxExtentY[i]);
+				const simd::float32x4 extentZ = simd::load_u<simd::float32x4>(&mBoxExtentZ[i]);
+
+				const simd::float32x4 negRadius = simd::neg(radius);
+				simd::mask_float32x4 inside = inRange;
+				for(UINT32 j = 0; j < numPlanes; j++)
+				{
+					const SIMDPlane& plane = planes[j];
+
+					simd::float32x4 sphereDist = simd::mul(sphereX, plane.normalX);
+					sphereDist = simd::add(sphereDist, simd::mul(sphereY, plane.normalY));
+					sphereDist = simd::add(sphereDist, simd::mul(sphereZ, plane.normalZ));
+					sphereDist = simd::sub(sphereDist, plane.d);
+
+					simd::float32x4 boxDist = simd::mul(boxX, plane.normalX);
+					boxDist = simd::add(boxDist, simd::mul(boxY, plane.normalY));
+					boxDist = simd::add(boxDist, simd::mul(boxZ, plane.normalZ));
+					boxDist = simd::sub(boxDist, plane.d);
+
+					simd::float32x4 effectiveRadius = simd::mul(extentX, plane.absNormalX);
+					effectiveRadius = simd::add(effectiveRadius, simd::mul(extentY, plane.absNormalY));
+					effectiveRadius = simd::add(effectiveRadius, simd::mul(extentZ, plane.absNormalZ));
+
+					inside = simd::bit_and(inside, simd::cmp_ge(sphereDist, negRadius));
+					inside = simd::bit_and(inside, simd::cmp_ge(boxDist, simd::neg(effectiveRadius)));
+				}
+
+				mask &= toBitMask(inside);
+			}
+
+			const UINT32 bitIdx = (i - start) & 63;
+			word |= (UINT64)mask << bitIdx;
+
+			if(bitIdx == (64 - SIMD_WIDTH))
+			{
+				*output++ = word;
+				word = 0;
+			}
+		}
+
+		// Write the last partial word, ignoring any padding elements
+		const UINT32 numTrailing = (end - start) & 63;
+		if(numTrailing != 0)
+			*output = word & ((1ULL << numTrailing) - 1);
+	}
+
+	/**
+	 * Checks if the box is in front of, or intersecting, all the view planes. Performs the same operations as the box
+	 * test in CullBuffer::cull().
+	 */
+	static bool isBoxVisible(const CullView& view, const simd::AABox& box, UINT32 numPlanes)
+	{
+		for(UINT32 i = 0; i < numPlanes; i++)
+		{
+			const Plane& plane = view.planes[i];
+
+			float boxDist = box.center.x * plane.normal.x;
+			boxDist += box.center.y * plane.normal.y;
+			boxDist += box.center.z * plane.normal.z;
+			boxDist -= plane.d;
+
+			float effectiveRadius = Math::abs(box.extents.x) * Math::abs(plane.normal.x);
+			effectiveRadius += Math::abs(box.extents.y) * Math::abs(plane.normal.y);
+			effectiveRadius += Math::abs(box.extents.z) * Math::abs(plane.normal.z);
+
+			if(!(boxDist >= -effectiveRadius))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool CullBuffer::isVisible(const CullView& view, const OctreeElement& elem)
+	{
+		// Note: Operations are performed in the same order as in cull(), so both methods produce the same results
+		if((elem.layer & view.layers) == 0)
+			return false;
+
+		const Vector3& sphereCenter = elem.sphere.getCenter();
+		const float radius = elem.sphere.getRadius();
+
+		const float diffX = sphereCenter.x - view.origin.x;
+		const float diffY = sphereCenter.y - view.origin.y;
+		const float diffZ = sphereCenter.z - view.origin.z;
+		const float distanceSq = (diffX * diffX + diffY * diffY) + diffZ * diffZ;
+
+		// NaN maximum distance (infinite factor with a zero cull distance) is treated as unbounded, same as in cull()
+		const float maxDistance = elem.cullDistanceFactor * view.cullDistance + radius;
+		if(distanceSq > maxDistance * maxDistance)
+			return false;
+
+		const UINT32 numPlanes = std::min((UINT32)view.planes.size(), MAX_PLANES);
+		for(UINT32 i = 0; i < numPlanes; i++)
+		{
+			const Plane& plane = view.planes[i];
+
+			float sphereDist = sphereCenter.x * plane.normal.x;
+			sphereDist += sphereCenter.y * plane.normal.y;
+			sphereDist += sphereCenter.z * plane.normal.z;
+			sphereDist -= plane.d;
+
+			if(!(sphereDist >= -radius))
+				return false;
+		}
+
+		return true;
+	}
+
+	void CullBuffer::cullHierarchical(const CullView& view, UINT64* output) const
+	{
+		assert(mOctree != nullptr);
+
+		const UINT32 numObjects = size();
+		memset(output, 0, Math::divideAndRoundUp(numObjects, 64U) * sizeof(UINT64));
+
+		if(numObjects == 0)
+			return;
+
+		struct NodeToVisit
+		{
+			const ObjectOctree::Node* node;
+			ObjectOctree::NodeBounds bounds;
+			UINT32 planeMask; // Planes the node isn't yet known to be fully in front of
+		};
+
+		const UINT32 numPlanes = std::min((UINT32)view.planes.size(), MAX_PLANES);
+
+		ObjectOctree::NodeIterator rootIter(*mOctree);
+		rootIter.moveNext();
+
+		const ObjectOctree::HNode& root = rootIter.getCurrent();
+
+		// Note: Root node is always visited, since it also holds the objects that don't fit into the tree bounds
+		Vector<NodeToVisit> todo;
+		todo.push_back({ root.getNode(), root.getBounds(), (1U << numPlanes) - 1 });
+
+		bool isRoot = true;
+		while(!todo.empty())
+		{
+			NodeToVisit current = todo.back();
+			todo.erase(todo.end() - 1);
+
+			if(!isRoot)
+			{
+				// Objects in a node (and its children) are fully contained in the node bounds, so if the node is fully
+				// behind any plane, all of them can be skipped
+				const simd::AABox& nodeBounds = current.bounds.getBounds();
+
+				bool culled = false;
+				for(UINT32 i = 0; i < numPlanes; i++)
+				{
+					if((current.planeMask & (1U << i)) == 0)
+						continue;
+
+					const Plane& plane = view.planes[i];
+
+					const float dist = nodeBounds.center.x * plane.normal.x + nodeBounds.center.y * plane.normal.y +
+						nodeBounds.center.z * plane.normal.z - plane.d;
+					const float effectiveRadius = nodeBounds.extents.x * Math::abs(plane.normal.x) +
+						nodeBounds.extents.y * Math::abs(plane.normal.y) + nodeBounds.extents.z * Math::abs(plane.normal.z);
+
+					if(dist < -effectiveRadius)
+					{
+						culled = true;
+						break;
+					}
+
+					// Fully in front of the plane, no need to check the children against it
+					if(dist > effectiveRadius)
+						current.planeMask &= ~(1U << i);
+				}
+
+				if(culled)
+					continue;
+			}
+
+			isRoot = false;
+
+			ObjectOctree::ElementIterator elemIter(current.node);
+			while(elemIter.moveNext())
+			{
+				const OctreeElement& elem = elemIter.getCurrentElem();
+				if(!isBoxVisible(view, elemIter.getCurrentBounds(), numPlanes) || !isVisible(view, elem))
+					continue;
+
+				const UINT32 idx = mSlotToObject[elem.slot];
+				output[idx >> 6] |= 1ULL << (idx & 63);
+			}
+
+			for(UINT32 i = 0; i < 8; i++)
+			{
+				if(current.node->hasChild(i))
+					todo.push_back({ current.node->getChild(i), current.bounds.getChild(i), current.planeMask });
+			}
+		}
+	}
+}}
@@ -0,0 +1,233 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Math/BsBounds.h"
+#include "Math/BsPlane.h"
+#include "Utility/BsOctree.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	/** Information used for culling an object against a view. */
+	struct CullInfo
+	{
+		CullInfo(const Bounds& bounds, UINT64 layer = -1, float cullDistanceFactor = 1.0f)
+			:layer(layer), bounds(bounds), cullDistanceFactor(cullDistanceFactor)
+		{ }
+
+		UINT64 layer;
+		Bounds bounds;
+		float cullDistanceFactor;
+	};
+
+	/** Packed set of bits, one for each object, determining whether the object is visible or not. */
+	class VisibilityMask
+	{
+	public:
+		/** Resizes the mask so it can hold @p size objects, and marks all objects as visible or not visible. */
+		void reset(UINT32 size, bool visible = false)
+		{
+			mSize = size;
+			mWords.assign(Math::divideAndRoundUp(size, 64U), visible ? ~0ULL : 0ULL);
+
+			// Keep the bits past the last object cleared
+			if(visible && (size & 63) != 0)
+				mWords.back() &= (1ULL << (size & 63)) - 1;
+		}
+
+		/** Marks all objects in @p other as visible in this mask. Both masks must be of the same size. */
+		void merge(const VisibilityMask& other)
+		{
+			assert(mSize == other.mSize);
+
+			for(UINT32 i = 0; i < (UINT32)mWords.size(); i++)
+				mWords[i] |= other.mWords[i];
+		}
+
+		/** Checks is the object at the specified index visible. */
+		bool operator[](UINT32 idx) const
+		{
+			return ((mWords[idx >> 6] >> (idx & 63)) & 1) != 0;
+		}
+
+		/** Returns the number of objects in the mask. */
+		UINT32 size() const { return mSize; }
+
+		/** Returns the number of 64-bit words used for storing the mask. */
+		UINT32 getNumWords() const { return (UINT32)mWords.size(); }
+
+		/** Returns the words storing the mask. Bit N of word M corresponds to object with index M * 64 + N. */
+		UINT64* getWords() { return mWords.data(); }
+
+	private:
+		Vector<UINT64> mWords;
+		UINT32 mSize = 0;
+	};
+
+	/** Information about a view that objects are being culled against. */
+	struct CullView
+	{
+		/** Planes of the view frustum. */
+		Vector<Plane> planes;
+
+		/** Position the view is located at, used for distance culling. */
+		Vector3 origin;
+
+		/** Distance at which objects are culled, before being scaled by CullInfo::cullDistanceFactor. */
+		float cullDistance;
+
+		/** Layers visible by the view. */
+		UINT64 layers;
+	};
+
+	/**
+	 * Stores culling information of a set of objects. Provides access to each individual CullInfo, while also storing
+	 * the same data in a structure-of-arrays layout, so that multiple objects can be culled at once using SIMD
+	 * instructions.
+	 *
+	 * Optionally the objects can also be stored in an octree, in which case cullHierarchical() can reject entire groups
+	 * of objects at once. This makes culling cost proportional to the number of objects near the view frustum, rather
+	 * than to the total number of objects.
+	 */
+	class CullBuffer
+	{
+		/**
+		 * Object stored in the octree. Contains a copy of the culling information (other than the bounding box, which
+		 * the octree stores itself), so it can be tested without accessing the object data.
+		 */
+		struct OctreeElement
+		{
+			UINT32 slot;
+			float cullDistanceFactor;
+			UINT64 layer;
+			Sphere sphere;
+		};
+
+		/** Options used for the octree storing the objects. */
+		struct OctreeOptions
+		{
+			enum { LoosePadding = 8 };
+			enum { MinElementsPerNode = 16 };
+			enum { MaxElementsPerNode = 32 };
+			enum { MaxDepth = 12 };
+
+			static simd::AABox getBounds(const OctreeElement& elem, void* context);
+			static void setElementId(const OctreeElement& elem, const OctreeElementId& id, void* context);
+		};
+
+		typedef Octree<OctreeElement, OctreeOptions> ObjectOctree;
+	public:
+		CullBuffer() = default;
+		CullBuffer(const CullBuffer&) = delete;
+		CullBuffer& operator=(const CullBuffer&) = delete;
+		~CullBuffer();
+
+		/** Adds a new object to the end of the buffer. */
+		void add(const CullInfo& info);
+
+		/** Updates the bounds of the object at the specified index. */
+		void setBounds(UINT32 idx, const Bounds& bounds);
+
+		/** Updates the cull distance factor of the object at the specified index. */
+		void setCullDistanceFactor(UINT32 idx, float cullDistanceFactor);
+
+		/** Swaps the objects at the two provided indices. */
+		void swap(UINT32 a, UINT32 b);
+
+		/** Removes the last object in the buffer. */
+		void removeLast();
+
+		/** Returns culling information for the object at the specified index. */
+		const CullInfo& operator[](UINT32 idx) const { return mInfos[idx]; }
+
+		/** Returns the number of objects in the buffer. */
+		UINT32 size() const { return (UINT32)mInfos.size(); }
+
+		/**
+		 * Determines which objects in the range [@p start, @p end) are visible from the provided view. The objects are
+		 * checked against view layers, cull distance and the view frustum (using both the bounding sphere and the
+		 * bounding box).
+		 *
+		 * @param[in]	view		View to cull the objects against.
+		 * @param[in]	start		Index of the first object to check. Must be a multiple of 64.
+		 * @param[in]	end			Index one past the last object to check.
+		 * @param[out]	output		Words of a VisibilityMask, starting with the word corresponding to @p start. Each
+		 *							word in the range is overwritten, with bits of visible objects set.
+		 */
+		void cull(const CullView& view, UINT32 start, UINT32 end, UINT64* output) const;
+
+		/**
+		 * Enables or disables the octree spatial index. Enabling the index is only worth it for objects whose bounds
+		 * are not updated often, as each bounds update requires the object to be re-inserted into the tree.
+		 */
+		void setSpatialIndexEnabled(bool enabled);
+
+		/** Checks is the octree spatial index enabled. See setSpatialIndexEnabled(). */
+		bool isSpatialIndexEnabled() const { return mOctree != nullptr; }
+
+		/**
+		 * Determines which objects are visible from the provided view, same as cull(). Traverses the octree and skips
+		 * all objects in octree nodes that are fully outside the view frustum. Spatial index must be enabled.
+		 *
+		 * @param[in]	view		View to cull the objects against.
+		 * @param[out]	output		Words of a VisibilityMask large enough to hold all objects in the buffer. All words
+		 *							are overwritten, with bits of visible objects set.
+		 */
+		void cullHierarchical(const CullView& view, UINT64* output) const;
+
+	private:
+		/**
+		 * Checks is the object visible from the provided view. Performs the same layer, distance and bounding sphere
+		 * tests as cull(), for a single object. Bounding box must be tested separately.
+		 */
+		static bool isVisible(const CullView& view, const OctreeElement& elem);
+
+		/** Inserts the object at the specified index into the octree. */
+		void addToOctree(UINT32 idx);
+
+		/** Re-inserts the object at the specified index into the octree, after its culling information changed. */
+		void updateInOctree(UINT32 idx);
+
+		/** Inserts the object using the provided slot into the octree. */
+		void insertSlot(UINT32 slot);
+
+		/** Removes the object at the specified index from the octree. */
+		void removeFromOctree(UINT32 idx);
+
+		/** Resizes the SIMD arrays so they can hold @p count objects, padded to the SIMD width. */
+		void resizeArrays(UINT32 count);
+
+		/** Copies the bounds of the object at the specified index into the SIMD arrays. */
+		void writeBounds(UINT32 idx);
+
+		Vector<CullInfo> mInfos;
+
+		// Same data as in mInfos, stored in a SIMD friendly layout
+		Vector<float> mSphereCenterX;
+		Vector<float> mSphereCenterY;
+		Vector<float> mSphereCenterZ;
+		Vector<float> mSphereRadius;
+		Vector<float> mBoxCenterX;
+		Vector<float> mBoxCenterY;
+		Vector<float> mBoxCenterZ;
+		Vector<float> mBoxExtentX;
+		Vector<float> mBoxExtentY;
+		Vector<float> mBoxExtentZ;
+		Vector<float> mCullDistanceFactor;
+		Vector<UINT64> mLayers;
+
+		// Spatial index. Octree elements refer to objects through slots, which stay the same when objects are swapped.
+		ObjectOctree* mOctree = nullptr;
+		Vector<OctreeElementId> mSlotOctreeIds;
+		Vector<UINT32> mSlotToObject;
+		Vector<UINT32> mObjectToSlot;
+		Vector<UINT32> mFreeSlots;
+	};
+
+	/** @} */
+}}
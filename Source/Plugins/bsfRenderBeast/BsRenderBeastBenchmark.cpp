@@ -0,0 +1,171 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsCullBuffer.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsMatrix4.h"
+#include "Math/BsRandom.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTimer.h"
+
+#include <iostream>
+
+namespace bs
+{
+	/**
+	 * Measures the time it takes to cull a scene of objects against a single view. Compares the original per-object
+	 * culling loop against the SIMD CullBuffer kernel (both single threaded and split over the task scheduler), and
+	 * against culling using the octree spatial index. Only synthetic scene data is used so no render API needs to be
+	 * running.
+	 */
+	void benchmarkCulling()
+	{
+		static constexpr UINT32 NUM_ITERATIONS = 20;
+		static constexpr UINT32 OBJECTS_PER_TASK = 2048;
+
+		ThreadPool::startUp<TThreadPool<>>(BS_THREAD_HARDWARE_CONCURRENCY + 2);
+		TaskScheduler::startUp();
+
+		const Matrix4 proj = Matrix4::projectionPerspective(Degree(75.0f), 16.0f / 9.0f, 0.05f, 1000.0f);
+		const ConvexVolume frustum(proj);
+
+		ct::CullView cullView;
+		cullView.planes = frustum.getPlanes();
+		cullView.origin = Vector3::ZERO;
+		cullView.layers = 0x7;
+
+		struct Scenario
+		{
+			float worldExtent;
+			float cullDistance;
+		};
+
+		// Dense scene (with and without distance culling), and a large sparse scene where the view sees a small part
+		Scenario scenarios[] =
+		{
+			{ 800.0f, FLT_MAX },
+			{ 800.0f, 500.0f },
+			{ 8000.0f, FLT_MAX }
+		};
+
+		std::cout << "Culling (" << NUM_ITERATIONS << " iterations)" << std::endl;
+		for(UINT32 numObjects : { 10000, 100000, 1000000 })
+		{
+			for(auto& scenario : scenarios)
+			{
+				cullView.cullDistance = scenario.cullDistance;
+
+				Random random(1234);
+				ct::CullBuffer cullBuffer;
+				for(UINT32 i = 0; i < numObjects; i++)
+				{
+					const Vector3 center(random.getSNorm(), random.getSNorm(), random.getSNorm());
+					const Vector3 extents(random.getUNorm() * 5.0f, random.getUNorm() * 5.0f, random.getUNorm() * 5.0f);
+
+					const AABox box(center * scenario.worldExtent - extents, center * scenario.worldExtent + extents);
+					const Sphere sphere(center * scenario.worldExtent, extents.length());
+
+					cullBuffer.add(ct::CullInfo(Bounds(box, sphere), 1ULL << (i % 4)));
+				}
+
+				// Original per-object loop
+				Vector<bool> scalarVisibility(numObjects);
+				Timer timer;
+				for(UINT32 iter = 0; iter < NUM_ITERATIONS; iter++)
+				{
+					for(UINT32 i = 0; i < numObjects; i++)
+					{
+						scalarVisibility[i] = false;
+
+						const ct::CullInfo& info = cullBuffer[i];
+						if((info.layer & cullView.layers) == 0)
+							continue;
+
+						const Sphere& sphere = info.bounds.getSphere();
+						const float distanceSq = cullView.origin.squaredDistance(sphere.getCenter());
+						const float maxDistance = info.cullDistanceFactor * cullView.cullDistance + sphere.getRadius();
+						if(distanceSq > maxDistance * maxDistance)
+							continue;
+
+						if(frustum.intersects(sphere) && frustum.intersects(info.bounds.getBox()))
+							scalarVisibility[i] = true;
+					}
+				}
+				const UINT64 scalarTime = timer.getMicroseconds();
+
+				// SIMD, single threaded
+				ct::VisibilityMask simdVisibility;
+				simdVisibility.reset(numObjects);
+
+				timer.reset();
+				for(UINT32 iter = 0; iter < NUM_ITERATIONS; iter++)
+					cullBuffer.cull(cullView, 0, numObjects, simdVisibility.getWords());
+				const UINT64 simdTime = timer.getMicroseconds();
+
+				// SIMD, split over multiple tasks
+				ct::VisibilityMask parallelVisibility;
+				parallelVisibility.reset(numObjects);
+
+				UINT64* words = parallelVisibility.getWords();
+				const UINT32 numBatches = Math::divideAndRoundUp(numObjects, OBJECTS_PER_TASK);
+
+				timer.reset();
+				for(UINT32 iter = 0; iter < NUM_ITERATIONS; iter++)
+				{
+					TaskScheduler::instance().parallelFor("Culling", numBatches, 1,
+						[&cullBuffer, &cullView, numObjects, words](UINT32 start, UINT32 end)
+					{
+						const UINT32 first = start * OBJECTS_PER_TASK;
+						const UINT32 last = std::min(end * OBJECTS_PER_TASK, numObjects);
+
+						cullBuffer.cull(cullView, first, last, words + first / 64);
+					});
+				}
+				const UINT64 parallelTime = timer.getMicroseconds();
+
+				// Using the spatial index
+				cullBuffer.setSpatialIndexEnabled(true);
+
+				ct::VisibilityMask octreeVisibility;
+				octreeVisibility.reset(numObjects);
+
+				timer.reset();
+				for(UINT32 iter = 0; iter < NUM_ITERATIONS; iter++)
+					cullBuffer.cullHierarchical(cullView, octreeVisibility.getWords());
+				const UINT64 octreeTime = timer.getMicroseconds();
+
+				UINT32 numVisible = 0;
+				UINT32 numMismatches = 0;
+				for(UINT32 i = 0; i < numObjects; i++)
+				{
+					if(scalarVisibility[i])
+						numVisible++;
+
+					if(scalarVisibility[i] != simdVisibility[i] || scalarVisibility[i] != parallelVisibility[i] ||
+						scalarVisibility[i] != octreeVisibility[i])
+						numMismatches++;
+				}
+
+				const auto toMsPerIteration = [](UINT64 time) { return time / (1000.0 * NUM_ITERATIONS); };
+
+				std::cout << "  " << numObjects << " objects, world extent " << scenario.worldExtent << ", cull distance " <<
+					scenario.cullDistance << " (" << numVisible << " visible, " << numMismatches << " mismatches)" << std::endl;
+				std::cout << "    Scalar:           " << toMsPerIteration(scalarTime) << " ms" << std::endl;
+				std::cout << "    SIMD:             " << toMsPerIteration(simdTime) << " ms" << std::endl;
+				std::cout << "    SIMD (parallel):  " << toMsPerIteration(parallelTime) << " ms" << std::endl;
+				std::cout << "    Octree:           " << toMsPerIteration(octreeTime) << " ms" << std::endl;
+			}
+		}
+
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	benchmarkCulling();
+
+	return 0;
+}
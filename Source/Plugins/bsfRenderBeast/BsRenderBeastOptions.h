@@ -43,6 +43,14 @@ namespace bs { namespace ct
 		 * shadows far away, but will never increase the resolution past the provided value.
 		 */
 		UINT32 shadowMapSize = 2048;
+
+		/**
+		 * If true, renderables, lights and decals will also be stored in an octree, allowing views to cull entire groups
+		 * of objects at once. This makes culling cost proportional to the number of objects near the view rather than the
+		 * total number of objects in the scene, at the cost of extra work whenever an object moves. Best suited for large
+		 * scenes with mostly static objects.
+		 */
+		bool spatialIndex = false;
 	};
 
 	/** @} */
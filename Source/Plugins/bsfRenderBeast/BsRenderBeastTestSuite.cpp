@@ -2,6 +2,10 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Testing/BsTestSuite.h"
 #include "Utility/BsTextureRowAllocator.h"
+#include "BsCullBuffer.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsMatrix4.h"
+#include "Math/BsRandom.h"
 
 namespace bs
 {
@@ -13,11 +17,15 @@ namespace bs
 
 	private:
 		void testTextureRowAllocator();
+		void testCullBuffer();
+		void testCullBufferSpatialIndex();
 	};
 
 	RenderBeastTestSuite::RenderBeastTestSuite()
 	{
 		BS_ADD_TEST(RenderBeastTestSuite::testTextureRowAllocator);
+		BS_ADD_TEST(RenderBeastTestSuite::testCullBuffer);
+		BS_ADD_TEST(RenderBeastTestSuite::testCullBufferSpatialIndex);
 	}
 
 	void RenderBeastTestSuite::testTextureRowAllocator()
@@ -71,4 +79,181 @@ namespace bs
 		auto a13 = alloc.alloc(0);
 		BS_TEST_ASSERT(a13.length == 0);
 	}
+
+	void RenderBeastTestSuite::testCullBuffer()
+	{
+		static constexpr UINT32 NUM_OBJECTS = 1000;
+
+		Random random(1234);
+		ct::CullBuffer cullBuffer;
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			const Vector3 center(random.getSNorm() * 100.0f, random.getSNorm() * 100.0f, random.getSNorm() * 100.0f);
+			const Vector3 extents(random.getUNorm() * 5.0f, random.getUNorm() * 5.0f, random.getUNorm() * 5.0f);
+
+			const AABox box(center - extents, center + extents);
+			const Sphere sphere(center, extents.length());
+
+			cullBuffer.add(ct::CullInfo(Bounds(box, sphere), 1ULL << (i % 4), 0.5f + random.getUNorm()));
+		}
+
+		// Test if removal keeps the SIMD data in sync with the per-object data
+		cullBuffer.swap(10, NUM_OBJECTS - 1);
+		cullBuffer.removeLast();
+		cullBuffer.setCullDistanceFactor(20, 3.0f);
+		cullBuffer.setBounds(30, Bounds(AABox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f)),
+			Sphere(Vector3::ZERO, 1.0f)));
+
+		const Matrix4 proj = Matrix4::projectionPerspective(Degree(75.0f), 16.0f / 9.0f, 0.05f, 500.0f);
+		const ConvexVolume frustum(proj);
+
+		ct::CullView cullView;
+		cullView.planes = frustum.getPlanes();
+		cullView.origin = Vector3::ZERO;
+		cullView.cullDistance = 60.0f;
+		cullView.layers = 0x7;
+
+		ct::VisibilityMask visibility;
+		visibility.reset(cullBuffer.size());
+
+		// Cull in two parts, to ensure partial ranges are handled properly
+		cullBuffer.cull(cullView, 0, 128, visibility.getWords());
+		cullBuffer.cull(cullView, 128, cullBuffer.size(), visibility.getWords() + 2);
+
+		UINT32 numVisible = 0;
+		for(UINT32 i = 0; i < cullBuffer.size(); i++)
+		{
+			const ct::CullInfo& info = cullBuffer[i];
+			const Sphere& sphere = info.bounds.getSphere();
+
+			const float maxDistance = info.cullDistanceFactor * cullView.cullDistance + sphere.getRadius();
+			const bool expected = (info.layer & cullView.layers) != 0 &&
+				!(sphere.getCenter().squaredLength() > maxDistance * maxDistance) &&
+				frustum.intersects(sphere) && frustum.intersects(info.bounds.getBox());
+
+			BS_TEST_ASSERT(visibility[i] == expected);
+
+			if(expected)
+				numVisible++;
+		}
+
+		BS_TEST_ASSERT(numVisible > 0);
+
+		// Infinite cull distance factors (as used by lights) must never be distance culled, even if the product with the
+		// view cull distance is NaN. Same for zero factors with an infinite view cull distance.
+		const Sphere farSphere(Vector3(0.0f, 0.0f, -400.0f), 1.0f);
+		const AABox farBox(farSphere.getCenter() - Vector3::ONE, farSphere.getCenter() + Vector3::ONE);
+		const Bounds farBounds(farBox, farSphere);
+
+		ct::CullBuffer unboundedBuffer;
+		unboundedBuffer.add(ct::CullInfo(farBounds, (UINT64)-1, std::numeric_limits<float>::infinity()));
+		unboundedBuffer.add(ct::CullInfo(farBounds, (UINT64)-1, 0.0f));
+		unboundedBuffer.add(ct::CullInfo(farBounds, (UINT64)-1, 1.0f));
+
+		const auto isVisible = [&unboundedBuffer, &cullView](float cullDistance, UINT32 idx)
+		{
+			cullView.cullDistance = cullDistance;
+
+			ct::VisibilityMask unboundedVisibility;
+			unboundedVisibility.reset(unboundedBuffer.size());
+			unboundedBuffer.cull(cullView, 0, unboundedBuffer.size(), unboundedVisibility.getWords());
+
+			return unboundedVisibility[idx];
+		};
+
+		const float infinity = std::numeric_limits<float>::infinity();
+		BS_TEST_ASSERT(isVisible(0.0f, 0));
+		BS_TEST_ASSERT(isVisible(60.0f, 0));
+		BS_TEST_ASSERT(isVisible(FLT_MAX, 0));
+		BS_TEST_ASSERT(isVisible(infinity, 1));
+		BS_TEST_ASSERT(!isVisible(FLT_MAX, 1));
+		BS_TEST_ASSERT(isVisible(FLT_MAX, 2));
+		BS_TEST_ASSERT(!isVisible(60.0f, 2));
+		BS_TEST_ASSERT(!isVisible(0.0f, 2));
+	}
+
+	void RenderBeastTestSuite::testCullBufferSpatialIndex()
+	{
+		static constexpr UINT32 NUM_OBJECTS = 5000;
+
+		Random random(4321);
+		const auto createBounds = [&random]()
+		{
+			const Vector3 center(random.getSNorm() * 1000.0f, random.getSNorm() * 1000.0f, random.getSNorm() * 1000.0f);
+			const float size = random.getUNorm() < 0.1f ? 100.0f : 5.0f;
+			const Vector3 extents(random.getUNorm() * size, random.getUNorm() * size, random.getUNorm() * size);
+
+			return Bounds(AABox(center - extents, center + extents), Sphere(center, extents.length()));
+		};
+
+		// Enable the index half-way through, to ensure both existing and new objects are inserted
+		ct::CullBuffer cullBuffer;
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			if(i == NUM_OBJECTS / 2)
+				cullBuffer.setSpatialIndexEnabled(true);
+
+			// Some objects with an infinite cull distance factor, same as lights
+			const float cullDistanceFactor = (i % 8) == 0 ? std::numeric_limits<float>::infinity() : 1.0f;
+			cullBuffer.add(ct::CullInfo(createBounds(), 1ULL << (i % 2), cullDistanceFactor));
+		}
+
+		// Move and remove objects, same as the renderer does
+		for(UINT32 i = 0; i < NUM_OBJECTS / 4; i++)
+		{
+			const UINT32 idx = random.getRange(0, cullBuffer.size() - 1);
+			cullBuffer.setBounds(idx, createBounds());
+
+			const UINT32 removeIdx = random.getRange(0, cullBuffer.size() - 1);
+			cullBuffer.swap(removeIdx, cullBuffer.size() - 1);
+			cullBuffer.removeLast();
+		}
+
+		const Matrix4 proj = Matrix4::projectionPerspective(Degree(90.0f), 1.0f, 0.05f, 800.0f);
+		const ConvexVolume frustum(proj);
+
+		ct::CullView cullView;
+		cullView.planes = frustum.getPlanes();
+		cullView.origin = Vector3::ZERO;
+		cullView.layers = 0x1;
+
+		// Zero cull distance results in NaN maximum distances for the objects with infinite factors
+		for(auto cullDistance : { FLT_MAX, 300.0f, 0.0f })
+		{
+			cullView.cullDistance = cullDistance;
+
+			ct::VisibilityMask linearVisibility;
+			linearVisibility.reset(cullBuffer.size());
+			cullBuffer.cull(cullView, 0, cullBuffer.size(), linearVisibility.getWords());
+
+			ct::VisibilityMask hierarchicalVisibility;
+			hierarchicalVisibility.reset(cullBuffer.size(), true);
+			cullBuffer.cullHierarchical(cullView, hierarchicalVisibility.getWords());
+
+			UINT32 numVisible = 0;
+			UINT32 numUnboundedVisible = 0;
+			for(UINT32 i = 0; i < cullBuffer.size(); i++)
+			{
+				BS_TEST_ASSERT(linearVisibility[i] == hierarchicalVisibility[i]);
+
+				if(linearVisibility[i])
+				{
+					numVisible++;
+
+					if(std::isinf(cullBuffer[i].cullDistanceFactor))
+						numUnboundedVisible++;
+				}
+			}
+
+			BS_TEST_ASSERT(numVisible > 0);
+			BS_TEST_ASSERT(numUnboundedVisible > 0);
+		}
+
+		// Ensure disabling the index and removing all objects works
+		cullBuffer.setSpatialIndexEnabled(false);
+		cullBuffer.setSpatialIndexEnabled(true);
+
+		while(cullBuffer.size() > 0)
+			cullBuffer.removeLast();
+	}
 }
@@ -317,8 +317,9 @@ namespace bs { namespace ct
 			if (!visibility.renderables[i])
 				continue;
 
+			// Per-call buffers of different objects share GPU memory, so they're uploaded together when first bound
 			RendererRenderable* rendererRenderable = inputs.scene.renderables[i];
-			rendererRenderable->updatePerCallBuffer(viewProps.viewProjTransform);
+			rendererRenderable->updatePerCallBuffer(viewProps.viewProjTransform, false);
 
 			for (auto& element : inputs.scene.renderables[i]->elements)
 			{
@@ -375,7 +376,7 @@ namespace bs { namespace ct
 			const RendererDecal& rendererDecal = inputs.scene.decals[i];
 			DecalRenderElement& renderElement = rendererDecal.renderElement;
 
-			rendererDecal.updatePerCallBuffer(viewProps.viewProjTransform);
+			rendererDecal.updatePerCallBuffer(viewProps.viewProjTransform, false);
 
 			SPtr<GpuParams> gpuParams = renderElement.params->getGpuParams();
 			for (UINT32 j = 0; j < GPT_COUNT; j++)
@@ -15,11 +15,11 @@ namespace bs { namespace ct
 		gRendererUtility().draw(mesh, subMesh);
 	}
 
-	RendererDecal::RendererDecal()
+	RendererDecal::RendererDecal(GpuParamBlockBufferPool& paramBlockPool)
 	{
 		decalParamBuffer = gDecalParamDef.createBuffer();
-		perObjectParamBuffer = gPerObjectParamDef.createBuffer();
-		perCallParamBuffer = gPerCallParamDef.createBuffer();
+		perObjectParamBuffer = gPerObjectParamDef.createBuffer(paramBlockPool);
+		perCallParamBuffer = gPerCallParamDef.createBuffer(paramBlockPool);
 	}
 
 	void RendererDecal::updatePerObjectBuffer()
@@ -90,7 +90,8 @@ namespace bs { namespace ct
 	 /** Contains information about a Decal, used by the Renderer. */
 	struct RendererDecal
 	{
-		RendererDecal();
+		/** Creates a new decal, allocating its per-object and per-call buffers from the provided pool. */
+		RendererDecal(GpuParamBlockBufferPool& paramBlockPool);
 
 		/** Updates the per-object GPU buffer according to the currently set properties. */
 		void updatePerObjectBuffer();
@@ -29,10 +29,10 @@ namespace bs { namespace ct
 			gRendererUtility().drawMorph(mesh, subMesh, morphShapeBuffer, morphVertexDeclaration);
 	}
 
-	RendererRenderable::RendererRenderable()
+	RendererRenderable::RendererRenderable(GpuParamBlockBufferPool& paramBlockPool)
 	{
-		perObjectParamBuffer = gPerObjectParamDef.createBuffer();
-		perCallParamBuffer = gPerCallParamDef.createBuffer();
+		perObjectParamBuffer = gPerObjectParamDef.createBuffer(paramBlockPool);
+		perCallParamBuffer = gPerCallParamDef.createBuffer(paramBlockPool);
 	}
 
 	void RendererRenderable::updatePerObjectBuffer()
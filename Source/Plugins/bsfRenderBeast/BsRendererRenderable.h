@@ -94,7 +94,8 @@ namespace bs { namespace ct
 	 /** Contains information about a Renderable, used by the Renderer. */
 	struct RendererRenderable
 	{
-		RendererRenderable();
+		/** Creates a new renderable, allocating its per-object and per-call buffers from the provided pool. */
+		RendererRenderable(GpuParamBlockBufferPool& paramBlockPool);
 
 		/** Updates the per-object GPU buffer according to the currently set properties. */
 		void updatePerObjectBuffer();
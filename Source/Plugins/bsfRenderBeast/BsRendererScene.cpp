@@ -37,10 +37,22 @@ namespace bs {	namespace ct
 		}
 	};
 
+	/** Creates culling information for a radial or a spot light. Lights are not culled by layer or by distance. */
+	static CullInfo createLightCullInfo(const Light* light)
+	{
+		const Sphere sphere = light->getBounds();
+		const Vector3 extents(sphere.getRadius(), sphere.getRadius(), sphere.getRadius());
+		const AABox box(sphere.getCenter() - extents, sphere.getCenter() + extents);
+
+		return CullInfo(Bounds(box, sphere), (UINT64)-1, std::numeric_limits<float>::infinity());
+	}
+
 	RendererScene::RendererScene(const SPtr<RenderBeastOptions>& options)
 		:mOptions(options)
 	{
 		mPerFrameParamBuffer = gPerFrameParamDef.createBuffer();
+
+		updateSpatialIndex();
 	}
 
 	RendererScene::~RendererScene()
@@ -155,7 +167,7 @@ namespace bs {	namespace ct
 				light->setRendererId(lightId);
 
 				mInfo.radialLights.push_back(RendererLight(light));
-				mInfo.radialLightWorldBounds.push_back(light->getBounds());
+				mInfo.radialLightCullInfos.add(createLightCullInfo(light));
 			}
 			else // Spot
 			{
@@ -163,7 +175,7 @@ namespace bs {	namespace ct
 				light->setRendererId(lightId);
 
 				mInfo.spotLights.push_back(RendererLight(light));
-				mInfo.spotLightWorldBounds.push_back(light->getBounds());
+				mInfo.spotLightCullInfos.add(createLightCullInfo(light));
 			}
 		}
 	}
@@ -173,9 +185,9 @@ namespace bs {	namespace ct
 		UINT32 lightId = light->getRendererId();
 
 		if (light->getType() == LightType::Radial)
-			mInfo.radialLightWorldBounds[lightId] = light->getBounds();
+			mInfo.radialLightCullInfos.setBounds(lightId, createLightCullInfo(light).bounds);
 		else if(light->getType() == LightType::Spot)
-			mInfo.spotLightWorldBounds[lightId] = light->getBounds();
+			mInfo.spotLightCullInfos.setBounds(lightId, createLightCullInfo(light).bounds);
 	}
 
 	void RendererScene::unregisterLight(Light* light)
@@ -207,14 +219,14 @@ namespace bs {	namespace ct
 				{
 					// Swap current last element with the one we want to erase
 					std::swap(mInfo.radialLights[lightId], mInfo.radialLights[lastLightId]);
-					std::swap(mInfo.radialLightWorldBounds[lightId], mInfo.radialLightWorldBounds[lastLightId]);
+					mInfo.radialLightCullInfos.swap(lightId, lastLightId);
 
 					lastLight->setRendererId(lightId);
 				}
 
 				// Last element is the one we want to erase
 				mInfo.radialLights.erase(mInfo.radialLights.end() - 1);
-				mInfo.radialLightWorldBounds.erase(mInfo.radialLightWorldBounds.end() - 1);
+				mInfo.radialLightCullInfos.removeLast();
 			}
 			else // Spot
 			{
@@ -225,14 +237,14 @@ namespace bs {	namespace ct
 				{
 					// Swap current last element with the one we want to erase
 					std::swap(mInfo.spotLights[lightId], mInfo.spotLights[lastLightId]);
-					std::swap(mInfo.spotLightWorldBounds[lightId], mInfo.spotLightWorldBounds[lastLightId]);
+					mInfo.spotLightCullInfos.swap(lightId, lastLightId);
 
 					lastLight->setRendererId(lightId);
 				}
 
 				// Last element is the one we want to erase
 				mInfo.spotLights.erase(mInfo.spotLights.end() - 1);
-				mInfo.spotLightWorldBounds.erase(mInfo.spotLightWorldBounds.end() - 1);
+				mInfo.spotLightCullInfos.removeLast();
 			}
 		}
 	}
@@ -243,8 +255,8 @@ namespace bs {	namespace ct
 
 		renderable->setRendererId(renderableId);
 
-		mInfo.renderables.push_back(bs_new<RendererRenderable>());
-		mInfo.renderableCullInfos.push_back(CullInfo(renderable->getBounds(), renderable->getLayer(), renderable->getCullDistanceFactor()));
+		mInfo.renderables.push_back(bs_new<RendererRenderable>(mParamBlockPool));
+		mInfo.renderableCullInfos.add(CullInfo(renderable->getBounds(), renderable->getLayer(), renderable->getCullDistanceFactor()));
 
 		RendererRenderable* rendererRenderable = mInfo.renderables.back();
 		rendererRenderable->renderable = renderable;
@@ -435,8 +447,8 @@ namespace bs {	namespace ct
 		UINT32 renderableId = renderable->getRendererId();
 
 		mInfo.renderables[renderableId]->updatePerObjectBuffer();
-		mInfo.renderableCullInfos[renderableId].bounds = renderable->getBounds();
-		mInfo.renderableCullInfos[renderableId].cullDistanceFactor = renderable->getCullDistanceFactor();
+		mInfo.renderableCullInfos.setBounds(renderableId, renderable->getBounds());
+		mInfo.renderableCullInfos.setCullDistanceFactor(renderableId, renderable->getCullDistanceFactor());
 	}
 
 	void RendererScene::unregisterRenderable(Renderable* renderable)
@@ -457,15 +469,17 @@ namespace bs {	namespace ct
 		{
 			// Swap current last element with the one we want to erase
 			std::swap(mInfo.renderables[renderableId], mInfo.renderables[lastRenderableId]);
-			std::swap(mInfo.renderableCullInfos[renderableId], mInfo.renderableCullInfos[lastRenderableId]);
+			mInfo.renderableCullInfos.swap(renderableId, lastRenderableId);
 
 			lastRenerable->setRendererId(renderableId);
 		}
 
 		// Last element is the one we want to erase
 		mInfo.renderables.erase(mInfo.renderables.end() - 1);
-		mInfo.renderableCullInfos.erase(mInfo.renderableCullInfos.end() - 1);
+		mInfo.renderableCullInfos.removeLast();
 
+		mParamBlockPool.free(rendererRenderable->perObjectParamBuffer);
+		mParamBlockPool.free(rendererRenderable->perCallParamBuffer);
 		bs_delete(rendererRenderable);
 	}
 
@@ -589,7 +603,7 @@ namespace bs {	namespace ct
 		particleSystem->setRendererId(rendererId);
 
 		mInfo.particleSystems.push_back(RendererParticles());
-		mInfo.particleSystemCullInfos.push_back(CullInfo(Bounds(), particleSystem->getLayer()));
+		mInfo.particleSystemCullInfos.add(CullInfo(Bounds(), particleSystem->getLayer()));
 
 		RendererParticles& rendererParticles = mInfo.particleSystems.back();
 		rendererParticles.particleSystem = particleSystem;
@@ -626,7 +640,10 @@ namespace bs {	namespace ct
 			return;
 		}
 
-		SPtr<GpuParamBlockBuffer> perObjectParamBuffer = gPerObjectParamDef.createBuffer();
+		if(rendererParticles.perObjectParamBuffer)
+			mParamBlockPool.free(rendererParticles.perObjectParamBuffer);
+
+		SPtr<GpuParamBlockBuffer> perObjectParamBuffer = gPerObjectParamDef.createBuffer(mParamBlockPool);
 		SPtr<GpuParamBlockBuffer> particlesParamBuffer = gParticlesParamDef.createBuffer();
 		PerObjectBuffer::update(perObjectParamBuffer, rendererParticles.localToWorld, localToWorldNoScale, layer);
 
@@ -909,6 +926,8 @@ namespace bs {	namespace ct
 			rendererParticles.gpuParticleSystem = nullptr;
 		}
 
+		mParamBlockPool.free(rendererParticles.perObjectParamBuffer);
+
 		ParticleSystem* lastSystem = mInfo.particleSystems.back().particleSystem;
 		const UINT32 lastRendererId = lastSystem->getRendererId();
 
@@ -916,14 +935,14 @@ namespace bs {	namespace ct
 		{
 			// Swap current last element with the one we want to erase
 			std::swap(mInfo.particleSystems[rendererId], mInfo.particleSystems[lastRendererId]);
-			std::swap(mInfo.particleSystemCullInfos[rendererId], mInfo.particleSystemCullInfos[lastRendererId]);
+			mInfo.particleSystemCullInfos.swap(rendererId, lastRendererId);
 
 			lastSystem->setRendererId(rendererId);
 		}
 
 		// Last element is the one we want to erase
 		mInfo.particleSystems.erase(mInfo.particleSystems.end() - 1);
-		mInfo.particleSystemCullInfos.erase(mInfo.particleSystemCullInfos.end() - 1);
+		mInfo.particleSystemCullInfos.removeLast();
 	}
 
 	void RendererScene::registerDecal(Decal* decal)
@@ -931,8 +950,8 @@ namespace bs {	namespace ct
 		const auto renderableId = (UINT32)mInfo.decals.size();
 		decal->setRendererId(renderableId);
 
-		mInfo.decals.emplace_back();
-		mInfo.decalCullInfos.push_back(CullInfo(decal->getBounds(), decal->getLayer()));
+		mInfo.decals.emplace_back(mParamBlockPool);
+		mInfo.decalCullInfos.add(CullInfo(decal->getBounds(), decal->getLayer()));
 
 		RendererDecal& rendererDecal = mInfo.decals.back();
 		rendererDecal.decal = decal;
@@ -1010,7 +1029,7 @@ namespace bs {	namespace ct
 		const UINT32 rendererId = decal->getRendererId();
 
 		mInfo.decals[rendererId].updatePerObjectBuffer();
-		mInfo.decalCullInfos[rendererId].bounds = decal->getBounds();
+		mInfo.decalCullInfos.setBounds(rendererId, decal->getBounds());
 	}
 
 	void RendererScene::unregisterDecal(Decal* decal)
@@ -1026,18 +1045,21 @@ namespace bs {	namespace ct
 		freeSamplerStateOverrides(renElement);
 		renElement.samplerOverrides = nullptr;
 
+		mParamBlockPool.free(rendererDecal.perObjectParamBuffer);
+		mParamBlockPool.free(rendererDecal.perCallParamBuffer);
+
 		if (rendererId != lastDecalId)
 		{
 			// Swap current last element with the one we want to erase
 			std::swap(mInfo.decals[rendererId], mInfo.decals[lastDecalId]);
-			std::swap(mInfo.decalCullInfos[rendererId], mInfo.decalCullInfos[lastDecalId]);
+			mInfo.decalCullInfos.swap(rendererId, lastDecalId);
 
 			lastDecal->setRendererId(rendererId);
 		}
 
 		// Last element is the one we want to erase
 		mInfo.decals.erase(mInfo.decals.end() - 1);
-		mInfo.decalCullInfos.erase(mInfo.decalCullInfos.end() - 1);
+		mInfo.decalCullInfos.removeLast();
 	}
 
 	void RendererScene::setOptions(const SPtr<RenderBeastOptions>& options)
@@ -1046,6 +1068,19 @@ namespace bs {	namespace ct
 
 		for (auto& entry : mInfo.views)
 			entry->setStateReductionMode(mOptions->stateReductionMode);
+
+		updateSpatialIndex();
+	}
+
+	void RendererScene::updateSpatialIndex()
+	{
+		// Note: Particle systems are excluded since their bounds change every frame
+		const bool enabled = mOptions->spatialIndex;
+
+		mInfo.renderableCullInfos.setSpatialIndexEnabled(enabled);
+		mInfo.radialLightCullInfos.setSpatialIndexEnabled(enabled);
+		mInfo.spotLightCullInfos.setSpatialIndexEnabled(enabled);
+		mInfo.decalCullInfos.setSpatialIndexEnabled(enabled);
 	}
 
 	RENDERER_VIEW_DESC RendererScene::createViewDesc(Camera* camera) const
@@ -1329,7 +1364,7 @@ namespace bs {	namespace ct
 				worldAABox.transformAffine(entry.localToWorld);
 
 			const Sphere worldSphere(worldAABox.getCenter(), worldAABox.getRadius());
-			mInfo.particleSystemCullInfos[rendererId].bounds = Bounds(worldAABox, worldSphere);
+			mInfo.particleSystemCullInfos.setBounds(rendererId, Bounds(worldAABox, worldSphere));
 		}
 	}
 
@@ -37,14 +37,14 @@ namespace bs
 		
 		// Renderables
 		Vector<RendererRenderable*> renderables;
-		Vector<CullInfo> renderableCullInfos;
+		CullBuffer renderableCullInfos;
 
 		// Lights
 		Vector<RendererLight> directionalLights;
 		Vector<RendererLight> radialLights;
 		Vector<RendererLight> spotLights;
-		Vector<Sphere> radialLightWorldBounds;
-		Vector<Sphere> spotLightWorldBounds;
+		CullBuffer radialLightCullInfos;
+		CullBuffer spotLightCullInfos;
 
 		// Reflection probes
 		Vector<RendererReflectionProbe> reflProbes;
@@ -57,11 +57,11 @@ namespace bs
 
 		// Particles
 		Vector<RendererParticles> particleSystems;
-		Vector<CullInfo> particleSystemCullInfos;
+		CullBuffer particleSystemCullInfos;
 
 		// Decals
 		Vector<RendererDecal> decals;
-		Vector<CullInfo> decalCullInfos;
+		CullBuffer decalCullInfos;
 
 		// Sky
 		Skybox* skybox = nullptr;
@@ -225,8 +225,12 @@ namespace bs
 		/** Frees sampler state overrides previously allocated with allocSamplerStateOverrides(). */
 		void freeSamplerStateOverrides(RenderElement& elem);
 
+		/** Enables or disables the spatial index on the relevant cull buffers, according to the current options. */
+		void updateSpatialIndex();
+
 		SceneInfo mInfo;
 		SPtr<GpuParamBlockBuffer> mPerFrameParamBuffer;
+		GpuParamBlockBufferPool mParamBlockPool;
 		UnorderedMap<SamplerOverrideKey, MaterialSamplerOverrides*> mSamplerOverrides;
 
 		SPtr<RenderBeastOptions> mOptions;
@@ -11,6 +11,7 @@
 #include "BsRendererScene.h"
 #include "BsRenderBeast.h"
 #include <BsRendererDecal.h>
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs { namespace ct
 {
@@ -179,11 +180,10 @@ namespace bs { namespace ct
 		mDecalQueue->clear();
 	}
 
-	void RendererView::determineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-		Vector<bool>* visibility)
+	void RendererView::determineVisible(const Vector<RendererRenderable*>& renderables, const CullBuffer& cullInfos,
+		VisibilityMask* visibility)
 	{
-		mVisibility.renderables.clear();
-		mVisibility.renderables.resize(renderables.size(), false);
+		mVisibility.renderables.reset((UINT32)renderables.size());
 
 		if (mRenderSettings->overlayOnly)
 			return;
@@ -191,21 +191,13 @@ namespace bs { namespace ct
 		calculateVisibility(cullInfos, mVisibility.renderables);
 
 		if(visibility != nullptr)
-		{
-			for (UINT32 i = 0; i < (UINT32)renderables.size(); i++)
-			{
-				bool visible = (*visibility)[i];
-
-				(*visibility)[i] = visible || mVisibility.renderables[i];
-			}
-		}
+			visibility->merge(mVisibility.renderables);
 	}
 
-	void RendererView::determineVisible(const Vector<RendererParticles>& particleSystems, const Vector<CullInfo>& cullInfos,
-		Vector<bool>* visibility)
+	void RendererView::determineVisible(const Vector<RendererParticles>& particleSystems, const CullBuffer& cullInfos,
+		VisibilityMask* visibility)
 	{
-		mVisibility.particleSystems.clear();
-		mVisibility.particleSystems.resize(particleSystems.size(), false);
+		mVisibility.particleSystems.reset((UINT32)particleSystems.size());
 
 		if (mRenderSettings->overlayOnly)
 			return;
@@ -213,21 +205,13 @@ namespace bs { namespace ct
 		calculateVisibility(cullInfos, mVisibility.particleSystems);
 
 		if(visibility != nullptr)
-		{
-			for (UINT32 i = 0; i < (UINT32)particleSystems.size(); i++)
-			{
-				bool visible = (*visibility)[i];
-
-				(*visibility)[i] = visible || mVisibility.particleSystems[i];
-			}
-		}
+			visibility->merge(mVisibility.particleSystems);
 	}
 
-	void RendererView::determineVisible(const Vector<RendererDecal>& decals, const Vector<CullInfo>& cullInfos,
-		Vector<bool>* visibility)
+	void RendererView::determineVisible(const Vector<RendererDecal>& decals, const CullBuffer& cullInfos,
+		VisibilityMask* visibility)
 	{
-		mVisibility.decals.clear();
-		mVisibility.decals.resize(decals.size(), false);
+		mVisibility.decals.reset((UINT32)decals.size());
 
 		if (mRenderSettings->overlayOnly)
 			return;
@@ -235,95 +219,73 @@ namespace bs { namespace ct
 		calculateVisibility(cullInfos, mVisibility.decals);
 
 		if(visibility != nullptr)
-		{
-			for (UINT32 i = 0; i < (UINT32)decals.size(); i++)
-			{
-				bool visible = (*visibility)[i];
-
-				(*visibility)[i] = visible || mVisibility.decals[i];
-			}
-		}
+			visibility->merge(mVisibility.decals);
 	}
 
-	void RendererView::determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds,
-		LightType lightType, Vector<bool>* visibility)
+	void RendererView::determineVisible(const Vector<RendererLight>& lights, const CullBuffer& cullInfos,
+		LightType lightType, VisibilityMask* visibility)
 	{
 		// Special case for directional lights, they're always visible
 		if(lightType == LightType::Directional)
 		{
 			if (visibility)
-				visibility->assign(lights.size(), true);
+				visibility->reset((UINT32)lights.size(), true);
 
 			return;
 		}
 
-		Vector<bool>* perViewVisibility;
+		VisibilityMask* perViewVisibility;
 		if(lightType == LightType::Radial)
-		{
-			mVisibility.radialLights.clear();
-			mVisibility.radialLights.resize(lights.size(), false);
-
 			perViewVisibility = &mVisibility.radialLights;
-		}
 		else // Spot
-		{
-			mVisibility.spotLights.clear();
-			mVisibility.spotLights.resize(lights.size(), false);
-
 			perViewVisibility = &mVisibility.spotLights;
-		}
+
+		perViewVisibility->reset((UINT32)lights.size());
 
 		if (mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(bounds, *perViewVisibility);
+		calculateVisibility(cullInfos, *perViewVisibility);
 
 		if(visibility != nullptr)
-		{
-			for (UINT32 i = 0; i < (UINT32)lights.size(); i++)
-			{
-				bool visible = (*visibility)[i];
-
-				(*visibility)[i] = visible || (*perViewVisibility)[i];
-			}
-		}
+			visibility->merge(*perViewVisibility);
 	}
 
-	void RendererView::calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const
+	void RendererView::calculateVisibility(const CullBuffer& cullInfos, VisibilityMask& visibility) const
 	{
-		UINT64 cameraLayers = mProperties.visibleLayers;
-		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
-		const Vector3& worldCameraPosition = mProperties.viewOrigin;
-		float baseCullDistance = mRenderSettings->cullDistance;
+		// Number of objects culled by a single task. Must be a multiple of 64 so tasks never share a mask word.
+		static constexpr UINT32 OBJECTS_PER_TASK = 2048;
 
-		for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
-		{
-			if ((cullInfos[i].layer & cameraLayers) == 0)
-				continue;
+		CullView cullView;
+		cullView.planes = mProperties.cullFrustum.getPlanes();
+		cullView.origin = mProperties.viewOrigin;
+		cullView.cullDistance = mRenderSettings->cullDistance;
+		cullView.layers = mProperties.visibleLayers;
 
-			// Do distance culling
-			const Sphere& boundingSphere = cullInfos[i].bounds.getSphere();
-			const Vector3& worldRenderablePosition = boundingSphere.getCenter();
+		const UINT32 numObjects = cullInfos.size();
+		UINT64* words = visibility.getWords();
 
-			float distanceToCameraSq = worldCameraPosition.squaredDistance(worldRenderablePosition);
-			float correctedCullDistance = cullInfos[i].cullDistanceFactor * baseCullDistance;
-			float maxDistanceToCamera = correctedCullDistance + boundingSphere.getRadius();
+		if(cullInfos.isSpatialIndexEnabled())
+		{
+			cullInfos.cullHierarchical(cullView, words);
+			return;
+		}
 
-			if (distanceToCameraSq > maxDistanceToCamera * maxDistanceToCamera)
-				continue;
+		if(numObjects <= OBJECTS_PER_TASK)
+		{
+			cullInfos.cull(cullView, 0, numObjects, words);
+			return;
+		}
 
-			// Do frustum culling
-			// Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-			// operations, as it is trivial to update them. Also consider spatial partitioning.
-			if (worldFrustum.intersects(boundingSphere))
-			{
-				// More precise with the box
-				const AABox& boundingBox = cullInfos[i].bounds.getBox();
+		const UINT32 numBatches = Math::divideAndRoundUp(numObjects, OBJECTS_PER_TASK);
+		TaskScheduler::instance().parallelFor("Culling", numBatches, 1,
+			[&cullInfos, &cullView, numObjects, words](UINT32 start, UINT32 end)
+		{
+			const UINT32 first = start * OBJECTS_PER_TASK;
+			const UINT32 last = std::min(end * OBJECTS_PER_TASK, numObjects);
 
-				if (worldFrustum.intersects(boundingBox))
-					visibility[i] = true;
-			}
-		}
+			cullInfos.cull(cullView, first, last, words + first / 64);
+		});
 	}
 
 	void RendererView::calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const
@@ -692,14 +654,9 @@ namespace bs { namespace ct
 			return;
 
 		// Calculate renderable visibility per view
-		mVisibility.renderables.resize(sceneInfo.renderables.size(), false);
-		mVisibility.renderables.assign(sceneInfo.renderables.size(), false);
-
-		mVisibility.particleSystems.resize(sceneInfo.particleSystems.size(), false);
-		mVisibility.particleSystems.assign(sceneInfo.particleSystems.size(), false);
-
-		mVisibility.decals.resize(sceneInfo.decals.size(), false);
-		mVisibility.decals.assign(sceneInfo.decals.size(), false);
+		mVisibility.renderables.reset((UINT32)sceneInfo.renderables.size());
+		mVisibility.particleSystems.reset((UINT32)sceneInfo.particleSystems.size());
+		mVisibility.decals.reset((UINT32)sceneInfo.decals.size());
 
 		for(UINT32 i = 0; i < numViews; i++)
 		{
@@ -713,23 +670,18 @@ namespace bs { namespace ct
 			mViews[i]->queueRenderElements(sceneInfo);
 
 		// Calculate light visibility for all views
-		const auto numRadialLights = (UINT32)sceneInfo.radialLights.size();
-		mVisibility.radialLights.resize(numRadialLights, false);
-		mVisibility.radialLights.assign(numRadialLights, false);
-
-		const auto numSpotLights = (UINT32)sceneInfo.spotLights.size();
-		mVisibility.spotLights.resize(numSpotLights, false);
-		mVisibility.spotLights.assign(numSpotLights, false);
+		mVisibility.radialLights.reset((UINT32)sceneInfo.radialLights.size());
+		mVisibility.spotLights.reset((UINT32)sceneInfo.spotLights.size());
 
 		for (UINT32 i = 0; i < numViews; i++)
 		{
 			if (mViews[i]->getRenderSettings().overlayOnly)
 				continue;
 
-			mViews[i]->determineVisible(sceneInfo.radialLights, sceneInfo.radialLightWorldBounds, LightType::Radial,
+			mViews[i]->determineVisible(sceneInfo.radialLights, sceneInfo.radialLightCullInfos, LightType::Radial,
 				&mVisibility.radialLights);
 
-			mViews[i]->determineVisible(sceneInfo.spotLights, sceneInfo.spotLightWorldBounds, LightType::Spot,
+			mViews[i]->determineVisible(sceneInfo.spotLights, sceneInfo.spotLightCullInfos, LightType::Spot,
 				&mVisibility.spotLights);
 		}
 
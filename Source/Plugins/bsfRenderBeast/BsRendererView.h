@@ -8,6 +8,7 @@
 #include "Renderer/BsRenderSettings.h"
 #include "Math/BsBounds.h"
 #include "Math/BsConvexVolume.h"
+#include "BsCullBuffer.h"
 #include "Shading/BsLightGrid.h"
 #include "Shading/BsShadowRendering.h"
 #include "BsRendererView.h"
@@ -190,24 +191,12 @@ namespace bs { namespace ct
 	/** Information whether certain scene objects are visible in a view, per object type. */
 	struct VisibilityInfo
 	{
-		Vector<bool> renderables;
-		Vector<bool> radialLights;
-		Vector<bool> spotLights;
+		VisibilityMask renderables;
+		VisibilityMask radialLights;
+		VisibilityMask spotLights;
 		Vector<bool> reflProbes;
-		Vector<bool> particleSystems;
-		Vector<bool> decals;
-	};
-
-	/** Information used for culling an object against a view. */
-	struct CullInfo
-	{
-		CullInfo(const Bounds& bounds, UINT64 layer = -1, float cullDistanceFactor = 1.0f)
-			:layer(layer), bounds(bounds), cullDistanceFactor(cullDistanceFactor)
-		{ }
-
-		UINT64 layer;
-		Bounds bounds;
-		float cullDistanceFactor;
+		VisibilityMask particleSystems;
+		VisibilityMask decals;
 	};
 
 	/**	Renderer information specific to a single render target. */
@@ -286,8 +275,8 @@ namespace bs { namespace ct
 		 *									As a side-effect, per-view visibility data is also calculated and can be
 		 *									retrieved by calling getVisibilityMask().
 		 */
-		void determineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+		void determineVisible(const Vector<RendererRenderable*>& renderables, const CullBuffer& cullInfos,
+			VisibilityMask* visibility = nullptr);
 
 		/**
 		 * Populates view render queues by determining visible particle systems.
@@ -303,8 +292,8 @@ namespace bs { namespace ct
 		 *									As a side-effect, per-view visibility data is also calculated and can be
 		 *									retrieved by calling getVisibilityMask().
 		 */
-		void determineVisible(const Vector<RendererParticles>& particleSystems, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+		void determineVisible(const Vector<RendererParticles>& particleSystems, const CullBuffer& cullInfos,
+			VisibilityMask* visibility = nullptr);
 
 		/**
 		 * Populates view render queues by determining visible decals.
@@ -320,15 +309,15 @@ namespace bs { namespace ct
 		 *									As a side-effect, per-view visibility data is also calculated and can be
 		 *									retrieved by calling getVisibilityMask().
 		 */
-		void determineVisible(const Vector<RendererDecal>& decals, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+		void determineVisible(const Vector<RendererDecal>& decals, const CullBuffer& cullInfos,
+			VisibilityMask* visibility = nullptr);
 
 		/**
 		 * Calculates the visibility masks for all the lights of the provided type.
 		 *
 		 * @param[in]	lights				A set of lights to determine visibility for.
-		 * @param[in]	bounds				Bounding sphere for each provided light. Must be the same size as the @p lights
-		 *									array.
+		 * @param[in]	cullInfos			Culling information for each provided light. Must be the same size as the
+		 *									@p lights array.
 		 * @param[in]	type				Type of all the lights in the @p lights array.
 		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible light. If the
 		 *									bit for a light is already set to true, the method will never change it to false
@@ -338,14 +327,16 @@ namespace bs { namespace ct
 		 *									As a side-effect, per-view visibility data is also calculated and can be
 		 *									retrieved by calling getVisibilityMask().
 		 */
-		void determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, LightType type,
-			Vector<bool>* visibility = nullptr);
+		void determineVisible(const Vector<RendererLight>& lights, const CullBuffer& cullInfos, LightType type,
+			VisibilityMask* visibility = nullptr);
 
 		/**
-		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
+		 * Culls the provided set of objects against the current frustum, cull distance and visible layers, and outputs a
+		 * mask determining which object is or isn't visible by this view. The mask must be of the same size as the cull
+		 * buffer. If the cull buffer has a spatial index it is used for rejecting whole groups of objects, otherwise
+		 * large sets of objects are culled in parallel using the task scheduler.
 		 */
-		void calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const;
+		void calculateVisibility(const CullBuffer& cullInfos, VisibilityMask& visibility) const;
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
@@ -12,6 +12,7 @@ set(BS_RENDERBEAST_INC_NOFILTER
 	"BsRendererScene.h"
 	"BsRenderCompositor.h"
 	"BsRenderBeastIBLUtility.h"
+	"BsCullBuffer.h"
 )
 
 set(BS_RENDERBEAST_SRC_NOFILTER
@@ -28,6 +29,7 @@ set(BS_RENDERBEAST_SRC_NOFILTER
 	"BsRendererScene.cpp"
 	"BsRenderCompositor.cpp"
 	"BsRenderBeastIBLUtility.cpp"
+	"BsCullBuffer.cpp"
 )
 
 set(BS_RENDERBEAST_INC_SHADING
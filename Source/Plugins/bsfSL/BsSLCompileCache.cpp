@@ -0,0 +1,205 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsSLCompileCache.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Utility/BsUtil.h"
+
+namespace bs
+{
+	/** Identifies a file as a cache entry. */
+	static constexpr UINT32 CACHE_MAGIC = 0x434C5342; // "BSLC"
+
+	/**
+	 * Version of the cache entries. Increment when the entry layout or the cross-compilation changes in a way that
+	 * makes existing entries invalid (e.g. when updating XShaderCompiler).
+	 */
+	static constexpr UINT32 CACHE_VERSION = 2;
+
+	/** Extension of the files storing the cache entries. */
+	static constexpr const char* ENTRY_EXTENSION = ".bslc";
+
+	/** Header written at the start of every cache entry, followed by the program code. */
+	struct CacheEntryHeader
+	{
+		UINT32 magic;
+		UINT32 version;
+		UINT32 nextBindingSlot;
+		UINT32 codeSize;
+
+		/** MD5 of the entry key and the program code, to detect entries that are corrupt or stored under a wrong key. */
+		char checksum[32];
+	};
+
+	/** Calculates the checksum stored in the entry header. */
+	static String getChecksum(const String& key, const String& code)
+	{
+		return md5(key + code);
+	}
+
+	BSLCompileCache::BSLCompileCache(Path folder, UINT64 maxSize)
+		:mFolder(std::move(folder)), mMaxSize(maxSize)
+	{
+		if(!mFolder.isEmpty() && !FileSystem::exists(mFolder))
+			FileSystem::createDir(mFolder);
+	}
+
+	String BSLCompileCache::getKey(const String& source, const String& options)
+	{
+		StringStream stream;
+		stream << CACHE_VERSION << "\n" << options << "\n" << source;
+
+		return md5(stream.str());
+	}
+
+	bool BSLCompileCache::find(const String& key, Entry& entry) const
+	{
+		if(!isEnabled())
+			return false;
+
+		const Path path = getEntryPath(key);
+		{
+			Lock fileLock = FileScheduler::getLock(path);
+			if(!FileSystem::isFile(path))
+				return false;
+
+			SPtr<DataStream> stream = FileSystem::openFile(path);
+			if(!stream)
+				return false;
+
+			CacheEntryHeader header;
+			if(stream->read(&header, sizeof(header)) != sizeof(header))
+				return false;
+
+			if(header.magic != CACHE_MAGIC || header.version != CACHE_VERSION ||
+				stream->size() != sizeof(header) + header.codeSize)
+				return false;
+
+			String code;
+			code.resize(header.codeSize);
+
+			if(header.codeSize > 0 && stream->read(&code[0], header.codeSize) != header.codeSize)
+				return false;
+
+			const String checksum = getChecksum(key, code);
+			if(checksum.size() != sizeof(header.checksum) ||
+				memcmp(checksum.data(), header.checksum, sizeof(header.checksum)) != 0)
+				return false;
+
+			entry.code = std::move(code);
+			entry.nextBindingSlot = header.nextBindingSlot;
+		}
+
+		markUsed(key);
+		return true;
+	}
+
+	void BSLCompileCache::add(const String& key, const Entry& entry) const
+	{
+		if(!isEnabled())
+			return;
+
+		const String checksum = getChecksum(key, entry.code);
+
+		CacheEntryHeader header;
+		header.magic = CACHE_MAGIC;
+		header.version = CACHE_VERSION;
+		header.nextBindingSlot = entry.nextBindingSlot;
+		header.codeSize = (UINT32)entry.code.size();
+
+		assert(checksum.size() == sizeof(header.checksum));
+		memcpy(header.checksum, checksum.data(), sizeof(header.checksum));
+
+		const Path path = getEntryPath(key);
+		{
+			Lock fileLock = FileScheduler::getLock(path);
+
+			SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+			if(!stream)
+				return;
+
+			stream->write(&header, sizeof(header));
+			stream->write(entry.code.data(), entry.code.size());
+		}
+
+		markUsed(key);
+	}
+
+	void BSLCompileCache::trim() const
+	{
+		if(!isEnabled() || !FileSystem::isDirectory(mFolder))
+			return;
+
+		struct FileInfo
+		{
+			Path path;
+			UINT64 size;
+			std::time_t lastModified;
+			bool isUsed;
+		};
+
+		Vector<FileInfo> files;
+		UINT64 totalSize = 0;
+		{
+			Lock lock(mMutex);
+
+			const auto addFile = [this, &files, &totalSize](const Path& path)
+			{
+				if(path.getExtension() != ENTRY_EXTENSION)
+					return true;
+
+				FileInfo info;
+				info.path = path;
+				info.size = FileSystem::getFileSize(path);
+				info.lastModified = FileSystem::getLastModifiedTime(path);
+				info.isUsed = mUsedKeys.find(path.getFilename(false)) != mUsedKeys.end();
+
+				files.push_back(info);
+				totalSize += info.size;
+
+				return true;
+			};
+
+			FileSystem::iterate(mFolder, addFile, nullptr, false);
+		}
+
+		if(totalSize <= mMaxSize)
+			return;
+
+		// Remove the least recently used entries first. Entries used by this object are more recent than any others.
+		std::sort(files.begin(), files.end(), [](const FileInfo& a, const FileInfo& b)
+		{
+			if(a.isUsed != b.isUsed)
+				return !a.isUsed;
+
+			return a.lastModified < b.lastModified;
+		});
+
+		for(auto& entry : files)
+		{
+			if(totalSize <= mMaxSize)
+				break;
+
+			Lock fileLock = FileScheduler::getLock(entry.path);
+			FileSystem::remove(entry.path, false);
+
+			totalSize -= entry.size;
+		}
+	}
+
+	Path BSLCompileCache::getDefaultFolder()
+	{
+		return FileSystem::getCacheDirectoryPath() + Path("bsf/ShaderCache/");
+	}
+
+	Path BSLCompileCache::getEntryPath(const String& key) const
+	{
+		return mFolder + Path(key + ENTRY_EXTENSION);
+	}
+
+	void BSLCompileCache::markUsed(const String& key) const
+	{
+		Lock lock(mMutex);
+		mUsedKeys.insert(key);
+	}
+}
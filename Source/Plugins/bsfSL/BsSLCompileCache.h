@@ -0,0 +1,86 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsSLPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup bsfSL
+	 *  @{
+	 */
+
+	/**
+	 * Persistent cache of GPU program code cross-compiled from BSL, stored as one file per entry in a folder on disk.
+	 * Entries are keyed by a hash of the program source and the compilation options, so unchanged programs don't need
+	 * to be compiled again when shaders are re-imported. Can be used from multiple threads.
+	 */
+	class BSLCompileCache
+	{
+	public:
+		/** Output of a single compilation stored in the cache. */
+		struct Entry
+		{
+			String code;
+			UINT32 nextBindingSlot = 0;
+		};
+
+		/** Size of the cache folder, in bytes, above which the oldest entries get removed by trim(). */
+		static constexpr UINT64 DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+		/** Creates a disabled cache, that never finds any entries and ignores new ones. */
+		BSLCompileCache() = default;
+
+		/**
+		 * Creates a cache that stores its entries in the provided folder. The folder is created if it doesn't exist. If
+		 * the path is empty the cache is disabled.
+		 *
+		 * @param[in]	folder		Folder to store the entries in. Should not be shared with other users, as entries
+		 *							are trusted if they are well formed.
+		 * @param[in]	maxSize		Size of all entries in the folder, in bytes, that trim() will reduce the cache to.
+		 */
+		explicit BSLCompileCache(Path folder, UINT64 maxSize = DEFAULT_MAX_SIZE);
+
+		/**
+		 * Generates a key identifying the compilation of @p source. @p options must contain everything else that
+		 * affects the compilation output.
+		 */
+		static String getKey(const String& source, const String& options);
+
+		/**
+		 * Looks up a previously stored entry. Returns false if no entry with the provided key exists, or if the entry is
+		 * outdated, truncated or otherwise corrupt.
+		 */
+		bool find(const String& key, Entry& entry) const;
+
+		/** Stores a new entry, replacing an existing entry with the same key. */
+		void add(const String& key, const Entry& entry) const;
+
+		/**
+		 * Removes entries until the size of the cache is below the maximum size. Entries that weren't found or added
+		 * through this object are removed first, oldest first.
+		 */
+		void trim() const;
+
+		/** Checks if the cache stores and looks up entries. */
+		bool isEnabled() const { return !mFolder.isEmpty(); }
+
+		/** Returns the folder used for the cache by default, within a per-user cache folder. */
+		static Path getDefaultFolder();
+
+	private:
+		/** Returns the file storing the entry with the provided key. */
+		Path getEntryPath(const String& key) const;
+
+		/** Registers an entry as used, so trim() prefers keeping it over other entries. */
+		void markUsed(const String& key) const;
+
+		Path mFolder;
+		UINT64 mMaxSize = DEFAULT_MAX_SIZE;
+
+		mutable UnorderedSet<String> mUsedKeys;
+		mutable Mutex mMutex;
+	};
+
+	/** @} */
+}
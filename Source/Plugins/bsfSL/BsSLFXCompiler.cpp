@@ -18,6 +18,8 @@
 #include "Renderer/BsRendererManager.h"
 #include "FileSystem/BsFileSystem.h"
 #include "FileSystem/BsDataStream.h"
+#include "Threading/BsTaskScheduler.h"
+#include "BsSLCompileCache.h"
 
 #define XSC_ENABLE_LANGUAGE_EXT 1
 #include "Xsc/Xsc.h"
@@ -625,7 +627,8 @@ namespace bs
 	};
 
 	String crossCompile(const String& hlsl, GpuProgramType type, CrossCompileOutput outputType, bool optionalEntry,
-		UINT32& startBindingSlot, SHADER_DESC* shaderDesc = nullptr, Vector<GpuProgramType>* detectedTypes = nullptr)
+		UINT32& startBindingSlot, Xsc::Reflection::ReflectionData* outReflection = nullptr,
+		Vector<GpuProgramType>* detectedTypes = nullptr)
 	{
 		SPtr<StringStream> input = bs_shared_ptr_new<StringStream>();
 
@@ -783,31 +786,59 @@ namespace bs
 			}
 		}
 
-		if (shaderDesc != nullptr)
-			parseParameters(reflectionData, *shaderDesc);
+		if (outReflection != nullptr)
+			*outReflection = reflectionData;
 
 		return output.str();
 	}
 
-	String crossCompile(const String& hlsl, GpuProgramType type, CrossCompileOutput outputType, UINT32& startBindingSlot)
+	String crossCompile(const String& hlsl, GpuProgramType type, CrossCompileOutput outputType, UINT32& startBindingSlot,
+		const BSLCompileCache& cache)
 	{
-		return crossCompile(hlsl, type, outputType, false, startBindingSlot);
+		// Code blocks start with the defines they were parsed with, so the source also identifies the variation
+		const String options = toString((UINT32)type) + "," + toString((UINT32)outputType) + "," +
+			toString(startBindingSlot);
+		const String key = BSLCompileCache::getKey(hlsl, options);
+
+		BSLCompileCache::Entry entry;
+		if (cache.find(key, entry))
+		{
+			startBindingSlot = entry.nextBindingSlot;
+			return entry.code;
+		}
+
+		entry.code = crossCompile(hlsl, type, outputType, false, startBindingSlot);
+		entry.nextBindingSlot = startBindingSlot;
+
+		// Failed compilations aren't cached, so their errors get reported on every import
+		if (!entry.code.empty())
+			cache.add(key, entry);
+
+		return entry.code;
 	}
 
-	void reflectHLSL(const String& hlsl, SHADER_DESC& shaderDesc, Vector<GpuProgramType>& entryPoints)
+	void reflectHLSL(const String& hlsl, Xsc::Reflection::ReflectionData& reflection,
+		Vector<GpuProgramType>& entryPoints)
 	{
 		UINT32 dummy = 0;
-		crossCompile(hlsl, GPT_VERTEX_PROGRAM, CrossCompileOutput::GLSL45, true, dummy, &shaderDesc, &entryPoints);
+		crossCompile(hlsl, GPT_VERTEX_PROGRAM, CrossCompileOutput::GLSL45, true, dummy, &reflection, &entryPoints);
 	}
 
 	BSLFXCompileResult BSLFXCompiler::compile(const String& name, const String& source,
 		const UnorderedMap<String, String>& defines, ShadingLanguageFlags languages)
+	{
+		return compile(name, source, defines, languages, BSLCompileCache());
+	}
+
+	BSLFXCompileResult BSLFXCompiler::compile(const String& name, const String& source,
+		const UnorderedMap<String, String>& defines, ShadingLanguageFlags languages, const BSLCompileCache& cache,
+		bool parallel)
 	{
 		// Parse global shader options & shader meta-data
 		SHADER_DESC shaderDesc;
 		Vector<String> includes;
 
-		BSLFXCompileResult output = compileShader(source, defines, languages, shaderDesc, includes);
+		BSLFXCompileResult output = compileShader(source, defines, languages, cache, parallel, shaderDesc, includes);
 
 		// Generate a shader from the parsed information
 		output.shader = Shader::_createPtr(name, shaderDesc);
@@ -1850,13 +1881,14 @@ cleanup:
 
 	BSLFXCompileResult BSLFXCompiler::compileTechniques(
 		const Vector<std::pair<ASTFXNode*, ShaderMetaData>>& shaderMetaData, const String& source,
-		const UnorderedMap<String, String>& defines, ShadingLanguageFlags languages, SHADER_DESC& shaderDesc,
-		Vector<String>& includes)
+		const UnorderedMap<String, String>& defines, ShadingLanguageFlags languages, const BSLCompileCache& cache,
+		bool parallel, SHADER_DESC& shaderDesc, Vector<String>& includes)
 	{
 		BSLFXCompileResult output;
 
 		// Build a list of different variations and re-parse the source using the relevant defines
 		UnorderedSet<String> includeSet;
+		Vector<VariationCompileData> compileData;
 		for (auto& entry : shaderMetaData)
 		{
 			const ShaderMetaData& metaData = entry.second;
@@ -1966,15 +1998,38 @@ cleanup:
 						rawCode = rawCode->next;
 					}
 
-					output = compileTechniques(variationParseState, entry.second.name, codeBlocks, variation, languages,
-						includeSet, shaderDesc);
+					VariationCompileData data;
+					data.variation = variation;
+
+					output = parseVariation(variationParseState, entry.second.name, codeBlocks, includeSet,
+						data.parsedShaders);
 
 					if (!output.errorMessage.empty())
 						return output;
+
+					compileData.push_back(std::move(data));
 				}
 			}
 		}
 
+		// Cross-compile the variations in parallel, as it takes most of the time for shaders with many variations
+		const auto compileVariations = [&compileData, languages, &cache](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+				compileVariation(compileData[i], languages, cache);
+		};
+
+		const auto numVariations = (UINT32)compileData.size();
+		if (parallel && numVariations > 1 && TaskScheduler::isStarted())
+			TaskScheduler::instance().parallelFor("BSL variation compilation", numVariations, 1, compileVariations);
+		else
+			compileVariations(0, numVariations);
+
+		// Parameters and techniques are registered in variation order, so the result doesn't depend on the order in
+		// which the variations finished compiling
+		for (auto& entry : compileData)
+			createTechniques(entry, shaderDesc);
+
 		// Generate a shader from the parsed techniques
 		for (auto& entry : includeSet)
 			includes.push_back(entry);
@@ -2035,7 +2090,8 @@ cleanup:
 	}
 
 	BSLFXCompileResult BSLFXCompiler::compileShader(String source, const UnorderedMap<String, String>& defines,
-		ShadingLanguageFlags languages, SHADER_DESC& shaderDesc, Vector<String>& includes)
+		ShadingLanguageFlags languages, const BSLCompileCache& cache, bool parallel, SHADER_DESC& shaderDesc,
+		Vector<String>& includes)
 	{
 		SPtr<ct::Renderer> renderer = RendererManager::instance().getActive();
 
@@ -2089,7 +2145,7 @@ cleanup:
 			populateVariationParamInfos(entry.second, shaderDesc);
 		}
 
-		output = compileTechniques(shaderMetaData, source, defines, languages, shaderDesc, includes);
+		output = compileTechniques(shaderMetaData, source, defines, languages, cache, parallel, shaderDesc, includes);
 
 		if (!output.errorMessage.empty())
 			return output;
@@ -2125,7 +2181,7 @@ cleanup:
 				SHADER_DESC subShaderDesc;
 				Vector<String> subShaderIncludes;
 				BSLFXCompileResult subShaderOutput = compileShader(subShaderSource.str(), subShaderDefines, languages,
-					subShaderDesc, subShaderIncludes);
+					cache, parallel, subShaderDesc, subShaderIncludes);
 
 				if (!subShaderOutput.errorMessage.empty())
 					return subShaderOutput;
@@ -2146,9 +2202,8 @@ cleanup:
 		return output;
 	}
 
-	BSLFXCompileResult BSLFXCompiler::compileTechniques(ParseState* parseState, const String& name,
-		const Vector<String>& codeBlocks, const ShaderVariation& variation, ShadingLanguageFlags languages,
-		UnorderedSet<String>& includes, SHADER_DESC& shaderDesc)
+	BSLFXCompileResult BSLFXCompiler::parseVariation(ParseState* parseState, const String& name,
+		const Vector<String>& codeBlocks, UnorderedSet<String>& includes, Vector<ShaderData>& shaders)
 	{
 		BSLFXCompileResult output;
 
@@ -2276,19 +2331,23 @@ cleanup:
 
 		parseStateDelete(parseState);
 
-		// Parse extended HLSL code and generate per-program code, also convert to GLSL/VKSL/MSL
-		const auto end = (UINT32)shaderData.size();
-		Vector<pair<ASTFXNode*, ShaderData>> outputShaderData;
-		for(UINT32 i = 0; i < end; i++)
+		for (auto& entry : shaderData)
 		{
-			const ShaderMetaData& metaData = shaderData[i].second.metaData;
-			if (metaData.isMixin)
-				continue;
+			if (!entry.second.metaData.isMixin)
+				shaders.push_back(std::move(entry.second));
+		}
 
-			ShaderData& shaderDataEntry = shaderData[i].second;
+		return output;
+	}
 
-			ShaderData hlslShaderData = shaderData[i].second;
-			ShaderData glslShaderData = shaderData[i].second;
+	void BSLFXCompiler::compileVariation(VariationCompileData& data, ShadingLanguageFlags languages,
+		const BSLCompileCache& cache)
+	{
+		// Parse extended HLSL code and generate per-program code, also convert to GLSL/VKSL/MSL
+		for (auto& shaderDataEntry : data.parsedShaders)
+		{
+			ShaderData hlslShaderData = shaderDataEntry;
+			ShaderData glslShaderData = shaderDataEntry;
 
 			// When working with OpenGL, lower-end feature sets are supported. For other backends, high-end is always assumed.
 			CrossCompileOutput glslVersion = CrossCompileOutput::GLSL41;
@@ -2300,10 +2359,10 @@ cleanup:
 			else
 				glslShaderData.metaData.language = "glsl4_1";
 
-			ShaderData vkslShaderData = shaderData[i].second;
+			ShaderData vkslShaderData = shaderDataEntry;
 			vkslShaderData.metaData.language = "vksl";
 
-			ShaderData mvksl = shaderData[i].second;
+			ShaderData mvksl = shaderDataEntry;
 			mvksl.metaData.language = "mvksl";
 
 			const auto numPasses = (UINT32)shaderDataEntry.passes.size();
@@ -2316,9 +2375,10 @@ cleanup:
 				// type. If performance is ever important here it could be good to update XShaderCompiler so it can
 				// somehow save the AST and then re-use it for multiple actions.
 				Vector<GpuProgramType> types;
-				reflectHLSL(passData.code, shaderDesc, types);
+				passData.reflection = bs_shared_ptr_new<Xsc::Reflection::ReflectionData>();
+				reflectHLSL(passData.code, *passData.reflection, types);
 
-				auto crossCompilePass = [&types](PassData& passData, CrossCompileOutput language)
+				auto crossCompilePass = [&types, &cache](PassData& passData, CrossCompileOutput language)
 				{
 					UINT32 binding = 0;
 
@@ -2327,22 +2387,28 @@ cleanup:
 						switch (type)
 						{
 						case GPT_VERTEX_PROGRAM:
-							passData.vertexCode = crossCompile(passData.code, GPT_VERTEX_PROGRAM, language, binding);
+							passData.vertexCode = crossCompile(passData.code, GPT_VERTEX_PROGRAM, language, binding,
+								cache);
 							break;
 						case GPT_FRAGMENT_PROGRAM:
-							passData.fragmentCode = crossCompile(passData.code, GPT_FRAGMENT_PROGRAM, language, binding);
+							passData.fragmentCode = crossCompile(passData.code, GPT_FRAGMENT_PROGRAM, language, binding,
+								cache);
 							break;
 						case GPT_GEOMETRY_PROGRAM:
-							passData.geometryCode = crossCompile(passData.code, GPT_GEOMETRY_PROGRAM, language, binding);
+							passData.geometryCode = crossCompile(passData.code, GPT_GEOMETRY_PROGRAM, language, binding,
+								cache);
 							break;
 						case GPT_HULL_PROGRAM:
-							passData.hullCode = crossCompile(passData.code, GPT_HULL_PROGRAM, language, binding);
+							passData.hullCode = crossCompile(passData.code, GPT_HULL_PROGRAM, language, binding,
+								cache);
 							break;
 						case GPT_DOMAIN_PROGRAM:
-							passData.domainCode = crossCompile(passData.code, GPT_DOMAIN_PROGRAM, language, binding);
+							passData.domainCode = crossCompile(passData.code, GPT_DOMAIN_PROGRAM, language, binding,
+								cache);
 							break;
 						case GPT_COMPUTE_PROGRAM:
-							passData.computeCode = crossCompile(passData.code, GPT_COMPUTE_PROGRAM, language, binding);
+							passData.computeCode = crossCompile(passData.code, GPT_COMPUTE_PROGRAM, language, binding,
+								cache);
 							break;
 						default:
 							break;
@@ -2419,20 +2485,30 @@ cleanup:
 				}
 			}
 
-			outputShaderData.push_back(std::make_pair(nullptr, hlslShaderData));
-			outputShaderData.push_back(std::make_pair(nullptr, glslShaderData));
-			outputShaderData.push_back(std::make_pair(nullptr, vkslShaderData));
-			outputShaderData.push_back(std::make_pair(nullptr, mvksl));
+			data.outputShaders.push_back(hlslShaderData);
+			data.outputShaders.push_back(glslShaderData);
+			data.outputShaders.push_back(vkslShaderData);
+			data.outputShaders.push_back(mvksl);
+		}
+	}
+
+	void BSLFXCompiler::createTechniques(const VariationCompileData& data, SHADER_DESC& shaderDesc)
+	{
+		for (auto& shader : data.parsedShaders)
+		{
+			for (auto& passData : shader.passes)
+			{
+				if (passData.reflection != nullptr)
+					parseParameters(*passData.reflection, shaderDesc);
+			}
 		}
 
-		for(auto& entry : outputShaderData)
+		for(auto& entry : data.outputShaders)
 		{
-			const ShaderMetaData& metaData = entry.second.metaData;
-			if (metaData.isMixin)
-				continue;
+			const ShaderMetaData& metaData = entry.metaData;
 
 			Map<UINT32, SPtr<Pass>, std::greater<UINT32>> passes;
-			for (auto& passData : entry.second.passes)
+			for (auto& passData : entry.passes)
 			{
 				PASS_DESC passDesc;
 				passDesc.blendStateDesc = passData.blendDesc;
@@ -2501,12 +2577,11 @@ cleanup:
 
 			if (!orderedPasses.empty())
 			{
-				SPtr<Technique> technique = Technique::create(metaData.language, metaData.tags, variation, orderedPasses);
+				SPtr<Technique> technique = Technique::create(metaData.language, metaData.tags, data.variation,
+					orderedPasses);
 				shaderDesc.techniques.push_back(technique);
 			}
 		}
-
-		return output;
 	}
 
 	String BSLFXCompiler::removeQuotes(const char* input)
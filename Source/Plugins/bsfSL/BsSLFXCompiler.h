@@ -4,6 +4,7 @@
 
 #include "BsSLPrerequisites.h"
 #include "Material/BsShader.h"
+#include "Material/BsShaderVariation.h"
 #include "RenderAPI/BsGpuProgram.h"
 #include "RenderAPI/BsRasterizerState.h"
 #include "RenderAPI/BsDepthStencilState.h"
@@ -14,8 +15,12 @@ extern "C" {
 #include "BsASTFX.h"
 }
 
+namespace Xsc { namespace Reflection { struct ReflectionData; } }
+
 namespace bs
 {
+	class BSLCompileCache;
+
 	/** @addtogroup bsfSL
 	 *  @{
 	 */
@@ -54,6 +59,9 @@ namespace bs
 
 			String code; // Parsed code block
 
+			/** Reflection information about the parsed code, used for registering shader parameters. */
+			SPtr<Xsc::Reflection::ReflectionData> reflection;
+
 			String vertexCode;
 			String fragmentCode;
 			String geometryCode;
@@ -105,6 +113,18 @@ namespace bs
 			Vector<PassData> passes;
 		};
 
+		/** Temporary data for a single shader variation, while it is being compiled. */
+		struct VariationCompileData
+		{
+			ShaderVariation variation;
+
+			/** Non-mixin shaders parsed using the defines of the variation. */
+			Vector<ShaderData> parsedShaders;
+
+			/** Parsed shaders with the code of their passes converted to each of the output languages. */
+			Vector<ShaderData> outputShaders;
+		};
+
 		/** Temporary data describing a sub-shader during parsing. */
 		struct SubShaderData
 		{
@@ -117,6 +137,21 @@ namespace bs
 		static BSLFXCompileResult compile(const String& name, const String& source,
 			const UnorderedMap<String, String>& defines, ShadingLanguageFlags languages);
 
+		/**
+		 * Transforms a source file written in BSL FX syntax into a Shader object.
+		 *
+		 * @param[in]	name		Name of the shader.
+		 * @param[in]	source		BSL source to compile.
+		 * @param[in]	defines		Defines to set before parsing the source.
+		 * @param[in]	languages	Shading languages to generate techniques for.
+		 * @param[in]	cache		Cache used to skip compilation of programs that have been compiled before.
+		 * @param[in]	parallel	If true, shader variations are compiled in parallel if the task scheduler is running.
+		 *							The resulting shader is the same either way.
+		 */
+		static BSLFXCompileResult compile(const String& name, const String& source,
+			const UnorderedMap<String, String>& defines, ShadingLanguageFlags languages, const BSLCompileCache& cache,
+			bool parallel = true);
+
 	private:
 		/** Converts the provided source into an abstract syntax tree using the lexer & parser for BSL FX syntax. */
 		static BSLFXCompileResult parseFX(ParseState* parseState, const char* source,
@@ -268,13 +303,16 @@ namespace bs
 		 *									applied to all variations.
 		 * @param[in]	languages			Shading languages to generate techniques for. Each shader variation will be
 		 *									compiled into a separate technique for each of the provided languages.
+		 * @param[in]	cache				Cache used to skip compilation of programs that have been compiled before.
+		 * @param[in]	parallel			If true, variations are compiled in parallel if the task scheduler is running.
 		 * @param[out]	shaderDesc			Shader descriptor that resulting techniques, sub-shaders, and parameters will be
 		 *									registered with.
 		 * @param[out]	includes			A list of all include files included by the BSL source.
 		 * @return							A result object containing an error message if not successful.
 		 */
 		static BSLFXCompileResult compileShader(String source, const UnorderedMap<String, String>& defines,
-				ShadingLanguageFlags languages, SHADER_DESC& shaderDesc, Vector<String>& includes);
+				ShadingLanguageFlags languages, const BSLCompileCache& cache, bool parallel, SHADER_DESC& shaderDesc,
+				Vector<String>& includes);
 
 		/**
 		 * Uses the provided list of shaders/mixins to generate a list of techniques. A technique is generated for
@@ -288,6 +326,8 @@ namespace bs
 		 *									applied to all variations.
 		 * @param[in]	languages			Shading languages to generate techniques for. Each shader variation will be
 		 *									compiled into a separate technique for each of the provided languages.
+		 * @param[in]	cache				Cache used to skip compilation of programs that have been compiled before.
+		 * @param[in]	parallel			If true, variations are compiled in parallel if the task scheduler is running.
 		 * @param[out]	shaderDesc			Shader descriptor that resulting techniques, and non-internal parameters will be
 		 *									registered with.
 		 * @param[out]	includes			A list of all include files included by the BSL source.
@@ -295,27 +335,44 @@ namespace bs
 		 */
 		static BSLFXCompileResult compileTechniques(const Vector<std::pair<ASTFXNode*, ShaderMetaData>>& shaderMetaData,
 			const String& source, const UnorderedMap<String, String>& defines, ShadingLanguageFlags languages,
-			SHADER_DESC& shaderDesc, Vector<String>& includes);
+			const BSLCompileCache& cache, bool parallel, SHADER_DESC& shaderDesc, Vector<String>& includes);
 
 		/**
-		 * Generates a set of techniques for a single variation. Uses AST parse state as input, which must be created using
-		 * the defines of the relevant variation.
+		 * Parses the shaders of a single variation. Uses AST parse state as input, which must be created using the
+		 * defines of the relevant variation.
 		 *
 		 * @param[in, out]	parseState	Parser state object that has previously been initialized with the AST using
-		 *								parseFX().
-		 * @param[in]	name			Name of the shader to generate the variation for.
+		 *								parseFX(). Deleted by this method.
+		 * @param[in]	name			Name of the shader to parse the variation for.
 		 * @param[in]	codeBlocks		Blocks containing GPU program source code that are referenced by the AST.
-		 * @param[in]	variation		Shader variation the AST was parsed with.
-		 * @param[in]	languages		Shading languages to generate techniques for. Each shader variation will be
-		 *								compiled into a separate technique for each of the provided languages.
 		 * @param[out]	includes		Set to append newly found includes to.
+		 * @param[out]	shaders			Parsed shaders, excluding mixins.
+		 * @return						A result object containing an error message if not successful.
+		 */
+		static BSLFXCompileResult parseVariation(ParseState* parseState, const String& name,
+			const Vector<String>& codeBlocks, UnorderedSet<String>& includes, Vector<ShaderData>& shaders);
+
+		/**
+		 * Converts the code of every pass in the parsed shaders of a variation into per-program code in each of the
+		 * provided languages, and reflects the pass parameters. Does not access any shared state and may be called for
+		 * different variations in parallel.
+		 *
+		 * @param[in, out]	data		Variation whose parsed shaders to compile. Output shaders are written to it.
+		 * @param[in]		languages	Shading languages to generate code for.
+		 * @param[in]		cache		Cache used to skip compilation of programs that have been compiled before.
+		 */
+		static void compileVariation(VariationCompileData& data, ShadingLanguageFlags languages,
+			const BSLCompileCache& cache);
+
+		/**
+		 * Registers the parameters reflected from a compiled variation with the shader descriptor, and creates a
+		 * technique for each of its output shaders.
+		 *
+		 * @param[in]	data			Variation previously compiled with compileVariation().
 		 * @param[out]	shaderDesc		Shader descriptor that resulting techniques, and non-internal parameters will be
 		 *								registered with.
-		 * @return						A result object containing an error message if not successful.
 		 */
-		static BSLFXCompileResult compileTechniques(ParseState* parseState, const String& name,
-			const Vector<String>& codeBlocks, const ShaderVariation& variation, ShadingLanguageFlags languages,
-			UnorderedSet<String>& includes, SHADER_DESC& shaderDesc);
+		static void createTechniques(const VariationCompileData& data, SHADER_DESC& shaderDesc);
 
 		/**
 		 * Converts a null-terminated string into a standard string, and eliminates quotes that are assumed to be at the
@@ -4,6 +4,7 @@
 #include "FileSystem/BsDataStream.h"
 #include "FileSystem/BsFileSystem.h"
 #include "BsSLFXCompiler.h"
+#include "BsSLCompileCache.h"
 #include "Importer/BsShaderImportOptions.h"
 
 namespace bs
@@ -33,7 +34,19 @@ namespace bs
 
 		SPtr<const ShaderImportOptions> io = std::static_pointer_cast<const ShaderImportOptions>(importOptions);
 		String shaderName = filePath.getFilename(false);
-		BSLFXCompileResult result = BSLFXCompiler::compile(shaderName, source, io->getDefines(), io->languages);
+
+		// Empty folder disables the cache
+		Path cacheFolder;
+		if (io->useCompileCache)
+		{
+			cacheFolder = io->compileCacheFolder.isEmpty() ? BSLCompileCache::getDefaultFolder() :
+				io->compileCacheFolder;
+		}
+
+		BSLCompileCache cache(cacheFolder);
+
+		BSLFXCompileResult result = BSLFXCompiler::compile(shaderName, source, io->getDefines(), io->languages, cache);
+		cache.trim();
 
 		if (result.shader != nullptr)
 			result.shader->setName(shaderName);
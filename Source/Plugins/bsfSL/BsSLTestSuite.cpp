@@ -0,0 +1,278 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Testing/BsTestSuite.h"
+#include "BsSLCompileCache.h"
+#include "BsSLFXCompiler.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Material/BsShader.h"
+#include "Material/BsTechnique.h"
+#include "Material/BsPass.h"
+
+namespace bs
+{
+	/** Runs unit tests for systems specific to the BSL compiler plugin. */
+	class SLTestSuite : public TestSuite
+	{
+	public:
+		SLTestSuite();
+
+	private:
+		void testCompileCache();
+		void testParallelCompile();
+
+		/** Returns an empty folder for the tests to store cache entries in. */
+		static Path getCacheFolder();
+	};
+
+	/** Shader with multiple variations, so the compiler has multiple variations to compile in parallel. */
+	static const char* TEST_SHADER_SOURCE = R"(
+		shader TestShader
+		{
+			variations
+			{
+				MODE = { 0, 1, 2 };
+				TINT = { true, false };
+			};
+
+			code
+			{
+				cbuffer Params
+				{
+					float4 gTint;
+				}
+
+				float4 vsmain(float2 position : POSITION) : SV_Position
+				{
+					return float4(position, 0.0f, 1.0f);
+				}
+
+				float4 fsmain(float4 position : SV_Position) : SV_Target0
+				{
+					float4 color = float4(MODE * 0.5f, 0.0f, 0.0f, 1.0f);
+					#if TINT
+						color *= gTint;
+					#endif
+					return color;
+				}
+			};
+		};
+	)";
+
+	/** Checks that two compiled shaders contain the same techniques, with the same GPU program code. */
+	static bool isShaderEqual(const SPtr<Shader>& a, const SPtr<Shader>& b)
+	{
+		if(a == nullptr || b == nullptr)
+			return false;
+
+		const Vector<SPtr<Technique>>& techniquesA = a->getTechniques();
+		const Vector<SPtr<Technique>>& techniquesB = b->getTechniques();
+
+		if(techniquesA.size() != techniquesB.size())
+			return false;
+
+		for(UINT32 i = 0; i < (UINT32)techniquesA.size(); i++)
+		{
+			if(techniquesA[i]->getNumPasses() != techniquesB[i]->getNumPasses())
+				return false;
+
+			for(UINT32 j = 0; j < techniquesA[i]->getNumPasses(); j++)
+			{
+				SPtr<Pass> passA = techniquesA[i]->getPass(j);
+				SPtr<Pass> passB = techniquesB[i]->getPass(j);
+
+				for(UINT32 k = 0; k < GPT_COUNT; k++)
+				{
+					const GPU_PROGRAM_DESC& programA = passA->getProgramDesc((GpuProgramType)k);
+					const GPU_PROGRAM_DESC& programB = passB->getProgramDesc((GpuProgramType)k);
+
+					if(programA.source != programB.source || programA.language != programB.language ||
+						programA.entryPoint != programB.entryPoint)
+						return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	SLTestSuite::SLTestSuite()
+	{
+		BS_ADD_TEST(SLTestSuite::testCompileCache);
+		BS_ADD_TEST(SLTestSuite::testParallelCompile);
+	}
+
+	void SLTestSuite::testCompileCache()
+	{
+		const Path folder = getCacheFolder();
+
+		BSLCompileCache::Entry entry;
+		entry.code = "void main() { }";
+		entry.nextBindingSlot = 3;
+
+		const String key = BSLCompileCache::getKey("source", "options");
+		BS_TEST_ASSERT(key != BSLCompileCache::getKey("source", "otherOptions"));
+		BS_TEST_ASSERT(key != BSLCompileCache::getKey("otherSource", "options"));
+
+		// Disabled cache never stores anything
+		{
+			BSLCompileCache disabledCache;
+			disabledCache.add(key, entry);
+
+			BSLCompileCache::Entry found;
+			BS_TEST_ASSERT(!disabledCache.find(key, found));
+		}
+
+		// Miss, followed by a hit once the entry is added
+		{
+			BSLCompileCache cache(folder);
+
+			BSLCompileCache::Entry found;
+			BS_TEST_ASSERT(!cache.find(key, found));
+
+			cache.add(key, entry);
+			BS_TEST_ASSERT(cache.find(key, found));
+			BS_TEST_ASSERT(found.code == entry.code);
+			BS_TEST_ASSERT(found.nextBindingSlot == entry.nextBindingSlot);
+		}
+
+		// Entries persist between cache instances
+		{
+			BSLCompileCache cache(folder);
+
+			BSLCompileCache::Entry found;
+			BS_TEST_ASSERT(cache.find(key, found));
+			BS_TEST_ASSERT(found.code == entry.code);
+		}
+
+		// Entries that were modified, truncated or stored under a different key are rejected
+		const Path entryPath = folder + Path(key + ".bslc");
+		const auto corruptEntry = [&entryPath](UINT32 offset, INT32 sizeChange)
+		{
+			String contents;
+			{
+				SPtr<DataStream> stream = FileSystem::openFile(entryPath);
+				contents = stream->getAsString();
+			}
+
+			if(sizeChange < 0)
+				contents.resize(contents.size() - (size_t)-sizeChange);
+			else
+				contents[offset] ^= 0x1;
+
+			SPtr<DataStream> stream = FileSystem::createAndOpenFile(entryPath);
+			stream->write(contents.data(), contents.size());
+		};
+
+		{
+			BSLCompileCache cache(folder);
+
+			// Flip a bit in the code
+			corruptEntry((UINT32)(FileSystem::getFileSize(entryPath) - 1), 0);
+
+			BSLCompileCache::Entry found;
+			BS_TEST_ASSERT(!cache.find(key, found));
+
+			// Truncate the code
+			cache.add(key, entry);
+			corruptEntry(0, -1);
+			BS_TEST_ASSERT(!cache.find(key, found));
+
+			// Change the version
+			cache.add(key, entry);
+			corruptEntry(4, 0);
+			BS_TEST_ASSERT(!cache.find(key, found));
+
+			// Move a valid entry under a different key
+			cache.add(key, entry);
+
+			const String otherKey = BSLCompileCache::getKey("source", "otherOptions");
+			FileSystem::copy(entryPath, folder + Path(otherKey + ".bslc"));
+			BS_TEST_ASSERT(!cache.find(otherKey, found));
+			BS_TEST_ASSERT(cache.find(key, found));
+		}
+
+		// Trimming removes entries not used by the cache instance first, until under the size limit
+		{
+			FileSystem::remove(folder);
+
+			const UINT64 entrySize = 1024;
+			BSLCompileCache::Entry largeEntry;
+			largeEntry.code = String((size_t)entrySize, 'x');
+
+			Vector<String> keys;
+			{
+				BSLCompileCache cache(folder);
+				for(UINT32 i = 0; i < 4; i++)
+				{
+					keys.push_back(BSLCompileCache::getKey("source" + toString(i), "options"));
+					cache.add(keys.back(), largeEntry);
+				}
+			}
+
+			// Allow only two entries to fit
+			BSLCompileCache cache(folder, entrySize * 2 + 512);
+
+			BSLCompileCache::Entry found;
+			BS_TEST_ASSERT(cache.find(keys[0], found));
+			BS_TEST_ASSERT(cache.find(keys[3], found));
+
+			cache.trim();
+
+			BS_TEST_ASSERT(FileSystem::exists(folder + Path(keys[0] + ".bslc")));
+			BS_TEST_ASSERT(!FileSystem::exists(folder + Path(keys[1] + ".bslc")));
+			BS_TEST_ASSERT(!FileSystem::exists(folder + Path(keys[2] + ".bslc")));
+			BS_TEST_ASSERT(FileSystem::exists(folder + Path(keys[3] + ".bslc")));
+		}
+
+		FileSystem::remove(folder);
+	}
+
+	void SLTestSuite::testParallelCompile()
+	{
+		const UnorderedMap<String, String> defines;
+		const ShadingLanguageFlags languages = ShadingLanguageFlag::HLSL | ShadingLanguageFlag::GLSL;
+
+		// Parallel and serial compilation produce the same shader
+		const BSLCompileCache disabledCache;
+		BSLFXCompileResult serial = BSLFXCompiler::compile("TestShader", TEST_SHADER_SOURCE, defines, languages,
+			disabledCache, false);
+		BSLFXCompileResult parallel = BSLFXCompiler::compile("TestShader", TEST_SHADER_SOURCE, defines, languages,
+			disabledCache, true);
+
+		BS_TEST_ASSERT(serial.errorMessage.empty());
+		BS_TEST_ASSERT(parallel.errorMessage.empty());
+		BS_TEST_ASSERT(serial.shader != nullptr && !serial.shader->getTechniques().empty());
+		BS_TEST_ASSERT(isShaderEqual(serial.shader, parallel.shader));
+
+		// Shader compiled from cached programs is the same as one compiled without the cache
+		const Path folder = getCacheFolder();
+		{
+			BSLCompileCache cache(folder);
+			BSLFXCompileResult uncached = BSLFXCompiler::compile("TestShader", TEST_SHADER_SOURCE, defines, languages,
+				cache, true);
+
+			Vector<Path> files;
+			Vector<Path> directories;
+			FileSystem::getChildren(folder, files, directories);
+			BS_TEST_ASSERT(!files.empty());
+
+			BSLFXCompileResult cached = BSLFXCompiler::compile("TestShader", TEST_SHADER_SOURCE, defines, languages,
+				cache, false);
+
+			BS_TEST_ASSERT(isShaderEqual(serial.shader, uncached.shader));
+			BS_TEST_ASSERT(isShaderEqual(serial.shader, cached.shader));
+		}
+
+		FileSystem::remove(folder);
+	}
+
+	Path SLTestSuite::getCacheFolder()
+	{
+		const Path folder = FileSystem::getTempDirectoryPath() + Path("SLTestSuiteCache/");
+		if(FileSystem::exists(folder))
+			FileSystem::remove(folder);
+
+		return folder;
+	}
+}
@@ -4,6 +4,7 @@ set(BS_SL_INC_NOFILTER
 	"BsMMAlloc.h"
 	"BsSLImporter.h"
 	"BsSLFXCompiler.h"
+	"BsSLCompileCache.h"
 	"BsIncludeHandler.h"
 	"BsLexerFX.h"
 	"BsParserFX.h"
@@ -14,6 +15,8 @@ set(BS_SL_SRC_NOFILTER
 	"BsASTFX.c"
 	"BsSLImporter.cpp"
 	"BsSLFXCompiler.cpp"
+	"BsSLCompileCache.cpp"
+	"BsSLTestSuite.cpp"
 	"BsIncludeHandler.cpp"
 	"BSMMAlloc.c"
 	"BsLexerFX.c"
@@ -10,15 +10,26 @@ namespace bs { namespace ct
 		:GpuParamBlockBuffer(size, usage, deviceMask), mDeviceMask(deviceMask)
 	{ }
 
+	VulkanGpuParamBlockBuffer::VulkanGpuParamBlockBuffer(const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset,
+		UINT32 size)
+		: GpuParamBlockBuffer(parent, offset, size)
+		, mDeviceMask(static_cast<VulkanGpuParamBlockBuffer*>(parent.get())->mDeviceMask)
+	{ }
+
 	VulkanGpuParamBlockBuffer::~VulkanGpuParamBlockBuffer()
 	{
-		if(mBuffer != nullptr)
+		// Ranges share the hardware buffer of their parent
+		if(mBuffer != nullptr && mParentBuffer == nullptr)
 			bs_pool_delete(static_cast<VulkanHardwareBuffer*>(mBuffer));
 	}
 
 	void VulkanGpuParamBlockBuffer::initialize()
 	{
-		mBuffer = bs_pool_new<VulkanHardwareBuffer>(VulkanHardwareBuffer::BT_UNIFORM, BF_UNKNOWN, mUsage, mSize, mDeviceMask);
+		if(mParentBuffer == nullptr)
+		{
+			mBuffer = bs_pool_new<VulkanHardwareBuffer>(VulkanHardwareBuffer::BT_UNIFORM, BF_UNKNOWN, mUsage, mSize,
+				mDeviceMask);
+		}
 
 		GpuParamBlockBuffer::initialize();
 	}
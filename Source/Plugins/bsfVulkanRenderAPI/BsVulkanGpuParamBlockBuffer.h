@@ -16,6 +16,9 @@ namespace bs { namespace ct
 	{
 	public:
 		VulkanGpuParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask);
+
+		/** @copydoc GpuParamBlockBuffer::GpuParamBlockBuffer(const SPtr<GpuParamBlockBuffer>&, UINT32, UINT32) */
+		VulkanGpuParamBlockBuffer(const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size);
 		~VulkanGpuParamBlockBuffer();
 
 		/**
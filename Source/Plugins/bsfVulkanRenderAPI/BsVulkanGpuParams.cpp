@@ -302,19 +302,34 @@ namespace bs { namespace ct
 				bufferRes = nullptr;
 
 			PerSetData& perSetData = mPerDeviceData[i].perSetData[set];
+			VkDescriptorBufferInfo& bufferInfo = perSetData.writeInfos[bindingIdx].buffer;
 			if (bufferRes != nullptr)
 			{
 				VkBuffer buffer = bufferRes->getHandle();
 
-				perSetData.writeInfos[bindingIdx].buffer.buffer = buffer;
+				bufferInfo.buffer = buffer;
 				mPerDeviceData[i].uniformBuffers[sequentialIdx] = buffer;
+
+				// Buffers that are ranges of a larger buffer only expose their part of it
+				if (vulkanParamBlockBuffer->getParentBuffer() != nullptr)
+				{
+					bufferInfo.offset = vulkanParamBlockBuffer->getParentOffset();
+					bufferInfo.range = vulkanParamBlockBuffer->getSize();
+				}
+				else
+				{
+					bufferInfo.offset = 0;
+					bufferInfo.range = VK_WHOLE_SIZE;
+				}
 			}
 			else
 			{
 				auto& vkBufManager = static_cast<VulkanHardwareBufferManager&>(HardwareBufferManager::instance());
 				VkBuffer buffer = vkBufManager.getDummyUniformBuffer()->getResource(i)->getHandle();
 
-				perSetData.writeInfos[bindingIdx].buffer.buffer = buffer;
+				bufferInfo.buffer = buffer;
+				bufferInfo.offset = 0;
+				bufferInfo.range = VK_WHOLE_SIZE;
 				mPerDeviceData[i].uniformBuffers[sequentialIdx] = buffer;
 			}
 		}
@@ -704,6 +704,7 @@ namespace bs { namespace ct
 
 			caps.maxBoundVertexBuffers = deviceLimits.maxVertexInputBindings;
 			caps.numMultiRenderTargets = deviceLimits.maxColorAttachments;
+			caps.paramBlockBufferOffsetAlignment = (UINT32)deviceLimits.minUniformBufferOffsetAlignment;
 
 			caps.numTextureUnitsPerStage[GPT_FRAGMENT_PROGRAM] = deviceLimits.maxPerStageDescriptorSampledImages;
 			caps.numTextureUnitsPerStage[GPT_VERTEX_PROGRAM] = deviceLimits.maxPerStageDescriptorSampledImages;
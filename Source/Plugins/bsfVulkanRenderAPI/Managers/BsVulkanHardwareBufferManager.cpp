@@ -67,6 +67,18 @@ namespace bs { namespace ct
 		return paramBlockBufferPtr;
 	}
 
+	SPtr<GpuParamBlockBuffer> VulkanHardwareBufferManager::createGpuParamBlockBufferRangeInternal(
+		const SPtr<GpuParamBlockBuffer>& parent, UINT32 offset, UINT32 size)
+	{
+		VulkanGpuParamBlockBuffer* paramBlockBuffer =
+			new (bs_alloc<VulkanGpuParamBlockBuffer>()) VulkanGpuParamBlockBuffer(parent, offset, size);
+
+		SPtr<GpuParamBlockBuffer> paramBlockBufferPtr = bs_shared_ptr<VulkanGpuParamBlockBuffer>(paramBlockBuffer);
+		paramBlockBufferPtr->_setThisPtr(paramBlockBufferPtr);
+
+		return paramBlockBufferPtr;
+	}
+
 	SPtr<GpuBuffer> VulkanHardwareBufferManager::createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
 		GpuDeviceFlags deviceMask)
 	{
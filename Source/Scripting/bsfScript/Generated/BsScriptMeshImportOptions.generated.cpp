@@ -35,6 +35,14 @@ namespace bs
 		metaData.scriptClass->addInternalCall("Internal_setreduceKeyFrames", (void*)&ScriptMeshImportOptions::Internal_setreduceKeyFrames);
 		metaData.scriptClass->addInternalCall("Internal_getimportRootMotion", (void*)&ScriptMeshImportOptions::Internal_getimportRootMotion);
 		metaData.scriptClass->addInternalCall("Internal_setimportRootMotion", (void*)&ScriptMeshImportOptions::Internal_setimportRootMotion);
+		metaData.scriptClass->addInternalCall("Internal_getcompressAnimation", (void*)&ScriptMeshImportOptions::Internal_getcompressAnimation);
+		metaData.scriptClass->addInternalCall("Internal_setcompressAnimation", (void*)&ScriptMeshImportOptions::Internal_setcompressAnimation);
+		metaData.scriptClass->addInternalCall("Internal_getanimationPositionError", (void*)&ScriptMeshImportOptions::Internal_getanimationPositionError);
+		metaData.scriptClass->addInternalCall("Internal_setanimationPositionError", (void*)&ScriptMeshImportOptions::Internal_setanimationPositionError);
+		metaData.scriptClass->addInternalCall("Internal_getanimationRotationError", (void*)&ScriptMeshImportOptions::Internal_getanimationRotationError);
+		metaData.scriptClass->addInternalCall("Internal_setanimationRotationError", (void*)&ScriptMeshImportOptions::Internal_setanimationRotationError);
+		metaData.scriptClass->addInternalCall("Internal_getanimationScaleError", (void*)&ScriptMeshImportOptions::Internal_getanimationScaleError);
+		metaData.scriptClass->addInternalCall("Internal_setanimationScaleError", (void*)&ScriptMeshImportOptions::Internal_setanimationScaleError);
 		metaData.scriptClass->addInternalCall("Internal_getimportScale", (void*)&ScriptMeshImportOptions::Internal_getimportScale);
 		metaData.scriptClass->addInternalCall("Internal_setimportScale", (void*)&ScriptMeshImportOptions::Internal_setimportScale);
 		metaData.scriptClass->addInternalCall("Internal_getcollisionMeshType", (void*)&ScriptMeshImportOptions::Internal_getcollisionMeshType);
@@ -191,6 +199,70 @@ namespace bs
 		thisPtr->getInternal()->importRootMotion = value;
 	}
 
+	bool ScriptMeshImportOptions::Internal_getcompressAnimation(ScriptMeshImportOptions* thisPtr)
+	{
+		bool tmp__output;
+		tmp__output = thisPtr->getInternal()->compressAnimation;
+
+		bool __output;
+		__output = tmp__output;
+
+		return __output;
+	}
+
+	void ScriptMeshImportOptions::Internal_setcompressAnimation(ScriptMeshImportOptions* thisPtr, bool value)
+	{
+		thisPtr->getInternal()->compressAnimation = value;
+	}
+
+	float ScriptMeshImportOptions::Internal_getanimationPositionError(ScriptMeshImportOptions* thisPtr)
+	{
+		float tmp__output;
+		tmp__output = thisPtr->getInternal()->animationPositionError;
+
+		float __output;
+		__output = tmp__output;
+
+		return __output;
+	}
+
+	void ScriptMeshImportOptions::Internal_setanimationPositionError(ScriptMeshImportOptions* thisPtr, float value)
+	{
+		thisPtr->getInternal()->animationPositionError = value;
+	}
+
+	float ScriptMeshImportOptions::Internal_getanimationRotationError(ScriptMeshImportOptions* thisPtr)
+	{
+		float tmp__output;
+		tmp__output = thisPtr->getInternal()->animationRotationError;
+
+		float __output;
+		__output = tmp__output;
+
+		return __output;
+	}
+
+	void ScriptMeshImportOptions::Internal_setanimationRotationError(ScriptMeshImportOptions* thisPtr, float value)
+	{
+		thisPtr->getInternal()->animationRotationError = value;
+	}
+
+	float ScriptMeshImportOptions::Internal_getanimationScaleError(ScriptMeshImportOptions* thisPtr)
+	{
+		float tmp__output;
+		tmp__output = thisPtr->getInternal()->animationScaleError;
+
+		float __output;
+		__output = tmp__output;
+
+		return __output;
+	}
+
+	void ScriptMeshImportOptions::Internal_setanimationScaleError(ScriptMeshImportOptions* thisPtr, float value)
+	{
+		thisPtr->getInternal()->animationScaleError = value;
+	}
+
 	float ScriptMeshImportOptions::Internal_getimportScale(ScriptMeshImportOptions* thisPtr)
 	{
 		float tmp__output;
@@ -41,6 +41,14 @@ namespace bs
 		static void Internal_setreduceKeyFrames(ScriptMeshImportOptions* thisPtr, bool value);
 		static bool Internal_getimportRootMotion(ScriptMeshImportOptions* thisPtr);
 		static void Internal_setimportRootMotion(ScriptMeshImportOptions* thisPtr, bool value);
+		static bool Internal_getcompressAnimation(ScriptMeshImportOptions* thisPtr);
+		static void Internal_setcompressAnimation(ScriptMeshImportOptions* thisPtr, bool value);
+		static float Internal_getanimationPositionError(ScriptMeshImportOptions* thisPtr);
+		static void Internal_setanimationPositionError(ScriptMeshImportOptions* thisPtr, float value);
+		static float Internal_getanimationRotationError(ScriptMeshImportOptions* thisPtr);
+		static void Internal_setanimationRotationError(ScriptMeshImportOptions* thisPtr, float value);
+		static float Internal_getanimationScaleError(ScriptMeshImportOptions* thisPtr);
+		static void Internal_setanimationScaleError(ScriptMeshImportOptions* thisPtr, float value);
 		static float Internal_getimportScale(ScriptMeshImportOptions* thisPtr);
 		static void Internal_setimportScale(ScriptMeshImportOptions* thisPtr, float value);
 		static CollisionMeshType Internal_getcollisionMeshType(ScriptMeshImportOptions* thisPtr);
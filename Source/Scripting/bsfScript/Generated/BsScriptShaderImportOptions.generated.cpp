@@ -23,6 +23,8 @@ namespace bs
 		metaData.scriptClass->addInternalCall("Internal_removeDefine", (void*)&ScriptShaderImportOptions::Internal_removeDefine);
 		metaData.scriptClass->addInternalCall("Internal_getlanguages", (void*)&ScriptShaderImportOptions::Internal_getlanguages);
 		metaData.scriptClass->addInternalCall("Internal_setlanguages", (void*)&ScriptShaderImportOptions::Internal_setlanguages);
+		metaData.scriptClass->addInternalCall("Internal_getuseCompileCache", (void*)&ScriptShaderImportOptions::Internal_getuseCompileCache);
+		metaData.scriptClass->addInternalCall("Internal_setuseCompileCache", (void*)&ScriptShaderImportOptions::Internal_setuseCompileCache);
 		metaData.scriptClass->addInternalCall("Internal_create", (void*)&ScriptShaderImportOptions::Internal_create);
 
 	}
@@ -102,5 +104,21 @@ namespace bs
 	{
 		thisPtr->getInternal()->languages = value;
 	}
+
+	bool ScriptShaderImportOptions::Internal_getuseCompileCache(ScriptShaderImportOptions* thisPtr)
+	{
+		bool tmp__output;
+		tmp__output = thisPtr->getInternal()->useCompileCache;
+
+		bool __output;
+		__output = tmp__output;
+
+		return __output;
+	}
+
+	void ScriptShaderImportOptions::Internal_setuseCompileCache(ScriptShaderImportOptions* thisPtr, bool value)
+	{
+		thisPtr->getInternal()->useCompileCache = value;
+	}
 #endif
 }
@@ -29,6 +29,8 @@ namespace bs
 		static void Internal_removeDefine(ScriptShaderImportOptions* thisPtr, MonoString* define);
 		static ShadingLanguageFlag Internal_getlanguages(ScriptShaderImportOptions* thisPtr);
 		static void Internal_setlanguages(ScriptShaderImportOptions* thisPtr, ShadingLanguageFlag value);
+		static bool Internal_getuseCompileCache(ScriptShaderImportOptions* thisPtr);
+		static void Internal_setuseCompileCache(ScriptShaderImportOptions* thisPtr, bool value);
 		static void Internal_create(MonoObject* managedInstance);
 	};
 #endif
@@ -107,6 +107,46 @@ namespace bs
 			set { Internal_setimportRootMotion(mCachedPtr, value); }
 		}
 
+		/// <summary>
+		/// Enables or disables lossy compression of imported animation clips. Compressed clips remove keyframes that can be 
+		/// reconstructed within the error tolerances below, and store the remaining keyframes at reduced precision. This 
+		/// significantly reduces the memory used by the clips, at the cost of small deviations from the original animation.
+		/// </summary>
+		[ShowInInspector]
+		[NativeWrapper]
+		public bool CompressAnimation
+		{
+			get { return Internal_getcompressAnimation(mCachedPtr); }
+			set { Internal_setcompressAnimation(mCachedPtr, value); }
+		}
+
+		/// <summary>Maximum distance a compressed bone position is allowed to deviate from the original, in meters.</summary>
+		[ShowInInspector]
+		[NativeWrapper]
+		public float AnimationPositionError
+		{
+			get { return Internal_getanimationPositionError(mCachedPtr); }
+			set { Internal_setanimationPositionError(mCachedPtr, value); }
+		}
+
+		/// <summary>Maximum angle a compressed bone rotation is allowed to deviate from the original, in radians.</summary>
+		[ShowInInspector]
+		[NativeWrapper]
+		public float AnimationRotationError
+		{
+			get { return Internal_getanimationRotationError(mCachedPtr); }
+			set { Internal_setanimationRotationError(mCachedPtr, value); }
+		}
+
+		/// <summary>Maximum difference allowed between the components of a compressed bone scale and the original.</summary>
+		[ShowInInspector]
+		[NativeWrapper]
+		public float AnimationScaleError
+		{
+			get { return Internal_getanimationScaleError(mCachedPtr); }
+			set { Internal_setanimationScaleError(mCachedPtr, value); }
+		}
+
 		/// <summary>Uniformly scales the imported mesh by the specified value.</summary>
 		[ShowInInspector]
 		[NativeWrapper]
@@ -187,6 +227,22 @@ namespace bs
 		[MethodImpl(MethodImplOptions.InternalCall)]
 		private static extern void Internal_setimportRootMotion(IntPtr thisPtr, bool value);
 		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern bool Internal_getcompressAnimation(IntPtr thisPtr);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern void Internal_setcompressAnimation(IntPtr thisPtr, bool value);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern float Internal_getanimationPositionError(IntPtr thisPtr);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern void Internal_setanimationPositionError(IntPtr thisPtr, float value);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern float Internal_getanimationRotationError(IntPtr thisPtr);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern void Internal_setanimationRotationError(IntPtr thisPtr, float value);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern float Internal_getanimationScaleError(IntPtr thisPtr);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern void Internal_setanimationScaleError(IntPtr thisPtr, float value);
+		[MethodImpl(MethodImplOptions.InternalCall)]
 		private static extern float Internal_getimportScale(IntPtr thisPtr);
 		[MethodImpl(MethodImplOptions.InternalCall)]
 		private static extern void Internal_setimportScale(IntPtr thisPtr, float value);
@@ -31,8 +31,15 @@ namespace bs
 		/// memory. Normally you want to keep this enabled if you plan on saving the resource to disk.
 		/// </summary>
 		KeepSourceData = 4,
+		/// <summary>
+		/// If enabled the resource file will be memory mapped instead of read into memory, allowing large data blocks (e.g. 
+		/// texture pixels, mesh vertices) to be referenced directly from the mapping. The file must not be modified or truncated 
+		/// while the resource is loaded. Ignored if KeepSourceData is enabled, as well as on platforms where a mapped file cannot 
+		/// be replaced on save.
+		/// </summary>
+		MapFile = 8,
 		/// <summary>Default set of flags used for resource loading.</summary>
-		Default = 3
+		Default = 11
 	}
 
 	/** @} */
@@ -35,6 +35,18 @@ namespace bs
 			set { Internal_setlanguages(mCachedPtr, value); }
 		}
 
+		/// <summary>
+		/// Determines should the GPU programs generated from the shader be cached on disk. This allows programs that haven&apos;t 
+		/// changed to be reused when the shader is re-imported, instead of being compiled again.
+		/// </summary>
+		[ShowInInspector]
+		[NativeWrapper]
+		public bool UseCompileCache
+		{
+			get { return Internal_getuseCompileCache(mCachedPtr); }
+			set { Internal_setuseCompileCache(mCachedPtr, value); }
+		}
+
 		/// <summary>
 		/// Sets a define and its value. Replaces an existing define if one already exists with the provided name.
 		/// </summary>
@@ -82,6 +94,10 @@ namespace bs
 		[MethodImpl(MethodImplOptions.InternalCall)]
 		private static extern void Internal_setlanguages(IntPtr thisPtr, ShadingLanguageFlags value);
 		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern bool Internal_getuseCompileCache(IntPtr thisPtr);
+		[MethodImpl(MethodImplOptions.InternalCall)]
+		private static extern void Internal_setuseCompileCache(IntPtr thisPtr, bool value);
+		[MethodImpl(MethodImplOptions.InternalCall)]
 		private static extern void Internal_create(ShaderImportOptions managedInstance);
 	}
 